@@ -0,0 +1,134 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// sd_bench: runs the benchmark suites and reports median/p99/CI timings, optionally as JSON
+//
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+#include "suites.h"
+
+using namespace sd;
+using namespace sd::bench;
+
+static std::vector<std::string> splitList(const std::string &value) {
+  std::vector<std::string> result;
+  std::stringstream stream(value);
+  std::string item;
+  while (std::getline(stream, item, ','))
+    if (!item.empty()) result.emplace_back(item);
+
+  return result;
+}
+
+static void printUsage() {
+  std::cout << "Usage: sd_bench [options]\n"
+            << "  --suite loops,ops,gemm,graph,workspace   suites to run, all of these by default\n"
+            << "          light,full                       the older op sweeps, only run when listed\n"
+            << "  --threads 1,2,4                          thread counts to sweep, the current limit by default\n"
+            << "  --warmup N                               warmup iterations, 10 by default\n"
+            << "  --iterations N                           measured iterations, 100 by default\n"
+            << "  --graph file.fb                          FlatBuffers graph for the graph suite\n"
+            << "  --json out.json                          writes the results as JSON\n"
+            << "  --quick                                  smaller sweeps\n";
+}
+
+// returns false if the arguments can't be parsed
+static bool parseOptions(int argc, char *argv[], BenchOptions &options) {
+  for (int e = 1; e < argc; e++) {
+    std::string arg(argv[e]);
+
+    if (arg == "--quick") {
+      options.quick = true;
+      continue;
+    }
+
+    if (e + 1 >= argc) return false;
+    std::string value(argv[++e]);
+
+    if (arg == "--suite")
+      options.suites = splitList(value);
+    else if (arg == "--threads") {
+      options.threads.clear();
+      for (const auto &t : splitList(value)) options.threads.emplace_back(std::atoi(t.c_str()));
+    } else if (arg == "--warmup")
+      options.warmup = std::atoi(value.c_str());
+    else if (arg == "--iterations")
+      options.iterations = std::atoi(value.c_str());
+    else if (arg == "--graph")
+      options.graph = value;
+    else if (arg == "--json")
+      options.json = value;
+    else
+      return false;
+  }
+
+  for (auto t : options.threads)
+    if (t < 1) return false;
+
+  return options.iterations > 0;
+}
+
+int main(int argc, char *argv[]) {
+  BenchOptions options;
+  if (!parseOptions(argc, argv, options)) {
+    printUsage();
+    return 1;
+  }
+
+  if (options.threads.empty()) options.threads.emplace_back(Environment::getInstance().maxThreads());
+
+  BenchmarkHelper helper(options.warmup, options.iterations);
+  BenchmarkReport report;
+
+  try {
+    for (const auto &suite : options.suites) {
+      if (suite == "loops")
+        runLoopsSuite(options, helper, report);
+      else if (suite == "ops")
+        runOpsSuite(options, helper, report);
+      else if (suite == "gemm")
+        runGemmSuite(options, helper, report);
+      else if (suite == "graph")
+        runGraphSuite(options, helper, report);
+      else if (suite == "workspace")
+        runWorkspaceSuite(options, helper, report);
+      else if (suite == "light")
+        runLightSuite(options, helper, report);
+      else if (suite == "full")
+        runFullSuite(options, helper, report);
+      else {
+        std::cerr << "Unknown suite: " << suite << std::endl;
+        printUsage();
+        return 1;
+      }
+    }
+
+    std::cout << report.toText();
+
+    if (!options.json.empty()) report.save(options.json);
+  } catch (std::exception &e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+
+  return 0;
+}
@@ -0,0 +1,242 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Benchmark suites run by sd_bench
+//
+#include "suites.h"
+
+#include <array/DataTypeUtils.h>
+#include <graph/GraphExecutioner.h>
+#include <memory/Workspace.h>
+#include <ops/declarable/CustomOperations.h>
+
+#include <memory>
+
+namespace sd {
+namespace bench {
+
+static void addAll(BenchmarkReport &report, const std::vector<BenchmarkRecord> &records) {
+  for (const auto &record : records) report.add(record);
+}
+
+// times a callable once per requested thread count, for code that is not an OpBenchmark
+static void measureCallable(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report,
+                            BenchmarkRecord prototype, const std::function<void()> &func) {
+  const auto maxThreads = Environment::getInstance().maxThreads();
+  const auto maxMasterThreads = Environment::getInstance().maxMasterThreads();
+
+  for (auto t : options.threads) {
+    BenchmarkHelper::setThreads(t);
+
+    BenchmarkRecord record = prototype;
+    record.threads = t;
+    record.stats = helper.measure(func);
+    report.add(record);
+  }
+
+  BenchmarkHelper::setThreads(maxThreads);
+  Environment::getInstance().setMaxMasterThreads(maxMasterThreads);
+}
+
+void runLoopsSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report) {
+  IntPowerParameters length("length", 2, 10, options.quick ? 16 : 24, 2);
+  PredefinedParameters dtype("dtype", {(int)sd::DataType::FLOAT32, (int)sd::DataType::DOUBLE,
+                                       (int)sd::DataType::HALF});
+  ParametersBatch batch({&length, &dtype});
+
+  for (auto &p : batch.parameters()) {
+    const sd::LongType len = p.getIntParam("length");
+    const auto type = (sd::DataType)p.getIntParam("dtype");
+
+    std::vector<std::unique_ptr<OpBenchmark>> benchmarks;
+    benchmarks.emplace_back(new TransformBenchmark(transform::Tanh, "tanh", new NDArray('c', {len}, type),
+                                                   new NDArray('c', {len}, type)));
+    benchmarks.emplace_back(new ScalarBenchmark(scalar::Multiply, "scalar_mul", new NDArray('c', {len}, type),
+                                                new NDArray(NDArrayFactory::create(type, 2.0)),
+                                                new NDArray('c', {len}, type)));
+    benchmarks.emplace_back(new PairwiseBenchmark(pairwise::Add, "pairwise_add", new NDArray('c', {len}, type),
+                                                  new NDArray('c', {len}, type), new NDArray('c', {len}, type)));
+    benchmarks.emplace_back(new ReductionBenchmark(reduce::Sum, "reduce_sum", new NDArray('c', {len}, type),
+                                                   new NDArray(type), std::vector<int>()));
+    if (len >= 256)
+      benchmarks.emplace_back(new BroadcastBenchmark(broadcast::Add, "broadcast_add",
+                                                     new NDArray('c', {len / 256, 256}, type),
+                                                     new NDArray('c', {256}, type),
+                                                     new NDArray('c', {len / 256, 256}, type), {1}));
+
+    for (auto &benchmark : benchmarks) {
+      auto records = helper.measure(*benchmark, "loops", options.threads);
+      for (auto &record : records) record.parameters = p.intParams();
+      addAll(report, records);
+    }
+  }
+}
+
+void runOpsSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report) {
+  IntPowerParameters batchSize("batch", 2, 0, options.quick ? 2 : 4, 2);
+  IntPowerParameters channels("channels", 2, 3, options.quick ? 4 : 6);
+  ParametersBatch batch({&batchSize, &channels});
+
+  sd::ops::conv2d conv2d;
+  sd::ops::softmax softmax;
+
+  for (auto &p : batch.parameters()) {
+    const sd::LongType b = p.getIntParam("batch");
+    const sd::LongType c = p.getIntParam("channels");
+    const sd::LongType hw = 32, k = 3;
+
+    // NCHW input, [kH, kW, iC, oC] weights, SAME padding
+    NDArray input('c', {b, c, hw, hw}, sd::DataType::FLOAT32);
+    NDArray weights('c', {k, k, c, c}, sd::DataType::FLOAT32);
+    NDArray output('c', {b, c, hw, hw}, sd::DataType::FLOAT32);
+    input.linspace(0.01, 0.01);
+    weights.assign(0.1);
+
+    auto ctx = new Context(1);
+    ctx->setInputArray(0, &input, false);
+    ctx->setInputArray(1, &weights, false);
+    ctx->setOutputArray(0, &output, false);
+    ctx->setIArguments({k, k, 1, 1, 0, 0, 1, 1, 1, 0, 0});
+
+    DeclarableBenchmark convBenchmark(conv2d, "conv2d");
+    convBenchmark.setContext(ctx);
+
+    auto records = helper.measure(convBenchmark, "ops", options.threads);
+    for (auto &record : records) {
+      record.parameters = p.intParams();
+      record.flops = 2.0 * output.lengthOf() * k * k * c;
+    }
+    addAll(report, records);
+
+    NDArray logits('c', {b * c, hw * hw}, sd::DataType::FLOAT32);
+    NDArray probabilities('c', {b * c, hw * hw}, sd::DataType::FLOAT32);
+    logits.linspace(-1.0, 0.001);
+
+    auto softmaxCtx = new Context(1);
+    softmaxCtx->setInputArray(0, &logits, false);
+    softmaxCtx->setOutputArray(0, &probabilities, false);
+
+    DeclarableBenchmark softmaxBenchmark(softmax, "softmax");
+    softmaxBenchmark.setContext(softmaxCtx);
+
+    records = helper.measure(softmaxBenchmark, "ops", options.threads);
+    for (auto &record : records) record.parameters = p.intParams();
+    addAll(report, records);
+  }
+}
+
+void runGemmSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report) {
+  IntPowerParameters size("size", 2, 5, options.quick ? 8 : 11);
+  PredefinedParameters dtype("dtype", {(int)sd::DataType::FLOAT32, (int)sd::DataType::DOUBLE});
+  ParametersBatch batch({&size, &dtype});
+
+  for (auto &p : batch.parameters()) {
+    const sd::LongType n = p.getIntParam("size");
+    const auto type = (sd::DataType)p.getIntParam("dtype");
+
+    auto x = new NDArray('c', {n, n}, type);
+    auto y = new NDArray('c', {n, n}, type);
+    x->linspace(0.0, 1e-4);
+    y->linspace(1.0, -1e-4);
+
+    MatrixBenchmark benchmark(1.0f, 0.0f, "gemm", x, y, new NDArray('c', {n, n}, type));
+
+    auto records = helper.measure(benchmark, "gemm", options.threads);
+    for (auto &record : records) record.parameters = p.intParams();
+    addAll(report, records);
+  }
+}
+
+// abs -> cos -> abs chain over a single input, used when no graph file was given
+static graph::Graph *buildDefaultGraph(sd::LongType length) {
+  auto graph = new graph::Graph();
+
+  auto x = new NDArray('c', {length}, sd::DataType::FLOAT32);
+  x->assign(-2.0f);
+  graph->getVariableSpace()->putVariable(-1, x);
+
+  graph->addNode(new graph::Node(graph::OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {2}));
+  graph->addNode(new graph::Node(graph::OpType_TRANSFORM_STRICT, transform::Cosine, 2, {1}, {3}));
+  graph->addNode(new graph::Node(graph::OpType_TRANSFORM_SAME, transform::Abs, 3, {2}, {}));
+
+  return graph;
+}
+
+void runGraphSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report) {
+  const sd::LongType length = options.quick ? 65536 : 1048576;
+
+  std::unique_ptr<graph::Graph> graph(options.graph.empty()
+                                          ? buildDefaultGraph(length)
+                                          : graph::GraphExecutioner::importFromFlatBuffers(options.graph.c_str()));
+  if (graph == nullptr) throw std::runtime_error("sd_bench: unable to load graph from " + options.graph);
+
+  BenchmarkRecord prototype;
+  prototype.suite = "graph";
+  prototype.name = options.graph.empty() ? "abs_cos_abs" : options.graph;
+  prototype.shape = options.graph.empty() ? "[" + std::to_string(length) + "]" : "N/A";
+  prototype.dataType = options.graph.empty() ? "FLOAT32" : "N/A";
+  prototype.parameters["nodes"] = graph->totalNodes();
+
+  measureCallable(options, helper, report, prototype, [&]() {
+    auto status = graph::GraphExecutioner::execute(graph.get());
+    if (status != sd::Status::OK) throw std::runtime_error("sd_bench: graph execution failed");
+  });
+}
+
+void runWorkspaceSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report) {
+  IntPowerParameters length("length", 2, 8, options.quick ? 14 : 20, 2);
+  ParametersBatch batch({&length});
+
+  // number of arrays allocated per iteration
+  const int count = 64;
+
+  for (auto &p : batch.parameters()) {
+    const sd::LongType len = p.getIntParam("length");
+    const double bytes = (double)count * len * sizeof(float);
+
+    BenchmarkRecord prototype;
+    prototype.suite = "workspace";
+    prototype.shape = "[" + std::to_string(len) + "]";
+    prototype.dataType = "FLOAT32";
+    prototype.parameters = p.intParams();
+    prototype.parameters["arrays"] = count;
+    prototype.bytes = bytes;
+
+    prototype.name = "heap_alloc";
+    measureCallable(options, helper, report, prototype, [&]() {
+      for (int e = 0; e < count; e++) NDArray array('c', {len}, sd::DataType::FLOAT32);
+    });
+
+    // sized to fit one iteration, so only the first cycle spills
+    memory::Workspace workspace(static_cast<sd::LongType>(bytes) + count * 1024);
+    LaunchContext context;
+    context.setWorkspace(&workspace);
+
+    prototype.name = "workspace_alloc";
+    measureCallable(options, helper, report, prototype, [&]() {
+      workspace.scopeIn();
+      for (int e = 0; e < count; e++) NDArray array('c', {len}, sd::DataType::FLOAT32, &context);
+      workspace.scopeOut();
+    });
+  }
+}
+
+}  // namespace bench
+}  // namespace sd
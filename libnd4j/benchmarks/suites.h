@@ -0,0 +1,57 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Benchmark suites run by sd_bench, every suite appends its records to the report
+//
+#ifndef LIBND4J_SD_BENCH_SUITES_H
+#define LIBND4J_SD_BENCH_SUITES_H
+#include <helpers/BenchmarkHelper.h>
+
+#include <string>
+#include <vector>
+
+namespace sd {
+namespace bench {
+
+struct BenchOptions {
+  std::vector<std::string> suites = {"loops", "ops", "gemm", "graph", "workspace"};
+  std::vector<int> threads;
+  unsigned int warmup = 10;
+  unsigned int iterations = 100;
+  std::string json;
+  std::string graph;
+  // smaller sweeps, for smoke runs
+  bool quick = false;
+};
+
+void runLoopsSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+void runOpsSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+void runGemmSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+void runGraphSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+void runWorkspaceSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+
+// the op sweeps that used to live in contrib/performance, not run unless asked for
+void runLightSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+void runFullSuite(const BenchOptions &options, BenchmarkHelper &helper, BenchmarkReport &report);
+
+}  // namespace bench
+}  // namespace sd
+
+#endif  // LIBND4J_SD_BENCH_SUITES_H
@@ -30,8 +30,10 @@
 #include <array/ResultSet.h>
 #include <array/ShapeDescriptor.h>
 #include <execution/AffinityManager.h>
+#include <execution/Threads.h>
 #include <graph/Intervals.h>
 #include <helpers/ConstantShapeHelper.h>
+#include <helpers/LoopKind.h>
 #include <helpers/ShapeBuilders.h>
 #include <helpers/shape.h>
 #include <indexing/IndicesList.h>
@@ -890,29 +892,29 @@ class SD_LIB_EXPORT NDArray {
 
   /**
    *  apply operation "func" to an array
-   *  func - what operation to apply
+   *  func - what operation to apply, any callable T(T); it is inlined into the loop
    *  target - where to store result
    */
-  template <typename T>
-  void applyLambda(const std::function<T(T)> &func, NDArray &target);
+  template <typename T, typename Lambda>
+  void applyLambda(const Lambda &func, NDArray &target);
 
   /**
    *  apply pairwise operation "func" to an array
    *  other - input array
-   *  func - what pairwise operation to apply
+   *  func - what pairwise operation to apply, any callable T(T, T)
    *  target - where to store result
    */
-  template <typename T>
-  void applyPairwiseLambda(const NDArray &other, const std::function<T(T, T)> &func, NDArray &target);
+  template <typename T, typename Lambda>
+  void applyPairwiseLambda(const NDArray &other, const Lambda &func, NDArray &target);
 
-  template <typename T>
-  void applyIndexedLambda(const std::function<T(sd::LongType, T)> &func, NDArray &target);
+  template <typename T, typename Lambda>
+  void applyIndexedLambda(const Lambda &func, NDArray &target);
 
-  template <typename T>
-  void applyIndexedPairwiseLambda(NDArray &other, const std::function<T(sd::LongType, T, T)> &func, NDArray &target);
+  template <typename T, typename Lambda>
+  void applyIndexedPairwiseLambda(NDArray &other, const Lambda &func, NDArray &target);
 
-  template <typename T>
-  void applyTriplewiseLambda(NDArray &second, NDArray &third, const std::function<T(T, T, T)> &func, NDArray &target);
+  template <typename T, typename Lambda>
+  void applyTriplewiseLambda(NDArray &second, NDArray &third, const Lambda &func, NDArray &target);
 #endif
 
   /**
@@ -1988,6 +1990,8 @@ bool NDArray::hasPaddedBuffer() const { return ArrayOptions::hasPaddedBuffer(_sh
 #if defined(__CUDACC__)  //&& defined(BUILD_TESTS)
 // for CUDA we need stil stuff inline
 #include <array/NDArrayLambda.hXX>
+#elif !defined(__CUDABLAS__) && !defined(__JAVACPP_HACK__)
+#include <array/cpu/NDArrayLambda.hpp>
 #endif
 
 }  // namespace sd
@@ -0,0 +1,447 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Lazy elementwise expressions over NDArray.
+//
+// Regular NDArray operators evaluate eagerly: every operator is a separate pass over memory and, unless an
+// operand is a temporary, a separate allocation. Expressions built from expr::lazy() operands are only
+// recorded, and are evaluated in one fused, multithreaded pass by expr::assign() or expr::evaluate():
+//
+//   expr::assign(weights, expr::lazy(weights) + (expr::lazy(mask) - 1.) * 1e9);
+//   auto h = expr::evaluate(expr::tanh(expr::lazy(a) * expr::lazy(b) + 1.));
+//
+// Operands broadcast numpy-style against the target. Arrays of another data type than the target are cast
+// once before the pass. Half and bfloat16 are computed in float. Evaluation runs on host buffers.
+//
+#ifndef SD_ARRAY_NDARRAYEXPRESSION_H
+#define SD_ARRAY_NDARRAYEXPRESSION_H
+#include <array/NDArray.h>
+#include <execution/Threads.h>
+#include <helpers/ShapeUtils.h>
+#include <math/templatemath.h>
+
+#include <deque>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace sd {
+namespace expr {
+
+// CRTP base of all expression nodes
+template <typename Derived>
+struct Expression {
+  const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+template <typename E>
+struct IsExpression : std::is_base_of<Expression<E>, E> {};
+
+// state shared by the typed evaluators of one evaluation
+struct BindContext {
+  const NDArray* target;
+  int rank;
+  bool dense;
+  // casted copies of operands with a data type different from the target
+  std::deque<NDArray> casts;
+};
+
+//////////////////////////////////////////////////////////////////////////
+// typed evaluators: setRow() positions an evaluator on a row of the target, at() reads along the row
+
+template <typename T, typename A, bool Dense>
+struct ArrayEvaluator {
+  const T* buffer;
+  const T* row;
+  sd::LongType strides[SD_MAX_RANK];
+  sd::LongType inner;
+  int rank;
+
+  SD_INLINE void setRow(const sd::LongType* coords) {
+    row = buffer;
+    for (int d = 0; d < rank - 1; d++) row += coords[d] * strides[d];
+  }
+
+  SD_INLINE A at(const sd::LongType j) const { return static_cast<A>(Dense ? row[j] : row[j * inner]); }
+};
+
+template <typename A>
+struct ScalarEvaluator {
+  A value;
+
+  SD_INLINE void setRow(const sd::LongType* coords) {}
+
+  SD_INLINE A at(const sd::LongType j) const { return value; }
+};
+
+template <typename Op, typename E>
+struct UnaryEvaluator {
+  E operand;
+
+  SD_INLINE void setRow(const sd::LongType* coords) { operand.setRow(coords); }
+
+  SD_INLINE auto at(const sd::LongType j) const -> decltype(operand.at(j)) { return Op::apply(operand.at(j)); }
+};
+
+template <typename Op, typename L, typename R>
+struct BinaryEvaluator {
+  L left;
+  R right;
+
+  SD_INLINE void setRow(const sd::LongType* coords) {
+    left.setRow(coords);
+    right.setRow(coords);
+  }
+
+  SD_INLINE auto at(const sd::LongType j) const -> decltype(left.at(j)) { return Op::apply(left.at(j), right.at(j)); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// expression nodes
+
+class ArrayOperand : public Expression<ArrayOperand> {
+ private:
+  const NDArray* _array;
+
+ public:
+  explicit ArrayOperand(const NDArray& array) : _array(&array) {}
+
+  void collect(std::vector<const NDArray*>& arrays) const { arrays.push_back(_array); }
+
+  template <typename T, typename A, bool Dense>
+  ArrayEvaluator<T, A, Dense> bind(BindContext& context) const {
+    const NDArray* array = _array;
+    if (array->dataType() != context.target->dataType()) {
+      context.casts.emplace_back(array->cast(context.target->dataType()));
+      array = &context.casts.back();
+    }
+
+    ArrayEvaluator<T, A, Dense> evaluator;
+    evaluator.buffer = array->bufferAsT<T>();
+    evaluator.row = evaluator.buffer;
+    evaluator.rank = context.rank;
+
+    // right-aligned broadcast against the target, size-1 dimensions get zero stride
+    const int shift = context.rank - array->rankOf();
+    for (int d = 0; d < context.rank; d++)
+      evaluator.strides[d] = d < shift || array->sizeAt(d - shift) == 1 ? 0 : array->strideAt(d - shift);
+    evaluator.inner = context.rank > 0 ? evaluator.strides[context.rank - 1] : 0;
+    return evaluator;
+  }
+};
+
+class ScalarOperand : public Expression<ScalarOperand> {
+ private:
+  double _value;
+
+ public:
+  explicit ScalarOperand(const double value) : _value(value) {}
+
+  void collect(std::vector<const NDArray*>& arrays) const {}
+
+  template <typename T, typename A, bool Dense>
+  ScalarEvaluator<A> bind(BindContext& context) const {
+    return ScalarEvaluator<A>{static_cast<A>(static_cast<T>(_value))};
+  }
+};
+
+template <typename Op, typename E>
+class UnaryExpression : public Expression<UnaryExpression<Op, E>> {
+ private:
+  E _operand;
+
+ public:
+  explicit UnaryExpression(const E& operand) : _operand(operand) {}
+
+  void collect(std::vector<const NDArray*>& arrays) const { _operand.collect(arrays); }
+
+  template <typename T, typename A, bool Dense>
+  auto bind(BindContext& context) const
+      -> UnaryEvaluator<Op, decltype(_operand.template bind<T, A, Dense>(context))> {
+    return {_operand.template bind<T, A, Dense>(context)};
+  }
+};
+
+template <typename Op, typename L, typename R>
+class BinaryExpression : public Expression<BinaryExpression<Op, L, R>> {
+ private:
+  L _left;
+  R _right;
+
+ public:
+  BinaryExpression(const L& left, const R& right) : _left(left), _right(right) {}
+
+  void collect(std::vector<const NDArray*>& arrays) const {
+    _left.collect(arrays);
+    _right.collect(arrays);
+  }
+
+  template <typename T, typename A, bool Dense>
+  auto bind(BindContext& context) const
+      -> BinaryEvaluator<Op, decltype(_left.template bind<T, A, Dense>(context)),
+                         decltype(_right.template bind<T, A, Dense>(context))> {
+    auto left = _left.template bind<T, A, Dense>(context);
+    return {left, _right.template bind<T, A, Dense>(context)};
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// element functions
+
+struct AddOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x, const A y) { return x + y; }
+};
+struct SubtractOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x, const A y) { return x - y; }
+};
+struct MultiplyOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x, const A y) { return x * y; }
+};
+struct DivideOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x, const A y) { return x / y; }
+};
+struct MaxOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x, const A y) { return sd::math::sd_max<A>(x, y); }
+};
+struct MinOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x, const A y) { return sd::math::sd_min<A>(x, y); }
+};
+struct NegOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return -x; }
+};
+struct AbsOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return sd::math::sd_abs<A>(x); }
+};
+struct ExpOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return sd::math::sd_exp<A, A>(x); }
+};
+struct LogOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return sd::math::sd_log<A, A>(x); }
+};
+struct SqrtOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return sd::math::sd_sqrt<A, A>(x); }
+};
+struct TanhOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return sd::math::sd_tanh<A, A>(x); }
+};
+struct SigmoidOp {
+  template <typename A>
+  static SD_INLINE A apply(const A x) { return sd::math::sd_sigmoid<A, A>(x); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+// building expressions
+
+SD_INLINE ArrayOperand lazy(const NDArray& array) { return ArrayOperand(array); }
+
+template <typename E, typename = typename std::enable_if<IsExpression<E>::value>::type>
+SD_INLINE const E& operand(const E& e) {
+  return e;
+}
+
+template <typename S, typename = typename std::enable_if<std::is_arithmetic<S>::value>::type>
+SD_INLINE ScalarOperand operand(const S value) {
+  return ScalarOperand(static_cast<double>(value));
+}
+
+// enabled when both sides are expressions or scalars and at least one is an expression
+template <typename L, typename R>
+using EnableBinary = typename std::enable_if<(IsExpression<L>::value || IsExpression<R>::value) &&
+                                             (IsExpression<L>::value || std::is_arithmetic<L>::value) &&
+                                             (IsExpression<R>::value || std::is_arithmetic<R>::value)>::type;
+
+template <typename Op, typename L, typename R>
+using BinaryOf = BinaryExpression<Op, typename std::decay<decltype(operand(std::declval<L>()))>::type,
+                                  typename std::decay<decltype(operand(std::declval<R>()))>::type>;
+
+#define SD_EXPR_BINARY(NAME, OP)                                                 \
+  template <typename L, typename R, typename = EnableBinary<L, R>>               \
+  SD_INLINE BinaryOf<OP, L, R> NAME(const L& left, const R& right) {             \
+    return BinaryOf<OP, L, R>(operand(left), operand(right));                    \
+  }
+
+SD_EXPR_BINARY(operator+, AddOp)
+SD_EXPR_BINARY(operator-, SubtractOp)
+SD_EXPR_BINARY(operator*, MultiplyOp)
+SD_EXPR_BINARY(operator/, DivideOp)
+SD_EXPR_BINARY(max, MaxOp)
+SD_EXPR_BINARY(min, MinOp)
+#undef SD_EXPR_BINARY
+
+#define SD_EXPR_UNARY(NAME, OP)                                                             \
+  template <typename E, typename = typename std::enable_if<IsExpression<E>::value>::type>   \
+  SD_INLINE UnaryExpression<OP, E> NAME(const E& e) {                                       \
+    return UnaryExpression<OP, E>(e);                                                       \
+  }
+
+SD_EXPR_UNARY(operator-, NegOp)
+SD_EXPR_UNARY(abs, AbsOp)
+SD_EXPR_UNARY(exp, ExpOp)
+SD_EXPR_UNARY(log, LogOp)
+SD_EXPR_UNARY(sqrt, SqrtOp)
+SD_EXPR_UNARY(tanh, TanhOp)
+SD_EXPR_UNARY(sigmoid, SigmoidOp)
+#undef SD_EXPR_UNARY
+
+//////////////////////////////////////////////////////////////////////////
+// evaluation
+
+template <typename T, typename E>
+void evaluateTyped(NDArray& target, const E& e, const bool dense) {
+  // half and bfloat16 are computed in float
+  using A = typename std::conditional<std::is_floating_point<T>::value || std::is_integral<T>::value, T, float>::type;
+
+  BindContext context;
+  context.target = &target;
+  context.rank = target.rankOf();
+  context.dense = dense;
+
+  T* z = target.bufferAsT<T>();
+  const sd::LongType length = target.lengthOf();
+
+  if (dense) {
+    const auto evaluator = e.template bind<T, A, true>(context);
+    auto func = PRAGMA_THREADS_FOR {
+      auto local = evaluator;
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) z[i] = static_cast<T>(local.at(i));
+    };
+    samediff::Threads::parallel_for(func, 0, length);
+    return;
+  }
+
+  // row by row along the last dimension of the target
+  const auto evaluator = e.template bind<T, A, false>(context);
+  const int rank = context.rank;
+  const sd::LongType rowLength = rank > 0 ? target.sizeAt(rank - 1) : 1;
+  const sd::LongType zInner = rank > 0 ? target.strideAt(rank - 1) : 0;
+  const sd::LongType rows = length / rowLength;
+  const sd::LongType* shapeInfo = target.shapeInfo();
+
+  auto func = PRAGMA_THREADS_FOR {
+    auto local = evaluator;
+    sd::LongType coords[SD_MAX_RANK] = {};
+    for (auto r = start; r < stop; r++) {
+      if (rank > 1) shape::index2coords(r, rank - 1, shape::shapeOf(shapeInfo), coords);
+      sd::LongType zOffset = 0;
+      for (int d = 0; d < rank - 1; d++) zOffset += coords[d] * shape::stride(shapeInfo)[d];
+
+      local.setRow(coords);
+      T* zRow = z + zOffset;
+      for (sd::LongType j = 0; j < rowLength; j++) zRow[j * zInner] = static_cast<T>(local.at(j));
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, rows);
+}
+
+/**
+ * evaluates the expression into target in a single pass; operands have to broadcast to the target shape
+ * and may alias the target as long as they are read at the same positions
+ */
+template <typename E>
+void assign(NDArray& target, const Expression<E>& expression) {
+  const E& e = expression.self();
+  std::vector<const NDArray*> arrays;
+  e.collect(arrays);
+
+  bool dense = target.ordering() == 'c' && target.ews() == 1;
+  for (auto array : arrays) {
+    bool broadcastable = array->rankOf() <= target.rankOf();
+    for (int d = 0; broadcastable && d < array->rankOf(); d++) {
+      const auto size = array->sizeAt(d);
+      broadcastable = size == 1 || size == target.sizeAt(target.rankOf() - array->rankOf() + d);
+    }
+    if (!broadcastable)
+      throw std::invalid_argument("expr::assign: operand of shape " + ShapeUtils::shapeAsString(array) +
+                                  " can't be broadcast to target shape " + ShapeUtils::shapeAsString(&target));
+    dense &= array->isSameShape(target) && array->ordering() == 'c' && array->ews() == 1;
+  }
+  if (target.lengthOf() == 0) return;
+
+  NDArray::preparePrimaryUse({&target}, arrays);
+  switch (target.dataType()) {
+    case sd::DataType::FLOAT32:
+      evaluateTyped<float>(target, e, dense);
+      break;
+    case sd::DataType::DOUBLE:
+      evaluateTyped<double>(target, e, dense);
+      break;
+    case sd::DataType::HALF:
+      evaluateTyped<float16>(target, e, dense);
+      break;
+    case sd::DataType::BFLOAT16:
+      evaluateTyped<bfloat16>(target, e, dense);
+      break;
+    case sd::DataType::INT32:
+      evaluateTyped<int>(target, e, dense);
+      break;
+    case sd::DataType::INT64:
+      evaluateTyped<sd::LongType>(target, e, dense);
+      break;
+    default:
+      throw std::invalid_argument("expr::assign: unsupported data type " + DataTypeUtils::asString(target.dataType()));
+  }
+  NDArray::registerPrimaryUse({&target}, arrays);
+}
+
+/**
+ * evaluates the expression into a new c-ordered array of the broadcast shape of its operands, allocated
+ * in the workspace of the first operand's context
+ */
+template <typename E>
+NDArray evaluate(const Expression<E>& expression) {
+  std::vector<const NDArray*> arrays;
+  expression.self().collect(arrays);
+  if (arrays.empty()) throw std::invalid_argument("expr::evaluate: expression has no array operands");
+
+  std::vector<sd::LongType> shape = arrays[0]->getShapeAsVector();
+  for (size_t i = 1; i < arrays.size(); i++) {
+    auto other = arrays[i]->getShapeAsVector();
+    if (other.size() > shape.size()) std::swap(other, shape);
+    const size_t shift = shape.size() - other.size();
+    for (size_t d = 0; d < other.size(); d++) {
+      if (shape[shift + d] == 1)
+        shape[shift + d] = other[d];
+      else if (other[d] != 1 && other[d] != shape[shift + d])
+        throw std::invalid_argument("expr::evaluate: operand shapes aren't broadcastable");
+    }
+  }
+
+  NDArray result('c', shape, arrays[0]->dataType(), arrays[0]->getContext());
+  assign(result, expression);
+  return result;
+}
+
+}  // namespace expr
+}  // namespace sd
+
+#endif  // SD_ARRAY_NDARRAYEXPRESSION_H
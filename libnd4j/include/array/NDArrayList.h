@@ -64,6 +64,25 @@ class SD_LIB_EXPORT NDArrayList {
   // maximum number of elements
   int _height = 0;
 
+  // dense mode: while all elements share dtype and shape they live in one contiguous, growable buffer
+  // and _chunks holds views into it, element i starting at offset i * length(_elementShape)
+  bool _dense = false;
+  std::shared_ptr<DataBuffer> _storage;
+  std::vector<sd::LongType> _elementShape;
+  int _capacity = 0;
+
+  // set once stack() has handed out a view of _storage, the next write copies the storage first
+  bool _storageShared = false;
+
+  sd::Status validate(const NDArray &array);
+  bool acceptsDense(const NDArray &array);
+  bool fitsStorage(const NDArray &array) const;
+  std::vector<sd::LongType> storageShape(int numElements) const;
+  NDArray *storageView(int idx);
+  void reserve(int capacity);
+  void dropStorage();
+  void writeDense(int idx, const NDArray &array);
+
  public:
   NDArrayList(int height, bool expandable = false);
   ~NDArrayList();
@@ -73,7 +92,14 @@ class SD_LIB_EXPORT NDArrayList {
   NDArray *remove(int idx);
   NDArray *read(int idx);
   NDArray *readRaw(int idx);
+  // takes ownership of array on success
   sd::Status write(int idx, NDArray *array);
+  // copies array into the list, in place when the list is dense
+  sd::Status write(int idx, const NDArray &array);
+
+  // switches the list to dense mode ahead of the first write, with storage for the declared height
+  void preallocate(sd::DataType dataType, const std::vector<sd::LongType> &elementShape);
+  bool isDense();
 
   NDArray *pick(std::initializer_list<int> indices);
   NDArray *pick(std::vector<int> &indices);
@@ -82,6 +108,7 @@ class SD_LIB_EXPORT NDArrayList {
   std::vector<sd::LongType> &shape();
 
   NDArray *stack();
+  NDArray *gather(const std::vector<int> &indices);
   void unstack(NDArray *array, int axis);
 
   std::pair<int, int> &id();
@@ -541,12 +541,6 @@ void NDArray::repeat(const int axis, const std::vector<int>& repeats, NDArray& t
                         SD_COMMON_TYPES);
 }
 
-//////////////////////////////////////////////////////////////////////////
-#ifndef __JAVACPP_HACK__
-#include "NDArrayLambda.hpp"
-
-#endif
-
 /*
 #ifndef __CLION_IDE__
 #include "NDArray.macro"
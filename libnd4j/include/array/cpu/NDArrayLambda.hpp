@@ -17,9 +17,78 @@
  *  * SPDX-License-Identifier: Apache-2.0
  *  *****************************************************************************
  */
-template <typename T>
-SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third,
-                                                  const std::function<T(T, T, T)>& func, NDArray& target) {
+
+//
+// Host implementation of the NDArray lambda appliers, included by NDArray.h.
+//
+// The lambdas are template parameters, so they are inlined into the loops below instead of being called
+// through std::function per element. The loop shape is picked like in the legacy loops: a flat (SIMD) loop
+// for dense arrays of the same layout, a strided flat loop for non-zero element-wise strides, rows along the
+// last dimension for same-shaped arrays of any layout and per-element offsets otherwise.
+//
+
+//////////////////////////////////////////////////////////////////////////
+// calls op(i, xOffset, yOffset, tOffset, zOffset) for every element index i of arrays of the same length
+template <typename Op>
+SD_INLINE void applyLambdaLoop(const NDArray& x, const NDArray& y, const NDArray& t, const NDArray& z, const Op& op) {
+  const sd::LongType length = z.lengthOf();
+  const auto kind = LoopKind::deduceKindOfLoopXYZ(x.shapeInfo(), y.shapeInfo(), z.shapeInfo());
+  const auto tKind = LoopKind::deduceKindOfLoopXZ(t.shapeInfo(), z.shapeInfo());
+  const bool flat = (kind == LoopKind::EWS1 || kind == LoopKind::EWSNONZERO) &&
+                    (tKind == LoopKind::EWS1 || tKind == LoopKind::EWSNONZERO);
+  const bool sameShape = x.isSameShape(z) && y.isSameShape(z) && t.isSameShape(z);
+
+  if (kind == LoopKind::EWS1 && tKind == LoopKind::EWS1) {
+    auto loop = PRAGMA_THREADS_FOR {
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) op(i, i, i, i, i);
+    };
+    samediff::Threads::parallel_for(loop, 0, length);
+  } else if (flat) {
+    const sd::LongType xEws = x.ews(), yEws = y.ews(), tEws = t.ews(), zEws = z.ews();
+    auto loop = PRAGMA_THREADS_FOR {
+      for (auto i = start; i < stop; i++) op(i, i * xEws, i * yEws, i * tEws, i * zEws);
+    };
+    samediff::Threads::parallel_for(loop, 0, length);
+  } else if (sameShape && z.rankOf() > 0) {
+    // rows along the last dimension, with offsets of the row starts from the coordinates of the other dimensions
+    const int rank = z.rankOf();
+    const sd::LongType rowLength = z.sizeAt(rank - 1);
+    const sd::LongType rows = length / rowLength;
+    const sd::LongType *xStrides = shape::stride(x.shapeInfo()), *yStrides = shape::stride(y.shapeInfo()),
+                       *tStrides = shape::stride(t.shapeInfo()), *zStrides = shape::stride(z.shapeInfo());
+    const sd::LongType xInner = xStrides[rank - 1], yInner = yStrides[rank - 1], tInner = tStrides[rank - 1],
+                       zInner = zStrides[rank - 1];
+
+    auto loop = PRAGMA_THREADS_FOR {
+      sd::LongType coords[SD_MAX_RANK];
+      for (auto r = start; r < stop; r++) {
+        if (rank > 1) shape::index2coords(r, rank - 1, shape::shapeOf(z.shapeInfo()), coords);
+        sd::LongType xOffset = 0, yOffset = 0, tOffset = 0, zOffset = 0;
+        for (int d = 0; d < rank - 1; d++) {
+          xOffset += coords[d] * xStrides[d];
+          yOffset += coords[d] * yStrides[d];
+          tOffset += coords[d] * tStrides[d];
+          zOffset += coords[d] * zStrides[d];
+        }
+
+        const sd::LongType first = r * rowLength;
+        for (sd::LongType j = 0; j < rowLength; j++)
+          op(first + j, xOffset + j * xInner, yOffset + j * yInner, tOffset + j * tInner, zOffset + j * zInner);
+      }
+    };
+    samediff::Threads::parallel_for(loop, 0, rows);
+  } else {
+    auto loop = PRAGMA_THREADS_FOR {
+      for (auto i = start; i < stop; i++) op(i, x.getOffset(i), y.getOffset(i), t.getOffset(i), z.getOffset(i));
+    };
+    samediff::Threads::parallel_for(loop, 0, length);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T, typename Lambda>
+void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third, const Lambda& func, NDArray& target) {
   if (dataType() != DataTypeUtils::fromT<T>())
     throw std::runtime_error(
         "NDArray::applyTriplewiseLambda<T> method: wrong template parameter T, its type should be the same as type of "
@@ -35,89 +104,19 @@ SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& thir
     throw std::runtime_error("Shapes mismatch");
   }
 
-  auto f = this->bufferAsT<T>();
-  auto s = second.bufferAsT<T>();
-  auto t = third.bufferAsT<T>();
+  const auto f = this->bufferAsT<T>();
+  const auto s = second.bufferAsT<T>();
+  const auto t = third.bufferAsT<T>();
   auto z = target.bufferAsT<T>();
 
-  if (this->ordering() == second.ordering() && this->ordering() == third.ordering() &&
-      this->ordering() == target.ordering() && (this->ews() == 1 && target.ews() == 1) && this->ews() == second.ews() &&
-      this->ews() == third.ews()) {
-    auto loop = PRAGMA_THREADS_FOR {
-      for (auto e = start; e < stop; e++) z[e] = func(f[e], s[e], t[e]);
-    };
-
-    samediff::Threads::parallel_for(loop, 0, _length);
-  } else {
-    if (f == z) {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto tOffset = this->getOffset(e);
-          auto uOffset = second.getOffset(e);
-          auto vOffset = third.getOffset(e);
-
-          f[tOffset] = func(f[tOffset], s[uOffset], t[vOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    } else {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto tOffset = this->getOffset(e);
-          auto uOffset = second.getOffset(e);
-          auto vOffset = third.getOffset(e);
-          auto zOffset = target.getOffset(e);
-
-          z[zOffset] = func(f[tOffset], s[uOffset], t[vOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    }
-  }
+  applyLambdaLoop(*this, second, third, target,
+                  [&](sd::LongType i, sd::LongType fOffset, sd::LongType sOffset, sd::LongType tOffset,
+                      sd::LongType zOffset) { z[zOffset] = static_cast<T>(func(f[fOffset], s[sOffset], t[tOffset])); });
 }
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third,
-                                                           const std::function<double(double, double, double)>& func,
-                                                           NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third,
-                                                           const std::function<float(float, float, float)>& func,
-                                                           NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<float16(float16, float16, float16)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<bfloat16(bfloat16, bfloat16, bfloat16)>& func,
-    NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<sd::LongType(sd::LongType, sd::LongType, sd::LongType)>& func,
-    NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third,
-                                                           const std::function<int(int, int, int)>& func,
-                                                           NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<int16_t(int16_t, int16_t, int16_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<uint8_t(uint8_t, uint8_t, uint8_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<uint16_t(uint16_t, uint16_t, uint16_t)>& func,
-    NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<uint32_t(uint32_t, uint32_t, uint32_t)>& func,
-    NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(
-    NDArray& second, NDArray& third, const std::function<uint64_t(uint64_t, uint64_t, uint64_t)>& func,
-    NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third,
-                                                           const std::function<int8_t(int8_t, int8_t, int8_t)>& func,
-                                                           NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyTriplewiseLambda(NDArray& second, NDArray& third,
-                                                           const std::function<bool(bool, bool, bool)>& func,
-                                                           NDArray& target);
 
 //////////////////////////////////////////////////////////////////////////
-template <typename T>
-SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other, const std::function<T(T, T)>& func,
-                                                NDArray& target) {
+template <typename T, typename Lambda>
+void NDArray::applyPairwiseLambda(const NDArray& other, const Lambda& func, NDArray& target) {
   if (dataType() != DataTypeUtils::fromT<T>())
     throw std::runtime_error(
         "NDArray::applyPairwiseLambda<T> method: wrong template parameter T, its type should be the same as type of "
@@ -132,115 +131,27 @@ SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other, const std:
     throw std::runtime_error("Shapes mismatch");
   }
 
-  auto f = this->bufferAsT<T>();
-  auto s = other.bufferAsT<T>();
+  const auto f = this->bufferAsT<T>();
+  const auto s = other.bufferAsT<T>();
   auto z = target.bufferAsT<T>();
-  auto isTargetOrderEws = this->ordering() == target.ordering() && (this->ews() == 1 && target.ews() == 1);
-  if (other.isScalar()) {
-    auto otherVal = s[other.getOffset(0)];
-    if (isTargetOrderEws) {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) z[e] = func(f[e], otherVal);
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    } else {
-      if (f == z) {
-        auto loop = PRAGMA_THREADS_FOR {
-          for (auto e = start; e < stop; e++) {
-            auto xOffset = this->getOffset(e);
-            f[xOffset] = func(f[xOffset], otherVal);
-          }
-        };
-
-        samediff::Threads::parallel_for(loop, 0, _length);
-      } else {
-        auto loop = PRAGMA_THREADS_FOR {
-          for (auto e = start; e < stop; e++) {
-            auto xOffset = this->getOffset(e);
-            auto zOffset = target.getOffset(e);
-
-            z[zOffset] = func(f[xOffset], otherVal);
-          }
-        };
 
-        samediff::Threads::parallel_for(loop, 0, _length);
-      }
-    }
-  } else if (isTargetOrderEws && this->ordering() == other.ordering() && this->ews() == other.ews()) {
-    auto loop = PRAGMA_THREADS_FOR {
-      for (auto e = start; e < stop; e++) z[e] = func(f[e], s[e]);
-    };
-
-    samediff::Threads::parallel_for(loop, 0, _length);
+  if (other.isScalar()) {
+    const T otherVal = s[other.getOffset(0)];
+    applyLambdaLoop(*this, *this, *this, target,
+                    [&](sd::LongType i, sd::LongType fOffset, sd::LongType, sd::LongType, sd::LongType zOffset) {
+                      z[zOffset] = static_cast<T>(func(f[fOffset], otherVal));
+                    });
   } else {
-    if (f == z) {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-          auto yOffset = other.getOffset(e);
-
-          f[xOffset] = func(f[xOffset], s[yOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    } else {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-          auto yOffset = other.getOffset(e);
-          auto zOffset = target.getOffset(e);
-
-          z[zOffset] = func(f[xOffset], s[yOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    }
+    applyLambdaLoop(*this, other, *this, target,
+                    [&](sd::LongType i, sd::LongType fOffset, sd::LongType sOffset, sd::LongType, sd::LongType zOffset) {
+                      z[zOffset] = static_cast<T>(func(f[fOffset], s[sOffset]));
+                    });
   }
 }
 
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<double(double, double)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<float(float, float)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<float16(float16, float16)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<bfloat16(bfloat16, bfloat16)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(
-    const NDArray& other, const std::function<sd::LongType(sd::LongType, sd::LongType)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other, const std::function<int(int, int)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<int16_t(int16_t, int16_t)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<uint8_t(uint8_t, uint8_t)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<uint16_t(uint16_t, uint16_t)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<uint32_t(uint32_t, uint32_t)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<uint64_t(uint64_t, uint64_t)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<int8_t(int8_t, int8_t)>& func,
-                                                         NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyPairwiseLambda(const NDArray& other,
-                                                         const std::function<bool(bool, bool)>& func, NDArray& target);
-
 //////////////////////////////////////////////////////////////////////////
-template <typename T>
-SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<T(T)>& func, NDArray& target) {
+template <typename T, typename Lambda>
+void NDArray::applyLambda(const Lambda& func, NDArray& target) {
   if (dataType() != DataTypeUtils::fromT<T>())
     throw std::runtime_error(
         "NDArray::applyLambda<T> method: wrong template parameter T, its type should be the same as type of this "
@@ -248,58 +159,18 @@ SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<T(T)>& func, NDArray
   if (dataType() != target.dataType())
     throw std::runtime_error("NDArray::applyLambda<T> method: types of this and target array should match !");
 
-  auto f = this->bufferAsT<T>();
+  const auto f = this->bufferAsT<T>();
   auto z = target.bufferAsT<T>();
 
-  if (this->ordering() == target.ordering() && (this->ews() == 1 && target.ews() == 1)) {
-    auto loop = PRAGMA_THREADS_FOR {
-      for (auto e = start; e < stop; e++) z[e] = func(f[e]);
-    };
-
-    samediff::Threads::parallel_for(loop, 0, _length);
-  } else {
-    if (f == z) {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-
-          f[xOffset] = func(f[xOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    } else {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-          auto zOffset = target.getOffset(e);
-
-          z[zOffset] = func(f[xOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    }
-  }
+  applyLambdaLoop(*this, *this, *this, target,
+                  [&](sd::LongType i, sd::LongType fOffset, sd::LongType, sd::LongType, sd::LongType zOffset) {
+                    z[zOffset] = static_cast<T>(func(f[fOffset]));
+                  });
 }
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<double(double)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<float(float)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<float16(float16)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<bfloat16(bfloat16)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<sd::LongType(sd::LongType)>& func,
-                                                 NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<int16_t(int16_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<int32_t(int32_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<uint8_t(uint8_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<uint16_t(uint16_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<uint32_t(uint32_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<uint64_t(uint64_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<int8_t(int8_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyLambda(const std::function<bool(bool)>& func, NDArray& target);
 
 //////////////////////////////////////////////////////////////////////////
-template <typename T>
-SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<T(sd::LongType, T)>& func, NDArray& target) {
+template <typename T, typename Lambda>
+void NDArray::applyIndexedLambda(const Lambda& func, NDArray& target) {
   if (dataType() != DataTypeUtils::fromT<T>())
     throw std::runtime_error(
         "NDArray::applyIndexedLambda<T> method: wrong template parameter T, its type should be the same as type of "
@@ -307,71 +178,18 @@ SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<T(sd::LongTyp
   if (dataType() != target.dataType())
     throw std::runtime_error("NDArray::applyIndexedLambda<T> method: types of this and target array should match !");
 
-  auto f = this->bufferAsT<T>();
+  const auto f = this->bufferAsT<T>();
   auto z = target.bufferAsT<T>();
 
-  if (this->ordering() == target.ordering() && (this->ews() == 1 && target.ews() == 1)) {
-    auto loop = PRAGMA_THREADS_FOR {
-      for (auto e = start; e < stop; e++) z[e] = func(e, f[e]);
-    };
-
-    samediff::Threads::parallel_for(loop, 0, _length);
-  } else {
-    if (f == z) {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-
-          f[xOffset] = func(e, f[xOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    } else {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-          auto zOffset = target.getOffset(e);
-
-          z[zOffset] = func(e, f[xOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    }
-  }
+  applyLambdaLoop(*this, *this, *this, target,
+                  [&](sd::LongType i, sd::LongType fOffset, sd::LongType, sd::LongType, sd::LongType zOffset) {
+                    z[zOffset] = static_cast<T>(func(i, f[fOffset]));
+                  });
 }
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<double(sd::LongType, double)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<float(sd::LongType, float)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<float16(sd::LongType, float16)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<bfloat16(sd::LongType, bfloat16)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(
-    const std::function<sd::LongType(sd::LongType, sd::LongType)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<int(sd::LongType, int)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<int16_t(sd::LongType, int16_t)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<uint8_t(sd::LongType, uint8_t)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<uint16_t(sd::LongType, uint16_t)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<uint32_t(sd::LongType, uint32_t)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<uint64_t(sd::LongType, uint64_t)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<int8_t(sd::LongType, int8_t)>& func,
-                                                        NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedLambda(const std::function<bool(sd::LongType, bool)>& func,
-                                                        NDArray& target);
 
 //////////////////////////////////////////////////////////////////////////
-template <typename T>
-SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(NDArray& other, const std::function<T(sd::LongType, T, T)>& func,
-                                                       NDArray& target) {
+template <typename T, typename Lambda>
+void NDArray::applyIndexedPairwiseLambda(NDArray& other, const Lambda& func, NDArray& target) {
   if (dataType() != DataTypeUtils::fromT<T>())
     throw std::runtime_error(
         "NDArray::applyIndexedPairwiseLambda<T> method: wrong template parameter T, its type should be the same as "
@@ -384,68 +202,12 @@ SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(NDArray& other, const std
     throw std::runtime_error("Shapes mismatch");
   }
 
-  auto f = this->bufferAsT<T>();
-  auto s = other.bufferAsT<T>();
+  const auto f = this->bufferAsT<T>();
+  const auto s = other.bufferAsT<T>();
   auto z = target.bufferAsT<T>();
 
-  if (this->ordering() == other.ordering() && this->ordering() == target.ordering() &&
-      (this->ews() == 1 && target.ews() == 1) && this->ews() == other.ews()) {
-    auto loop = PRAGMA_THREADS_FOR {
-      for (auto e = start; e < stop; e++) z[e] = func((sd::LongType)e, f[e], s[e]);
-    };
-
-    samediff::Threads::parallel_for(loop, 0, _length);
-  } else {
-    if (f == z) {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-          auto yOffset = other.getOffset(e);
-
-          f[xOffset] = func((sd::LongType)e, f[xOffset], s[yOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    } else {
-      auto loop = PRAGMA_THREADS_FOR {
-        for (auto e = start; e < stop; e++) {
-          auto xOffset = this->getOffset(e);
-          auto yOffset = other.getOffset(e);
-          auto zOffset = target.getOffset(e);
-
-          z[zOffset] = func((sd::LongType)e, f[xOffset], s[yOffset]);
-        }
-      };
-
-      samediff::Threads::parallel_for(loop, 0, _length);
-    }
-  }
+  applyLambdaLoop(*this, other, *this, target,
+                  [&](sd::LongType i, sd::LongType fOffset, sd::LongType sOffset, sd::LongType, sd::LongType zOffset) {
+                    z[zOffset] = static_cast<T>(func(i, f[fOffset], s[sOffset]));
+                  });
 }
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<double(sd::LongType, double, double)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<float(sd::LongType, float, float)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<float16(sd::LongType, float16, float16)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<bfloat16(sd::LongType, bfloat16, bfloat16)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<sd::LongType(sd::LongType, sd::LongType, sd::LongType)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(NDArray& other,
-                                                                const std::function<int(sd::LongType, int, int)>& func,
-                                                                NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<int16_t(sd::LongType, int16_t, int16_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<uint8_t(sd::LongType, uint8_t, uint8_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<uint16_t(sd::LongType, uint16_t, uint16_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<uint32_t(sd::LongType, uint32_t, uint32_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<uint64_t(sd::LongType, uint64_t, uint64_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<int8_t(sd::LongType, int8_t, int8_t)>& func, NDArray& target);
-template SD_LIB_HIDDEN void NDArray::applyIndexedPairwiseLambda(
-    NDArray& other, const std::function<bool(sd::LongType, bool, bool)>& func, NDArray& target);
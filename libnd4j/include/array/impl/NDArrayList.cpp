@@ -21,6 +21,7 @@
 //
 
 #include <array/NDArrayList.h>
+#include <execution/Threads.h>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/stack.h>
@@ -65,70 +66,169 @@ NDArray* NDArrayList::remove(int idx) {
     throw std::invalid_argument("Bad index");
   }
 
+  auto result = new NDArray(_chunks[idx]->dup());
   delete _chunks[idx];
+  _chunks.erase(idx);
 
   _elements--;
-  return new NDArray(readRaw(idx)->dup());
+  return result;
 }
 
-
-sd::Status NDArrayList::write(int idx, NDArray* array) {
-  if (_chunks.count(idx) == 0)
-    _elements++;
-  else {
-    delete _chunks[idx];
-  }
-
+sd::Status NDArrayList::validate(const NDArray& array) {
   // we store reference shape on first write
   if (_chunks.empty()) {
-    _dtype = array->dataType();
+    _dtype = array.dataType();
 
     if (_shape.empty()) {
       // adding leading 1 to shape
       _shape.emplace_back(1);
-      for (int e = 0; e < array->rankOf(); e++) _shape.emplace_back(array->sizeAt(e));
-    } else {
-      // if shape is inferred (say, from split_list)
-      if (array->rankOf() == _shape.size()) {
-        // skipping first dim
-        for (int e = 1; e < _shape.size(); e++) {
-          if (_shape[e] != array->sizeAt(e))
-            return Logger::logStatusMsg(Status::BAD_INPUT,
-                                        "NDArrayList: all arrays must have same size along inner dimensions");
-        }
-      } else if (array->rankOf() == _shape.size() - 1) {
-        // case like 2d _shape, and 1D rows
-        for (int e = 1; e < _shape.size(); e++)
-          if (_shape[e] != array->sizeAt(e - 1))
-            return Logger::logStatusMsg(Status::BAD_INPUT,
-                                        "NDArrayList: all arrays must have same size along inner dimensions");
-      } else
+      for (int e = 0; e < array.rankOf(); e++) _shape.emplace_back(array.sizeAt(e));
+      return Status::OK;
+    }
+  } else if (array.dataType() != _dtype) {
+    return Logger::logStatusMsg(Status::BAD_INPUT, "NDArrayList: all arrays must have same data type");
+  }
+
+  // if shape is inferred (say, from split_list)
+  if (array.rankOf() == _shape.size()) {
+    // skipping first dim
+    for (int e = 1; e < _shape.size(); e++) {
+      if (_shape[e] != array.sizeAt(e))
         return Logger::logStatusMsg(Status::BAD_INPUT,
                                     "NDArrayList: all arrays must have same size along inner dimensions");
     }
-  } else {
-    if (array->dataType() != _dtype)
-      return Logger::logStatusMsg(Status::BAD_INPUT, "NDArrayList: all arrays must have same data type");
-
-    // if shape is inferred (say, from split_list)
-    if (array->rankOf() == _shape.size()) {
-      // skipping first dim
-      for (int e = 1; e < _shape.size(); e++) {
-        if (_shape[e] != array->sizeAt(e))
-          return Logger::logStatusMsg(Status::BAD_INPUT,
-                                      "NDArrayList: all arrays must have same size along inner dimensions");
-      }
-    } else if (array->rankOf() == _shape.size() - 1) {
-      // case like 2d _shape, and 1D rows
-      for (int e = 1; e < _shape.size(); e++)
-        if (_shape[e] != array->sizeAt(e - 1))
-          return Logger::logStatusMsg(Status::BAD_INPUT,
-                                      "NDArrayList: all arrays must have same size along inner dimensions");
-    } else
-      return Logger::logStatusMsg(Status::BAD_INPUT,
-                                  "NDArrayList: all arrays must have same size along inner dimensions");
+  } else if (array.rankOf() == _shape.size() - 1) {
+    // case like 2d _shape, and 1D rows
+    for (int e = 1; e < _shape.size(); e++)
+      if (_shape[e] != array.sizeAt(e - 1))
+        return Logger::logStatusMsg(Status::BAD_INPUT,
+                                    "NDArrayList: all arrays must have same size along inner dimensions");
+  } else
+    return Logger::logStatusMsg(Status::BAD_INPUT,
+                                "NDArrayList: all arrays must have same size along inner dimensions");
+
+  return Status::OK;
+}
+
+bool NDArrayList::fitsStorage(const NDArray& array) const {
+  if (_storage != nullptr && _storage->getDataType() != array.dataType()) return false;
+
+  return array.getShapeAsVector() == _elementShape;
+}
+
+bool NDArrayList::acceptsDense(const NDArray& array) {
+  if (_dense && fitsStorage(array)) return true;
+
+  // a mismatching element turns the stored views into standalone arrays
+  if (!_chunks.empty()) {
+    if (_dense) dropStorage();
+    return false;
+  }
+
+  _storage.reset();
+  _capacity = 0;
+  _storageShared = false;
+  _dense = !array.isEmpty() && !array.isS() && array.rankOf() > 0;
+  _elementShape = _dense ? array.getShapeAsVector() : std::vector<sd::LongType>();
+  return _dense;
+}
+
+std::vector<sd::LongType> NDArrayList::storageShape(int numElements) const {
+  std::vector<sd::LongType> shape(_elementShape);
+  shape.insert(shape.begin(), (sd::LongType)numElements);
+  return shape;
+}
+
+NDArray* NDArrayList::storageView(int idx) {
+  if (isWritten(idx)) return _chunks[idx];
+
+  auto offset = idx * shape::prodLong(_elementShape.data(), (int)_elementShape.size());
+  auto view = new NDArray(_storage, 'c', _elementShape, _dtype, _context, false, true, offset);
+  _chunks[idx] = view;
+  _elements++;
+
+  return view;
+}
+
+void NDArrayList::reserve(int capacity) {
+  NDArray storage('c', storageShape(capacity), _dtype, _context);
+
+  if (_storage != nullptr && _capacity > 0) {
+    auto numElements = sd::math::sd_min<int>(_capacity, capacity);
+    NDArray source(_storage, 'c', storageShape(numElements), _dtype, _context, false, true, 0);
+    NDArray target(storage.dataBuffer(), 'c', storageShape(numElements), _dtype, _context, false, true, 0);
+    target.assign(source);
+  }
+
+  _storage = storage.dataBuffer();
+  _capacity = capacity;
+  _storageShared = false;
+
+  // views are rebound to the new storage at the same offsets
+  for (auto& v : _chunks) {
+    auto offset = v.second->bufferOffset();
+    delete v.second;
+    v.second = new NDArray(_storage, 'c', _elementShape, _dtype, _context, false, true, offset);
   }
+}
 
+void NDArrayList::dropStorage() {
+  for (auto& v : _chunks) {
+    auto copy = new NDArray(v.second->dup());
+    delete v.second;
+    v.second = copy;
+  }
+
+  _dense = false;
+  _storage.reset();
+  _capacity = 0;
+  _storageShared = false;
+  _elementShape.clear();
+}
+
+void NDArrayList::writeDense(int idx, const NDArray& array) {
+  auto capacity = _capacity;
+  if (idx >= capacity) capacity = sd::math::sd_max<int>(sd::math::sd_max<int>(idx + 1, 2 * capacity), _height);
+
+  // growth and detaching from a handed out stack() result are the only allocations of element data
+  if (capacity != _capacity || _storageShared) reserve(capacity);
+
+  storageView(idx)->assign(array);
+}
+
+void NDArrayList::preallocate(sd::DataType dataType, const std::vector<sd::LongType>& elementShape) {
+  if (!_chunks.empty() || elementShape.empty() || DataTypeUtils::isS(dataType)) return;
+
+  for (auto dim : elementShape)
+    if (dim <= 0) return;
+
+  _dtype = dataType;
+  _elementShape = elementShape;
+  _dense = true;
+  _storage.reset();
+  _capacity = 0;
+
+  if (_height > 0) reserve(_height);
+}
+
+bool NDArrayList::isDense() { return _dense; }
+
+sd::Status NDArrayList::write(int idx, NDArray* array) {
+  if (isWritten(idx) && _chunks[idx] == array) return Status::OK;
+
+  auto status = validate(*array);
+  if (status != Status::OK) return status;
+
+  if (acceptsDense(*array)) {
+    writeDense(idx, *array);
+    delete array;
+    return Status::OK;
+  }
+
+  if (isWritten(idx))
+    delete _chunks[idx];
+  else
+    _elements++;
 
   // storing reference
   _chunks[idx] = array;
@@ -136,6 +236,18 @@ sd::Status NDArrayList::write(int idx, NDArray* array) {
   return Status::OK;
 }
 
+sd::Status NDArrayList::write(int idx, const NDArray& array) {
+  auto status = validate(array);
+  if (status != Status::OK) return status;
+
+  if (acceptsDense(array)) {
+    writeDense(idx, array);
+    return Status::OK;
+  }
+
+  return write(idx, new NDArray(array.dup()));
+}
+
 std::vector<sd::LongType>& NDArrayList::shape() { return _shape; }
 
 int NDArrayList::counter() { return _counter++; }
@@ -145,10 +257,10 @@ void NDArrayList::unstack(NDArray* array, int axis) {
   std::vector<int> args({axis});
   auto newAxis = ShapeUtils::evalDimsToExclude(array->rankOf(), args);
   auto result = array->allTensorsAlongDimension(newAxis);
-  for (int e = 0; e < result.size(); e++) {
-    auto chunk = result.at(e);
-    write(e, new NDArray(chunk->dup(array->ordering())));
-  }
+  // slices share shape, so the list goes dense with room for all of them
+  if (_chunks.empty() && _height < result.size()) _height = result.size();
+
+  for (int e = 0; e < result.size(); e++) write(e, *result.at(e));
 }
 
 NDArray* NDArrayList::stack() {
@@ -157,6 +269,18 @@ NDArray* NDArrayList::stack() {
     return  new NDArray(NDArrayFactory::empty<double>());
 
   }
+
+  // zero-copy: the result is a view of the storage, later writes copy the storage before modifying it
+  if (_dense) {
+    bool contiguous = true;
+    for (int e = 0; e < numElements && contiguous; e++) contiguous = isWritten(e);
+
+    if (contiguous) {
+      _storageShared = true;
+      return new NDArray(_storage, 'c', storageShape(numElements), _dtype, _context, false, numElements < _capacity, 0);
+    }
+  }
+
   std::vector<const NDArray*> inputs(numElements);
   for (int e = 0; e < numElements; e++) {
     if(!_chunks[e]->isEmpty())
@@ -196,6 +320,46 @@ NDArray* NDArrayList::stack() {
   return array;
 }
 
+NDArray* NDArrayList::gather(const std::vector<int>& indices) {
+  std::vector<sd::LongType> shape = readRaw(indices.empty() ? 0 : indices[0])->getShapeAsVector();
+  shape.insert(shape.begin(), (sd::LongType)indices.size());
+
+  auto result = new NDArray('c', shape, _dtype, _context);
+  int numIndices = indices.size();
+
+  if (_dense && Environment::getInstance().isCPU()) {
+    // element i of the result is a plain copy of one storage slot
+    for (auto idx : indices) readRaw(idx);
+
+    auto elementBytes =
+        shape::prodLong(_elementShape.data(), (int)_elementShape.size()) * DataTypeUtils::sizeOfElement(_dtype);
+    auto source = static_cast<int8_t*>(_storage->primary());
+    auto target = static_cast<int8_t*>(result->buffer());
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto e = start; e < stop; e++)
+        memcpy(target + e * elementBytes, source + indices[e] * elementBytes, elementBytes);
+    };
+    samediff::Threads::parallel_for(func, 0, numIndices);
+
+    return result;
+  }
+
+  std::vector<sd::LongType> indicesList(shape.size() * 2, 0);
+  for (int e = 0; e < numIndices; e++) {
+    auto array = readRaw(indices[e]);
+
+    // first dimension
+    indicesList[0] = e;
+    indicesList[1] = e + 1;
+
+    auto subarray = (*result)(indicesList, true);
+    subarray.assign(array);
+  }
+
+  return result;
+}
+
 std::pair<int, int>& NDArrayList::id() { return _id; }
 
 std::string& NDArrayList::name() { return _name; }
@@ -243,11 +407,9 @@ NDArrayList* NDArrayList::clone() {
   list->_id.first = _id.first;
   list->_id.second = _id.second;
   list->_name = _name;
-  list->_elements.store(_elements.load());
+  list->_shape = _shape;
 
-  for (auto const& v : _chunks) {
-    list->_chunks[v.first] = new NDArray(v.second->dup());
-  }
+  for (auto const& v : _chunks) list->write(v.first, *v.second);
 
   return list;
 }
@@ -26,6 +26,7 @@
 #include <helpers/logger.h>
 #include <math/templatemath.h>
 #include <helpers/shape.h>
+#include <system/ParallelCostModel.h>
 
 #ifdef _OPENMP
 
@@ -37,11 +38,8 @@
 namespace samediff {
 
 	int ThreadsHelper::numberOfThreads(int maxThreads, uint64_t numberOfElements) {
-		// let's see how many threads we actually need first
-		auto optimalThreads = sd::math::sd_max<uint64_t>(1, numberOfElements / 1024);
-
-		// now return the smallest value
-		return sd::math::sd_min<int>(optimalThreads, maxThreads);
+		// without a hint about the op, elements are costed as cheap elementwise work
+		return sd::ParallelCostModel::getInstance().numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::FLOAT32, numberOfElements, maxThreads);
 	}
 
 	Span3::Span3(int64_t startX, int64_t stopX, int64_t incX, int64_t startY, int64_t stopY, int64_t incY, int64_t startZ, int64_t stopZ, int64_t incZ) {
@@ -22,6 +22,7 @@
 #include <execution/ThreadPool.h>
 #include <execution/Ticket.h>
 #include <helpers/logger.h>
+#include <system/Tracer.h>
 
 
 namespace samediff {
@@ -76,6 +77,8 @@ void Ticket::enqueue(uint32_t thread_id, uint32_t num_threads, FUNC_3D func, int
 void Ticket::acquiredThreads(uint32_t threads) { _acquiredThreads = threads; }
 
 void Ticket::waitAndRelease() {
+  sd::TraceScope trace(sd::TraceEventType::POOL_WAIT, "pool_wait");
+
   for (uint32_t e = 0; e < this->_acquiredThreads; e++) {
     // block until finished
     _interfaces[e]->waitForCompletion();
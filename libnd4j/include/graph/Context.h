@@ -69,6 +69,9 @@ class SD_LIB_EXPORT Context : public sd::graph::ContextPrototype {
   // special flag used during conversion from Graph exec to FastPath exec
   bool _forbidFastPath = false;
 
+  // set by kernels that applied fused activation within their own output loop
+  bool _fusedActivationApplied = false;
+
  public:
   Context(ContextPrototype* prototype, VariableSpace* variableSpace);
   explicit Context(int nodeId, VariableSpace* variableSpace = nullptr);
@@ -239,6 +242,9 @@ class SD_LIB_EXPORT Context : public sd::graph::ContextPrototype {
   void allowHelpers(bool reallyAllow);
   bool helpersAllowed();
 
+  void markFusedActivationApplied(bool reallyApplied);
+  bool isFusedActivationApplied();
+
   void setShapeFunctionOverride(bool reallyOverride);
   bool shapeFunctionOverride();
 
@@ -25,6 +25,7 @@
 #include <array/DataType.h>
 #include <execution/Engine.h>
 #include <execution/ExecutionMode.h>
+#include <graph/FusedActivation.h>
 #include <graph/RandomGenerator.h>
 #include <ops/declarable/OpDescriptor.h>
 #include <system/Environment.h>
@@ -68,6 +69,10 @@ class SD_LIB_EXPORT ContextPrototype {
 
   samediff::ExecutionMode _execMode = samediff::ExecutionMode::MODE_UNDEFINED;
 
+  // activation folded into this op by graph optimization, applied to output 0
+  FusedActivation _fusedActivation = FUSED_NONE;
+  double _fusedActivationAlpha = 0.0;
+
  public:
   explicit ContextPrototype(sd::ops::OpDescriptor* opDescriptor = nullptr, int nodeId = 1, bool inPlace = false);
   ~ContextPrototype() = default;
@@ -112,6 +117,13 @@ class SD_LIB_EXPORT ContextPrototype {
   int opNum();
   void setOpNum(int opNum);
 
+  FusedActivation fusedActivation() { return _fusedActivation; }
+  double fusedActivationAlpha() { return _fusedActivationAlpha; }
+  void setFusedActivation(FusedActivation activation, double alpha = 0.0) {
+    _fusedActivation = activation;
+    _fusedActivationAlpha = alpha;
+  }
+
   bool isUseONEDNN() { return _useONEDNN; }
   void setUseONEDNN(bool useONEDNN) { _useONEDNN = useONEDNN; }
 
@@ -38,6 +38,13 @@ class SD_LIB_EXPORT FlatUtils {
 
   static NDArray* fromFlatArray(const sd::graph::FlatArray* flatArray);
 
+  /**
+   * wraps the FlatArray buffer without copying, the result must not outlive the FlatBuffer.
+   * returns nullptr if the array can't be used in place: strings, empty arrays, foreign byte order
+   * or misaligned data
+   */
+  static NDArray* viewFlatArray(const sd::graph::FlatArray* flatArray);
+
   static flatbuffers::Offset<FlatArray> toFlatArray(flatbuffers::FlatBufferBuilder& builder, NDArray& array);
 };
 }  // namespace graph
@@ -80,6 +80,11 @@ class SD_LIB_EXPORT FlowPath {
   sd::LongType getNumberOfCycles(sd::LongType frameId);
 
   GraphProfile* profile();
+
+  /**
+   * forgets all node and frame states, so the same FlowPath can be used for another run
+   */
+  void reset();
 };
 }  // namespace graph
 }  // namespace sd
@@ -17,20 +17,23 @@
  ******************************************************************************/
 
 //
-// @author raver119@gmail.com
+// Activations that can be folded into the output loop of the preceding op
 //
 
-#ifndef LIBND4J_FULLBENCHMARKSUIT_H
-#define LIBND4J_FULLBENCHMARKSUIT_H
-
-#include <performance/benchmarking/BenchmarkSuit.h>
+#ifndef SD_FUSEDACTIVATION_H
+#define SD_FUSEDACTIVATION_H
 
 namespace sd {
-    class FullBenchmarkSuit : public BenchmarkSuit {
-    public:
-        std::string runSuit() override;
-    };
+namespace graph {
+enum FusedActivation {
+  FUSED_NONE = 0,
+  FUSED_RELU = 1,     // alpha is used as cutoff
+  FUSED_RELU6 = 2,    // alpha is used as cutoff
+  FUSED_LRELU = 3,    // alpha is used as negative slope
+  FUSED_SIGMOID = 4,
+  FUSED_TANH = 5,
+};
 }
+}  // namespace sd
 
-
-#endif //DEV_TESTS_FULLBENCHMARKSUIT_H
+#endif  // SD_FUSEDACTIVATION_H
@@ -41,6 +41,8 @@
 namespace sd {
 namespace graph {
 
+class LoopProgram;
+
 class SD_LIB_EXPORT Graph {
  protected:
   ExecutorConfiguration *_configuration;
@@ -67,6 +69,9 @@ class SD_LIB_EXPORT Graph {
   SD_MAP_IMPL<int, Scope *> _mappedScopes;
   std::vector<Scope *> _scopes;
 
+  // compiled While loops, keyed by id of the While node
+  SD_MAP_IMPL<int, LoopProgram *> _loopPrograms;
+
   ////////////////////////////////////////
   sd::Status validateNode(sd::graph::Node *node);
 
@@ -176,6 +181,12 @@ class SD_LIB_EXPORT Graph {
    */
   Scope *scopeById(int id);
 
+  /**
+   * These methods provide access to compiled While loops. Graph owns stored programs
+   */
+  LoopProgram *loopProgram(int nodeId);
+  void putLoopProgram(int nodeId, LoopProgram *program);
+
   /**
    * This method returns TRUE if specified ID refers to Scope, and false otherwise
    * @param id
@@ -19,8 +19,11 @@
 //
 //  @author raver119@gmail.com
 //
+#ifndef LIBND4J_GRAPHHOLDER_H
+#define LIBND4J_GRAPHHOLDER_H
 #include <exceptions/unknown_graph_exception.h>
 #include <graph/Graph.h>
+#include <graph/GraphSession.h>
 #include <helpers/SimpleReadWriteLock.h>
 #include <helpers/logger.h>
 
@@ -35,6 +38,9 @@ class SD_LIB_EXPORT GraphHolder {
 
   SD_MAP_IMPL<sd::LongType, SimpleReadWriteLock> _locks;
 
+  // execution sessions of every registered graph, reused across requests
+  SD_MAP_IMPL<sd::LongType, GraphSessionPool*> _pools;
+
   GraphHolder() = default;
   ~GraphHolder() = default;
 
@@ -60,6 +66,8 @@ class SD_LIB_EXPORT GraphHolder {
   flatbuffers::Offset<FlatResult> execute(sd::LongType graphId, flatbuffers::FlatBufferBuilder& builder,
                                           const FlatInferenceRequest* request);
 
+  GraphSessionPool* sessionPool(sd::LongType graphId);
+
   void replaceGraph(sd::LongType graphId, Graph* graph);
 
   /////////////////////////////
@@ -90,3 +98,5 @@ class SD_LIB_EXPORT GraphHolder {
 };
 }  // namespace graph
 }  // namespace sd
+
+#endif  // LIBND4J_GRAPHHOLDER_H
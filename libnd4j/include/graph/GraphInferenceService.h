@@ -0,0 +1,81 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// gRPC binding of InferenceServer, available when built against gRPC (SD_GRPC)
+//
+#ifndef LIBND4J_GRAPHINFERENCESERVICE_H
+#define LIBND4J_GRAPHINFERENCESERVICE_H
+#ifdef SD_GRPC
+#include <graph/InferenceServer.h>
+#include <graph/scheme/graph.grpc.fb.h>
+
+namespace sd {
+namespace graph {
+
+class GraphInferenceService final : public GraphInferenceServer::Service {
+ private:
+  InferenceServer& _server;
+
+  static ::grpc::Status respond(sd::Status status, flatbuffers::grpc::Message<FlatResponse>* response) {
+    flatbuffers::grpc::MessageBuilder builder;
+    builder.Finish(CreateFlatResponse(builder, static_cast<int32_t>(status)));
+    *response = builder.ReleaseMessage<FlatResponse>();
+    return ::grpc::Status::OK;
+  }
+
+ public:
+  explicit GraphInferenceService(InferenceServer& server) : _server(server) {}
+
+  ::grpc::Status RegisterGraph(::grpc::ServerContext* context, const flatbuffers::grpc::Message<FlatGraph>* request,
+                               flatbuffers::grpc::Message<FlatResponse>* response) override {
+    return respond(_server.registerGraph(request->GetRoot()), response);
+  }
+
+  ::grpc::Status ForgetGraph(::grpc::ServerContext* context, const flatbuffers::grpc::Message<FlatDropRequest>* request,
+                             flatbuffers::grpc::Message<FlatResponse>* response) override {
+    return respond(_server.forgetGraph(request->GetRoot()), response);
+  }
+
+  ::grpc::Status ReplaceGraph(::grpc::ServerContext* context, const flatbuffers::grpc::Message<FlatGraph>* request,
+                              flatbuffers::grpc::Message<FlatResponse>* response) override {
+    return respond(_server.replaceGraph(request->GetRoot()), response);
+  }
+
+  ::grpc::Status InferenceRequest(::grpc::ServerContext* context,
+                                  const flatbuffers::grpc::Message<FlatInferenceRequest>* request,
+                                  flatbuffers::grpc::Message<FlatResult>* response) override {
+    try {
+      auto bytes = _server.inferenceRequest(std::vector<uint8_t>(request->data(), request->data() + request->size()));
+
+      flatbuffers::grpc::MessageBuilder builder;
+      builder.PushFlatBuffer(bytes.data(), bytes.size());
+      *response = builder.ReleaseMessage<FlatResult>();
+      return ::grpc::Status::OK;
+    } catch (std::exception& e) {
+      return ::grpc::Status(::grpc::StatusCode::INTERNAL, e.what());
+    }
+  }
+};
+
+}  // namespace graph
+}  // namespace sd
+
+#endif  // SD_GRPC
+#endif  // LIBND4J_GRAPHINFERENCESERVICE_H
@@ -0,0 +1,99 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Reusable execution state for a registered graph.
+//
+// A session owns a proxy clone of the graph, its FlowPath and a workspace. Requests bind their
+// inputs on top of the proxy, and afterwards the session drops everything it stored and rewinds
+// the workspace, so the next request reuses the same clone and memory instead of building them again.
+//
+#ifndef LIBND4J_GRAPHSESSION_H
+#define LIBND4J_GRAPHSESSION_H
+#include <graph/FlowPath.h>
+#include <graph/Graph.h>
+#include <graph/VariableProxy.h>
+#include <memory/Workspace.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace sd {
+namespace graph {
+class SD_LIB_EXPORT GraphSession {
+ private:
+  Graph* _graph;
+  VariableProxy* _variableSpace;
+  FlowPath _flowPath;
+  sd::memory::Workspace _workspace;
+  LaunchContext* _launchContext;
+
+  std::chrono::steady_clock::time_point _lastUsed;
+
+  void bindInputs(const FlatInferenceRequest* request);
+  void reset();
+
+ public:
+  explicit GraphSession(Graph* origin);
+  ~GraphSession();
+
+  GraphSession(const GraphSession&) = delete;
+  GraphSession& operator=(const GraphSession&) = delete;
+
+  flatbuffers::Offset<FlatResult> execute(flatbuffers::FlatBufferBuilder& builder, const FlatInferenceRequest* request);
+
+  std::chrono::steady_clock::time_point lastUsed() const { return _lastUsed; }
+};
+
+/**
+ * Sessions of one graph. Requests check out an idle session or get a new one, so the pool grows to
+ * the peak concurrency; sessions left idle for longer than the timeout are released
+ */
+class SD_LIB_EXPORT GraphSessionPool {
+ private:
+  Graph* _graph;
+  std::vector<GraphSession*> _idle;
+  std::mutex _mutex;
+
+  int _created = 0;
+  std::chrono::milliseconds _idleTimeout;
+
+  void trim(std::chrono::steady_clock::time_point now);
+
+ public:
+  explicit GraphSessionPool(Graph* graph, sd::LongType idleTimeoutMs = 60000);
+  ~GraphSessionPool();
+
+  GraphSessionPool(const GraphSessionPool&) = delete;
+  GraphSessionPool& operator=(const GraphSessionPool&) = delete;
+
+  GraphSession* acquire();
+  void release(GraphSession* session);
+
+  flatbuffers::Offset<FlatResult> execute(flatbuffers::FlatBufferBuilder& builder, const FlatInferenceRequest* request);
+
+  // number of sessions currently alive, idle or checked out
+  int size();
+  int idle();
+};
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_GRAPHSESSION_H
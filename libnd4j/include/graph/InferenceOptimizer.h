@@ -0,0 +1,100 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Inference-time graph rewrites: folding of frozen normalization into preceding layers, activation fusion and
+// NCHWc layout propagation
+//
+
+#ifndef LIBND4J_INFERENCEOPTIMIZER_H
+#define LIBND4J_INFERENCEOPTIMIZER_H
+#include <graph/Graph.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace sd {
+namespace graph {
+
+/**
+ * This class rewrites built Graph for inference:
+ * 1) batchnorm, fused_batch_norm and biasadd with constant parameters are folded into weights and bias of preceding
+ *    conv2d, xw_plus_b or matmul
+ * 2) relu, relu6, lrelu, sigmoid and tanh are fused into the epilogue of preceding conv2d, xw_plus_b, matmul or biasadd
+ * 3) chains of conv2d, maxpool2d, avgpool2d, upsampling2d and elementwise ops are switched to NCHWc blocked layout,
+ *    so arrays are reordered only at chain boundaries. This rewrite is applied only if Environment::blockedLayout()
+ *    is enabled
+ *
+ * Rewritten nodes keep id of the last node in the chain, so graph outputs and downstream references stay intact.
+ * PLEASE NOTE: batchnorm folding is valid for inference only, since normalization parameters become part of weights
+ */
+class SD_LIB_EXPORT InferenceOptimizer {
+ protected:
+  static bool isConstant(Graph *graph, const std::pair<int, int> &input);
+  static NDArray *constantArray(Graph *graph, const std::pair<int, int> &input);
+  static int putConstant(Graph *graph, NDArray *array);
+
+  static std::string opName(Node *node);
+  static std::vector<Node *> consumersOf(Graph *graph, int nodeId);
+  static bool isExclusiveProducer(Graph *graph, Node *producer, Node *consumer);
+
+  static Node *rebuildNode(Node *origin, int id, const std::vector<std::pair<int, int>> &inputs,
+                           sd::ops::DeclarableOp *op = nullptr);
+  static void replaceNode(Graph *graph, Node *oldNode, Node *newNode);
+  static void copyArguments(Node *origin, Node *node);
+  static void removeNode(Graph *graph, Node *node);
+
+  static bool foldBatchNorm(Graph *graph, Node *producer, Node *norm);
+  static bool foldBiasAdd(Graph *graph, Node *producer, Node *biasAdd);
+  static bool fuseActivation(Graph *graph, Node *producer, Node *activation);
+
+  static bool isBlockedAnchor(const std::string &name);
+  static bool isLayoutAgnostic(const std::string &name);
+  static sd::LongType channelsOf(Graph *graph, Node *node);
+
+ public:
+  /**
+   * This method applies all inference rewrites to the given Graph
+   * @return number of rewrites applied
+   */
+  static int optimize(Graph *graph);
+
+  /**
+   * This method folds constant batchnorm, fused_batch_norm and biasadd nodes into preceding layers
+   * @return number of rewrites applied
+   */
+  static int foldNormalization(Graph *graph);
+
+  /**
+   * This method fuses activation nodes into the epilogue of preceding layers
+   * @return number of rewrites applied
+   */
+  static int fuseActivations(Graph *graph);
+
+  /**
+   * This method switches chains of convolution, pooling, upsampling and elementwise ops to NCHWc layout
+   * @return number of rewrites applied
+   */
+  static int propagateBlockedLayout(Graph *graph);
+};
+
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_INFERENCEOPTIMIZER_H
@@ -0,0 +1,140 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// In-process implementation of the GraphInferenceServer service declared in graph.fbs.
+//
+// Inference requests are queued per graph, and concurrent requests with the same inputs (ids, data
+// types and shapes apart from the first dimension) are concatenated along the batch dimension and
+// executed as one request. Each output that has the batch as its first dimension is split back
+// between the requests, other outputs are returned to every request as they are.
+//
+// Batching is only valid for graphs that treat rows independently, so it is enabled per graph with
+// setBatchable(), or for every graph with batchByDefault. A batch is executed once it holds
+// maxBatchSize rows, or once its oldest request has waited for maxQueueDelayUs. Requests that can't
+// be batched, i.e. for other graphs, without inputs, with scalar inputs or with inputs of different
+// first dimensions, are executed on their own without waiting.
+//
+#ifndef LIBND4J_INFERENCESERVER_H
+#define LIBND4J_INFERENCESERVER_H
+#include <graph/GraphHolder.h>
+#include <graph/scheme/graph_generated.h>
+#include <graph/scheme/request_generated.h>
+#include <graph/scheme/result_generated.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sd {
+namespace graph {
+
+struct BatchingOptions {
+  // max number of rows, along the first dimension, executed together
+  sd::LongType maxBatchSize = 32;
+  // max time the oldest request of a batch waits for others to join it
+  sd::LongType maxQueueDelayUs = 1000;
+  // number of batches executed concurrently
+  int numWorkers = 1;
+  // batch requests of graphs that weren't marked with setBatchable()
+  bool batchByDefault = false;
+};
+
+class SD_LIB_EXPORT InferenceServer {
+ private:
+  struct PendingRequest {
+    std::vector<uint8_t> buffer;
+    const FlatInferenceRequest* request = nullptr;
+    // 0 if the request can't be batched
+    sd::LongType rows = 0;
+    // requests with equal signatures can be concatenated
+    std::string signature;
+    std::chrono::steady_clock::time_point enqueued;
+    std::promise<std::vector<uint8_t>> result;
+  };
+
+  typedef std::shared_ptr<PendingRequest> PendingPtr;
+
+  BatchingOptions _options;
+
+  std::map<sd::LongType, std::deque<PendingPtr>> _queues;
+  std::map<sd::LongType, bool> _batchable;
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  bool _stopped = false;
+
+  std::vector<std::thread> _workers;
+
+  std::atomic<sd::LongType> _batches{0};
+  std::atomic<sd::LongType> _requests{0};
+
+  static void describe(PendingRequest& pending);
+
+  void workerLoop();
+
+  // picks the requests to execute next, returns false if nothing is ready before the deadline
+  bool takeBatch(std::vector<PendingPtr>& batch, std::chrono::steady_clock::time_point& deadline);
+
+  void executeBatch(std::vector<PendingPtr>& batch);
+  static std::vector<uint8_t> executeSingle(PendingRequest& pending);
+
+ public:
+  explicit InferenceServer(const BatchingOptions& options = BatchingOptions());
+  ~InferenceServer();
+
+  InferenceServer(const InferenceServer&) = delete;
+  InferenceServer& operator=(const InferenceServer&) = delete;
+
+  sd::Status registerGraph(const FlatGraph* graph);
+  sd::Status forgetGraph(const FlatDropRequest* request);
+  sd::Status replaceGraph(const FlatGraph* graph);
+
+  /**
+   * allows requests of the given graph to be concatenated, the graph must not mix rows of its inputs
+   */
+  void setBatchable(sd::LongType graphId, bool batchable);
+
+  /**
+   * queues a serialized FlatInferenceRequest, the future holds the serialized FlatResult
+   */
+  std::future<std::vector<uint8_t>> submit(std::vector<uint8_t> request);
+
+  /**
+   * blocks until the request, possibly batched with others, is executed
+   */
+  std::vector<uint8_t> inferenceRequest(std::vector<uint8_t> request);
+
+  // number of executions, and number of requests they served
+  sd::LongType executedBatches() const { return _batches.load(); }
+  sd::LongType executedRequests() const { return _requests.load(); }
+
+  const BatchingOptions& options() const { return _options; }
+};
+
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_INFERENCESERVER_H
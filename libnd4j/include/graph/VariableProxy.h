@@ -86,6 +86,11 @@ class SD_LIB_EXPORT VariableProxy : public VariableSpace {
   virtual sd::graph::Stash *getStash();
   virtual void setFlowPath(FlowPath *timers);
   virtual FlowPath *flowPath();
+
+  /**
+   * releases everything stored on top of the backing space, the FlowPath is kept
+   */
+  void reset();
 };
 }  // namespace graph
 }  // namespace sd
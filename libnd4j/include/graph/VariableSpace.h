@@ -68,6 +68,9 @@ class SD_LIB_EXPORT VariableSpace {
 
   FlowPath* _flow = nullptr;
 
+  // default context is used if not set
+  LaunchContext* _launchContext = nullptr;
+
  public:
   VariableSpace();
   virtual ~VariableSpace();
@@ -79,6 +82,7 @@ class SD_LIB_EXPORT VariableSpace {
   virtual void setWorkspace(sd::memory::Workspace* workspace);
 
   virtual LaunchContext* launchContext();
+  virtual void setLaunchContext(LaunchContext* context);
 
   virtual bool hasExternalVariable(int it);
   virtual bool hasExternalVariable(std::pair<int, int>& pair);
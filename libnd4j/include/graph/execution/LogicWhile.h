@@ -32,7 +32,7 @@ namespace graph {
  * This class is responsible for execution logic of While logical abstraction
  *
  * Basic idea is simple: we take 2 scopes, one for condition and other one for body. and we re-execute body as long, as
- * condition scope evaluates to TRUE
+ * condition scope evaluates to TRUE. Scopes are compiled into LoopProgram on first use, see LoopProgram for details
  * @tparam T
  */
 class LogicWhile {
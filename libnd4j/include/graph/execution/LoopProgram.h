@@ -0,0 +1,110 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Compiled form of a While loop: condition and body scopes flattened into instruction lists
+// with persistent op contexts and pre-resolved variable slots
+//
+
+#ifndef LIBND4J_LOOPPROGRAM_H
+#define LIBND4J_LOOPPROGRAM_H
+
+#include <graph/Context.h>
+#include <graph/Graph.h>
+#include <graph/Node.h>
+
+#include <memory>
+#include <vector>
+
+namespace sd {
+namespace graph {
+/**
+ * This class holds While loop compiled once per Graph
+ *
+ * The first iteration of every loop run goes through the regular VariableSpace lookups, which creates all
+ * intermediate variables. After that the program binds Variable pointers for op inputs/outputs, so every
+ * following iteration only refreshes fast path arrays and calls kernels. Loop-carried values are double
+ * buffered: Return swaps body result and loop variable arrays instead of copying, whenever that's safe.
+ */
+class SD_LIB_EXPORT LoopProgram {
+ protected:
+  struct Instruction {
+    Node* node = nullptr;
+    std::unique_ptr<Context> context;
+
+    // logic ops, embedded graphs and ops without custom op implementation go through the interpreter
+    bool interpreted = false;
+
+    // bound after the first iteration: op uses fast path with these variables
+    bool bound = false;
+    std::vector<Variable*> inputs;
+    std::vector<Variable*> outputs;
+  };
+
+  VariableSpace* _variableSpace = nullptr;
+  int _whileId = 0;
+
+  std::vector<Instruction> _condition;
+  std::vector<Instruction> _body;
+
+  // Return node: body results and loop-carried variables they're written to
+  Node* _return = nullptr;
+  std::vector<std::pair<int, int>> _returnFrom;
+  std::vector<std::pair<int, int>> _returnTo;
+
+  // slots resolved per loop run
+  Variable* _conditionResult = nullptr;
+  std::vector<Variable*> _returnIn;
+  std::vector<Variable*> _returnOut;
+  std::vector<bool> _swappable;
+
+  // Return statistics of the last run
+  sd::LongType _swaps = 0;
+  sd::LongType _copies = 0;
+
+  static void compileScope(Scope* scope, VariableSpace* variableSpace, std::vector<Instruction>& instructions,
+                           bool skipLast);
+
+  sd::Status execute(Graph* graph, Instruction& instruction);
+  sd::Status executeScope(Graph* graph, std::vector<Instruction>& instructions);
+  void bind();
+  void returnValues();
+
+ public:
+  LoopProgram(Graph* graph, Node* node);
+  ~LoopProgram() = default;
+
+  // returns false if loop structure doesn't allow compilation
+  bool isValid();
+
+  VariableSpace* variableSpace();
+
+  // number of loop-carried values swapped and copied by Return during the last run
+  sd::LongType swappedReturns() const;
+  sd::LongType copiedReturns() const;
+
+  /**
+   * This method runs loop until condition evaluates to false, or maxIterations is reached
+   */
+  sd::Status run(Graph* graph, sd::LongType maxIterations);
+};
+}  // namespace graph
+}  // namespace sd
+
+#endif  // LIBND4J_LOOPPROGRAM_H
@@ -21,8 +21,8 @@
 //
 #include <graph/GraphExecutioner.h>
 #include <graph/execution/LogicExecutor.h>
-#include <graph/execution/LogicReturn.h>
 #include <graph/execution/LogicWhile.h>
+#include <graph/execution/LoopProgram.h>
 
 namespace sd {
 namespace graph {
@@ -58,83 +58,21 @@ sd::Status LogicWhile::processNode(Graph* graph, Node* node) {
     }
   }
 
-  int scopeConditionIndex = node->input()->at(inputs - 2).first;
-  int scopeBodyIndex = node->input()->at(inputs - 1).first;
-
-  sd_debug("While [%i]: got [%i] inputs\n", node->id(), node->input()->size());
-
-  // we're running condition nodes now
-  auto scope = graph->scopeById(scopeConditionIndex);
-  int breaker = 0;
-  while (true && breaker < 10000000) {
-    int lastNode = 0;
-    // we're running condition scope first
-    sd_debug("While [%i]: got [%i] ops in condition scope [%i]\n", node->id(), scope->nodes()->size(),
-             scopeConditionIndex);
-
-    for (Node* v : *scope->nodes()) {
-      // v->getBlock()->updateVariables();
-      if (v->opType() == OpType_LOGIC) {
-        sd_debug("Falling back to logic\n", "");
-        LogicExecutor::processNode(graph, v);
-      } else {
-        sd_debug("Op [<%s>]\n", v->getName()->c_str());
-        sd::Status status = GraphExecutioner::executeFlatNode(graph, v, __variableSpace);
-        if (status != sd::Status::OK) return status;
-      }
-
-      lastNode = v->id();
-    }
-
-    if (!__variableSpace->hasVariable(lastNode)) {
-      sd_printf("While [%i]: got no results out of conditional loop\n", node->id());
-      return sd::Status::KERNEL_FAILURE;
-    }
-
-    // now we should take result of the Scope run, and evaluate it
-    auto result = __variableSpace->getVariable(lastNode)->getNDArray();
-
-    if (Environment::getInstance().isDebugAndVerbose()) result->printBuffer("Result of the last node:");
-
-    // if result evaluates to 0.0 - condition returned FALSE
-    if (result->e<int>(0) == 0)
-      break;
-    else {
-      auto scopeBody = graph->scopeById(scopeBodyIndex);
-      int lastNode = 0;
-      int e = 0;
-      sd_debug("While [%i] got [%i] ops in body scope [%i]\n", node->id(), scopeBody->nodes()->size(), scopeBodyIndex);
-      for (; e < scopeBody->nodes()->size() - 1; e++) {
-        Node* v = scopeBody->nodes()->at(e);
-
-        if (v->opType() == OpType_LOGIC) {
-          sd_debug("Falling back to logic\n", "");
-          LogicExecutor::processNode(graph, v);
-        } else {
-          sd_debug("Op [<%s>]\n", v->getName()->c_str());
-          // v->getBlock()->updateVariables();
-          sd::Status status = GraphExecutioner::executeFlatNode(graph, v, __variableSpace);
-          if (status != sd::Status::OK) return status;
-        }
-
-        lastNode = v->id();
-      }
-
-      // now execute return statement
-      Node* ret = scopeBody->nodes()->at(e);
-      LogicReturn::processNode(graph, ret);
-    }
-
-    breaker++;
+  // condition and body scopes are compiled once, and re-bound to variables on every run
+  auto program = graph->loopProgram(node->id());
+  if (program == nullptr || program->variableSpace() != __variableSpace) {
+    program = new LoopProgram(graph, node);
+    graph->putLoopProgram(node->id(), program);
   }
 
-  // if we've hit breaker limit - we should notify about that
-  if (breaker >= 10000000) {
-    sd_printf("While condition seems to be never ending, aborting...\n", breaker);
-    return sd::Status::KERNEL_FAILURE;
+  if (!program->isValid()) {
+    sd_printf("While [%i]: condition and body scopes should contain at least 1 node each\n", node->id());
+    return sd::Status::BAD_INPUT;
   }
 
-  return sd::Status::OK;
+  sd_debug("While [%i]: got [%i] inputs\n", node->id(), node->input()->size());
+
+  return program->run(graph, 10000000);
 }
 }  // namespace graph
 }  // namespace sd
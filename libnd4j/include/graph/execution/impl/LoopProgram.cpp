@@ -0,0 +1,281 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Compiled While loop execution
+//
+#include <graph/GraphExecutioner.h>
+#include <graph/execution/LogicExecutor.h>
+#include <graph/execution/LogicReturn.h>
+#include <graph/execution/LoopProgram.h>
+
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sd {
+namespace graph {
+LoopProgram::LoopProgram(Graph* graph, Node* node) {
+  _variableSpace = graph->getVariableSpace();
+  _whileId = node->id();
+
+  // 2 last inputs are scopes
+  int inputs = node->input()->size();
+  auto condition = graph->scopeById(node->input()->at(inputs - 2).first);
+  auto body = graph->scopeById(node->input()->at(inputs - 1).first);
+
+  if (condition == nullptr || body == nullptr || condition->nodes()->empty() || body->nodes()->empty()) return;
+
+  compileScope(condition, _variableSpace, _condition, false);
+  compileScope(body, _variableSpace, _body, true);
+
+  // body scope always ends with Return statement
+  _return = body->nodes()->back();
+  for (int e = 0; e < _return->input()->size(); e++) {
+    _returnFrom.emplace_back(_return->input()->at(e));
+    _returnTo.emplace_back(_return->output()->at(e).first, e);
+  }
+}
+
+void LoopProgram::compileScope(Scope* scope, VariableSpace* variableSpace, std::vector<Instruction>& instructions,
+                               bool skipLast) {
+  int numNodes = scope->nodes()->size() - (skipLast ? 1 : 0);
+  instructions.resize(numNodes);
+
+  for (int e = 0; e < numNodes; e++) {
+    auto node = scope->nodes()->at(e);
+    auto& instruction = instructions[e];
+
+    instruction.node = node;
+    instruction.interpreted = node->opType() == OpType_LOGIC || node->hasGraphEmbedded() || !node->hasCustomOp();
+
+    if (!instruction.interpreted) instruction.context.reset(new Context(node->getContextPrototype(), variableSpace));
+  }
+}
+
+bool LoopProgram::isValid() { return _return != nullptr; }
+
+sd::LongType LoopProgram::swappedReturns() const { return _swaps; }
+
+sd::LongType LoopProgram::copiedReturns() const { return _copies; }
+
+VariableSpace* LoopProgram::variableSpace() { return _variableSpace; }
+
+sd::Status LoopProgram::execute(Graph* graph, Instruction& instruction) {
+  auto node = instruction.node;
+
+  if (instruction.interpreted) {
+    if (node->opType() == OpType_LOGIC) {
+      sd_debug("Falling back to logic\n", "");
+      return LogicExecutor::processNode(graph, node);
+    }
+
+    return GraphExecutioner::executeFlatNode(graph, node, _variableSpace);
+  }
+
+  // fast path arrays left from the previous iteration might be stale
+  auto context = instruction.context.get();
+  context->clearFastPath();
+
+  if (instruction.bound) {
+    for (int e = 0; e < instruction.inputs.size(); e++) context->setInputArray(e, instruction.inputs[e]->getNDArray());
+
+    for (int e = 0; e < instruction.outputs.size(); e++)
+      context->setOutputArray(e, instruction.outputs[e]->getNDArray());
+  }
+
+  auto status = node->getCustomOp()->execute(context);
+  if (status != sd::Status::OK) return status;
+
+  // propagate variables
+  if (node->hasExternalOutputs()) {
+    for (auto v : *node->output()) {
+      if (_variableSpace->hasExternalVariable(v.first)) {
+        _variableSpace->getVariable(v.first)->getNDArray()->assign(_variableSpace->getVariable(node->id())->getNDArray());
+      }
+    }
+  }
+
+  return sd::Status::OK;
+}
+
+sd::Status LoopProgram::executeScope(Graph* graph, std::vector<Instruction>& instructions) {
+  for (auto& instruction : instructions) {
+    auto status = execute(graph, instruction);
+    if (status != sd::Status::OK) return status;
+  }
+
+  return sd::Status::OK;
+}
+
+void LoopProgram::bind() {
+  // return values can be swapped only if every op in the loop resolves its arrays through bound variables
+  bool swappable = true;
+
+  for (auto instructions : {&_condition, &_body}) {
+    for (auto& instruction : *instructions) {
+      instruction.bound = false;
+      instruction.inputs.clear();
+      instruction.outputs.clear();
+
+      if (instruction.interpreted) {
+        swappable = false;
+        continue;
+      }
+
+      auto context = instruction.context.get();
+      auto& in = context->fastpath_in();
+      auto& out = context->fastpath_out();
+
+      // in-place ops alias their outputs with inputs, these stay on VariableSpace lookups
+      bool bound = !context->isInplace() && context->isFastPath() && !out.empty() &&
+                   in.size() == context->inputs()->size();
+
+      for (int e = 0; e < in.size() && bound; e++) {
+        auto pair = context->inputs()->at(e);
+        bound = _variableSpace->hasVariable(pair) && _variableSpace->getVariable(pair)->getNDArray() == in[e];
+        if (bound) instruction.inputs.emplace_back(_variableSpace->getVariable(pair));
+      }
+
+      for (int e = 0; e < out.size() && bound; e++) {
+        std::pair<int, int> pair(context->nodeId(), e);
+        bound = _variableSpace->hasVariable(pair) && _variableSpace->getVariable(pair)->getNDArray() == out[e];
+        if (bound) instruction.outputs.emplace_back(_variableSpace->getVariable(pair));
+      }
+
+      instruction.bound = bound;
+      if (!bound) {
+        instruction.inputs.clear();
+        instruction.outputs.clear();
+        swappable = false;
+        continue;
+      }
+    }
+  }
+
+  _returnIn.clear();
+  _returnOut.clear();
+  for (int e = 0; e < _returnFrom.size(); e++) {
+    _returnIn.emplace_back(_variableSpace->getVariable(_returnFrom[e]));
+    _returnOut.emplace_back(_variableSpace->getVariable(_returnTo[e]));
+  }
+
+  // arrays referenced by more than one variable, anywhere in the graph, can't move between variables.
+  // Deletion responsibility (removable flag) moves together with the array on swap, so it doesn't matter here:
+  // loop variables are inputs of the condition and are never removable after the first iteration
+  std::unordered_set<Variable*> variables(_variableSpace->handles()->begin(), _variableSpace->handles()->end());
+  std::unordered_map<NDArray*, int> owners;
+  for (auto v : variables)
+    if (v->variableType() == VariableType::NDARRAY && v->hasNDArray()) owners[v->getNDArray()]++;
+
+  auto ownsExclusively = [&](Variable* v) -> bool {
+    return v->hasNDArray() && !v->isReadOnly() && !v->getNDArray()->isView() && owners[v->getNDArray()] == 1;
+  };
+
+  _swappable.assign(_returnFrom.size(), false);
+  for (int e = 0; e < _returnFrom.size() && swappable; e++) {
+    auto in = _returnIn[e];
+    auto out = _returnOut[e];
+
+    _swappable[e] = in != out && ownsExclusively(in) && ownsExclusively(out) &&
+                    in->getNDArray()->isSameShape(out->getNDArray()) &&
+                    in->getNDArray()->dataType() == out->getNDArray()->dataType() &&
+                    in->getNDArray()->ordering() == out->getNDArray()->ordering();
+  }
+}
+
+void LoopProgram::returnValues() {
+  for (int e = 0; e < _returnIn.size(); e++) {
+    auto in = _returnIn[e];
+    auto out = _returnOut[e];
+
+    if (_swappable[e]) {
+      // body result becomes the loop variable, old loop variable array receives next body result.
+      // whoever was going to delete an array still does
+      auto array = in->getNDArray();
+      auto removable = in->isRemovable();
+      in->setNDArray(out->getNDArray());
+      in->markRemovable(out->isRemovable());
+      out->setNDArray(array);
+      out->markRemovable(removable);
+      _swaps++;
+    } else {
+      out->getNDArray()->assign(in->getNDArray());
+      _copies++;
+    }
+  }
+}
+
+sd::Status LoopProgram::run(Graph* graph, sd::LongType maxIterations) {
+  // variables might have been replaced since the previous run, so slots are resolved again
+  _conditionResult = nullptr;
+  _returnIn.clear();
+  _returnOut.clear();
+  _swappable.clear();
+  _swaps = 0;
+  _copies = 0;
+
+  for (auto instructions : {&_condition, &_body}) {
+    for (auto& instruction : *instructions) {
+      instruction.bound = false;
+      instruction.inputs.clear();
+      instruction.outputs.clear();
+    }
+  }
+
+  for (sd::LongType iteration = 0; iteration < maxIterations; iteration++) {
+    // we're running condition scope first
+    auto status = executeScope(graph, _condition);
+    if (status != sd::Status::OK) return status;
+
+    if (_conditionResult == nullptr) {
+      auto lastNode = _condition.back().node->id();
+      if (!_variableSpace->hasVariable(lastNode)) {
+        sd_printf("While [%i]: got no results out of conditional loop\n", _whileId);
+        return sd::Status::KERNEL_FAILURE;
+      }
+
+      _conditionResult = _variableSpace->getVariable(lastNode);
+    }
+
+    // now we should take result of the Scope run, and evaluate it
+    auto result = _conditionResult->getNDArray();
+
+    if (Environment::getInstance().isDebugAndVerbose()) result->printBuffer("Result of the last node:");
+
+    // if result evaluates to 0.0 - condition returned FALSE
+    if (result->e<int>(0) == 0) return sd::Status::OK;
+
+    status = executeScope(graph, _body);
+    if (status != sd::Status::OK) return status;
+
+    // first iteration creates all intermediate variables, so we bind slots right after it
+    if (iteration == 0) {
+      LogicReturn::processNode(graph, _return);
+      bind();
+    } else {
+      returnValues();
+    }
+  }
+
+  // if we've hit breaker limit - we should notify about that
+  sd_printf("While [%i]: condition seems to be never ending, aborting...\n", _whileId);
+  return sd::Status::KERNEL_FAILURE;
+}
+}  // namespace graph
+}  // namespace sd
@@ -54,6 +54,7 @@ Context::Context(ContextPrototype *prototype, VariableSpace *variableSpace) {
     this->_isInplace = prototype->isInplace();
     this->_nodeId = prototype->nodeId();
     this->_useONEDNN = prototype->isUseONEDNN();
+    this->setFusedActivation(prototype->fusedActivation(), prototype->fusedActivationAlpha());
   }
 
   if (variableSpace != nullptr && variableSpace->launchContext()->getWorkspace() != nullptr)
@@ -468,6 +469,10 @@ void Context::allowHelpers(bool reallyAllow) { _helpersAllowed = reallyAllow; }
 
 bool Context::helpersAllowed() { return _helpersAllowed; }
 
+void Context::markFusedActivationApplied(bool reallyApplied) { _fusedActivationApplied = reallyApplied; }
+
+bool Context::isFusedActivationApplied() { return _fusedActivationApplied; }
+
 void Context::setTArguments(const std::vector<double> &tArgs) {
   for (auto t : tArgs) _tArgs.emplace_back(t);
 }
@@ -117,6 +117,8 @@ void ContextPrototype::setOpDescriptor(sd::ops::OpDescriptor* opDescriptor) { _o
 ContextPrototype* ContextPrototype::clone() {
   auto clone = new ContextPrototype(_opDescriptor, _nodeId, _isInplace);
   clone->_opNum = _opNum;
+  clone->_fusedActivation = _fusedActivation;
+  clone->_fusedActivationAlpha = _fusedActivationAlpha;
 
   for (auto v : _inputs) clone->_inputs.emplace_back(v);
 
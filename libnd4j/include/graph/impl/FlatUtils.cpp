@@ -105,6 +105,30 @@ NDArray *FlatUtils::fromFlatArray(const sd::graph::FlatArray *flatArray) {
   return array;
 }
 
+NDArray *FlatUtils::viewFlatArray(const sd::graph::FlatArray *flatArray) {
+  if (flatArray->shape() == nullptr || flatArray->buffer() == nullptr) return nullptr;
+
+  auto dtype = DataTypeUtils::fromFlatDataType(flatArray->dtype());
+  if (dtype == UTF8 || dtype == UTF16 || dtype == UTF32) return nullptr;
+
+  auto isBe = BitwiseUtils::isBE();
+  if ((isBe && flatArray->byteOrder() != sd::graph::ByteOrder_BE) ||
+      (!isBe && flatArray->byteOrder() != sd::graph::ByteOrder_LE))
+    return nullptr;
+
+  auto shapeInfo = reinterpret_cast<const sd::LongType *>(flatArray->shape()->data());
+  if (reinterpret_cast<uintptr_t>(shapeInfo) % sizeof(sd::LongType) != 0 || shape::isEmpty(shapeInfo)) return nullptr;
+
+  auto buffer = flatArray->buffer()->data();
+  auto sizeOfT = DataTypeUtils::sizeOf(dtype);
+  if (reinterpret_cast<uintptr_t>(buffer) % sizeOfT != 0 ||
+      flatArray->buffer()->size() < shape::length(shapeInfo) * sizeOfT)
+    return nullptr;
+
+  // the buffer is not owned by the array
+  return new NDArray(const_cast<int8_t *>(buffer), shapeInfo, sd::LaunchContext::defaultContext(), false);
+}
+
 flatbuffers::Offset<FlatArray> FlatUtils::toFlatArray(flatbuffers::FlatBufferBuilder &builder, NDArray &array) {
   auto byteVector = array.asByteVector();
 
@@ -127,5 +127,10 @@ bool FlowPath::wasExecuted(int nodeId) { return _states[nodeId].wasExecuted(); }
 void FlowPath::markExecuted(int nodeId, bool wasExecuted) { _states[nodeId].markExecuted(wasExecuted); }
 
 GraphProfile* FlowPath::profile() { return &_profile; }
+
+void FlowPath::reset() {
+  _states.clear();
+  _frames.clear();
+}
 }  // namespace graph
 }  // namespace sd
@@ -24,6 +24,7 @@
 #include <graph/FlatUtils.h>
 #include <graph/Graph.h>
 #include <graph/VariableProxy.h>
+#include <graph/execution/LoopProgram.h>
 #include <graph/exceptions/unresolved_input_exception.h>
 #include <graph/exceptions/unresolved_output_exception.h>
 #include <helpers/EnumUtils.h>
@@ -273,6 +274,8 @@ Graph::~Graph() {
 
   for (auto v : _scopes) delete v;
 
+  for (auto &v : _loopPrograms) delete v.second;
+
   delete _mapped;
   delete _nodes;
   delete _variableSpace;
@@ -1195,6 +1198,21 @@ Scope *Graph::scopeById(int id) {
   return _mappedScopes.at(id);
 }
 
+LoopProgram *Graph::loopProgram(int nodeId) {
+  auto it = _loopPrograms.find(nodeId);
+  return it == _loopPrograms.end() ? nullptr : it->second;
+}
+
+void Graph::putLoopProgram(int nodeId, LoopProgram *program) {
+  auto it = _loopPrograms.find(nodeId);
+  if (it != _loopPrograms.end()) {
+    if (it->second == program) return;
+    delete it->second;
+  }
+
+  _loopPrograms[nodeId] = program;
+}
+
 void Graph::forgetVariableSpace() { _variableSpace = nullptr; }
 
 void Graph::replaceState(VariableSpace *state, ExecutorConfiguration *configuration) {
@@ -35,6 +35,7 @@ void GraphHolder::registerGraph(sd::LongType graphId, Graph* graph) {
   if (hasGraphAny(graphId)) throw graph_exists_exception(graphId);
 
   _graphF[graphId] = graph;
+  _pools[graphId] = new GraphSessionPool(graph);
 
   sd::SimpleReadWriteLock lock;
   _locks[graphId] = lock;
@@ -64,6 +65,11 @@ Graph* GraphHolder::pullGraph(sd::LongType graphId) {
 
 void GraphHolder::forgetGraph(sd::LongType graphId) {
   if (this->hasGraph(graphId)) _graphF.erase(graphId);
+
+  if (_pools.count(graphId) > 0) {
+    delete _pools[graphId];
+    _pools.erase(graphId);
+  }
 }
 
 void GraphHolder::dropGraph(sd::LongType graphId) {
@@ -98,6 +104,10 @@ void GraphHolder::replaceGraph(sd::LongType graphId, Graph* graph) {
 
   _graphF[graphId] = graph;
 
+  // sessions are clones of the old graph
+  delete _pools[graphId];
+  _pools[graphId] = new GraphSessionPool(graph);
+
   this->unlockWrite(graphId);
 }
 
@@ -107,13 +117,20 @@ flatbuffers::Offset<FlatResult> GraphHolder::execute(sd::LongType graphId, flatb
 
   lockRead(graphId);
 
-  auto graph = cloneGraph(graphId);
-  auto res = GraphExecutioner::execute(graph, builder, request);
-  delete graph;
+  try {
+    auto res = _pools.at(graphId)->execute(builder, request);
+    unlockRead(graphId);
+    return res;
+  } catch (...) {
+    unlockRead(graphId);
+    throw;
+  }
+}
 
-  unlockRead(graphId);
+GraphSessionPool* GraphHolder::sessionPool(sd::LongType graphId) {
+  if (!hasGraph(graphId)) throw unknown_graph_exception(graphId);
 
-  return res;
+  return _pools.at(graphId);
 }
 }  // namespace graph
 }  // namespace sd
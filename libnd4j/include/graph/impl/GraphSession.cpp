@@ -0,0 +1,180 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Pooled execution sessions for GraphHolder
+//
+#include <exceptions/graph_execution_exception.h>
+#include <exceptions/no_results_exception.h>
+#include <graph/ExecutionResult.h>
+#include <graph/FlatUtils.h>
+#include <graph/GraphExecutioner.h>
+#include <graph/GraphSession.h>
+
+namespace sd {
+namespace graph {
+
+GraphSession::GraphSession(Graph* origin) {
+  _graph = origin->cloneWithProxy();
+  _variableSpace = static_cast<VariableProxy*>(_graph->getVariableSpace());
+
+  // arrays created while executing come from this session's workspace
+  _launchContext = new LaunchContext();
+  _launchContext->setWorkspace(&_workspace);
+
+  _variableSpace->setLaunchContext(_launchContext);
+  _variableSpace->setFlowPath(&_flowPath);
+
+  _lastUsed = std::chrono::steady_clock::now();
+}
+
+GraphSession::~GraphSession() {
+  delete _graph;
+  delete _launchContext;
+}
+
+void GraphSession::bindInputs(const FlatInferenceRequest* request) {
+  if (request == nullptr || request->variables() == nullptr) return;
+
+  auto vars = request->variables();
+  for (int e = 0; e < vars->size(); e++) {
+    auto fv = vars->Get(e);
+
+    // inputs are used straight from the request buffer when possible, it outlives the execution
+    NDArray* view = fv->ndarray() != nullptr ? FlatUtils::viewFlatArray(fv->ndarray()) : nullptr;
+
+    Variable* v;
+    if (view != nullptr) {
+      auto name = fv->name() != nullptr && fv->name()->size() != 0 ? fv->name()->c_str() : nullptr;
+      v = new Variable(view, name, fv->id()->first(), fv->id()->second());
+    } else
+      v = new Variable(fv);
+
+    _variableSpace->replaceVariable(v);
+  }
+}
+
+void GraphSession::reset() {
+  _variableSpace->reset();
+  _flowPath.reset();
+  _workspace.scopeOut();
+}
+
+flatbuffers::Offset<FlatResult> GraphSession::execute(flatbuffers::FlatBufferBuilder& builder,
+                                                      const FlatInferenceRequest* request) {
+  _lastUsed = std::chrono::steady_clock::now();
+  const sd::LongType requestId = request != nullptr ? request->id() : 0L;
+
+  // sizes the workspace after the previous request, so that it doesn't spill again
+  _workspace.scopeIn();
+
+  try {
+    bindInputs(request);
+
+    auto status = GraphExecutioner::execute(_graph);
+    if (status != sd::Status::OK) throw graph_execution_exception(requestId);
+
+    auto outputs = _graph->fetchOutputs();
+    if (outputs->size() == 0) {
+      delete outputs;
+      throw no_results_exception(requestId);
+    }
+
+    // results are serialized before the session forgets them
+    ExecutionResult result;
+    for (auto v : *outputs) result.emplace_back(v);
+
+    auto t = result.asFlatResult(builder);
+    delete outputs;
+
+    reset();
+    return t;
+  } catch (...) {
+    reset();
+    throw;
+  }
+}
+
+GraphSessionPool::GraphSessionPool(Graph* graph, sd::LongType idleTimeoutMs)
+    : _graph(graph), _idleTimeout(idleTimeoutMs) {
+  //
+}
+
+GraphSessionPool::~GraphSessionPool() {
+  for (auto s : _idle) delete s;
+}
+
+GraphSession* GraphSessionPool::acquire() {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (!_idle.empty()) {
+    auto session = _idle.back();
+    _idle.pop_back();
+    return session;
+  }
+
+  // cloning touches the original graph, so it's done under the lock
+  _created++;
+  return new GraphSession(_graph);
+}
+
+void GraphSessionPool::release(GraphSession* session) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  _idle.emplace_back(session);
+  trim(std::chrono::steady_clock::now());
+}
+
+void GraphSessionPool::trim(std::chrono::steady_clock::time_point now) {
+  // sessions are reused LIFO, so the front holds the ones idle for longest. the most recent one is always kept
+  int expired = 0;
+  while (expired < (int)_idle.size() - 1 && now - _idle[expired]->lastUsed() > _idleTimeout) expired++;
+
+  for (int e = 0; e < expired; e++) delete _idle[e];
+
+  _idle.erase(_idle.begin(), _idle.begin() + expired);
+  _created -= expired;
+}
+
+flatbuffers::Offset<FlatResult> GraphSessionPool::execute(flatbuffers::FlatBufferBuilder& builder,
+                                                          const FlatInferenceRequest* request) {
+  auto session = acquire();
+
+  try {
+    auto result = session->execute(builder, request);
+    release(session);
+    return result;
+  } catch (...) {
+    release(session);
+    throw;
+  }
+}
+
+int GraphSessionPool::size() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _created;
+}
+
+int GraphSessionPool::idle() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return static_cast<int>(_idle.size());
+}
+
+}  // namespace graph
+}  // namespace sd
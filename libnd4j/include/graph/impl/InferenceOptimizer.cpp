@@ -0,0 +1,607 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Inference-time graph rewrites
+//
+#include <graph/InferenceOptimizer.h>
+#include <ops/declarable/OpRegistrator.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+
+namespace sd {
+namespace graph {
+
+bool InferenceOptimizer::isConstant(Graph *graph, const std::pair<int, int> &input) {
+  // nodes have positive ids, variables have negative ids
+  if (input.first >= 0) return false;
+
+  std::pair<int, int> pair(input);
+  auto varSpace = graph->getVariableSpace();
+  if (!varSpace->hasVariable(pair)) return false;
+
+  auto var = varSpace->getVariable(pair);
+  return !var->isPlaceholder() && var->variableType() == VariableType::NDARRAY && var->hasNDArray();
+}
+
+NDArray *InferenceOptimizer::constantArray(Graph *graph, const std::pair<int, int> &input) {
+  std::pair<int, int> pair(input);
+  return graph->getVariableSpace()->getVariable(pair)->getNDArray();
+}
+
+int InferenceOptimizer::putConstant(Graph *graph, NDArray *array) {
+  auto varSpace = graph->getVariableSpace();
+
+  int id = -1;
+  for (auto v : varSpace->getVariables()) id = sd::math::sd_min<int>(id, v->id() - 1);
+
+  varSpace->putVariable(id, array);
+  return id;
+}
+
+std::string InferenceOptimizer::opName(Node *node) {
+  if (node->opType() != OpType_CUSTOM || !node->hasCustomOp()) return "";
+
+  return *node->getCustomOp()->getOpName();
+}
+
+std::vector<Node *> InferenceOptimizer::consumersOf(Graph *graph, int nodeId) {
+  std::vector<Node *> result;
+  for (auto &v : *graph->getMapped()) {
+    auto inputs = v.second->input();
+    if (std::any_of(inputs->begin(), inputs->end(), [&](const std::pair<int, int> &p) { return p.first == nodeId; }))
+      result.emplace_back(v.second);
+  }
+
+  return result;
+}
+
+bool InferenceOptimizer::isExclusiveProducer(Graph *graph, Node *producer, Node *consumer) {
+  if (!producer->hasCustomOp() || !consumer->hasCustomOp()) return false;
+
+  // we don't touch anything within scopes or loop frames
+  if (producer->isScoped() || consumer->isScoped()) return false;
+
+  // producer output must not be observable anywhere except consumer
+  auto outputs = graph->output();
+  if (std::find(outputs->begin(), outputs->end(), producer->id()) != outputs->end()) return false;
+
+  auto consumers = consumersOf(graph, producer->id());
+  if (consumers.size() != 1 || consumers[0] != consumer) return false;
+
+  auto inputs = consumer->input();
+  auto uses = std::count_if(inputs->begin(), inputs->end(),
+                            [&](const std::pair<int, int> &p) { return p.first == producer->id(); });
+
+  return uses == 1 && inputs->at(0).first == producer->id() && inputs->at(0).second == 0;
+}
+
+Node *InferenceOptimizer::rebuildNode(Node *origin, int id, const std::vector<std::pair<int, int>> &inputs,
+                                      sd::ops::DeclarableOp *op) {
+  auto node = new Node(op != nullptr ? op : origin->getCustomOp(), id);
+  for (const auto &v : inputs) node->pickInput(v.first, v.second);
+
+  // prototype picks inputs from node on first access
+  node->getContextPrototype();
+  if (op == nullptr) copyArguments(origin, node);
+
+  return node;
+}
+
+void InferenceOptimizer::copyArguments(Node *origin, Node *node) {
+  auto block = node->getContextPrototype();
+  auto originBlock = origin->getContextPrototype();
+
+  for (auto v : *originBlock->getIArguments()) block->getIArguments()->emplace_back(v);
+  for (auto v : *originBlock->getTArguments()) block->getTArguments()->emplace_back(v);
+  for (auto v : *originBlock->getBArguments()) block->getBArguments()->emplace_back(v);
+  for (auto v : *originBlock->getDArguments()) block->getDArguments()->emplace_back(v);
+  for (auto v : *originBlock->getAxis()) block->getAxis()->emplace_back(v);
+
+  block->setFusedActivation(originBlock->fusedActivation(), originBlock->fusedActivationAlpha());
+}
+
+void InferenceOptimizer::replaceNode(Graph *graph, Node *oldNode, Node *newNode) {
+  newNode->setLayer(oldNode->getLayer());
+  newNode->setName(*oldNode->getName());
+
+  auto layer = graph->getOnion()->at(oldNode->getLayer());
+  std::replace(layer->begin(), layer->end(), oldNode, newNode);
+
+  auto handles = graph->getAllNodes();
+  std::replace(handles->begin(), handles->end(), oldNode, newNode);
+
+  (*graph->getMapped())[oldNode->id()] = newNode;
+
+  delete oldNode;
+}
+
+void InferenceOptimizer::removeNode(Graph *graph, Node *node) {
+  auto layer = graph->getOnion()->at(node->getLayer());
+  layer->erase(std::remove(layer->begin(), layer->end(), node), layer->end());
+
+  auto handles = graph->getAllNodes();
+  handles->erase(std::remove(handles->begin(), handles->end(), node), handles->end());
+
+  auto ids = graph->nodes();
+  ids->erase(std::remove(ids->begin(), ids->end(), node->id()), ids->end());
+
+  graph->getMapped()->erase(node->id());
+
+  delete node;
+}
+
+bool InferenceOptimizer::foldBatchNorm(Graph *graph, Node *producer, Node *norm) {
+  const auto pName = opName(producer);
+  const auto nName = opName(norm);
+  auto pBlock = producer->getContextPrototype();
+  auto nBlock = norm->getContextPrototype();
+  auto pInputs = *producer->input();
+  auto nInputs = *norm->input();
+
+  if (pBlock->fusedActivation() != FUSED_NONE || pInputs.size() < 2 || !isConstant(graph, pInputs[1])) return false;
+
+  auto &pIArgs = *pBlock->getIArguments();
+  auto &pTArgs = *pBlock->getTArguments();
+
+  // output channel axis of producer, and output channel axis of its weights
+  int channelAxis, weightsAxis, outRank;
+  if (pName == "conv2d") {
+    if (pIArgs.size() < 9) return false;
+
+    const int isNCHW = pIArgs.size() > 9 ? !pIArgs[9] : 1;
+    const int wFormat = pIArgs.size() > 10 ? pIArgs[10] : 0;
+    channelAxis = isNCHW ? 1 : 3;
+    weightsAxis = 0 == wFormat ? 3 : 0;
+    outRank = 4;
+  } else if (pName == "xw_plus_b") {
+    if (std::any_of(pIArgs.begin(), pIArgs.end(), [](int v) { return v != 0; }) || pInputs.size() < 3) return false;
+
+    channelAxis = 1;
+    weightsAxis = 1;
+    outRank = 2;
+  } else if (pName == "matmul") {
+    if (std::any_of(pIArgs.begin(), pIArgs.end(), [](int v) { return v != 0; })) return false;
+    if ((pTArgs.size() > 0 && pTArgs[0] != 1.0) || (pTArgs.size() > 1 && pTArgs[1] != 0.0)) return false;
+
+    // rank of x is unknown here, so only last axis is acceptable
+    channelAxis = -1;
+    weightsAxis = 1;
+    outRank = -1;
+  } else {
+    return false;
+  }
+
+  auto weights = constantArray(graph, pInputs[1]);
+  if (weightsAxis >= weights->rankOf() || (pName == "matmul" && weights->rankOf() != 2)) return false;
+
+  const auto numChannels = weights->sizeAt(weightsAxis);
+
+  std::pair<int, int> meanId, varianceId, gammaId(0, -1), betaId(0, -1);
+  double epsilon;
+
+  if (nName == "batchnorm") {
+    auto &iArgs = *nBlock->getIArguments();
+    if (iArgs.size() < 2 || iArgs.size() > 3 || nBlock->getTArguments()->empty()) return false;
+
+    const bool applyScale = iArgs[0];
+    const bool applyOffset = iArgs[1];
+    if (nInputs.size() != 3 + (int)applyScale + (int)applyOffset) return false;
+
+    int axis = iArgs.size() > 2 ? iArgs[2] : -1;
+    if (outRank > 0 && axis < 0) axis += outRank;
+    if (axis != channelAxis) return false;
+
+    meanId = nInputs[1];
+    varianceId = nInputs[2];
+    if (applyScale) gammaId = nInputs[3];
+    if (applyOffset) betaId = nInputs[3 + (int)applyScale];
+    epsilon = nBlock->getTArguments()->at(0);
+  } else if (nName == "fused_batch_norm") {
+    auto &iArgs = *nBlock->getIArguments();
+    if (pName != "conv2d" || iArgs.size() < 2 || iArgs[1] != 0 || nInputs.size() < 5) return false;
+
+    // data format: 0 - NHWC, 1 - NCHW
+    if ((iArgs[0] ? 1 : 3) != channelAxis) return false;
+
+    // batch mean and variance outputs will not be produced anymore
+    auto outputs = graph->output();
+    if (std::find(outputs->begin(), outputs->end(), norm->id()) != outputs->end()) return false;
+    for (auto c : consumersOf(graph, norm->id()))
+      for (const auto &p : *c->input())
+        if (p.first == norm->id() && p.second != 0) return false;
+
+    gammaId = nInputs[1];
+    betaId = nInputs[2];
+    meanId = nInputs[3];
+    varianceId = nInputs[4];
+    epsilon = nBlock->getTArguments()->empty() ? 0.001 : sd::math::sd_max<double>(nBlock->getTArguments()->at(0), 1.001e-5);
+  } else {
+    return false;
+  }
+
+  // all normalization parameters must be frozen vectors of proper length
+  for (const auto &p : {meanId, varianceId, gammaId, betaId}) {
+    if (p.second < 0) continue;
+
+    if (!isConstant(graph, p)) return false;
+
+    auto array = constantArray(graph, p);
+    if (array->lengthOf() != numChannels) return false;
+  }
+
+  NDArray *bias = nullptr;
+  if (pName != "matmul" && pInputs.size() > 2) {
+    if (!isConstant(graph, pInputs[2])) return false;
+
+    bias = constantArray(graph, pInputs[2]);
+    if (bias->lengthOf() != numChannels) return false;
+  }
+
+  // scale = gamma / sqrt(variance + epsilon), shift = (bias - mean) * scale + beta
+  const auto dataType = weights->dataType();
+  auto vector = [&](const std::pair<int, int> &p) {
+    auto array = constantArray(graph, p);
+    return array->cast(dataType).reshape('c', {numChannels});
+  };
+
+  NDArray scale = vector(varianceId) + epsilon;
+  scale.applyTransform(transform::RSqrt, scale);
+  if (gammaId.second >= 0) scale *= vector(gammaId);
+
+  NDArray shift = bias != nullptr ? bias->cast(dataType).reshape('c', {numChannels}) - vector(meanId)
+                                  : vector(meanId) * -1.0;
+  shift *= scale;
+  if (betaId.second >= 0) shift += vector(betaId);
+
+  auto foldedWeights = new NDArray(weights->ulike());
+  weights->applyBroadcast(broadcast::Multiply, {weightsAxis}, scale, *foldedWeights);
+  auto foldedBias = new NDArray(shift);
+
+  const std::pair<int, int> weightsId(putConstant(graph, foldedWeights), 0);
+  const std::pair<int, int> biasId(putConstant(graph, foldedBias), 0);
+
+  if (pName == "matmul") {
+    // matmul has no bias, so normalization is replaced with biasadd over folded shift
+    producer->input()->at(1) = weightsId;
+    pBlock->inputs()->at(1) = weightsId;
+
+    auto biasAdd = rebuildNode(norm, norm->id(), {{producer->id(), 0}, biasId},
+                               sd::ops::OpRegistrator::getInstance().getOperation("biasadd"));
+    replaceNode(graph, norm, biasAdd);
+  } else {
+    auto folded = rebuildNode(producer, norm->id(), {pInputs[0], weightsId, biasId});
+    replaceNode(graph, norm, folded);
+    removeNode(graph, producer);
+  }
+
+  return true;
+}
+
+bool InferenceOptimizer::foldBiasAdd(Graph *graph, Node *producer, Node *biasAdd) {
+  const auto pName = opName(producer);
+  auto pBlock = producer->getContextPrototype();
+  auto pInputs = *producer->input();
+  auto bInputs = *biasAdd->input();
+
+  if (pBlock->fusedActivation() != FUSED_NONE || pInputs.size() < 2 || bInputs.size() != 2) return false;
+  if (!isConstant(graph, bInputs[1])) return false;
+
+  auto &pIArgs = *pBlock->getIArguments();
+  const bool isNCHW = !biasAdd->getContextPrototype()->getBArguments()->empty() &&
+                      biasAdd->getContextPrototype()->getBArguments()->at(0);
+
+  if (pName == "conv2d") {
+    if (pIArgs.size() < 9) return false;
+
+    const int convNCHW = pIArgs.size() > 9 ? !pIArgs[9] : 1;
+    if (convNCHW != (int)isNCHW) return false;
+  } else if (pName == "xw_plus_b") {
+    if (std::any_of(pIArgs.begin(), pIArgs.end(), [](int v) { return v != 0; }) || pInputs.size() < 3) return false;
+  } else {
+    return false;
+  }
+
+  auto addition = constantArray(graph, bInputs[1]);
+  if (addition->rankOf() != 1) return false;
+
+  NDArray *folded;
+  if (pInputs.size() > 2) {
+    if (!isConstant(graph, pInputs[2])) return false;
+
+    auto bias = constantArray(graph, pInputs[2]);
+    if (bias->lengthOf() != addition->lengthOf()) return false;
+
+    folded = new NDArray(bias->reshape('c', {bias->lengthOf()}) + addition->cast(bias->dataType()));
+  } else {
+    folded = new NDArray(addition->dup());
+  }
+
+  const std::pair<int, int> biasId(putConstant(graph, folded), 0);
+
+  auto node = rebuildNode(producer, biasAdd->id(), {pInputs[0], pInputs[1], biasId});
+  replaceNode(graph, biasAdd, node);
+  removeNode(graph, producer);
+
+  return true;
+}
+
+bool InferenceOptimizer::fuseActivation(Graph *graph, Node *producer, Node *activation) {
+  const auto pName = opName(producer);
+  const auto aName = opName(activation);
+
+  if (pName != "conv2d" && pName != "xw_plus_b" && pName != "matmul" && pName != "biasadd") return false;
+  if (producer->getContextPrototype()->fusedActivation() != FUSED_NONE || activation->input()->size() != 1)
+    return false;
+
+  auto &tArgs = *activation->getContextPrototype()->getTArguments();
+
+  FusedActivation kind;
+  double alpha = 0.0;
+  if (aName == "relu") {
+    kind = FUSED_RELU;
+    alpha = tArgs.empty() ? 0.0 : tArgs[0];
+  } else if (aName == "relu6") {
+    kind = FUSED_RELU6;
+    alpha = tArgs.empty() ? 0.0 : tArgs[0];
+  } else if (aName == "lrelu") {
+    kind = FUSED_LRELU;
+    alpha = tArgs.empty() ? 0.01 : tArgs[0];
+  } else if (aName == "sigmoid") {
+    kind = FUSED_SIGMOID;
+  } else if (aName == "tanh") {
+    kind = FUSED_TANH;
+  } else {
+    return false;
+  }
+
+  auto node = rebuildNode(producer, activation->id(), *producer->input());
+  node->getContextPrototype()->setFusedActivation(kind, alpha);
+
+  replaceNode(graph, activation, node);
+  removeNode(graph, producer);
+
+  return true;
+}
+
+int InferenceOptimizer::foldNormalization(Graph *graph) {
+  if (!graph->built()) graph->buildGraph();
+
+  int cnt = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    for (auto &v : *graph->getMapped()) {
+      auto node = v.second;
+      const auto name = opName(node);
+      if (name != "batchnorm" && name != "fused_batch_norm" && name != "biasadd") continue;
+
+      auto input = node->input()->at(0);
+      if (graph->getMapped()->count(input.first) == 0) continue;
+
+      auto producer = graph->getMapped()->at(input.first);
+      if (!isExclusiveProducer(graph, producer, node)) continue;
+
+      // graph is modified on success, so iteration starts over
+      if (name == "biasadd" ? foldBiasAdd(graph, producer, node) : foldBatchNorm(graph, producer, node)) {
+        cnt++;
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  return cnt;
+}
+
+int InferenceOptimizer::fuseActivations(Graph *graph) {
+  if (!graph->built()) graph->buildGraph();
+
+  int cnt = 0;
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    for (auto &v : *graph->getMapped()) {
+      auto node = v.second;
+      if (!node->hasCustomOp() || node->input()->empty()) continue;
+
+      auto input = node->input()->at(0);
+      if (graph->getMapped()->count(input.first) == 0) continue;
+
+      auto producer = graph->getMapped()->at(input.first);
+      if (!isExclusiveProducer(graph, producer, node)) continue;
+
+      if (fuseActivation(graph, producer, node)) {
+        cnt++;
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  return cnt;
+}
+
+bool InferenceOptimizer::isBlockedAnchor(const std::string &name) {
+  return name == "conv2d" || name == "maxpool2d" || name == "avgpool2d" || name == "upsampling2d";
+}
+
+bool InferenceOptimizer::isLayoutAgnostic(const std::string &name) {
+  // these ops don't care about layout, and keep zero-padded tail channels finite
+  static const std::vector<std::string> names = {"relu", "relu6",   "lrelu",    "elu",     "sigmoid", "tanh",
+                                                 "add",  "subtract", "multiply", "maximum", "minimum"};
+
+  return std::find(names.begin(), names.end(), name) != names.end();
+}
+
+sd::LongType InferenceOptimizer::channelsOf(Graph *graph, Node *node) {
+  const auto name = opName(node);
+  auto inputs = node->input();
+
+  if (name == "conv2d") {
+    if (inputs->size() < 2 || !isConstant(graph, inputs->at(1))) return -1;
+
+    auto iArgs = node->getContextPrototype()->getIArguments();
+    const int wFormat = iArgs->size() > 10 ? iArgs->at(10) : 0;
+    return constantArray(graph, inputs->at(1))->sizeAt(0 == wFormat ? 3 : 0);
+  }
+
+  // everything else keeps number of channels
+  if (inputs->empty() || graph->getMapped()->count(inputs->at(0).first) == 0) return -1;
+
+  return channelsOf(graph, graph->getMapped()->at(inputs->at(0).first));
+}
+
+int InferenceOptimizer::propagateBlockedLayout(Graph *graph) {
+  if (!graph->built()) graph->buildGraph();
+
+  auto mapped = graph->getMapped();
+  auto outputs = graph->output();
+
+  // candidates for blocked layout, shrinking until consistent
+  std::vector<int> blocked;
+  for (auto &v : *mapped) {
+    auto node = v.second;
+    const auto name = opName(node);
+    if (node->isScoped() || node->input()->empty()) continue;
+
+    const auto numIArgs = node->getContextPrototype()->getIArguments()->size();
+    if (isLayoutAgnostic(name) || (name == "upsampling2d" && numIArgs >= 2) ||
+        ((name == "conv2d" || name == "maxpool2d") && numIArgs >= 9) || (name == "avgpool2d" && numIArgs >= 10))
+      blocked.emplace_back(v.first);
+  }
+
+  auto isBlocked = [&](int id) -> bool { return std::find(blocked.begin(), blocked.end(), id) != blocked.end(); };
+
+  // output stays blocked when every consumer accepts blocked array
+  auto hasBlockedOutput = [&](int id) -> bool {
+    if (!isBlocked(id) || std::find(outputs->begin(), outputs->end(), id) != outputs->end()) return false;
+
+    auto consumers = consumersOf(graph, id);
+    if (consumers.empty()) return false;
+
+    for (auto c : consumers) {
+      if (!isBlocked(c->id())) return false;
+
+      auto inputs = c->input();
+      for (size_t e = 0; e < inputs->size(); e++) {
+        if (inputs->at(e).first != id) continue;
+
+        if (inputs->at(e).second != 0 || (isBlockedAnchor(opName(c)) && e != 0)) return false;
+      }
+    }
+
+    return true;
+  };
+
+  auto hasBlockedInput = [&](const std::pair<int, int> &input) -> bool {
+    return mapped->count(input.first) > 0 && hasBlockedOutput(input.first);
+  };
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+
+    for (auto it = blocked.begin(); it != blocked.end(); ++it) {
+      auto node = mapped->at(*it);
+      const auto name = opName(node);
+
+      bool keep;
+      if (isLayoutAgnostic(name)) {
+        // elementwise op can't reorder, so all its inputs and consumers must be blocked
+        auto inputs = node->input();
+        keep = hasBlockedOutput(node->id()) && std::all_of(inputs->begin(), inputs->end(), hasBlockedInput);
+      } else {
+        const bool in = hasBlockedInput(node->input()->at(0));
+        const bool out = hasBlockedOutput(node->id());
+
+        // lone layer gains nothing from reordering
+        keep = in || out;
+
+        // pooling and upsampling need number of channels to leave blocked layout
+        if (keep && in && !out && name != "conv2d") keep = channelsOf(graph, node) > 0;
+      }
+
+      if (!keep) {
+        blocked.erase(it);
+        changed = true;
+        break;
+      }
+    }
+  }
+
+  // collect layout flags and channels first, since rewriting invalidates nodes
+  struct Rewrite {
+    int id;
+    bool in;
+    bool out;
+    sd::LongType channels;
+  };
+
+  std::vector<Rewrite> rewrites;
+  for (auto id : blocked) {
+    auto node = mapped->at(id);
+    if (isBlockedAnchor(opName(node)))
+      rewrites.push_back({id, hasBlockedInput(node->input()->at(0)), hasBlockedOutput(id), channelsOf(graph, node)});
+  }
+
+  for (const auto &r : rewrites) {
+    auto origin = mapped->at(r.id);
+    const auto name = opName(origin);
+    std::string blockedName = name + "_nchwc";
+
+    auto node = rebuildNode(origin, origin->id(), *origin->input(),
+                            sd::ops::OpRegistrator::getInstance().getOperation(blockedName));
+    copyArguments(origin, node);
+
+    auto block = node->getContextPrototype();
+    block->getBArguments()->clear();
+    block->getBArguments()->emplace_back(r.in);
+    block->getBArguments()->emplace_back(r.out);
+
+    if (r.in && !r.out && name != "conv2d") {
+      // number of channels goes after all optional IntArgs
+      auto iArgs = block->getIArguments();
+      const size_t position = name == "upsampling2d" ? 3 : 11;
+      while (iArgs->size() < position) iArgs->emplace_back(name == "maxpool2d" && iArgs->size() == 9 ? 1 : 0);
+      iArgs->resize(position);
+      iArgs->emplace_back(r.channels);
+    }
+
+    replaceNode(graph, origin, node);
+  }
+
+  return rewrites.size();
+}
+
+int InferenceOptimizer::optimize(Graph *graph) {
+  int cnt = foldNormalization(graph) + fuseActivations(graph);
+
+#ifndef __CUDABLAS__
+  // blocked layout pays off with SIMD kernels only, and is opt-in until blocked convolution beats im2col + GEMM
+  if (sd::Environment::getInstance().blockedLayout()) cnt += propagateBlockedLayout(graph);
+#endif
+
+  return cnt;
+}
+
+}  // namespace graph
+}  // namespace sd
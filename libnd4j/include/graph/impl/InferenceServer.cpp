@@ -0,0 +1,352 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// In-process batching front-end of GraphHolder, see InferenceServer.h
+//
+#include <array/NDArray.h>
+#include <graph/ExecutionResult.h>
+#include <graph/FlatUtils.h>
+#include <graph/InferenceRequest.h>
+#include <graph/InferenceServer.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace sd {
+namespace graph {
+
+// index ranges selecting rows [first, first + rows) of an array of given rank
+static std::vector<sd::LongType> rowRange(sd::LongType first, sd::LongType rows, int rank) {
+  std::vector<sd::LongType> range(2 * rank, 0);
+  range[0] = first;
+  range[1] = first + rows;
+  return range;
+}
+
+InferenceServer::InferenceServer(const BatchingOptions& options) : _options(options) {
+  if (_options.maxBatchSize < 1) _options.maxBatchSize = 1;
+  if (_options.maxQueueDelayUs < 0) _options.maxQueueDelayUs = 0;
+  if (_options.numWorkers < 1) _options.numWorkers = 1;
+
+  for (int e = 0; e < _options.numWorkers; e++) _workers.emplace_back(&InferenceServer::workerLoop, this);
+}
+
+InferenceServer::~InferenceServer() {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopped = true;
+  }
+  _condition.notify_all();
+
+  // workers drain the queues before leaving
+  for (auto& worker : _workers) worker.join();
+}
+
+sd::Status InferenceServer::registerGraph(const FlatGraph* graph) {
+  try {
+    GraphHolder::getInstance().registerGraph(graph->id(), new Graph(graph));
+    return sd::Status::OK;
+  } catch (std::exception& e) {
+    sd_printf("InferenceServer: can't register graph [%lld]: %s\n", (long long)graph->id(), e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
+sd::Status InferenceServer::forgetGraph(const FlatDropRequest* request) {
+  GraphHolder::getInstance().dropGraphAny(request->id());
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _batchable.erase(request->id());
+  return sd::Status::OK;
+}
+
+sd::Status InferenceServer::replaceGraph(const FlatGraph* graph) {
+  try {
+    auto& holder = GraphHolder::getInstance();
+    auto replacement = new Graph(graph);
+    auto previous = holder.hasGraph(graph->id()) ? holder.pullGraph(graph->id()) : nullptr;
+
+    // replaceGraph waits for the running requests, nothing refers to the previous graph afterwards
+    holder.replaceGraph(graph->id(), replacement);
+    delete previous;
+
+    return sd::Status::OK;
+  } catch (std::exception& e) {
+    sd_printf("InferenceServer: can't replace graph [%lld]: %s\n", (long long)graph->id(), e.what());
+    return sd::Status::BAD_INPUT;
+  }
+}
+
+void InferenceServer::setBatchable(sd::LongType graphId, bool batchable) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _batchable[graphId] = batchable;
+}
+
+std::future<std::vector<uint8_t>> InferenceServer::submit(std::vector<uint8_t> request) {
+  auto pending = std::make_shared<PendingRequest>();
+  auto future = pending->result.get_future();
+  pending->buffer = std::move(request);
+
+  flatbuffers::Verifier verifier(pending->buffer.data(), pending->buffer.size());
+  if (pending->buffer.empty() || !VerifyFlatInferenceRequestBuffer(verifier)) {
+    pending->result.set_exception(
+        std::make_exception_ptr(std::invalid_argument("InferenceServer: malformed FlatInferenceRequest")));
+    return future;
+  }
+
+  pending->request = GetFlatInferenceRequest(pending->buffer.data());
+  describe(*pending);
+  pending->enqueued = std::chrono::steady_clock::now();
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_stopped) {
+      pending->result.set_exception(
+          std::make_exception_ptr(std::runtime_error("InferenceServer: server is shutting down")));
+      return future;
+    }
+
+    auto batchable = _batchable.find(pending->request->id());
+    if (batchable == _batchable.end() ? !_options.batchByDefault : !batchable->second) pending->rows = 0;
+
+    _queues[pending->request->id()].emplace_back(pending);
+  }
+  _condition.notify_one();
+
+  return future;
+}
+
+std::vector<uint8_t> InferenceServer::inferenceRequest(std::vector<uint8_t> request) {
+  return submit(std::move(request)).get();
+}
+
+void InferenceServer::describe(PendingRequest& pending) {
+  pending.rows = 0;
+
+  auto variables = pending.request->variables();
+  if (variables == nullptr || variables->size() == 0) return;
+
+  sd::LongType rows = -1;
+  std::string signature;
+  for (int e = 0; e < variables->size(); e++) {
+    auto variable = variables->Get(e);
+    auto array = variable->ndarray();
+    if (array == nullptr || array->shape() == nullptr || array->shape()->size() < 2) return;
+
+    // strings have no fixed row size
+    if (array->dtype() >= DType_UTF8) return;
+
+    // shape holds the shapeInfo: rank, dimensions, strides...
+    auto shape = array->shape();
+    auto rank = shape->Get(0);
+    if (rank < 1 || shape->size() < rank + 1) return;
+
+    auto first = shape->Get(1);
+    if (first < 1 || (rows >= 0 && first != rows)) return;
+    rows = first;
+
+    if (variable->id() != nullptr)
+      signature += std::to_string(variable->id()->first()) + ":" + std::to_string(variable->id()->second());
+    if (variable->name() != nullptr) signature += ":" + variable->name()->str();
+    signature += ":" + std::to_string(static_cast<int>(array->dtype()));
+    for (int d = 2; d <= rank; d++) signature += "," + std::to_string(shape->Get(d));
+    signature += ";";
+  }
+
+  pending.rows = rows;
+  pending.signature = signature;
+}
+
+bool InferenceServer::takeBatch(std::vector<PendingPtr>& batch, std::chrono::steady_clock::time_point& deadline) {
+  auto now = std::chrono::steady_clock::now();
+  auto delay = std::chrono::microseconds(_options.maxQueueDelayUs);
+
+  std::deque<PendingPtr>* chosen = nullptr;
+  sd::LongType chosenId = 0;
+  std::vector<PendingPtr> candidates;
+
+  for (auto& entry : _queues) {
+    auto& queue = entry.second;
+    if (queue.empty()) continue;
+
+    auto head = queue.front();
+
+    // the oldest ready queue goes first
+    if (chosen != nullptr && chosen->front()->enqueued <= head->enqueued) continue;
+
+    std::vector<PendingPtr> collected;
+    sd::LongType rows = 0;
+    if (head->rows == 0 || head->rows >= _options.maxBatchSize) {
+      collected.emplace_back(head);
+      rows = _options.maxBatchSize;
+    } else {
+      for (auto& pending : queue) {
+        if (pending->rows == 0 || pending->signature != head->signature) continue;
+        if (rows + pending->rows > _options.maxBatchSize) break;
+
+        collected.emplace_back(pending);
+        rows += pending->rows;
+        if (rows == _options.maxBatchSize) break;
+      }
+    }
+
+    if (rows >= _options.maxBatchSize || now >= head->enqueued + delay || _stopped) {
+      chosen = &queue;
+      chosenId = entry.first;
+      candidates = std::move(collected);
+    } else {
+      deadline = std::min(deadline, head->enqueued + delay);
+    }
+  }
+
+  if (chosen == nullptr) return false;
+
+  for (auto& pending : candidates) chosen->erase(std::find(chosen->begin(), chosen->end(), pending));
+  if (chosen->empty()) _queues.erase(chosenId);
+
+  batch = std::move(candidates);
+  return true;
+}
+
+void InferenceServer::workerLoop() {
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (true) {
+    std::vector<PendingPtr> batch;
+    auto deadline = std::chrono::steady_clock::time_point::max();
+
+    if (takeBatch(batch, deadline)) {
+      lock.unlock();
+      executeBatch(batch);
+      lock.lock();
+      continue;
+    }
+
+    // once stopped every queue is ready, so nothing is left behind
+    if (_stopped) return;
+
+    if (deadline == std::chrono::steady_clock::time_point::max())
+      _condition.wait(lock);
+    else
+      _condition.wait_until(lock, deadline);
+  }
+}
+
+std::vector<uint8_t> InferenceServer::executeSingle(PendingRequest& pending) {
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto result = GraphHolder::getInstance().execute(pending.request->id(), builder, pending.request);
+  builder.Finish(result);
+
+  return std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
+}
+
+void InferenceServer::executeBatch(std::vector<PendingPtr>& batch) {
+  _batches++;
+  _requests += batch.size();
+
+  if (batch.size() == 1) {
+    try {
+      batch[0]->result.set_value(executeSingle(*batch[0]));
+    } catch (...) {
+      batch[0]->result.set_exception(std::current_exception());
+    }
+    return;
+  }
+
+  size_t served = 0;
+  try {
+    auto graphId = batch[0]->request->id();
+    auto variables = batch[0]->request->variables();
+
+    sd::LongType totalRows = 0;
+    for (auto& pending : batch) totalRows += pending->rows;
+
+    // every input is concatenated along the first dimension, in the order of requests
+    std::vector<std::unique_ptr<NDArray>> inputs;
+    InferenceRequest merged(graphId);
+    for (int e = 0; e < variables->size(); e++) {
+      std::unique_ptr<NDArray> combined;
+      sd::LongType offset = 0;
+      for (auto& pending : batch) {
+        std::unique_ptr<NDArray> part(FlatUtils::fromFlatArray(pending->request->variables()->Get(e)->ndarray()));
+        if (combined == nullptr) {
+          auto shape = part->getShapeAsVector();
+          shape[0] = totalRows;
+          combined.reset(new NDArray('c', shape, part->dataType()));
+        }
+
+        (*combined)(rowRange(offset, part->sizeAt(0), part->rankOf())).assign(*part);
+        offset += part->sizeAt(0);
+      }
+
+      auto variable = variables->Get(e);
+      std::string name = variable->name() != nullptr ? variable->name()->str() : std::string();
+      int id = variable->id() != nullptr ? static_cast<int>(variable->id()->first()) : 0;
+      int index = variable->id() != nullptr ? static_cast<int>(variable->id()->second()) : 0;
+
+      merged.appendVariable(name, id, index, combined.get());
+      inputs.emplace_back(std::move(combined));
+    }
+
+    flatbuffers::FlatBufferBuilder requestBuilder(1024);
+    requestBuilder.Finish(merged.asFlatInferenceRequest(requestBuilder));
+
+    flatbuffers::FlatBufferBuilder resultBuilder(1024);
+    resultBuilder.Finish(GraphHolder::getInstance().execute(
+        graphId, resultBuilder, GetFlatInferenceRequest(requestBuilder.GetBufferPointer())));
+
+    ExecutionResult outputs(GetFlatResult(resultBuilder.GetBufferPointer()));
+
+    // outputs with the batch as first dimension are split back, the rest is shared by every request
+    sd::LongType offset = 0;
+    for (auto& pending : batch) {
+      std::vector<std::unique_ptr<Variable>> owned;
+      ExecutionResult result;
+      for (int o = 0; o < outputs.size(); o++) {
+        auto output = outputs.at(o);
+        auto array = output->getNDArray();
+        if (array == nullptr) continue;
+
+        NDArray* part;
+        if (!array->isEmpty() && array->rankOf() > 0 && array->sizeAt(0) == totalRows)
+          part = new NDArray((*array)(rowRange(offset, pending->rows, array->rankOf())).dup());
+        else
+          part = new NDArray(array->dup());
+
+        auto name = output->getName();
+        owned.emplace_back(new Variable(part, name != nullptr ? name->c_str() : nullptr, output->id(), output->index()));
+        result.emplace_back(owned.back().get());
+      }
+
+      flatbuffers::FlatBufferBuilder builder(1024);
+      builder.Finish(result.asFlatResult(builder));
+
+      pending->result.set_value(
+          std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize()));
+      served++;
+      offset += pending->rows;
+    }
+  } catch (...) {
+    auto error = std::current_exception();
+    for (size_t e = served; e < batch.size(); e++) batch[e]->result.set_exception(error);
+  }
+}
+
+}  // namespace graph
+}  // namespace sd
@@ -154,6 +154,14 @@ void VariableProxy::setFlowPath(FlowPath *timers) { _current->setFlowPath(timers
 
 FlowPath *VariableProxy::flowPath() { return _current->flowPath(); }
 
+void VariableProxy::reset() {
+  auto flow = _current->flowPath();
+  delete _current;
+
+  _current = new VariableSpace();
+  _current->setFlowPath(flow);
+}
+
 void VariableProxy::putOutputVariable(Variable *variable) { _current->putOutputVariable(variable); }
 
 sd::LongType VariableProxy::externalMemory() { return _backed->externalMemory() + _current->externalMemory(); }
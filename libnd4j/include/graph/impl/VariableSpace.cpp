@@ -297,7 +297,11 @@ sd::graph::Variable* sd::graph::VariableSpace::getVariable(int id) {
   }
 }
 
-LaunchContext* sd::graph::VariableSpace::launchContext() { return LaunchContext::defaultContext(); }
+LaunchContext* sd::graph::VariableSpace::launchContext() {
+  return _launchContext != nullptr ? _launchContext : LaunchContext::defaultContext();
+}
+
+void sd::graph::VariableSpace::setLaunchContext(LaunchContext* context) { _launchContext = context; }
 
 std::vector<Variable*>* sd::graph::VariableSpace::handles() { return _handles; }
 
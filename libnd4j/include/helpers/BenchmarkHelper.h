@@ -27,6 +27,8 @@
 #include <array/ResultSet.h>
 #include <graph/Context.h>
 #include <helpers/OpBenchmark.h>
+#include <helpers/benchmark/BenchmarkReport.h>
+#include <helpers/benchmark/BenchmarkStats.h>
 #include <helpers/benchmark/BoolParameters.h>
 #include <helpers/benchmark/BroadcastBenchmark.h>
 #include <helpers/benchmark/DeclarableBenchmark.h>
@@ -50,6 +52,12 @@ class SD_LIB_EXPORT BenchmarkHelper {
   unsigned int _wIterations;
   unsigned int _rIterations;
 
+  // when set, the runOperationSuit calls append records here instead of returning text rows
+  BenchmarkReport *_report = nullptr;
+  std::string _suite;
+  std::vector<int> _threads;
+  std::map<std::string, int> _parameters;
+
  protected:
   std::string benchmarkOperation(OpBenchmark &benchmark);
 
@@ -107,6 +115,28 @@ class SD_LIB_EXPORT BenchmarkHelper {
 
   std::string runOperationSuit(DeclarableBenchmark *op, const std::function<Context *(Parameters &)> &func,
                                ParametersBatch &parametersBatch, const char *message = nullptr);
+
+  /**
+   * times func after the warmup iterations, with nanosecond resolution
+   */
+  BenchmarkStats measure(const std::function<void()> &func);
+
+  /**
+   * times the benchmark once per thread count, the thread limits are restored afterwards
+   */
+  std::vector<BenchmarkRecord> measure(OpBenchmark &benchmark, const std::string &suite,
+                                       const std::vector<int> &threads);
+
+  /**
+   * routes the runOperationSuit calls into the report, timing each benchmark once per thread count.
+   * passing nullptr restores the text output
+   */
+  void setReport(BenchmarkReport *report, const std::string &suite = "", const std::vector<int> &threads = {});
+
+  /**
+   * limits the library to the given number of threads
+   */
+  static void setThreads(int threads);
 };
 }  // namespace sd
 
@@ -97,6 +97,12 @@ typedef void (*CblasDgemmBatch)(CBLAS_ORDER Layout, CBLAS_TRANSPOSE *TransA_Arra
                                 int *lda_Array, double **B_Array, int *ldb_Array, double *beta_Array, double **C_Array,
                                 int *ldc_Array, int group_count, int *group_size);
 
+typedef void (*CblasStrsm)(CBLAS_ORDER Layout, CBLAS_SIDE Side, CBLAS_UPLO Uplo, CBLAS_TRANSPOSE TransA,
+                           CBLAS_DIAG Diag, int M, int N, float alpha, float *A, int lda, float *B, int ldb);
+
+typedef void (*CblasDtrsm)(CBLAS_ORDER Layout, CBLAS_SIDE Side, CBLAS_UPLO Uplo, CBLAS_TRANSPOSE TransA,
+                           CBLAS_DIAG Diag, int M, int N, double alpha, double *A, int lda, double *B, int ldb);
+
 #ifdef LAPACK_ROW_MAJOR
 #undef LAPACK_ROW_MAJOR
 #endif
@@ -117,6 +123,18 @@ typedef int (*LapackeSgesdd)(LAPACK_LAYOUT matrix_layout, char jobz, int m, int
 typedef int (*LapackeDgesdd)(LAPACK_LAYOUT matrix_layout, char jobz, int m, int n, double *a, int lda, double *s,
                              double *u, int ldu, double *vt, int ldvt);
 
+typedef int (*LapackeSgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n, float *a, int lda, int *ipiv);
+typedef int (*LapackeDgetrf)(LAPACK_LAYOUT matrix_layout, int m, int n, double *a, int lda, int *ipiv);
+
+typedef int (*LapackeSpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n, float *a, int lda);
+typedef int (*LapackeDpotrf)(LAPACK_LAYOUT matrix_layout, char uplo, int n, double *a, int lda);
+
+typedef int (*LapackeSgeqrf)(LAPACK_LAYOUT matrix_layout, int m, int n, float *a, int lda, float *tau);
+typedef int (*LapackeDgeqrf)(LAPACK_LAYOUT matrix_layout, int m, int n, double *a, int lda, double *tau);
+
+typedef int (*LapackeSorgqr)(LAPACK_LAYOUT matrix_layout, int m, int n, int k, float *a, int lda, const float *tau);
+typedef int (*LapackeDorgqr)(LAPACK_LAYOUT matrix_layout, int m, int n, int k, double *a, int lda, const double *tau);
+
 typedef cublasStatus_t(CUBLASWINAPI *CublasSgemv)(cublasHandle_t handle, cublasOperation_t trans, int m, int n,
                                                   float *alpha, /* host or device pointer */
                                                   float *A, int lda, float *x, int incx,
@@ -234,6 +252,9 @@ class BlasHelper {
   bool _hasDgemm = false;
   bool _hasDgemmBatch = false;
 
+  bool _hasStrsm = false;
+  bool _hasDtrsm = false;
+
   CblasSgemv cblasSgemv;
   CblasDgemv cblasDgemv;
   CblasSgemm cblasSgemm;
@@ -244,6 +265,16 @@ class BlasHelper {
   LapackeDgesvd lapackeDgesvd;
   LapackeSgesdd lapackeSgesdd;
   LapackeDgesdd lapackeDgesdd;
+  CblasStrsm cblasStrsm;
+  CblasDtrsm cblasDtrsm;
+  LapackeSgetrf lapackeSgetrf;
+  LapackeDgetrf lapackeDgetrf;
+  LapackeSpotrf lapackeSpotrf;
+  LapackeDpotrf lapackeDpotrf;
+  LapackeSgeqrf lapackeSgeqrf;
+  LapackeDgeqrf lapackeDgeqrf;
+  LapackeSorgqr lapackeSorgqr;
+  LapackeDorgqr lapackeDorgqr;
 
   CublasSgemv cublasSgemv;
   CublasDgemv cublasDgemv;
@@ -277,6 +308,12 @@ class BlasHelper {
   template <typename T>
   bool hasBatchedGEMM();
 
+  template <typename T>
+  bool hasTRSM();
+
+  // LAPACK routines are optional, accessors below return nullptr when the library doesn't provide them
+  bool hasLAPACK();
+
   CblasSgemv sgemv();
   CblasDgemv dgemv();
 
@@ -292,6 +329,21 @@ class BlasHelper {
   LapackeSgesdd sgesdd();
   LapackeDgesdd dgesdd();
 
+  CblasStrsm strsm();
+  CblasDtrsm dtrsm();
+
+  LapackeSgetrf sgetrf();
+  LapackeDgetrf dgetrf();
+
+  LapackeSpotrf spotrf();
+  LapackeDpotrf dpotrf();
+
+  LapackeSgeqrf sgeqrf();
+  LapackeDgeqrf dgeqrf();
+
+  LapackeSorgqr sorgqr();
+  LapackeDorgqr dorgqr();
+
   // destructor
   ~BlasHelper() noexcept;
 };
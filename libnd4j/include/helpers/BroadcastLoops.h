@@ -0,0 +1,285 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// N-D broadcasting engine for ops without dimensions (x, y and z of equal rank, size-1 dims broadcast).
+//
+// The three shapes are first reduced to a minimal plan: size-1 dims of z are dropped, broadcast dims get
+// zero strides, dims are ordered by z stride and adjacent dims that are contiguous in all three arrays are
+// merged. What remains is looped row by row over the innermost dim, with a dedicated SIMD loop for each
+// collapsed pattern (elementwise, row plus scalar, scalar plus row, constant). When x or y is traversed
+// against its own layout (a transposed operand) the two innermost dims are walked in square tiles instead.
+//
+#ifndef LIBND4J_BROADCASTLOOPS_H
+#define LIBND4J_BROADCASTLOOPS_H
+#include <execution/Threads.h>
+#include <helpers/OmpLaunchHelper.h>
+#include <helpers/shape.h>
+#include <math/templatemath.h>
+#include <system/CpuDispatch.h>
+#include <system/Environment.h>
+#include <system/op_boilerplate.h>
+
+namespace sd {
+
+struct BroadcastPlan {
+  int rank = 0;
+  sd::LongType shape[SD_MAX_RANK];
+  sd::LongType xStrides[SD_MAX_RANK];
+  sd::LongType yStrides[SD_MAX_RANK];
+  sd::LongType zStrides[SD_MAX_RANK];
+
+  // true when x or y runs along its contiguous dim on the second innermost dim of the plan
+  SD_INLINE bool needsTiling() const {
+    if (rank < 2) return false;
+    const int i = rank - 1;
+    return (xStrides[i] > 1 && xStrides[i - 1] == 1) || (yStrides[i] > 1 && yStrides[i - 1] == 1);
+  }
+};
+
+SD_INLINE void buildBroadcastPlan(const sd::LongType* xShapeInfo, const sd::LongType* yShapeInfo,
+                                  const sd::LongType* zShapeInfo, BroadcastPlan& plan) {
+  const int zRank = shape::rank(zShapeInfo);
+  const int xShift = zRank - shape::rank(xShapeInfo);
+  const int yShift = zRank - shape::rank(yShapeInfo);
+
+  // operands are right-aligned with z, dims missing or of size 1 are broadcast
+  plan.rank = 0;
+  for (int d = 0; d < zRank; ++d) {
+    const sd::LongType n = shape::sizeAt(zShapeInfo, d);
+    if (n == 1) continue;
+
+    const int xd = d - xShift, yd = d - yShift;
+    const int i = plan.rank++;
+    plan.shape[i] = n;
+    plan.zStrides[i] = shape::strideAt(zShapeInfo, d);
+    plan.xStrides[i] = xd >= 0 && shape::sizeAt(xShapeInfo, xd) != 1 ? shape::strideAt(xShapeInfo, xd) : 0;
+    plan.yStrides[i] = yd >= 0 && shape::sizeAt(yShapeInfo, yd) != 1 ? shape::strideAt(yShapeInfo, yd) : 0;
+  }
+
+  if (plan.rank == 0) {
+    plan.rank = 1;
+    plan.shape[0] = 1;
+    plan.xStrides[0] = plan.yStrides[0] = plan.zStrides[0] = 0;
+    return;
+  }
+
+  // order dims by z stride, so that z is written in memory order whatever its ordering is
+  for (int i = 1; i < plan.rank; ++i) {
+    for (int j = i; j > 0 && plan.zStrides[j - 1] < plan.zStrides[j]; --j) {
+      sd::math::sd_swap(plan.shape[j - 1], plan.shape[j]);
+      sd::math::sd_swap(plan.xStrides[j - 1], plan.xStrides[j]);
+      sd::math::sd_swap(plan.yStrides[j - 1], plan.yStrides[j]);
+      sd::math::sd_swap(plan.zStrides[j - 1], plan.zStrides[j]);
+    }
+  }
+
+  // merge a dim into its inner neighbour when the pair is contiguous (or broadcast) in all three arrays
+  int rank = 0;
+  for (int i = 1; i < plan.rank; ++i) {
+    const sd::LongType n = plan.shape[i];
+    if (plan.xStrides[rank] == plan.xStrides[i] * n && plan.yStrides[rank] == plan.yStrides[i] * n &&
+        plan.zStrides[rank] == plan.zStrides[i] * n) {
+      plan.shape[rank] *= n;
+    } else {
+      ++rank;
+      plan.shape[rank] = n;
+    }
+    plan.xStrides[rank] = plan.xStrides[i];
+    plan.yStrides[rank] = plan.yStrides[i];
+    plan.zStrides[rank] = plan.zStrides[i];
+  }
+  plan.rank = rank + 1;
+
+  // a transposed operand gets its contiguous dim moved next to the innermost one, so that tiles read it in rows
+  const int inner = plan.rank - 1;
+  if (plan.rank > 2 && plan.zStrides[inner] == 1) {
+    const sd::LongType* strides =
+        plan.xStrides[inner] > 1 ? plan.xStrides : (plan.yStrides[inner] > 1 ? plan.yStrides : nullptr);
+    for (int k = 0; strides != nullptr && k < inner - 1; ++k) {
+      if (strides[k] != 1) continue;
+      for (int d = k; d < inner - 1; ++d) {
+        sd::math::sd_swap(plan.shape[d], plan.shape[d + 1]);
+        sd::math::sd_swap(plan.xStrides[d], plan.xStrides[d + 1]);
+        sd::math::sd_swap(plan.yStrides[d], plan.yStrides[d + 1]);
+        sd::math::sd_swap(plan.zStrides[d], plan.zStrides[d + 1]);
+      }
+      break;
+    }
+  }
+}
+
+// Op is a functor z = op(x, y), see functions::broadcast for the wrappers around legacy ops
+template <typename X, typename Y, typename Z, typename Op>
+struct BroadcastRowsKernel {
+  static SD_INLINE void row(const X* x, const sd::LongType xs, const Y* y, const sd::LongType ys, Z* z,
+                            const sd::LongType zs, const sd::LongType n, const Op& op) {
+    if (zs == 1) {
+      if (xs == 1 && ys == 1) {
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < n; ++i) z[i] = op(x[i], y[i]);
+      } else if (xs == 1 && ys == 0) {
+        const Y b = *y;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < n; ++i) z[i] = op(x[i], b);
+      } else if (xs == 0 && ys == 1) {
+        const X a = *x;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < n; ++i) z[i] = op(a, y[i]);
+      } else if (xs == 0 && ys == 0) {
+        const Z c = op(*x, *y);
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < n; ++i) z[i] = c;
+      } else {
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < n; ++i) z[i] = op(x[i * xs], y[i * ys]);
+      }
+    } else {
+      for (sd::LongType i = 0; i < n; ++i) z[i * zs] = op(x[i * xs], y[i * ys]);
+    }
+  }
+
+  // processes rows [rowStart, rowStop) of the plan, restricted to the columns [colStart, colStop)
+  static SD_INLINE void run(const BroadcastPlan* plan, const X* x, const Y* y, Z* z, const sd::LongType rowStart,
+                            const sd::LongType rowStop, const sd::LongType colStart, const sd::LongType colStop,
+                            const Op op) {
+    const int outer = plan->rank - 1;
+    const sd::LongType xs = plan->xStrides[outer], ys = plan->yStrides[outer], zs = plan->zStrides[outer];
+
+    sd::LongType coords[SD_MAX_RANK];
+    sd::LongType xOffset = colStart * xs, yOffset = colStart * ys, zOffset = colStart * zs;
+    sd::LongType index = rowStart;
+    for (int d = outer - 1; d >= 0; --d) {
+      coords[d] = index % plan->shape[d];
+      index /= plan->shape[d];
+      xOffset += coords[d] * plan->xStrides[d];
+      yOffset += coords[d] * plan->yStrides[d];
+      zOffset += coords[d] * plan->zStrides[d];
+    }
+
+    for (auto r = rowStart; r < rowStop; ++r) {
+      row(x + xOffset, xs, y + yOffset, ys, z + zOffset, zs, colStop - colStart, op);
+
+      // odometer over the outer dims
+      for (int d = outer - 1; d >= 0; --d) {
+        xOffset += plan->xStrides[d];
+        yOffset += plan->yStrides[d];
+        zOffset += plan->zStrides[d];
+        if (++coords[d] < plan->shape[d]) break;
+        xOffset -= plan->shape[d] * plan->xStrides[d];
+        yOffset -= plan->shape[d] * plan->yStrides[d];
+        zOffset -= plan->shape[d] * plan->zStrides[d];
+        coords[d] = 0;
+      }
+    }
+  }
+};
+
+template <typename X, typename Y, typename Z, typename Op>
+struct BroadcastTilesKernel {
+  static constexpr sd::LongType tile = 64;
+
+  // processes tiles [taskStart, taskStop), tiles enumerate (outer index, tile row, tile column)
+  static SD_INLINE void run(const BroadcastPlan* plan, const X* x, const Y* y, Z* z, const sd::LongType taskStart,
+                            const sd::LongType taskStop, const Op op) {
+    const int inner = plan->rank - 1, second = plan->rank - 2;
+    const sd::LongType rows = plan->shape[second], cols = plan->shape[inner];
+    const sd::LongType rowTiles = (rows + tile - 1) / tile, colTiles = (cols + tile - 1) / tile;
+
+    for (auto t = taskStart; t < taskStop; ++t) {
+      const sd::LongType tc = t % colTiles, tr = (t / colTiles) % rowTiles;
+      sd::LongType outerIndex = t / (colTiles * rowTiles);
+
+      sd::LongType xOffset = 0, yOffset = 0, zOffset = 0;
+      for (int d = second - 1; d >= 0; --d) {
+        const sd::LongType c = outerIndex % plan->shape[d];
+        outerIndex /= plan->shape[d];
+        xOffset += c * plan->xStrides[d];
+        yOffset += c * plan->yStrides[d];
+        zOffset += c * plan->zStrides[d];
+      }
+
+      const sd::LongType r0 = tr * tile, r1 = sd::math::sd_min<sd::LongType>(r0 + tile, rows);
+      const sd::LongType c0 = tc * tile, c1 = sd::math::sd_min<sd::LongType>(c0 + tile, cols);
+      for (auto r = r0; r < r1; ++r)
+        BroadcastRowsKernel<X, Y, Z, Op>::row(
+            x + xOffset + r * plan->xStrides[second] + c0 * plan->xStrides[inner], plan->xStrides[inner],
+            y + yOffset + r * plan->yStrides[second] + c0 * plan->yStrides[inner], plan->yStrides[inner],
+            z + zOffset + r * plan->zStrides[second] + c0 * plan->zStrides[inner], plan->zStrides[inner], c1 - c0,
+            op);
+    }
+  }
+};
+
+// z = op(x, y) with numpy-like broadcasting of x and y to the shape of z
+template <typename X, typename Y, typename Z, typename Op>
+SD_LIB_HIDDEN void execBroadcastLoops(const X* x, const sd::LongType* xShapeInfo, const Y* y,
+                                      const sd::LongType* yShapeInfo, Z* z, const sd::LongType* zShapeInfo,
+                                      const Op& op) {
+  const sd::LongType zLen = shape::length(zShapeInfo);
+  if (zLen == 0) return;
+
+  BroadcastPlan plan;
+  buildBroadcastPlan(xShapeInfo, yShapeInfo, zShapeInfo, plan);
+  const BroadcastPlan* pPlan = &plan;
+
+  const int numThreads = OmpLaunchHelper::betterThreads(zLen, Environment::getInstance().maxMasterThreads());
+
+  if (plan.needsTiling()) {
+    const sd::LongType tile = BroadcastTilesKernel<X, Y, Z, Op>::tile;
+    sd::LongType tasks =
+        ((plan.shape[plan.rank - 2] + tile - 1) / tile) * ((plan.shape[plan.rank - 1] + tile - 1) / tile);
+    for (int d = 0; d < plan.rank - 2; ++d) tasks *= plan.shape[d];
+
+    auto func = PRAGMA_THREADS_FOR {
+      isaDispatch<BroadcastTilesKernel<X, Y, Z, Op>>(pPlan, x, y, z, start, stop, op);
+    };
+    samediff::Threads::parallel_tad(func, 0, tasks, 1, numThreads);
+    return;
+  }
+
+  const sd::LongType cols = plan.shape[plan.rank - 1];
+  const sd::LongType rows = zLen / cols;
+
+  // enough rows to keep every thread busy: each thread takes a range of whole rows
+  if (rows >= numThreads) {
+    auto func = PRAGMA_THREADS_FOR {
+      isaDispatch<BroadcastRowsKernel<X, Y, Z, Op>>(pPlan, x, y, z, start, stop, static_cast<sd::LongType>(0), cols,
+                                                    op);
+    };
+    samediff::Threads::parallel_tad(func, 0, rows, 1, numThreads);
+    return;
+  }
+
+  // otherwise rows are split into column chunks as well
+  const sd::LongType chunks = (numThreads + rows - 1) / rows;
+  const sd::LongType chunk = (cols + chunks - 1) / chunks;
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto t = start; t < stop; ++t) {
+      const sd::LongType r = t / chunks;
+      const sd::LongType c0 = (t % chunks) * chunk, c1 = sd::math::sd_min<sd::LongType>(c0 + chunk, cols);
+      if (c0 < c1) isaDispatch<BroadcastRowsKernel<X, Y, Z, Op>>(pPlan, x, y, z, r, r + 1, c0, c1, op);
+    }
+  };
+  samediff::Threads::parallel_tad(func, 0, rows * chunks, 1, numThreads);
+}
+
+}  // namespace sd
+
+#endif  // LIBND4J_BROADCASTLOOPS_H
@@ -0,0 +1,231 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Mixed-precision execution of the legacy elementwise ops on float16 and bfloat16 buffers.
+//
+// Contiguous spans are processed in blocks: a block is widened into a float buffer on the stack, the op
+// is applied to it in float (the same op template instantiated for float), and the result is narrowed
+// back. This replaces a software conversion per element and per operand with vectorized bulk
+// conversions, and reductions accumulate in float.
+//
+// HalfPrecision<X, Y, Z, OpType>::* return false when the types or arguments don't qualify, in which case
+// the caller runs its regular loop. Only ops called without extraParams are rerouted, since their extra
+// parameters are typed as the storage type.
+//
+#ifndef LIBND4J_HALF_PRECISION_LOOPS_H
+#define LIBND4J_HALF_PRECISION_LOOPS_H
+#include <execution/Threads.h>
+#include <math/templatemath.h>
+#include <system/CpuDispatch.h>
+#include <system/Environment.h>
+#include <types/half_conversions.h>
+
+#include <type_traits>
+
+namespace sd {
+
+template <typename T>
+struct HalfComputeType {
+  using type = T;
+};
+
+template <>
+struct HalfComputeType<float16> {
+  using type = float;
+};
+
+template <>
+struct HalfComputeType<bfloat16> {
+  using type = float;
+};
+
+// simdOps::Add<float16, float16, float16> -> simdOps::Add<float, float, float>
+template <typename OpType>
+struct HalfComputeOp {
+  using type = OpType;
+};
+
+template <template <typename...> class Op, typename... Ts>
+struct HalfComputeOp<Op<Ts...>> {
+  using type = Op<typename HalfComputeType<Ts>::type...>;
+};
+
+// X is a half type, and Y and Z are either X or float
+template <typename X, typename Y, typename Z>
+struct IsHalfComputable
+    : std::integral_constant<bool, (std::is_same<X, float16>::value || std::is_same<X, bfloat16>::value) &&
+                                       (std::is_same<Y, X>::value || std::is_same<Y, float>::value) &&
+                                       (std::is_same<Z, X>::value || std::is_same<Z, float>::value)> {};
+
+constexpr sd::LongType kHalfBlockSize = 256;
+
+template <typename X, typename Z, typename FloatOp>
+struct HalfTransformKernel {
+  static SD_INLINE void run(const X* x, Z* z, const sd::LongType start, const sd::LongType stop) {
+    float buffer[kHalfBlockSize];
+    for (auto b = start; b < stop; b += kHalfBlockSize) {
+      const auto n = sd::math::sd_min<sd::LongType>(kHalfBlockSize, stop - b);
+      convertToFloats(x + b, buffer, n);
+
+      PRAGMA_OMP_SIMD
+      for (sd::LongType i = 0; i < n; i++) buffer[i] = FloatOp::op(buffer[i], static_cast<float*>(nullptr));
+
+      convertFromFloats(buffer, z + b, n);
+    }
+  }
+};
+
+template <typename X, typename Y, typename Z, typename FloatOp>
+struct HalfPairwiseKernel {
+  static SD_INLINE void run(const X* x, const Y* y, Z* z, const sd::LongType start, const sd::LongType stop) {
+    float xBuffer[kHalfBlockSize];
+    float yBuffer[kHalfBlockSize];
+    for (auto b = start; b < stop; b += kHalfBlockSize) {
+      const auto n = sd::math::sd_min<sd::LongType>(kHalfBlockSize, stop - b);
+      convertToFloats(x + b, xBuffer, n);
+      convertToFloats(y + b, yBuffer, n);
+
+      PRAGMA_OMP_SIMD
+      for (sd::LongType i = 0; i < n; i++)
+        xBuffer[i] = FloatOp::op(xBuffer[i], yBuffer[i], static_cast<float*>(nullptr));
+
+      convertFromFloats(xBuffer, z + b, n);
+    }
+  }
+};
+
+template <typename X, typename Z, typename FloatOp>
+struct HalfScalarKernel {
+  static SD_INLINE void run(const X* x, const float scalar, Z* z, const sd::LongType start,
+                            const sd::LongType stop) {
+    float buffer[kHalfBlockSize];
+    for (auto b = start; b < stop; b += kHalfBlockSize) {
+      const auto n = sd::math::sd_min<sd::LongType>(kHalfBlockSize, stop - b);
+      convertToFloats(x + b, buffer, n);
+
+      PRAGMA_OMP_SIMD
+      for (sd::LongType i = 0; i < n; i++) buffer[i] = FloatOp::op(buffer[i], scalar, static_cast<float*>(nullptr));
+
+      convertFromFloats(buffer, z + b, n);
+    }
+  }
+};
+
+// folds [start, stop) into the float accumulator
+template <typename X, typename FloatOp>
+struct HalfReduceKernel {
+  static SD_INLINE float run(const X* x, const sd::LongType start, const sd::LongType stop, float accumulator) {
+    float buffer[kHalfBlockSize];
+    for (auto b = start; b < stop; b += kHalfBlockSize) {
+      const auto n = sd::math::sd_min<sd::LongType>(kHalfBlockSize, stop - b);
+      convertToFloats(x + b, buffer, n);
+
+      for (sd::LongType i = 0; i < n; i++)
+        accumulator = FloatOp::update(accumulator, FloatOp::op(buffer[i], static_cast<float*>(nullptr)),
+                                      static_cast<float*>(nullptr));
+    }
+    return accumulator;
+  }
+};
+
+template <typename X, typename Y, typename Z, typename OpType, bool = IsHalfComputable<X, Y, Z>::value>
+struct HalfPrecision {
+  template <typename E>
+  static SD_INLINE bool transform(const X* x, Z* z, E* extraParams, sd::LongType start, sd::LongType stop) {
+    return false;
+  }
+
+  template <typename E>
+  static SD_INLINE bool pairwise(const X* x, const Y* y, Z* z, E* extraParams, sd::LongType start,
+                                sd::LongType stop) {
+    return false;
+  }
+
+  template <typename E>
+  static SD_INLINE bool scalar(const X* x, const Y scalar, Z* z, E* extraParams, sd::LongType start,
+                              sd::LongType stop) {
+    return false;
+  }
+
+  template <typename E>
+  static SD_INLINE bool reduce(const X* x, sd::LongType length, E* extraParams, Z& result) {
+    return false;
+  }
+};
+
+template <typename X, typename Y, typename Z, typename OpType>
+struct HalfPrecision<X, Y, Z, OpType, true> {
+  using FloatOp = typename HalfComputeOp<OpType>::type;
+
+  template <typename E>
+  static SD_INLINE bool transform(const X* x, Z* z, E* extraParams, sd::LongType start, sd::LongType stop) {
+    if (extraParams != nullptr) return false;
+
+    isaDispatch<HalfTransformKernel<X, Z, FloatOp>>(x, z, start, stop);
+    return true;
+  }
+
+  template <typename E>
+  static SD_INLINE bool pairwise(const X* x, const Y* y, Z* z, E* extraParams, sd::LongType start,
+                                sd::LongType stop) {
+    if (extraParams != nullptr) return false;
+
+    isaDispatch<HalfPairwiseKernel<X, Y, Z, FloatOp>>(x, y, z, start, stop);
+    return true;
+  }
+
+  template <typename E>
+  static SD_INLINE bool scalar(const X* x, const Y scalar, Z* z, E* extraParams, sd::LongType start,
+                              sd::LongType stop) {
+    if (extraParams != nullptr) return false;
+
+    isaDispatch<HalfScalarKernel<X, Z, FloatOp>>(x, static_cast<float>(scalar), z, start, stop);
+    return true;
+  }
+
+  // whole-array reduction of a contiguous buffer, split across threads
+  template <typename E>
+  static bool reduce(const X* x, sd::LongType length, E* extraParams, Z& result) {
+    if (extraParams != nullptr) return false;
+
+    const float first = length > 0 ? static_cast<float>(x[0]) : 0.f;
+    int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
+    float intermediate[64];
+
+    for (int e = 0; e < maxThreads; e++) intermediate[e] = FloatOp::startingValue(&first);
+
+    auto func = PRAGMA_THREADS_FOR {
+      intermediate[thread_id] = isaDispatch<HalfReduceKernel<X, FloatOp>>(x, static_cast<sd::LongType>(start),
+                                                                          static_cast<sd::LongType>(stop),
+                                                                          intermediate[thread_id]);
+    };
+
+    maxThreads = samediff::Threads::parallel_for(func, 0, length, 1, maxThreads);
+
+    for (int e = 1; e < maxThreads; e++)
+      intermediate[0] = FloatOp::update(intermediate[0], intermediate[e], static_cast<float*>(nullptr));
+
+    result = static_cast<Z>(FloatOp::postProcess(intermediate[0], length, static_cast<float*>(nullptr)));
+    return true;
+  }
+};
+
+}  // namespace sd
+
+#endif  // LIBND4J_HALF_PRECISION_LOOPS_H
@@ -25,11 +25,14 @@
 #include <array/DataTypeUtils.h>
 #include <execution/Threads.h>
 #include <helpers/ConstantTadHelper.h>
+#include <helpers/HalfPrecisionLoops.h>
 #include <helpers/LoopKind.h>
+#include <helpers/OffsetIterator.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <helpers/shape.h>
 #include <loops/indexreduce.h>
 #include <ops/ops.h>
+#include <system/CpuDispatch.h>
 
 #include <functional>
 
@@ -147,6 +150,31 @@ class SD_LIB_HIDDEN Reduction3Loops {
                                   int64_t start, int64_t stop);
 };
 
+//////////////////////////////////////////////////////////////////////////
+// leaf loops of the contiguous cases, multi-versioned through isaDispatch
+template <typename X, typename Z, typename E, typename OpType>
+struct TransformEws1Kernel {
+  static SD_INLINE void run(const X* x, Z* z, E* extraParams, const sd::LongType start, const sd::LongType stop) {
+    for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], extraParams);
+  }
+};
+
+// reduces rows [start, stop) of len contiguous elements, rows are xStride apart in x and zStride apart in z
+template <typename X, typename Z, typename E, typename OpType>
+struct ReduceRowsKernel {
+  static SD_INLINE void run(const X* x, const sd::LongType xStride, Z* z, const sd::LongType zStride,
+                            const sd::LongType len, E* extraParams, const sd::LongType start, const sd::LongType stop) {
+    for (auto i0 = start; i0 < stop; ++i0) {
+      auto x0 = x + i0 * xStride;
+      auto s = OpType::startingValue(x0);
+
+      for (sd::LongType i1 = 0; i1 < len; ++i1) s = OpType::update(s, OpType::op(x0[i1], extraParams), extraParams);
+
+      z[i0 * zStride] = OpType::postProcess(s, len, extraParams);
+    }
+  }
+};
+
 //////////////////////////////////////////////////////////////////////////
 template <typename X, typename Z, typename E, typename OpType>
 static void reduceExec21(const X* x, const sd::LongType* xShapeInfo, Z* z, const sd::LongType* zShapeInfo,
@@ -159,18 +187,21 @@ static void reduceExec21(const X* x, const sd::LongType* xShapeInfo, Z* z, const
   const sd::LongType xStrd1 = shape::strideAt(xShapeInfo, dims[1]);
 
   auto func = PRAGMA_THREADS_FOR {
+    if (xStrd1 == 1) {
+      isaDispatch<ReduceRowsKernel<X, Z, E, OpType>>(x, xStrd0, z, zStrd0, static_cast<sd::LongType>(xAxis1),
+                                                     extraParams, static_cast<sd::LongType>(start),
+                                                     static_cast<sd::LongType>(stop));
+      return;
+    }
+
     for (auto i0 = start; i0 < stop; ++i0) {
       auto x0 = x + i0 * xStrd0;
       auto z0 = z + i0 * zStrd0;
 
       auto s = OpType::startingValue(x0);
 
-      if (xStrd1 == 1)
-        for (sd::Unsigned i1 = 0; i1 < xAxis1; ++i1)
-          s = OpType::update(s, OpType::op(x0[i1], extraParams), extraParams);
-      else
-        for (sd::Unsigned i1 = 0; i1 < xAxis1; ++i1)
-          s = OpType::update(s, OpType::op(x0[i1 * xStrd1], extraParams), extraParams);
+      for (sd::Unsigned i1 = 0; i1 < xAxis1; ++i1)
+        s = OpType::update(s, OpType::op(x0[i1 * xStrd1], extraParams), extraParams);
 
       *z0 = OpType::postProcess(s, static_cast<sd::LongType>(xAxis1), extraParams);
     }
@@ -645,6 +676,141 @@ SD_LIB_HIDDEN void reduceExec54(const X* x, const sd::LongType* xShapeInfo, Z* z
   samediff::Threads::parallel_for(func, 0, xAxis0, 1, 0, xAxis1, 1, 0, xAxis2, 1);
 }
 
+////////////////////////////////////////////////////////////////////////
+// Outer-axis reductions, e.g. column sums of a c-ordered matrix: the kept dimensions form a dense block of x, so
+// every TAD is strided by the block size and walking TADs touches one element per cache line. Instead, rows of
+// the block are streamed contiguously into vectors of per-column accumulators.
+
+// reduces rows [rowStart, rowStop) of columns [colStart, colStop) into acc[0, colStop - colStart)
+template <typename X, typename A, typename E, typename OpType>
+struct ReduceColumnsKernel {
+  static SD_INLINE void run(const X* x, const sd::LongType* rowOffsets, const sd::LongType rowStride, A* acc,
+                            const sd::LongType colStart, const sd::LongType colStop, E* extraParams,
+                            const sd::LongType rowStart, const sd::LongType rowStop) {
+    const sd::LongType width = colStop - colStart;
+    for (auto r = rowStart; r < rowStop; ++r) {
+      const X* row = x + (rowOffsets != nullptr ? rowOffsets[r] : r * rowStride) + colStart;
+
+      PRAGMA_OMP_SIMD
+      for (sd::LongType c = 0; c < width; ++c)
+        acc[c] = OpType::update(acc[c], OpType::op(row[c], extraParams), extraParams);
+    }
+  }
+};
+
+// returns false when dims don't describe an outer-axis reduction of x into a dense c-ordered z
+template <typename X, typename Z, typename E, typename OpType>
+SD_LIB_HIDDEN bool reduceOuterAxes(sd::memory::Workspace* workspace, const X* x, const sd::LongType* xShapeInfo, Z* z,
+                                   const sd::LongType* zShapeInfo, const int* dims, E* extraParams) {
+  const int xRank = shape::rank(xShapeInfo);
+  const int zRank = shape::rank(zShapeInfo);
+  if (zRank == 0 || zRank >= xRank) return false;
+
+  // kept dimensions have to be dense and c-ordered in x, and z has to be dense and c-ordered as well
+  sd::LongType columns = 1, zColumns = 1;
+  for (int i = zRank - 1; i >= 0; --i) {
+    if (i > 0 && dims[i - 1] >= dims[i]) return false;
+    const sd::LongType size = shape::sizeAt(xShapeInfo, dims[i]);
+    if (size != 1 && shape::strideAt(xShapeInfo, dims[i]) != columns) return false;
+    columns *= size;
+
+    const sd::LongType zSize = shape::sizeAt(zShapeInfo, i);
+    if (zSize != 1 && shape::strideAt(zShapeInfo, i) != zColumns) return false;
+    zColumns *= zSize;
+  }
+
+  const sd::LongType rows = shape::length(xShapeInfo) / columns;
+  if (columns != zColumns || columns < 8 || rows < 2) return false;
+
+  // offsets of the rows are given by the reduced dimensions
+  sd::LongType* rowsShapeInfo =
+      sd::ShapeBuilders::createSubArrShapeInfo(xShapeInfo, dims + zRank, xRank - zRank, workspace);
+  const sd::LongType rowStride = shape::order(rowsShapeInfo) == 'c' ? shape::elementWiseStride(rowsShapeInfo) : 0;
+  sd::LongType* rowOffsets = nullptr;
+  if (rowStride <= 0) {
+    ALLOCATE(rowOffsets, workspace, rows, sd::LongType);
+    shape::calcOffsets(rowsShapeInfo, rowOffsets);
+  }
+
+  using A = decltype(OpType::startingValue(x));
+  constexpr sd::LongType tile = 1024;
+  constexpr sd::LongType pairwiseBlock = 128;
+  const bool pairwise = sd::Environment::getInstance().pairwiseReductions();
+
+  // reduces rows [r0, r1) of columns [c0, c1) into acc; in pairwise mode blocks of rows are reduced separately
+  // and merged, so the error of long sums grows with the number of blocks instead of the number of rows
+  // some ops (AMax, AMin) start from the first element they see, so every column is seeded from its own data
+  auto rowStart = [&](const sd::LongType r) -> const X* {
+    return x + (rowOffsets != nullptr ? rowOffsets[r] : r * rowStride);
+  };
+
+  auto reduceTile = [&](A* acc, const sd::LongType c0, const sd::LongType c1, const sd::LongType r0,
+                        const sd::LongType r1) {
+    for (sd::LongType c = 0; c < c1 - c0; ++c) acc[c] = OpType::startingValue(rowStart(r0) + c0 + c);
+
+    if (!pairwise) {
+      isaDispatch<ReduceColumnsKernel<X, A, E, OpType>>(x, static_cast<const sd::LongType*>(rowOffsets), rowStride,
+                                                        acc, c0, c1, extraParams, r0, r1);
+      return;
+    }
+
+    A block[tile];
+    for (auto b0 = r0; b0 < r1; b0 += pairwiseBlock) {
+      const sd::LongType b1 = sd::math::sd_min<sd::LongType>(b0 + pairwiseBlock, r1);
+      for (sd::LongType c = 0; c < c1 - c0; ++c) block[c] = OpType::startingValue(rowStart(b0) + c0 + c);
+      isaDispatch<ReduceColumnsKernel<X, A, E, OpType>>(x, static_cast<const sd::LongType*>(rowOffsets), rowStride,
+                                                        static_cast<A*>(block), c0, c1, extraParams, b0, b1);
+      for (sd::LongType c = 0; c < c1 - c0; ++c) acc[c] = OpType::update(acc[c], block[c], extraParams);
+    }
+  };
+
+  const sd::LongType tiles = (columns + tile - 1) / tile;
+  const sd::LongType maxThreads = sd::Environment::getInstance().maxMasterThreads();
+
+  // when there are too few column tiles to occupy the threads, the rows are split as well and merged afterwards
+  const sd::LongType parts =
+      tiles >= maxThreads
+          ? 1
+          : sd::math::sd_max<sd::LongType>(1, sd::math::sd_min<sd::LongType>(maxThreads / tiles, rows / 64));
+
+  if (parts == 1) {
+    auto func = PRAGMA_THREADS_FOR {
+      A acc[tile];
+      for (auto t = start; t < stop; ++t) {
+        const sd::LongType c0 = t * tile, c1 = sd::math::sd_min<sd::LongType>(c0 + tile, columns);
+        reduceTile(acc, c0, c1, 0, rows);
+        for (auto c = c0; c < c1; ++c) z[c] = OpType::postProcess(acc[c - c0], rows, extraParams);
+      }
+    };
+    samediff::Threads::parallel_for(func, 0, tiles);
+  } else {
+    std::vector<A> partials(parts * columns);
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto i = start; i < stop; ++i) {
+        const sd::LongType t = i % tiles, part = i / tiles;
+        const sd::LongType c0 = t * tile, c1 = sd::math::sd_min<sd::LongType>(c0 + tile, columns);
+        reduceTile(partials.data() + part * columns + c0, c0, c1, part * rows / parts, (part + 1) * rows / parts);
+      }
+    };
+    samediff::Threads::parallel_for(func, 0, tiles * parts);
+
+    auto merge = PRAGMA_THREADS_FOR {
+      for (auto c = start; c < stop; ++c) {
+        auto s = partials[c];
+        for (sd::LongType part = 1; part < parts; ++part)
+          s = OpType::update(s, partials[part * columns + c], extraParams);
+        z[c] = OpType::postProcess(s, rows, extraParams);
+      }
+    };
+    samediff::Threads::parallel_for(merge, 0, columns);
+  }
+
+  RELEASE(rowsShapeInfo, workspace);
+  if (rowOffsets != nullptr) RELEASE(rowOffsets, workspace);
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////
 template <typename X, typename Z, typename E, typename OpType>
 SD_LIB_HIDDEN void reduceDefault(sd::memory::Workspace* workspace, const X* x, const sd::LongType* xShapeInfo, Z* z,
@@ -712,6 +878,8 @@ SD_LIB_HIDDEN void sd::ReductionLoops<X, Z, E>::loopReduce(sd::memory::Workspace
   // shape::printShapeInfoLinear(zShapeInfo);
   // shape::printIntArray(dims, shape::rank(xShapeInfo));
 
+  if (reduceOuterAxes<X, Z, E, OpType>(workspace, x, xShapeInfo, z, zShapeInfo, dims, extraParams)) return;
+
   if (xRank == 2 && zRank == 1)
     reduceExec21<X, Z, E, OpType>(x, xShapeInfo, z, zShapeInfo, dims, extraParams);
   else if (xRank == 3 && zRank == 1)
@@ -775,7 +943,9 @@ SD_LIB_HIDDEN void sd::TransformLoops<X, Z, E>::loopTransform(const X* x, const
       auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
       int64_t start = span.startX(), stop = span.stopX();
 
-      for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], extraParams);
+      if (!HalfPrecision<X, X, Z, OpType>::transform(x, z, extraParams, start, stop))
+        isaDispatch<TransformEws1Kernel<X, Z, E, OpType>>(x, z, extraParams, static_cast<sd::LongType>(start),
+                                                          static_cast<sd::LongType>(stop));
 
     } break;
 
@@ -793,24 +963,18 @@ SD_LIB_HIDDEN void sd::TransformLoops<X, Z, E>::loopTransform(const X* x, const
 
       //*********************************************//
     case LoopKind::Z_EWSNONZERO: {
-
       const sd::Unsigned zEws = shape::elementWiseStride(zShapeInfo);
-      sd::Unsigned castXShapeInfo[SD_MAX_RANK];
-      const bool canCastX = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(xShapeInfo, castXShapeInfo);
 
       auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
       int64_t start = span.startX(), stop = span.stopX();
 
+      OffsetIterator<1> xIt(xShapeInfo);
+      xIt.seek(start);
+
       if (zEws > 1) {
-        for (auto i = start; i < stop; i++) {
-          const auto xOffset = shape::indexOffset(i, xShapeInfo, castXShapeInfo, canCastX);
-          z[i * zEws] = OpType::op(x[xOffset], extraParams);
-        }
+        for (auto i = start; i < stop; i++, xIt.next()) z[i * zEws] = OpType::op(x[xIt.offset(0)], extraParams);
       } else {
-        for (auto i = start; i < stop; i++) {
-          const auto xOffset = shape::indexOffset(i, xShapeInfo, castXShapeInfo, canCastX);
-          z[i] = OpType::op(x[xOffset], extraParams);
-        }
+        for (auto i = start; i < stop; i++, xIt.next()) z[i] = OpType::op(x[xIt.offset(0)], extraParams);
       }
 
     } break;
@@ -918,22 +1082,13 @@ SD_LIB_HIDDEN void sd::TransformLoops<X, Z, E>::loopTransform(const X* x, const
 
       //*********************************************//
     default: {
-
-      sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-      sd::Unsigned zShapeInfoCast[SD_MAX_RANK];
-
-      bool canCastX = DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-      bool canCastZ = DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
-
       auto span = samediff::Span::build(threadId, numThreads, 0, len, 1);
 
-      for (auto i = span.startX(); i < span.stopX(); i++) {
-        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
-        z[zOffset] = OpType::op(x[xOffset], extraParams);
-      }
-
+      OffsetIterator<2> it(xShapeInfo, zShapeInfo);
+      it.seek(span.startX());
 
+      for (auto i = span.startX(); i < span.stopX(); i++, it.next())
+        z[it.offset(1)] = OpType::op(x[it.offset(0)], extraParams);
     }
   }
 }
@@ -1161,8 +1316,7 @@ void sd::Reduction3Loops<X, Z>::loopReduce3(const X* x, const sd::LongType* xSha
 
       //*********************************************//
     default: {
-      sd::Unsigned castXTadShapeInfo[SD_MAX_RANK];
-      const bool canCastXTad = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(xTadShapeInfo, castXTadShapeInfo);
+      OffsetIterator<1> xTadIt(xTadShapeInfo);
 
       if (shape::haveSameShapeAndStrides(xTadShapeInfo, yTadShapeInfo)) {
         Z extraParams[3];
@@ -1175,16 +1329,16 @@ void sd::Reduction3Loops<X, Z>::loopReduce3(const X* x, const sd::LongType* xSha
           const auto yTad = yTadOffsets ? y + yTadOffsets[i] : y;
           auto s = OpType::startingValue(xTad);
 
-          for (sd::LongType j = 0; j < tadLen; ++j) {
-            const auto tadOffset = shape::indexOffset(j, xTadShapeInfo, castXTadShapeInfo, canCastXTad);
+          xTadIt.seek(0);
+          for (sd::LongType j = 0; j < tadLen; ++j, xTadIt.next()) {
+            const auto tadOffset = xTadIt.offset(0);
             s = OpType::update(s, OpType::op(xTad[tadOffset], yTad[tadOffset], extraParams), extraParams);
           }
 
           z[i * zEws] = OpType::postProcess(s, tadLen, extraParams);
         };
       } else {
-        sd::Unsigned castYTadShapeInfo[SD_MAX_RANK];
-        const bool canCastYTad = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(yTadShapeInfo, castYTadShapeInfo);
+        OffsetIterator<2> xyTadIt(xTadShapeInfo, yTadShapeInfo);
 
         Z extraParams[3];
         for (auto i = start; i < stop; i++) {
@@ -1196,9 +1350,10 @@ void sd::Reduction3Loops<X, Z>::loopReduce3(const X* x, const sd::LongType* xSha
           const auto yTad = yTadOffsets ? y + yTadOffsets[i] : y;
           auto s = OpType::startingValue(xTad);
 
-          for (sd::LongType j = 0; j < tadLen; ++j) {
-            const auto xTadOffset = shape::indexOffset(j, xTadShapeInfo, castXTadShapeInfo, canCastXTad);
-            const auto yTadOffset = shape::indexOffset(j, yTadShapeInfo, castYTadShapeInfo, canCastYTad);
+          xyTadIt.seek(0);
+          for (sd::LongType j = 0; j < tadLen; ++j, xyTadIt.next()) {
+            const auto xTadOffset = xyTadIt.offset(0);
+            const auto yTadOffset = xyTadIt.offset(1);
             s = OpType::update(s, OpType::op(xTad[xTadOffset], yTad[yTadOffset], extraParams), extraParams);
           }
           z[i * zEws] = OpType::postProcess(s, tadLen, extraParams);
@@ -1432,8 +1587,7 @@ void sd::Reduction3Loops<X, Z>::loopReduce3All(const X* x, const sd::LongType* x
 
       //*********************************************//
     default: {
-      sd::Unsigned castXTadShapeInfo[SD_MAX_RANK];
-      const bool canCastXTad = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(xTadShapeInfo, castXTadShapeInfo);
+      OffsetIterator<1> xTadIt(xTadShapeInfo);
 
       if (shape::haveSameShapeAndStrides(xTadShapeInfo, yTadShapeInfo)) {
         Z extraParams[3];
@@ -1448,16 +1602,16 @@ void sd::Reduction3Loops<X, Z>::loopReduce3All(const X* x, const sd::LongType* x
             const auto zInd = ix * numYTads + iy;
             auto s = startVal;
 
-            for (sd::LongType j = 0; j < tadLen; ++j) {
-              const auto tadOffset = shape::indexOffset(j, xTadShapeInfo, castXTadShapeInfo, canCastXTad);
+            xTadIt.seek(0);
+            for (sd::LongType j = 0; j < tadLen; ++j, xTadIt.next()) {
+              const auto tadOffset = xTadIt.offset(0);
               s = OpType::update(s, OpType::op(xTad[tadOffset], yTad[tadOffset], extraParams), extraParams);
             }
             z[zInd * zEws] = OpType::postProcess(s, tadLen, extraParams);
           }
         };
       } else {
-        sd::Unsigned castYTadShapeInfo[SD_MAX_RANK];
-        const bool canCastYTad = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(yTadShapeInfo, castYTadShapeInfo);
+        OffsetIterator<2> xyTadIt(xTadShapeInfo, yTadShapeInfo);
 
         Z extraParams[3];
         for (sd::LongType ix = 0; ix < numXTads; ix++) {
@@ -1471,9 +1625,10 @@ void sd::Reduction3Loops<X, Z>::loopReduce3All(const X* x, const sd::LongType* x
             const auto zInd = ix * numYTads + iy;
             auto s = startVal;
 
-            for (sd::LongType j = 0; j < tadLen; ++j) {
-              const auto xTadOffset = shape::indexOffset(j, xTadShapeInfo, castXTadShapeInfo, canCastXTad);
-              const auto yTadOffset = shape::indexOffset(j, yTadShapeInfo, castYTadShapeInfo, canCastYTad);
+            xyTadIt.seek(0);
+            for (sd::LongType j = 0; j < tadLen; ++j, xyTadIt.next()) {
+              const auto xTadOffset = xyTadIt.offset(0);
+              const auto yTadOffset = xyTadIt.offset(1);
               s = OpType::update(s, OpType::op(xTad[xTadOffset], yTad[yTadOffset], extraParams), extraParams);
             }
 
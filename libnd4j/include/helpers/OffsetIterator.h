@@ -0,0 +1,136 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Incremental offset iteration over strided arrays.
+//
+// OffsetIterator<N> walks N arrays of equal length in lockstep, in the c-order of their logical indices,
+// and keeps the buffer offset of the current element of each array. Dimensions of size 1 are dropped and
+// dimensions contiguous with their inner neighbour are merged per array, so moving to the next element is
+// an add and a compare for almost every step, instead of the division and modulo per dimension that
+// shape::getIndexOffset does. seek() positions the iterator at any index, which is how a thread starts
+// on its own chunk of [0, length).
+//
+//   OffsetIterator<2> it(xShapeInfo, zShapeInfo);
+//   it.seek(start);
+//   for (auto i = start; i < stop; i++, it.next()) z[it.offset(1)] = OpType::op(x[it.offset(0)], extraParams);
+//
+#ifndef LIBND4J_OFFSETITERATOR_H
+#define LIBND4J_OFFSETITERATOR_H
+#include <helpers/shape.h>
+
+namespace sd {
+
+template <int N>
+class OffsetIterator {
+ private:
+  int _rank[N];
+  sd::LongType _shape[N][SD_MAX_RANK];
+  sd::LongType _strides[N][SD_MAX_RANK];
+  sd::LongType _coords[N][SD_MAX_RANK];
+  sd::LongType _offsets[N];
+
+  SD_INLINE void collapse(const int a, const sd::LongType* shapeInfo) {
+    const int rank = shape::rank(shapeInfo);
+    const sd::LongType* shape = shape::shapeOf(shapeInfo);
+    const sd::LongType* strides = shape::stride(shapeInfo);
+
+    int r = 0;
+    for (int d = 0; d < rank; ++d) {
+      if (shape[d] == 1) continue;
+
+      if (r > 0 && _strides[a][r - 1] == strides[d] * shape[d]) {
+        _shape[a][r - 1] *= shape[d];
+        _strides[a][r - 1] = strides[d];
+      } else {
+        _shape[a][r] = shape[d];
+        _strides[a][r] = strides[d];
+        ++r;
+      }
+    }
+
+    // scalars and arrays of unities
+    if (r == 0) {
+      _shape[a][0] = 1;
+      _strides[a][0] = 0;
+      r = 1;
+    }
+    _rank[a] = r;
+  }
+
+  SD_INLINE void init(const sd::LongType* const* shapeInfos) {
+    for (int a = 0; a < N; ++a) collapse(a, shapeInfos[a]);
+    seek(0);
+  }
+
+ public:
+  explicit OffsetIterator(const sd::LongType* shapeInfo) {
+    static_assert(N == 1, "OffsetIterator: the number of shapes has to match N");
+    const sd::LongType* shapeInfos[] = {shapeInfo};
+    init(shapeInfos);
+  }
+
+  OffsetIterator(const sd::LongType* shapeInfo0, const sd::LongType* shapeInfo1) {
+    static_assert(N == 2, "OffsetIterator: the number of shapes has to match N");
+    const sd::LongType* shapeInfos[] = {shapeInfo0, shapeInfo1};
+    init(shapeInfos);
+  }
+
+  OffsetIterator(const sd::LongType* shapeInfo0, const sd::LongType* shapeInfo1, const sd::LongType* shapeInfo2) {
+    static_assert(N == 3, "OffsetIterator: the number of shapes has to match N");
+    const sd::LongType* shapeInfos[] = {shapeInfo0, shapeInfo1, shapeInfo2};
+    init(shapeInfos);
+  }
+
+  // positions the iterator at the element with logical index `index`
+  SD_INLINE void seek(sd::LongType index) {
+    for (int a = 0; a < N; ++a) {
+      sd::LongType rest = index;
+      _offsets[a] = 0;
+      for (int d = _rank[a] - 1; d >= 0; --d) {
+        _coords[a][d] = rest % _shape[a][d];
+        rest /= _shape[a][d];
+        _offsets[a] += _coords[a][d] * _strides[a][d];
+      }
+    }
+  }
+
+  // moves to the next element, carrying into outer dimensions only at the end of the innermost one
+  SD_INLINE void next() {
+    for (int a = 0; a < N; ++a) {
+      int d = _rank[a] - 1;
+      _offsets[a] += _strides[a][d];
+      while (++_coords[a][d] == _shape[a][d] && d > 0) {
+        _offsets[a] -= _shape[a][d] * _strides[a][d];
+        _coords[a][d] = 0;
+        --d;
+        _offsets[a] += _strides[a][d];
+      }
+    }
+  }
+
+  SD_INLINE sd::LongType offset(const int a) const { return _offsets[a]; }
+
+  // rank of array `a` after collapsing, 1 means the array is traversed with a single constant stride
+  SD_INLINE int rank(const int a) const { return _rank[a]; }
+};
+
+}  // namespace sd
+
+#endif  // LIBND4J_OFFSETITERATOR_H
@@ -49,6 +49,7 @@ class SD_LIB_EXPORT OpBenchmark {
   OpBenchmark(std::string name, NDArray *x, NDArray *z, std::vector<int> axis);
   OpBenchmark(std::string name, NDArray *x, NDArray *y, NDArray *z, std::initializer_list<int> axis);
   OpBenchmark(std::string name, NDArray *x, NDArray *y, NDArray *z, std::vector<int> axis);
+  virtual ~OpBenchmark() = default;
 
   void setOpNum(int opNum);
   void setTestName(std::string testName);
@@ -71,6 +72,10 @@ class SD_LIB_EXPORT OpBenchmark {
   virtual std::string shape();
   virtual std::string inplace() = 0;
 
+  // memory traffic and arithmetic of a single execution, used to report rates
+  virtual double bytes();
+  virtual double flops();
+
   virtual void executeOnce() = 0;
 
   virtual OpBenchmark *clone() = 0;
@@ -0,0 +1,77 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Collected benchmark results, printable as a table or as JSON for comparing builds
+//
+
+#ifndef DEV_TESTS_BENCHMARKREPORT_H
+#define DEV_TESTS_BENCHMARKREPORT_H
+#include <helpers/benchmark/BenchmarkStats.h>
+#include <system/common.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace sd {
+class SD_LIB_EXPORT BenchmarkRecord {
+ public:
+  std::string suite;
+  std::string name;
+  std::string shape;
+  std::string dataType;
+  std::map<std::string, int> parameters;
+  int threads = 1;
+  BenchmarkStats stats;
+
+  // per execution, 0 if unknown
+  double bytes = 0.0;
+  double flops = 0.0;
+
+  // rates at the median time
+  double bytesPerSecond() const;
+  double flopsPerSecond() const;
+};
+
+class SD_LIB_EXPORT BenchmarkReport {
+ private:
+  std::vector<BenchmarkRecord> _records;
+
+ public:
+  BenchmarkReport() = default;
+
+  void add(const BenchmarkRecord &record);
+  const std::vector<BenchmarkRecord> &records() const;
+
+  std::string toText() const;
+
+  /**
+   * JSON document with the host description and one entry per record
+   */
+  std::string toJson() const;
+
+  /**
+   * writes toJson() to the file, throws std::runtime_error on failure
+   */
+  void save(const std::string &path) const;
+};
+}  // namespace sd
+
+#endif  // DEV_TESTS_BENCHMARKREPORT_H
@@ -0,0 +1,82 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Summary statistics of a series of benchmark timings
+//
+
+#ifndef DEV_TESTS_BENCHMARKSTATS_H
+#define DEV_TESTS_BENCHMARKSTATS_H
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sd {
+class BenchmarkStats {
+ public:
+  // all timings are in microseconds
+  int iterations = 0;
+  double mean = 0.0;
+  double median = 0.0;
+  double p99 = 0.0;
+  double min = 0.0;
+  double max = 0.0;
+  double stdev = 0.0;
+
+  // 95% confidence interval of the median, from the order statistics of the sample
+  double ciLow = 0.0;
+  double ciHigh = 0.0;
+
+  BenchmarkStats() = default;
+
+  static BenchmarkStats build(std::vector<double> timings) {
+    BenchmarkStats stats;
+    const int n = static_cast<int>(timings.size());
+    if (n == 0) return stats;
+
+    std::sort(timings.begin(), timings.end());
+
+    double sum = 0.0;
+    for (auto t : timings) sum += t;
+
+    double squares = 0.0;
+    const double mean = sum / n;
+    for (auto t : timings) squares += (t - mean) * (t - mean);
+
+    stats.iterations = n;
+    stats.mean = mean;
+    stats.median = n % 2 == 1 ? timings[n / 2] : (timings[n / 2 - 1] + timings[n / 2]) / 2.0;
+    stats.p99 = timings[std::min(n - 1, static_cast<int>(std::ceil(0.99 * n)) - 1)];
+    stats.min = timings.front();
+    stats.max = timings.back();
+    stats.stdev = n > 1 ? std::sqrt(squares / (n - 1)) : 0.0;
+
+    // the median lies between these ranks with 95% probability, whatever the distribution
+    const double halfWidth = 1.96 * std::sqrt(static_cast<double>(n)) / 2.0;
+    const int low = std::max(0, static_cast<int>(std::floor(n / 2.0 - halfWidth)));
+    const int high = std::min(n - 1, static_cast<int>(std::ceil(n / 2.0 + halfWidth)));
+    stats.ciLow = timings[low];
+    stats.ciHigh = timings[high];
+
+    return stats;
+  }
+};
+}  // namespace sd
+
+#endif  // DEV_TESTS_BENCHMARKSTATS_H
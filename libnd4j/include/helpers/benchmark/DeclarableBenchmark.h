@@ -77,6 +77,21 @@ class SD_LIB_EXPORT DeclarableBenchmark : public OpBenchmark {
 
   std::string inplace() override { return "N/A"; }
 
+  double bytes() override {
+    double result = 0.0;
+    if (_context != nullptr && _context->isFastPath()) {
+      for (auto array : _context->fastpath_in())
+        if (array != nullptr) result += static_cast<double>(array->lengthOf()) * array->sizeOfT();
+
+      for (auto array : _context->fastpath_out())
+        if (array != nullptr) result += static_cast<double>(array->lengthOf()) * array->sizeOfT();
+    }
+    return result;
+  }
+
+  // unknown for an arbitrary op
+  double flops() override { return 0.0; }
+
   void executeOnce() override {
     PointersManager pm(LaunchContext::defaultContext(), "DeclarableBenchmark");
     _op->execute(_context);
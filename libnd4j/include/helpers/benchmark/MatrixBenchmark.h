@@ -81,6 +81,12 @@ class SD_LIB_EXPORT MatrixBenchmark : public OpBenchmark {
 
   std::string inplace() override { return "N/A"; }
 
+  // multiply-add per element of z per element of the shared dimension
+  double flops() override {
+    const auto k = _tA ? _x->sizeAt(0) : _x->sizeAt(-1);
+    return 2.0 * static_cast<double>(_z->lengthOf()) * static_cast<double>(k);
+  }
+
   std::string orders() override {
     std::string result;
     result += _x->ordering();
@@ -49,6 +49,8 @@ class Parameters {
   int getIntParam(std::string string) const;
   bool getBoolParam(std::string string) const;
   std::vector<int> getArrayParam(std::string string) const;
+
+  const std::map<std::string, int>& intParams() const;
 };
 }  // namespace sd
 
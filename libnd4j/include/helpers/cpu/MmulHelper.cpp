@@ -27,6 +27,7 @@
 #include <execution/Threads.h>
 #include <helpers/BlasHelper.h>
 #include <helpers/ShapeUtils.h>
+#include <system/CpuDispatch.h>
 
 namespace sd {
 
@@ -592,6 +593,47 @@ multiplication !");
     return C;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+template <typename T1, typename T2, typename T3>
+struct UsualGemmArgs {
+  const T1* A;
+  const T2* B;
+  T3* C;
+  int K, lda, ldb, ldc;
+  bool flagA, flagB, flagC;
+  T3 alpha, beta;
+};
+
+// block of C rows [startX, stopX) x columns [startY, stopY), multi-versioned through isaDispatch
+template <typename T1, typename T2, typename T3>
+struct UsualGemmKernel {
+  static SD_INLINE void run(const UsualGemmArgs<T1, T2, T3>* args, const sd::LongType startX,
+                            const sd::LongType stopX, const sd::LongType incX, const sd::LongType startY,
+                            const sd::LongType stopY, const sd::LongType incY) {
+    const T1* A = args->A;
+    const T2* B = args->B;
+    const int lda = args->lda, ldb = args->ldb, ldc = args->ldc;
+
+    for (auto row = startX; row < stopX; row += incX) {
+      for (auto col = startY; col < stopY; col += incY) {
+        T3 *c = args->flagC ? (args->C + row + col * ldc) : (args->C + row * ldc + col);
+        T3 val = 0;
+
+        for (int i = 0; i < args->K; ++i) {
+          T3 a = args->flagA ? *(A + row * lda + i) : *(A + row + i * lda);
+          T3 b = args->flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);
+          val += args->alpha * a * b;
+        }
+
+        if (args->beta)
+          *c = val + args->beta * *c;
+        else
+          *c = val;
+      }
+    }
+  }
+};
+
 //////////////////////////////////////////////////////////////////////////////
 // MXK x KxN = MxN
 template <typename T1, typename T2, typename T3>
@@ -599,65 +641,19 @@ static void usualGemm(const char cOrder, const bool transA, const bool transB, c
 const double alpha, const void* vA, const int lda, const void* vB, const int ldb, const double beta, void* vC, const int
 ldc) {
 
-    T1* A = reinterpret_cast<T1*>(const_cast<void*>(vA));
-    T2* B = reinterpret_cast<T2*>(const_cast<void*>(vB));
-    T3* C = reinterpret_cast<T3*>(vC);
-    T3 alphaZ(alpha), betaZ(beta);
-
     const bool flagC = cOrder == 'f';
     const bool flagA = (flagC && transA) || (!flagC && !transA);
     const bool flagB = (flagC && transB) || (!flagC && !transB);
 
-    // PRAGMA_OMP_PARALLEL_FOR_ARGS(OMP_IF(M*N > Environment::getInstance().elementwiseThreshold()) schedule(guided))
-    // for(sd::Unsigned row = 0; row < M; ++row) {
-
-    //     T3* c = flagC ? (C + row) : (C + row * ldc);
-
-    //     for(sd::Unsigned col = 0; col < N; ++col)
-    //         c[flagC ? col * ldc : col] = 0;
-
-    //     for(sd::Unsigned i = 0; i < K; ++i) {
-
-    //         T3* b = flagB ? (B + i * ldb) : (B + i);
-    //         T3* a = flagA ? (A + row * lda + i) : (A + row + i * lda);
-
-    //         if(flagC) {
-    //             for(sd::Unsigned col = 0; col < N; ++col) {
-    //                 if(betaZ)
-    //                     c[col * ldc] += a * b[flagB ? col : col * ldb] + betaZ * c[col * ldc];
-    //                 else
-    //                     c[col * ldc] += a * b[flagB ? col : col * ldb];
-    //             }
-    //         }
-    //         else {
-    //             for(sd::Unsigned col = 0; col < N; ++col) {
-    //                 if(betaZ)
-    //                     c[col] += a * b[flagB ? col : col * ldb] + betaZ * c[col];
-    //                 else
-    //                     c[col] += a * b[flagB ? col : col * ldb];
-    //             }
-    //         }
-    //     }
-    // }
-
-    auto func = PRAGMA_THREADS_FOR_2D { ;
-        for (auto row = start_x; row < stop_x; row += inc_x) {
-            for (auto col = start_y; col < stop_y; col += inc_y) {
-                T3 *c = flagC ? (C + row + col * ldc) : (C + row * ldc + col);
-                T3 val = 0;
-
-                for (sd::Unsigned i = 0; i < K; ++i) {
-                    T3 a = flagA ? *(A + row * lda + i) : *(A + row + i * lda);
-                    T3 b = flagB ? *(B + col + i * ldb) : *(B + col * ldb + i);
-                    val += alphaZ * a * b;
-                }
-
-                if (betaZ)
-                    *c = val + betaZ * *c;
-                else
-                    *c = val;
-            }
-        }
+    const UsualGemmArgs<T1, T2, T3> args = {reinterpret_cast<const T1*>(vA), reinterpret_cast<const T2*>(vB),
+                                            reinterpret_cast<T3*>(vC), K, lda, ldb, ldc, flagA, flagB, flagC,
+                                            static_cast<T3>(alpha), static_cast<T3>(beta)};
+
+    auto func = PRAGMA_THREADS_FOR_2D {
+        isaDispatch<UsualGemmKernel<T1, T2, T3>>(&args, static_cast<sd::LongType>(start_x),
+                                                 static_cast<sd::LongType>(stop_x), static_cast<sd::LongType>(inc_x),
+                                                 static_cast<sd::LongType>(start_y), static_cast<sd::LongType>(stop_y),
+                                                 static_cast<sd::LongType>(inc_y));
     };
 
     samediff::Threads::parallel_tad(func, 0, M, 1, 0, N, 1);
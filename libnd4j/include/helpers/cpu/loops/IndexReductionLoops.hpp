@@ -220,10 +220,10 @@ SD_LIB_HIDDEN void sd::IndexReductionLoops<X, Z>::loopIndexReduce(const X* x, co
 
       //*********************************************//
     case sd::LoopKind::X_EWSNONZERO: {
-      sd::Unsigned castZShapeInfo[SD_MAX_RANK];
-      const bool canCastZ = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(zShapeInfo, castZShapeInfo);
-
       auto func = PRAGMA_THREADS_FOR {
+        OffsetIterator<1> zIt(zShapeInfo);
+        zIt.seek(start);
+
         for (auto i = start; i < stop; i++) {
           auto tad = const_cast<X*>(x) + tadOffsets[i];
           auto indexValue = OpType::startingIndexValue(tad);
@@ -233,8 +233,8 @@ SD_LIB_HIDDEN void sd::IndexReductionLoops<X, Z>::loopIndexReduce(const X* x, co
             indexValue = OpType::update(indexValue, comp, extraParams);
           }
 
-          auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, canCastZ);
-          z[zOffset] = (Z)indexValue.index;
+          z[zIt.offset(0)] = (Z)indexValue.index;
+          zIt.next();
         }
       };
 
@@ -243,17 +243,16 @@ SD_LIB_HIDDEN void sd::IndexReductionLoops<X, Z>::loopIndexReduce(const X* x, co
 
       //*********************************************//
     case sd::LoopKind::Z_EWSNONZERO: {
-      sd::Unsigned castTadShapeInfo[SD_MAX_RANK];
-      const bool canCastTad = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(tadShapeInfo, castTadShapeInfo);
-
       auto func = PRAGMA_THREADS_FOR {
+        OffsetIterator<1> tadIt(tadShapeInfo);
+
         for (auto i = start; i < stop; i++) {
           auto tad = const_cast<X*>(x) + tadOffsets[i];
           auto indexValue = OpType::startingIndexValue(tad);
 
-          for (sd::LongType j = 0; j < tadLen; j++) {
-            auto tadOffset = shape::indexOffset(j, tadShapeInfo, castTadShapeInfo, canCastTad);
-            functions::indexreduce::IndexValue<X> comp(tad[tadOffset], j);
+          tadIt.seek(0);
+          for (sd::LongType j = 0; j < tadLen; j++, tadIt.next()) {
+            functions::indexreduce::IndexValue<X> comp(tad[tadIt.offset(0)], j);
             indexValue = OpType::update(indexValue, comp, extraParams);
           }
 
@@ -266,24 +265,23 @@ SD_LIB_HIDDEN void sd::IndexReductionLoops<X, Z>::loopIndexReduce(const X* x, co
 
       //*********************************************//
     default: {
-      sd::Unsigned castTadShapeInfo[SD_MAX_RANK];
-      sd::Unsigned castZShapeInfo[SD_MAX_RANK];
-      const bool canCastTad = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(tadShapeInfo, castTadShapeInfo);
-      const bool canCastZ = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(zShapeInfo, castZShapeInfo);
-
       auto func = PRAGMA_THREADS_FOR {
+        OffsetIterator<1> tadIt(tadShapeInfo);
+        OffsetIterator<1> zIt(zShapeInfo);
+        zIt.seek(start);
+
         for (auto i = start; i < stop; i++) {
           auto tad = const_cast<X*>(x) + tadOffsets[i];
           auto indexValue = OpType::startingIndexValue(tad);
 
-          for (sd::LongType j = 0; j < tadLen; j++) {
-            auto tadOffset = shape::indexOffset(j, tadShapeInfo, castTadShapeInfo, canCastTad);
-            functions::indexreduce::IndexValue<X> comp(tad[tadOffset], j);
+          tadIt.seek(0);
+          for (sd::LongType j = 0; j < tadLen; j++, tadIt.next()) {
+            functions::indexreduce::IndexValue<X> comp(tad[tadIt.offset(0)], j);
             indexValue = OpType::update(indexValue, comp, extraParams);
           }
 
-          auto zOffset = shape::indexOffset(i, zShapeInfo, castZShapeInfo, canCastZ);
-          z[zOffset] = (Z)indexValue.index;
+          z[zIt.offset(0)] = (Z)indexValue.index;
+          zIt.next();
         }
       };
 
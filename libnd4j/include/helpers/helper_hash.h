@@ -27,7 +27,6 @@
 
 #include <system/common.h>
 
-#include <mutex>
 #include <string>
 
 namespace sd {
@@ -38,12 +37,17 @@ class SD_LIB_EXPORT HashHelper {
   const sd::LongType HSTART = 0xBB40E64DA205B064L;
   const sd::LongType HMULT = 7664345821815920749L;
 
-  bool _isInit = false;
-  std::mutex _locker;
+  HashHelper();
 
  public:
   static HashHelper& getInstance();
   sd::LongType getLongHash(std::string& str);
+
+  // lock-free variants for hot loops: the hash of a byte range can be built incrementally
+  // starting from initialLongHash(), and equals getLongHash() of the same bytes as std::string
+  sd::LongType initialLongHash() const { return HSTART; }
+  sd::LongType updateLongHash(sd::LongType hash, const void* data, sd::LongType length) const;
+  sd::LongType getLongHash(const void* data, sd::LongType length) const;
 };
 }  // namespace ops
 }  // namespace sd
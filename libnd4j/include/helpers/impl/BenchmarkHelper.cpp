@@ -27,6 +27,10 @@
 
 #include <chrono>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace sd {
 BenchmarkHelper::BenchmarkHelper(unsigned int warmUpIterations, unsigned int runIterations) {
   _wIterations = warmUpIterations;
@@ -40,6 +44,18 @@ std::string BenchmarkHelper::printHeader() {
 }
 
 std::string BenchmarkHelper::benchmarkOperation(OpBenchmark &benchmark) {
+  if (_report != nullptr) {
+    auto threads = _threads;
+    if (threads.empty()) threads.emplace_back(Environment::getInstance().maxThreads());
+
+    for (auto &record : measure(benchmark, _suite, threads)) {
+      record.parameters = _parameters;
+      _report->add(record);
+    }
+
+    return std::string();
+  }
+
   for (sd::Unsigned i = 0; i < _wIterations; i++) benchmark.executeOnce();
 
   std::vector<sd::LongType> timings(_rIterations);
@@ -179,6 +195,7 @@ std::string BenchmarkHelper::runOperationSuit(DeclarableBenchmark *op,
   std::vector<OpBenchmark *> list;
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     auto ctx = func(p);
 
     auto clone = reinterpret_cast<DeclarableBenchmark *>(op->clone());
@@ -189,6 +206,8 @@ std::string BenchmarkHelper::runOperationSuit(DeclarableBenchmark *op,
     delete clone;
   }
 
+  _parameters.clear();
+
   return result;
 }
 
@@ -207,6 +226,7 @@ std::string BenchmarkHelper::runOperationSuit(ScalarBenchmark *op,
   output += printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet z;
@@ -235,6 +255,8 @@ std::string BenchmarkHelper::runOperationSuit(ScalarBenchmark *op,
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
 
@@ -288,6 +310,7 @@ std::string BenchmarkHelper::runOperationSuit(TransformBenchmark *op,
   output += printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet z;
@@ -316,6 +339,8 @@ std::string BenchmarkHelper::runOperationSuit(TransformBenchmark *op,
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
 
@@ -369,6 +394,7 @@ std::string BenchmarkHelper::runOperationSuit(ReductionBenchmark *op,
   output += printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet z;
@@ -397,6 +423,8 @@ std::string BenchmarkHelper::runOperationSuit(ReductionBenchmark *op,
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
 
@@ -449,6 +477,7 @@ std::string BenchmarkHelper::runOperationSuit(
   printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet y;
@@ -486,6 +515,8 @@ std::string BenchmarkHelper::runOperationSuit(
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
 
@@ -547,6 +578,7 @@ std::string BenchmarkHelper::runOperationSuit(
   output += printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet y;
@@ -580,6 +612,8 @@ std::string BenchmarkHelper::runOperationSuit(
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
 
@@ -598,6 +632,7 @@ std::string BenchmarkHelper::runOperationSuit(
   output += printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet y;
@@ -631,6 +666,8 @@ std::string BenchmarkHelper::runOperationSuit(
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
 
@@ -689,6 +726,7 @@ std::string BenchmarkHelper::runOperationSuit(
   output += printHeader();
 
   for (auto &p : parameters) {
+    _parameters = p.intParams();
     ResultSet x;
     x.setNonRemovable();
     ResultSet y;
@@ -719,6 +757,70 @@ std::string BenchmarkHelper::runOperationSuit(
     }
   }
 
+  _parameters.clear();
+
   return output;
 }
+
+BenchmarkStats BenchmarkHelper::measure(const std::function<void()> &func) {
+  for (sd::Unsigned i = 0; i < _wIterations; i++) func();
+
+  std::vector<double> timings(_rIterations);
+  for (sd::Unsigned i = 0; i < _rIterations; i++) {
+    auto timeStart = std::chrono::steady_clock::now();
+
+    func();
+
+    auto timeEnd = std::chrono::steady_clock::now();
+    timings[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count() / 1000.0;
+  }
+
+  return BenchmarkStats::build(timings);
+}
+
+std::vector<BenchmarkRecord> BenchmarkHelper::measure(OpBenchmark &benchmark, const std::string &suite,
+                                                      const std::vector<int> &threads) {
+  std::vector<BenchmarkRecord> result;
+  auto &environment = Environment::getInstance();
+  const auto maxThreads = environment.maxThreads();
+  const auto maxMasterThreads = environment.maxMasterThreads();
+
+  for (auto t : threads) {
+    setThreads(t);
+
+    BenchmarkRecord record;
+    record.suite = suite;
+    record.name = benchmark.testName();
+    record.shape = benchmark.shape();
+    record.dataType = benchmark.dataType();
+    record.threads = t;
+    record.bytes = benchmark.bytes();
+    record.flops = benchmark.flops();
+    record.stats = measure([&]() { benchmark.executeOnce(); });
+
+    result.emplace_back(record);
+  }
+
+  setThreads(maxThreads);
+  environment.setMaxMasterThreads(maxMasterThreads);
+
+  return result;
+}
+
+void BenchmarkHelper::setReport(BenchmarkReport *report, const std::string &suite, const std::vector<int> &threads) {
+  _report = report;
+  _suite = suite;
+  _threads = threads;
+  _parameters.clear();
+}
+
+void BenchmarkHelper::setThreads(int threads) {
+  auto &environment = Environment::getInstance();
+
+  environment.setMaxThreads(threads);
+  environment.setMaxMasterThreads(threads);
+#ifdef _OPENMP
+  omp_set_num_threads(threads);
+#endif
+}
 }  // namespace sd
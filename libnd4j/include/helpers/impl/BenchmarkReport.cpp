@@ -0,0 +1,143 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Benchmark report formatting
+//
+#include <helpers/benchmark/BenchmarkReport.h>
+#include <system/CpuDispatch.h>
+#include <system/Environment.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace sd {
+
+double BenchmarkRecord::bytesPerSecond() const { return stats.median > 0.0 ? bytes / (stats.median * 1e-6) : 0.0; }
+
+double BenchmarkRecord::flopsPerSecond() const { return stats.median > 0.0 ? flops / (stats.median * 1e-6) : 0.0; }
+
+void BenchmarkReport::add(const BenchmarkRecord &record) { _records.emplace_back(record); }
+
+const std::vector<BenchmarkRecord> &BenchmarkReport::records() const { return _records; }
+
+static std::string escapeJson(const std::string &value) {
+  std::string result;
+  for (auto c : value) {
+    switch (c) {
+      case '"':
+        result += "\\\"";
+        break;
+      case '\\':
+        result += "\\\\";
+        break;
+      case '\n':
+        result += "\\n";
+        break;
+      case '\t':
+        result += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buffer[8];
+          snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+          result += buffer;
+        } else {
+          result += c;
+        }
+    }
+  }
+  return result;
+}
+
+// JSON has no representation for inf and nan
+static std::string jsonNumber(double value) {
+  if (!std::isfinite(value)) return "null";
+
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%.6g", value);
+  return buffer;
+}
+
+std::string BenchmarkReport::toText() const {
+  std::string result =
+      "Suite\tName\tThreads\tDataType\tShape\tIters\tmedian (us)\tp99 (us)\tCI95 (us)\tGB/s\tGFLOP/s\n";
+
+  for (const auto &r : _records) {
+    char buffer[1024];
+    snprintf(buffer, sizeof(buffer), "%s\t%s\t%i\t%s\t%s\t%i\t%.2f\t%.2f\t%.2f-%.2f\t%.3f\t%.3f\n", r.suite.c_str(),
+             r.name.c_str(), r.threads, r.dataType.c_str(), r.shape.c_str(), r.stats.iterations, r.stats.median,
+             r.stats.p99, r.stats.ciLow, r.stats.ciHigh, r.bytesPerSecond() * 1e-9, r.flopsPerSecond() * 1e-9);
+    result += buffer;
+  }
+
+  return result;
+}
+
+std::string BenchmarkReport::toJson() const {
+  auto &environment = Environment::getInstance();
+  std::ostringstream out;
+
+  out << "{\n";
+  out << "  \"host\": {\"isa\": \"" << CpuDispatch::isaName(CpuDispatch::getInstance().isa())
+      << "\", \"maxThreads\": " << environment.maxThreads()
+      << ", \"maxMasterThreads\": " << environment.maxMasterThreads() << "},\n";
+  out << "  \"results\": [";
+
+  for (size_t e = 0; e < _records.size(); e++) {
+    const auto &r = _records[e];
+    out << (e == 0 ? "\n" : ",\n");
+    out << "    {\"suite\": \"" << escapeJson(r.suite) << "\", \"name\": \"" << escapeJson(r.name) << "\", \"shape\": \""
+        << escapeJson(r.shape) << "\", \"dataType\": \"" << escapeJson(r.dataType) << "\", \"threads\": " << r.threads;
+
+    out << ", \"parameters\": {";
+    bool first = true;
+    for (const auto &p : r.parameters) {
+      out << (first ? "" : ", ") << "\"" << escapeJson(p.first) << "\": " << p.second;
+      first = false;
+    }
+    out << "}";
+
+    out << ", \"iterations\": " << r.stats.iterations << ", \"mean_us\": " << jsonNumber(r.stats.mean)
+        << ", \"median_us\": " << jsonNumber(r.stats.median) << ", \"p99_us\": " << jsonNumber(r.stats.p99)
+        << ", \"min_us\": " << jsonNumber(r.stats.min) << ", \"max_us\": " << jsonNumber(r.stats.max)
+        << ", \"stdev_us\": " << jsonNumber(r.stats.stdev) << ", \"ci95_us\": [" << jsonNumber(r.stats.ciLow) << ", "
+        << jsonNumber(r.stats.ciHigh) << "]";
+
+    out << ", \"bytes\": " << jsonNumber(r.bytes) << ", \"flops\": " << jsonNumber(r.flops)
+        << ", \"bytes_per_second\": " << jsonNumber(r.bytesPerSecond())
+        << ", \"flops_per_second\": " << jsonNumber(r.flopsPerSecond()) << "}";
+  }
+
+  out << (_records.empty() ? "]\n" : "\n  ]\n");
+  out << "}\n";
+  return out.str();
+}
+
+void BenchmarkReport::save(const std::string &path) const {
+  std::ofstream out(path);
+  if (!out.good()) throw std::runtime_error("BenchmarkReport: can't write to " + path);
+
+  out << toJson();
+  if (!out.good()) throw std::runtime_error("BenchmarkReport: can't write to " + path);
+}
+}  // namespace sd
@@ -48,6 +48,20 @@ void BlasHelper::initializeFunctions(sd::Pointer *functions) {
   this->lapackeDgesvd = (LapackeDgesvd)functions[7];
   this->lapackeSgesdd = (LapackeSgesdd)functions[8];
   this->lapackeDgesdd = (LapackeDgesdd)functions[9];
+
+  _hasStrsm = functions[10] != nullptr;
+  _hasDtrsm = functions[11] != nullptr;
+
+  this->cblasStrsm = (CblasStrsm)functions[10];
+  this->cblasDtrsm = (CblasDtrsm)functions[11];
+  this->lapackeSgetrf = (LapackeSgetrf)functions[12];
+  this->lapackeDgetrf = (LapackeDgetrf)functions[13];
+  this->lapackeSpotrf = (LapackeSpotrf)functions[14];
+  this->lapackeDpotrf = (LapackeDpotrf)functions[15];
+  this->lapackeSgeqrf = (LapackeSgeqrf)functions[16];
+  this->lapackeDgeqrf = (LapackeDgeqrf)functions[17];
+  this->lapackeSorgqr = (LapackeSorgqr)functions[18];
+  this->lapackeDorgqr = (LapackeDorgqr)functions[19];
 }
 
 void BlasHelper::initializeDeviceFunctions(sd::Pointer *functions) {
@@ -292,6 +306,30 @@ bool BlasHelper::hasBatchedGEMM<bool>() {
   return false;
 }
 
+template <>
+bool BlasHelper::hasTRSM<float>() {
+  if (sd::Environment::getInstance().blasFallback()) return false;
+
+#if defined(__EXTERNAL_BLAS__) || defined(HAVE_OPENBLAS)
+  return true;
+#else
+  return _hasStrsm;
+#endif
+}
+
+template <>
+bool BlasHelper::hasTRSM<double>() {
+  if (sd::Environment::getInstance().blasFallback()) return false;
+
+#if defined(__EXTERNAL_BLAS__) || defined(HAVE_OPENBLAS)
+  return true;
+#else
+  return _hasDtrsm;
+#endif
+}
+
+bool BlasHelper::hasLAPACK() { return !sd::Environment::getInstance().blasFallback(); }
+
 CblasSgemv BlasHelper::sgemv() {
 #if defined(__EXTERNAL_BLAS__) || defined(HAVE_OPENBLAS)
   return (CblasSgemv)&cblas_sgemv;
@@ -335,6 +373,38 @@ LapackeSgesdd BlasHelper::sgesdd() { return this->lapackeSgesdd; }
 
 LapackeDgesdd BlasHelper::dgesdd() { return this->lapackeDgesdd; }
 
+CblasStrsm BlasHelper::strsm() {
+#if defined(__EXTERNAL_BLAS__) || defined(HAVE_OPENBLAS)
+  return (CblasStrsm)&cblas_strsm;
+#else
+  return this->cblasStrsm;
+#endif
+}
+
+CblasDtrsm BlasHelper::dtrsm() {
+#if defined(__EXTERNAL_BLAS__) || defined(HAVE_OPENBLAS)
+  return (CblasDtrsm)&cblas_dtrsm;
+#else
+  return this->cblasDtrsm;
+#endif
+}
+
+LapackeSgetrf BlasHelper::sgetrf() { return this->lapackeSgetrf; }
+
+LapackeDgetrf BlasHelper::dgetrf() { return this->lapackeDgetrf; }
+
+LapackeSpotrf BlasHelper::spotrf() { return this->lapackeSpotrf; }
+
+LapackeDpotrf BlasHelper::dpotrf() { return this->lapackeDpotrf; }
+
+LapackeSgeqrf BlasHelper::sgeqrf() { return this->lapackeSgeqrf; }
+
+LapackeDgeqrf BlasHelper::dgeqrf() { return this->lapackeDgeqrf; }
+
+LapackeSorgqr BlasHelper::sorgqr() { return this->lapackeSorgqr; }
+
+LapackeDorgqr BlasHelper::dorgqr() { return this->lapackeDorgqr; }
+
 // destructor
 BlasHelper::~BlasHelper() noexcept {}
 }  // namespace sd
@@ -23,6 +23,7 @@
 #include <helpers/OmpLaunchHelper.h>
 #include <math/templatemath.h>
 #include <system/Environment.h>
+#include <system/ParallelCostModel.h>
 
 namespace sd {
 
@@ -76,6 +77,11 @@ int OmpLaunchHelper::betterThreads(sd::LongType N) {
 }
 
 int OmpLaunchHelper::betterThreads(sd::LongType N, int maxThreads) {
+  // a calibrated cost model takes over from the static threshold
+  auto& costModel = ParallelCostModel::getInstance();
+  if (costModel.isCalibrated())
+    return costModel.numberOfThreads(CostClass::ELEMENTWISE, sd::DataType::FLOAT32, N, maxThreads);
+
   auto t = Environment::getInstance().elementwiseThreshold();
   if (N < t)
     return 1;
@@ -97,7 +103,13 @@ int OmpLaunchHelper::tadThreads(sd::LongType tadLength, sd::LongType numTads) {
   auto totalLength = tadLength * numTads;
 
   // if array is tiny - no need to spawn any threeds
-  if (totalLength < Environment::getInstance().elementwiseThreshold()) return 1;
+  auto& costModel = ParallelCostModel::getInstance();
+  if (costModel.isCalibrated()) {
+    maxThreads = costModel.numberOfThreads(CostClass::REDUCTION, sd::DataType::FLOAT32, totalLength, maxThreads);
+    if (maxThreads <= 1) return 1;
+  } else if (totalLength < Environment::getInstance().elementwiseThreshold()) {
+    return 1;
+  }
 
   // by default we're spawning as many threads we can, but not more than number of TADs
   return sd::math::sd_min<int>(numTads, maxThreads);
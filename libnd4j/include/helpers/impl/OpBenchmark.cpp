@@ -95,6 +95,26 @@ std::string OpBenchmark::shape() {
     return "N/A";
 }
 
+double OpBenchmark::bytes() {
+  double result = 0.0;
+  for (auto array : {_x, _y, _z}) {
+    if (array == nullptr || (array == _z && (_z == _x || _z == _y))) continue;
+
+    result += static_cast<double>(array->lengthOf()) * array->sizeOfT();
+  }
+
+  // in-place ops write back to their input
+  if (_z != nullptr && (_z == _x || _z == _y)) result += static_cast<double>(_z->lengthOf()) * _z->sizeOfT();
+
+  return result;
+}
+
+double OpBenchmark::flops() {
+  if (_x != nullptr) return static_cast<double>(_x->lengthOf());
+
+  return _z != nullptr ? static_cast<double>(_z->lengthOf()) : 0.0;
+}
+
 std::string OpBenchmark::dataType() {
   if (_x != nullptr)
     return DataTypeUtils::asString(_x->dataType());
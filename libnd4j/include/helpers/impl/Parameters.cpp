@@ -37,6 +37,8 @@ int Parameters::getIntParam(std::string string) const {
   return _intParams.at(string);
 }
 
+const std::map<std::string, int>& Parameters::intParams() const { return _intParams; }
+
 Parameters* Parameters::addIntParam(std::initializer_list<std::string> strings, std::initializer_list<int> params) {
   std::vector<std::string> s(strings);
   std::vector<int> p(params);
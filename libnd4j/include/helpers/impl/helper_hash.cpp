@@ -30,37 +30,37 @@ HashHelper& HashHelper::getInstance() {
   return instance;
 }
 
-sd::LongType HashHelper::getLongHash(std::string& str) {
-  _locker.lock();
-  if (!_isInit) {
-    sd_verbose("Building HashUtil table\n", "");
+HashHelper::HashHelper() {
+  sd_verbose("Building HashUtil table\n", "");
 
-    sd::LongType h = 0x544B2FBACAAF1684L;
-    for (int i = 0; i < 256; i++) {
-      for (int j = 0; j < 31; j++) {
-        h = (((unsigned long long)h) >> 7) ^ h;
-        h = (h << 11) ^ h;
-        h = (((unsigned long long)h) >> 10) ^ h;
-      }
-      _byteTable[i] = h;
+  sd::LongType h = 0x544B2FBACAAF1684L;
+  for (int i = 0; i < 256; i++) {
+    for (int j = 0; j < 31; j++) {
+      h = (((unsigned long long)h) >> 7) ^ h;
+      h = (h << 11) ^ h;
+      h = (((unsigned long long)h) >> 10) ^ h;
     }
-
-    _isInit = true;
+    _byteTable[i] = h;
   }
+}
 
-  _locker.unlock();
-
-  sd::LongType h = HSTART;
+sd::LongType HashHelper::updateLongHash(sd::LongType hash, const void* data, sd::LongType length) const {
+  auto bytes = static_cast<const unsigned char*>(data);
+  sd::LongType h = hash;
   sd::LongType hmult = HMULT;
-  sd::LongType len = str.size();
-  for (int i = 0; i < len; i++) {
-    char ch = str.at(i);
-    auto uch = (unsigned char)ch;
-    h = (h * hmult) ^ _byteTable[ch & 0xff];
-    h = (h * hmult) ^ _byteTable[(uch >> 8) & 0xff];
+  for (sd::LongType i = 0; i < length; i++) {
+    // second round mixes the high byte of a (single byte) char, which is always zero
+    h = (h * hmult) ^ _byteTable[bytes[i]];
+    h = (h * hmult) ^ _byteTable[0];
   }
 
   return h;
 }
+
+sd::LongType HashHelper::getLongHash(const void* data, sd::LongType length) const {
+  return updateLongHash(HSTART, data, length);
+}
+
+sd::LongType HashHelper::getLongHash(std::string& str) { return getLongHash(str.data(), str.size()); }
 }  // namespace ops
 }  // namespace sd
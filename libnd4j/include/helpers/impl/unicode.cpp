@@ -21,6 +21,8 @@
 //
 #include <helpers/unicode.h>
 
+#include <cstring>
+
 namespace sd {
 namespace unicode {
 
@@ -36,6 +38,25 @@ constexpr uint32_t BYTEOFFSET = 0x10000u - (HIGHBYTEMIN << 10) - TRAILBYTEMIN;
 // Maximum valid value for a Unicode code point
 constexpr uint32_t CODEPOINTMAX = 0x0010ffffu;
 
+// word-at-a-time fast paths: runs of ASCII are checked and converted 8 bytes (4 utf16 units) per step
+constexpr uint64_t ASCIIMASKU8 = 0x8080808080808080ull;
+constexpr uint64_t ASCIIMASKU16 = 0xff80ff80ff80ff80ull;
+
+SD_INLINE uint64_t loadWord(const void* it) {
+  uint64_t word;
+  std::memcpy(&word, it, sizeof(uint64_t));
+  return word;
+}
+
+SD_INLINE bool isAsciiWordU8(const void* it, const void* end) {
+  return static_cast<const int8_t*>(end) - static_cast<const int8_t*>(it) >= 8 && (loadWord(it) & ASCIIMASKU8) == 0;
+}
+
+SD_INLINE bool isAsciiWordU16(const void* it, const void* end) {
+  return static_cast<const uint16_t*>(end) - static_cast<const uint16_t*>(it) >= 4 &&
+         (loadWord(it) & ASCIIMASKU16) == 0;
+}
+
 template <typename T>
 SD_INLINE uint8_t castToU8(const T cp) {
   return static_cast<uint8_t>(0xff & cp);
@@ -151,6 +172,11 @@ sd::LongType symbolLength16(const T* it) {
 sd::LongType offsetUtf8StringInUtf32(const void* start, const void* end) {
   sd::LongType count = 0;
   for (auto it = static_cast<const int8_t*>(start); it != end; it++) {
+    if (isAsciiWordU8(it, end)) {
+      it += 7;
+      count += 8;
+      continue;
+    }
     auto length = symbolLength(it);
     it += (length > 0) ? (length - 1) : 0;
     count += 1;
@@ -171,6 +197,11 @@ sd::LongType offsetUtf16StringInUtf32(const void* start, const void* end) {
 sd::LongType offsetUtf8StringInUtf16(const void* start, const void* end) {
   sd::LongType count = 0;
   for (auto it = static_cast<const int8_t*>(start); it != end; it++) {
+    if (isAsciiWordU8(it, end)) {
+      it += 7;
+      count += 8;
+      continue;
+    }
     auto length = symbolLength(it);
     auto step = ((length > 0) ? (length - 1) : 0);
     it += step;
@@ -182,6 +213,11 @@ sd::LongType offsetUtf8StringInUtf16(const void* start, const void* end) {
 sd::LongType offsetUtf16StringInUtf8(const void* start, const void* end) {
   sd::LongType count = 0;
   for (auto it = static_cast<const uint16_t*>(start); it != end;) {
+    if (isAsciiWordU16(it, end)) {
+      it += 4;
+      count += 4;
+      continue;
+    }
     auto length = symbolLength16(it);
     it += (4 == length) ? 2 : 1;
     count += length;
@@ -208,18 +244,68 @@ sd::LongType offsetUtf32StringInUtf8(const void* start, const void* end) {
 }
 
 bool isStringValidU8(const void* start, const void* stop) {
-  for (auto it = static_cast<const int8_t*>(start); it != stop; it++) {
-    if (!isSymbolU8Valid(castToU8(*it))) {
+  auto end = static_cast<const uint8_t*>(stop);
+  for (auto it = static_cast<const uint8_t*>(start); it < end;) {
+    if (isAsciiWordU8(it, end)) {
+      it += 8;
+      continue;
+    }
+
+    uint8_t lead = *it;
+    if (lead < ONEBYTEBOUND) {
+      it++;
+      continue;
+    }
+
+    int length = 0;
+    uint32_t cp = 0, minimal = 0;
+    if ((lead >> 5) == 0x6) {
+      length = 2;
+      cp = lead & 0x1f;
+      minimal = ONEBYTEBOUND;
+    } else if ((lead >> 4) == 0xe) {
+      length = 3;
+      cp = lead & 0x0f;
+      minimal = TWOBYTEBOUND;
+    } else if ((lead >> 3) == 0x1e) {
+      length = 4;
+      cp = lead & 0x07;
+      minimal = THREEBYTEBOUND;
+    } else {
+      // stray continuation byte or invalid lead
       return false;
     }
+
+    if (end - it < length) return false;
+
+    for (int e = 1; e < length; e++) {
+      if (!isTrail(it[e])) return false;
+      cp = (cp << 6) | (it[e] & 0x3f);
+    }
+
+    // overlong forms, surrogates and values above U+10FFFF aren't valid utf8
+    if (cp < minimal || !isSymbolU8Valid(cp)) return false;
+
+    it += length;
   }
   return true;
 }
 
 bool isStringValidU16(const void* start, const void* stop) {
-  for (auto it = static_cast<const uint16_t*>(start); it != stop; it++) {
-    if (!isSymbolValid(castToU32(*it))) {
-      return false;
+  auto end = static_cast<const uint16_t*>(stop);
+  for (auto it = static_cast<const uint16_t*>(start); it < end; it++) {
+    if (isAsciiWordU16(it, end)) {
+      it += 3;
+      continue;
+    }
+
+    uint32_t cp = castToU16(*it);
+    if (isTrailSurrogate(cp)) return false;
+
+    // high surrogate has to be followed by low one
+    if (isLeadSurrogate(cp)) {
+      if (it + 1 == end || !isTrailSurrogate(castToU16(it[1]))) return false;
+      it++;
     }
   }
   return true;
@@ -238,6 +324,11 @@ void* utf16to8Ptr(const void* start, const void* end, void* res) {
   auto result = static_cast<int8_t*>(res);
   // result have to be  pre-allocated
   for (auto it = static_cast<const uint16_t*>(start); it != end;) {
+    if (isAsciiWordU16(it, end)) {
+      for (int e = 0; e < 4; e++) *(result++) = static_cast<int8_t>(it[e]);
+      it += 4;
+      continue;
+    }
     uint32_t cp = castToU16(*it++);
     if (!isLeadSurrogate(cp)) {
       if (cp < 0x80) {  // for one byte
@@ -269,6 +360,11 @@ void* utf8to16Ptr(const void* start, const void* end, void* res) {
   auto result = static_cast<uint16_t*>(res);
   // result have to be  pre-allocated
   for (auto it = static_cast<const int8_t*>(start); it != end;) {
+    if (isAsciiWordU8(it, end)) {
+      for (int e = 0; e < 8; e++) *(result++) = static_cast<uint16_t>(it[e]);
+      it += 8;
+      continue;
+    }
     auto nLength = symbolLength(it);
     uint32_t cp = castToU8(*it++);
     if (4 != nLength) {
@@ -318,6 +414,11 @@ void* utf8to32Ptr(const void* start, const void* end, void* res) {
   auto result = static_cast<uint32_t*>(res);
   // result have to be  pre-allocated
   for (auto it = static_cast<const int8_t*>(start); it != end;) {
+    if (isAsciiWordU8(it, end)) {
+      for (int e = 0; e < 8; e++) *(result++) = static_cast<uint32_t>(it[e]);
+      it += 8;
+      continue;
+    }
     auto nLength = symbolLength(it);
     uint32_t cp = castToU8(*it++);
     if (2 == nLength) {
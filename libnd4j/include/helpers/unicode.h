@@ -62,12 +62,13 @@ sd::LongType offsetUtf32StringInUtf16(const void* start, const void* end);
 sd::LongType offsetUtf32StringInUtf8(const void* start, const void* end);
 
 /*
- * This function check is valid charecter in u8 string
+ * This function check is valid charecter in u8 string: rejects malformed and truncated sequences,
+ * overlong forms, surrogates and values above U+10FFFF
  */
 bool isStringValidU8(const void* start, const void* stop);
 
 /*
- * This function check is valid charecter in u16 string
+ * This function check is valid charecter in u16 string: surrogates have to come in pairs
  */
 bool isStringValidU16(const void* start, const void* stop);
 
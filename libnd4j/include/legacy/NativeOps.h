@@ -101,6 +101,43 @@ SD_LIB_EXPORT void setElementThreshold(int num);
  */
 SD_LIB_EXPORT void setTADThreshold(int num);
 
+/**
+ * Measures op costs on this host and sizes thread teams from them instead of the static thresholds
+ *
+ * @param profilePath if not null, the measured profile is saved to this file
+ */
+SD_LIB_EXPORT void calibrateParallelism(const char *profilePath);
+
+/**
+ * Loads a profile saved by calibrateParallelism
+ *
+ * @param profilePath
+ * @return false if the file doesn't exist or isn't a valid profile
+ */
+SD_LIB_EXPORT bool loadParallelismProfile(const char *profilePath);
+
+/**
+ * Turns op, allocation and thread pool tracing on or off, can be called at any time
+ *
+ * @param enabled
+ */
+SD_LIB_EXPORT void setTracingEnabled(bool enabled);
+
+SD_LIB_EXPORT bool isTracingEnabled();
+
+/**
+ * Drops all trace events recorded so far
+ */
+SD_LIB_EXPORT void resetTrace();
+
+/**
+ * Writes the recorded trace events as Chrome trace JSON, readable by chrome://tracing and Perfetto
+ *
+ * @param tracePath
+ * @return false if the file can't be written
+ */
+SD_LIB_EXPORT bool exportTrace(const char *tracePath);
+
 /**
  *
  * @param opNum
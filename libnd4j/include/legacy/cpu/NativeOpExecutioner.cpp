@@ -43,6 +43,7 @@
 #include <loops/transform_float.h>
 #include <loops/transform_same.h>
 #include <loops/transform_strict.h>
+#include <system/ParallelCostModel.h>
 #include <types/types.h>
 
 #include <vector>
@@ -53,6 +54,12 @@
 
 #endif
 
+// thread team size for length elements of an op of the given cost class
+static int threadsFor(sd::CostClass costClass, sd::DataType dataType, sd::LongType length) {
+  return sd::ParallelCostModel::getInstance().numberOfThreads(costClass, dataType, length,
+                                                              sd::Environment::getInstance().maxMasterThreads());
+}
+
 ////////////////////////////////////////////////////////////////////////
 /**
  *
@@ -450,9 +457,7 @@ void NativeOpExecutioner::execPairwiseTransform(sd::LaunchContext *lc, int opNum
   };
 
   auto zLen = shape::length(hZShapeInfo);
-  samediff::Threads::parallel_for(
-      func, 0, zLen, 1,
-      sd::math::sd_max<int>(1, sd::math::sd_min<int>(zLen / 1024, sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_for(func, 0, zLen, 1, threadsFor(sd::CostClass::ELEMENTWISE, zType, zLen));
 
 #endif
 }
@@ -484,9 +489,7 @@ void NativeOpExecutioner::execPairwiseBoolTransform(sd::LaunchContext *lc, int o
   };
 
   auto zLen = shape::length(hZShapeInfo);
-  samediff::Threads::parallel_for(
-      func, 0, zLen, 1,
-      sd::math::sd_max<int>(1, sd::math::sd_min<int>(zLen / 1024, sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_for(func, 0, zLen, 1, threadsFor(sd::CostClass::ELEMENTWISE, zType, zLen));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -516,9 +519,7 @@ void NativeOpExecutioner::execPairwiseIntTransform(sd::LaunchContext *lc, int op
   };
 
   auto zLen = shape::length(hZShapeInfo);
-  samediff::Threads::parallel_for(
-      func, 0, zLen, 1,
-      sd::math::sd_max<int>(1, sd::math::sd_min<int>(zLen / 1024, sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_for(func, 0, zLen, 1, threadsFor(sd::CostClass::ELEMENTWISE, zType, zLen));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -848,11 +849,7 @@ void NativeOpExecutioner::execScalar(sd::LaunchContext *lc, int opNum, const voi
 
   auto zLen = shape::length(hZShapeInfo);
   samediff::Threads::parallel_for(
-      func, 0, zLen, 1,
-      !allowParallelism
-      ? 1
-      : sd::math::sd_max<int>(
-          1, sd::math::sd_min<int>(zLen / 1024, sd::Environment::getInstance().maxMasterThreads())));
+      func, 0, zLen, 1, !allowParallelism ? 1 : threadsFor(sd::CostClass::ELEMENTWISE, zType, zLen));
 
 
 #endif
@@ -923,11 +920,7 @@ void NativeOpExecutioner::execScalarBool(sd::LaunchContext *lc, int opNum, const
 
   auto zLen = shape::length(hZShapeInfo);
   samediff::Threads::parallel_for(
-      func, 0, zLen, 1,
-      !allowParallelism
-      ? 1
-      : sd::math::sd_max<int>(
-          1, sd::math::sd_min<int>(zLen / 1024, sd::Environment::getInstance().maxMasterThreads())));
+      func, 0, zLen, 1, !allowParallelism ? 1 : threadsFor(sd::CostClass::ELEMENTWISE, zType, zLen));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -989,11 +982,7 @@ void NativeOpExecutioner::execScalarInt(sd::LaunchContext *lc, int opNum, const
 
   auto zLen = shape::length(hZShapeInfo);
   samediff::Threads::parallel_for(
-      func, 0, zLen, 1,
-      !allowParallelism
-      ? 1
-      : sd::math::sd_max<int>(
-          1, sd::math::sd_min<int>(zLen / 1024, sd::Environment::getInstance().maxMasterThreads())));
+      func, 0, zLen, 1, !allowParallelism ? 1 : threadsFor(sd::CostClass::ELEMENTWISE, zType, zLen));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1128,9 +1117,7 @@ void NativeOpExecutioner::execTransformFloat(sd::LaunchContext *lc, int opNum, c
                           SD_COMMON_TYPES_ALL, SD_FLOAT_TYPES);
   };
 
-  samediff::Threads::parallel_do(
-      func, sd::math::sd_max<int>(1, sd::math::sd_min<int>(shape::length(hZShapeInfo) / 1024,
-                                                           sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_do(func, threadsFor(sd::CostClass::TRANSCENDENTAL, xType, shape::length(hZShapeInfo)));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1150,9 +1137,7 @@ void NativeOpExecutioner::execTransformBool(sd::LaunchContext *lc, int opNum, co
                           SD_COMMON_TYPES_ALL, SD_BOOL_TYPES);
   };
 
-  samediff::Threads::parallel_do(
-      func, sd::math::sd_max<int>(1, sd::math::sd_min<int>(shape::length(hZShapeInfo) / 1024,
-                                                           sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_do(func, threadsFor(sd::CostClass::ELEMENTWISE, zType, shape::length(hZShapeInfo)));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1180,9 +1165,7 @@ void NativeOpExecutioner::execTransformAny(sd::LaunchContext *lc, int opNum, con
                             SD_COMMON_TYPES_ALL, SD_COMMON_TYPES);
     };
 
-    samediff::Threads::parallel_do(
-        func, sd::math::sd_max<int>(1, sd::math::sd_min<int>(shape::length(hZShapeInfo) / 1024,
-                                                             sd::Environment::getInstance().maxMasterThreads())));
+    samediff::Threads::parallel_do(func, threadsFor(sd::CostClass::ELEMENTWISE, zType, shape::length(hZShapeInfo)));
   }
 }
 
@@ -1203,9 +1186,7 @@ void NativeOpExecutioner::execTransformSame(sd::LaunchContext *lc, int opNum, co
                           SD_COMMON_TYPES_ALL);
   };
 
-  samediff::Threads::parallel_do(
-      func, sd::math::sd_max<int>(1, sd::math::sd_min<int>(shape::length(hZShapeInfo) / 1024,
-                                                           sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_do(func, threadsFor(sd::CostClass::ELEMENTWISE, zType, shape::length(hZShapeInfo)));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -1226,9 +1207,7 @@ void NativeOpExecutioner::execTransformStrict(sd::LaunchContext *lc, int opNum,
                           SD_FLOAT_TYPES);
   };
 
-  samediff::Threads::parallel_do(
-      func, sd::math::sd_max<int>(1, sd::math::sd_min<int>(shape::length(hZShapeInfo) / 1024,
-                                                           sd::Environment::getInstance().maxMasterThreads())));
+  samediff::Threads::parallel_do(func, threadsFor(sd::CostClass::TRANSCENDENTAL, xType, shape::length(hZShapeInfo)));
 }
 
 ////////////////////////////////////////////////////////////////////////
@@ -70,7 +70,10 @@ bool experimentalSupport = false;
 #include <helpers/TAD.h>
 #include <ops/declarable/OpRegistrator.h>
 #include <ops/specials.h>
+#include <system/CpuDispatch.h>
 #include <system/Environment.h>
+#include <system/ParallelCostModel.h>
+#include <system/Tracer.h>
 
 #ifdef CPU_FEATURES
 #include <cpuinfo_x86.h>
@@ -90,6 +93,41 @@ void setTADThreshold(int num) {
   if (num > 0) sd::Environment::getInstance().setTadThreshold(num);
 }
 
+void calibrateParallelism(const char *profilePath) {
+  try {
+    auto &costModel = sd::ParallelCostModel::getInstance();
+    costModel.calibrate();
+    if (profilePath != nullptr) costModel.save(profilePath);
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+  }
+}
+
+bool loadParallelismProfile(const char *profilePath) {
+  if (profilePath == nullptr) return false;
+
+  return sd::ParallelCostModel::getInstance().load(profilePath);
+}
+
+void setTracingEnabled(bool enabled) { sd::Tracer::setEnabled(enabled); }
+
+bool isTracingEnabled() { return sd::Tracer::isEnabled(); }
+
+void resetTrace() { sd::Tracer::getInstance().reset(); }
+
+bool exportTrace(const char *tracePath) {
+  if (tracePath == nullptr) return false;
+
+  try {
+    return sd::Tracer::getInstance().exportChromeTrace(std::string(tracePath));
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return false;
+  }
+}
+
 #if defined(HAVE_VEDA)
 static bool execHelper(const char *entryPrefix, int opNum, void *extraParams, const sd::LongType *hZShapeInfo,
                        OpaqueDataBuffer *dbZ, const sd::LongType *hXShapeInfo, OpaqueDataBuffer *dbX,
@@ -2911,7 +2949,17 @@ void ctxShapeFunctionOverride(OpaqueContext *ptr, bool reallyOverride) {
 int binaryLevel() {
 #ifdef CPU_FEATURES
 
-#if defined(F_X64)
+#if defined(SD_CPU_DISPATCH)
+  // hot kernels run at the ISA picked at startup
+  switch (sd::CpuDispatch::getInstance().isa()) {
+    case sd::CpuIsa::AVX512:
+      return 3;
+    case sd::CpuIsa::AVX2:
+      return 2;
+    default:
+      return 1;
+  }
+#elif defined(F_X64)
   return 1;
 #elif defined(F_AVX2)
   return 2;
@@ -35,6 +35,7 @@
 #include <loops/transform_any.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/specials_cuda.h>
+#include <system/Tracer.h>
 #include <system/buffer.h>
 
 #include <curand.h>
@@ -1563,6 +1564,33 @@ void setTADThreshold(int num) {
   // this is no-op for CUDA
 }
 
+void calibrateParallelism(const char *profilePath) {
+  // this is no-op for CUDA
+}
+
+bool loadParallelismProfile(const char *profilePath) {
+  // this is no-op for CUDA
+  return false;
+}
+
+void setTracingEnabled(bool enabled) { sd::Tracer::setEnabled(enabled); }
+
+bool isTracingEnabled() { return sd::Tracer::isEnabled(); }
+
+void resetTrace() { sd::Tracer::getInstance().reset(); }
+
+bool exportTrace(const char *tracePath) {
+  if (tracePath == nullptr) return false;
+
+  try {
+    return sd::Tracer::getInstance().exportChromeTrace(std::string(tracePath));
+  } catch (std::exception &e) {
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorCode(1);
+    sd::LaunchContext::defaultContext()->errorReference()->setErrorMessage(e.what());
+    return false;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////
 void execSummaryStats(sd::Pointer *extraPointers, int opNum, OpaqueDataBuffer *dbX, sd::LongType const *hXShapeInfo,
                       sd::LongType const *dXShapeInfo, void *extraParams, OpaqueDataBuffer *dbZ,
@@ -0,0 +1,136 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Host ISA detection for runtime CPU dispatch
+//
+#include <system/CpuDispatch.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(CPU_FEATURES) && (defined(__x86_64__) || defined(_M_X64))
+#include <cpuinfo_x86.h>
+#endif
+
+#if defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SVE
+#define HWCAP_SVE (1 << 22)
+#endif
+#endif
+
+namespace sd {
+
+static CpuIsa detectIsa() {
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(CPU_FEATURES)
+  const auto features = cpu_features::GetX86Info().features;
+  const bool avx2 = features.avx && features.avx2 && features.fma3 && features.f16c;
+  const bool avx512 = avx2 && features.avx512f && features.avx512vl && features.avx512bw && features.avx512dq &&
+                      features.avx512cd;
+#elif defined(__GNUC__) || defined(__clang__)
+  __builtin_cpu_init();
+  const bool avx2 = __builtin_cpu_supports("avx") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  const bool avx512 = avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") &&
+                      __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") &&
+                      __builtin_cpu_supports("avx512cd");
+#else
+  const bool avx2 = false;
+  const bool avx512 = false;
+#endif
+  return avx512 ? CpuIsa::AVX512 : avx2 ? CpuIsa::AVX2 : CpuIsa::GENERIC;
+#elif defined(__aarch64__)
+#if defined(__linux__)
+  if (getauxval(AT_HWCAP) & HWCAP_SVE) return CpuIsa::SVE;
+#endif
+  return CpuIsa::NEON;
+#else
+  return CpuIsa::GENERIC;
+#endif
+}
+
+CpuDispatch::CpuDispatch() {
+  _detected = detectIsa();
+  _active = _detected;
+
+  /**
+   * This var allows to lower the ISA used by dispatched kernels: generic, avx2, avx512, neon or sve
+   */
+  const char *requested = std::getenv("SD_CPU_ISA");
+  if (requested != nullptr) {
+    for (auto isa : {CpuIsa::GENERIC, CpuIsa::AVX2, CpuIsa::AVX512, CpuIsa::NEON, CpuIsa::SVE})
+      if (std::strcmp(requested, isaName(isa)) == 0 && supports(isa)) _active = isa;
+  }
+}
+
+CpuDispatch &CpuDispatch::getInstance() {
+  static CpuDispatch instance;
+  return instance;
+}
+
+bool CpuDispatch::supports(CpuIsa isa) const {
+  switch (isa) {
+    case CpuIsa::GENERIC:
+      return true;
+    case CpuIsa::AVX2:
+      return _detected == CpuIsa::AVX2 || _detected == CpuIsa::AVX512;
+    case CpuIsa::AVX512:
+      return _detected == CpuIsa::AVX512;
+    case CpuIsa::NEON:
+      return _detected == CpuIsa::NEON || _detected == CpuIsa::SVE;
+    case CpuIsa::SVE:
+      return _detected == CpuIsa::SVE;
+    default:
+      return false;
+  }
+}
+
+void CpuDispatch::setIsa(CpuIsa isa) {
+  if (!supports(isa))
+    throw std::invalid_argument(std::string("CpuDispatch: ISA ") + isaName(isa) + " isn't supported by this host");
+  _active = isa;
+}
+
+bool CpuDispatch::isMultiVersioned() {
+#if defined(SD_DISPATCH_X86) || defined(SD_DISPATCH_SVE)
+  return true;
+#else
+  return false;
+#endif
+}
+
+const char *CpuDispatch::isaName(CpuIsa isa) {
+  switch (isa) {
+    case CpuIsa::AVX2:
+      return "avx2";
+    case CpuIsa::AVX512:
+      return "avx512";
+    case CpuIsa::NEON:
+      return "neon";
+    case CpuIsa::SVE:
+      return "sve";
+    default:
+      return "generic";
+  }
+}
+
+}  // namespace sd
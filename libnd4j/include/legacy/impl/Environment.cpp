@@ -168,6 +168,16 @@ sd::Environment::Environment() {
   if (blas_fallback != nullptr) {
     _blasFallback = true;
   }
+
+  const char *pairwise_reductions = std::getenv("SD_PAIRWISE_REDUCTIONS");
+  if (pairwise_reductions != nullptr) {
+    _pairwiseReductions = true;
+  }
+
+  const char *blocked_layout = std::getenv("SD_BLOCKED_LAYOUT");
+  if (blocked_layout != nullptr) {
+    _blockedLayout = true;
+  }
 #endif
 
 #ifdef __CUDABLAS__
@@ -275,6 +285,14 @@ bool Environment::precisionBoostAllowed() { return _precBoost.load(); }
 
 void Environment::allowPrecisionBoost(bool reallyAllow) { _precBoost.store(reallyAllow); }
 
+bool Environment::pairwiseReductions() { return _pairwiseReductions.load(); }
+
+void Environment::setPairwiseReductions(bool reallyPairwise) { _pairwiseReductions.store(reallyPairwise); }
+
+bool Environment::blockedLayout() { return _blockedLayout.load(); }
+
+void Environment::setBlockedLayout(bool reallyBlocked) { _blockedLayout.store(reallyBlocked); }
+
 bool Environment::isCPU() {
 #ifdef __CUDABLAS__
   return false;
@@ -0,0 +1,303 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Calibration and persistence of the thread sizing cost model
+//
+#include <array/DataTypeUtils.h>
+#include <execution/Threads.h>
+#include <helpers/logger.h>
+#include <math/templatemath.h>
+#include <system/ParallelCostModel.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace sd {
+
+static const char* kClassNames[ParallelCostModel::kNumClasses] = {"elementwise", "transcendental", "reduction"};
+static const char* kGroupNames[ParallelCostModel::kNumTypeGroups] = {"float", "double", "half", "integer"};
+
+// with the default thread cost, elementwise ops get one thread per 1024 elements as before
+static const double kDefaultThreadCost = 1024.0;
+static const double kDefaultCosts[ParallelCostModel::kNumClasses] = {1.0, 8.0, 1.0};
+
+// calibrated thread cost is this many times the wake-up latency of a full thread team
+static const double kThreadCostToLatency = 4.0;
+
+static int typeGroup(sd::DataType dataType) {
+  switch (dataType) {
+    case sd::DataType::FLOAT32:
+      return 0;
+    case sd::DataType::DOUBLE:
+      return 1;
+    case sd::DataType::HALF:
+    case sd::DataType::BFLOAT16:
+      return 2;
+    default:
+      return DataTypeUtils::isR(dataType) ? 0 : 3;
+  }
+}
+
+static bool isTruthy(const char* value) {
+  return value != nullptr && (std::strcmp(value, "true") == 0 || std::strcmp(value, "1") == 0);
+}
+
+ParallelCostModel::ParallelCostModel() {
+  reset();
+
+  /**
+   * Profile with the calibrated costs of this host, written by a previous calibration
+   */
+  const char* profile = std::getenv("SD_COST_PROFILE");
+  if (profile != nullptr && load(profile)) return;
+
+  /**
+   * This var enables calibration at startup, the result is saved to SD_COST_PROFILE if it's set
+   */
+  if (isTruthy(std::getenv("SD_CALIBRATE"))) {
+    calibrate();
+    if (profile != nullptr) {
+      try {
+        save(profile);
+      } catch (std::exception& e) {
+        sd_printf("ParallelCostModel: %s\n", e.what());
+      }
+    }
+  }
+}
+
+ParallelCostModel& ParallelCostModel::getInstance() {
+  static ParallelCostModel instance;
+  return instance;
+}
+
+double ParallelCostModel::costPerElement(CostClass costClass, sd::DataType dataType) const {
+  return _costs[static_cast<int>(costClass)][typeGroup(dataType)].load(std::memory_order_relaxed);
+}
+
+void ParallelCostModel::setCostPerElement(CostClass costClass, sd::DataType dataType, double nanos) {
+  if (nanos <= 0.0) throw std::invalid_argument("ParallelCostModel: cost per element must be positive");
+
+  _costs[static_cast<int>(costClass)][typeGroup(dataType)].store(nanos);
+}
+
+double ParallelCostModel::threadCost() const { return _threadCost.load(std::memory_order_relaxed); }
+
+void ParallelCostModel::setThreadCost(double nanos) {
+  if (nanos <= 0.0) throw std::invalid_argument("ParallelCostModel: thread cost must be positive");
+
+  _threadCost.store(nanos);
+}
+
+int ParallelCostModel::numberOfThreads(CostClass costClass, sd::DataType dataType, sd::LongType numElements,
+                                       int maxThreads) const {
+  if (maxThreads <= 1 || numElements <= 0) return 1;
+
+  const double work = costPerElement(costClass, dataType) * static_cast<double>(numElements);
+  const double threads = work / threadCost();
+
+  if (threads >= static_cast<double>(maxThreads)) return maxThreads;
+
+  return sd::math::sd_max<int>(1, static_cast<int>(threads));
+}
+
+bool ParallelCostModel::isCalibrated() const { return _calibrated.load(); }
+
+void ParallelCostModel::reset() {
+  for (int c = 0; c < kNumClasses; c++)
+    for (int g = 0; g < kNumTypeGroups; g++) _costs[c][g].store(kDefaultCosts[c]);
+
+  _threadCost.store(kDefaultThreadCost);
+  _calibrated.store(false);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// calibration kernels, each one is timed single-threaded over a buffer that stays in cache
+
+// float for every type but double, the way the 16-bit and integer math ops compute
+template <typename T>
+using CalibrationMath = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+template <typename T>
+static void elementwiseKernel(const T* x, const T* y, T* z, sd::LongType length) {
+  PRAGMA_OMP_SIMD
+  for (sd::LongType i = 0; i < length; i++) z[i] = static_cast<T>(x[i] + y[i]);
+}
+
+template <typename T>
+static void transcendentalKernel(const T* x, const T* y, T* z, sd::LongType length) {
+  using M = CalibrationMath<T>;
+  for (sd::LongType i = 0; i < length; i++)
+    z[i] = static_cast<T>(sd::math::sd_exp<M, M>(static_cast<M>(x[i])) / (static_cast<M>(1) + static_cast<M>(y[i])));
+}
+
+template <typename T>
+static void reductionKernel(const T* x, const T* y, T* z, sd::LongType length) {
+  using M = CalibrationMath<T>;
+  M sum = static_cast<M>(0);
+  for (sd::LongType i = 0; i < length; i++) sum += static_cast<M>(x[i]);
+
+  z[0] = static_cast<T>(sum);
+}
+
+// best of several runs, in ns per element
+template <typename T>
+static double measureKernel(void (*kernel)(const T*, const T*, T*, sd::LongType)) {
+  const sd::LongType length = 16384;
+  std::vector<T> x(length), y(length), z(length);
+  for (sd::LongType i = 0; i < length; i++) {
+    x[i] = static_cast<T>((i % 7) + 1);
+    y[i] = static_cast<T>((i % 5) + 1);
+  }
+
+  double best = -1.0;
+  for (int run = 0; run < 5; run++) {
+    int repeats = 0;
+    const auto timeStart = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::duration elapsed;
+    do {
+      kernel(x.data(), y.data(), z.data(), length);
+      repeats++;
+      elapsed = std::chrono::steady_clock::now() - timeStart;
+    } while (elapsed < std::chrono::microseconds(500));
+
+    const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    const double perElement = static_cast<double>(nanos) / (static_cast<double>(repeats) * length);
+    if (best < 0.0 || perElement < best) best = perElement;
+  }
+
+  // keeps the results alive
+  volatile auto sink = static_cast<double>(z[0]);
+  (void)sink;
+
+  return sd::math::sd_max<double>(best, 1e-3);
+}
+
+template <typename T>
+static void calibrateGroup(ParallelCostModel& model, sd::DataType dataType) {
+  model.setCostPerElement(CostClass::ELEMENTWISE, dataType, measureKernel<T>(elementwiseKernel<T>));
+  model.setCostPerElement(CostClass::TRANSCENDENTAL, dataType, measureKernel<T>(transcendentalKernel<T>));
+  model.setCostPerElement(CostClass::REDUCTION, dataType, measureKernel<T>(reductionKernel<T>));
+}
+
+// median latency of waking up a full thread team for an empty task, -1 if there's a single thread
+static double measureThreadLatency() {
+  const int maxThreads = sd::Environment::getInstance().maxMasterThreads();
+  if (maxThreads <= 1) return -1.0;
+
+  std::atomic<int> counter{0};
+  auto func = PRAGMA_THREADS_DO { counter.fetch_add(1, std::memory_order_relaxed); };
+
+  std::vector<double> latencies;
+  for (int run = 0; run < 64; run++) {
+    const auto timeStart = std::chrono::steady_clock::now();
+    samediff::Threads::parallel_do(func, maxThreads);
+    const auto timeEnd = std::chrono::steady_clock::now();
+    latencies.push_back(
+        static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEnd - timeStart).count()));
+  }
+
+  std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+  return latencies[latencies.size() / 2];
+}
+
+void ParallelCostModel::calibrate() {
+  calibrateGroup<float>(*this, sd::DataType::FLOAT32);
+  calibrateGroup<double>(*this, sd::DataType::DOUBLE);
+  calibrateGroup<float16>(*this, sd::DataType::HALF);
+  calibrateGroup<int>(*this, sd::DataType::INT32);
+
+  // with a single thread there's nothing to size, and the default is kept
+  const auto latency = measureThreadLatency();
+  if (latency > 0.0) setThreadCost(sd::math::sd_max<double>(1.0, kThreadCostToLatency * latency));
+
+  _calibrated.store(true);
+
+  sd_debug("ParallelCostModel: thread cost %f ns, elementwise float %f ns/element\n", threadCost(),
+           costPerElement(CostClass::ELEMENTWISE, sd::DataType::FLOAT32));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// profile format: one "thread_cost <ns>" line and one "cost <class> <group> <ns>" line per entry
+
+void ParallelCostModel::save(const std::string& path) const {
+  std::ofstream out(path);
+  if (!out.good()) throw std::runtime_error("ParallelCostModel: can't write profile to " + path);
+
+  out << "# libnd4j parallel cost profile\n";
+  out << "thread_cost " << threadCost() << "\n";
+  for (int c = 0; c < kNumClasses; c++)
+    for (int g = 0; g < kNumTypeGroups; g++)
+      out << "cost " << kClassNames[c] << " " << kGroupNames[g] << " " << _costs[c][g].load() << "\n";
+
+  if (!out.good()) throw std::runtime_error("ParallelCostModel: can't write profile to " + path);
+}
+
+bool ParallelCostModel::load(const std::string& path) {
+  std::ifstream in(path);
+  if (!in.good()) return false;
+
+  double costs[kNumClasses][kNumTypeGroups];
+  bool seen[kNumClasses][kNumTypeGroups] = {};
+  double threadCost = -1.0;
+
+  std::string key;
+  while (in >> key) {
+    if (key[0] == '#') {
+      std::getline(in, key);
+    } else if (key == "thread_cost") {
+      if (!(in >> threadCost)) return false;
+    } else if (key == "cost") {
+      std::string className, groupName;
+      double value;
+      if (!(in >> className >> groupName >> value) || value <= 0.0) return false;
+
+      auto c = std::find(kClassNames, kClassNames + kNumClasses, className) - kClassNames;
+      auto g = std::find(kGroupNames, kGroupNames + kNumTypeGroups, groupName) - kGroupNames;
+      if (c == kNumClasses || g == kNumTypeGroups) return false;
+
+      costs[c][g] = value;
+      seen[c][g] = true;
+    } else {
+      return false;
+    }
+  }
+
+  if (threadCost <= 0.0) return false;
+
+  for (int c = 0; c < kNumClasses; c++)
+    for (int g = 0; g < kNumTypeGroups; g++)
+      if (!seen[c][g]) return false;
+
+  // nothing is applied unless the whole profile is valid
+  for (int c = 0; c < kNumClasses; c++)
+    for (int g = 0; g < kNumTypeGroups; g++) _costs[c][g].store(costs[c][g]);
+
+  _threadCost.store(threadCost);
+  _calibrated.store(true);
+  return true;
+}
+
+}  // namespace sd
@@ -0,0 +1,248 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Per-thread trace buffers and Chrome trace export
+//
+#include <system/Tracer.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace sd {
+
+static const uint64_t kDefaultBufferSize = 16384;
+
+// buffers of exited threads kept for export, so that thread churn doesn't grow memory
+static const int kMaxRetiredBuffers = 16;
+
+static const char *kCategories[] = {"op", "shape", "alloc", "free", "spill", "wait"};
+
+static bool enabledByDefault() {
+  /**
+   * Enables tracing from the start of the process
+   */
+  const char *trace = std::getenv("SD_TRACE");
+  return trace != nullptr && (std::strcmp(trace, "true") == 0 || std::strcmp(trace, "1") == 0);
+}
+
+std::atomic<bool> Tracer::_enabled{enabledByDefault()};
+
+TraceBuffer::TraceBuffer(int threadId, uint64_t capacity) : _threadId(threadId) {
+  uint64_t size = 1;
+  while (size < capacity) size <<= 1;
+
+  _events.resize(size);
+  _mask = size - 1;
+}
+
+void TraceBuffer::collect(std::vector<TraceEvent> &events) const {
+  const uint64_t capacity = _events.size();
+  const auto head = _head.load(std::memory_order_acquire);
+  const auto first = head > capacity ? head - capacity : 0;
+
+  std::vector<TraceEvent> copy;
+  copy.reserve(head - first);
+  for (auto e = first; e < head; e++) copy.emplace_back(_events[e & _mask]);
+
+  // the owner keeps writing while we copy, entries it wrapped around to in the meantime are torn. that
+  // includes the slot of entry "after", which may be half-written before "after + 1" is published
+  const auto after = _head.load(std::memory_order_acquire);
+  const auto valid = after >= capacity ? after - capacity + 1 : 0;
+  for (auto e = std::max(first, valid); e < head; e++) events.emplace_back(copy[e - first]);
+}
+
+Tracer::Tracer() {
+  _origin = std::chrono::steady_clock::now();
+  _bufferSize = kDefaultBufferSize;
+
+  /**
+   * Number of events kept per thread
+   */
+  const char *bufferSize = std::getenv("SD_TRACE_BUFFER");
+  if (bufferSize != nullptr) {
+    auto size = std::atoll(bufferSize);
+    if (size > 0) _bufferSize = static_cast<uint64_t>(size);
+  }
+}
+
+Tracer &Tracer::getInstance() {
+  static Tracer instance;
+  return instance;
+}
+
+void Tracer::setEnabled(bool enabled) {
+  // creates the instance before the first event, so that timestamps start from here
+  getInstance();
+  _enabled.store(enabled);
+}
+
+// hands the buffer back to the tracer when its thread exits
+struct ThreadTraceBuffer {
+  TraceBuffer *buffer = nullptr;
+
+  ~ThreadTraceBuffer() {
+    if (buffer != nullptr) Tracer::getInstance().retire(buffer);
+  }
+};
+
+TraceBuffer *Tracer::threadBuffer() {
+  // buffers are owned by the tracer, so events of finished threads can still be exported
+  static thread_local ThreadTraceBuffer holder;
+  if (holder.buffer == nullptr) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _buffers.emplace_back(new TraceBuffer(_nextThreadId++, _bufferSize.load()));
+    holder.buffer = _buffers.back().get();
+  }
+
+  return holder.buffer;
+}
+
+void Tracer::retire(TraceBuffer *buffer) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  buffer->retire();
+
+  // buffers are appended as threads start tracing, so the first retired ones are the oldest
+  int retired = 0;
+  for (const auto &b : _buffers)
+    if (b->isRetired()) retired++;
+
+  for (auto it = _buffers.begin(); it != _buffers.end() && retired > kMaxRetiredBuffers;) {
+    if ((*it)->isRetired()) {
+      it = _buffers.erase(it);
+      retired--;
+    } else
+      ++it;
+  }
+}
+
+int Tracer::numBuffers() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return static_cast<int>(_buffers.size());
+}
+
+void Tracer::record(TraceEventType type, const char *name, uint64_t timestamp, uint64_t duration,
+                    sd::LongType value) {
+  threadBuffer()->push(TraceEvent{timestamp, duration, name, value, type});
+}
+
+void Tracer::setBufferSize(uint64_t numEvents) { _bufferSize = std::max<uint64_t>(numEvents, 1); }
+
+uint64_t Tracer::bufferSize() const { return _bufferSize.load(); }
+
+void Tracer::reset() {
+  _resetTime = now();
+
+  // events of exited threads are all older than the reset now
+  std::lock_guard<std::mutex> lock(_mutex);
+  _buffers.erase(std::remove_if(_buffers.begin(), _buffers.end(),
+                                [](const std::unique_ptr<TraceBuffer> &b) { return b->isRetired(); }),
+                 _buffers.end());
+}
+
+std::vector<TraceEvent> Tracer::events() {
+  std::vector<TraceEvent> result;
+  const auto resetTime = _resetTime.load();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (const auto &buffer : _buffers) {
+    std::vector<TraceEvent> events;
+    buffer->collect(events);
+    for (const auto &e : events)
+      if (e.timestamp >= resetTime) result.emplace_back(e);
+  }
+
+  std::stable_sort(result.begin(), result.end(),
+                   [](const TraceEvent &a, const TraceEvent &b) { return a.timestamp < b.timestamp; });
+  return result;
+}
+
+static void appendEscaped(std::ostringstream &out, const char *value) {
+  for (auto c = value; c != nullptr && *c != '\0'; c++) {
+    switch (*c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20)
+          out << ' ';
+        else
+          out << *c;
+    }
+  }
+}
+
+std::string Tracer::exportChromeTrace() {
+  const auto resetTime = _resetTime.load();
+
+  std::ostringstream out;
+  out.setf(std::ios::fixed);
+  out.precision(3);
+  out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+
+  bool first = true;
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (const auto &buffer : _buffers) {
+    std::vector<TraceEvent> events;
+    buffer->collect(events);
+
+    out << (first ? "\n" : ",\n") << "{\"ph\": \"M\", \"name\": \"thread_name\", \"pid\": 1, \"tid\": "
+        << buffer->threadId() << ", \"args\": {\"name\": \"thread " << buffer->threadId() << "\"}}";
+    first = false;
+
+    for (const auto &e : events) {
+      if (e.timestamp < resetTime) continue;
+
+      // timestamps are in microseconds
+      out << ",\n{\"name\": \"";
+      appendEscaped(out, e.name);
+      out << "\", \"cat\": \"" << kCategories[static_cast<int>(e.type)] << "\", \"pid\": 1, \"tid\": "
+          << buffer->threadId() << ", \"ts\": " << (e.timestamp - resetTime) / 1000.0;
+
+      switch (e.type) {
+        case TraceEventType::OP:
+        case TraceEventType::SHAPE_FUNCTION:
+        case TraceEventType::POOL_WAIT:
+          out << ", \"ph\": \"X\", \"dur\": " << e.duration / 1000.0 << "}";
+          break;
+        default:
+          out << ", \"ph\": \"i\", \"s\": \"t\", \"args\": {\"bytes\": " << e.value << "}}";
+      }
+    }
+  }
+
+  out << "\n]}\n";
+  return out.str();
+}
+
+bool Tracer::exportChromeTrace(const std::string &path) {
+  std::ofstream file(path, std::ios::out | std::ios::trunc);
+  if (!file.is_open()) return false;
+
+  file << exportChromeTrace();
+  return file.good();
+}
+
+}  // namespace sd
@@ -20,6 +20,7 @@
 //  @author raver119@gmail.com
 //
 #include <execution/Threads.h>
+#include <helpers/BroadcastLoops.h>
 #include <helpers/ConstantTadHelper.h>
 #include <helpers/LoopKind.h>
 #include <loops/broadcasting_bool.h>
@@ -378,230 +379,11 @@ void BroadcastBool<X, Z>::execInverse(const void *vx, const sd::LongType *xShape
 
 ////////////////////////////////////////////////////////////////////////
 template <typename X, typename Z, typename OpType>
-static void execRank1(const X *x, const sd::LongType *xShapeInfo, const X *y, const sd::LongType *yShapeInfo, Z *z,
-                      const sd::LongType *zShapeInfo, X *extraParams) {
-  sd::Unsigned zAxis0 = shape::sizeAt(zShapeInfo, 0);
-  sd::LongType xStrd0 = shape::strideAt(xShapeInfo, 0);
-  sd::LongType yStrd0 = shape::strideAt(yShapeInfo, 0);
-  sd::LongType zStrd0 = shape::strideAt(zShapeInfo, 0);
-
-  auto func = PRAGMA_THREADS_FOR {
-    if (zStrd0 == 1 && xStrd0 == 1 && yStrd0 == 0) {
-      for (auto i0 = start; i0 < stop; ++i0) z[i0] = OpType::op(x[i0], *y, extraParams);
-    } else if (zStrd0 == 1 && xStrd0 == 0 && yStrd0 == 1) {
-      for (auto i0 = start; i0 < stop; ++i0) z[i0] = OpType::op(*x, y[i0], extraParams);
-    } else if (zStrd0 == 1 && xStrd0 == 1 && yStrd0 == 1) {
-      for (auto i0 = start; i0 < stop; ++i0) z[i0] = OpType::op(x[i0], y[i0], extraParams);
-    } else {
-      for (auto i0 = start; i0 < stop; ++i0) z[i0 * zStrd0] = OpType::op(x[i0 * xStrd0], y[i0 * yStrd0], extraParams);
-    }
-  };
-  samediff::Threads::parallel_tad(func, 0, zAxis0);
-}
-
-////////////////////////////////////////////////////////////////////////
-template <typename X, typename Z, typename OpType>
-static void execRank2(const X *x, const sd::LongType *xShapeInfo, const X *y, const sd::LongType *yShapeInfo, Z *z,
-                      const sd::LongType *zShapeInfo, X *extraParams) {
-  sd::Unsigned zAxis0 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 1);
-  sd::LongType xStrd0 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 1);
-  sd::LongType yStrd0 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 1);
-  sd::LongType zStrd0 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 1);
-
-  sd::Unsigned zAxis1 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 0);
-  sd::LongType xStrd1 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 0);
-  sd::LongType yStrd1 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 0);
-  sd::LongType zStrd1 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 0);
-
-  auto func = PRAGMA_THREADS_FOR {
-    for (auto i0 = start; i0 < stop; ++i0) {
-      auto x0 = x + i0 * xStrd0;
-      auto y0 = y + i0 * yStrd0;
-      auto z0 = z + i0 * zStrd0;
-
-      if (zStrd1 == 1 && xStrd1 == 1 && yStrd1 == 0)
-        for (sd::Unsigned i1 = 0; i1 < zAxis1; ++i1) z0[i1] = OpType::op(x0[i1], *y0, extraParams);
-      else if (zStrd1 == 1 && xStrd1 == 0 && yStrd1 == 1)
-        for (sd::Unsigned i1 = 0; i1 < zAxis1; ++i1) z0[i1] = OpType::op(*x0, y0[i1], extraParams);
-      else if (zStrd1 == 1 && xStrd1 == 1 && yStrd1 == 1)
-        for (sd::Unsigned i1 = 0; i1 < zAxis1; ++i1) z0[i1] = OpType::op(x0[i1], y0[i1], extraParams);
-      else
-        for (sd::Unsigned i1 = 0; i1 < zAxis1; ++i1)
-          z0[i1 * zStrd1] = OpType::op(x0[i1 * xStrd1], y0[i1 * yStrd1], extraParams);
-    }
-  };
-
-  samediff::Threads::parallel_tad(func, 0, zAxis0);
-}
-
-////////////////////////////////////////////////////////////////////////
-template <typename X, typename Z, typename OpType>
-static void execRank3(const X *x, const sd::LongType *xShapeInfo, const X *y, const sd::LongType *yShapeInfo, Z *z,
-                      const sd::LongType *zShapeInfo, X *extraParams) {
-  sd::Unsigned zAxis0 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 2);
-  sd::LongType xStrd0 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 2);
-  sd::LongType yStrd0 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 2);
-  sd::LongType zStrd0 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 2);
-
-  sd::Unsigned zAxis1 = shape::sizeAt(zShapeInfo, 1);
-  sd::LongType xStrd1 = shape::strideAt(xShapeInfo, 1);
-  sd::LongType yStrd1 = shape::strideAt(yShapeInfo, 1);
-  sd::LongType zStrd1 = shape::strideAt(zShapeInfo, 1);
-
-  sd::Unsigned zAxis2 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 0);
-  sd::LongType xStrd2 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 0);
-  sd::LongType yStrd2 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 0);
-  sd::LongType zStrd2 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 0);
-
-  auto func = PRAGMA_THREADS_FOR_2D {
-    for (auto i0 = start_x; i0 < stop_x; ++i0) {
-      for (auto i1 = start_y; i1 < stop_y; ++i1) {
-        auto x1 = x + i0 * xStrd0 + i1 * xStrd1;
-        auto y1 = y + i0 * yStrd0 + i1 * yStrd1;
-        auto z1 = z + i0 * zStrd0 + i1 * zStrd1;
-
-        if (zStrd2 == 1 && xStrd2 == 1 && yStrd2 == 0)
-          for (sd::Unsigned i2 = 0; i2 < zAxis2; ++i2) z1[i2] = OpType::op(x1[i2], *y1, extraParams);
-        else if (zStrd2 == 1 && xStrd2 == 0 && yStrd2 == 1)
-          for (sd::Unsigned i2 = 0; i2 < zAxis2; ++i2) z1[i2] = OpType::op(*x1, y1[i2], extraParams);
-        else if (zStrd2 == 1 && xStrd2 == 1 && yStrd2 == 1)
-          for (sd::Unsigned i2 = 0; i2 < zAxis2; ++i2) z1[i2] = OpType::op(x1[i2], y1[i2], extraParams);
-        else
-          for (sd::Unsigned i2 = 0; i2 < zAxis2; ++i2)
-            z1[i2 * zStrd2] = OpType::op(x1[i2 * xStrd2], y1[i2 * yStrd2], extraParams);
-      }
-    }
-  };
-
-  samediff::Threads::parallel_for(func, 0, zAxis0, 1, 0, zAxis1, 1);
-}
-
-////////////////////////////////////////////////////////////////////////
-template <typename X, typename Z, typename OpType>
-static void execRank4(const X *x, const sd::LongType *xShapeInfo, const X *y, const sd::LongType *yShapeInfo, Z *z,
-                      const sd::LongType *zShapeInfo, X *extraParams) {
-  sd::Unsigned zAxis0 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 3);
-  sd::LongType xStrd0 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 3);
-  sd::LongType yStrd0 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 3);
-  sd::LongType zStrd0 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 3);
-
-  sd::Unsigned zAxis1 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 2);
-  sd::LongType xStrd1 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 2);
-  sd::LongType yStrd1 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 2);
-  sd::LongType zStrd1 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 2);
-
-  sd::Unsigned zAxis2 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 1);
-  sd::LongType xStrd2 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 1);
-  sd::LongType yStrd2 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 1);
-  sd::LongType zStrd2 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 2 : 1);
-
-  sd::Unsigned zAxis3 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 0);
-  sd::LongType xStrd3 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 0);
-  sd::LongType yStrd3 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 0);
-  sd::LongType zStrd3 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 0);
-
-  auto func = PRAGMA_THREADS_FOR_3D {
-    for (auto i0 = start_x; i0 < stop_x; ++i0) {
-      for (auto i1 = start_y; i1 < stop_y; ++i1) {
-        for (auto i2 = start_z; i2 < stop_z; ++i2) {
-          auto x2 = x + i0 * xStrd0 + i1 * xStrd1 + i2 * xStrd2;
-          auto y2 = y + i0 * yStrd0 + i1 * yStrd1 + i2 * yStrd2;
-          auto z2 = z + i0 * zStrd0 + i1 * zStrd1 + i2 * zStrd2;
-
-          if (zStrd3 == 1 && xStrd3 == 1 && yStrd3 == 0)
-            for (sd::Unsigned i3 = 0; i3 < zAxis3; ++i3) z2[i3] = OpType::op(x2[i3], *y2, extraParams);
-          else if (zStrd3 == 1 && xStrd3 == 0 && yStrd3 == 1)
-            for (sd::Unsigned i3 = 0; i3 < zAxis3; ++i3) z2[i3] = OpType::op(*x2, y2[i3], extraParams);
-          else if (zStrd3 == 1 && xStrd3 == 1 && yStrd3 == 1)
-            for (sd::Unsigned i3 = 0; i3 < zAxis3; ++i3) z2[i3] = OpType::op(x2[i3], y2[i3], extraParams);
-          else
-            for (sd::Unsigned i3 = 0; i3 < zAxis3; ++i3)
-              z2[i3 * zStrd3] = OpType::op(x2[i3 * xStrd3], y2[i3 * yStrd3], extraParams);
-        }
-      }
-    }
-  };
-
-  samediff::Threads::parallel_for(func, 0, zAxis0, 1, 0, zAxis1, 1, 0, zAxis2, 1);
-}
-
-////////////////////////////////////////////////////////////////////////
-template <typename X, typename Z, typename OpType>
-static void execRank5(const X *x, const sd::LongType *xShapeInfo, const X *y, const sd::LongType *yShapeInfo, Z *z,
-                      const sd::LongType *zShapeInfo, X *extraParams) {
-  sd::Unsigned zAxis0 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 4);
-  sd::LongType xStrd0 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 4);
-  sd::LongType yStrd0 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 4);
-  sd::LongType zStrd0 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 0 : 4);
-
-  sd::Unsigned zAxis1 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 3);
-  sd::LongType xStrd1 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 3);
-  sd::LongType yStrd1 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 3);
-  sd::LongType zStrd1 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 1 : 3);
-
-  sd::Unsigned zAxis2 = shape::sizeAt(zShapeInfo, 2);
-  sd::LongType xStrd2 = shape::strideAt(xShapeInfo, 2);
-  sd::LongType yStrd2 = shape::strideAt(yShapeInfo, 2);
-  sd::LongType zStrd2 = shape::strideAt(zShapeInfo, 2);
-
-  sd::Unsigned zAxis3 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 1);
-  sd::LongType xStrd3 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 1);
-  sd::LongType yStrd3 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 1);
-  sd::LongType zStrd3 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 3 : 1);
-
-  sd::Unsigned zAxis4 = shape::sizeAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 4 : 0);
-  sd::LongType xStrd4 = shape::strideAt(xShapeInfo, shape::order(zShapeInfo) == 'c' ? 4 : 0);
-  sd::LongType yStrd4 = shape::strideAt(yShapeInfo, shape::order(zShapeInfo) == 'c' ? 4 : 0);
-  sd::LongType zStrd4 = shape::strideAt(zShapeInfo, shape::order(zShapeInfo) == 'c' ? 4 : 0);
-
-  auto func = PRAGMA_THREADS_FOR_3D {
-    for (auto i0 = start_x; i0 < stop_x; ++i0) {
-      for (auto i1 = start_y; i1 < stop_y; ++i1) {
-        for (auto i2 = start_z; i2 < stop_z; ++i2) {
-          for (sd::Unsigned i3 = 0; i3 < zAxis3; ++i3) {
-            auto x3 = x + i0 * xStrd0 + i1 * xStrd1 + i2 * xStrd2 + i3 * xStrd3;
-            auto y3 = y + i0 * yStrd0 + i1 * yStrd1 + i2 * yStrd2 + i3 * yStrd3;
-            auto z3 = z + i0 * zStrd0 + i1 * zStrd1 + i2 * zStrd2 + i3 * zStrd3;
-
-            if (zStrd4 == 1 && xStrd4 == 1 && yStrd4 == 0)
-              for (sd::Unsigned i4 = 0; i4 < zAxis4; ++i4) z3[i4] = OpType::op(x3[i4], *y3, extraParams);
-            else if (zStrd4 == 1 && xStrd4 == 0 && yStrd4 == 1)
-              for (sd::Unsigned i4 = 0; i4 < zAxis4; ++i4) z3[i4] = OpType::op(*x3, y3[i4], extraParams);
-            else if (zStrd4 == 1 && xStrd4 == 1 && yStrd4 == 1)
-              for (sd::Unsigned i4 = 0; i4 < zAxis4; ++i4) z3[i4] = OpType::op(x3[i4], y3[i4], extraParams);
-            else
-              for (sd::Unsigned i4 = 0; i4 < zAxis4; ++i4)
-                z3[i4 * zStrd4] = OpType::op(x3[i4 * xStrd4], y3[i4 * yStrd4], extraParams);
-          }
-        }
-      }
-    }
-  };
-
-  samediff::Threads::parallel_for(func, 0, zAxis0, 1, 0, zAxis1, 1, 0, zAxis2, 1);
-}
+struct BroadcastBoolPairOp {
+  X *extraParams;
+  SD_INLINE Z operator()(const X a, const X b) const { return OpType::op(a, b, extraParams); }
+};
 
-////////////////////////////////////////////////////////////////////////
-template <typename X, typename Z, typename OpType>
-static void execDefault(const X *x, const sd::LongType *xShapeInfo, const X *y, const sd::LongType *yShapeInfo, Z *z,
-                        const sd::LongType *zShapeInfo, X *extraParams) {
-  const bool xzSameOffsets = shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo);
-  const bool yzSameOffsets = shape::haveSameShapeAndStrides(yShapeInfo, zShapeInfo);
-
-  auto func = PRAGMA_THREADS_FOR {
-    int coords[SD_MAX_RANK];
-    sd::LongType xOffset, yOffset, zOffset;
-
-    for (auto i = start; i < stop; ++i) {
-      shape::getOffsetBroadcast(start, i, zShapeInfo, xShapeInfo, yShapeInfo, xzSameOffsets, yzSameOffsets, coords,
-                                zOffset, xOffset, yOffset);
-
-      z[zOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
-    }
-  };
-
-  samediff::Threads::parallel_for(func, 0, shape::length(zShapeInfo));
-}
 ////////////////////////////////////////////////////////////////////////
 template <typename X, typename Z>
 template <typename OpType>
@@ -614,27 +396,7 @@ void BroadcastBool<X, Z>::exec(const void *vx, const sd::LongType *xShapeInfo, c
 
   X *extraParams = reinterpret_cast<X *>(vextraParams);
 
-  const int rank = shape::rank(zShapeInfo);  // xRank = yRank = zRank
-
-  switch (rank) {
-    case 1:
-      execRank1<X, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams);
-      break;
-    case 2:
-      execRank2<X, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams);
-      break;
-    case 3:
-      execRank3<X, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams);
-      break;
-    case 4:
-      execRank4<X, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams);
-      break;
-    case 5:
-      execRank5<X, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams);
-      break;
-    default:
-      execDefault<X, Z, OpType>(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, extraParams);
-  }
+  sd::execBroadcastLoops(x, xShapeInfo, y, yShapeInfo, z, zShapeInfo, BroadcastBoolPairOp<X, Z, OpType>{extraParams});
 }
 
 // BUILD_DOUBLE_TEMPLATE(template class SD_LIB_HIDDEN BroadcastBool, , SD_COMMON_TYPES, SD_BOOL_TYPES);
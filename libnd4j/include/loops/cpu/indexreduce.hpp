@@ -62,8 +62,6 @@ sd::LongType IndexReduce<X, Y>::execScalar(const void *vx, const sd::LongType *x
   auto xEws = shape::elementWiseStride(xShapeInfo);
   sd::OmpLaunchHelper info(len);
 
-  sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-  bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
   int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
   IndexValue<X> intermediatery[64];
   for (int e = 0; e < maxThreads; e++) intermediatery[e].index = -1;
@@ -86,9 +84,11 @@ sd::LongType IndexReduce<X, Y>::execScalar(const void *vx, const sd::LongType *x
     auto func = PRAGMA_THREADS_FOR {
       intermediatery[thread_id] = OpType::startingIndexValue(x);
 
-      for (auto i = start; i < stop; i++) {
-        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        IndexValue<X> curr(x[offset], i);
+      sd::OffsetIterator<1> xIt(xShapeInfo);
+      xIt.seek(start);
+
+      for (auto i = start; i < stop; i++, xIt.next()) {
+        IndexValue<X> curr(x[xIt.offset(0)], i);
         intermediatery[thread_id] = OpType::update(intermediatery[thread_id], curr, extraParams);
       }
     };
@@ -21,6 +21,7 @@
 //
 #include <execution/Threads.h>
 #include <helpers/LoopKind.h>
+#include <helpers/OffsetIterator.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <loops/pairwise_int.h>
 #include <types/types.h>
@@ -80,23 +81,21 @@ void PairWiseIntTransform<X>::exec(const void *vx, const sd::LongType *xShapeInf
   auto zEws = shape::elementWiseStride(zShapeInfo);
 
   if (shape::isScalar(yShapeInfo)) {
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-
     if (shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+      sd::OffsetIterator<1> it(xShapeInfo);
+      it.seek(start);
+
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto offset = it.offset(0);
         z[offset] = OpType::op(x[offset], y[0], extraParams);
       };
     } else {
-      sd::Unsigned zShapeInfoCast[SD_MAX_RANK];
-      const bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
+      sd::OffsetIterator<2> it(xShapeInfo, zShapeInfo);
+      it.seek(start);
 
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto xOffset = it.offset(0);
+        const auto zOffset = it.offset(1);
         z[zOffset] = OpType::op(x[xOffset], y[0], extraParams);
       };
     }
@@ -114,63 +113,48 @@ void PairWiseIntTransform<X>::exec(const void *vx, const sd::LongType *xShapeInf
   } else {
     if (shape::haveSameShapeAndStrides(xShapeInfo, yShapeInfo) &&
         shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-      sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-      const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
+      sd::OffsetIterator<1> it(xShapeInfo);
+      it.seek(start);
 
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto offset = it.offset(0);
         z[offset] = OpType::op(x[offset], y[offset], extraParams);
       };
     } else if (shape::haveSameShapeAndStrides(xShapeInfo, yShapeInfo)) {
-      sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-      sd::Unsigned zShapeInfoCast[SD_MAX_RANK];
-      const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-      const bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
-
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+      sd::OffsetIterator<2> it(xShapeInfo, zShapeInfo);
+      it.seek(start);
+
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto offset = it.offset(0);
+        const auto zOffset = it.offset(1);
         z[zOffset] = OpType::op(x[offset], y[offset], extraParams);
       };
     } else if (shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-      sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-      sd::Unsigned yShapeInfoCast[SD_MAX_RANK];
-      const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-      const bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
-
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
+      sd::OffsetIterator<2> it(xShapeInfo, yShapeInfo);
+      it.seek(start);
+
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto offset = it.offset(0);
+        const auto yOffset = it.offset(1);
         z[offset] = OpType::op(x[offset], y[yOffset], extraParams);
       };
     } else if (shape::haveSameShapeAndStrides(yShapeInfo, zShapeInfo)) {
-      sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-      sd::Unsigned yShapeInfoCast[SD_MAX_RANK];
-      const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-      const bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
-
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto offset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
+      sd::OffsetIterator<2> it(xShapeInfo, yShapeInfo);
+      it.seek(start);
+
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto xOffset = it.offset(0);
+        const auto offset = it.offset(1);
         z[offset] = OpType::op(x[xOffset], y[offset], extraParams);
       };
     } else {
-      sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-      sd::Unsigned yShapeInfoCast[SD_MAX_RANK];
-      sd::Unsigned zShapeInfoCast[SD_MAX_RANK];
-      const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
-      const bool canCastY = sd::DataTypeUtils::castShapeInfo(yShapeInfo, yShapeInfoCast);
-      const bool canCastZ = sd::DataTypeUtils::castShapeInfo(zShapeInfo, zShapeInfoCast);
-
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto yOffset = shape::indexOffset(i, yShapeInfo, yShapeInfoCast, canCastY);
-        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+      sd::OffsetIterator<3> it(xShapeInfo, yShapeInfo, zShapeInfo);
+      it.seek(start);
+
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto xOffset = it.offset(0);
+        const auto yOffset = it.offset(1);
+        const auto zOffset = it.offset(2);
         z[zOffset] = OpType::op(x[xOffset], y[yOffset], extraParams);
       };
     }
@@ -60,13 +60,10 @@ void SD_HOST ReduceBoolFunction<X, Z>::execScalar(const void *vx, const sd::Long
     z[0] = execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
-    for (sd::LongType i = 0; i < length; i++)
-      startingValue = OpType::update(
-          startingValue, OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams),
-          extraParams);
+    sd::OffsetIterator<1> xIt(xShapeInfo);
+    for (sd::LongType i = 0; i < length; i++, xIt.next())
+      startingValue = OpType::update(startingValue, OpType::op(x[xIt.offset(0)], extraParams), extraParams);
 
     z[0] = OpType::postProcess(startingValue, length, extraParams);
   }
@@ -85,13 +82,10 @@ Z SD_HOST ReduceBoolFunction<X, Z>::execScalar(const void *vx, const sd::LongTyp
     return execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
-    for (sd::LongType i = 0; i < length; i++)
-      startingValue = OpType::update(
-          startingValue, OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams),
-          extraParams);
+    sd::OffsetIterator<1> xIt(xShapeInfo);
+    for (sd::LongType i = 0; i < length; i++, xIt.next())
+      startingValue = OpType::update(startingValue, OpType::op(x[xIt.offset(0)], extraParams), extraParams);
 
     return OpType::postProcess(startingValue, length, extraParams);
   }
@@ -68,8 +68,6 @@ void SD_HOST ReduceFloatFunction<X, Z>::execScalar(const void *vx, const sd::Lon
     z[0] = execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
     int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
     Y intermediate[64];
 
@@ -77,10 +75,12 @@ void SD_HOST ReduceFloatFunction<X, Z>::execScalar(const void *vx, const sd::Lon
     for (auto e = 0; e < maxThreads; e++) intermediate[e] = OpType::startingValue(x);
 
     auto func = PRAGMA_THREADS_FOR {
-      for (auto i = start; i < stop; i++)
-        intermediate[thread_id] = OpType::update(
-            intermediate[thread_id],
-            OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams), extraParams);
+      sd::OffsetIterator<1> xIt(xShapeInfo);
+      xIt.seek(start);
+
+      for (auto i = start; i < stop; i++, xIt.next())
+        intermediate[thread_id] =
+            OpType::update(intermediate[thread_id], OpType::op(x[xIt.offset(0)], extraParams), extraParams);
     };
 
     maxThreads = samediff::Threads::parallel_for(func, 0, length, 1, maxThreads);
@@ -107,13 +107,10 @@ Z SD_HOST ReduceFloatFunction<X, Z>::execScalar(const void *vx, const sd::LongTy
     return execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
-    for (sd::LongType i = 0; i < length; i++)
-      startingValue = OpType::update(
-          startingValue, OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams),
-          extraParams);
+    sd::OffsetIterator<1> xIt(xShapeInfo);
+    for (sd::LongType i = 0; i < length; i++, xIt.next())
+      startingValue = OpType::update(startingValue, OpType::op(x[xIt.offset(0)], extraParams), extraParams);
 
     return OpType::postProcess(startingValue, length, extraParams);
   }
@@ -146,6 +143,10 @@ Z SD_HOST ReduceFloatFunction<X, Z>::execScalar(const void *vx, sd::LongType xEw
                                                 void *vextraParams) {
   auto x = reinterpret_cast<const X *>(vx);
   auto extraParams = reinterpret_cast<Z *>(vextraParams);
+
+  Z result;
+  if (xEws == 1 && sd::HalfPrecision<X, X, Z, OpType>::reduce(x, length, extraParams, result)) return result;
+
   int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
   using Y = typename OpType::InterType;
   Y intermediate[64];
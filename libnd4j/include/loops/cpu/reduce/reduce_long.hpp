@@ -60,8 +60,6 @@ void SD_HOST ReduceLongFunction<X, Z>::execScalar(const void *vx, const sd::Long
     z[0] = execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
     int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
     Z intermediate[64];
 
@@ -69,10 +67,12 @@ void SD_HOST ReduceLongFunction<X, Z>::execScalar(const void *vx, const sd::Long
     for (auto e = 0; e < maxThreads; e++) intermediate[e] = OpType::startingValue(x);
 
     auto func = PRAGMA_THREADS_FOR {
-      for (auto i = start; i < stop; i++)
-        intermediate[thread_id] = OpType::update(
-            intermediate[thread_id],
-            OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams), extraParams);
+      sd::OffsetIterator<1> xIt(xShapeInfo);
+      xIt.seek(start);
+
+      for (auto i = start; i < stop; i++, xIt.next())
+        intermediate[thread_id] =
+            OpType::update(intermediate[thread_id], OpType::op(x[xIt.offset(0)], extraParams), extraParams);
     };
 
     maxThreads = samediff::Threads::parallel_for(func, 0, length, 1, maxThreads);
@@ -99,13 +99,10 @@ Z SD_HOST ReduceLongFunction<X, Z>::execScalar(const void *vx, const sd::LongTyp
     return execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
-    for (sd::LongType i = 0; i < length; i++)
-      startingValue = OpType::update(
-          startingValue, OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams),
-          extraParams);
+    sd::OffsetIterator<1> xIt(xShapeInfo);
+    for (sd::LongType i = 0; i < length; i++, xIt.next())
+      startingValue = OpType::update(startingValue, OpType::op(x[xIt.offset(0)], extraParams), extraParams);
 
     return OpType::postProcess(startingValue, length, extraParams);
   }
@@ -63,8 +63,6 @@ void SD_HOST ReduceSameFunction<X>::execScalar(const void *vx, const sd::LongTyp
     z[0] = execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    const bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
     int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
     X intermediate[64];
 
@@ -72,10 +70,12 @@ void SD_HOST ReduceSameFunction<X>::execScalar(const void *vx, const sd::LongTyp
     for (auto e = 0; e < maxThreads; e++) intermediate[e] = OpType::startingValue(x);
 
     auto func = PRAGMA_THREADS_FOR {
-      for (auto i = start; i < stop; i++)
-        intermediate[thread_id] = OpType::update(
-            intermediate[thread_id],
-            OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams), extraParams);
+      sd::OffsetIterator<1> xIt(xShapeInfo);
+      xIt.seek(start);
+
+      for (auto i = start; i < stop; i++, xIt.next())
+        intermediate[thread_id] =
+            OpType::update(intermediate[thread_id], OpType::op(x[xIt.offset(0)], extraParams), extraParams);
     };
 
     maxThreads = samediff::Threads::parallel_for(func, 0, length, 1, maxThreads);
@@ -102,13 +102,10 @@ X SD_HOST ReduceSameFunction<X>::execScalar(const void *vx, const sd::LongType *
     return execScalar<OpType>(x, xEws, length, extraParams);
   } else {
     auto startingValue = OpType::startingValue(x);
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    bool canCastX = sd::DataTypeUtils::castShapeInfo(xShapeInfo, xShapeInfoCast);
 
-    for (sd::LongType i = 0; i < length; i++)
-      startingValue = OpType::update(
-          startingValue, OpType::op(x[shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX)], extraParams),
-          extraParams);
+    sd::OffsetIterator<1> xIt(xShapeInfo);
+    for (sd::LongType i = 0; i < length; i++, xIt.next())
+      startingValue = OpType::update(startingValue, OpType::op(x[xIt.offset(0)], extraParams), extraParams);
 
     return OpType::postProcess(startingValue, length, extraParams);
   }
@@ -139,6 +136,10 @@ X SD_HOST ReduceSameFunction<X>::execScalar(const void *vx, sd::LongType xEws, s
                                             void *vextraParams) {
   auto x = reinterpret_cast<const X *>(vx);
   auto extraParams = reinterpret_cast<X *>(vextraParams);
+
+  X result;
+  if (xEws == 1 && sd::HalfPrecision<X, X, X, OpType>::reduce(x, length, extraParams, result)) return result;
+
   int maxThreads = sd::math::sd_min<int>(64, sd::Environment::getInstance().maxThreads());
   X intermediate[64];
 
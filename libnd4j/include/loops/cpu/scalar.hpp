@@ -20,7 +20,9 @@
 // Created by raver119 on 08.10.2017.
 //
 #include <execution/Threads.h>
+#include <helpers/HalfPrecisionLoops.h>
 #include <helpers/LoopKind.h>
+#include <helpers/OffsetIterator.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
@@ -132,23 +134,21 @@ void ScalarTransform<X, Y, Z>::transform(const void *vx, const sd::LongType *xSh
   if (kindOfLoop == sd::LoopKind::EWS1 || kindOfLoop == sd::LoopKind::EWSNONZERO) {
     transform<OpType>(x, xEws, z, zEws, vscalar, extraParams, len, start, stop);
   } else {
-    sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-    const bool canCastX = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(xShapeInfo, xShapeInfoCast);
-
     if (shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+      sd::OffsetIterator<1> it(xShapeInfo);
+      it.seek(start);
+
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto offset = it.offset(0);
         z[offset] = OpType::op(x[offset], scalar, extraParams);
       };
     } else {
-      sd::Unsigned zShapeInfoCast[SD_MAX_RANK];
-      const bool canCastZ = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(zShapeInfo, zShapeInfoCast);
+      sd::OffsetIterator<2> it(xShapeInfo, zShapeInfo);
+      it.seek(start);
 
-      PRAGMA_OMP_SIMD
-      for (auto i = start; i < stop; i++) {
-        auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-        auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+      for (auto i = start; i < stop; i++, it.next()) {
+        const auto xOffset = it.offset(0);
+        const auto zOffset = it.offset(1);
         z[zOffset] = OpType::op(x[xOffset], scalar, extraParams);
       };
     }
@@ -167,6 +167,8 @@ void ScalarTransform<X, Y, Z>::transform(const void *vx, sd::LongType xEws, void
   auto extraParams = reinterpret_cast<Z *>(vextraParams);
 
   if (xEws == 1 && zEws == 1) {
+    if (sd::HalfPrecision<X, Y, Z, OpType>::scalar(x, scalar, z, extraParams, start, stop)) return;
+
     PRAGMA_OMP_SIMD
     for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], scalar, extraParams);
   } else {
@@ -23,6 +23,7 @@
 
 #include <execution/Threads.h>
 #include <helpers/LoopKind.h>
+#include <helpers/OffsetIterator.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
@@ -132,23 +133,21 @@ void ScalarIntTransform<X>::transform(const void *vx, const sd::LongType *xShape
     return;
   }
 
-  sd::Unsigned xShapeInfoCast[SD_MAX_RANK];
-  const bool canCastX = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(xShapeInfo, xShapeInfoCast);
-
   if (shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo)) {
-    PRAGMA_OMP_SIMD
-    for (auto i = start; i < stop; i++) {
-      auto offset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
+    sd::OffsetIterator<1> it(xShapeInfo);
+    it.seek(start);
+
+    for (auto i = start; i < stop; i++, it.next()) {
+      const auto offset = it.offset(0);
       z[offset] = OpType::op(x[offset], scalar, extraParams);
     };
   } else {
-    sd::Unsigned zShapeInfoCast[SD_MAX_RANK];
-    const bool canCastZ = sd::DataTypeUtils::castShapeInfo<sd::Unsigned>(zShapeInfo, zShapeInfoCast);
+    sd::OffsetIterator<2> it(xShapeInfo, zShapeInfo);
+    it.seek(start);
 
-    PRAGMA_OMP_SIMD
-    for (auto i = start; i < stop; i++) {
-      auto xOffset = shape::indexOffset(i, xShapeInfo, xShapeInfoCast, canCastX);
-      auto zOffset = shape::indexOffset(i, zShapeInfo, zShapeInfoCast, canCastZ);
+    for (auto i = start; i < stop; i++, it.next()) {
+      const auto xOffset = it.offset(0);
+      const auto zOffset = it.offset(1);
       z[zOffset] = OpType::op(x[xOffset], scalar, extraParams);
     };
   }
@@ -20,8 +20,10 @@
 // Created by raver on 6/12/2018.
 //
 #include <execution/Threads.h>
+#include <helpers/HalfPrecisionLoops.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <loops/type_conversions.h>
+#include <system/CpuDispatch.h>
 #include <system/op_boilerplate.h>
 #include <types/types.h>
 
@@ -196,15 +198,38 @@ void TypeCast::convertFromThreshold(sd::Pointer *extras, const void *dx, sd::Lon
  * @param N
  * @param dz
  */
+template <typename S, typename T,
+          bool = std::is_same<S, float16>::value || std::is_same<S, bfloat16>::value ||
+                 std::is_same<T, float16>::value || std::is_same<T, bfloat16>::value>
+struct TypeCastKernel {
+  static SD_INLINE void run(const S *x, T *z, const sd::LongType start, const sd::LongType stop) {
+    for (auto i = start; i < stop; i++) {
+      z[i] = static_cast<T>(static_cast<float>(x[i]));
+    }
+  }
+};
+
+// one side is a 16-bit float: cast through a float block with the bulk conversions
+template <typename S, typename T>
+struct TypeCastKernel<S, T, true> {
+  static SD_INLINE void run(const S *x, T *z, const sd::LongType start, const sd::LongType stop) {
+    float buffer[sd::kHalfBlockSize];
+    for (auto b = start; b < stop; b += sd::kHalfBlockSize) {
+      const auto n = sd::math::sd_min<sd::LongType>(sd::kHalfBlockSize, stop - b);
+      sd::convertToFloats(x + b, buffer, n);
+      sd::convertFromFloats(buffer, z + b, n);
+    }
+  }
+};
+
 template <typename S, typename T>
 void TypeCast::convertGeneric(sd::Pointer *extras, void *dx, sd::LongType N, void *dz) {
   auto x = reinterpret_cast<S *>(dx);
   auto z = reinterpret_cast<T *>(dz);
 
   auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      z[i] = static_cast<T>(static_cast<float>(x[i]));
-    }
+    isaDispatch<TypeCastKernel<S, T>>(static_cast<const S *>(x), z, static_cast<sd::LongType>(start),
+                                      static_cast<sd::LongType>(stop));
   };
   samediff::Threads::parallel_for(func, 0, N);
 };
@@ -28,6 +28,7 @@
 #include <math/templatemath.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <system/Tracer.h>
 #include <system/op_boilerplate.h>
 
 #include <atomic>
@@ -138,6 +139,8 @@ void *Workspace::allocateBytes(sd::LongType numBytes) {
 
     _spillsSize += numBytes;
 
+    if (Tracer::isEnabled()) Tracer::getInstance().instant(TraceEventType::WORKSPACE_SPILL, "workspace", numBytes);
+
     return p;
   }
 
@@ -115,6 +115,11 @@ class SD_LIB_EXPORT DeclarableOp {
    */
   int prepareOutputs(Context& block);
 
+  /**
+   *   This method applies activation folded into this op by graph optimization, in-place on the first output
+   */
+  void applyFusedActivation(Context& block);
+
   virtual samediff::EmptyHandling emptyHandling();
 
  public:
@@ -56,10 +56,11 @@ LIST_OP_IMPL(create_list, -2, 2, 0, -2) {
   auto list = new NDArrayList(height, expandable);
   // we receive input array for graph integrity purposes only
   auto input = INPUT_VARIABLE(0);
-  //mainly a marker for now, representing the fixed shape the elements can be
-  if(block.width() > 1) {
+  // fixed element shape: together with the element dtype it lets the list preallocate contiguous storage
+  if (block.width() > 1 && block.numD() > 0) {
     auto setShape = INPUT_VARIABLE(1);
-
+    if (setShape->isZ() && setShape->rankOf() == 1 && setShape->lengthOf() > 0)
+      list->preallocate(D_ARG(0), setShape->asVectorT<sd::LongType>());
   }
   setupResultList(list, block);
   //            OVERWRITE_RESULT(list);
@@ -37,32 +37,14 @@ LIST_OP_IMPL(gather_list, 2, 1, 0, -2) {
                "Number of indicies should be equal to number of elements in list, but got [%i] indices instead",
                indices->lengthOf());
 
-  // first of all we need to get shapes
-  std::vector<sd::LongType> shape({0});
-  shape[0] = indices->lengthOf();
-  for (int e = 0; e < list->height(); e++) {
-    auto array = list->readRaw(e);
-
-    // now we should fill other dimensions
-    if (e == 0) {
-      for (int d = 0; d < array->rankOf(); d++) shape.emplace_back(array->sizeAt(d));
-    }
+  std::vector<int> idcs(indices->lengthOf());
+  for (int e = 0; e < idcs.size(); e++) {
+    idcs[e] = indices->e<int>(e);
+    REQUIRE_TRUE(list->isWritten(idcs[e]), 0, "GatherList: requested index [%i] wasn't written yet", idcs[e]);
   }
 
-  auto result = NDArrayFactory::create_('c', shape, list->dataType());
-  std::vector<sd::LongType> indicesList((list->readRaw(0)->rankOf() + 1) * 2, 0);
-  int skipPosition = 0;
-  for (int e = 0; e < indices->lengthOf(); e++) {
-    auto idx = indices->e<int>(e);
-    auto array = list->readRaw(idx);
-
-    // first dimension
-    indicesList[0] = skipPosition;
-    indicesList[1] = skipPosition++ + 1;
-
-    auto subarray = (*result)(indicesList, true);
-    subarray.assign(array);
-  }
+  // dense lists copy whole storage slots, others assign element by element
+  auto result = list->gather(idcs);
 
   // OVERWRITE_RESULT(result);
   setupResult(result, block);
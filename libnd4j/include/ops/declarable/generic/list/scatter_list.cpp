@@ -59,8 +59,7 @@ LIST_OP_IMPL(scatter_list, 1, 1, 0, -2) {
     auto idx = indices->e<int>(e);
     if (idx >= tads.size()) return sd::Status::BAD_ARGUMENTS;
 
-    auto arr = new NDArray(tads.at(e)->dup(array->ordering()));
-    auto res = list->write(idx, arr);
+    auto res = list->write(idx, *tads.at(e));
     if (res != sd::Status::OK) return res;
   }
 
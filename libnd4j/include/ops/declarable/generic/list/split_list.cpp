@@ -71,7 +71,7 @@ LIST_OP_IMPL(split_list, 2, 1, 0, -2) {
 
     auto subarray = (*array)(indices);
 
-    auto status = list->write(e, new NDArray(subarray.dup(array->ordering())));
+    auto status = list->write(e, subarray);
 
     if (status != sd::Status::OK) return status;
   }
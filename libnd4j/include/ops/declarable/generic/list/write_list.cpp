@@ -39,7 +39,7 @@ LIST_OP_IMPL(write_list, 2, 1, 0, -2) {
     REQUIRE_TRUE(idx->isScalar(), 0, "Index should be Scalar");
 
 
-    sd::Status result = list->write(idx->e<int>(0), new NDArray(input->dup()));
+    sd::Status result = list->write(idx->e<int>(0), *input);
 
     auto res = NDArrayFactory::create_(list->counter(), block.launchContext());
 
@@ -51,7 +51,7 @@ LIST_OP_IMPL(write_list, 2, 1, 0, -2) {
     auto input = INPUT_VARIABLE(1);
     auto idx = INT_ARG(0);
 
-    sd::Status result = list->write(idx, new NDArray(input->dup()));
+    sd::Status result = list->write(idx, *input);
 
     auto res = NDArrayFactory::create_(list->counter(), block.launchContext());
     // res->printShapeInfo("Write_list 1 output shape");
@@ -0,0 +1,184 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Vocabulary lookup ops over hash tables kept as (table, keys, values) arrays, see helpers/lookup_table.h
+//
+
+#include <system/op_boilerplate.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/lookup_table.h>
+
+namespace sd {
+namespace ops {
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_hash_table_build)
+CUSTOM_OP_IMPL(hash_table_build, 1, 1, false, 0, -2) {
+  auto keys = INPUT_VARIABLE(0);
+  auto table = OUTPUT_VARIABLE(0);
+
+  auto error = helpers::hashTableValidate(*table, *keys);
+  REQUIRE_TRUE(error.empty(), 0, "hash_table_build: %s", error.c_str());
+
+  helpers::hashTableBuild(block.launchContext(), *keys, *table);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(hash_table_build) {
+  getOpDescriptor()
+      ->setAllowedInputTypes({ALL_INTS, sd::DataType::UTF8})
+      ->setAllowedOutputTypes(sd::DataType::INT64);
+}
+
+DECLARE_SHAPE_FN(hash_table_build) {
+  auto keys = INPUT_VARIABLE(0);
+
+  // optional number of keys to reserve room for, so that later insertions don't rebuild the index
+  auto reserve = block.numI() > 0 ? INT_ARG(0) : 0;
+  auto capacity = helpers::hashTableCapacity(sd::math::sd_max<sd::LongType>(keys->lengthOf(), reserve));
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::INT64, 'c', {capacity, 2}));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_hash_table_lookup)
+CUSTOM_OP_IMPL(hash_table_lookup, 4, 1, false, 0, -2) {
+  auto table = INPUT_VARIABLE(0);
+  auto keys = INPUT_VARIABLE(1);
+  auto values = INPUT_VARIABLE(2);
+  auto queries = INPUT_VARIABLE(3);
+  auto defaultValue = block.width() > 4 ? INPUT_VARIABLE(4) : nullptr;
+  auto output = OUTPUT_VARIABLE(0);
+
+  auto numOovBuckets = block.numI() > 0 ? INT_ARG(0) : 0;
+
+  auto error = helpers::hashTableValidate(*table, *keys);
+  REQUIRE_TRUE(error.empty(), 0, "hash_table_lookup: %s", error.c_str());
+  REQUIRE_TRUE(values->rankOf() > 0 && values->sizeAt(0) == keys->lengthOf() && !values->isS(), 0,
+               "hash_table_lookup: values should be numeric with a row per key");
+  REQUIRE_TRUE(queries->isS() == keys->isS() && (queries->isS() || queries->isZ()), 0,
+               "hash_table_lookup: queries should have the same kind as keys");
+  REQUIRE_TRUE(numOovBuckets == 0 || (values->isZ() && values->rankOf() == 1), 0,
+               "hash_table_lookup: out of vocabulary buckets need integer vector values");
+  REQUIRE_TRUE(defaultValue == nullptr || defaultValue->lengthOf() == 1 ||
+                   defaultValue->lengthOf() * values->sizeAt(0) == values->lengthOf(),
+               0, "hash_table_lookup: default value should be a scalar or a row of values");
+
+  if (queries->isEmpty()) return sd::Status::OK;
+
+  helpers::hashTableLookup(block.launchContext(), *table, *keys, *values, *queries, defaultValue, numOovBuckets,
+                           *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(hash_table_lookup) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS, sd::DataType::UTF8})
+      ->setAllowedInputTypes(2, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_INTS, sd::DataType::UTF8})
+      ->setAllowedInputTypes(4, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedOutputTypes({ALL_INTS, ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(hash_table_lookup) {
+  auto values = INPUT_VARIABLE(2);
+  auto queries = INPUT_VARIABLE(3);
+
+  // queries shape followed by the row shape
+  auto shape = queries->getShapeAsVector();
+  for (int d = 1; d < values->rankOf(); d++) shape.emplace_back(values->sizeAt(d));
+
+  if (queries->isEmpty()) return SHAPELIST(ConstantShapeHelper::getInstance().emptyShapeInfo(values->dataType()));
+
+  if (shape.empty()) return SHAPELIST(ConstantShapeHelper::getInstance().scalarShapeInfo(values->dataType()));
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(values->dataType(), 'c', shape));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_hash_table_insert)
+CUSTOM_OP_IMPL(hash_table_insert, 5, 3, false, 0, 0) {
+  auto table = INPUT_VARIABLE(0);
+  auto keys = INPUT_VARIABLE(1);
+  auto values = INPUT_VARIABLE(2);
+  auto newKeys = INPUT_VARIABLE(3);
+  auto newValues = INPUT_VARIABLE(4);
+
+  auto error = helpers::hashTableValidate(*table, *keys);
+  REQUIRE_TRUE(error.empty(), 0, "hash_table_insert: %s", error.c_str());
+  REQUIRE_TRUE(values->rankOf() > 0 && values->sizeAt(0) == keys->lengthOf() && !values->isS(), 0,
+               "hash_table_insert: values should be numeric with a row per key");
+  REQUIRE_TRUE(newKeys->rankOf() <= 1 && newKeys->isS() == keys->isS() && (newKeys->isS() || newKeys->isZ()), 0,
+               "hash_table_insert: new keys should be a vector of the same kind as keys");
+  REQUIRE_TRUE(newValues->rankOf() == values->rankOf() && newValues->sizeAt(0) == newKeys->lengthOf() &&
+                   newValues->lengthOf() * values->sizeAt(0) == values->lengthOf() * newValues->sizeAt(0),
+               0, "hash_table_insert: new values should have a row per new key, of the same shape as rows of values");
+
+  helpers::hashTableInsert(block.launchContext(), *table, *keys, *values, *newKeys, *newValues, *OUTPUT_VARIABLE(0),
+                           *OUTPUT_VARIABLE(1), *OUTPUT_VARIABLE(2));
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(hash_table_insert) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS, sd::DataType::UTF8})
+      ->setAllowedInputTypes(2, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_INTS, sd::DataType::UTF8})
+      ->setAllowedInputTypes(4, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedOutputTypes(0, sd::DataType::INT64)
+      ->setAllowedOutputTypes(1, {ALL_INTS, sd::DataType::UTF8})
+      ->setAllowedOutputTypes(2, {ALL_INTS, ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(hash_table_insert) {
+  auto table = INPUT_VARIABLE(0);
+  auto keys = INPUT_VARIABLE(1);
+  auto values = INPUT_VARIABLE(2);
+  auto newKeys = INPUT_VARIABLE(3);
+
+  auto error = helpers::hashTableValidate(*table, *keys);
+  REQUIRE_TRUE(error.empty(), 0, "hash_table_insert: %s", error.c_str());
+
+  // the index keeps its capacity while the load factor allows, so it can be updated in place
+  auto total = keys->lengthOf() + helpers::hashTableCountMissing(*table, *keys, *newKeys);
+  auto capacity = sd::math::sd_max<sd::LongType>(table->sizeAt(0), helpers::hashTableCapacity(total));
+
+  auto tableShape = ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::INT64, 'c', {capacity, 2});
+  if (total == 0)
+    return SHAPELIST(tableShape, ConstantShapeHelper::getInstance().emptyShapeInfo(keys->dataType()),
+                     ConstantShapeHelper::getInstance().emptyShapeInfo(values->dataType()));
+
+  auto valuesShape = values->getShapeAsVector();
+  valuesShape[0] = total;
+
+  return SHAPELIST(tableShape, ConstantShapeHelper::getInstance().vectorShapeInfo(total, keys->dataType()),
+                   ConstantShapeHelper::getInstance().createShapeInfo(values->dataType(), 'c', valuesShape));
+}
+#endif
+
+}  // namespace ops
+}  // namespace sd
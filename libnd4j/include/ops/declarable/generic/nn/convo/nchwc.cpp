@@ -0,0 +1,310 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// NCHWc (channel-blocked) layout ops. Blocked array has shape [bS, ceil(C / b), H, W, b], b = SD_CHANNEL_BLOCK
+//
+
+#include <system/op_boilerplate.h>
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/convolutions.h>
+
+namespace sd {
+namespace ops {
+
+#if NOT_EXCLUDED(OP_to_nchwc)
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(to_nchwc, 1, 1, false, 0, 0) {
+  auto input = INPUT_VARIABLE(0);    // [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)
+  auto output = OUTPUT_VARIABLE(0);  // [bS, iCb, iH, iW, b]
+
+  const int isNCHW = block.getIArguments()->size() > 0 ? !INT_ARG(0) : 1;  // INT_ARG(0): 0-NCHW, 1-NHWC
+
+  REQUIRE_TRUE(input->rankOf() == 4, 0, "TO_NCHWC op: input array should have rank of 4, but got %i instead",
+               input->rankOf());
+
+  ConvolutionUtils::toBlockedChannels(block, *input, *output, isNCHW);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(to_nchwc) { getOpDescriptor()->setAllowedInputTypes(sd::DataType::ANY)->setSameMode(true); }
+
+DECLARE_SHAPE_FN(to_nchwc) {
+  auto inShape = inputShape->at(0);
+  const int isNCHW = block.getIArguments()->size() > 0 ? !INT_ARG(0) : 1;
+
+  REQUIRE_TRUE(shape::rank(inShape) == 4, 0, "TO_NCHWC op: input array should have rank of 4, but got %i instead",
+               shape::rank(inShape));
+
+  const sd::LongType iC = shape::sizeAt(inShape, isNCHW ? 1 : 3);
+  const sd::LongType iH = shape::sizeAt(inShape, isNCHW ? 2 : 1);
+  const sd::LongType iW = shape::sizeAt(inShape, isNCHW ? 3 : 2);
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(
+      ArrayOptions::dataType(inShape), 'c',
+      {shape::sizeAt(inShape, 0), ConvolutionUtils::blockedChannels(iC), iH, iW, SD_CHANNEL_BLOCK}));
+}
+#endif
+
+#if NOT_EXCLUDED(OP_from_nchwc)
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(from_nchwc, 1, 1, false, 0, 1) {
+  auto input = INPUT_VARIABLE(0);    // [bS, iCb, iH, iW, b]
+  auto output = OUTPUT_VARIABLE(0);  // [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)
+
+  const int isNCHW = block.getIArguments()->size() > 1 ? !INT_ARG(1) : 1;  // INT_ARG(1): 0-NCHW, 1-NHWC
+
+  REQUIRE_TRUE(input->rankOf() == 5 && input->sizeAt(4) == SD_CHANNEL_BLOCK, 0,
+               "FROM_NCHWC op: input array should have shape [bS, iCb, iH, iW, %i], but got %s instead",
+               SD_CHANNEL_BLOCK, ShapeUtils::shapeAsString(input).c_str());
+
+  ConvolutionUtils::fromBlockedChannels(block, *input, *output, isNCHW);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(from_nchwc) { getOpDescriptor()->setAllowedInputTypes(sd::DataType::ANY)->setSameMode(true); }
+
+DECLARE_SHAPE_FN(from_nchwc) {
+  auto inShape = inputShape->at(0);
+  const sd::LongType iC = INT_ARG(0);
+  const int isNCHW = block.getIArguments()->size() > 1 ? !INT_ARG(1) : 1;
+
+  REQUIRE_TRUE(shape::rank(inShape) == 5, 0, "FROM_NCHWC op: input array should have rank of 5, but got %i instead",
+               shape::rank(inShape));
+  REQUIRE_TRUE(ConvolutionUtils::blockedChannels(iC) == shape::sizeAt(inShape, 1), 0,
+               "FROM_NCHWC op: %i channels don't match %i channel blocks of input", (int)iC,
+               (int)shape::sizeAt(inShape, 1));
+
+  const sd::LongType bS = shape::sizeAt(inShape, 0);
+  const sd::LongType iH = shape::sizeAt(inShape, 2);
+  const sd::LongType iW = shape::sizeAt(inShape, 3);
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(
+      ArrayOptions::dataType(inShape), 'c',
+      isNCHW ? std::vector<sd::LongType>({bS, iC, iH, iW}) : std::vector<sd::LongType>({bS, iH, iW, iC})));
+}
+#endif
+
+#if NOT_EXCLUDED(OP_conv2d_nchwc)
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(conv2d_nchwc, 2, 1, false, 0, 9) {
+  auto input = INPUT_VARIABLE(0);    // [bS, iCb, iH, iW, b] if BArg(0), else [bS, iH, iW, iC] (NHWC) or [bS, iC, iH, iW]
+  auto weights = INPUT_VARIABLE(1);  // [kH, kW, iC, oC], [oC, iC, kH, kW], [oC, kH, kW, iC]
+  auto bias = block.width() > 2 ? INPUT_VARIABLE(2) : nullptr;  // [oC]
+
+  auto output = OUTPUT_VARIABLE(0);  // [bS, oCb, oH, oW, b] if BArg(1), else [bS, oH, oW, oC] (NHWC) or [bS, oC, oH, oW]
+
+  int sH = INT_ARG(2);                                               // strides height
+  int sW = INT_ARG(3);                                               // strides width
+  int pH = INT_ARG(4);                                               // paddings height
+  int pW = INT_ARG(5);                                               // paddings width
+  int dH = INT_ARG(6);                                               // dilations height
+  int dW = INT_ARG(7);                                               // dilations width
+  int isSameMode = INT_ARG(8);                                       // 0-VALID, 1-SAME
+  int isNCHW = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;  // INT_ARG(9): 0-NCHW,  1-NHWC
+  int wFormat = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;
+  const bool blockedInput = block.getBArguments()->size() > 0 ? B_ARG(0) : false;
+  const bool blockedOutput = block.getBArguments()->size() > 1 ? B_ARG(1) : false;
+
+  int kH = INT_ARG(0) > 0 ? INT_ARG(0) : static_cast<int>(weights->sizeAt(0 == wFormat ? 0 : (1 == wFormat ? 2 : 1)));
+  int kW = INT_ARG(1) > 0 ? INT_ARG(1) : static_cast<int>(weights->sizeAt(0 == wFormat ? 1 : (1 == wFormat ? 3 : 2)));
+
+  const int iC = weights->sizeAt(0 == wFormat ? 2 : (1 == wFormat ? 1 : 3));
+  const int oC = weights->sizeAt(0 == wFormat ? 3 : 0);
+
+  REQUIRE_TRUE(weights->isSameShape(ConvolutionUtils::expectWeightsShape(wFormat, kH, kW, iC, oC)), 0,
+               "CONV2D_NCHWC OP: wrong shape of weights array %s", ShapeUtils::shapeAsString(weights).c_str());
+  if (bias)
+    REQUIRE_TRUE(bias->rankOf() <= 2 && oC == bias->lengthOf(), 0,
+                 "CONV2D_NCHWC OP: wrong shape of array with biases, expected length %i, but got %i instead !", oC,
+                 bias->lengthOf());
+
+  NDArray* x = input;
+  if (!blockedInput) {
+    x = new NDArray('c',
+                    {input->sizeAt(0), ConvolutionUtils::blockedChannels(iC), input->sizeAt(isNCHW ? 2 : 1),
+                     input->sizeAt(isNCHW ? 3 : 2), SD_CHANNEL_BLOCK},
+                    input->dataType(), block.launchContext());
+    ConvolutionUtils::toBlockedChannels(block, *input, *x, isNCHW);
+  }
+
+  REQUIRE_TRUE(x->sizeAt(1) == ConvolutionUtils::blockedChannels(iC), 0,
+               "CONV2D_NCHWC OP: %i input channel blocks don't match %i weights input channels", (int)x->sizeAt(1), iC);
+
+  NDArray* z = output;
+  if (!blockedOutput)
+    z = new NDArray('c',
+                    {output->sizeAt(0), ConvolutionUtils::blockedChannels(oC), output->sizeAt(isNCHW ? 2 : 1),
+                     output->sizeAt(isNCHW ? 3 : 2), SD_CHANNEL_BLOCK},
+                    output->dataType(), block.launchContext());
+
+  ConvolutionUtils::conv2dBlocked(block, *x, *weights, bias, *z, kH, kW, sH, sW, pH, pW, dH, dW, isSameMode, wFormat);
+
+  if (!blockedOutput) {
+    ConvolutionUtils::fromBlockedChannels(block, *z, *output, isNCHW);
+    delete z;
+  }
+
+  if (!blockedInput) delete x;
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(conv2d_nchwc) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, sd::DataType::ANY)
+      ->setAllowedInputTypes(1, {ALL_FLOATS})
+      ->setAllowedInputTypes(2, {ALL_FLOATS})
+      ->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(conv2d_nchwc) {
+  auto inShape = inputShape->at(0);
+  auto weightsShape = inputShape->at(1);
+
+  int sH = INT_ARG(2);
+  int sW = INT_ARG(3);
+  int pH = INT_ARG(4);
+  int pW = INT_ARG(5);
+  int dH = INT_ARG(6);
+  int dW = INT_ARG(7);
+  int isSameMode = INT_ARG(8);
+  int isNCHW = block.getIArguments()->size() > 9 ? !INT_ARG(9) : 1;
+  int wFormat = block.getIArguments()->size() > 10 ? INT_ARG(10) : 0;
+  const bool blockedInput = block.getBArguments()->size() > 0 ? B_ARG(0) : false;
+  const bool blockedOutput = block.getBArguments()->size() > 1 ? B_ARG(1) : false;
+
+  int kH = INT_ARG(0) > 0 ? INT_ARG(0) : shape::sizeAt(weightsShape, 0 == wFormat ? 0 : (1 == wFormat ? 2 : 1));
+  int kW = INT_ARG(1) > 0 ? INT_ARG(1) : shape::sizeAt(weightsShape, 0 == wFormat ? 1 : (1 == wFormat ? 3 : 2));
+
+  REQUIRE_TRUE(shape::rank(inShape) == (blockedInput ? 5 : 4), 0,
+               "CONV2D_NCHWC OP: rank of input array must be equal to %i, but got %i instead !", blockedInput ? 5 : 4,
+               shape::rank(inShape));
+  REQUIRE_TRUE(shape::rank(weightsShape) == 4, 0,
+               "CONV2D_NCHWC OP: rank of weights array must be equal to 4, but got %i instead !",
+               shape::rank(weightsShape));
+
+  const int indIiH = blockedInput || isNCHW ? 2 : 1;
+  const sd::LongType bS = shape::sizeAt(inShape, 0);
+  const int iH = shape::sizeAt(inShape, indIiH);
+  const int iW = shape::sizeAt(inShape, indIiH + 1);
+  const sd::LongType oC = shape::sizeAt(weightsShape, 0 == wFormat ? 3 : 0);
+
+  int oH, oW;
+  ConvolutionUtils::calcOutSizePool2D(oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, iH, iW, isSameMode);
+
+  std::vector<sd::LongType> outShape;
+  if (blockedOutput)
+    outShape = {bS, ConvolutionUtils::blockedChannels(oC), oH, oW, SD_CHANNEL_BLOCK};
+  else if (isNCHW)
+    outShape = {bS, oC, oH, oW};
+  else
+    outShape = {bS, oH, oW, oC};
+
+  return SHAPELIST(
+      ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(weightsShape), 'c', outShape));
+}
+#endif
+
+#if NOT_EXCLUDED(OP_upsampling2d_nchwc)
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(upsampling2d_nchwc, 1, 1, false, 0, 2) {
+  auto input = INPUT_VARIABLE(0);
+  auto output = OUTPUT_VARIABLE(0);
+
+  const int factorH = INT_ARG(0);
+  const int factorW = INT_ARG(1);
+  const int isNCHW = block.getIArguments()->size() > 2 ? INT_ARG(2) : 0;  // INT_ARG(2): 0-NHWC, 1-NCHW
+  const bool blockedInput = block.getBArguments()->size() > 0 ? B_ARG(0) : false;
+  const bool blockedOutput = block.getBArguments()->size() > 1 ? B_ARG(1) : false;
+
+  NDArray* x = input;
+  if (!blockedInput) {
+    x = new NDArray('c',
+                    {input->sizeAt(0), ConvolutionUtils::blockedChannels(input->sizeAt(isNCHW ? 1 : 3)),
+                     input->sizeAt(isNCHW ? 2 : 1), input->sizeAt(isNCHW ? 3 : 2), SD_CHANNEL_BLOCK},
+                    input->dataType(), block.launchContext());
+    ConvolutionUtils::toBlockedChannels(block, *input, *x, isNCHW);
+  }
+
+  NDArray* z = output;
+  if (!blockedOutput)
+    z = new NDArray('c', {x->sizeAt(0), x->sizeAt(1), x->sizeAt(2) * factorH, x->sizeAt(3) * factorW, SD_CHANNEL_BLOCK},
+                    output->dataType(), block.launchContext());
+
+  ConvolutionUtils::upsampling2dBlocked(block, *x, *z, factorH, factorW);
+
+  if (!blockedOutput) {
+    ConvolutionUtils::fromBlockedChannels(block, *z, *output, isNCHW);
+    delete z;
+  }
+
+  if (!blockedInput) delete x;
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(upsampling2d_nchwc) {
+  getOpDescriptor()->setAllowedInputTypes(sd::DataType::ANY)->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(upsampling2d_nchwc) {
+  auto inShape = inputShape->at(0);
+
+  const int factorH = INT_ARG(0);
+  const int factorW = INT_ARG(1);
+  const int isNCHW = block.getIArguments()->size() > 2 ? INT_ARG(2) : 0;
+  const bool blockedInput = block.getBArguments()->size() > 0 ? B_ARG(0) : false;
+  const bool blockedOutput = block.getBArguments()->size() > 1 ? B_ARG(1) : false;
+
+  REQUIRE_TRUE(shape::rank(inShape) == (blockedInput ? 5 : 4), 0,
+               "UPSAMPLING2D_NCHWC OP: rank of input array must be equal to %i, but got %i instead !",
+               blockedInput ? 5 : 4, shape::rank(inShape));
+
+  const int indIiH = blockedInput || isNCHW ? 2 : 1;
+  const sd::LongType bS = shape::sizeAt(inShape, 0);
+  const sd::LongType oH = shape::sizeAt(inShape, indIiH) * factorH;
+  const sd::LongType oW = shape::sizeAt(inShape, indIiH + 1) * factorW;
+
+  sd::LongType iC;
+  if (blockedInput) {
+    // number of real channels is only required when leaving blocked layout
+    iC = block.getIArguments()->size() > 3 ? INT_ARG(3) : -1;
+    REQUIRE_TRUE(blockedOutput || iC > 0, 0, "UPSAMPLING2D_NCHWC OP: number of channels is required for plain output");
+  } else {
+    iC = shape::sizeAt(inShape, isNCHW ? 1 : 3);
+  }
+
+  std::vector<sd::LongType> outShape;
+  if (blockedOutput)
+    outShape = {bS, blockedInput ? shape::sizeAt(inShape, 1) : ConvolutionUtils::blockedChannels(iC), oH, oW,
+                SD_CHANNEL_BLOCK};
+  else if (isNCHW)
+    outShape = {bS, iC, oH, oW};
+  else
+    outShape = {bS, oH, oW, iC};
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(inShape), 'c', outShape));
+}
+#endif
+
+}  // namespace ops
+}  // namespace sd
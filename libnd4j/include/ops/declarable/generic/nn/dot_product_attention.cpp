@@ -25,6 +25,7 @@
 #include <system/op_boilerplate.h>
 #if NOT_EXCLUDED(OP_dot_product_attention)
 
+#include <array/NDArrayExpression.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/reverse.h>
 
@@ -95,7 +96,7 @@ CUSTOM_OP_IMPL(dot_product_attention, 3, -1, false, 0, 2) {
     // before going through the softmax, we effectively push all masked positions to zero after softmax.
     //
     // we are using 1e9 to mean effectively infinity
-    *weights += (reshapedMask - 1) * 1e9;
+    expr::assign(*weights, expr::lazy(*weights) + (expr::lazy(reshapedMask) - 1.) * 1e9);
   }
 
   sd::ops::softmax softmax;
@@ -191,7 +192,7 @@ CUSTOM_OP_IMPL(dot_product_attention_bp, 4, 3, false, 0, 1) {
     } else {
       reshapedMask = mask->reshape(mask->ordering(), {mask->sizeAt(0), mask->sizeAt(1), 1});
     }
-    preSoftmax += (reshapedMask - 1) * 1e9;
+    expr::assign(preSoftmax, expr::lazy(preSoftmax) + (expr::lazy(reshapedMask) - 1.) * 1e9);
   }
 
   NDArray weights('c', weightShape, values->dataType(), block.launchContext());
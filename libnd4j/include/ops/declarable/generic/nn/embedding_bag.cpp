@@ -0,0 +1,162 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// embedding_bag: rows of params gathered by indices and pooled per bag, bags given by offsets
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_embedding_bag)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/embedding.h>
+#include <ops/declarable/helpers/scatter.h>
+
+namespace sd {
+namespace ops {
+
+static void validateBags(Context& block, const NDArray* params, const NDArray* indices, const NDArray* offsets,
+                               const NDArray* weights, const int mode) {
+  REQUIRE_TRUE(params->rankOf() >= 2, 0, "embedding_bag: params should have rank >= 2, but got %i", params->rankOf());
+  REQUIRE_TRUE(indices->rankOf() == 1, 0, "embedding_bag: indices should be a vector, but got rank %i",
+               indices->rankOf());
+  REQUIRE_TRUE(offsets->rankOf() == 1 && offsets->lengthOf() > 0, 0,
+               "embedding_bag: offsets should be a non-empty vector");
+  REQUIRE_TRUE(mode >= helpers::EMBEDDING_BAG_SUM && mode <= helpers::EMBEDDING_BAG_MAX, 0,
+               "embedding_bag: mode should be 0 (sum), 1 (mean) or 2 (max), but got %i", mode);
+
+  if (weights != nullptr) {
+    REQUIRE_TRUE(weights->isSameShape(indices), 0, "embedding_bag: per sample weights should match indices");
+    REQUIRE_TRUE(weights->dataType() == params->dataType(), 0,
+                 "embedding_bag: per sample weights should have the data type of params");
+    REQUIRE_TRUE(mode != helpers::EMBEDDING_BAG_MAX, 0, "embedding_bag: per sample weights aren't allowed with max");
+  }
+
+  const auto numIndices = indices->lengthOf();
+  sd::LongType previous = 0;
+  for (sd::LongType b = 0; b < offsets->lengthOf(); b++) {
+    const auto offset = offsets->e<sd::LongType>(b);
+    REQUIRE_TRUE(offset >= previous && offset <= numIndices, 0,
+                 "embedding_bag: offsets should be non-decreasing and within [0, %lld], but offsets[%lld] = %lld",
+                 numIndices, b, offset);
+    previous = offset;
+  }
+
+  if (numIndices > 0) {
+    const sd::LongType numOfBadIndx = helpers::checkIndices(block.launchContext(), *indices, *params, 0);
+    REQUIRE_TRUE(numOfBadIndx == 0, 0,
+                 "embedding_bag: please check elements of indices-array, total number of wrong elements is %lld!",
+                 numOfBadIndx);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// inputs: params [N, ...], indices [L], offsets [B], optional per sample weights [L]
+// int arg: mode, 0 - sum, 1 - mean, 2 - max
+CUSTOM_OP_IMPL(embedding_bag, 3, 1, false, 0, 0) {
+  auto params = INPUT_VARIABLE(0);
+  auto indices = INPUT_VARIABLE(1);
+  auto offsets = INPUT_VARIABLE(2);
+  auto weights = block.width() > 3 ? INPUT_VARIABLE(3) : nullptr;
+  auto output = OUTPUT_VARIABLE(0);
+
+  const int mode = block.getIArguments()->size() > 0 ? INT_ARG(0) : helpers::EMBEDDING_BAG_SUM;
+
+  validateBags(block, params, indices, offsets, weights, mode);
+
+  helpers::embeddingBag(block.launchContext(), *params, *indices, *offsets, weights, mode, *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(embedding_bag) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_FLOATS})
+      ->setAllowedInputTypes(1, {ALL_INTS})
+      ->setAllowedInputTypes(2, {ALL_INTS})
+      ->setAllowedInputTypes(3, {ALL_FLOATS})
+      ->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(embedding_bag) {
+  auto paramsShapeInfo = inputShape->at(0);
+  auto offsetsShapeInfo = inputShape->at(2);
+
+  std::vector<sd::LongType> shape(shape::rank(paramsShapeInfo));
+  shape[0] = shape::length(offsetsShapeInfo);
+  for (int e = 1; e < shape.size(); e++) shape[e] = shape::sizeAt(paramsShapeInfo, e);
+
+  return SHAPELIST(
+      ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(paramsShapeInfo), 'c', shape));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// inputs: params, indices, offsets, optional per sample weights, gradO [B, ...]
+// outputs: the sparse gradient of params, i.e. indices [L] and the matching gradient rows [L, ...]
+CUSTOM_OP_IMPL(embedding_bag_bp, 4, 2, false, 0, 0) {
+  auto params = INPUT_VARIABLE(0);
+  auto indices = INPUT_VARIABLE(1);
+  auto offsets = INPUT_VARIABLE(2);
+  auto weights = block.width() > 4 ? INPUT_VARIABLE(3) : nullptr;
+  auto gradO = INPUT_VARIABLE(block.width() - 1);
+
+  auto gradIndices = OUTPUT_VARIABLE(0);
+  auto gradRows = OUTPUT_VARIABLE(1);
+
+  const int mode = block.getIArguments()->size() > 0 ? INT_ARG(0) : helpers::EMBEDDING_BAG_SUM;
+
+  validateBags(block, params, indices, offsets, weights, mode);
+
+  REQUIRE_TRUE(gradO->rankOf() == params->rankOf() && gradO->sizeAt(0) == offsets->lengthOf(), 0,
+               "embedding_bag_bp: gradO should have one row per bag");
+  REQUIRE_TRUE(gradO->dataType() == params->dataType(), 0, "embedding_bag_bp: gradO should have the data type of params");
+
+  gradIndices->assign(indices);
+  helpers::embeddingBagBp(block.launchContext(), *params, *indices, *offsets, weights, *gradO, mode, *gradRows);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(embedding_bag_bp) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(sd::DataType::ANY)
+      ->setAllowedOutputTypes(0, {ALL_INDICES})
+      ->setAllowedOutputTypes(1, {ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(embedding_bag_bp) {
+  auto paramsShapeInfo = inputShape->at(0);
+  auto indicesShapeInfo = inputShape->at(1);
+
+  std::vector<sd::LongType> shape(shape::rank(paramsShapeInfo));
+  shape[0] = shape::length(indicesShapeInfo);
+  for (int e = 1; e < shape.size(); e++) shape[e] = shape::sizeAt(paramsShapeInfo, e);
+
+  auto gradIndices = ConstantShapeHelper::getInstance().vectorShapeInfo(shape::length(indicesShapeInfo),
+                                                                        sd::DataType::INT64);
+  auto gradRows =
+      ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(paramsShapeInfo), 'c', shape);
+
+  return SHAPELIST(gradIndices, gradRows);
+}
+
+}  // namespace ops
+}  // namespace sd
+
+#endif
@@ -25,6 +25,8 @@
 
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/embedding.h>
+#include <ops/declarable/helpers/scatter.h>
 
 #include <numeric>
 #include <vector>
@@ -40,37 +42,32 @@ CUSTOM_OP_IMPL(embedding_lookup, 2, 1, false, 0, 1) {
 
   if (block.width() > 2) {  // multiple input
     indices = INPUT_VARIABLE(block.width() - 1);
-    std::vector<int> dims(input->rankOf());
-    int i = output->rankOf() - input->rankOf();
-    for (auto& v : dims) {
-      v = i++;
-    }
-
-    ResultSet outputView = output->allTensorsAlongDimension(dims);
     REQUIRE_TRUE(block.width() > output->sizeAt(0), 0,
                  "embedding_lookup: input list should be greater then %i, but %i given.", output->sizeAt(0),
                  block.width());
+
+    // every selected input goes straight into its row of the output
     for (sd::LongType e = 0; e < indices->lengthOf(); ++e) {
       sd::LongType thisIndex = (*indices).e<sd::LongType>(e);
       input = INPUT_VARIABLE(thisIndex);  // lookup param
 
-      outputView.at(e)->assign(input);
+      auto row = (*output)(e, {0});
+      row.assign(input);
     }
   } else {
     int indexRank = indices->rankOf();
     REQUIRE_TRUE(indexRank > 0, 0,
                  "embedded_lookup: input array of indexes can't be single scalar, the requirement is: rank > 0 !");
+    REQUIRE_TRUE(indices->lengthOf() == output->sizeAt(0), 0,
+                 "embedding_lookup: expected %lld rows in output, but got %lld.", indices->lengthOf(),
+                 output->sizeAt(0));
 
-    int inputRank = input->rankOf();
-    int lastIndDim = indices->lengthOf();
-    int partition_mode = INT_ARG(0);  // partition_mode == 0 - i.e. 'mod' , 1 - 'div'
-
-    sd::ops::gather op;
+    const sd::LongType numOfBadIndx = helpers::checkIndices(block.launchContext(), *indices, *input, 0);
+    REQUIRE_TRUE(numOfBadIndx == 0, 0,
+                 "embedding_lookup: please check elements of indices-array, total number of wrong elements is %lld!",
+                 numOfBadIndx);
 
-    auto result(op.evaluate({input, indices}, {0}));
-    REQUIRE_TRUE(result.status() == sd::Status::OK, 0, "embedding_lookup: cannot retrieve results from gather op.");
-    REQUIRE_TRUE(result.at(0)->isSameShape(output), 0, "embedding_lookup: wrong shape of return from gather op.");
-    output->assign(result.at(0));
+    helpers::embeddingLookup(block.launchContext(), *input, *indices, *output);
   }
   return sd::Status::OK;
 }
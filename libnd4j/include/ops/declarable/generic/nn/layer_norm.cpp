@@ -26,8 +26,7 @@
 #if NOT_EXCLUDED(OP_layer_norm)
 
 #include <ops/declarable/CustomOperations.h>
-#include <ops/declarable/helpers/addBias.h>
-#include <ops/declarable/helpers/reverse.h>
+#include <ops/declarable/helpers/layer_norm.h>
 
 namespace sd {
 namespace ops {
@@ -54,19 +53,10 @@ CONFIGURABLE_OP_IMPL(layer_norm, 2, 1, false, 0, -1) {
                  input->sizeAt(dimC), ShapeUtils::shapeAsString(bias).c_str());
   }
 
-  std::vector<sd::LongType> longAxis = ArrayUtils::toLongVector(axis);
+  REQUIRE_TRUE(!axis.empty(), 0, "LAYER_NORM OP: axis has to be non-empty");
+  shape::checkDimensions(input->rankOf(), axis);
 
-  sd::ops::standardize standardizeOp;
-  std::vector<NDArray *> inputs = {input};
-  std::vector<NDArray *> outputs = {output};
-  std::vector<double> targs = {};
-  std::vector<bool> bargs = {};
-  standardizeOp.execute(inputs, outputs, targs, longAxis, bargs);
-
-  output->applyBroadcast(sd::broadcast::Multiply, {dimC}, *gain, *output);
-  if (bias != nullptr) {
-    helpers::addBias(block, *output, *bias, *output, isNCHW);
-  }
+  helpers::layerNorm(block.launchContext(), *input, *gain, bias, *output, axis, dimC);
 
   return sd::Status::OK;
 }
@@ -95,7 +85,8 @@ CUSTOM_OP_IMPL(layer_norm_bp, 3, -1, false, 0, -1) {
 
   std::vector<int> axis = *block.getIArguments();
 
-  std::vector<sd::LongType> longAxis = ArrayUtils::toLongVector(axis);
+  REQUIRE_TRUE(!axis.empty(), 0, "LAYER_NORM_BP OP: axis has to be non-empty");
+  shape::checkDimensions(input->rankOf(), axis);
 
   if (bias != nullptr) {
     REQUIRE_TRUE(bias->rankOf() == 1 && bias->sizeAt(0) == input->sizeAt(dimC), 0,
@@ -105,26 +96,9 @@ CUSTOM_OP_IMPL(layer_norm_bp, 3, -1, false, 0, -1) {
     eps->reduceAlongDimension(sd::reduce::Sum, *dLdb, ShapeUtils::evalDimsToExclude(input->rankOf(), {dimC}));
   }
 
-  NDArray standardized(input->shapeInfo(), false, block.launchContext());
-
-  sd::ops::standardize standardizeOp;
-  std::vector<NDArray *> inputs = {input};
-  std::vector<NDArray *> outputs = {&standardized};
-  std::vector<double> targs = {};
-  std::vector<bool> bargs = {};
-
-  standardizeOp.execute(inputs, outputs, targs, longAxis, bargs);
-  standardized.applyPairwiseTransform(sd::pairwise::Multiply, *eps, standardized);
-  standardized.reduceAlongDimension(sd::reduce::Sum, *dLdg, ShapeUtils::evalDimsToExclude(input->rankOf(), {dimC}));
-
-  sd::ops::standardize_bp standardizeBp;
-  // eps->applyTrueBroadcast(sd::BroadcastOpsTuple::Multiply(), gain, dLdx);
-  eps->applyBroadcast(sd::broadcast::Multiply, {dimC}, *gain, *dLdx);
-
-  auto dLdx_tmp = dLdx->dup();
-  std::vector<NDArray *> standardizeBpArgs = {input, &dLdx_tmp};
-  std::vector<NDArray *> standardizeBpOut = {dLdx};
-  standardizeBp.execute(standardizeBpArgs, standardizeBpOut, targs, longAxis, bargs);
+  NDArray dLdgTerms(input->shapeInfo(), false, block.launchContext());
+  helpers::layerNormBp(block.launchContext(), *input, *gain, *eps, *dLdx, dLdgTerms, axis, dimC);
+  dLdgTerms.reduceAlongDimension(sd::reduce::Sum, *dLdg, ShapeUtils::evalDimsToExclude(input->rankOf(), {dimC}));
 
   return sd::Status::OK;
 }
@@ -68,12 +68,8 @@ CONFIGURABLE_OP_IMPL(log_softmax_bp, 2, 1, true, 0, 0) {
                "%i, but got dimension = %i instead !",
                rank, dim);
 
-  helpers::softmax(block.launchContext(), *input, *gradI, dim);
- 
-  auto sumGradOj = gradO->reduceAlongDimension(reduce::Sum, {dim}, true);
-  //gradInputi = gradOutputi - softMax(xi) . sum_j( gradOutputj )
-  //we stored softmax inside gradI
-  gradI->assign(*gradO - *gradI * sumGradOj);
+  // gradInputi = gradOutputi - softMax(xi) . sum_j( gradOutputj )
+  helpers::logSoftmaxBp(block.launchContext(), *input, *gradO, *gradI, dim);
 
   return sd::Status::OK;
 }
@@ -0,0 +1,159 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// max/avg pooling in NCHWc (channel-blocked) layout
+//
+
+#include <system/op_boilerplate.h>
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/convolutions.h>
+
+namespace sd {
+namespace ops {
+
+//////////////////////////////////////////////////////////////////////////
+// 0,1 - kernel Height/Width; 2,3 - stride Height/Width; 4,5 - pad Height/Width; 6,7 - dilation Height/Width;
+// 8 - same mode; 9 - divisor; 10 - data format: 0-NCHW, 1-NHWC; 11 - number of channels
+static sd::Status pooling2dNchwc(sd::graph::Context& block, NDArray* input, NDArray* output,
+                                 const PoolingType poolingMode) {
+  const int kH = INT_ARG(0);
+  const int kW = INT_ARG(1);
+  const int sH = INT_ARG(2);
+  const int sW = INT_ARG(3);
+  int pH = INT_ARG(4);
+  int pW = INT_ARG(5);
+  const int dH = INT_ARG(6);
+  const int dW = INT_ARG(7);
+  const bool isSameMode = INT_ARG(8);
+  const int extraParam0 = block.getIArguments()->size() > 9 ? INT_ARG(9) : 1;
+  const int isNCHW = block.getIArguments()->size() > 10 ? !INT_ARG(10) : 1;
+  const bool blockedInput = block.getBArguments()->size() > 0 ? B_ARG(0) : false;
+  const bool blockedOutput = block.getBArguments()->size() > 1 ? B_ARG(1) : false;
+
+  REQUIRE_TRUE(dH != 0 && dW != 0, 0, "POOLING2D_NCHWC op: dilation must not be zero, but got instead {%i, %i}", dH,
+               dW);
+
+  NDArray* x = input;
+  if (!blockedInput) {
+    x = new NDArray('c',
+                    {input->sizeAt(0), ConvolutionUtils::blockedChannels(input->sizeAt(isNCHW ? 1 : 3)),
+                     input->sizeAt(isNCHW ? 2 : 1), input->sizeAt(isNCHW ? 3 : 2), SD_CHANNEL_BLOCK},
+                    input->dataType(), block.launchContext());
+    ConvolutionUtils::toBlockedChannels(block, *input, *x, isNCHW);
+  }
+
+  const int iH = x->sizeAt(2);
+  const int iW = x->sizeAt(3);
+
+  int oH, oW;
+  ConvolutionUtils::calcOutSizePool2D(oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, iH, iW, isSameMode);
+
+  if (isSameMode) ConvolutionUtils::calcPadding2D(pH, pW, oH, oW, iH, iW, kH, kW, sH, sW, dH, dW);
+
+  NDArray* z = output;
+  if (!blockedOutput)
+    z = new NDArray('c', {x->sizeAt(0), x->sizeAt(1), oH, oW, SD_CHANNEL_BLOCK}, output->dataType(),
+                    block.launchContext());
+
+  ConvolutionUtils::pooling2dBlocked(block, *x, *z, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0);
+
+  if (!blockedOutput) {
+    ConvolutionUtils::fromBlockedChannels(block, *z, *output, isNCHW);
+    delete z;
+  }
+
+  if (!blockedInput) delete x;
+
+  return sd::Status::OK;
+}
+
+static sd::ShapeList* pooling2dNchwcShape(sd::graph::Context& block, sd::ShapeList* inputShape) {
+  auto inShape = inputShape->at(0);
+
+  const int kH = INT_ARG(0);
+  const int kW = INT_ARG(1);
+  const int sH = INT_ARG(2);
+  const int sW = INT_ARG(3);
+  const int pH = INT_ARG(4);
+  const int pW = INT_ARG(5);
+  const int dH = INT_ARG(6);
+  const int dW = INT_ARG(7);
+  const int isSameMode = INT_ARG(8);
+  const int isNCHW = block.getIArguments()->size() > 10 ? !INT_ARG(10) : 1;
+  const bool blockedInput = block.getBArguments()->size() > 0 ? B_ARG(0) : false;
+  const bool blockedOutput = block.getBArguments()->size() > 1 ? B_ARG(1) : false;
+
+  REQUIRE_TRUE(shape::rank(inShape) == (blockedInput ? 5 : 4), 0,
+               "POOLING2D_NCHWC OP: rank of input array must be equal to %i, but got %i instead !",
+               blockedInput ? 5 : 4, shape::rank(inShape));
+
+  const int indIiH = blockedInput || isNCHW ? 2 : 1;
+  const sd::LongType bS = shape::sizeAt(inShape, 0);
+  const int iH = shape::sizeAt(inShape, indIiH);
+  const int iW = shape::sizeAt(inShape, indIiH + 1);
+
+  int oH, oW;
+  ConvolutionUtils::calcOutSizePool2D(oH, oW, kH, kW, sH, sW, pH, pW, dH, dW, iH, iW, isSameMode);
+
+  sd::LongType iC;
+  if (blockedInput) {
+    // number of real channels is only required when leaving blocked layout
+    iC = block.getIArguments()->size() > 11 ? INT_ARG(11) : -1;
+    REQUIRE_TRUE(blockedOutput || iC > 0, 0, "POOLING2D_NCHWC OP: number of channels is required for plain output");
+  } else {
+    iC = shape::sizeAt(inShape, isNCHW ? 1 : 3);
+  }
+
+  std::vector<sd::LongType> outShape;
+  if (blockedOutput)
+    outShape = {bS, blockedInput ? shape::sizeAt(inShape, 1) : ConvolutionUtils::blockedChannels(iC), oH, oW,
+                SD_CHANNEL_BLOCK};
+  else if (isNCHW)
+    outShape = {bS, iC, oH, oW};
+  else
+    outShape = {bS, oH, oW, iC};
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(inShape), 'c', outShape));
+}
+
+#if NOT_EXCLUDED(OP_maxpool2d_nchwc)
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(maxpool2d_nchwc, 1, 1, false, 0, 9) {
+  return pooling2dNchwc(block, INPUT_VARIABLE(0), OUTPUT_VARIABLE(0), PoolingType::MAX_POOL);
+}
+
+DECLARE_TYPES(maxpool2d_nchwc) { getOpDescriptor()->setAllowedInputTypes(sd::DataType::ANY)->setSameMode(true); }
+
+DECLARE_SHAPE_FN(maxpool2d_nchwc) { return pooling2dNchwcShape(block, inputShape); }
+#endif
+
+#if NOT_EXCLUDED(OP_avgpool2d_nchwc)
+//////////////////////////////////////////////////////////////////////////
+CUSTOM_OP_IMPL(avgpool2d_nchwc, 1, 1, false, 0, 10) {
+  return pooling2dNchwc(block, INPUT_VARIABLE(0), OUTPUT_VARIABLE(0), PoolingType::AVG_POOL);
+}
+
+DECLARE_TYPES(avgpool2d_nchwc) { getOpDescriptor()->setAllowedInputTypes(sd::DataType::ANY)->setSameMode(true); }
+
+DECLARE_SHAPE_FN(avgpool2d_nchwc) { return pooling2dNchwcShape(block, inputShape); }
+#endif
+
+}  // namespace ops
+}  // namespace sd
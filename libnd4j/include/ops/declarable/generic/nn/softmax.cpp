@@ -64,10 +64,7 @@ CONFIGURABLE_OP_IMPL(softmax_bp, 2, 1, true, 0, 0) {
                "but got dimension = %i instead !",
                rank, dim);
 
-  helpers::softmax(block.launchContext(), *input, *gradI, dim);
-
-  auto sumAlongDim = (*gradI * *gradO).reduceAlongDimension(reduce::Sum, {dim}, true);
-  gradI->assign(*gradI * (*gradO - sumAlongDim));
+  helpers::softmaxBp(block.launchContext(), *input, *gradO, *gradI, dim);
 
   return sd::Status::OK;
 }
@@ -27,6 +27,7 @@
 
 #include <helpers/MmulHelper.h>
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/epilogue.h>
 #include <ops/declarable/helpers/matmul.h>
 
 namespace sd {
@@ -56,6 +57,18 @@ CUSTOM_OP_IMPL(xw_plus_b, 3, 1, false, 0, 0) {
 
   // multiply x to y
   MmulHelper::mmul(x, w, z, 1.0, 0.0);
+
+  // bias and fused activation are applied within single pass over z
+  const int biasDim = bTranspose && b->rankOf() == 1 ? 0 : 1;
+  if (block.fusedActivation() != graph::FUSED_NONE && z->isMatrix() && b->lengthOf() == z->sizeAt(biasDim)) {
+    helpers::fusedEpilogue(block.launchContext(), *z, b, *z, biasDim, block.fusedActivation(),
+                           block.fusedActivationAlpha());
+    block.markFusedActivationApplied(true);
+
+    if (bTranspose) delete w;
+
+    return sd::Status::OK;
+  }
   if(bTranspose && b->rankOf() == 1) {
     b = new NDArray(INPUT_VARIABLE(2)->reshape('c',{INPUT_VARIABLE(2)->lengthOf(),1}));
     if(z->isMatrix()) {
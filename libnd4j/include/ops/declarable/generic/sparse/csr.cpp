@@ -0,0 +1,262 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// CSR sparse matrices: conversions, sparse x dense products and sparse-dense elementwise ops.
+// A CSR matrix is passed as three arrays: rowPointers, columns and values, see helpers/sparse.h
+//
+
+#include <system/op_boilerplate.h>
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/sparse.h>
+
+namespace sd {
+namespace ops {
+
+static helpers::CsrMatrix csrInput(Context& block, sd::LongType cols, const char* opName) {
+  helpers::CsrMatrix matrix(INPUT_VARIABLE(0), INPUT_VARIABLE(1), INPUT_VARIABLE(2), cols);
+
+  auto error = helpers::csrValidate(matrix);
+  REQUIRE_TRUE(error.empty(), 0, "%s: malformed CSR matrix: %s", opName, error.c_str());
+
+  return matrix;
+}
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_dense_to_csr)
+CUSTOM_OP_IMPL(dense_to_csr, 1, 3, false, 0, 0) {
+  auto dense = INPUT_VARIABLE(0);
+  REQUIRE_TRUE(dense->rankOf() == 2, 0, "dense_to_csr: input should be a matrix, but got rank %i", dense->rankOf());
+
+  helpers::denseToCsr(block.launchContext(), *dense, *OUTPUT_VARIABLE(0), *OUTPUT_VARIABLE(1),
+                      *OUTPUT_VARIABLE(2));
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(dense_to_csr) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedOutputTypes(0, sd::DataType::INT64)
+      ->setAllowedOutputTypes(1, sd::DataType::INT64)
+      ->setAllowedOutputTypes(2, {ALL_INTS, ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(dense_to_csr) {
+  auto dense = INPUT_VARIABLE(0);
+  REQUIRE_TRUE(dense->rankOf() == 2, 0, "dense_to_csr: input should be a matrix, but got rank %i", dense->rankOf());
+
+  // the number of non-zero elements defines the output shapes
+  const auto nnz = helpers::csrCountNonZeros(*dense);
+
+  auto rowPointers = ConstantShapeHelper::getInstance().vectorShapeInfo(dense->sizeAt(0) + 1, sd::DataType::INT64);
+  auto columns = ConstantShapeHelper::getInstance().vectorShapeInfo(nnz, sd::DataType::INT64);
+  auto values = ConstantShapeHelper::getInstance().vectorShapeInfo(nnz, dense->dataType());
+
+  return SHAPELIST(rowPointers, columns, values);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_coo_to_csr)
+CUSTOM_OP_IMPL(coo_to_csr, 3, 3, false, 0, 0) {
+  auto indices = INPUT_VARIABLE(0);
+  auto values = INPUT_VARIABLE(1);
+  auto shape = INPUT_VARIABLE(2);
+
+  REQUIRE_TRUE(indices->rankOf() == 2 && indices->sizeAt(1) == 2 && indices->sizeAt(0) == values->lengthOf(), 0,
+               "coo_to_csr: indices should be [nnz, 2] with nnz equal to the number of values");
+  REQUIRE_TRUE(shape->lengthOf() == 2, 0, "coo_to_csr: shape should hold the number of rows and columns");
+
+  const auto cols = shape->e<sd::LongType>(1);
+  auto columns = OUTPUT_VARIABLE(1);
+
+  helpers::cooToCsr(block.launchContext(), *indices, *values, shape->e<sd::LongType>(0), *OUTPUT_VARIABLE(0),
+                    *columns, *OUTPUT_VARIABLE(2));
+
+  auto error = helpers::csrValidate(helpers::CsrMatrix(OUTPUT_VARIABLE(0), columns, OUTPUT_VARIABLE(2), cols));
+  REQUIRE_TRUE(error.empty(), 0, "coo_to_csr: %s", error.c_str());
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(coo_to_csr) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedInputTypes(2, {ALL_INTS})
+      ->setAllowedOutputTypes(0, sd::DataType::INT64)
+      ->setAllowedOutputTypes(1, sd::DataType::INT64)
+      ->setAllowedOutputTypes(2, {ALL_INTS, ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(coo_to_csr) {
+  auto values = INPUT_VARIABLE(1);
+  auto shape = INPUT_VARIABLE(2);
+  REQUIRE_TRUE(shape->lengthOf() == 2, 0, "coo_to_csr: shape should hold the number of rows and columns");
+
+  auto rowPointers =
+      ConstantShapeHelper::getInstance().vectorShapeInfo(shape->e<sd::LongType>(0) + 1, sd::DataType::INT64);
+  auto columns = ConstantShapeHelper::getInstance().vectorShapeInfo(values->lengthOf(), sd::DataType::INT64);
+  auto csrValues = ConstantShapeHelper::getInstance().vectorShapeInfo(values->lengthOf(), values->dataType());
+
+  return SHAPELIST(rowPointers, columns, csrValues);
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_csr_to_dense)
+CUSTOM_OP_IMPL(csr_to_dense, 4, 1, false, 0, 0) {
+  auto shape = INPUT_VARIABLE(3);
+  auto output = OUTPUT_VARIABLE(0);
+
+  auto matrix = csrInput(block, shape->e<sd::LongType>(1), "csr_to_dense");
+  REQUIRE_TRUE(matrix.rows == output->sizeAt(0), 0, "csr_to_dense: expected %lld rows, but rowPointers give %lld",
+               output->sizeAt(0), matrix.rows);
+
+  helpers::csrToDense(block.launchContext(), matrix, *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(csr_to_dense) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS})
+      ->setAllowedInputTypes(2, {ALL_INTS, ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_INTS})
+      ->setAllowedOutputTypes({ALL_INTS, ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(csr_to_dense) {
+  auto values = INPUT_VARIABLE(2);
+  auto shape = INPUT_VARIABLE(3);
+  REQUIRE_TRUE(shape->lengthOf() == 2, 0, "csr_to_dense: shape should hold the number of rows and columns");
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(values->dataType(), 'c',
+                                                                      shape->getBufferAsVector<sd::LongType>()));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_csr_matmul)
+CUSTOM_OP_IMPL(csr_matmul, 4, 1, false, 0, 0) {
+  auto dense = INPUT_VARIABLE(3);
+  auto output = OUTPUT_VARIABLE(0);
+
+  REQUIRE_TRUE(dense->rankOf() == 1 || dense->rankOf() == 2, 0,
+               "csr_matmul: dense operand should be a vector or a matrix, but got rank %i", dense->rankOf());
+  REQUIRE_TRUE(dense->dataType() == INPUT_VARIABLE(2)->dataType(), 0,
+               "csr_matmul: both operands should have the same data type");
+
+  // the number of columns of the sparse matrix is implied by the dense operand
+  auto matrix = csrInput(block, dense->sizeAt(0), "csr_matmul");
+
+  helpers::csrMatmul(block.launchContext(), matrix, *dense, *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(csr_matmul) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS})
+      ->setAllowedInputTypes(2, {ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_FLOATS})
+      ->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(csr_matmul) {
+  auto rowPointersShapeInfo = inputShape->at(0);
+  auto denseShapeInfo = inputShape->at(3);
+
+  const auto rows = shape::length(rowPointersShapeInfo) - 1;
+  std::vector<sd::LongType> shape = {rows};
+  if (shape::rank(denseShapeInfo) == 2) shape.push_back(shape::sizeAt(denseShapeInfo, 1));
+
+  return SHAPELIST(
+      ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(denseShapeInfo), 'c', shape));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_csr_multiply_dense)
+CUSTOM_OP_IMPL(csr_multiply_dense, 4, 1, false, 0, 0) {
+  auto dense = INPUT_VARIABLE(3);
+
+  REQUIRE_TRUE(dense->rankOf() == 2, 0, "csr_multiply_dense: dense operand should be a matrix");
+  auto matrix = csrInput(block, dense->sizeAt(1), "csr_multiply_dense");
+  REQUIRE_TRUE(matrix.rows == dense->sizeAt(0), 0, "csr_multiply_dense: operands should have the same shape");
+
+  helpers::csrMultiplyDense(block.launchContext(), matrix, *dense, *OUTPUT_VARIABLE(0));
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(csr_multiply_dense) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS})
+      ->setAllowedInputTypes(2, {ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_FLOATS})
+      ->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+// the product keeps the structure of the sparse operand, only values are returned
+DECLARE_SHAPE_FN(csr_multiply_dense) {
+  auto valuesShapeInfo = inputShape->at(2);
+  return SHAPELIST(ConstantShapeHelper::getInstance().vectorShapeInfo(shape::length(valuesShapeInfo),
+                                                                      ArrayOptions::dataType(valuesShapeInfo)));
+}
+#endif
+
+//////////////////////////////////////////////////////////////////////////
+#if NOT_EXCLUDED(OP_csr_add_dense)
+CUSTOM_OP_IMPL(csr_add_dense, 4, 1, false, 0, 0) {
+  auto dense = INPUT_VARIABLE(3);
+
+  REQUIRE_TRUE(dense->rankOf() == 2, 0, "csr_add_dense: dense operand should be a matrix");
+  auto matrix = csrInput(block, dense->sizeAt(1), "csr_add_dense");
+  REQUIRE_TRUE(matrix.rows == dense->sizeAt(0), 0, "csr_add_dense: operands should have the same shape");
+
+  helpers::csrAddDense(block.launchContext(), matrix, *dense, *OUTPUT_VARIABLE(0));
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(csr_add_dense) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_INTS})
+      ->setAllowedInputTypes(1, {ALL_INTS})
+      ->setAllowedInputTypes(2, {ALL_FLOATS})
+      ->setAllowedInputTypes(3, {ALL_FLOATS})
+      ->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+DECLARE_SHAPE_FN(csr_add_dense) {
+  auto denseShapeInfo = inputShape->at(3);
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(denseShapeInfo), 'c',
+                                                                      shape::rank(denseShapeInfo),
+                                                                      shape::shapeOf(denseShapeInfo)));
+}
+#endif
+
+}  // namespace ops
+}  // namespace sd
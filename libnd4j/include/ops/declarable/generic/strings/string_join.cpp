@@ -0,0 +1,67 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Joins utf8 strings along the last dimension
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_string_join)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/strings.h>
+
+namespace sd {
+namespace ops {
+CUSTOM_OP_IMPL(string_join, 1, 1, false, 0, 0) {
+  auto input = INPUT_VARIABLE(0);
+  auto output = OUTPUT_VARIABLE(0);
+
+  REQUIRE_TRUE(input->dataType() == sd::DataType::UTF8, 0, "string_join: only UTF8 input is supported");
+
+  std::string separator;
+  if (block.width() > 1) {
+    auto sep = INPUT_VARIABLE(1);
+    REQUIRE_TRUE(sep->isS() && sep->lengthOf() == 1, 0, "string_join: separator has to be a single string");
+    separator = sep->e<std::string>(0);
+  }
+
+  helpers::stringsJoin(block.launchContext(), *input, separator, *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_SHAPE_FN(string_join) {
+  auto input = INPUT_VARIABLE(0);
+
+  if (input->rankOf() <= 1) return SHAPELIST(ConstantShapeHelper::getInstance().scalarShapeInfo(sd::DataType::UTF8));
+
+  auto shape = input->getShapeAsVector();
+  shape.pop_back();
+
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::UTF8, 'c', shape));
+}
+
+DECLARE_TYPES(string_join) {
+  getOpDescriptor()->setAllowedInputTypes({ALL_STRINGS})->setAllowedOutputTypes({ALL_STRINGS});
+}
+}  // namespace ops
+}  // namespace sd
+
+#endif
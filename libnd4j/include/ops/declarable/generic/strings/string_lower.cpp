@@ -16,21 +16,38 @@
  * SPDX-License-Identifier: Apache-2.0
  ******************************************************************************/
 
+
 //
-// @author raver119@gmail.com
+// Lowercase copy of utf8 strings
 //
 
-#ifndef LIBND4J_LIGHTBENCHMARKSUIT_H
-#define LIBND4J_LIGHTBENCHMARKSUIT_H
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_string_lower)
 
-#include <performance/benchmarking/BenchmarkSuit.h>
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/strings.h>
 
 namespace sd {
-    class LightBenchmarkSuit : public BenchmarkSuit {
-    public:
-        std::string runSuit() override;
-    };
+namespace ops {
+CUSTOM_OP_IMPL(string_lower, 1, 1, false, 0, 0) {
+  auto input = INPUT_VARIABLE(0);
+  auto output = OUTPUT_VARIABLE(0);
+
+  REQUIRE_TRUE(input->dataType() == sd::DataType::UTF8, 0, "string_lower: only UTF8 input is supported");
+
+  helpers::stringsLower(block.launchContext(), *input, *output);
+
+  return sd::Status::OK;
 }
 
+DECLARE_SHAPE_FN(string_lower) {
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::UTF8, inputShape->at(0)));
+}
+
+DECLARE_TYPES(string_lower) {
+  getOpDescriptor()->setAllowedInputTypes({ALL_STRINGS})->setAllowedOutputTypes({ALL_STRINGS});
+}
+}  // namespace ops
+}  // namespace sd
 
-#endif //DEV_TESTS_LIGHTBENCHMARKSUIT_H
+#endif
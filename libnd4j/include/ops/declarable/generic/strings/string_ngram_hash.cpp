@@ -0,0 +1,75 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Hashes n-grams of tokens into buckets
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_string_ngram_hash)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/strings.h>
+
+namespace sd {
+namespace ops {
+CUSTOM_OP_IMPL(string_ngram_hash, 1, 2, false, 0, 2) {
+  auto tokens = INPUT_VARIABLE(0);
+  auto rowSplits = block.width() > 1 ? INPUT_VARIABLE(1) : nullptr;
+  auto hashes = OUTPUT_VARIABLE(0);
+  auto outputSplits = OUTPUT_VARIABLE(1);
+
+  auto width = INT_ARG(0);
+  auto numBuckets = INT_ARG(1);
+
+  REQUIRE_TRUE(tokens->dataType() == sd::DataType::UTF8, 0, "string_ngram_hash: only UTF8 tokens are supported");
+  REQUIRE_TRUE(width > 0, 0, "string_ngram_hash: n-gram width has to be positive, but got %i", width);
+  REQUIRE_TRUE(numBuckets > 0, 0, "string_ngram_hash: number of buckets has to be positive, but got %i", numBuckets);
+  REQUIRE_TRUE(rowSplits == nullptr || rowSplits->isZ(), 0, "string_ngram_hash: row splits have to be integer");
+
+  helpers::stringsNgramHash(block.launchContext(), *tokens, rowSplits, width, numBuckets, *hashes, *outputSplits);
+
+  return sd::Status::OK;
+}
+
+DECLARE_SHAPE_FN(string_ngram_hash) {
+  auto tokens = INPUT_VARIABLE(0);
+  auto rowSplits = block.width() > 1 ? INPUT_VARIABLE(1) : nullptr;
+  auto width = INT_ARG(0);
+
+  auto count = width > 0 ? helpers::stringsCountNgrams(*tokens, rowSplits, width) : 0;
+  auto rows = rowSplits != nullptr ? rowSplits->lengthOf() : 2;
+
+  auto hashesShape = count > 0 ? ConstantShapeHelper::getInstance().vectorShapeInfo(count, sd::DataType::INT64)
+                               : ConstantShapeHelper::getInstance().emptyShapeInfo(sd::DataType::INT64);
+  auto splitsShape = ConstantShapeHelper::getInstance().vectorShapeInfo(rows, sd::DataType::INT64);
+
+  return SHAPELIST(hashesShape, splitsShape);
+}
+
+DECLARE_TYPES(string_ngram_hash) {
+  getOpDescriptor()
+      ->setAllowedInputTypes(0, {ALL_STRINGS})
+      ->setAllowedInputTypes(1, {ALL_INTS})
+      ->setAllowedOutputTypes({ALL_INDICES});
+}
+}  // namespace ops
+}  // namespace sd
+
+#endif
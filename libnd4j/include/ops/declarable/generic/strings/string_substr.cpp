@@ -0,0 +1,58 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Substrings of utf8 strings, positions in bytes or in symbols
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_string_substr)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/strings.h>
+
+namespace sd {
+namespace ops {
+CUSTOM_OP_IMPL(string_substr, 1, 1, false, 0, -2) {
+  auto input = INPUT_VARIABLE(0);
+  auto output = OUTPUT_VARIABLE(0);
+
+  REQUIRE_TRUE(block.numI() >= 1, 0, "string_substr: start position has to be provided");
+  REQUIRE_TRUE(input->dataType() == sd::DataType::UTF8, 0, "string_substr: only UTF8 input is supported");
+
+  auto pos = INT_ARG(0);
+  auto len = block.numI() > 1 ? INT_ARG(1) : -1;
+  auto chars = block.numI() > 2 ? INT_ARG(2) != 0 : false;
+
+  helpers::stringsSubstr(block.launchContext(), *input, pos, len, chars, *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_SHAPE_FN(string_substr) {
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::UTF8, inputShape->at(0)));
+}
+
+DECLARE_TYPES(string_substr) {
+  getOpDescriptor()->setAllowedInputTypes({ALL_STRINGS})->setAllowedOutputTypes({ALL_STRINGS});
+}
+}  // namespace ops
+}  // namespace sd
+
+#endif
@@ -0,0 +1,59 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Maps utf8 strings to hash buckets
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_string_to_hash_bucket)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/strings.h>
+
+namespace sd {
+namespace ops {
+CUSTOM_OP_IMPL(string_to_hash_bucket, 1, 1, false, 0, 1) {
+  auto input = INPUT_VARIABLE(0);
+  auto output = OUTPUT_VARIABLE(0);
+
+  auto numBuckets = INT_ARG(0);
+
+  REQUIRE_TRUE(input->dataType() == sd::DataType::UTF8, 0, "string_to_hash_bucket: only UTF8 input is supported");
+  REQUIRE_TRUE(numBuckets > 0, 0, "string_to_hash_bucket: number of buckets has to be positive, but got %i",
+               numBuckets);
+
+  if (input->isEmpty()) return sd::Status::OK;
+
+  helpers::stringsToHashBucket(block.launchContext(), *input, numBuckets, *output);
+
+  return sd::Status::OK;
+}
+
+DECLARE_SHAPE_FN(string_to_hash_bucket) {
+  return SHAPELIST(ConstantShapeHelper::getInstance().createShapeInfo(sd::DataType::INT64, inputShape->at(0)));
+}
+
+DECLARE_TYPES(string_to_hash_bucket) {
+  getOpDescriptor()->setAllowedInputTypes({ALL_STRINGS})->setAllowedOutputTypes({ALL_INDICES});
+}
+}  // namespace ops
+}  // namespace sd
+
+#endif
@@ -0,0 +1,70 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Splits utf8 strings into tokens without regular expressions
+//
+
+#include <system/op_boilerplate.h>
+#if NOT_EXCLUDED(OP_string_tokenize)
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/strings.h>
+
+namespace sd {
+namespace ops {
+CUSTOM_OP_IMPL(string_tokenize, 1, 2, false, 0, -2) {
+  auto input = INPUT_VARIABLE(0);
+  auto values = OUTPUT_VARIABLE(0);
+  auto rowSplits = OUTPUT_VARIABLE(1);
+
+  auto mode = block.numI() > 0 ? INT_ARG(0) : helpers::TOKENIZE_WHITESPACE;
+
+  REQUIRE_TRUE(input->dataType() == sd::DataType::UTF8, 0, "string_tokenize: only UTF8 input is supported");
+  REQUIRE_TRUE(mode == helpers::TOKENIZE_WHITESPACE || mode == helpers::TOKENIZE_PUNCTUATION, 0,
+               "string_tokenize: mode has to be 0 (whitespace) or 1 (whitespace and punctuation), but got %i", mode);
+
+  helpers::stringsTokenize(block.launchContext(), *input, mode, *values, *rowSplits);
+
+  return sd::Status::OK;
+}
+
+DECLARE_SHAPE_FN(string_tokenize) {
+  auto input = INPUT_VARIABLE(0);
+  auto mode = block.numI() > 0 ? INT_ARG(0) : helpers::TOKENIZE_WHITESPACE;
+
+  auto count = helpers::stringsCountTokens(*input, mode);
+
+  auto valuesShape = count > 0 ? ConstantShapeHelper::getInstance().vectorShapeInfo(count, sd::DataType::UTF8)
+                               : ConstantShapeHelper::getInstance().emptyShapeInfo(sd::DataType::UTF8);
+  auto splitsShape = ConstantShapeHelper::getInstance().vectorShapeInfo(input->lengthOf() + 1, sd::DataType::INT64);
+
+  return SHAPELIST(valuesShape, splitsShape);
+}
+
+DECLARE_TYPES(string_tokenize) {
+  getOpDescriptor()
+      ->setAllowedInputTypes({ALL_STRINGS})
+      ->setAllowedOutputTypes(0, {ALL_STRINGS})
+      ->setAllowedOutputTypes(1, sd::DataType::INT64);
+}
+}  // namespace ops
+}  // namespace sd
+
+#endif
@@ -0,0 +1,111 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Multi-tensor updater: updates many parameter tensors with a single op call
+//
+
+#include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/headers/updaters.h>
+#if NOT_EXCLUDED(OP_multi_tensor_updater)
+namespace sd {
+namespace ops {
+
+CUSTOM_OP_IMPL(multi_tensor_updater, 2, 1, false, 4, 1) {
+  const int type = INT_ARG(0);
+  const int numStates = helpers::multiTensorUpdaterStates(type);
+  REQUIRE_TRUE(numStates >= 0, 0, "MULTI TENSOR UPDATER OP: unknown updater type %i", type);
+  REQUIRE_TRUE(block.width() % (2 + numStates) == 0, 0,
+               "MULTI TENSOR UPDATER OP: expected params, gradients and %i state arrays per tensor, but got %i inputs",
+               numStates, block.width());
+
+  const int n = block.width() / (2 + numStates);
+
+  std::vector<const NDArray*> params(n), gradients(n), initStates(n * numStates);
+  std::vector<NDArray*> updatedParams(n), updatedStates(n * numStates);
+
+  const auto dataType = INPUT_VARIABLE(0)->dataType();
+  for (int t = 0; t < n; t++) {
+    params[t] = INPUT_VARIABLE(t);
+    gradients[t] = INPUT_VARIABLE(n + t);
+    updatedParams[t] = OUTPUT_VARIABLE(t);
+  }
+  for (int s = 0; s < n * numStates; s++) {
+    initStates[s] = INPUT_VARIABLE(2 * n + s);
+    updatedStates[s] = OUTPUT_VARIABLE(n + s);
+  }
+
+  // the kernel walks flat buffers, so every array of a tensor has to be contiguous and alike
+  for (int t = 0; t < n; t++) {
+    std::vector<const NDArray*> group = {params[t], gradients[t], updatedParams[t]};
+    for (int s = 0; s < numStates; s++) {
+      group.push_back(initStates[s * n + t]);
+      group.push_back(updatedStates[s * n + t]);
+    }
+
+    for (auto array : group) {
+      REQUIRE_TRUE(array->dataType() == dataType, 0,
+                   "MULTI TENSOR UPDATER OP: all arrays should have the same data type, tensor %i differs", t);
+      REQUIRE_TRUE(array->isSameShape(params[t]), 0,
+                   "MULTI TENSOR UPDATER OP: gradient and states of tensor %i should have the shape of its params", t);
+      REQUIRE_TRUE(array->ews() == 1 && array->ordering() == params[t]->ordering(), 0,
+                   "MULTI TENSOR UPDATER OP: arrays of tensor %i should be contiguous and have the same ordering", t);
+    }
+  }
+
+  helpers::MultiTensorUpdaterConfig config;
+  config.lr = T_ARG(0);
+  config.beta1 = T_ARG(1);
+  config.beta2 = T_ARG(2);
+  config.epsilon = T_ARG(3);
+  config.weightDecay = block.getTArguments()->size() > 4 ? T_ARG(4) : 0.;
+  config.maxGlobalNorm = block.getTArguments()->size() > 5 ? T_ARG(5) : 0.;
+  config.iteration = block.getIArguments()->size() > 1 ? INT_ARG(1) : 0;
+
+  helpers::updaterMultiTensor(block.launchContext(), type, params, gradients, initStates, updatedParams, updatedStates,
+                              config);
+
+  return sd::Status::OK;
+}
+
+DECLARE_TYPES(multi_tensor_updater) {
+  getOpDescriptor()->setAllowedInputTypes({ALL_FLOATS})->setAllowedOutputTypes({ALL_FLOATS});
+}
+
+// outputs are the params, then the states
+DECLARE_SHAPE_FN(multi_tensor_updater) {
+  const int numStates = helpers::multiTensorUpdaterStates(INT_ARG(0));
+  REQUIRE_TRUE(numStates >= 0 && block.width() % (2 + numStates) == 0, 0,
+               "MULTI TENSOR UPDATER OP: inputs don't match updater type %i", INT_ARG(0));
+
+  const int n = block.width() / (2 + numStates);
+  auto shapes = SHAPELIST();
+  for (int t = 0; t < n; t++)
+    shapes->push_back(ConstantShapeHelper::getInstance().createShapeInfo(ArrayOptions::dataType(inputShape->at(t)),
+                                                                         inputShape->at(t)));
+  for (int s = 0; s < n * numStates; s++)
+    shapes->push_back(ConstantShapeHelper::getInstance().createShapeInfo(
+        ArrayOptions::dataType(inputShape->at(2 * n + s)), inputShape->at(2 * n + s)));
+
+  return shapes;
+}
+
+}  // namespace ops
+}  // namespace sd
+#endif
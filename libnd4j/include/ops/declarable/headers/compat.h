@@ -43,6 +43,7 @@ DECLARE_CUSTOM_OP(compat_string_split, 2, 2, false, 0, 0);
 
 /**
  * This operation converts TF sparse array representation to dense NDArray
+ * If indices repeat, the last value given for an index is kept
  */
 #if NOT_EXCLUDED(OP_compat_sparse_to_dense)
 DECLARE_CUSTOM_OP(compat_sparse_to_dense, 4, 1, false, 0, 0);
@@ -325,6 +325,52 @@ DECLARE_CUSTOM_OP(pointwise_conv2d, 2, 1, false, 0, 0);
 #if NOT_EXCLUDED(OP_deconv2d_tf)
 DECLARE_CUSTOM_OP(deconv2d_tf, 2, 1, false, 0, 0);
 #endif
+
+/**
+ * NCHWc blocked layout: [bS, iC, iH, iW] array is stored as [bS, ceil(iC / b), iH, iW, b],
+ * where b is SD_CHANNEL_BLOCK, and tail channels of the last block are zeros.
+ *
+ * to_nchwc converts 4D array into blocked layout
+ * IntArgs:
+ * 0: data format (optional): 1 NHWC, 0 NCHW (default)
+ *
+ * from_nchwc converts blocked array back
+ * IntArgs:
+ * 0: number of channels
+ * 1: data format (optional): 1 NHWC, 0 NCHW (default)
+ */
+#if NOT_EXCLUDED(OP_to_nchwc)
+DECLARE_CUSTOM_OP(to_nchwc, 1, 1, false, 0, 0);
+#endif
+
+#if NOT_EXCLUDED(OP_from_nchwc)
+DECLARE_CUSTOM_OP(from_nchwc, 1, 1, false, 0, 1);
+#endif
+
+/**
+ * Inference versions of conv2d, maxpool2d, avgpool2d and upsampling2d working in NCHWc layout.
+ * IntArgs are the same as for the original ops, pooling ops and upsampling2d accept number of channels
+ * as the last IntArg (11 and 3 respectively), it's required when input is blocked and output is not.
+ *
+ * BoolArgs:
+ * 0: input is in blocked layout, otherwise it's converted from data format (default false)
+ * 1: output is in blocked layout, otherwise it's converted to data format (default false)
+ */
+#if NOT_EXCLUDED(OP_conv2d_nchwc)
+DECLARE_CUSTOM_OP(conv2d_nchwc, 2, 1, false, 0, 9);
+#endif
+
+#if NOT_EXCLUDED(OP_maxpool2d_nchwc)
+DECLARE_CUSTOM_OP(maxpool2d_nchwc, 1, 1, false, 0, 9);
+#endif
+
+#if NOT_EXCLUDED(OP_avgpool2d_nchwc)
+DECLARE_CUSTOM_OP(avgpool2d_nchwc, 1, 1, false, 0, 10);
+#endif
+
+#if NOT_EXCLUDED(OP_upsampling2d_nchwc)
+DECLARE_CUSTOM_OP(upsampling2d_nchwc, 1, 1, false, 0, 2);
+#endif
 }  // namespace ops
 }  // namespace sd
 
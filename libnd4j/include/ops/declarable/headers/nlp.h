@@ -42,6 +42,55 @@ DECLARE_CONFIGURABLE_OP(cbow, 15, 15, true, 0, 0);
 #if NOT_EXCLUDED(OP_cbow_inference)
 DECLARE_CONFIGURABLE_OP(cbow_inference,6, 6, true, -2, -2);
 #endif
+
+/**
+ * Vocabulary lookup tables. A table is three arrays: integer or UTF8 keys vector, values with a row per key,
+ * and an INT64 [capacity, 2] open addressing index over keys built by hash_table_build. Being plain arrays,
+ * tables are stored within the graph and load with the model.
+ */
+
+/**
+ * This operation builds the index of a table
+ *
+ * Input[0] - keys, repeated keys resolve to the last occurrence
+ * IntArgs[0] - optional number of keys to reserve room for
+ */
+#if NOT_EXCLUDED(OP_hash_table_build)
+DECLARE_CUSTOM_OP(hash_table_build, 1, 1, false, 0, -2);
+#endif
+
+/**
+ * This operation looks queries up in a table
+ *
+ * Input[0] - index
+ * Input[1] - keys
+ * Input[2] - values
+ * Input[3] - queries of the same kind as keys
+ * Input[4] - optional default value for missing queries, scalar or row. Zero if absent
+ * IntArgs[0] - optional number of out of vocabulary buckets. If positive, values have to be integer ids and
+ *              missing queries get ids numKeys + hash % buckets instead of the default value
+ *
+ * Output - shape of queries followed by the row shape of values
+ */
+#if NOT_EXCLUDED(OP_hash_table_lookup)
+DECLARE_CUSTOM_OP(hash_table_lookup, 4, 1, false, 0, -2);
+#endif
+
+/**
+ * This operation inserts keys into a table: values of existing keys are replaced, new keys are appended.
+ * The index is updated in place while its load factor allows and is rebuilt with a larger capacity otherwise
+ *
+ * Input[0] - index
+ * Input[1] - keys
+ * Input[2] - values
+ * Input[3] - new keys
+ * Input[4] - new values
+ *
+ * Output[0..2] - index, keys and values of the updated table
+ */
+#if NOT_EXCLUDED(OP_hash_table_insert)
+DECLARE_CUSTOM_OP(hash_table_insert, 5, 3, false, 0, 0);
+#endif
 }  // namespace ops
 }  // namespace sd
 
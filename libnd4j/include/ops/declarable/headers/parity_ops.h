@@ -847,6 +847,25 @@ DECLARE_CUSTOM_OP(moments, 1, 2, false, 0, -2);
 DECLARE_CUSTOM_OP(embedding_lookup, 2, 1, false, 0, 1);
 #endif
 
+/**
+ * embedding_bag - gathers rows of params and pools them per bag, without materializing the gathered rows
+ *
+ * Input arrays:
+ * 0 - params, [N, ...]
+ * 1 - indices of rows, vector of length L
+ * 2 - offsets, vector of length B: bag b is indices[offsets[b] ... offsets[b + 1]), the last bag ends at L
+ * 3 - optional per sample weights, vector of length L, sum and mean modes only
+ *
+ * Int arguments:
+ * 0 - optional pooling mode: 0 - sum (default), 1 - mean, 2 - max
+ *
+ * Output: [B, ...], empty bags give zeros
+ */
+#if NOT_EXCLUDED(OP_embedding_bag)
+DECLARE_CUSTOM_OP(embedding_bag, 3, 1, false, 0, 0);
+DECLARE_CUSTOM_OP(embedding_bag_bp, 4, 2, false, 0, 0);
+#endif
+
 /**
  * dynamic_partition - partition a input tensor onto num_partitions
  * accordingly to index array given.
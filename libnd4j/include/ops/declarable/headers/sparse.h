@@ -0,0 +1,112 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Sparse matrix operations. CSR matrices are given as three arrays:
+//   rowPointers - [rows + 1], entries of row r are at rowPointers[r] ... rowPointers[r + 1] - 1
+//   columns     - [nnz], column of every entry
+//   values      - [nnz], value of every entry
+//
+
+#ifndef LIBND4J_HEADERS_SPARSE_H
+#define LIBND4J_HEADERS_SPARSE_H
+#include <ops/declarable/headers/common.h>
+
+namespace sd {
+namespace ops {
+
+/**
+ * Converts a dense matrix to CSR, zeros are dropped
+ *
+ * Input:
+ * 0 - dense matrix [rows, cols]
+ *
+ * Output:
+ * 0 - rowPointers, 1 - columns, 2 - values
+ */
+#if NOT_EXCLUDED(OP_dense_to_csr)
+DECLARE_CUSTOM_OP(dense_to_csr, 1, 3, false, 0, 0);
+#endif
+
+/**
+ * Converts COO entries to CSR, entries of every row get ordered by column
+ *
+ * Input:
+ * 0 - indices [nnz, 2], (row, column) of every entry in any order
+ * 1 - values [nnz]
+ * 2 - shape, {rows, cols}
+ *
+ * Output:
+ * 0 - rowPointers, 1 - columns, 2 - values
+ */
+#if NOT_EXCLUDED(OP_coo_to_csr)
+DECLARE_CUSTOM_OP(coo_to_csr, 3, 3, false, 0, 0);
+#endif
+
+/**
+ * Converts CSR to a dense matrix, repeated entries are summed
+ *
+ * Input:
+ * 0 - rowPointers, 1 - columns, 2 - values
+ * 3 - shape, {rows, cols}
+ */
+#if NOT_EXCLUDED(OP_csr_to_dense)
+DECLARE_CUSTOM_OP(csr_to_dense, 4, 1, false, 0, 0);
+#endif
+
+/**
+ * Sparse x dense product: SpMV for a vector operand, SpMM for a matrix
+ *
+ * Input:
+ * 0 - rowPointers, 1 - columns, 2 - values
+ * 3 - dense [cols] or [cols, k]
+ *
+ * Output: [rows] or [rows, k]
+ */
+#if NOT_EXCLUDED(OP_csr_matmul)
+DECLARE_CUSTOM_OP(csr_matmul, 4, 1, false, 0, 0);
+#endif
+
+/**
+ * Elementwise product of a CSR matrix and a dense matrix of the same shape. The result has the
+ * structure of the sparse operand, so only its values are returned.
+ *
+ * Input:
+ * 0 - rowPointers, 1 - columns, 2 - values
+ * 3 - dense [rows, cols]
+ */
+#if NOT_EXCLUDED(OP_csr_multiply_dense)
+DECLARE_CUSTOM_OP(csr_multiply_dense, 4, 1, false, 0, 0);
+#endif
+
+/**
+ * Elementwise sum of a CSR matrix and a dense matrix of the same shape, the result is dense
+ *
+ * Input:
+ * 0 - rowPointers, 1 - columns, 2 - values
+ * 3 - dense [rows, cols]
+ */
+#if NOT_EXCLUDED(OP_csr_add_dense)
+DECLARE_CUSTOM_OP(csr_add_dense, 4, 1, false, 0, 0);
+#endif
+
+}  // namespace ops
+}  // namespace sd
+
+#endif  // LIBND4J_HEADERS_SPARSE_H
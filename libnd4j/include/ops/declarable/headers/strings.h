@@ -36,6 +36,76 @@ namespace ops {
 DECLARE_CUSTOM_OP(split_string, 2, 1, true, 0, 0);
 #endif
 
+/**
+ * This operation returns lowercase copy of utf8 strings, symbols without a lowercase form of the
+ * same encoded length are kept as is
+ *
+ * Input[0] - strings
+ */
+#if NOT_EXCLUDED(OP_string_lower)
+DECLARE_CUSTOM_OP(string_lower, 1, 1, false, 0, 0);
+#endif
+
+/**
+ * This operation splits utf8 strings into tokens
+ *
+ * Input[0] - strings
+ * IntArgs[0] - optional mode: 0 (default) splits on whitespace, 1 also makes every ascii punctuation symbol a token
+ *
+ * Output[0] - vector of all tokens
+ * Output[1] - row splits: tokens of string i are Output[0][splits[i]] ... Output[0][splits[i + 1] - 1]
+ */
+#if NOT_EXCLUDED(OP_string_tokenize)
+DECLARE_CUSTOM_OP(string_tokenize, 1, 2, false, 0, -2);
+#endif
+
+/**
+ * This operation hashes n-grams of consecutive tokens into buckets
+ *
+ * Input[0] - vector of tokens
+ * Input[1] - optional row splits, as produced by string_tokenize. N-grams don't cross rows
+ * IntArgs[0] - n-gram width
+ * IntArgs[1] - number of buckets
+ *
+ * Output[0] - bucket of every n-gram
+ * Output[1] - row splits of n-grams
+ */
+#if NOT_EXCLUDED(OP_string_ngram_hash)
+DECLARE_CUSTOM_OP(string_ngram_hash, 1, 2, false, 0, 2);
+#endif
+
+/**
+ * This operation maps utf8 strings to hash buckets
+ *
+ * Input[0] - strings
+ * IntArgs[0] - number of buckets
+ */
+#if NOT_EXCLUDED(OP_string_to_hash_bucket)
+DECLARE_CUSTOM_OP(string_to_hash_bucket, 1, 1, false, 0, 1);
+#endif
+
+/**
+ * This operation joins utf8 strings along the last dimension
+ *
+ * Input[0] - strings
+ * Input[1] - optional scalar separator
+ */
+#if NOT_EXCLUDED(OP_string_join)
+DECLARE_CUSTOM_OP(string_join, 1, 1, false, 0, 0);
+#endif
+
+/**
+ * This operation returns substrings of utf8 strings, positions are clamped to string bounds
+ *
+ * Input[0] - strings
+ * IntArgs[0] - start position, negative counts from the end
+ * IntArgs[1] - optional length, negative (default) means till the end
+ * IntArgs[2] - optional unit: 0 (default) - bytes, 1 - symbols
+ */
+#if NOT_EXCLUDED(OP_string_substr)
+DECLARE_CUSTOM_OP(string_substr, 1, 1, false, 0, -2);
+#endif
+
 }  // namespace ops
 }  // namespace sd
 
@@ -227,6 +227,30 @@ DECLARE_CONFIGURABLE_OP(nadam_updater, 3, 3, true, 0, 0);
 #if NOT_EXCLUDED(OP_ams_grad_updater)
 DECLARE_CONFIGURABLE_OP(ams_grad_updater, 4, 4, true, 0, 0);
 #endif
+// Multi-tensor updater: updates the params of many tensors (or of one flat parameter arena) in a single
+// parallel pass, with optional gradient clipping by global norm and decoupled weight decay.
+// Params are updated directly: param -= update + lr * weightDecay * param
+/* Input arrays, for n tensors:
+ *  0 ... n-1       - params
+ *  n ... 2n-1      - gradients
+ *  2n ...          - states, state-major: first state of every tensor, then the second one...
+ *                    sgd: none, nesterovs: V, rms prop: G, adam: U, M, nadam: V, M, ams grad: V, M, H
+ * T args
+ * 0 - learning rate
+ * 1 - beta 1 (momentum for nesterovs, decay for rms prop)
+ * 2 - beta 2
+ * 3 - epsilon
+ * 4 - optional weight decay, 0 by default
+ * 5 - optional max global norm of gradients, 0 (no clipping) by default
+ * I args
+ * 0 - updater: 0 - sgd, 1 - nesterovs, 2 - rms prop, 3 - adam, 4 - nadam, 5 - ams grad
+ * 1 - optional iteration
+ * Output arrays: updated params followed by updated states. The op isn't inplace since outputs don't line up
+ * with inputs, but the input params and states may be passed as outputs to update them in place
+ */
+#if NOT_EXCLUDED(OP_multi_tensor_updater)
+DECLARE_CUSTOM_OP(multi_tensor_updater, 2, 1, false, 4, 1);
+#endif
 }  // namespace ops
 }  // namespace sd
 
@@ -36,6 +36,14 @@ SD_LIB_HIDDEN void softmax(sd::LaunchContext *context, const NDArray &input, NDA
 
 SD_LIB_HIDDEN void logSoftmax(sd::LaunchContext *context, const NDArray &input, NDArray &output, const int dimension);
 
+// gradient of softmax along dimension: gradI = softmax(input) * (gradO - sum(softmax(input) * gradO))
+SD_LIB_HIDDEN void softmaxBp(sd::LaunchContext *context, const NDArray &input, const NDArray &gradO, NDArray &gradI,
+                             const int dimension);
+
+// gradient of log_softmax along dimension: gradI = gradO - softmax(input) * sum(gradO)
+SD_LIB_HIDDEN void logSoftmaxBp(sd::LaunchContext *context, const NDArray &input, const NDArray &gradO,
+                                NDArray &gradI, const int dimension);
+
 SD_LIB_HIDDEN void softmaxDerivative(sd::LaunchContext *context, const NDArray &input, NDArray &output,
                                      const int dimension);
 
@@ -29,6 +29,13 @@
 namespace sd {
 namespace ops {
 
+// channel block of NCHWc layout, matches SIMD register width in floats
+#if defined(__AVX512F__)
+#define SD_CHANNEL_BLOCK 16
+#else
+#define SD_CHANNEL_BLOCK 8
+#endif
+
 enum PoolingType {
   MAX_POOL = 0,
   AVG_POOL = 1,
@@ -377,6 +384,29 @@ class SD_LIB_HIDDEN ConvolutionUtils {
                           const int kD, const int kH, const int kW, const int sD, const int sH, const int sW,
                           const int pD, const int pH, const int pW, const int dD, const int dH, const int dW,
                           const int poolingMode, const int extraParam0);
+
+  // NCHWc blocked layout: [bS, iC, iH, iW] is stored as [bS, ceil(iC / b), iH, iW, b], b = SD_CHANNEL_BLOCK,
+  // tail channels of last block are zero
+  static inline sd::LongType blockedChannels(const sd::LongType numChannels) {
+    return (numChannels + SD_CHANNEL_BLOCK - 1) / SD_CHANNEL_BLOCK;
+  }
+
+  static void toBlockedChannels(sd::graph::Context& block, const NDArray& input, NDArray& output, const bool isNCHW);
+
+  static void fromBlockedChannels(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                  const bool isNCHW);
+
+  static void conv2dBlocked(sd::graph::Context& block, const NDArray& input, const NDArray& weights,
+                            const NDArray* bias, NDArray& output, const int kH, const int kW, const int sH,
+                            const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode,
+                            const int wFormat);
+
+  static void pooling2dBlocked(sd::graph::Context& block, const NDArray& input, NDArray& output, const int kH,
+                               const int kW, const int sH, const int sW, const int pH, const int pW, const int dH,
+                               const int dW, const PoolingType poolingMode, const int extraParam0);
+
+  static void upsampling2dBlocked(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                  const int factorH, const int factorW);
 };
 
 }  // namespace ops
@@ -211,25 +211,6 @@ void thresholdReluDerivative(sd::LaunchContext* context, NDArray* input, double
                         SD_FLOAT_TYPES);
 }
 
-///////////////////////////////////////////////////////////////////
-void logSoftmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  const int rank = input.rankOf();
-
-  if (input.isVector()) {
-    if (rank == 1 || input.sizeAt(dimension) != 1) {
-      BUILD_SINGLE_SELECTOR(input.dataType(), logSoftMaxForVector_,
-                            (input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo()), SD_FLOAT_TYPES);
-    } else
-      output = 0.;
-  } else {
-    auto maxAlongDim = const_cast<NDArray&>(input).reduceAlongDimension(reduce::Max, {dimension}, true);
-    (input - maxAlongDim).applyTransform(transform::Exp, output);  // output contains exponents temporarily
-    auto sumAlongDim = output.reduceAlongDimension(reduce::Sum, {dimension}, true);
-    output /= sumAlongDim;
-    output.applyTransform(transform::Log, output);
-  }
-}
-
 BUILD_SINGLE_TEMPLATE(template void thresholdReluDerivative_,
                       (sd::LaunchContext * context, NDArray* input, double threshold, NDArray* dLdO, NDArray* output),
                       SD_FLOAT_TYPES);
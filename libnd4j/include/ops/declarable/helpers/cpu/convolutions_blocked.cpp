@@ -0,0 +1,394 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// NCHWc (channel-blocked) layout helpers
+//
+#include <execution/Threads.h>
+#include <ops/declarable/helpers/convolutions.h>
+
+#include <vector>
+
+namespace sd {
+namespace ops {
+
+// blocked arrays are always processed as dense c-ordered buffers
+static SD_INLINE bool isDense(const NDArray& array) { return array.ordering() == 'c' && array.ews() == 1; }
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void toBlockedChannels_(const NDArray& input, NDArray& output, const bool isNCHW) {
+  // input  [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)
+  // output [bS, iCb, iH, iW, b]
+
+  const int dimIC = isNCHW ? 1 : 3;
+  const int dimIH = isNCHW ? 2 : 1;
+
+  const sd::LongType bS = input.sizeAt(0);
+  const sd::LongType iC = input.sizeAt(dimIC);
+  const sd::LongType iH = input.sizeAt(dimIH);
+  const sd::LongType iW = input.sizeAt(dimIH + 1);
+  const sd::LongType iCb = output.sizeAt(1);
+
+  const sd::LongType xStride0 = input.strideAt(0);
+  const sd::LongType xStride1 = input.strideAt(dimIC);
+  const sd::LongType xStride2 = input.strideAt(dimIH);
+  const sd::LongType xStride3 = input.strideAt(dimIH + 1);
+
+  const T* x = input.bufferAsT<T>();
+  T* z = output.bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR_3D {
+    for (auto b = start_x; b < stop_x; b += inc_x) {
+      for (auto cb = start_y; cb < stop_y; cb += inc_y) {
+        for (auto h = start_z; h < stop_z; h += inc_z) {
+          T* pZ = z + ((b * iCb + cb) * iH + h) * iW * SD_CHANNEL_BLOCK;
+          const T* pX = x + b * xStride0 + h * xStride2;
+
+          for (sd::LongType w = 0; w < iW; ++w) {
+            for (sd::LongType l = 0; l < SD_CHANNEL_BLOCK; ++l) {
+              const auto c = cb * SD_CHANNEL_BLOCK + l;
+              pZ[w * SD_CHANNEL_BLOCK + l] = c < iC ? pX[c * xStride1 + w * xStride3] : static_cast<T>(0);
+            }
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, bS, 1, 0, iCb, 1, 0, iH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void fromBlockedChannels_(const NDArray& input, NDArray& output, const bool isNCHW) {
+  // input  [bS, iCb, iH, iW, b]
+  // output [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)
+
+  const int dimIC = isNCHW ? 1 : 3;
+  const int dimIH = isNCHW ? 2 : 1;
+
+  const sd::LongType bS = output.sizeAt(0);
+  const sd::LongType iC = output.sizeAt(dimIC);
+  const sd::LongType iH = output.sizeAt(dimIH);
+  const sd::LongType iW = output.sizeAt(dimIH + 1);
+  const sd::LongType iCb = input.sizeAt(1);
+
+  const sd::LongType zStride0 = output.strideAt(0);
+  const sd::LongType zStride1 = output.strideAt(dimIC);
+  const sd::LongType zStride2 = output.strideAt(dimIH);
+  const sd::LongType zStride3 = output.strideAt(dimIH + 1);
+
+  const T* x = input.bufferAsT<T>();
+  T* z = output.bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR_3D {
+    for (auto b = start_x; b < stop_x; b += inc_x) {
+      for (auto c = start_y; c < stop_y; c += inc_y) {
+        for (auto h = start_z; h < stop_z; h += inc_z) {
+          const T* pX = x + ((b * iCb + c / SD_CHANNEL_BLOCK) * iH + h) * iW * SD_CHANNEL_BLOCK + c % SD_CHANNEL_BLOCK;
+          T* pZ = z + b * zStride0 + c * zStride1 + h * zStride2;
+
+          for (sd::LongType w = 0; w < iW; ++w) pZ[w * zStride3] = pX[w * SD_CHANNEL_BLOCK];
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, bS, 1, 0, iC, 1, 0, iH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void conv2dBlocked_(const NDArray& input, const NDArray& w, const NDArray* bias, NDArray& output,
+                           const int kH, const int kW, const int sH, const int sW, const int pH, const int pW,
+                           const int dH, const int dW) {
+  // input   [bS, iCb, iH, iW, b]
+  // w       [kH, kW, iC, oC]
+  // bias    [oC]
+  // output  [bS, oCb, oH, oW, b]
+
+  const sd::LongType bS = input.sizeAt(0);
+  const sd::LongType iCb = input.sizeAt(1);
+  const sd::LongType iH = input.sizeAt(2);
+  const sd::LongType iW = input.sizeAt(3);
+  const sd::LongType oCb = output.sizeAt(1);
+  const sd::LongType oH = output.sizeAt(2);
+  const sd::LongType oW = output.sizeAt(3);
+  const sd::LongType iCp = iCb * SD_CHANNEL_BLOCK;
+
+  const sd::LongType iC = w.sizeAt(2);
+  const sd::LongType oC = w.sizeAt(3);
+
+  // repack weights into [oCb, kH, kW, iCp, b] so that inner loop reads one contiguous block of output channels
+  std::vector<T> packed(oCb * kH * kW * iCp * SD_CHANNEL_BLOCK, static_cast<T>(0));
+  std::vector<T> packedBias(oCb * SD_CHANNEL_BLOCK, static_cast<T>(0));
+
+  const T* pW0 = w.bufferAsT<T>();
+  for (sd::LongType kh = 0; kh < kH; ++kh)
+    for (sd::LongType kw = 0; kw < kW; ++kw)
+      for (sd::LongType ic = 0; ic < iC; ++ic)
+        for (sd::LongType oc = 0; oc < oC; ++oc)
+          packed[((((oc / SD_CHANNEL_BLOCK) * kH + kh) * kW + kw) * iCp + ic) * SD_CHANNEL_BLOCK +
+                 oc % SD_CHANNEL_BLOCK] =
+              pW0[kh * w.strideAt(0) + kw * w.strideAt(1) + ic * w.strideAt(2) + oc * w.strideAt(3)];
+
+  if (bias != nullptr)
+    for (sd::LongType oc = 0; oc < oC; ++oc) packedBias[oc] = bias->e<T>(oc);
+
+  const T* x = input.bufferAsT<T>();
+  const T* wp = packed.data();
+  const T* bp = packedBias.data();
+  T* z = output.bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR_3D {
+    T sum[SD_CHANNEL_BLOCK];
+
+    for (auto b = start_x; b < stop_x; b += inc_x) {
+      for (auto ocb = start_y; ocb < stop_y; ocb += inc_y) {
+        for (auto oh = start_z; oh < stop_z; oh += inc_z) {
+          for (sd::LongType ow = 0; ow < oW; ++ow) {
+            for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) sum[l] = bp[ocb * SD_CHANNEL_BLOCK + l];
+
+            for (sd::LongType kh = 0; kh < kH; ++kh) {
+              const sd::LongType ih = oh * sH - pH + kh * dH;
+              if (ih < 0 || ih >= iH) continue;
+
+              for (sd::LongType kw = 0; kw < kW; ++kw) {
+                const sd::LongType iw = ow * sW - pW + kw * dW;
+                if (iw < 0 || iw >= iW) continue;
+
+                const T* pX = x + ((b * iCb * iH + ih) * iW + iw) * SD_CHANNEL_BLOCK;
+                const T* pWk = wp + ((ocb * kH + kh) * kW + kw) * iCp * SD_CHANNEL_BLOCK;
+
+                for (sd::LongType ic = 0; ic < iCp; ++ic) {
+                  const T v = pX[(ic / SD_CHANNEL_BLOCK) * iH * iW * SD_CHANNEL_BLOCK + ic % SD_CHANNEL_BLOCK];
+                  const T* pWc = pWk + ic * SD_CHANNEL_BLOCK;
+
+                  PRAGMA_OMP_SIMD
+                  for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) sum[l] += v * pWc[l];
+                }
+              }
+            }
+
+            T* pZ = z + (((b * oCb + ocb) * oH + oh) * oW + ow) * SD_CHANNEL_BLOCK;
+            for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) pZ[l] = sum[l];
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, bS, 1, 0, oCb, 1, 0, oH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void pooling2dBlocked_(const NDArray& input, NDArray& output, const int kH, const int kW, const int sH,
+                              const int sW, const int pH, const int pW, const int dH, const int dW,
+                              const PoolingType poolingMode, const int extraParam0) {
+  // input  [bS, iCb, iH, iW, b]
+  // output [bS, iCb, oH, oW, b]
+
+  const sd::LongType bS = input.sizeAt(0);
+  const sd::LongType iCb = input.sizeAt(1);
+  const sd::LongType iH = input.sizeAt(2);
+  const sd::LongType iW = input.sizeAt(3);
+  const sd::LongType oH = output.sizeAt(2);
+  const sd::LongType oW = output.sizeAt(3);
+
+  const T* x = input.bufferAsT<T>();
+  T* z = output.bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR_3D {
+    T acc[SD_CHANNEL_BLOCK];
+
+    for (auto b = start_x; b < stop_x; b += inc_x) {
+      for (auto cb = start_y; cb < stop_y; cb += inc_y) {
+        for (auto oh = start_z; oh < stop_z; oh += inc_z) {
+          const T* pX = x + (b * iCb + cb) * iH * iW * SD_CHANNEL_BLOCK;
+
+          for (sd::LongType ow = 0; ow < oW; ++ow) {
+            const T init = poolingMode == MAX_POOL ? -DataTypeUtils::infOrMax<T>() : static_cast<T>(0);
+            for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) acc[l] = init;
+
+            int cnt = 0;
+            for (sd::LongType kh = 0; kh < kH; ++kh) {
+              const sd::LongType ih = oh * sH - pH + kh * dH;
+              if (ih < 0 || ih >= iH) continue;
+
+              for (sd::LongType kw = 0; kw < kW; ++kw) {
+                const sd::LongType iw = ow * sW - pW + kw * dW;
+                if (iw < 0 || iw >= iW) continue;
+
+                const T* pXw = pX + (ih * iW + iw) * SD_CHANNEL_BLOCK;
+                if (poolingMode == MAX_POOL) {
+                  PRAGMA_OMP_SIMD
+                  for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) acc[l] = sd::math::sd_max<T>(acc[l], pXw[l]);
+                } else {
+                  PRAGMA_OMP_SIMD
+                  for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) acc[l] += pXw[l];
+                }
+                ++cnt;
+              }
+            }
+
+            if (poolingMode == AVG_POOL) {
+              // 0 - exclude padding, 1 - include padding
+              const T divisor = static_cast<T>(extraParam0 == 0 ? sd::math::sd_max<int>(cnt, 1) : kH * kW);
+              for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) acc[l] /= divisor;
+            } else if (cnt == 0) {
+              for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) acc[l] = static_cast<T>(0);
+            }
+
+            T* pZ = z + (((b * iCb + cb) * oH + oh) * oW + ow) * SD_CHANNEL_BLOCK;
+            for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) pZ[l] = acc[l];
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, bS, 1, 0, iCb, 1, 0, oH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void upsampling2dBlocked_(const NDArray& input, NDArray& output, const int factorH, const int factorW) {
+  // input  [bS, iCb, iH, iW, b]
+  // output [bS, iCb, factorH*iH, factorW*iW, b]
+
+  const sd::LongType bS = input.sizeAt(0);
+  const sd::LongType iCb = input.sizeAt(1);
+  const sd::LongType iH = input.sizeAt(2);
+  const sd::LongType iW = input.sizeAt(3);
+  const sd::LongType oH = output.sizeAt(2);
+  const sd::LongType oW = output.sizeAt(3);
+
+  const T* x = input.bufferAsT<T>();
+  T* z = output.bufferAsT<T>();
+
+  auto func = PRAGMA_THREADS_FOR_3D {
+    for (auto b = start_x; b < stop_x; b += inc_x) {
+      for (auto cb = start_y; cb < stop_y; cb += inc_y) {
+        for (auto oh = start_z; oh < stop_z; oh += inc_z) {
+          const T* pX = x + (((b * iCb + cb) * iH + oh / factorH) * iW) * SD_CHANNEL_BLOCK;
+          T* pZ = z + (((b * iCb + cb) * oH + oh) * oW) * SD_CHANNEL_BLOCK;
+
+          for (sd::LongType ow = 0; ow < oW; ++ow) {
+            const T* pXw = pX + (ow / factorW) * SD_CHANNEL_BLOCK;
+
+            PRAGMA_OMP_SIMD
+            for (int l = 0; l < SD_CHANNEL_BLOCK; ++l) pZ[ow * SD_CHANNEL_BLOCK + l] = pXw[l];
+          }
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, bS, 1, 0, iCb, 1, 0, oH, 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::toBlockedChannels(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                         const bool isNCHW) {
+  NDArray* z = isDense(output) ? &output : new NDArray(output.ulike());
+
+  BUILD_SINGLE_SELECTOR(input.dataType(), toBlockedChannels_, (input, *z, isNCHW), SD_COMMON_TYPES);
+
+  if (z != &output) {
+    output.assign(z);
+    delete z;
+  }
+}
+
+void ConvolutionUtils::fromBlockedChannels(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                           const bool isNCHW) {
+  const NDArray* x = isDense(input) ? &input : new NDArray(input.dup('c'));
+
+  BUILD_SINGLE_SELECTOR(output.dataType(), fromBlockedChannels_, (*x, output, isNCHW), SD_COMMON_TYPES);
+
+  if (x != &input) delete x;
+}
+
+void ConvolutionUtils::conv2dBlocked(sd::graph::Context& block, const NDArray& input, const NDArray& weights,
+                                     const NDArray* bias, NDArray& output, const int kH, const int kW, const int sH,
+                                     const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode,
+                                     const int wFormat) {
+  ConvolutionUtils::calcPadding2D(pH, pW, output.sizeAt(2), output.sizeAt(3), input.sizeAt(2), input.sizeAt(3), kH, kW,
+                                  sH, sW, dH, dW, paddingMode);
+
+  const NDArray* x = isDense(input) ? &input : new NDArray(input.dup('c'));
+  NDArray* z = isDense(output) ? &output : new NDArray(output.ulike());
+
+  // weights [kH, kW, iC, oC], [oC, iC, kH, kW], [oC, kH, kW, iC] -> [kH, kW, iC, oC]
+  std::vector<int> permut = {0, 1, 2, 3};
+  if (1 == wFormat)
+    permut = {2, 3, 1, 0};
+  else if (2 == wFormat)
+    permut = {1, 2, 3, 0};
+
+  NDArray w = weights.permute(permut);
+  if (w.dataType() != input.dataType()) w = w.cast(input.dataType());
+
+  BUILD_SINGLE_SELECTOR(input.dataType(), conv2dBlocked_, (*x, w, bias, *z, kH, kW, sH, sW, pH, pW, dH, dW),
+                        SD_FLOAT_TYPES);
+
+  if (x != &input) delete x;
+
+  if (z != &output) {
+    output.assign(z);
+    delete z;
+  }
+}
+
+void ConvolutionUtils::pooling2dBlocked(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                        const int kH, const int kW, const int sH, const int sW, const int pH,
+                                        const int pW, const int dH, const int dW, const PoolingType poolingMode,
+                                        const int extraParam0) {
+  const NDArray* x = isDense(input) ? &input : new NDArray(input.dup('c'));
+  NDArray* z = isDense(output) ? &output : new NDArray(output.ulike());
+
+  BUILD_SINGLE_SELECTOR(input.dataType(), pooling2dBlocked_,
+                        (*x, *z, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0), SD_FLOAT_TYPES);
+
+  if (x != &input) delete x;
+
+  if (z != &output) {
+    output.assign(z);
+    delete z;
+  }
+}
+
+void ConvolutionUtils::upsampling2dBlocked(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                           const int factorH, const int factorW) {
+  const NDArray* x = isDense(input) ? &input : new NDArray(input.dup('c'));
+  NDArray* z = isDense(output) ? &output : new NDArray(output.ulike());
+
+  BUILD_SINGLE_SELECTOR(input.dataType(), upsampling2dBlocked_, (*x, *z, factorH, factorW), SD_FLOAT_TYPES);
+
+  if (x != &input) delete x;
+
+  if (z != &output) {
+    output.assign(z);
+    delete z;
+  }
+}
+
+}  // namespace ops
+}  // namespace sd
@@ -25,6 +25,7 @@
 #include <ops/declarable/helpers/addBias.h>
 #include <ops/declarable/helpers/col2im.h>
 #include <ops/declarable/helpers/convolutions.h>
+#include <ops/declarable/helpers/epilogue.h>
 #include <ops/declarable/helpers/im2col.h>
 #if NOT_EXCLUDED(OP_col2im) && NOT_EXCLUDED(OP_im2col)
 
@@ -94,12 +95,23 @@ static void conv2d_(sd::graph::Context& block, const NDArray* input, const NDArr
     mmulResult.reshapei({bS, oH, oW, oC});
     mmulResult.permutei(permutForOutput);
   }
-  output->assign(mmulResult);
-
-  //----- add biases if required -----//
-  if (bias)
-    // output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
-    helpers::addBias(block, *output, *bias, *output, isNCHW);
+  if (block.fusedActivation() != graph::FUSED_NONE) {
+    //----- assign, add biases and apply fused activation in one pass -----//
+    if (isNCHW)
+      helpers::fusedEpilogue(ctx, mmulResult, bias, *output, indIOioC, block.fusedActivation(),
+                             block.fusedActivationAlpha());
+    else
+      helpers::fusedEpilogue(ctx, mmulResult.reshape('c', {bS, oH, oW, oC}, false), bias, *output, indIOioC,
+                             block.fusedActivation(), block.fusedActivationAlpha());
+    block.markFusedActivationApplied(true);
+  } else {
+    output->assign(mmulResult);
+
+    //----- add biases if required -----//
+    if (bias)
+      // output->applyBroadcast(broadcast::Add, {indIOioC}, bias);
+      helpers::addBias(block, *output, *bias, *output, isNCHW);
+  }
 
   if (!isNCHW) delete input;
 }
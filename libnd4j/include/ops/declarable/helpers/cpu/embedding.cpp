@@ -0,0 +1,227 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Embedding gathers. Rows are copied (or pooled) straight from params into the output, the rows
+// of upcoming indices are prefetched since lookups into large tables mostly miss the cache.
+//
+#include <execution/Threads.h>
+#include <ops/declarable/helpers/cpu/normalization.hpp>
+#include <ops/declarable/helpers/embedding.h>
+
+#include <cstring>
+#include <limits>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// how many indices ahead the rows are prefetched
+constexpr sd::LongType kEmbeddingPrefetchDistance = 8;
+// at most that many bytes of a row are prefetched
+constexpr sd::LongType kEmbeddingPrefetchBytes = 512;
+
+SD_INLINE void prefetchRow(const void* row, sd::LongType bytes) {
+#if defined(__GNUC__) || defined(__clang__)
+  auto p = reinterpret_cast<const char*>(row);
+  const auto limit = bytes < kEmbeddingPrefetchBytes ? bytes : kEmbeddingPrefetchBytes;
+  for (sd::LongType b = 0; b < limit; b += 64) __builtin_prefetch(p + b, 0, 1);
+#endif
+}
+
+// dense c-ordered int64 copy of indices, unless they are such already
+static const sd::LongType* denseIndices(const NDArray& indices, std::unique_ptr<NDArray>& holder) {
+  if (indices.dataType() == sd::DataType::INT64 && isDenseC(indices)) return indices.bufferAsT<sd::LongType>();
+
+  holder.reset(new NDArray('c', indices.getShapeAsVector(), sd::DataType::INT64, indices.getContext()));
+  holder->assign(indices);
+  return holder->bufferAsT<sd::LongType>();
+}
+
+static SD_INLINE sd::LongType rowLengthOf(const NDArray& params) {
+  return params.sizeAt(0) > 0 ? params.lengthOf() / params.sizeAt(0) : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+void embeddingLookup(sd::LaunchContext* context, const NDArray& params, const NDArray& indices, NDArray& output) {
+  if (output.isEmpty() || indices.lengthOf() == 0) return;
+
+  std::unique_ptr<NDArray> paramsHolder, outputHolder, indicesHolder;
+  auto src = reinterpret_cast<const int8_t*>(denseInput(params, paramsHolder)->buffer());
+  auto out = denseOutput(output, outputHolder);
+  auto dst = reinterpret_cast<int8_t*>(out->buffer());
+  auto idx = denseIndices(indices, indicesHolder);
+
+  // rows are copied bytewise, the element type doesn't matter
+  const auto rowBytes = rowLengthOf(params) * static_cast<sd::LongType>(params.sizeOfT());
+  const auto numIndices = indices.lengthOf();
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto i = start; i < stop; i++) {
+      if (i + kEmbeddingPrefetchDistance < stop) prefetchRow(src + idx[i + kEmbeddingPrefetchDistance] * rowBytes, rowBytes);
+
+      std::memcpy(dst + i * rowBytes, src + idx[i] * rowBytes, rowBytes);
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numIndices);
+
+  flushDenseOutput(output, outputHolder);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void embeddingBag_(const NDArray& params, const NDArray& indices, const NDArray& offsets,
+                          const NDArray* weights, const int mode, NDArray& output) {
+  typedef NormAccumulator<T> A;
+
+  std::unique_ptr<NDArray> paramsHolder, weightsHolder, outputHolder, indicesHolder, offsetsHolder;
+  const T* src = denseInput(params, paramsHolder)->bufferAsT<T>();
+  const T* w = weights != nullptr ? denseInput(*weights, weightsHolder)->bufferAsT<T>() : nullptr;
+  T* dst = denseOutput(output, outputHolder)->bufferAsT<T>();
+  auto idx = denseIndices(indices, indicesHolder);
+  auto off = denseIndices(offsets, offsetsHolder);
+
+  const auto rowLength = rowLengthOf(params);
+  const auto numIndices = indices.lengthOf();
+  const auto numBags = offsets.lengthOf();
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<A> acc(rowLength);
+    for (auto b = start; b < stop; b++) {
+      const auto first = off[b];
+      const auto last = b + 1 < numBags ? off[b + 1] : numIndices;
+      T* zr = dst + b * rowLength;
+
+      if (last <= first) {
+        std::fill(zr, zr + rowLength, static_cast<T>(0));
+        continue;
+      }
+
+      std::fill(acc.begin(), acc.end(),
+                mode == EMBEDDING_BAG_MAX ? -std::numeric_limits<A>::infinity() : static_cast<A>(0));
+      A* a = acc.data();
+
+      for (auto j = first; j < last; j++) {
+        if (j + kEmbeddingPrefetchDistance < last)
+          prefetchRow(src + idx[j + kEmbeddingPrefetchDistance] * rowLength, rowLength * sizeof(T));
+
+        const T* xr = src + idx[j] * rowLength;
+        if (mode == EMBEDDING_BAG_MAX) {
+          PRAGMA_OMP_SIMD
+          for (sd::LongType k = 0; k < rowLength; k++) {
+            const A v = static_cast<A>(xr[k]);
+            a[k] = v > a[k] ? v : a[k];
+          }
+        } else {
+          const A scale = w != nullptr ? static_cast<A>(w[j]) : static_cast<A>(1);
+          PRAGMA_OMP_SIMD
+          for (sd::LongType k = 0; k < rowLength; k++) a[k] += scale * static_cast<A>(xr[k]);
+        }
+      }
+
+      const A norm = mode == EMBEDDING_BAG_MEAN ? static_cast<A>(1) / static_cast<A>(last - first) : static_cast<A>(1);
+      PRAGMA_OMP_SIMD
+      for (sd::LongType k = 0; k < rowLength; k++) zr[k] = static_cast<T>(a[k] * norm);
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numBags);
+
+  flushDenseOutput(output, outputHolder);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void embeddingBagBp_(const NDArray& params, const NDArray& indices, const NDArray& offsets,
+                            const NDArray* weights, const NDArray& gradO, const int mode, NDArray& gradRows) {
+  typedef NormAccumulator<T> A;
+
+  std::unique_ptr<NDArray> paramsHolder, weightsHolder, gradOHolder, gradRowsHolder, indicesHolder, offsetsHolder;
+  const T* src = denseInput(params, paramsHolder)->bufferAsT<T>();
+  const T* w = weights != nullptr ? denseInput(*weights, weightsHolder)->bufferAsT<T>() : nullptr;
+  const T* g = denseInput(gradO, gradOHolder)->bufferAsT<T>();
+  T* dst = denseOutput(gradRows, gradRowsHolder)->bufferAsT<T>();
+  auto idx = denseIndices(indices, indicesHolder);
+  auto off = denseIndices(offsets, offsetsHolder);
+
+  const auto rowLength = rowLengthOf(params);
+  const auto numIndices = indices.lengthOf();
+  const auto numBags = offsets.lengthOf();
+
+  // indices before the first bag don't belong to any bag
+  if (numBags > 0 && off[0] > 0) std::fill(dst, dst + off[0] * rowLength, static_cast<T>(0));
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<sd::LongType> winner;
+    if (mode == EMBEDDING_BAG_MAX) winner.resize(rowLength);
+
+    for (auto b = start; b < stop; b++) {
+      const auto first = off[b];
+      const auto last = b + 1 < numBags ? off[b + 1] : numIndices;
+      if (last <= first) continue;
+
+      const T* gr = g + b * rowLength;
+
+      if (mode == EMBEDDING_BAG_MAX) {
+        // the gradient goes to the first row holding the maximum, like the forward pass keeps it
+        std::fill(winner.begin(), winner.end(), first);
+        for (auto j = first + 1; j < last; j++) {
+          const T* xr = src + idx[j] * rowLength;
+          for (sd::LongType k = 0; k < rowLength; k++)
+            if (xr[k] > src[idx[winner[k]] * rowLength + k]) winner[k] = j;
+        }
+
+        for (auto j = first; j < last; j++) {
+          T* zr = dst + j * rowLength;
+          for (sd::LongType k = 0; k < rowLength; k++) zr[k] = winner[k] == j ? gr[k] : static_cast<T>(0);
+        }
+        continue;
+      }
+
+      const A norm = mode == EMBEDDING_BAG_MEAN ? static_cast<A>(1) / static_cast<A>(last - first) : static_cast<A>(1);
+      for (auto j = first; j < last; j++) {
+        const A scale = (w != nullptr ? static_cast<A>(w[j]) : static_cast<A>(1)) * norm;
+        T* zr = dst + j * rowLength;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType k = 0; k < rowLength; k++) zr[k] = static_cast<T>(scale * static_cast<A>(gr[k]));
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numBags);
+
+  flushDenseOutput(gradRows, gradRowsHolder);
+}
+
+void embeddingBag(sd::LaunchContext* context, const NDArray& params, const NDArray& indices, const NDArray& offsets,
+                  const NDArray* weights, const int mode, NDArray& output) {
+  BUILD_SINGLE_SELECTOR(params.dataType(), embeddingBag_, (params, indices, offsets, weights, mode, output),
+                        SD_FLOAT_TYPES);
+}
+
+void embeddingBagBp(sd::LaunchContext* context, const NDArray& params, const NDArray& indices, const NDArray& offsets,
+                    const NDArray* weights, const NDArray& gradO, const int mode, NDArray& gradRows) {
+  BUILD_SINGLE_SELECTOR(params.dataType(), embeddingBagBp_,
+                        (params, indices, offsets, weights, gradO, mode, gradRows), SD_FLOAT_TYPES);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
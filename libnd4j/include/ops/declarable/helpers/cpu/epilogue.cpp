@@ -0,0 +1,154 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Fused bias + activation epilogue, CPU implementation
+//
+#include <execution/Threads.h>
+#include <ops/declarable/helpers/epilogue.h>
+#include <ops/ops.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+template <typename T>
+struct EpilogueIdentity {
+  static SD_INLINE T op(T v, T alpha) { return v; }
+};
+
+template <typename T>
+struct EpilogueRelu {
+  static SD_INLINE T op(T v, T alpha) { return simdOps::RELU<T, T, T>::op(v, alpha, nullptr); }
+};
+
+template <typename T>
+struct EpilogueRelu6 {
+  static SD_INLINE T op(T v, T alpha) { return simdOps::RELU6<T, T, T>::op(v, alpha, nullptr); }
+};
+
+template <typename T>
+struct EpilogueLeakyRelu {
+  static SD_INLINE T op(T v, T alpha) { return simdOps::LeakyRELU<T, T, T>::op(v, alpha, nullptr); }
+};
+
+template <typename T>
+struct EpilogueSigmoid {
+  static SD_INLINE T op(T v, T alpha) { return simdOps::Sigmoid<T>::op(v, nullptr); }
+};
+
+template <typename T>
+struct EpilogueTanh {
+  static SD_INLINE T op(T v, T alpha) { return simdOps::Tanh<T>::op(v, nullptr); }
+};
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T, typename OpType>
+static void fusedEpilogueLoop(const NDArray& input, const NDArray* bias, NDArray& output, const int channelDim,
+                              const T alpha) {
+  const T* x = input.bufferAsT<T>();
+  const T* b = bias == nullptr ? nullptr : bias->bufferAsT<T>();
+  T* z = output.bufferAsT<T>();
+
+  const auto xShapeInfo = input.shapeInfo();
+  const auto zShapeInfo = output.shapeInfo();
+  const sd::LongType length = input.lengthOf();
+  int posOfNonUnityDim = 0;
+  if (bias != nullptr) bias->isCommonVector(posOfNonUnityDim);
+  const sd::LongType bStride = bias == nullptr ? 0 : bias->strideAt(posOfNonUnityDim);
+  const sd::LongType numChannels = input.sizeAt(channelDim);
+  const sd::LongType cStride = input.strideAt(channelDim);
+
+  const bool xzSameOffset = shape::haveSameShapeAndStrides(xShapeInfo, zShapeInfo);
+
+  if (xzSameOffset && input.ews() == 1 && output.ews() == 1 && cStride > 0) {
+    // dense buffer: channel index is derived from the flat offset, no coordinates required
+    auto func = PRAGMA_THREADS_FOR {
+      if (b == nullptr) {
+        PRAGMA_OMP_SIMD
+        for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i], alpha);
+      } else {
+        for (auto i = start; i < stop; i++) z[i] = OpType::op(x[i] + b[((i / cStride) % numChannels) * bStride], alpha);
+      }
+    };
+
+    samediff::Threads::parallel_for(func, 0, length);
+    return;
+  }
+
+  auto func = PRAGMA_THREADS_FOR {
+    int coords[SD_MAX_RANK];
+
+    for (auto i = start; i < stop; i++) {
+      shape::index2coordsCPU(start, i, xShapeInfo, coords);
+
+      const auto xOffset = shape::getOffset(xShapeInfo, coords);
+      const auto zOffset = xzSameOffset ? xOffset : shape::getOffset(zShapeInfo, coords);
+
+      z[zOffset] = OpType::op(b == nullptr ? x[xOffset] : x[xOffset] + b[coords[channelDim] * bStride], alpha);
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, length);
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void fusedEpilogue_(const NDArray& input, const NDArray* bias, NDArray& output, const int channelDim,
+                           const graph::FusedActivation activation, const double alpha) {
+  const auto a = static_cast<T>(alpha);
+
+  switch (activation) {
+    case graph::FUSED_RELU:
+      fusedEpilogueLoop<T, EpilogueRelu<T>>(input, bias, output, channelDim, a);
+      break;
+    case graph::FUSED_RELU6:
+      fusedEpilogueLoop<T, EpilogueRelu6<T>>(input, bias, output, channelDim, a);
+      break;
+    case graph::FUSED_LRELU:
+      fusedEpilogueLoop<T, EpilogueLeakyRelu<T>>(input, bias, output, channelDim, a);
+      break;
+    case graph::FUSED_SIGMOID:
+      fusedEpilogueLoop<T, EpilogueSigmoid<T>>(input, bias, output, channelDim, a);
+      break;
+    case graph::FUSED_TANH:
+      fusedEpilogueLoop<T, EpilogueTanh<T>>(input, bias, output, channelDim, a);
+      break;
+    default:
+      fusedEpilogueLoop<T, EpilogueIdentity<T>>(input, bias, output, channelDim, a);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+void fusedEpilogue(sd::LaunchContext* context, const NDArray& input, const NDArray* bias, NDArray& output,
+                   const int channelDim, const graph::FusedActivation activation, const double alpha) {
+  if (bias != nullptr && bias->dataType() != input.dataType()) {
+    auto castedBias = bias->cast(input.dataType());
+    fusedEpilogue(context, input, &castedBias, output, channelDim, activation, alpha);
+    return;
+  }
+
+  NDArray::preparePrimaryUse({&output}, {&input, bias});
+  BUILD_SINGLE_SELECTOR(input.dataType(), fusedEpilogue_, (input, bias, output, channelDim, activation, alpha),
+                        SD_FLOAT_TYPES);
+  NDArray::registerPrimaryUse({&output}, {&input, bias});
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
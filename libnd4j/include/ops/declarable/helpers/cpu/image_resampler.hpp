@@ -0,0 +1,323 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Separable resampling engine shared by the cpu image resize helpers.
+//
+// Every weighted resize method is expressed as two 1-D coefficient tables (rows and columns):
+// output pixel `o` along an axis is the dot product of `weights[o * spanSize : (o + 1) * spanSize]`
+// with the input pixels starting at `starts[o]`. Tables depend only on the method, its parameters
+// and the in/out sizes, so they are built once and kept in a small process-wide cache.
+//
+#ifndef LIBND4J_HELPERS_CPU_IMAGE_RESAMPLER_HPP
+#define LIBND4J_HELPERS_CPU_IMAGE_RESAMPLER_HPP
+#include <array/NDArray.h>
+#include <execution/Threads.h>
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// fractional bits of the fixed point weights used for 8-bit input
+constexpr int kResampleFixedBits = 16;
+
+struct ResampleTable {
+  sd::LongType inSize = 0;
+  sd::LongType outSize = 0;
+  int spanSize = 0;
+  // first input index of every output pixel, {outSize}
+  std::vector<sd::LongType> starts;
+  // {outSize, spanSize}, zero padded
+  std::vector<float> weights;
+  std::vector<double> weightsD;
+  // weights scaled by 2^kResampleFixedBits, every row sums exactly to the scaled sum of the float row
+  std::vector<int32_t> fixedWeights;
+};
+
+using ResampleTablePtr = std::shared_ptr<const ResampleTable>;
+
+template <typename A>
+static inline const A* resampleWeights(ResampleTable const& table);
+
+template <>
+inline const float* resampleWeights<float>(ResampleTable const& table) {
+  return table.weights.data();
+}
+
+template <>
+inline const double* resampleWeights<double>(ResampleTable const& table) {
+  return table.weightsD.data();
+}
+
+// Collects (index, weight) taps per output pixel and packs them into a ResampleTable.
+// Repeated indices (e.g. clamped border taps) are merged, and every window is shifted
+// so that starts[o] + spanSize never exceeds inSize.
+class ResampleTableBuilder {
+ public:
+  ResampleTableBuilder(sd::LongType inSize, sd::LongType outSize) : _inSize(inSize), _taps(outSize) {}
+
+  void add(sd::LongType out, sd::LongType index, double weight) {
+    if (weight == 0.) return;
+    _taps[out].emplace_back(index, weight);
+  }
+
+  ResampleTablePtr build() const {
+    auto table = std::make_shared<ResampleTable>();
+    const sd::LongType outSize = static_cast<sd::LongType>(_taps.size());
+    table->inSize = _inSize;
+    table->outSize = outSize;
+    table->starts.assign(outSize, 0);
+
+    std::vector<std::pair<sd::LongType, sd::LongType>> ranges(outSize, {0, 0});
+    sd::LongType span = 1;
+    for (sd::LongType o = 0; o < outSize; o++) {
+      if (_taps[o].empty()) continue;
+      sd::LongType lo = _inSize, hi = -1;
+      for (auto& tap : _taps[o]) {
+        lo = sd::math::sd_min(lo, tap.first);
+        hi = sd::math::sd_max(hi, tap.first);
+      }
+      ranges[o] = {lo, hi + 1};
+      span = sd::math::sd_max(span, hi + 1 - lo);
+    }
+    span = sd::math::sd_min(span, _inSize);
+    table->spanSize = static_cast<int>(span);
+    table->weightsD.assign(outSize * span, 0.);
+
+    for (sd::LongType o = 0; o < outSize; o++) {
+      auto start = sd::math::sd_min(ranges[o].first, _inSize - span);
+      table->starts[o] = start;
+      auto row = table->weightsD.data() + o * span;
+      for (auto& tap : _taps[o]) row[tap.first - start] += tap.second;
+    }
+
+    table->weights.resize(table->weightsD.size());
+    for (size_t e = 0; e < table->weightsD.size(); e++) table->weights[e] = static_cast<float>(table->weightsD[e]);
+
+    // round to fixed point and push the rounding residue into the largest tap, so that
+    // a flat input region stays flat after resampling
+    const double one = static_cast<double>(1 << kResampleFixedBits);
+    table->fixedWeights.assign(table->weightsD.size(), 0);
+    for (sd::LongType o = 0; o < outSize; o++) {
+      auto row = table->weightsD.data() + o * span;
+      auto fixedRow = table->fixedWeights.data() + o * span;
+      double sum = 0.;
+      int64_t fixedSum = 0;
+      sd::LongType largest = 0;
+      for (sd::LongType k = 0; k < span; k++) {
+        sum += row[k];
+        fixedRow[k] = static_cast<int32_t>(std::llround(row[k] * one));
+        fixedSum += fixedRow[k];
+        if (sd::math::sd_abs(row[k]) > sd::math::sd_abs(row[largest])) largest = k;
+      }
+      fixedRow[largest] += static_cast<int32_t>(std::llround(sum * one) - fixedSum);
+    }
+    return table;
+  }
+
+ private:
+  sd::LongType _inSize;
+  std::vector<std::vector<std::pair<sd::LongType, double>>> _taps;
+};
+
+// Process-wide LRU cache of coefficient tables, keyed by a description of the method,
+// its parameters and the in/out sizes. Tables are immutable once published.
+class ResampleTableCache {
+ public:
+  static ResampleTableCache& getInstance() {
+    static ResampleTableCache instance;
+    return instance;
+  }
+
+  // returns the cached table for the key, building (outside of the lock) and caching it on a miss;
+  // a null table from the builder is reported to the caller and never cached
+  ResampleTablePtr get(const std::string& key, const std::function<ResampleTablePtr()>& builder) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      auto it = _tables.find(key);
+      if (it != _tables.end()) {
+        _order.splice(_order.begin(), _order, it->second.second);
+        return it->second.first;
+      }
+    }
+
+    auto table = builder();
+    if (table == nullptr) return table;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _tables.find(key);
+    if (it != _tables.end()) return it->second.first;
+
+    _order.push_front(key);
+    _tables.emplace(key, std::make_pair(table, _order.begin()));
+    while (_order.size() > kCapacity) {
+      _tables.erase(_order.back());
+      _order.pop_back();
+    }
+    return table;
+  }
+
+  size_t size() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tables.size();
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tables.clear();
+    _order.clear();
+  }
+
+ private:
+  ResampleTableCache() = default;
+
+  static constexpr size_t kCapacity = 256;
+  std::mutex _mutex;
+  std::list<std::string> _order;
+  std::map<std::string, std::pair<ResampleTablePtr, std::list<std::string>::iterator>> _tables;
+};
+
+// Resamples NHWC `input` into c-ordered NHWC `output` with the given row and column tables.
+// Every thread runs the vertical pass for one output row into a contiguous [inWidth * channels]
+// buffer and then the horizontal pass from that buffer, so the inner loops of both passes run
+// over contiguous memory. Accumulation happens in double for double output and in float otherwise;
+// 8-bit input runs the vertical pass in 32-bit fixed point.
+template <typename X, typename Z>
+static void resampleSeparable(NDArray const* input, ResampleTable const& rows, ResampleTable const& cols,
+                              NDArray* output) {
+  using A = typename std::conditional<std::is_same<Z, double>::value, double, float>::type;
+  constexpr bool fixedPoint = std::is_same<X, uint8_t>::value;
+
+  if (output->lengthOf() == 0) return;
+
+  const sd::LongType batchSize = input->sizeAt(0);
+  const sd::LongType inWidth = input->sizeAt(2);
+  const sd::LongType channels = input->sizeAt(3);
+  const sd::LongType outHeight = rows.outSize;
+  const sd::LongType outWidth = cols.outSize;
+  const sd::LongType rowLength = inWidth * channels;
+
+  const sd::LongType bStride = input->strideAt(0);
+  const sd::LongType hStride = input->strideAt(1);
+  const sd::LongType wStride = input->strideAt(2);
+  const sd::LongType cStride = input->strideAt(3);
+  const bool denseRows = cStride == 1 && wStride == channels;
+
+  const X* inputPtr = input->bufferAsT<X>();
+  Z* outputPtr = output->bufferAsT<Z>();
+
+  const int rowSpan = rows.spanSize;
+  const int colSpan = cols.spanSize;
+  const A* rowWeights = resampleWeights<A>(rows);
+  const A* colWeights = resampleWeights<A>(cols);
+  const int32_t* rowFixed = rows.fixedWeights.data();
+  const A fixedScale = static_cast<A>(1.) / static_cast<A>(1 << kResampleFixedBits);
+
+  auto func = PRAGMA_THREADS_FOR {
+    std::vector<A> row(rowLength);
+    std::vector<int32_t> fixedRow(fixedPoint ? rowLength : 0);
+    std::vector<A> pixel(channels);
+
+    for (auto i = start; i < stop; i++) {
+      const sd::LongType b = i / outHeight;
+      const sd::LongType y = i % outHeight;
+      const X* image = inputPtr + b * bStride;
+
+      // vertical pass
+      const sd::LongType yStart = rows.starts[y];
+      if (fixedPoint) {
+        std::fill(fixedRow.begin(), fixedRow.end(), 0);
+        int32_t* acc = fixedRow.data();
+        for (int k = 0; k < rowSpan; k++) {
+          const int32_t w = rowFixed[y * rowSpan + k];
+          if (w == 0) continue;
+          const X* src = image + (yStart + k) * hStride;
+          if (denseRows) {
+            PRAGMA_OMP_SIMD
+            for (sd::LongType e = 0; e < rowLength; e++) acc[e] += w * static_cast<int32_t>(src[e]);
+          } else {
+            for (sd::LongType x = 0; x < inWidth; x++)
+              for (sd::LongType c = 0; c < channels; c++)
+                acc[x * channels + c] += w * static_cast<int32_t>(src[x * wStride + c * cStride]);
+          }
+        }
+        A* dst = row.data();
+        PRAGMA_OMP_SIMD
+        for (sd::LongType e = 0; e < rowLength; e++) dst[e] = static_cast<A>(acc[e]) * fixedScale;
+      } else {
+        std::fill(row.begin(), row.end(), static_cast<A>(0));
+        A* acc = row.data();
+        for (int k = 0; k < rowSpan; k++) {
+          const A w = rowWeights[y * rowSpan + k];
+          if (w == static_cast<A>(0)) continue;
+          const X* src = image + (yStart + k) * hStride;
+          if (denseRows) {
+            PRAGMA_OMP_SIMD
+            for (sd::LongType e = 0; e < rowLength; e++) acc[e] += w * static_cast<A>(src[e]);
+          } else {
+            for (sd::LongType x = 0; x < inWidth; x++)
+              for (sd::LongType c = 0; c < channels; c++)
+                acc[x * channels + c] += w * static_cast<A>(src[x * wStride + c * cStride]);
+          }
+        }
+      }
+
+      // horizontal pass
+      Z* dst = outputPtr + i * outWidth * channels;
+      for (sd::LongType x = 0; x < outWidth; x++) {
+        const A* src = row.data() + cols.starts[x] * channels;
+        const A* w = colWeights + x * colSpan;
+        if (channels == 1) {
+          A sum = static_cast<A>(0);
+          PRAGMA_OMP_SIMD_SUM(sum)
+          for (int k = 0; k < colSpan; k++) sum += w[k] * src[k];
+          dst[x] = static_cast<Z>(sum);
+        } else {
+          A* acc = pixel.data();
+          std::fill(pixel.begin(), pixel.end(), static_cast<A>(0));
+          for (int k = 0; k < colSpan; k++) {
+            const A wk = w[k];
+            const A* s = src + k * channels;
+            PRAGMA_OMP_SIMD
+            for (sd::LongType c = 0; c < channels; c++) acc[c] += wk * s[c];
+          }
+          Z* d = dst + x * channels;
+          for (sd::LongType c = 0; c < channels; c++) d[c] = static_cast<Z>(acc[c]);
+        }
+      }
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, batchSize * outHeight);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_CPU_IMAGE_RESAMPLER_HPP
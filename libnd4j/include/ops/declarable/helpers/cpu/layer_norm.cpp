@@ -0,0 +1,296 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused layer normalization. The normalized axes are arranged as the trailing part of a dense
+// {outer, len} view (through a permuted copy when they are not trailing already), so every
+// normalized sub-array is a contiguous row: moments come from one pass of lane-wise Welford
+// updates, the second pass writes the output.
+//
+#include <execution/Threads.h>
+#include <helpers/ShapeUtils.h>
+#include <ops/declarable/helpers/cpu/normalization.hpp>
+#include <ops/declarable/helpers/layer_norm.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#if NOT_EXCLUDED(OP_layer_norm)
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// same epsilon as the standardize op
+constexpr double kLayerNormEpsilon = 1e-12;
+// independent Welford accumulators per row
+constexpr int kWelfordLanes = 8;
+
+struct LayerNormLayout {
+  // non-normalized dimensions first, normalized ones last
+  std::vector<int> permutation;
+  bool identity = true;
+  sd::LongType outer = 1;
+  sd::LongType len = 1;
+  // channel of a row (gainAlongRow == false) or of a row element: (index / divisor) % channels
+  bool gainAlongRow = false;
+  sd::LongType divisor = 1;
+  sd::LongType channels = 1;
+};
+
+static LayerNormLayout layerNormLayout(const NDArray& input, std::vector<int> axes, int dimC) {
+  const int rank = input.rankOf();
+  if (axes.empty()) throw std::invalid_argument("layerNorm: axes have to be non-empty");
+  if (dimC < 0 || dimC >= rank) throw std::invalid_argument("layerNorm: channel dimension is out of range");
+
+  std::vector<bool> normalized(rank, false);
+  for (auto a : axes) {
+    if (a < 0) a += rank;
+    if (a < 0 || a >= rank) throw std::invalid_argument("layerNorm: axis is out of range");
+    normalized[a] = true;
+  }
+
+  LayerNormLayout layout;
+  for (int d = 0; d < rank; d++)
+    if (!normalized[d]) {
+      layout.permutation.push_back(d);
+      layout.outer *= input.sizeAt(d);
+    }
+  const int numOuter = static_cast<int>(layout.permutation.size());
+  for (int d = 0; d < rank; d++)
+    if (normalized[d]) {
+      layout.permutation.push_back(d);
+      layout.len *= input.sizeAt(d);
+    }
+  for (int d = 0; d < rank; d++) layout.identity &= layout.permutation[d] == d;
+
+  const int posC = static_cast<int>(std::find(layout.permutation.begin(), layout.permutation.end(), dimC) -
+                                    layout.permutation.begin());
+  layout.gainAlongRow = posC >= numOuter;
+  const int regionEnd = layout.gainAlongRow ? rank : numOuter;
+  for (int p = posC + 1; p < regionEnd; p++) layout.divisor *= input.sizeAt(layout.permutation[p]);
+  layout.channels = input.sizeAt(dimC);
+  return layout;
+}
+
+// population mean and variance of a contiguous row
+template <typename T, typename A>
+static void rowMoments(const T* x, const sd::LongType len, A& mean, A& variance) {
+  A laneMean[kWelfordLanes] = {};
+  A laneM2[kWelfordLanes] = {};
+  const sd::LongType steps = len / kWelfordLanes;
+  for (sd::LongType s = 0; s < steps; s++) {
+    const A invCount = static_cast<A>(1) / static_cast<A>(s + 1);
+    const T* xs = x + s * kWelfordLanes;
+    PRAGMA_OMP_SIMD
+    for (int l = 0; l < kWelfordLanes; l++) {
+      const A v = static_cast<A>(xs[l]);
+      const A d = v - laneMean[l];
+      laneMean[l] += d * invCount;
+      laneM2[l] += d * (v - laneMean[l]);
+    }
+  }
+
+  // Chan et al. merge of the lanes, then plain Welford for the tail
+  A count = static_cast<A>(0), m2 = static_cast<A>(0);
+  mean = static_cast<A>(0);
+  if (steps > 0) {
+    const A laneCount = static_cast<A>(steps);
+    for (int l = 0; l < kWelfordLanes; l++) {
+      const A total = count + laneCount;
+      const A d = laneMean[l] - mean;
+      mean += d * laneCount / total;
+      m2 += laneM2[l] + d * d * count * laneCount / total;
+      count = total;
+    }
+  }
+  for (sd::LongType j = steps * kWelfordLanes; j < len; j++) {
+    const A v = static_cast<A>(x[j]);
+    count += static_cast<A>(1);
+    const A d = v - mean;
+    mean += d / count;
+    m2 += d * (v - mean);
+  }
+  variance = len > 0 ? m2 / static_cast<A>(len) : static_cast<A>(0);
+}
+
+template <typename A>
+SD_INLINE A zeroNan(const A v) {
+  return v != v ? static_cast<A>(0) : v;
+}
+
+template <typename A>
+static std::vector<A> channelValues(const NDArray* array, const sd::LongType channels, const A fill) {
+  std::vector<A> values(channels, fill);
+  if (array != nullptr)
+    for (sd::LongType c = 0; c < channels; c++) values[c] = array->e<A>(c);
+  return values;
+}
+
+// per-element channel values of a row, used when the channel dimension is one of the normalized axes
+template <typename A>
+static std::vector<A> expandAlongRow(const std::vector<A>& values, const LayerNormLayout& layout) {
+  std::vector<A> row(layout.gainAlongRow ? layout.len : 0);
+  for (sd::LongType k = 0; k < static_cast<sd::LongType>(row.size()); k++)
+    row[k] = values[(k / layout.divisor) % layout.channels];
+  return row;
+}
+
+// views the array with the normalized axes last
+static std::unique_ptr<NDArray> arrangeForRows(const NDArray& array, const LayerNormLayout& layout) {
+  if (layout.identity) return nullptr;
+  return std::unique_ptr<NDArray>(new NDArray(array.permute(layout.permutation)));
+}
+
+template <typename T>
+static void layerNorm_(const NDArray& input, const NDArray& gain, const NDArray* bias, NDArray& output,
+                       const std::vector<int>& axes, const int dimC) {
+  using A = NormAccumulator<T>;
+  if (input.lengthOf() == 0) return;
+
+  const auto layout = layerNormLayout(input, axes, dimC);
+  const auto gainValues = channelValues<A>(&gain, layout.channels, static_cast<A>(1));
+  const auto biasValues = channelValues<A>(bias, layout.channels, static_cast<A>(0));
+  const auto gainRow = expandAlongRow(gainValues, layout);
+  const auto biasRow = expandAlongRow(biasValues, layout);
+
+  auto inView = arrangeForRows(input, layout);
+  auto outView = arrangeForRows(output, layout);
+  NDArray& outArranged = outView ? *outView : output;
+  std::unique_ptr<NDArray> inHolder, outHolder;
+  const T* x = denseInput(inView ? *inView : input, inHolder)->bufferAsT<T>();
+  T* z = denseOutput(outArranged, outHolder)->bufferAsT<T>();
+  const sd::LongType len = layout.len;
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto o = start; o < stop; o++) {
+      const T* xr = x + o * len;
+      T* zr = z + o * len;
+      A mean, variance;
+      rowMoments(xr, len, mean, variance);
+      const A inv = static_cast<A>(1) / (sd::math::sd_sqrt<A, A>(variance) + static_cast<A>(kLayerNormEpsilon));
+
+      if (layout.gainAlongRow) {
+        const A* g = gainRow.data();
+        const A* b = biasRow.data();
+        PRAGMA_OMP_SIMD
+        for (sd::LongType k = 0; k < len; k++)
+          zr[k] = static_cast<T>(zeroNan((static_cast<A>(xr[k]) - mean) * inv) * g[k] + b[k]);
+      } else {
+        const auto c = (o / layout.divisor) % layout.channels;
+        const A g = gainValues[c];
+        const A b = biasValues[c];
+        PRAGMA_OMP_SIMD
+        for (sd::LongType k = 0; k < len; k++)
+          zr[k] = static_cast<T>(zeroNan((static_cast<A>(xr[k]) - mean) * inv) * g + b);
+      }
+    }
+  };
+  samediff::Threads::parallel_tad(func, 0, layout.outer);
+
+  flushDenseOutput(outArranged, outHolder);
+}
+
+// with g' = gradO * gain, s = stdev(x), y = (x - mean) / s:
+// dLdx = (g' - mean(g') - y * mean(g' * y)) / s
+template <typename T>
+static void layerNormBp_(const NDArray& input, const NDArray& gain, const NDArray& gradO, NDArray& dLdx,
+                         NDArray& dLdgTerms, const std::vector<int>& axes, const int dimC) {
+  using A = NormAccumulator<T>;
+  if (input.lengthOf() == 0) return;
+
+  const auto layout = layerNormLayout(input, axes, dimC);
+  const auto gainValues = channelValues<A>(&gain, layout.channels, static_cast<A>(1));
+  const auto gainRow = expandAlongRow(gainValues, layout);
+
+  auto inView = arrangeForRows(input, layout);
+  auto gradOView = arrangeForRows(gradO, layout);
+  auto dLdxView = arrangeForRows(dLdx, layout);
+  auto termsView = arrangeForRows(dLdgTerms, layout);
+  NDArray& dLdxArranged = dLdxView ? *dLdxView : dLdx;
+  NDArray& termsArranged = termsView ? *termsView : dLdgTerms;
+  std::unique_ptr<NDArray> inHolder, gradOHolder, dLdxHolder, termsHolder;
+  const T* x = denseInput(inView ? *inView : input, inHolder)->bufferAsT<T>();
+  const T* eps = denseInput(gradOView ? *gradOView : gradO, gradOHolder)->bufferAsT<T>();
+  T* dx = denseOutput(dLdxArranged, dLdxHolder)->bufferAsT<T>();
+  T* terms = denseOutput(termsArranged, termsHolder)->bufferAsT<T>();
+  const sd::LongType len = layout.len;
+  const A invLen = static_cast<A>(1) / static_cast<A>(len);
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto o = start; o < stop; o++) {
+      const T* xr = x + o * len;
+      const T* er = eps + o * len;
+      T* dxr = dx + o * len;
+      T* tr = terms + o * len;
+      A mean, variance;
+      rowMoments(xr, len, mean, variance);
+      const A stdev = sd::math::sd_sqrt<A, A>(variance);
+      const A invStdev = stdev > static_cast<A>(0) ? static_cast<A>(1) / stdev : static_cast<A>(0);
+      const A invStdevEps = static_cast<A>(1) / (stdev + static_cast<A>(kLayerNormEpsilon));
+      const A* g = gainRow.data();
+      const A gc = layout.gainAlongRow ? static_cast<A>(1) : gainValues[(o / layout.divisor) % layout.channels];
+
+      A sumG = static_cast<A>(0), sumGY = static_cast<A>(0);
+      if (layout.gainAlongRow) {
+        PRAGMA_OMP_SIMD_SUM(sumG)
+        for (sd::LongType k = 0; k < len; k++) sumG += static_cast<A>(er[k]) * g[k];
+        PRAGMA_OMP_SIMD_SUM(sumGY)
+        for (sd::LongType k = 0; k < len; k++)
+          sumGY += static_cast<A>(er[k]) * g[k] * (static_cast<A>(xr[k]) - mean) * invStdev;
+      } else {
+        PRAGMA_OMP_SIMD_SUM(sumG)
+        for (sd::LongType k = 0; k < len; k++) sumG += static_cast<A>(er[k]) * gc;
+        PRAGMA_OMP_SIMD_SUM(sumGY)
+        for (sd::LongType k = 0; k < len; k++)
+          sumGY += static_cast<A>(er[k]) * gc * (static_cast<A>(xr[k]) - mean) * invStdev;
+      }
+      const A meanG = sumG * invLen;
+      const A meanGY = sumGY * invLen;
+
+      PRAGMA_OMP_SIMD
+      for (sd::LongType k = 0; k < len; k++) {
+        const A centered = static_cast<A>(xr[k]) - mean;
+        const A grad = static_cast<A>(er[k]);
+        const A scaled = grad * (layout.gainAlongRow ? g[k] : gc);
+        dxr[k] = static_cast<T>(zeroNan((scaled - meanG - centered * invStdev * meanGY) * invStdev));
+        tr[k] = static_cast<T>(zeroNan(centered * invStdevEps) * grad);
+      }
+    }
+  };
+  samediff::Threads::parallel_tad(func, 0, layout.outer);
+
+  flushDenseOutput(dLdxArranged, dLdxHolder);
+  flushDenseOutput(termsArranged, termsHolder);
+}
+
+void layerNorm(sd::LaunchContext* context, const NDArray& input, const NDArray& gain, const NDArray* bias,
+               NDArray& output, const std::vector<int>& axes, const int dimC) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), layerNorm_, (input, gain, bias, output, axes, dimC), SD_FLOAT_TYPES);
+}
+
+void layerNormBp(sd::LaunchContext* context, const NDArray& input, const NDArray& gain, const NDArray& gradO,
+                 NDArray& dLdx, NDArray& dLdgTerms, const std::vector<int>& axes, const int dimC) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), layerNormBp_, (input, gain, gradO, dLdx, dLdgTerms, axes, dimC),
+                        SD_FLOAT_TYPES);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif
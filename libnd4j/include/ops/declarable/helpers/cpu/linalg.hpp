@@ -0,0 +1,636 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+//
+// Blocked dense linear algebra kernels shared by the CPU lup, qr, svd and triangular_solve helpers.
+//
+// All kernels work in place on row-major buffers with a leading dimension. Trailing updates are
+// expressed as GEMM calls and go to BlasHelper when a BLAS is present; when the loaded library also
+// provides the LAPACK routine, the whole factorization is delegated to it.
+//
+// `threads` is the number of threads a kernel may use: batches of small matrices are spread over
+// threads with every matrix kept on one thread (see forEachMatrix), large single matrices give all
+// threads to the kernels.
+//
+#ifndef LIBND4J_HELPERS_CPU_LINALG_HPP
+#define LIBND4J_HELPERS_CPU_LINALG_HPP
+#include <array/NDArray.h>
+#include <execution/Threads.h>
+#include <helpers/BlasHelper.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// panel width of the blocked factorizations
+constexpr sd::LongType kLinalgBlock = 64;
+// multiply-adds below which a kernel stays on the calling thread
+constexpr sd::LongType kLinalgParallelWork = 1 << 16;
+
+SD_INLINE int linalgThreads(sd::LongType work, int threads) { return work < kLinalgParallelWork ? 1 : threads; }
+
+//////////////////////////////////////////////////////////////////////////
+// BLAS/LAPACK bridge: every call returns false when the routine isn't available for T
+template <typename T>
+struct LinalgBlas {
+  static bool gemm(bool transA, bool transB, sd::LongType m, sd::LongType n, sd::LongType k, T alpha, const T* a,
+                   sd::LongType lda, const T* b, sd::LongType ldb, T beta, T* c, sd::LongType ldc) {
+    return false;
+  }
+  static bool trsm(bool lower, bool unitDiag, sd::LongType n, sd::LongType nrhs, const T* a, sd::LongType lda, T* b,
+                   sd::LongType ldb) {
+    return false;
+  }
+  static bool getrf(sd::LongType n, T* a, sd::LongType lda, int* pivots, int& info) { return false; }
+  static bool potrf(sd::LongType n, T* a, sd::LongType lda, int& info) { return false; }
+  static bool geqrf(sd::LongType m, sd::LongType n, T* a, sd::LongType lda, T* tau) { return false; }
+  static bool orgqr(sd::LongType m, sd::LongType n, sd::LongType k, T* a, sd::LongType lda, const T* tau) {
+    return false;
+  }
+  static bool gesdd(char job, sd::LongType m, sd::LongType n, T* a, sd::LongType lda, T* s, T* u, sd::LongType ldu,
+                    T* vt, sd::LongType ldvt) {
+    return false;
+  }
+};
+
+#define SD_LINALG_BLAS(T, GEMM, TRSM, GETRF, POTRF, GEQRF, ORGQR, GESDD)                                              \
+  template <>                                                                                                         \
+  struct LinalgBlas<T> {                                                                                              \
+    static bool gemm(bool transA, bool transB, sd::LongType m, sd::LongType n, sd::LongType k, T alpha, const T* a,  \
+                     sd::LongType lda, const T* b, sd::LongType ldb, T beta, T* c, sd::LongType ldc) {                \
+      if (!BlasHelper::getInstance().hasGEMM<T>()) return false;                                                      \
+      BlasHelper::getInstance().GEMM()(CblasRowMajor, transA ? CblasTrans : CblasNoTrans,                             \
+                                       transB ? CblasTrans : CblasNoTrans, m, n, k, alpha, const_cast<T*>(a), lda,    \
+                                       const_cast<T*>(b), ldb, beta, c, ldc);                                         \
+      return true;                                                                                                    \
+    }                                                                                                                 \
+    static bool trsm(bool lower, bool unitDiag, sd::LongType n, sd::LongType nrhs, const T* a, sd::LongType lda,     \
+                     T* b, sd::LongType ldb) {                                                                        \
+      if (!BlasHelper::getInstance().hasTRSM<T>()) return false;                                                      \
+      BlasHelper::getInstance().TRSM()(CblasRowMajor, CblasLeft, lower ? CblasLower : CblasUpper, CblasNoTrans,       \
+                                       unitDiag ? CblasUnit : CblasNonUnit, n, nrhs, T(1), const_cast<T*>(a), lda, b, \
+                                       ldb);                                                                          \
+      return true;                                                                                                    \
+    }                                                                                                                 \
+    static bool getrf(sd::LongType n, T* a, sd::LongType lda, int* pivots, int& info) {                               \
+      auto routine = BlasHelper::getInstance().GETRF();                                                               \
+      if (!BlasHelper::getInstance().hasLAPACK() || routine == nullptr) return false;                                 \
+      info = routine(LAPACK_ROW_MAJOR, n, n, a, lda, pivots);                                                         \
+      for (sd::LongType i = 0; i < n; i++) pivots[i]--;                                                               \
+      return true;                                                                                                    \
+    }                                                                                                                 \
+    static bool potrf(sd::LongType n, T* a, sd::LongType lda, int& info) {                                            \
+      auto routine = BlasHelper::getInstance().POTRF();                                                               \
+      if (!BlasHelper::getInstance().hasLAPACK() || routine == nullptr) return false;                                 \
+      info = routine(LAPACK_ROW_MAJOR, 'L', n, a, lda);                                                               \
+      return true;                                                                                                    \
+    }                                                                                                                 \
+    static bool geqrf(sd::LongType m, sd::LongType n, T* a, sd::LongType lda, T* tau) {                               \
+      auto routine = BlasHelper::getInstance().GEQRF();                                                               \
+      if (!BlasHelper::getInstance().hasLAPACK() || routine == nullptr) return false;                                 \
+      return routine(LAPACK_ROW_MAJOR, m, n, a, lda, tau) == 0;                                                       \
+    }                                                                                                                 \
+    static bool orgqr(sd::LongType m, sd::LongType n, sd::LongType k, T* a, sd::LongType lda, const T* tau) {         \
+      auto routine = BlasHelper::getInstance().ORGQR();                                                               \
+      if (!BlasHelper::getInstance().hasLAPACK() || routine == nullptr) return false;                                 \
+      return routine(LAPACK_ROW_MAJOR, m, n, k, a, lda, tau) == 0;                                                    \
+    }                                                                                                                 \
+    static bool gesdd(char job, sd::LongType m, sd::LongType n, T* a, sd::LongType lda, T* s, T* u, sd::LongType ldu, \
+                      T* vt, sd::LongType ldvt) {                                                                     \
+      auto routine = BlasHelper::getInstance().GESDD();                                                               \
+      if (!BlasHelper::getInstance().hasLAPACK() || routine == nullptr) return false;                                 \
+      return routine(LAPACK_ROW_MAJOR, job, m, n, a, lda, s, u, ldu, vt, ldvt) == 0;                                  \
+    }                                                                                                                 \
+  };
+
+SD_LINALG_BLAS(float, sgemm, strsm, sgetrf, spotrf, sgeqrf, sorgqr, sgesdd)
+SD_LINALG_BLAS(double, dgemm, dtrsm, dgetrf, dpotrf, dgeqrf, dorgqr, dgesdd)
+
+#undef SD_LINALG_BLAS
+
+//////////////////////////////////////////////////////////////////////////
+// dense row-major copies of the last two dimensions of a (possibly strided) matrix view
+template <typename T>
+SD_INLINE void loadMatrix(const NDArray& matrix, T* dense) {
+  const auto rows = matrix.sizeAt(-2);
+  const auto cols = matrix.sizeAt(-1);
+  const auto rowStride = matrix.strideAt(matrix.rankOf() - 2);
+  const auto colStride = matrix.strideAt(matrix.rankOf() - 1);
+  const T* source = matrix.bufferAsT<T>();
+
+  for (sd::LongType r = 0; r < rows; r++)
+    for (sd::LongType c = 0; c < cols; c++) dense[r * cols + c] = source[r * rowStride + c * colStride];
+}
+
+template <typename T>
+SD_INLINE void storeMatrix(const T* dense, NDArray& matrix) {
+  const auto rows = matrix.sizeAt(-2);
+  const auto cols = matrix.sizeAt(-1);
+  const auto rowStride = matrix.strideAt(matrix.rankOf() - 2);
+  const auto colStride = matrix.strideAt(matrix.rankOf() - 1);
+  T* target = matrix.bufferAsT<T>();
+
+  for (sd::LongType r = 0; r < rows; r++)
+    for (sd::LongType c = 0; c < cols; c++) target[r * rowStride + c * colStride] = dense[r * cols + c];
+}
+
+// calls func(index, threads) for every matrix of a batch
+template <typename F>
+SD_INLINE void forEachMatrix(sd::LongType numMatrices, sd::LongType workPerMatrix, F func) {
+  const int maxThreads = sd::Environment::getInstance().maxMasterThreads();
+  if (numMatrices > 1 && (numMatrices >= maxThreads || workPerMatrix < kLinalgParallelWork)) {
+    auto batchLoop = PRAGMA_THREADS_FOR {
+      for (auto i = start; i < stop; i++) func(i, 1);
+    };
+    samediff::Threads::parallel_tad(batchLoop, 0, numMatrices, 1);
+  } else {
+    for (sd::LongType i = 0; i < numMatrices; i++) func(i, maxThreads);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// C = alpha * op(A) * op(B) + beta * C, C is m x n
+template <typename T>
+void linalgGemm(bool transA, bool transB, sd::LongType m, sd::LongType n, sd::LongType k, T alpha, const T* a,
+                sd::LongType lda, const T* b, sd::LongType ldb, T beta, T* c, sd::LongType ldc, int threads) {
+  if (m == 0 || n == 0) return;
+  if (LinalgBlas<T>::gemm(transA, transB, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc)) return;
+
+  auto rowsLoop = PRAGMA_THREADS_FOR {
+    for (auto i = start; i < stop; i++) {
+      T* cRow = c + i * ldc;
+      if (beta == T(0.f)) {
+        for (sd::LongType j = 0; j < n; j++) cRow[j] = T(0.f);
+      } else if (beta != T(1.f)) {
+        for (sd::LongType j = 0; j < n; j++) cRow[j] *= beta;
+      }
+
+      if (!transB) {
+        // rank-1 updates along contiguous rows of B
+        for (sd::LongType p = 0; p < k; p++) {
+          const T aip = alpha * (transA ? a[p * lda + i] : a[i * lda + p]);
+          if (aip == T(0.f)) continue;
+          const T* bRow = b + p * ldb;
+          PRAGMA_OMP_SIMD
+          for (sd::LongType j = 0; j < n; j++) cRow[j] += aip * bRow[j];
+        }
+      } else {
+        // dot products against contiguous rows of B
+        for (sd::LongType j = 0; j < n; j++) {
+          const T* bRow = b + j * ldb;
+          T sum = T(0.f);
+          if (!transA) {
+            const T* aRow = a + i * lda;
+            for (sd::LongType p = 0; p < k; p++) sum += aRow[p] * bRow[p];
+          } else {
+            for (sd::LongType p = 0; p < k; p++) sum += a[p * lda + i] * bRow[p];
+          }
+          cRow[j] += alpha * sum;
+        }
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(rowsLoop, 0, m, 1, linalgThreads(m * n * k, threads));
+}
+
+//////////////////////////////////////////////////////////////////////////
+// solves A X = B for triangular n x n A, X overwrites the n x nrhs B; only columns [from, to) of B are touched
+template <typename T>
+static void trsmUnblocked(bool lower, bool unitDiag, sd::LongType n, const T* a, sd::LongType lda, T* b,
+                          sd::LongType ldb, sd::LongType from, sd::LongType to) {
+  for (sd::LongType s = 0; s < n; s++) {
+    const auto i = lower ? s : n - 1 - s;
+    T* bi = b + i * ldb;
+    const auto first = lower ? 0 : i + 1;
+    const auto last = lower ? i : n;
+    for (sd::LongType p = first; p < last; p++) {
+      const T aip = a[i * lda + p];
+      if (aip == T(0.f)) continue;
+      const T* bp = b + p * ldb;
+      PRAGMA_OMP_SIMD
+      for (sd::LongType j = from; j < to; j++) bi[j] -= aip * bp[j];
+    }
+    if (!unitDiag) {
+      const T diagonal = a[i * lda + i];
+      for (sd::LongType j = from; j < to; j++) bi[j] /= diagonal;
+    }
+  }
+}
+
+template <typename T>
+void linalgTrsm(bool lower, bool unitDiag, sd::LongType n, sd::LongType nrhs, const T* a, sd::LongType lda, T* b,
+                sd::LongType ldb, int threads) {
+  if (n == 0 || nrhs == 0) return;
+  if (LinalgBlas<T>::trsm(lower, unitDiag, n, nrhs, a, lda, b, ldb)) return;
+
+  for (sd::LongType s = 0; s < n; s += kLinalgBlock) {
+    const auto bs = sd::math::sd_min<sd::LongType>(kLinalgBlock, n - s);
+    // first row of the diagonal block: blocks go down for lower and up for upper matrices
+    const auto k = lower ? s : n - s - bs;
+
+    auto columnsLoop = PRAGMA_THREADS_FOR { trsmUnblocked(lower, unitDiag, bs, a + k * lda + k, lda, b + k * ldb, ldb, start, stop); };
+    samediff::Threads::parallel_for(columnsLoop, 0, nrhs, 1, linalgThreads(bs * bs * nrhs, threads));
+
+    // eliminate the solved block from the rows still to go
+    if (lower && k + bs < n)
+      linalgGemm<T>(false, false, n - k - bs, nrhs, bs, T(-1.f), a + (k + bs) * lda + k, lda, b + k * ldb, ldb,
+                    T(1.f), b + (k + bs) * ldb, ldb, threads);
+    else if (!lower && k > 0)
+      linalgGemm<T>(false, false, k, nrhs, bs, T(-1.f), a + k, lda, b + k * ldb, ldb, T(1.f), b, ldb, threads);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// LU with partial pivoting of the n x n matrix, P A = L U with unit lower L. Row i of the factors was row
+// pivots[i] before step i. Returns 0 or the 1-based index of the first exactly zero pivot.
+template <typename T>
+int luFactorize(sd::LongType n, T* a, sd::LongType lda, int* pivots, int threads) {
+  int info = 0;
+  if (LinalgBlas<T>::getrf(n, a, lda, pivots, info)) return info;
+
+  for (sd::LongType k = 0; k < n; k += kLinalgBlock) {
+    const auto bs = sd::math::sd_min<sd::LongType>(kLinalgBlock, n - k);
+
+    // unblocked factorization of the panel of columns [k, k + bs)
+    for (sd::LongType j = k; j < k + bs; j++) {
+      sd::LongType pivot = j;
+      T pivotValue = sd::math::sd_abs<T>(a[j * lda + j]);
+      for (sd::LongType i = j + 1; i < n; i++) {
+        const T value = sd::math::sd_abs<T>(a[i * lda + j]);
+        if (value > pivotValue) {
+          pivotValue = value;
+          pivot = i;
+        }
+      }
+
+      pivots[j] = static_cast<int>(pivot);
+      if (pivotValue == T(0.f)) {
+        if (info == 0) info = static_cast<int>(j + 1);
+        continue;
+      }
+      if (pivot != j) std::swap_ranges(a + j * lda, a + j * lda + n, a + pivot * lda);
+
+      const T* rowJ = a + j * lda;
+      auto rowsLoop = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++) {
+          T* rowI = a + i * lda;
+          const T multiplier = rowI[j] / rowJ[j];
+          rowI[j] = multiplier;
+          PRAGMA_OMP_SIMD
+          for (sd::LongType c = j + 1; c < k + bs; c++) rowI[c] -= multiplier * rowJ[c];
+        }
+      };
+      samediff::Threads::parallel_for(rowsLoop, j + 1, n, 1, linalgThreads((n - j) * bs, threads));
+    }
+
+    if (k + bs < n) {
+      // U12 = L11^-1 A12, A22 -= L21 U12
+      linalgTrsm<T>(true, true, bs, n - k - bs, a + k * lda + k, lda, a + k * lda + k + bs, lda, threads);
+      linalgGemm<T>(false, false, n - k - bs, n - k - bs, bs, T(-1.f), a + (k + bs) * lda + k, lda,
+                    a + k * lda + k + bs, lda, T(1.f), a + (k + bs) * lda + k + bs, lda, threads);
+    }
+  }
+
+  return info;
+}
+
+// row permutation produced by luFactorize: row i of the factors is row permutation[i] of the input
+SD_INLINE std::vector<sd::LongType> luPermutation(const int* pivots, sd::LongType n) {
+  std::vector<sd::LongType> permutation(n);
+  std::iota(permutation.begin(), permutation.end(), 0);
+  for (sd::LongType i = 0; i < n; i++) std::swap(permutation[i], permutation[pivots[i]]);
+  return permutation;
+}
+
+SD_INLINE bool luOddPermutation(const int* pivots, sd::LongType n) {
+  bool odd = false;
+  for (sd::LongType i = 0; i < n; i++)
+    if (pivots[i] != i) odd = !odd;
+  return odd;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Cholesky factorization A = L L^T, L overwrites the lower triangle, the strict upper triangle is garbage on exit.
+// Returns 0 or the 1-based index of the first non-positive pivot; the factorization keeps going past it (producing
+// NaNs) so that callers see the same values as the unblocked algorithm.
+template <typename T>
+int choleskyFactorize(sd::LongType n, T* a, sd::LongType lda, int threads) {
+  int info = 0;
+  if (LinalgBlas<T>::potrf(n, a, lda, info)) return info;
+
+  for (sd::LongType k = 0; k < n; k += kLinalgBlock) {
+    const auto bs = sd::math::sd_min<sd::LongType>(kLinalgBlock, n - k);
+    T* a11 = a + k * lda + k;
+
+    // A11 -= L10 L10^T
+    if (k > 0) linalgGemm<T>(false, true, bs, bs, k, T(-1.f), a + k * lda, lda, a + k * lda, lda, T(1.f), a11, lda, threads);
+
+    for (sd::LongType j = 0; j < bs; j++) {
+      T* rowJ = a11 + j * lda;
+      T diagonal = rowJ[j];
+      for (sd::LongType p = 0; p < j; p++) diagonal -= rowJ[p] * rowJ[p];
+      if (diagonal <= T(0.f) && info == 0) info = static_cast<int>(k + j + 1);
+      rowJ[j] = sd::math::sd_sqrt<T, T>(diagonal);
+
+      for (sd::LongType i = j + 1; i < bs; i++) {
+        T* rowI = a11 + i * lda;
+        T sum = rowI[j];
+        for (sd::LongType p = 0; p < j; p++) sum -= rowI[p] * rowJ[p];
+        rowI[j] = sum / rowJ[j];
+      }
+    }
+
+    if (k + bs < n) {
+      T* a21 = a + (k + bs) * lda + k;
+      // A21 -= L20 L10^T, then L21 = A21 L11^-T row by row
+      if (k > 0)
+        linalgGemm<T>(false, true, n - k - bs, bs, k, T(-1.f), a + (k + bs) * lda, lda, a + k * lda, lda, T(1.f),
+                      a21, lda, threads);
+
+      auto rowsLoop = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++) {
+          T* x = a21 + i * lda;
+          for (sd::LongType j = 0; j < bs; j++) {
+            const T* l11 = a11 + j * lda;
+            T sum = x[j];
+            for (sd::LongType p = 0; p < j; p++) sum -= l11[p] * x[p];
+            x[j] = sum / l11[j];
+          }
+        }
+      };
+      samediff::Threads::parallel_for(rowsLoop, 0, n - k - bs, 1, linalgThreads((n - k - bs) * bs * bs, threads));
+    }
+  }
+
+  return info;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Householder QR: generates the reflector annihilating x[1:], x is strided by ldx
+template <typename T>
+static void householderColumn(sd::LongType length, T* x, sd::LongType ldx, T& tau) {
+  const double alpha = static_cast<double>(x[0]);
+  double sigma = 0.;
+  for (sd::LongType i = 1; i < length; i++) sigma += static_cast<double>(x[i * ldx]) * static_cast<double>(x[i * ldx]);
+
+  if (sigma == 0.) {
+    tau = T(0.f);
+    return;
+  }
+
+  const double beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+  const double scale = 1. / (alpha - beta);
+  tau = static_cast<T>((beta - alpha) / beta);
+  for (sd::LongType i = 1; i < length; i++) x[i * ldx] = static_cast<T>(static_cast<double>(x[i * ldx]) * scale);
+  x[0] = static_cast<T>(beta);
+}
+
+// C = (I - tau v v^T) C for a single reflector with implicit v[0] == 1
+template <typename T>
+static void applyHouseholder(sd::LongType length, sd::LongType columns, const T* v, sd::LongType ldv, T tau, T* c,
+                             sd::LongType ldc) {
+  if (columns == 0 || tau == T(0.f)) return;
+
+  std::vector<T> w(c, c + columns);
+  for (sd::LongType i = 1; i < length; i++) {
+    const T vi = v[i * ldv];
+    const T* ci = c + i * ldc;
+    for (sd::LongType j = 0; j < columns; j++) w[j] += vi * ci[j];
+  }
+
+  for (sd::LongType j = 0; j < columns; j++) c[j] -= tau * w[j];
+  for (sd::LongType i = 1; i < length; i++) {
+    const T factor = tau * v[i * ldv];
+    T* ci = c + i * ldc;
+    for (sd::LongType j = 0; j < columns; j++) ci[j] -= factor * w[j];
+  }
+}
+
+// explicit unit lower trapezoidal V (rows x bs) and upper triangular T (bs x bs) of the compact WY form
+// H_0 H_1 ... H_bs-1 = I - V T V^T of the reflectors stored below the diagonal of a
+template <typename T>
+static void compactWY(sd::LongType rows, sd::LongType bs, const T* a, sd::LongType lda, const T* tau,
+                      std::vector<T>& v, std::vector<T>& t) {
+  v.assign(rows * bs, T(0.f));
+  for (sd::LongType i = 0; i < rows; i++)
+    for (sd::LongType j = 0; j < bs && j <= i; j++) v[i * bs + j] = i == j ? T(1.f) : a[i * lda + j];
+
+  t.assign(bs * bs, T(0.f));
+  std::vector<T> z(bs);
+  for (sd::LongType j = 0; j < bs; j++) {
+    // T[0:j, j] = -tau_j T[0:j, 0:j] V[:, 0:j]^T v_j
+    for (sd::LongType p = 0; p < j; p++) {
+      T sum = T(0.f);
+      for (sd::LongType i = j; i < rows; i++) sum += v[i * bs + p] * v[i * bs + j];
+      z[p] = sum;
+    }
+    for (sd::LongType r = 0; r < j; r++) {
+      T sum = T(0.f);
+      for (sd::LongType p = r; p < j; p++) sum += t[r * bs + p] * z[p];
+      t[r * bs + j] = -tau[j] * sum;
+    }
+    t[j * bs + j] = tau[j];
+  }
+}
+
+// C = (I - V T V^T) C, or its transpose applied when transpose is set; C is rows x columns
+template <typename T>
+static void applyBlockReflector(bool transpose, sd::LongType rows, sd::LongType columns, sd::LongType bs,
+                                const std::vector<T>& v, const std::vector<T>& t, T* c, sd::LongType ldc,
+                                int threads) {
+  std::vector<T> w(bs * columns), tw(bs * columns);
+  linalgGemm<T>(true, false, bs, columns, rows, T(1.f), v.data(), bs, c, ldc, T(0.f), w.data(), columns, threads);
+  linalgGemm<T>(transpose, false, bs, columns, bs, T(1.f), t.data(), bs, w.data(), columns, T(0.f), tw.data(),
+                columns, threads);
+  linalgGemm<T>(false, false, rows, columns, bs, T(-1.f), v.data(), bs, tw.data(), columns, T(1.f), c, ldc, threads);
+}
+
+// QR of the m x n matrix: R overwrites the upper triangle, the reflectors are kept below the diagonal with their
+// min(m, n) scales in tau
+template <typename T>
+void qrFactorize(sd::LongType m, sd::LongType n, T* a, sd::LongType lda, T* tau, int threads) {
+  if (LinalgBlas<T>::geqrf(m, n, a, lda, tau)) return;
+
+  const auto reflectors = sd::math::sd_min<sd::LongType>(m, n);
+  std::vector<T> v, t;
+  for (sd::LongType k = 0; k < reflectors; k += kLinalgBlock) {
+    const auto bs = sd::math::sd_min<sd::LongType>(kLinalgBlock, reflectors - k);
+
+    for (sd::LongType j = k; j < k + bs; j++) {
+      householderColumn(m - j, a + j * lda + j, lda, tau[j]);
+      applyHouseholder(m - j, k + bs - j - 1, a + j * lda + j, lda, tau[j], a + j * lda + j + 1, lda);
+    }
+
+    if (k + bs < n) {
+      compactWY(m - k, bs, a + k * lda + k, lda, tau + k, v, t);
+      applyBlockReflector(true, m - k, n - k - bs, bs, v, t, a + k * lda + k + bs, lda, threads);
+    }
+  }
+}
+
+// forms the first n columns of Q from the k reflectors that qrFactorize left in the first k columns of q (m x n)
+template <typename T>
+void qrFormQ(sd::LongType m, sd::LongType n, sd::LongType k, T* q, sd::LongType ldq, const T* tau, int threads) {
+  if (LinalgBlas<T>::orgqr(m, n, k, q, ldq, tau)) return;
+
+  std::vector<T> reflectors(m * k);
+  for (sd::LongType i = 0; i < m; i++)
+    for (sd::LongType j = 0; j < k; j++) reflectors[i * k + j] = q[i * ldq + j];
+
+  for (sd::LongType i = 0; i < m; i++)
+    for (sd::LongType j = 0; j < n; j++) q[i * ldq + j] = i == j ? T(1.f) : T(0.f);
+
+  // Q = H_0 ... H_k-1 I, accumulated backwards so that every panel only touches Q[j:, j:]
+  std::vector<T> v, t;
+  for (sd::LongType j = k > 0 ? ((k - 1) / kLinalgBlock) * kLinalgBlock : -1; j >= 0; j -= kLinalgBlock) {
+    const auto bs = sd::math::sd_min<sd::LongType>(kLinalgBlock, k - j);
+    compactWY(m - j, bs, reflectors.data() + j * k + j, k, tau + j, v, t);
+    applyBlockReflector(false, m - j, n - j, bs, v, t, q + j * ldq + j, ldq, threads);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+// One-sided Jacobi SVD of the m x n matrix a. s gets the min(m, n) singular values in descending order, u (m x uCols)
+// and v (n x vCols) the singular vectors when calcUV is set; uCols/vCols are either min(m, n) or m/n.
+// Rotations run in double on the columns of the taller orientation, disjoint pairs in parallel.
+template <typename T>
+void svdJacobi(sd::LongType m, sd::LongType n, const T* a, sd::LongType lda, T* s, bool calcUV, T* u,
+               sd::LongType uCols, T* v, sd::LongType vCols, int threads) {
+  const bool transposed = m < n;
+  const auto rows = transposed ? n : m;
+  const auto p = transposed ? m : n;
+
+  // g keeps the columns of the (possibly transposed) matrix as rows, w the accumulated rotations
+  std::vector<double> g(p * rows), w(p * p, 0.);
+  for (sd::LongType i = 0; i < rows; i++)
+    for (sd::LongType j = 0; j < p; j++)
+      g[j * rows + i] = static_cast<double>(transposed ? a[j * lda + i] : a[i * lda + j]);
+  for (sd::LongType j = 0; j < p; j++) w[j * p + j] = 1.;
+
+  const double tolerance = static_cast<double>(DataTypeUtils::eps<T>());
+  const auto players = p + (p & 1);
+  std::vector<sd::LongType> order(players);
+
+  auto rotate = [&](sd::LongType x, sd::LongType y) -> bool {
+    double* gx = g.data() + x * rows;
+    double* gy = g.data() + y * rows;
+    double alpha = 0., beta = 0., gamma = 0.;
+    for (sd::LongType i = 0; i < rows; i++) {
+      alpha += gx[i] * gx[i];
+      beta += gy[i] * gy[i];
+      gamma += gx[i] * gy[i];
+    }
+    if (gamma == 0. || std::abs(gamma) <= tolerance * std::sqrt(alpha * beta)) return false;
+
+    const double zeta = (beta - alpha) / (2. * gamma);
+    const double tangent = (zeta >= 0. ? 1. : -1.) / (std::abs(zeta) + std::sqrt(1. + zeta * zeta));
+    const double cosine = 1. / std::sqrt(1. + tangent * tangent);
+    const double sine = cosine * tangent;
+
+    PRAGMA_OMP_SIMD
+    for (sd::LongType i = 0; i < rows; i++) {
+      const double first = gx[i];
+      gx[i] = cosine * first - sine * gy[i];
+      gy[i] = sine * first + cosine * gy[i];
+    }
+    double* wx = w.data() + x * p;
+    double* wy = w.data() + y * p;
+    PRAGMA_OMP_SIMD
+    for (sd::LongType i = 0; i < p; i++) {
+      const double first = wx[i];
+      wx[i] = cosine * first - sine * wy[i];
+      wy[i] = sine * first + cosine * wy[i];
+    }
+    return true;
+  };
+
+  for (int sweep = 0; sweep < 64 && p > 1; sweep++) {
+    std::atomic<bool> rotated(false);
+    // round-robin tournament: every round pairs all columns disjointly, players - 1 rounds cover all pairs
+    for (sd::LongType round = 0; round < players - 1; round++) {
+      order[0] = 0;
+      for (sd::LongType i = 1; i < players; i++) order[i] = 1 + (i - 1 + round) % (players - 1);
+
+      auto pairsLoop = PRAGMA_THREADS_FOR {
+        for (auto i = start; i < stop; i++) {
+          const auto x = order[i];
+          const auto y = order[players - 1 - i];
+          if (x >= p || y >= p) continue;
+          if (rotate(sd::math::sd_min<sd::LongType>(x, y), sd::math::sd_max<sd::LongType>(x, y))) rotated = true;
+        }
+      };
+      samediff::Threads::parallel_for(pairsLoop, 0, players / 2, 1, linalgThreads(rows * players, threads));
+    }
+    if (!rotated) break;
+  }
+
+  std::vector<double> sigma(p);
+  for (sd::LongType j = 0; j < p; j++) {
+    double norm = 0.;
+    for (sd::LongType i = 0; i < rows; i++) norm += g[j * rows + i] * g[j * rows + i];
+    sigma[j] = std::sqrt(norm);
+  }
+  std::vector<sd::LongType> sorted(p);
+  std::iota(sorted.begin(), sorted.end(), 0);
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [&](sd::LongType x, sd::LongType y) { return sigma[x] > sigma[y]; });
+  for (sd::LongType j = 0; j < p; j++) s[j] = static_cast<T>(sigma[sorted[j]]);
+
+  if (!calcUV) return;
+
+  // left vectors of the taller orientation: normalized columns for the nonzero singular values, the rest of the
+  // requested basis is completed with Q of their QR decomposition
+  const auto leftCols = transposed ? vCols : uCols;
+  const double threshold = p > 0 ? sigma[sorted[0]] * rows * std::numeric_limits<double>::epsilon() : 0.;
+  sd::LongType rank = 0;
+  while (rank < p && sigma[sorted[rank]] > threshold) rank++;
+
+  std::vector<double> left(rows * leftCols, 0.);
+  if (rank < leftCols) {
+    std::vector<double> tau(rank);
+    for (sd::LongType i = 0; i < rows; i++)
+      for (sd::LongType j = 0; j < rank; j++) left[i * leftCols + j] = g[sorted[j] * rows + i] / sigma[sorted[j]];
+    qrFactorize<double>(rows, rank, left.data(), leftCols, tau.data(), threads);
+    qrFormQ<double>(rows, leftCols, rank, left.data(), leftCols, tau.data(), threads);
+  }
+  for (sd::LongType i = 0; i < rows; i++)
+    for (sd::LongType j = 0; j < rank; j++) left[i * leftCols + j] = g[sorted[j] * rows + i] / sigma[sorted[j]];
+
+  // right vectors of the taller orientation are the accumulated rotations
+  T* leftTarget = transposed ? v : u;
+  T* rightTarget = transposed ? u : v;
+  for (sd::LongType i = 0; i < rows; i++)
+    for (sd::LongType j = 0; j < leftCols; j++) leftTarget[i * leftCols + j] = static_cast<T>(left[i * leftCols + j]);
+  for (sd::LongType i = 0; i < p; i++)
+    for (sd::LongType j = 0; j < p; j++) rightTarget[i * p + j] = static_cast<T>(w[sorted[j] * p + i]);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_CPU_LINALG_HPP
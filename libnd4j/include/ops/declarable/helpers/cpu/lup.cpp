@@ -22,232 +22,51 @@
 #include <array/NDArrayFactory.h>
 #include <execution/Threads.h>
 #include <helpers/MmulHelper.h>
+#include <ops/declarable/helpers/cpu/linalg.hpp>
 #include <ops/declarable/helpers/top_k.h>
 #if NOT_EXCLUDED(OP_lup)
 namespace sd {
 namespace ops {
 namespace helpers {
 
+// LU factors of a dense copy of the matrix, returns 0 or the 1-based index of the first zero pivot
 template <typename T>
-static void swapRows_(NDArray* matrix, int theFirst, int theSecond) {
-  if (theFirst != theSecond)
-    for (int i = 0; i < matrix->columns(); i++) {
-      math::sd_swap(matrix->r<T>(theFirst, i), matrix->r<T>(theSecond, i));
-    }
-}
-BUILD_SINGLE_TEMPLATE(template void swapRows_, (NDArray * matrix, int theFirst, int theSecond), SD_FLOAT_TYPES);
-
-template <typename T>
-static void swapRows(T* matrixBuf, sd::LongType const* matrixShape, sd::LongType theFirst, sd::LongType theSecond) {
-  if (theFirst != theSecond) {
-    auto n = shape::sizeAt(matrixShape, -1);
-
-    auto loop = PRAGMA_THREADS_FOR {
-      for (auto i = start; i < stop; i++) {
-        sd::LongType theFirstPos[] = {theFirst, i};
-        sd::LongType theSecondPos[] = {theSecond, i};
-        auto theFirstIndex = shape::getOffset(matrixShape, theFirstPos, 0);
-        auto theSecondIndex = shape::getOffset(matrixShape, theSecondPos, 0);
-        math::sd_swap(matrixBuf[theFirstIndex], matrixBuf[theSecondIndex]);
-      }
-    };
-
-    samediff::Threads::parallel_tad(loop, 0, n, 1);
-  }
-}
-
-void swapRows(NDArray* matrix, int theFirst, int theSecond) {
-  BUILD_SINGLE_SELECTOR(matrix->dataType(), swapRows_, (matrix, theFirst, theSecond), SD_FLOAT_TYPES);
-}
-
-template <typename T>
-static void invertLowerMatrix_(NDArray* inputMatrix, NDArray* invertedMatrix) {
-  int n = inputMatrix->rows();
-  invertedMatrix->setIdentity();
-
-  if (inputMatrix->isIdentityMatrix()) return;
-
-  auto invertDiagonals = PRAGMA_THREADS_FOR {
-    for (int i = start; i < stop; i += increment) invertedMatrix->r<T>(i, i) /= inputMatrix->t<T>(i, i);
-  };
-
-  auto invertSubDiagonals = PRAGMA_THREADS_FOR {
-    for (int i = start; i < stop; i += increment)
-      invertedMatrix->r<T>(i, i - 1) -=
-          (inputMatrix->t<T>(i, i - 1) * invertedMatrix->t<T>(i - 1, i - 1) / inputMatrix->t<T>(i, i));
-  };
-
-  samediff::Threads::parallel_for(invertDiagonals, 0, n, 1);
-  samediff::Threads::parallel_for(invertSubDiagonals, 1, n, 1);
-
-  //        PRAGMA_OMP_PARALLEL_FOR_SIMD
-  for (int i = 1; i < n; i++) {
-    for (int j = 0; j < i - 1; j++)
-      for (int k = 0; k < i; k++)
-        invertedMatrix->r<T>(i, j) -=
-            ((invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k) / inputMatrix->t<T>(i, i)));
-  }
-}
-
-BUILD_SINGLE_TEMPLATE(template void invertLowerMatrix_, (NDArray * inputMatrix, NDArray* invertedMatrix);
-                      , SD_FLOAT_TYPES);
-
-void invertLowerMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-  BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), invertLowerMatrix_, (inputMatrix, invertedMatrix), SD_FLOAT_TYPES);
-}
-
-template <typename T>
-static void _invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-  int n = inputMatrix->rows();
-  invertedMatrix->setIdentity();
-
-  if (inputMatrix->isIdentityMatrix()) {  // the inverse for I is I
-    return;
-  }
-
-  auto invertDiagonals = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i += increment) invertedMatrix->r<T>(i, i) /= inputMatrix->t<T>(i, i);
-  };
-
-  // PRAGMA_OMP_PARALLEL_FOR_IF(n > Environment::getInstance().elementwiseThreshold())
-  auto invertUpDiagonals = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i += increment)
-      invertedMatrix->r<T>(i, i + 1) -=
-          (inputMatrix->t<T>(i, i + 1) * invertedMatrix->t<T>(i + 1, i + 1) / inputMatrix->t<T>(i, i));
-  };
-
-  samediff::Threads::parallel_for(invertDiagonals, 0, n, 1);
-  samediff::Threads::parallel_for(invertUpDiagonals, 0, n - 1, 1);
-
-  //        PRAGMA_OMP_PARALLEL_FOR_SIMD
-  for (auto i = n - 2; i >= 0; i--) {
-    for (auto j = i + 2; j < n; j++)
-      for (auto k = i; k < n; k++)
-        invertedMatrix->r<T>(i, j) -=
-            ((invertedMatrix->t<T>(k, j) * inputMatrix->t<T>(i, k) / inputMatrix->t<T>(i, i)));
-  }
-}
-
-BUILD_SINGLE_TEMPLATE(template void _invertUpperMatrix, (NDArray * inputMatrix, NDArray* invertedMatrix);
-                      , SD_FLOAT_TYPES);
-
-void invertUpperMatrix(NDArray* inputMatrix, NDArray* invertedMatrix) {
-  BUILD_SINGLE_SELECTOR(inputMatrix->dataType(), _invertUpperMatrix, (inputMatrix, invertedMatrix), SD_FLOAT_TYPES);
+static int factorizeMatrix(const NDArray& matrix, std::vector<T>& factors, std::vector<int>& pivots, int threads) {
+  const auto n = matrix.sizeAt(-1);
+  factors.resize(n * n);
+  pivots.resize(n);
+  loadMatrix(matrix, factors.data());
+  return luFactorize<T>(n, factors.data(), n, pivots.data(), threads);
 }
 
 template <typename T, typename I>
 static NDArray lup_(LaunchContext* context, NDArray* input, NDArray* compound, NDArray* permutation) {
-  const int rowNum = input->rows();
-  const int columnNum = input->columns();
-
-  NDArray determinant = NDArrayFactory::create<T>(1.f, context);
-  NDArray compoundMatrix = *input;                   // copy
-  NDArray permutationMatrix(input, false, context);  // has same shape as input and contiguous strides
-  permutationMatrix.setIdentity();
-
-  T pivotValue;  // = T(0.0);
-  int pivot;     // = -1;
-  int swapCount = 0;
-
-  for (int i = 0; i < rowNum; i++) {
-    pivotValue = T(0.0);
-    pivot = -1;
-    // PRAGMA_OMP_PARALLEL_FOR //_ARGS(firstprivate(pivot,pivotValue))
-    for (int rowCounter = i; rowCounter < rowNum; rowCounter++) {
-      if (sd::math::sd_abs(compoundMatrix.t<T>(rowCounter, i)) > pivotValue) {
-        pivotValue = sd::math::sd_abs(compoundMatrix.t<T>(rowCounter, i));
-        pivot = rowCounter;
-      }
-    }
+  const auto n = input->rows();
 
-    if (pivotValue > DataTypeUtils::min_positive<T>()) {
-      swapRows(&compoundMatrix, pivot, i);
-      swapRows(&permutationMatrix, pivot, i);
-      if (pivot != i) swapCount++;
+  std::vector<T> factors;
+  std::vector<int> pivots;
+  factorizeMatrix(*input, factors, pivots, sd::Environment::getInstance().maxMasterThreads());
 
-      for (int j = i + 1; j < rowNum; j++) {
-        compoundMatrix.r<T>(j, i) /= compoundMatrix.t<T>(i, i);
-        // PRAGMA_OMP_PARALLEL_FOR
-        for (int k = i + 1; k < rowNum; k++) {
-          compoundMatrix.r<T>(j, k) -= compoundMatrix.t<T>(j, i) * compoundMatrix.t<T>(i, k);
-        }
-      }
-    }
-  }
+  T determinant = luOddPermutation(pivots.data(), n) ? T(-1.f) : T(1.f);
+  for (sd::LongType e = 0; e < n; e++) determinant *= factors[e * n + e];
 
-  for (int e = 0; e < rowNum; e++) {
-    determinant *= compoundMatrix.e<T>(e, e);
-  }
-  if (swapCount % 2) determinant = -determinant;
-  if (compound != nullptr) compound->assign(compoundMatrix);
+  if (compound != nullptr) storeMatrix(factors.data(), *compound);
   if (permutation != nullptr) {
-    auto permutaionVector = NDArrayFactory::create('c', {rowNum}, DataTypeUtils::fromT<I>(), input->getContext());
-    for (auto i = 0; i < rowNum; i++) {
-      for (auto j = 0; j < columnNum; j++) {
-        if (permutationMatrix.t<T>(i, j) != 0) {
-          permutaionVector.template r<I>(i) = j;
-        }
-      }
-    }
-    if (permutationMatrix.isSameShape(permutation))
-      permutation->assign(permutationMatrix);
-    else if (permutation->isSameShape(permutaionVector)) {
-      permutation->assign(permutaionVector);
+    auto rows = luPermutation(pivots.data(), n);
+    if (permutation->isSameShape(input)) {
+      permutation->nullify();
+      for (sd::LongType i = 0; i < n; i++) permutation->p(i, rows[i], 1);
+    } else if (permutation->rankOf() == 1 && permutation->lengthOf() == n) {
+      for (sd::LongType i = 0; i < n; i++) permutation->p(i, rows[i]);
     }
   }
-  return determinant;
+
+  return NDArrayFactory::create<T>(determinant, context);
 }
 
 BUILD_DOUBLE_TEMPLATE(template NDArray lup_,
                       (LaunchContext * context, NDArray* input, NDArray* output, NDArray* permutation), SD_FLOAT_TYPES,
                       SD_INDEXING_TYPES);
-/*
- * lu decomposition with naive algorithm with partial pivoting
- * */
-template <typename T, typename I>
-static I argmaxCol(I column, T* compoundBuffer, sd::LongType const* compoundShape) {
-  auto rowNum = shape::sizeAt(compoundShape, 0);
-  sd::LongType xInitial[] = {column, column};
-  auto xInitialIndex = shape::getOffset(compoundShape, xInitial, 0);
-  auto maxValue = T(0);  // sd::math::sd_abs(compoundBuffer[xInitialIndex]);
-  auto result = -1;
-  // auto loop = PRAGMA_THREADS_FOR {
-  auto start = column;
-  auto stop = rowNum;
-  auto increment = 1;
-  for (auto rowCounter = start; rowCounter < stop; rowCounter++) {
-    sd::LongType xPos[] = {rowCounter, column};
-    auto xIndex = shape::getOffset(compoundShape, xPos, 0);
-    if (sd::math::sd_abs(compoundBuffer[xIndex]) > maxValue) {
-      maxValue = sd::math::sd_max(maxValue, sd::math::sd_abs(compoundBuffer[xIndex]));
-      result = rowCounter;
-    }
-  }
-  //};
-  // samediff::Threads::parallel_for(loop, column, rowNum, 1);
-  return result;
-}
-
-template <typename T>
-void processColumns(int currentRow, int rowNum, T* compoundBuf, sd::LongType const* compoundShape) {
-  sd::LongType xDiag[] = {currentRow, currentRow};
-  auto diagIndex = shape::getOffset(compoundShape, xDiag, 0);
-  auto loop = PRAGMA_THREADS_FOR {
-    for (auto j = start; j < stop; j++) {
-      sd::LongType xRow[] = {j, currentRow};
-      auto rowIndex = shape::getOffset(compoundShape, xRow, 0);
-      compoundBuf[rowIndex] /= compoundBuf[diagIndex];  // output->t<T>(i, i);
-      for (int k = currentRow + 1; k < rowNum; k++) {
-        sd::LongType yRow[] = {j, k};
-        sd::LongType yCol[] = {currentRow, k};
-        auto rowIndexY = shape::getOffset(compoundShape, yRow, 0);
-        auto colIndex = shape::getOffset(compoundShape, yCol, 0);
-        compoundBuf[rowIndexY] -= compoundBuf[rowIndex] * compoundBuf[colIndex];
-      }
-    }
-  };
-  samediff::Threads::parallel_tad(loop, currentRow + 1, rowNum, 1);
-}
 
 template <typename T>
 static void doolitleLU(LaunchContext* context, NDArray* compound, sd::LongType rowNum) {
@@ -279,47 +98,37 @@ static void doolitleLU(LaunchContext* context, NDArray* compound, sd::LongType r
   }
 }
 
-template <typename T, typename I>
-static void luNN_(LaunchContext* context, NDArray* compound, NDArray* permutation, sd::LongType rowNum) {
-  // const int rowNum = compound->rows();
-  //        const int columnNum = output->columns();
-  if (permutation) {  // LUP algorithm
-    permutation->linspace(0);
-    auto permutationBuf = permutation->bufferAsT<I>();  // dataBuffer()->primaryAsT<I>();
-    auto compoundBuf = compound->bufferAsT<T>();
-    auto compoundShape = compound->shapeInfo();
-    auto permutationShape = permutation->shapeInfo();
-    for (auto i = 0; i < rowNum - 1; i++) {
-      auto pivotIndex = argmaxCol(i, compoundBuf, compoundShape);
-      if (pivotIndex < 0) {
-        throw std::runtime_error("helpers::luNN_: input matrix is singular.");
-      }
-      math::sd_swap(permutationBuf[shape::getIndexOffset(i, permutationShape)],
-                    permutationBuf[shape::getIndexOffset(pivotIndex, permutationShape)]);
-      swapRows(compoundBuf, compoundShape, i, pivotIndex);
-
-      processColumns(i, rowNum, compoundBuf, compoundShape);
-    }
-  } else {  // Doolitle algorithm with LU decomposition
-    doolitleLU<T>(context, compound, rowNum);
-  }
-}
-
 template <typename T, typename I>
 static void lu_(LaunchContext* context, NDArray* input, NDArray* output, NDArray* permutationVectors) {
-  auto n = input->sizeAt(-1);
+  const auto n = input->sizeAt(-1);
 
-  output->assign(input);  // fill up output tensor with zeros
+  output->assign(input);
   ResultSet outputs = output->allTensorsAlongDimension({-2, -1});
-  ResultSet permutations;
-  if (permutationVectors) permutations = permutationVectors->allTensorsAlongDimension({-1});
 
-  auto loop = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      luNN_<T, I>(context, outputs.at(i), permutationVectors ? permutations.at(i) : nullptr, n);
-    }
-  };
-  samediff::Threads::parallel_for(loop, 0, outputs.size(), 1);
+  if (permutationVectors == nullptr) {  // Doolitle algorithm with LU decomposition
+    auto loop = PRAGMA_THREADS_FOR {
+      for (auto i = start; i < stop; i++) doolitleLU<T>(context, outputs.at(i), n);
+    };
+    samediff::Threads::parallel_for(loop, 0, outputs.size(), 1);
+    return;
+  }
+
+  ResultSet permutations = permutationVectors->allTensorsAlongDimension({-1});
+  std::atomic<bool> singular(false);
+  forEachMatrix(outputs.size(), n * n * n, [&](sd::LongType i, int threads) {
+    std::vector<T> factors;
+    std::vector<int> pivots;
+    const auto info = factorizeMatrix(*outputs.at(i), factors, pivots, threads);
+    // a zero column before the last step leaves nothing to pivot on
+    if (info > 0 && info < n) singular = true;
+
+    storeMatrix(factors.data(), *outputs.at(i));
+    auto rows = luPermutation(pivots.data(), n);
+    auto permutation = permutations.at(i);
+    for (sd::LongType j = 0; j < n; j++) permutation->r<I>(j) = static_cast<I>(rows[j]);
+  });
+
+  if (singular) throw std::runtime_error("helpers::lu_: input matrix is singular.");
 }
 
 void lu(LaunchContext* context, NDArray* input, NDArray* output, NDArray* permutation) {
@@ -327,21 +136,20 @@ void lu(LaunchContext* context, NDArray* input, NDArray* output, NDArray* permut
                         (context, input, output, permutation), SD_FLOAT_TYPES, SD_INDEXING_TYPES);
 }
 
-//    BUILD_DOUBLE_TEMPLATE(template NDArray lu_, (LaunchContext *context, NDArray* input, NDArray* output, NDArray*
-//    permutation), SD_FLOAT_TYPES, SD_INDEXING_TYPES);
-
 template <typename T>
 static sd::Status determinant_(LaunchContext* context, NDArray* input, NDArray* output) {
-  sd::LongType n = input->sizeAt(-1);
-  sd::LongType n2 = n * n;
+  const auto n = input->sizeAt(-1);
+  ResultSet matrices = input->allTensorsAlongDimension({-2, -1});
 
-  auto matrix =
-      NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), context);  //, block.getWorkspace());
+  forEachMatrix(matrices.size(), n * n * n, [&](sd::LongType e, int threads) {
+    std::vector<T> factors;
+    std::vector<int> pivots;
+    factorizeMatrix(*matrices.at(e), factors, pivots, threads);
 
-  for (int e = 0; e < output->lengthOf(); e++) {
-    for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) matrix.p(row, input->e<T>(k));
-    output->p(e, lup_<T, int>(context, &matrix, (NDArray*)nullptr, (NDArray*)nullptr));
-  }
+    T determinant = luOddPermutation(pivots.data(), n) ? T(-1.f) : T(1.f);
+    for (sd::LongType i = 0; i < n; i++) determinant *= factors[i * n + i];
+    output->r<T>(e) = determinant;
+  });
 
   return sd::Status::OK;
 }
@@ -352,18 +160,23 @@ sd::Status determinant(sd::LaunchContext* context, NDArray* input, NDArray* outp
 
 template <typename T>
 sd::Status logAbsDeterminant_(LaunchContext* context, NDArray* input, NDArray* output) {
-  sd::LongType n = input->sizeAt(-1);
-  sd::LongType n2 = n * n;
-
-  NDArray matrix =
-      NDArrayFactory::create(input->ordering(), {n, n}, input->dataType(), context);  //, block.getWorkspace());
-  for (int e = 0; e < output->lengthOf(); e++) {
-    for (int k = e * n2, row = 0; k < (e + 1) * n2; ++k, ++row) {
-      matrix.p(row, input->e<T>(k));
+  const auto n = input->sizeAt(-1);
+  ResultSet matrices = input->allTensorsAlongDimension({-2, -1});
+
+  forEachMatrix(matrices.size(), n * n * n, [&](sd::LongType e, int threads) {
+    std::vector<T> factors;
+    std::vector<int> pivots;
+    factorizeMatrix(*matrices.at(e), factors, pivots, threads);
+
+    // summed logarithms of the pivots don't under- or overflow the way the determinant does on large matrices
+    T logDeterminant = T(0.f);
+    for (sd::LongType i = 0; i < n; i++) {
+      const T pivot = sd::math::sd_abs<T>(factors[i * n + i]);
+      if (pivot == T(0.f)) return;
+      logDeterminant += sd::math::sd_log<T, T>(pivot);
     }
-    NDArray det = lup_<T, int>(context, &matrix, (NDArray*)nullptr, (NDArray*)nullptr);
-    if (det.e<T>(0) != 0.f) output->p(e, sd::math::sd_log<T, T>(sd::math::sd_abs(det.t<T>(0))));
-  }
+    output->r<T>(e) = logDeterminant;
+  });
 
   return sd::Status::OK;
 }
@@ -372,112 +185,78 @@ sd::Status logAbsDeterminant(sd::LaunchContext* context, NDArray* input, NDArray
   BUILD_SINGLE_SELECTOR(input->dataType(), return logAbsDeterminant_, (context, input, output), SD_FLOAT_TYPES);
 }
 
+// true when the diagonal has a zero or a value negligible against the largest one
 template <typename T>
-static sd::Status inverse_(LaunchContext* context, NDArray* input, NDArray* output) {
-  auto n = input->sizeAt(-1);
-  auto n2 = n * n;
-  auto totalCount = output->lengthOf() / n2;
-
-  output->assign(0.f);  // fill up output tensor with zeros
-  auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);    //, block.getWorkspace());
-  auto compound = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);  //, block.getWorkspace());
-  auto permutation = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-  auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-  auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
+static bool singularDiagonal(const T* matrix, sd::LongType n) {
+  T minValue = DataTypeUtils::max<T>(), maxValue = T(0.f);
+  for (sd::LongType i = 0; i < n; i++) {
+    const T value = sd::math::sd_abs<T>(matrix[i * n + i]);
+    minValue = sd::math::sd_min<T>(minValue, value);
+    maxValue = sd::math::sd_max<T>(maxValue, value);
+  }
+  return n > 0 && minValue <= maxValue * DataTypeUtils::eps<T>();
+}
 
-  for (int e = 0; e < totalCount; e++) {
-    if (e) matrix.assign(0.f);
+template <typename T>
+static sd::Status inverse_(LaunchContext* context, NDArray* input, NDArray* output) {
+  const auto n = input->sizeAt(-1);
+  ResultSet inputs = input->allTensorsAlongDimension({-2, -1});
+  ResultSet outputs = output->allTensorsAlongDimension({-2, -1});
 
-    for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-      matrix.p(row++, input->e<T>(k));
+  std::atomic<sd::LongType> singular(-1);
+  forEachMatrix(inputs.size(), n * n * n, [&](sd::LongType e, int threads) {
+    std::vector<T> factors;
+    std::vector<int> pivots;
+    const auto info = factorizeMatrix(*inputs.at(e), factors, pivots, threads);
+    if (info > 0 || singularDiagonal(factors.data(), n)) {
+      singular = e;
+      return;
     }
-    T det = lup_<T, int>(context, &matrix, &compound, &permutation).template e<T>(0);
 
-    // FIXME: and how this is going to work on float16?
-    if (sd::math::sd_abs<T>(det) < T(0.000001)) {
-      sd_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", e, det);
-      matrix.printIndexedBuffer("Wrong matrix");
-      return sd::Status::VALIDATION;
-    }
-    lowerMatrix.setIdentity();     // set up U to identity matrix
-    for (int k = 1; k < n; k++) {  // and then put all values under main diagonal on to it
-      for (int j = 0; j < k; j++) lowerMatrix.template r<T>(k, j) = compound.template t<T>(k, j);
-    }
-    upperMatrix.setIdentity();     // set up U to identity matrix
-    for (int k = 0; k < n; k++) {  // and then put all values under main diagonal on to it
-      for (int j = k; j < n; j++) upperMatrix.template r<T>(k, j) = compound.template t<T>(k, j);
-    }
-    invertUpperMatrix(&upperMatrix, &matrix);
+    // A^-1 = U^-1 L^-1 P, so solve L U X = P
+    auto rows = luPermutation(pivots.data(), n);
+    std::vector<T> inverted(n * n, T(0.f));
+    for (sd::LongType i = 0; i < n; i++) inverted[i * n + rows[i]] = T(1.f);
 
-    invertLowerMatrix(&lowerMatrix, &upperMatrix);
+    linalgTrsm<T>(true, true, n, n, factors.data(), n, inverted.data(), n, threads);
+    linalgTrsm<T>(false, false, n, n, factors.data(), n, inverted.data(), n, threads);
+    storeMatrix(inverted.data(), *outputs.at(e));
+  });
 
-    sd::MmulHelper::mmul(&matrix, &upperMatrix, &compound, 1.0, 0.0);
-    sd::MmulHelper::mmul(&compound, &permutation, &matrix, 1.0, 0.0);
-    for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-      output->r<T>(k) = matrix.template t<T>(row++);
-    }
+  if (singular >= 0) {
+    sd_printf("matrix_inverse: The matrix %i has no inverse due to singularity. Quiting...\n", (int)singular.load());
+    return sd::Status::VALIDATION;
   }
 
   return sd::Status::OK;
 }
 
 template <typename T>
-static sd::Status lowerInverse_(LaunchContext* context, NDArray* input, NDArray* output) {
-  auto n = input->sizeAt(-1);
-  auto n2 = n * n;
-  auto totalCount = output->lengthOf() / n2;
-
-  output->assign(0.f);  // fill up output tensor with zeros
-  auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);    //, block.getWorkspace());
-  auto compound = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);  //, block.getWorkspace());
-  auto permutation = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-  auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-  auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-
-  //        auto batchLoop = PRAGMA_THREADS_FOR {
-  for (int e = 0; e < totalCount; e++) {
-    if (e) matrix.assign(0.f);
-
-    for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-      matrix.p(row++, input->e<T>(k));
-    }
-    T det = T(1.f);
-    for (auto i = 0; i < n; i++) {
-      det *= matrix.template t<T>(i, i);
-    }
-
-    // FIXME: and how this is going to work on float16?
-    if (sd::math::sd_abs<T>(det) < T(0.000001)) {
-      sd_printf("matrix_inverse: The matrix %i has no inverse due determinant is %lf. Quiting...\n", e, det);
-      matrix.printIndexedBuffer("Wrong matrix");
-      return sd::Status::VALIDATION;
-    }
-    lowerMatrix.nullify();
-    invertLowerMatrix(&matrix, &lowerMatrix);
+static sd::Status triangularInverse_(LaunchContext* context, NDArray* input, NDArray* output, bool lower) {
+  const auto n = input->sizeAt(-1);
+  ResultSet inputs = input->allTensorsAlongDimension({-2, -1});
+  ResultSet outputs = output->allTensorsAlongDimension({-2, -1});
 
-    for (int k = e * n2, row = 0; k < (e + 1) * n2; k++) {
-      output->r<T>(k) = lowerMatrix.template t<T>(row++);
+  std::atomic<sd::LongType> singular(-1);
+  forEachMatrix(inputs.size(), n * n * n, [&](sd::LongType e, int threads) {
+    std::vector<T> matrix(n * n);
+    loadMatrix(*inputs.at(e), matrix.data());
+    if (singularDiagonal(matrix.data(), n)) {
+      singular = e;
+      return;
     }
-  }
 
-  return sd::Status::OK;
-}
+    std::vector<T> inverted(n * n, T(0.f));
+    for (sd::LongType i = 0; i < n; i++) inverted[i * n + i] = T(1.f);
+    linalgTrsm<T>(lower, false, n, n, matrix.data(), n, inverted.data(), n, threads);
+    storeMatrix(inverted.data(), *outputs.at(e));
+  });
 
-template <typename T>
-static sd::Status upperInverse_(LaunchContext* context, NDArray* input, NDArray* output) {
-  auto n = input->sizeAt(-1);
-  auto n2 = n * n;
-
-  output->nullify();  // fill up output tensor with zeros
-  //        auto matrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context); //,
-  //        block.getWorkspace()); auto lowerMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(),
-  //        context); auto upperMatrix = NDArrayFactory::create('c', {n, n}, DataTypeUtils::fromT<T>(), context);
-  auto inputPart = input->allTensorsAlongDimension({-2, -1});
-  auto outputPart = output->allTensorsAlongDimension({-2, -1});
-  auto totalCount = outputPart.size();  // lengthOf() / n2;
-  for (int e = 0; e < totalCount; e++) {
-    invertUpperMatrix(inputPart.at(e), outputPart.at(e));
+  if (singular >= 0) {
+    sd_printf("matrix_inverse: The matrix %i has no inverse due to singularity. Quiting...\n", (int)singular.load());
+    return sd::Status::VALIDATION;
   }
+
   return sd::Status::OK;
 }
 
@@ -486,37 +265,36 @@ sd::Status inverse(sd::LaunchContext* context, NDArray* input, NDArray* output)
 }
 
 sd::Status lowerInverseFunctor(sd::LaunchContext* context, NDArray* input, NDArray* output) {
-  BUILD_SINGLE_SELECTOR(input->dataType(), return lowerInverse_, (context, input, output), SD_FLOAT_TYPES);
+  BUILD_SINGLE_SELECTOR(input->dataType(), return triangularInverse_, (context, input, output, true), SD_FLOAT_TYPES);
 }
 
 sd::Status upperInverseFunctor(sd::LaunchContext* context, NDArray* input, NDArray* output) {
-  BUILD_SINGLE_SELECTOR(input->dataType(), return upperInverse_, (context, input, output), SD_FLOAT_TYPES);
+  BUILD_SINGLE_SELECTOR(input->dataType(), return triangularInverse_, (context, input, output, false), SD_FLOAT_TYPES);
 }
 
 template <typename T>
 static bool checkCholeskyInput_(sd::LaunchContext* context, NDArray const* input) {
-  // std::unique_ptr<NDArray> matrix(NDArrayFactory::create_('c', {n, n}, input->dataType())); //,
-  // block.getWorkspace());
-  ResultSet lastMatrixList = input->allTensorsAlongDimension({input->rankOf() - 2, input->rankOf() - 1});
-  for (size_t i = 0; i < lastMatrixList.size(); i++) {
-    auto thisMatrix = lastMatrixList.at(i);
-    // check for symmetric
-    for (sd::LongType r = 0; r < thisMatrix->rows(); r++)
-      for (sd::LongType c = 0; c < thisMatrix->columns(); c++)
-        if (sd::math::sd_abs(thisMatrix->e<T>(r, c) - lastMatrixList.at(i)->e<T>(c, r)) >
-            DataTypeUtils::min_positive<T>())
-          return false;
-
-    NDArray output = NDArrayFactory::create<T>(0., context);
-    if (sd::Status::OK != determinant(context, thisMatrix, &output)) return false;
-    if (output.e<T>(0) <= T(0)) return 0;
-    NDArray reversedMatrix(*thisMatrix);
-    if (sd::Status::OK != inverse(context, thisMatrix, &reversedMatrix)) return false;
-    if (sd::Status::OK != determinant(context, &reversedMatrix, &output)) return false;
-    if (output.e<T>(0) <= T(0)) return 0;
-  }
+  const auto n = input->sizeAt(-1);
+  ResultSet matrices = input->allTensorsAlongDimension({input->rankOf() - 2, input->rankOf() - 1});
+
+  // symmetric and positive definite, the latter exactly when the Cholesky factorization succeeds
+  std::atomic<bool> valid(true);
+  forEachMatrix(matrices.size(), n * n * n, [&](sd::LongType i, int threads) {
+    if (!valid) return;
+    std::vector<T> matrix(n * n);
+    loadMatrix(*matrices.at(i), matrix.data());
+
+    for (sd::LongType r = 0; r < n; r++)
+      for (sd::LongType c = r + 1; c < n; c++)
+        if (sd::math::sd_abs<T>(matrix[r * n + c] - matrix[c * n + r]) > DataTypeUtils::min_positive<T>()) {
+          valid = false;
+          return;
+        }
+
+    if (choleskyFactorize<T>(n, matrix.data(), n, threads) != 0) valid = false;
+  });
 
-  return true;
+  return valid;
 }
 
 bool checkCholeskyInput(sd::LaunchContext* context, NDArray const* input) {
@@ -525,37 +303,19 @@ bool checkCholeskyInput(sd::LaunchContext* context, NDArray const* input) {
 
 template <typename T>
 sd::Status cholesky_(LaunchContext* context, NDArray* input, NDArray* output, bool inplace) {
-  auto n = input->sizeAt(-1);
-  auto n2 = n * n;
-  auto totalCount = output->lengthOf() / n2;
-  if (!inplace) output->assign(0.f);  // fill up output tensor with zeros only inplace=false
-
-  std::unique_ptr<NDArray> matrix(
-      NDArrayFactory::create_('c', {n, n}, input->dataType(), context));  //, block.getWorkspace());
-  std::unique_ptr<NDArray> lowerMatrix(NDArrayFactory::create_('c', {n, n}, input->dataType(), context));
-
-  for (int e = 0; e < totalCount; e++) {
-    // fill up matrix
-    for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-      matrix->p(l++, input->e<T>(k));
-    }
-    // if (e) // from the second loop need to zero matrix
-    lowerMatrix->assign(0.f);
-
-    for (sd::LongType col = 0; col < n; col++) {
-      for (sd::LongType row = 0; row < col; row++) {
-        T rowSum = 0;
-        for (sd::LongType k = 0; k < row; ++k) rowSum += (lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(row, k));
-        lowerMatrix->p(col, row, (matrix->e<T>(row, col) - rowSum) / lowerMatrix->e<double>(row, row));
-      }
-      T diagonalSum = 0;
-      for (sd::LongType k = 0; k < col; ++k) diagonalSum += lowerMatrix->e<T>(col, k) * lowerMatrix->e<T>(col, k);
-      lowerMatrix->p(col, col, sd::math::sd_sqrt<T, T>(matrix->e<T>(col, col) - diagonalSum));
-    }
-    for (int k = e * n2, l = 0; k < (e + 1) * n2; k++) {
-      output->p(k, lowerMatrix->e<T>(l++));
-    }
-  }
+  const auto n = input->sizeAt(-1);
+  ResultSet inputs = input->allTensorsAlongDimension({-2, -1});
+  ResultSet outputs = output->allTensorsAlongDimension({-2, -1});
+
+  forEachMatrix(inputs.size(), n * n * n, [&](sd::LongType e, int threads) {
+    std::vector<T> matrix(n * n);
+    loadMatrix(*inputs.at(e), matrix.data());
+    choleskyFactorize<T>(n, matrix.data(), n, threads);
+
+    for (sd::LongType r = 0; r < n; r++)
+      for (sd::LongType c = r + 1; c < n; c++) matrix[r * n + c] = T(0.f);
+    storeMatrix(matrix.data(), *outputs.at(e));
+  });
 
   return sd::Status::OK;
 }
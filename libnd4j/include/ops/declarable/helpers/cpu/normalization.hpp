@@ -0,0 +1,86 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Shared pieces of the single-pass normalization kernels (softmax, log_softmax, layer_norm).
+//
+// The kernels work on dense c-ordered buffers viewed as {outer, axis, inner}: the normalized
+// axis is contiguous when inner == 1 (rows), otherwise `inner` independent sub-arrays are
+// interleaved and are processed together, vectorized along inner (columns).
+//
+#ifndef LIBND4J_HELPERS_CPU_NORMALIZATION_HPP
+#define LIBND4J_HELPERS_CPU_NORMALIZATION_HPP
+#include <array/NDArray.h>
+
+#include <memory>
+#include <type_traits>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// half, bfloat16 and float accumulate in float, double in double
+template <typename T>
+using NormAccumulator = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+struct AxisSplit {
+  sd::LongType outer = 1;
+  sd::LongType axis = 1;
+  sd::LongType inner = 1;
+};
+
+// splits the shape around the consecutive dimensions [first, last]
+SD_INLINE AxisSplit splitAroundAxes(const NDArray& array, int first, int last) {
+  AxisSplit split;
+  for (int d = 0; d < array.rankOf(); d++) {
+    if (d < first)
+      split.outer *= array.sizeAt(d);
+    else if (d <= last)
+      split.axis *= array.sizeAt(d);
+    else
+      split.inner *= array.sizeAt(d);
+  }
+  return split;
+}
+
+SD_INLINE bool isDenseC(const NDArray& array) { return array.ordering() == 'c' && array.ews() == 1; }
+
+// returns the array itself when it is dense and c-ordered, otherwise a dense copy kept alive by holder
+SD_INLINE const NDArray* denseInput(const NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (isDenseC(array)) return &array;
+  holder.reset(new NDArray(array.dup('c')));
+  return holder.get();
+}
+
+// returns the array itself when it is dense and c-ordered, otherwise a dense buffer to be written back
+// with flushDenseOutput
+SD_INLINE NDArray* denseOutput(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (isDenseC(array)) return &array;
+  holder.reset(new NDArray('c', array.getShapeAsVector(), array.dataType(), array.getContext()));
+  return holder.get();
+}
+
+SD_INLINE void flushDenseOutput(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (holder != nullptr) array.assign(*holder);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_CPU_NORMALIZATION_HPP
@@ -24,6 +24,7 @@
 #include <array/NDArrayFactory.h>
 #include <execution/Threads.h>
 #include <helpers/MmulHelper.h>
+#include <ops/declarable/helpers/cpu/linalg.hpp>
 #include <ops/declarable/helpers/qr.h>
 #if NOT_EXCLUDED(OP_qr)
 namespace sd {
@@ -31,78 +32,30 @@ namespace ops {
 namespace helpers {
 
 template <typename T>
-NDArray matrixMinor(NDArray& in, sd::LongType col) {
-  NDArray m = in.ulike();
-  m.setIdentity();
-  m({col, m.rows(), col, m.columns()}).assign(in({col, m.rows(), col, m.columns()}));
+void qrSingle(NDArray* matrix, NDArray* Q, NDArray* R, int threads) {
+  const sd::LongType M = matrix->sizeAt(-2);
+  const sd::LongType N = matrix->sizeAt(-1);
+  const sd::LongType qColumns = Q->sizeAt(-1);
+  const sd::LongType rRows = R->sizeAt(-2);
+  const sd::LongType reflectors = sd::math::sd_min<sd::LongType>(M, N);
 
-  return m;
-}
-
-/* m = I - v v^T */
-template <typename T>
-NDArray vmul(NDArray const& v, int n) {
-  NDArray res('c', {n, n}, v.dataType(), v.getContext());  // x = matrix_new(n, n);
-  T const* vBuf = v.getDataBuffer()->primaryAsT<T>();
-  T* resBuf = res.dataBuffer()->primaryAsT<T>();
-  auto interloop = PRAGMA_THREADS_FOR_2D {
-    for (auto i = start_x; i < n; i += inc_x)
-      for (auto j = start_y; j < n; j += inc_y) resBuf[i * n + j] = -2 * vBuf[i] * vBuf[j] + (i == j ? T(1) : T(0));
-  };
-
-  samediff::Threads::parallel_for(interloop, 0, n, 1, 0, n, 1);
-  return res;
-}
-
-template <typename T>
-void qrSingle(NDArray* matrix, NDArray* Q, NDArray* R, bool const fullMatricies) {
-  sd::LongType M = matrix->sizeAt(-2);
-  sd::LongType N = matrix->sizeAt(-1);
-  auto resQ = fullMatricies ? Q->ulike() : NDArrayFactory::create<T>(matrix->ordering(), {M, M}, Q->getContext());
-  auto resR = fullMatricies ? R->ulike() : matrix->ulike();
-  std::vector<NDArray> q(M);
-
-  NDArray z = *matrix;
-  NDArray e('c', {M}, DataTypeUtils::fromT<T>(), Q->getContext());  // two internal buffers and scalar for squared norm
-
-  for (sd::LongType k = 0; k < N && k < M - 1; k++) {  // loop for columns, but not further then row number
-    e.nullify();
-    z = matrixMinor<T>(z, k);  // minor computing for current column with given matrix z (initally is a input matrix)
+  // blocked Householder QR, R is the upper triangle of the factors
+  std::vector<T> factors(M * N), tau(reflectors);
+  loadMatrix(*matrix, factors.data());
+  qrFactorize<T>(M, N, factors.data(), N, tau.data(), threads);
 
-    auto currentColumn = z({0, 0, k, k + 1});  // retrieve k column from z to x buffer
-    auto norm = currentColumn.reduceAlongDimension(reduce::Norm2, {0});
-    if (matrix->t<T>(k, k) > T(0.f))  // negate on positive matrix diagonal element
-      norm *= T(-1.f);                //.applyTransform(transform::Neg, nullptr, nullptr); //t<T>(0) = -norm.t<T>(0);
-    // e.t<T>(k) = T(1.f); // e - is filled by 0 vector except diagonal element (filled by 1)
-    // auto tE = e;
-    // tE *= norm;
+  std::vector<T> r(rRows * N, T(0.f));
+  for (sd::LongType i = 0; i < rRows && i < M; i++)
+    for (sd::LongType j = i; j < N; j++) r[i * N + j] = factors[i * N + j];
+  storeMatrix(r.data(), *R);
 
-    e.p(k, norm);
-    e += currentColumn;  //  e += tE; // e[i] = x[i] + a * e[i] for each i from 0 to n - 1
-    auto normE = e.reduceAlongDimension(reduce::Norm2, {0});
-    e /= normE;
-    q[k] = vmul<T>(e, M);
-    auto qQ = z.ulike();
-    MmulHelper::matmul(&q[k], &z, &qQ, false, false);
-    z = std::move(qQ);
-  }
-  resQ.assign(q[0]);  //
-                      //        MmulHelper::matmul(&q[0], matrix, &resR, false, false);
-  for (sd::LongType i = 1; i < N && i < M - 1; i++) {
-    auto tempResQ = resQ;
-    MmulHelper::matmul(&q[i], &resQ, &tempResQ, false, false);  // use mmulMxM?
-    resQ = std::move(tempResQ);
-  }
-  MmulHelper::matmul(&resQ, matrix, &resR, false, false);
-  // resR *= -1.f;
-  resQ.transposei();
-  if (fullMatricies) {
-    Q->assign(resQ);
-    R->assign(resR);
-  } else {
-    Q->assign(resQ({0, 0, 0, N}));
-    R->assign(resR({0, N, 0, 0}));
-  }
+  // Q is formed from the reflectors kept below the diagonal
+  const auto used = sd::math::sd_min<sd::LongType>(reflectors, qColumns);
+  std::vector<T> q(M * qColumns, T(0.f));
+  for (sd::LongType i = 0; i < M; i++)
+    for (sd::LongType j = 0; j < used; j++) q[i * qColumns + j] = factors[i * N + j];
+  qrFormQ<T>(M, qColumns, used, q.data(), qColumns, tau.data(), threads);
+  storeMatrix(q.data(), *Q);
 }
 
 template <typename T>
@@ -112,14 +65,12 @@ void qr_(NDArray const* input, NDArray* outputQ, NDArray* outputR, bool const fu
   ResultSet listOutQ(outputQ->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
   ResultSet listOutR(outputR->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
   ResultSet listInput(input->allTensorsAlongDimension({(int)preLastDim, (int)lastDim}));
-  auto batching = PRAGMA_THREADS_FOR {
-    for (auto batch = start; batch < stop; batch++) {
-      // qr here
-      qrSingle<T>(listInput.at(batch), listOutQ.at(batch), listOutR.at(batch), fullMatricies);
-    }
-  };
 
-  samediff::Threads::parallel_tad(batching, 0, listOutQ.size(), 1);
+  // shapes of Q and R already reflect fullMatricies
+  const auto work = input->sizeAt(-2) * input->sizeAt(-1) * outputQ->sizeAt(-1);
+  forEachMatrix(listInput.size(), work, [&](sd::LongType batch, int threads) {
+    qrSingle<T>(listInput.at(batch), listOutQ.at(batch), listOutR.at(batch), threads);
+  });
 }
 
 void qr(sd::LaunchContext* context, NDArray const* input, NDArray* outputQ, NDArray* outputR,
@@ -24,9 +24,11 @@
 #include <helpers/ConstantTadHelper.h>
 #include <helpers/ShapeUtils.h>
 #include <ops/declarable/helpers/activations.h>
+#include <ops/declarable/helpers/cpu/normalization.hpp>
+#include <system/CpuDispatch.h>
 
 #include <numeric>
-#if NOT_EXCLUDED(OP_softmax)
+#if NOT_EXCLUDED(OP_softmax) || NOT_EXCLUDED(OP_log_softmax)
 namespace sd {
 namespace ops {
 namespace helpers {
@@ -77,158 +79,309 @@ void softMaxForVector(sd::LaunchContext* context, const NDArray& input, NDArray&
                         (input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo()), SD_FLOAT_TYPES);
 }
 
-template <typename T>
-void softmax_loop(const T* input, T* output, const sd::LongType* offsets, sd::LongType numOfSubArrs, uint32_t tadLen);
-
-#if defined(_OPENMP) && !defined(__NEC__)
-template <>
-SD_INLINE void softmax_loop(const float* input, float* output, const sd::LongType* offsets, sd::LongType numOfSubArrs,
-                            uint32_t tadLen) {
-#pragma omp parallel for default(shared)
-  for (sd::LongType i = 0; i < numOfSubArrs; i++) {
-    auto inBuff = input + offsets[i];
-    auto outBuff = output + offsets[i];
-
-    float max = -DataTypeUtils::max<float>();
-    float sum = 0.f;
-
-#pragma omp simd reduction(max : max)
-    for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<float>(max, inBuff[j]);
-
-#pragma omp simd reduction(+ : sum)
-    for (sd::Unsigned j = 0; j < tadLen; ++j) {
-      float temp = sd::math::sd_exp<float, float>(inBuff[j] - max);
-      outBuff[j] = temp;
-      sum += temp;
+//////////////////////////////////////////////////////////////////////////
+// Single-pass softmax family.
+//
+// Statistics are computed with an online max and sum: the running sum of exponents is rescaled
+// whenever the running max grows, and the max is updated once per block, so every element costs
+// one exponent and the input is streamed once before the output pass.
+// Contiguous sub-arrays (softmax along the last dimension) are processed row by row; sub-arrays
+// along other dimensions are interleaved in memory and up to kSoftmaxTile of them are processed
+// together, vectorized across sub-arrays.
+
+// row elements per online max update
+constexpr sd::LongType kSoftmaxBlock = 256;
+// interleaved sub-arrays processed together
+constexpr sd::LongType kSoftmaxTile = 256;
+// axis positions per online max update of a tile
+constexpr sd::LongType kSoftmaxTileBlock = 8;
+
+template <typename T, typename A>
+static SD_INLINE void softmaxRowStats(const T* x, const sd::LongType len, A& max, A& sum) {
+  max = -DataTypeUtils::infOrMax<A>();
+  sum = static_cast<A>(0);
+  for (sd::LongType b = 0; b < len; b += kSoftmaxBlock) {
+    const sd::LongType e = sd::math::sd_min<sd::LongType>(b + kSoftmaxBlock, len);
+    A blockMax = max;
+    PRAGMA_OMP_SIMD_MAX(blockMax)
+    for (sd::LongType j = b; j < e; j++) blockMax = sd::math::sd_max<A>(blockMax, static_cast<A>(x[j]));
+    if (blockMax > max) {
+      sum *= sd::math::sd_exp<A, A>(max - blockMax);
+      max = blockMax;
     }
-
-    for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[j] /= sum;
+    A blockSum = static_cast<A>(0);
+    PRAGMA_OMP_SIMD_SUM(blockSum)
+    for (sd::LongType j = b; j < e; j++) blockSum += sd::math::sd_exp<A, A>(static_cast<A>(x[j]) - max);
+    sum += blockSum;
   }
 }
-#else
-template <>
-SD_INLINE void softmax_loop(const float* input, float* output, const sd::LongType* offsets, sd::LongType numOfSubArrs,
-                            uint32_t tadLen) {
-  auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      auto inBuff = input + offsets[i];
-      auto outBuff = output + offsets[i];
-
-      float max = -DataTypeUtils::max<float>();
-      float sum = 0.f;
-
-      for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<float>(max, inBuff[j]);
-
-      for (sd::Unsigned j = 0; j < tadLen; ++j) {
-        float temp = sd::math::sd_exp<float, float>(inBuff[j] - max);
-        outBuff[j] = temp;
-        sum += temp;
-      }
 
-      for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[j] /= sum;
+// x points to the first element of the tile, consecutive axis positions are `inner` apart
+template <typename T, typename A>
+static SD_INLINE void softmaxTileStats(const T* x, const sd::LongType len, const sd::LongType inner,
+                                       const sd::LongType width, A* max, A* sum) {
+  A blockMax[kSoftmaxTile];
+  for (sd::LongType i = 0; i < width; i++) {
+    max[i] = -DataTypeUtils::infOrMax<A>();
+    sum[i] = static_cast<A>(0);
+  }
+  for (sd::LongType b = 0; b < len; b += kSoftmaxTileBlock) {
+    const sd::LongType e = sd::math::sd_min<sd::LongType>(b + kSoftmaxTileBlock, len);
+    for (sd::LongType i = 0; i < width; i++) blockMax[i] = max[i];
+    for (sd::LongType k = b; k < e; k++) {
+      const T* row = x + k * inner;
+      PRAGMA_OMP_SIMD
+      for (sd::LongType i = 0; i < width; i++) blockMax[i] = sd::math::sd_max<A>(blockMax[i], static_cast<A>(row[i]));
     }
-  };
-
-  samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+    PRAGMA_OMP_SIMD
+    for (sd::LongType i = 0; i < width; i++) {
+      const A scale = blockMax[i] > max[i] ? sd::math::sd_exp<A, A>(max[i] - blockMax[i]) : static_cast<A>(1);
+      sum[i] *= scale;
+      max[i] = sd::math::sd_max<A>(max[i], blockMax[i]);
+    }
+    for (sd::LongType k = b; k < e; k++) {
+      const T* row = x + k * inner;
+      PRAGMA_OMP_SIMD
+      for (sd::LongType i = 0; i < width; i++) sum[i] += sd::math::sd_exp<A, A>(static_cast<A>(row[i]) - max[i]);
+    }
+  }
 }
 
-#endif
-
-template <typename T>
-SD_INLINE void softmax_loop(const T* input, T* output, const sd::LongType* offsets, sd::LongType numOfSubArrs,
-                            uint32_t tadLen) {
-  auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      auto inBuff = input + offsets[i];
-      auto outBuff = output + offsets[i];
-
-      T max = -DataTypeUtils::max<T>();
-      T sum(0.f);
-
-      PRAGMA_OMP_SIMD_MAX_2(max)
-      for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<T>(max, inBuff[j]);
-      PRAGMA_OMP_SIMD_SUM(sum)
-      for (sd::Unsigned j = 0; j < tadLen; ++j) {
-        T temp = sd::math::sd_exp<T, T>(inBuff[j] - max);
-        outBuff[j] = temp;
-        sum += temp;
+// Kernels below run one thread's share of sub-arrays and are multi-versioned through isaDispatch.
+// Offsets are in elements of the dense {outer, axis, inner} buffer.
+
+// rows [start, stop) of len contiguous elements
+template <typename T, bool Log>
+struct SoftmaxRowsKernel {
+  static SD_INLINE void run(const T* x, T* z, const sd::LongType len, const sd::LongType start,
+                            const sd::LongType stop) {
+    using A = NormAccumulator<T>;
+    for (auto o = start; o < stop; o++) {
+      const T* xr = x + o * len;
+      T* zr = z + o * len;
+      A max, sum;
+      softmaxRowStats(xr, len, max, sum);
+      if (Log) {
+        const A shift = max + sd::math::sd_log<A, A>(sum);
+        PRAGMA_OMP_SIMD
+        for (sd::LongType j = 0; j < len; j++) zr[j] = static_cast<T>(static_cast<A>(xr[j]) - shift);
+      } else {
+        const A inv = static_cast<A>(1) / sum;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType j = 0; j < len; j++)
+          zr[j] = static_cast<T>(sd::math::sd_exp<A, A>(static_cast<A>(xr[j]) - max) * inv);
+      }
+    }
+  }
+};
+
+// tiles [start, stop) of up to kSoftmaxTile interleaved sub-arrays, `tiles` tiles per outer index
+template <typename T, bool Log>
+struct SoftmaxTilesKernel {
+  static SD_INLINE void run(const T* x, T* z, const sd::LongType len, const sd::LongType inner,
+                            const sd::LongType tiles, const sd::LongType start, const sd::LongType stop) {
+    using A = NormAccumulator<T>;
+    A max[kSoftmaxTile], sum[kSoftmaxTile];
+    for (auto t = start; t < stop; t++) {
+      const sd::LongType i0 = (t % tiles) * kSoftmaxTile;
+      const sd::LongType offset = (t / tiles) * len * inner + i0;
+      const sd::LongType width = sd::math::sd_min<sd::LongType>(kSoftmaxTile, inner - i0);
+
+      softmaxTileStats(x + offset, len, inner, width, max, sum);
+      for (sd::LongType i = 0; i < width; i++)
+        sum[i] = Log ? max[i] + sd::math::sd_log<A, A>(sum[i]) : static_cast<A>(1) / sum[i];
+
+      for (sd::LongType k = 0; k < len; k++) {
+        const T* xr = x + offset + k * inner;
+        T* zr = z + offset + k * inner;
+        if (Log) {
+          PRAGMA_OMP_SIMD
+          for (sd::LongType i = 0; i < width; i++) zr[i] = static_cast<T>(static_cast<A>(xr[i]) - sum[i]);
+        } else {
+          PRAGMA_OMP_SIMD
+          for (sd::LongType i = 0; i < width; i++)
+            zr[i] = static_cast<T>(sd::math::sd_exp<A, A>(static_cast<A>(xr[i]) - max[i]) * sum[i]);
+        }
+      }
+    }
+  }
+};
+
+// softmax:     gradI = y * (gradO - sum(y * gradO))
+// log_softmax: gradI = gradO - y * sum(gradO)
+// where y = softmax(input) is recomputed from the online statistics instead of being stored
+template <typename T, bool Log>
+struct SoftmaxBpRowsKernel {
+  static SD_INLINE void run(const T* x, const T* g, T* z, const sd::LongType len, const sd::LongType start,
+                            const sd::LongType stop) {
+    using A = NormAccumulator<T>;
+    for (auto o = start; o < stop; o++) {
+      const T* xr = x + o * len;
+      const T* gr = g + o * len;
+      T* zr = z + o * len;
+      A max, sum;
+      softmaxRowStats(xr, len, max, sum);
+      const A inv = static_cast<A>(1) / sum;
+      A dot = static_cast<A>(0);
+      if (Log) {
+        PRAGMA_OMP_SIMD_SUM(dot)
+        for (sd::LongType j = 0; j < len; j++) dot += static_cast<A>(gr[j]);
+      } else {
+        PRAGMA_OMP_SIMD_SUM(dot)
+        for (sd::LongType j = 0; j < len; j++)
+          dot += sd::math::sd_exp<A, A>(static_cast<A>(xr[j]) - max) * inv * static_cast<A>(gr[j]);
+      }
+      PRAGMA_OMP_SIMD
+      for (sd::LongType j = 0; j < len; j++) {
+        const A y = sd::math::sd_exp<A, A>(static_cast<A>(xr[j]) - max) * inv;
+        const A grad = static_cast<A>(gr[j]);
+        zr[j] = static_cast<T>(Log ? grad - y * dot : y * (grad - dot));
+      }
+    }
+  }
+};
+
+template <typename T, bool Log>
+struct SoftmaxBpTilesKernel {
+  static SD_INLINE void run(const T* x, const T* g, T* z, const sd::LongType len, const sd::LongType inner,
+                            const sd::LongType tiles, const sd::LongType start, const sd::LongType stop) {
+    using A = NormAccumulator<T>;
+    A max[kSoftmaxTile], inv[kSoftmaxTile], dot[kSoftmaxTile];
+    for (auto t = start; t < stop; t++) {
+      const sd::LongType i0 = (t % tiles) * kSoftmaxTile;
+      const sd::LongType offset = (t / tiles) * len * inner + i0;
+      const sd::LongType width = sd::math::sd_min<sd::LongType>(kSoftmaxTile, inner - i0);
+
+      softmaxTileStats(x + offset, len, inner, width, max, inv);
+      for (sd::LongType i = 0; i < width; i++) {
+        inv[i] = static_cast<A>(1) / inv[i];
+        dot[i] = static_cast<A>(0);
+      }
+      for (sd::LongType k = 0; k < len; k++) {
+        const T* xr = x + offset + k * inner;
+        const T* gr = g + offset + k * inner;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < width; i++)
+          dot[i] += Log ? static_cast<A>(gr[i])
+                        : sd::math::sd_exp<A, A>(static_cast<A>(xr[i]) - max[i]) * inv[i] * static_cast<A>(gr[i]);
+      }
+      for (sd::LongType k = 0; k < len; k++) {
+        const T* xr = x + offset + k * inner;
+        const T* gr = g + offset + k * inner;
+        T* zr = z + offset + k * inner;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType i = 0; i < width; i++) {
+          const A y = sd::math::sd_exp<A, A>(static_cast<A>(xr[i]) - max[i]) * inv[i];
+          const A grad = static_cast<A>(gr[i]);
+          zr[i] = static_cast<T>(Log ? grad - y * dot[i] : y * (grad - dot[i]));
+        }
       }
-
-      for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[j] /= sum;
     }
-  };
+  }
+};
+
+template <typename T, bool Log>
+static void softmax_(const NDArray& input, NDArray& output, const int dimension) {
+  if (input.lengthOf() == 0) return;
+
+  std::unique_ptr<NDArray> inHolder, outHolder;
+  const NDArray* in = denseInput(input, inHolder);
+  NDArray* out = denseOutput(output, outHolder);
+  const int dim = dimension < 0 ? dimension + input.rankOf() : dimension;
+  const auto split = splitAroundAxes(*in, dim, dim);
+  const T* x = in->bufferAsT<T>();
+  T* z = out->bufferAsT<T>();
+
+  if (split.inner == 1) {
+    auto func = PRAGMA_THREADS_FOR {
+      isaDispatch<SoftmaxRowsKernel<T, Log>>(x, z, split.axis, static_cast<sd::LongType>(start),
+                                             static_cast<sd::LongType>(stop));
+    };
+    samediff::Threads::parallel_tad(func, 0, split.outer);
+  } else {
+    const sd::LongType tiles = (split.inner + kSoftmaxTile - 1) / kSoftmaxTile;
+    auto func = PRAGMA_THREADS_FOR {
+      isaDispatch<SoftmaxTilesKernel<T, Log>>(x, z, split.axis, split.inner, tiles, static_cast<sd::LongType>(start),
+                                              static_cast<sd::LongType>(stop));
+    };
+    samediff::Threads::parallel_tad(func, 0, split.outer * tiles);
+  }
 
-  samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+  flushDenseOutput(output, outHolder);
 }
 
-//////////////////////////////////////////////////////////////////////////
-template <typename T>
-static void softmax_(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  const int rank = input.rankOf();
-
-  if (input.isVector()) {
-    if (rank == 1 || input.sizeAt(dimension) != 1)
-      softMaxForVector_<T>(input.buffer(), input.shapeInfo(), output.buffer(), output.shapeInfo());
-    else
-      output = 1.;
-  } else if (input.isSameShapeStrict(output)) {
-    TadPack tadPack = sd::ConstantTadHelper::getInstance().tadForDimensions(input.shapeInfo(), dimension);
-    auto tadShapeInfo = tadPack.primaryShapeInfo();
-    auto tadOffsets = tadPack.primaryOffsets();
-    const sd::Unsigned numOfSubArrs = tadPack.numberOfTads();
-    const sd::Unsigned tadLen = shape::length(tadShapeInfo);
-
-    if (shape::elementWiseStride(tadShapeInfo) == 1) {
-      auto inBuff = input.bufferAsT<T>();
-      T* outBuff = output.bufferAsT<T>();
-
-      softmax_loop(inBuff, outBuff, tadOffsets, numOfSubArrs, tadLen);
-    } else {
-      sd::Unsigned inShapeInfoCast[SD_MAX_RANK];
-      bool canCast = sd::DataTypeUtils::castShapeInfo(tadShapeInfo, inShapeInfoCast);
-
-      auto offsets = new sd::LongType[tadLen];
-      shape::calcOffsets(tadShapeInfo, offsets);
-
-      auto func = PRAGMA_THREADS_FOR {
-        for (auto i = start; i < stop; i++) {
-          auto inBuff = input.bufferAsT<T>() + tadOffsets[i];
-          auto outBuff = output.bufferAsT<T>() + tadOffsets[i];
+template <typename T, bool Log>
+static void softmaxBp_(const NDArray& input, const NDArray& gradO, NDArray& gradI, const int dimension) {
+  if (input.lengthOf() == 0) return;
+
+  std::unique_ptr<NDArray> inHolder, gradOHolder, gradIHolder;
+  const NDArray* in = denseInput(input, inHolder);
+  const NDArray* eps = denseInput(gradO, gradOHolder);
+  NDArray* out = denseOutput(gradI, gradIHolder);
+  const int dim = dimension < 0 ? dimension + input.rankOf() : dimension;
+  const auto split = splitAroundAxes(*in, dim, dim);
+  const T* x = in->bufferAsT<T>();
+  const T* g = eps->bufferAsT<T>();
+  T* z = out->bufferAsT<T>();
+
+  if (split.inner == 1) {
+    auto func = PRAGMA_THREADS_FOR {
+      isaDispatch<SoftmaxBpRowsKernel<T, Log>>(x, g, z, split.axis, static_cast<sd::LongType>(start),
+                                               static_cast<sd::LongType>(stop));
+    };
+    samediff::Threads::parallel_tad(func, 0, split.outer);
+  } else {
+    const sd::LongType tiles = (split.inner + kSoftmaxTile - 1) / kSoftmaxTile;
+    auto func = PRAGMA_THREADS_FOR {
+      isaDispatch<SoftmaxBpTilesKernel<T, Log>>(x, g, z, split.axis, split.inner, tiles,
+                                                static_cast<sd::LongType>(start), static_cast<sd::LongType>(stop));
+    };
+    samediff::Threads::parallel_tad(func, 0, split.outer * tiles);
+  }
 
-          T max = -DataTypeUtils::max<T>();
-          T sum = 0.f;
+  flushDenseOutput(gradI, gradIHolder);
+}
 
-          for (sd::Unsigned j = 0; j < tadLen; ++j) max = sd::math::sd_max<T>(max, inBuff[offsets[j]]);
+template <typename T>
+static void softmaxForward_(const NDArray& input, NDArray& output, const int dimension, const bool log) {
+  if (log)
+    softmax_<T, true>(input, output, dimension);
+  else
+    softmax_<T, false>(input, output, dimension);
+}
 
-          for (sd::Unsigned j = 0; j < tadLen; ++j) {
-            T temp = sd::math::sd_exp<T, T>(inBuff[offsets[j]] - max);
-            outBuff[offsets[j]] = temp;
-            sum += temp;
-          }
+template <typename T>
+static void softmaxBackward_(const NDArray& input, const NDArray& gradO, NDArray& gradI, const int dimension,
+                             const bool log) {
+  if (log)
+    softmaxBp_<T, true>(input, gradO, gradI, dimension);
+  else
+    softmaxBp_<T, false>(input, gradO, gradI, dimension);
+}
 
-          for (sd::Unsigned j = 0; j < tadLen; ++j) outBuff[offsets[j]] /= sum;
-        }
-      };
+///////////////////////////////////////////////////////////////////
+void softmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmaxForward_, (input, output, dimension, false), SD_FLOAT_TYPES);
+}
 
-      samediff::Threads::parallel_tad(func, 0, numOfSubArrs);
+///////////////////////////////////////////////////////////////////
+void logSoftmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmaxForward_, (input, output, dimension, true), SD_FLOAT_TYPES);
+}
 
-      delete[] offsets;
-    }
-  } else {
-    NDArray max = input.reduceAlongDimension(sd::reduce::Max, {dimension}, true);
-    input.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), max, output, false);
-    output.applyTransform(sd::transform::Exp, output);
-    NDArray sum = output.reduceAlongDimension(sd::reduce::Sum, {dimension}, true);
-    output /= sum;
-  }
+///////////////////////////////////////////////////////////////////
+void softmaxBp(sd::LaunchContext* context, const NDArray& input, const NDArray& gradO, NDArray& gradI,
+               const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmaxBackward_, (input, gradO, gradI, dimension, false), SD_FLOAT_TYPES);
 }
 
 ///////////////////////////////////////////////////////////////////
-void softmax(sd::LaunchContext* context, const NDArray& input, NDArray& output, const int dimension) {
-  BUILD_SINGLE_SELECTOR(input.dataType(), softmax_, (context, input, output, dimension), SD_FLOAT_TYPES);
+void logSoftmaxBp(sd::LaunchContext* context, const NDArray& input, const NDArray& gradO, NDArray& gradI,
+                  const int dimension) {
+  BUILD_SINGLE_SELECTOR(input.dataType(), softmaxBackward_, (input, gradO, gradI, dimension, true), SD_FLOAT_TYPES);
 }
 
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
-#endif
\ No newline at end of file
+#endif
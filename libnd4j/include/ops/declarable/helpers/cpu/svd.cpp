@@ -23,11 +23,46 @@
 #include <helpers/biDiagonalUp.h>
 #include <helpers/jacobiSVD.h>
 #include <helpers/svd.h>
+#include <ops/declarable/helpers/cpu/linalg.hpp>
 #if NOT_EXCLUDED(OP_svd)
 namespace sd {
 namespace ops {
 namespace helpers {
 
+// matrices at least this small on both sides stay on the SVD class
+constexpr sd::LongType kDenseSvdMinSize = 32;
+
+//////////////////////////////////////////////////////////////////////////
+// svd of a larger matrix: LAPACK gesdd when the loaded library has it, one-sided Jacobi otherwise
+template <typename T>
+static void svdDense(const NDArray& x, NDArray& s, NDArray* u, NDArray* v, const bool fullUV, const bool calcUV,
+                     int threads) {
+  const auto m = x.sizeAt(-2);
+  const auto n = x.sizeAt(-1);
+  const auto p = sd::math::sd_min<sd::LongType>(m, n);
+  const auto uCols = fullUV ? m : p;
+  const auto vCols = fullUV ? n : p;
+
+  std::vector<T> a(m * n), values(p);
+  std::vector<T> left(calcUV ? m * uCols : 0), right(calcUV ? n * vCols : 0);
+  loadMatrix(x, a.data());
+
+  std::vector<T> rightT(calcUV ? vCols * n : 0);
+  if (LinalgBlas<T>::gesdd(calcUV ? (fullUV ? 'A' : 'S') : 'N', m, n, a.data(), n, values.data(), left.data(),
+                           uCols, rightT.data(), n)) {
+    for (sd::LongType i = 0; i < n && calcUV; i++)
+      for (sd::LongType j = 0; j < vCols; j++) right[i * vCols + j] = rightT[j * n + i];
+  } else {
+    svdJacobi<T>(m, n, a.data(), n, values.data(), calcUV, left.data(), uCols, right.data(), vCols, threads);
+  }
+
+  for (sd::LongType j = 0; j < p; j++) s.r<T>(j) = values[j];
+  if (calcUV) {
+    storeMatrix(left.data(), *u);
+    storeMatrix(right.data(), *v);
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 // svd operation, this function is not method of SVD class, it is standalone function
 template <typename T>
@@ -41,27 +76,30 @@ static void svd_(const NDArray* x, const std::vector<NDArray*>& outArrs, const b
 
   auto listX = x->allTensorsAlongDimension({rank - 2, rank - 1});
   auto listS = s->allTensorsAlongDimension({sRank - 1});
-  ResultSet *listU(nullptr), *listV(nullptr);
+  ResultSet listU, listV;
 
   if (calcUV) {
-    listU = new ResultSet(u->allTensorsAlongDimension({rank - 2, rank - 1}));
-    listV = new ResultSet(v->allTensorsAlongDimension({rank - 2, rank - 1}));
+    listU = u->allTensorsAlongDimension({rank - 2, rank - 1});
+    listV = v->allTensorsAlongDimension({rank - 2, rank - 1});
   }
 
-  for (int i = 0; i < listX.size(); ++i) {
+  const auto m = x->sizeAt(-2);
+  const auto n = x->sizeAt(-1);
+  forEachMatrix(listX.size(), m * n * sd::math::sd_min<sd::LongType>(m, n), [&](sd::LongType i, int threads) {
+    if (sd::math::sd_min<sd::LongType>(m, n) >= kDenseSvdMinSize) {
+      svdDense<T>(*listX.at(i), *listS.at(i), calcUV ? listU.at(i) : nullptr, calcUV ? listV.at(i) : nullptr, fullUV,
+                  calcUV, threads);
+      return;
+    }
+
     helpers::SVD<T> svdObj(*(listX.at(i)), switchNum, calcUV, calcUV, fullUV);
     listS.at(i)->assign(svdObj._s);
 
     if (calcUV) {
-      listU->at(i)->assign(svdObj._u);
-      listV->at(i)->assign(svdObj._v);
+      listU.at(i)->assign(svdObj._u);
+      listV.at(i)->assign(svdObj._v);
     }
-  }
-
-  if (calcUV) {
-    delete listU;
-    delete listV;
-  }
+  });
 }
 
 //////////////////////////////////////////////////////////////////////////
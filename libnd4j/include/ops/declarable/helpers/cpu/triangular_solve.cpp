@@ -25,11 +25,27 @@
 
 #include <array/NDArray.h>
 #include <execution/Threads.h>
+#include <ops/declarable/helpers/cpu/linalg.hpp>
 #include <system/op_boilerplate.h>
 #if NOT_EXCLUDED(OP_triangular_solve)
 namespace sd {
 namespace ops {
 namespace helpers {
+// single system solved with the blocked kernel, see linalgTrsm
+template <typename T>
+static void triangularSolve(NDArray const* leftInput, NDArray const* rightInput, bool const lower,
+                            bool const unitsOnDiag, NDArray* output, int threads) {
+  const auto rows = leftInput->rows();
+  const auto cols = rightInput->columns();
+
+  // dense copies, so that output may alias rightInput
+  std::vector<T> a(rows * rows), x(rows * cols);
+  loadMatrix(*leftInput, a.data());
+  loadMatrix(*rightInput, x.data());
+  linalgTrsm<T>(lower, unitsOnDiag, rows, cols, a.data(), rows, x.data(), cols, threads);
+  storeMatrix(x.data(), *output);
+}
+
 /*
  * lower triangular process for system of linear equations
  * x_1 = b_1/a_1,1
@@ -45,19 +61,9 @@ namespace helpers {
  * */
 template <typename T>
 static void lowerTriangularSolve(sd::LaunchContext* context, NDArray const* leftInput, NDArray const* rightInput,
-                                 bool const unitsOnDiag, NDArray* output) {
-  auto rows = leftInput->rows();
-  auto cols = rightInput->columns();
-  // output->r<T>(0,0) = rightInput->t<T>(0,0) / leftInput->t<T>(0,0);
-  for (sd::LongType r = 0; r < rows; r++) {
-    for (sd::LongType j = 0; j < cols; j++) {
-      auto sum = rightInput->t<T>(r, j);
-      for (sd::LongType c = 0; c < r; c++) {
-        sum -= leftInput->t<T>(r, c) * output->t<T>(c, j);
-      }
-      output->r<T>(r, j) = unitsOnDiag ? sum : sum / leftInput->t<T>(r, r);
-    }
-  }
+                                 bool const unitsOnDiag, NDArray* output,
+                                 int threads = sd::Environment::getInstance().maxMasterThreads()) {
+  triangularSolve<T>(leftInput, rightInput, true, unitsOnDiag, output, threads);
 }
 
 /*
@@ -76,18 +82,9 @@ static void lowerTriangularSolve(sd::LaunchContext* context, NDArray const* left
 
 template <typename T>
 static void upperTriangularSolve(sd::LaunchContext* context, NDArray const* leftInput, NDArray const* rightInput,
-                                 bool const unitsOnDiag, NDArray* output) {
-  auto rows = leftInput->rows();
-  auto cols = rightInput->columns();
-  for (sd::LongType r = rows; r > 0; r--) {
-    for (sd::LongType j = 0; j < cols; j++) {
-      auto sum = rightInput->t<T>(r - 1, j);
-      for (sd::LongType c = r; c < rows; c++) {
-        sum -= leftInput->t<T>(r - 1, c) * output->t<T>(c, j);
-      }
-      output->r<T>(r - 1, j) = unitsOnDiag ? sum : sum / leftInput->t<T>(r - 1, r - 1);
-    }
-  }
+                                 bool const unitsOnDiag, NDArray* output,
+                                 int threads = sd::Environment::getInstance().maxMasterThreads()) {
+  triangularSolve<T>(leftInput, rightInput, false, unitsOnDiag, output, threads);
 }
 
 ///  triangularSolve2D - 2D implementation of triangularSolveFunctor
@@ -120,17 +117,14 @@ static sd::Status triangularSolveFunctor_(sd::LaunchContext* context, NDArray* l
   auto rightPart = rightInput->allTensorsAlongDimension({-2, -1});
   auto outputPart = output->allTensorsAlongDimension({-2, -1});
 
-  auto batchLoop = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      if (lower) {
-        lowerTriangularSolve<T>(context, leftPart[i], rightPart[i], false, outputPart[i]);
-      } else {
-        upperTriangularSolve<T>(context, leftPart[i], rightPart[i], false, outputPart[i]);
-      }
+  const auto work = leftInput->sizeAt(-1) * leftInput->sizeAt(-1) * rightInput->sizeAt(-1);
+  forEachMatrix(leftPart.size(), work, [&](sd::LongType i, int threads) {
+    if (lower) {
+      lowerTriangularSolve<T>(context, leftPart[i], rightPart[i], false, outputPart[i], threads);
+    } else {
+      upperTriangularSolve<T>(context, leftPart[i], rightPart[i], false, outputPart[i], threads);
     }
-  };
-
-  samediff::Threads::parallel_tad(batchLoop, 0, leftPart.size(), 1);
+  });
 
   return sd::Status::OK;
 }
@@ -0,0 +1,225 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Multi-tensor updater: all parameter tensors are cut into chunks of similar size, so a single
+// parallel pass serves hundreds of small tensors as well as one flat parameter arena. The bias
+// corrections are computed once per call, and the per-element math runs in float (double for
+// double) over contiguous buffers.
+//
+#include <execution/Threads.h>
+#include <math/templatemath.h>
+#include <ops/declarable/helpers/cpu/normalization.hpp>
+#include <ops/declarable/helpers/updatersHelpers.h>
+
+#include <cmath>
+
+#if NOT_EXCLUDED(OP_multi_tensor_updater)
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// elements per chunk of work
+constexpr sd::LongType kMultiTensorChunk = 16384;
+
+struct TensorChunk {
+  int tensor;
+  sd::LongType start;
+  sd::LongType stop;
+};
+
+template <typename A>
+struct MultiTensorCoefficients {
+  A lr, beta1, beta2, epsilon, decay, clip;
+  // adam and ams grad step size, nadam bias correction
+  A epsilonT, mbeta1T;
+};
+
+template <typename T, typename A>
+static void updateChunk(const int type, const MultiTensorCoefficients<A>& k, const T* param, const T* grad,
+                        const T* const* init, T* outParam, T* const* state, const sd::LongType start,
+                        const sd::LongType stop) {
+  const A lr = k.lr, b1 = k.beta1, b2 = k.beta2, eps = k.epsilon, decay = k.decay, clip = k.clip;
+  const A one = static_cast<A>(1);
+
+  switch (type) {
+    case MULTI_SGD: {
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) {
+        const A p = static_cast<A>(param[i]);
+        const A g = clip * static_cast<A>(grad[i]);
+        outParam[i] = static_cast<T>(p - lr * g - decay * p);
+      }
+    } break;
+    case MULTI_NESTEROVS: {
+      const A momentumT = -b1 - one;
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) {
+        const A p = static_cast<A>(param[i]);
+        const A g = clip * static_cast<A>(grad[i]);
+        const A prev = b1 * static_cast<A>(init[0][i]);
+        const A v = prev - lr * g;
+        state[0][i] = static_cast<T>(v);
+        outParam[i] = static_cast<T>(p - (prev + momentumT * v) - decay * p);
+      }
+    } break;
+    case MULTI_RMS_PROP: {
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) {
+        const A p = static_cast<A>(param[i]);
+        const A g = clip * static_cast<A>(grad[i]);
+        const A s = static_cast<A>(init[0][i]) * b1 + g * g * (one - b1);
+        state[0][i] = static_cast<T>(s);
+        outParam[i] = static_cast<T>(p - lr * g / (std::sqrt(s) + eps) - decay * p);
+      }
+    } break;
+    case MULTI_ADAM: {
+      const A epsilonT = k.epsilonT;
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) {
+        const A p = static_cast<A>(param[i]);
+        const A g = clip * static_cast<A>(grad[i]);
+        const A u = b2 * static_cast<A>(init[0][i]) + g * g * (one - b2);
+        const A m = b1 * static_cast<A>(init[1][i]) + g * (one - b1);
+        state[0][i] = static_cast<T>(u);
+        state[1][i] = static_cast<T>(m);
+        outParam[i] = static_cast<T>(p - m * epsilonT / (std::sqrt(u) + eps) - decay * p);
+      }
+    } break;
+    case MULTI_NADAM: {
+      const A mbeta1T = k.mbeta1T;
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) {
+        const A p = static_cast<A>(param[i]);
+        const A g = clip * static_cast<A>(grad[i]);
+        const A oneMinusBeta1Grad = g * (one - b1);
+        const A v = b2 * static_cast<A>(init[0][i]) + g * g * (one - b2);
+        const A m = b1 * static_cast<A>(init[1][i]) + oneMinusBeta1Grad;
+        state[0][i] = static_cast<T>(v);
+        state[1][i] = static_cast<T>(m);
+        outParam[i] =
+            static_cast<T>(p - lr * ((m * b1 + oneMinusBeta1Grad) / mbeta1T) / (std::sqrt(v) + eps) - decay * p);
+      }
+    } break;
+    case MULTI_AMS_GRAD: {
+      const A epsilonT = k.epsilonT;
+      PRAGMA_OMP_SIMD
+      for (auto i = start; i < stop; i++) {
+        const A p = static_cast<A>(param[i]);
+        const A g = clip * static_cast<A>(grad[i]);
+        const A v = b2 * static_cast<A>(init[0][i]) + g * g * (one - b2);
+        const A m = b1 * static_cast<A>(init[1][i]) + g * (one - b1);
+        const A h0 = static_cast<A>(init[2][i]);
+        const A h = h0 > v ? h0 : v;
+        state[0][i] = static_cast<T>(v);
+        state[1][i] = static_cast<T>(m);
+        state[2][i] = static_cast<T>(h);
+        outParam[i] = static_cast<T>(p - epsilonT * m / (std::sqrt(h) + eps) - decay * p);
+      }
+    } break;
+    default:
+      throw std::invalid_argument("updaterMultiTensor: unknown updater type");
+  }
+}
+
+template <typename T>
+static void updaterMultiTensor_(const int type, const std::vector<const NDArray*>& params,
+                                const std::vector<const NDArray*>& gradients,
+                                const std::vector<const NDArray*>& initStates,
+                                const std::vector<NDArray*>& updatedParams, const std::vector<NDArray*>& updatedStates,
+                                const MultiTensorUpdaterConfig& config) {
+  typedef NormAccumulator<T> A;
+
+  const int n = static_cast<int>(params.size());
+  const int numStates = multiTensorUpdaterStates(type);
+
+  std::vector<TensorChunk> chunks;
+  for (int t = 0; t < n; t++)
+    for (sd::LongType s = 0; s < params[t]->lengthOf(); s += kMultiTensorChunk)
+      chunks.push_back({t, s, std::min<sd::LongType>(s + kMultiTensorChunk, params[t]->lengthOf())});
+
+  // gradients are scaled on the fly, they are never written
+  double clip = 1.;
+  if (config.maxGlobalNorm > 0.) {
+    std::vector<double> partial(chunks.size(), 0.);
+    auto norms = PRAGMA_THREADS_FOR {
+      for (auto c = start; c < stop; c++) {
+        const T* g = gradients[chunks[c].tensor]->bufferAsT<T>();
+        A sum = static_cast<A>(0);
+        PRAGMA_OMP_SIMD_SUM(sum)
+        for (auto i = chunks[c].start; i < chunks[c].stop; i++) sum += static_cast<A>(g[i]) * static_cast<A>(g[i]);
+        partial[c] = static_cast<double>(sum);
+      }
+    };
+    samediff::Threads::parallel_for(norms, 0, chunks.size());
+
+    double total = 0.;
+    for (auto p : partial) total += p;
+    const double norm = std::sqrt(total);
+    if (norm > config.maxGlobalNorm) clip = config.maxGlobalNorm / norm;
+  }
+
+  const double iteration = static_cast<double>(config.iteration) + 1.;
+  const double beta1T = std::pow(config.beta1, iteration);
+  const double beta2T = std::pow(config.beta2, iteration);
+  double epsilonT = config.lr * std::sqrt(1. - beta2T) / (1. - beta1T);
+  if (std::isnan(epsilonT) || 0. == epsilonT || std::isinf(epsilonT)) epsilonT = config.epsilon;
+
+  MultiTensorCoefficients<A> k;
+  k.lr = static_cast<A>(config.lr);
+  k.beta1 = static_cast<A>(config.beta1);
+  k.beta2 = static_cast<A>(config.beta2);
+  k.epsilon = static_cast<A>(config.epsilon);
+  k.decay = static_cast<A>(config.lr * config.weightDecay);
+  k.clip = static_cast<A>(clip);
+  k.epsilonT = static_cast<A>(epsilonT);
+  k.mbeta1T = static_cast<A>(1. - beta1T);
+
+  auto func = PRAGMA_THREADS_FOR {
+    const T* init[3] = {nullptr, nullptr, nullptr};
+    T* state[3] = {nullptr, nullptr, nullptr};
+    for (auto c = start; c < stop; c++) {
+      const auto t = chunks[c].tensor;
+      for (int s = 0; s < numStates; s++) {
+        init[s] = initStates[s * n + t]->bufferAsT<T>();
+        state[s] = updatedStates[s * n + t]->bufferAsT<T>();
+      }
+
+      updateChunk<T, A>(type, k, params[t]->bufferAsT<T>(), gradients[t]->bufferAsT<T>(), init,
+                        updatedParams[t]->bufferAsT<T>(), state, chunks[c].start, chunks[c].stop);
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, chunks.size());
+}
+
+void updaterMultiTensor(sd::LaunchContext* context, const int type, const std::vector<const NDArray*>& params,
+                        const std::vector<const NDArray*>& gradients, const std::vector<const NDArray*>& initStates,
+                        const std::vector<NDArray*>& updatedParams, const std::vector<NDArray*>& updatedStates,
+                        const MultiTensorUpdaterConfig& config) {
+  if (params.empty()) return;
+
+  BUILD_SINGLE_SELECTOR(params[0]->dataType(), updaterMultiTensor_,
+                        (type, params, gradients, initStates, updatedParams, updatedStates, config), SD_FLOAT_TYPES);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif
@@ -25,6 +25,7 @@
 #include <ops/declarable/helpers/helpers.h>
 
 #include <type_traits>
+#include <vector>
 namespace sd {
 namespace ops {
 namespace helpers {
@@ -56,15 +57,24 @@ T local_log(T x) {
   return (negative_infinity<T>());
 }
 
+// below this difference exp(min - max) is lost in the type's precision, so log_sum_exp is just the max
+template <typename T>
+T log_sum_exp_cutoff() {
+  static const T cutoff = sd::math::p_log<T>(DataTypeUtils::eps<T>());
+  return cutoff;
+}
+
 template <typename T>
 T log_sum_exp(T x1, T x2) {
   // substituting this : std::log(std::exp(arg1 - cMax) + std::exp(arg2 - cMax)) + cMax
   // if arg1==cMax : std::log(1 + std::exp(arg2 - cMax)) + cMax
   if (x1 >= x2) {
     // x1 is max
+    if (x2 - x1 < log_sum_exp_cutoff<T>()) return x1;
     return (x1 + local_log(1 + sd::math::p_exp<T>(x2 - x1)));
   }
   // x2 is max
+  if (x1 - x2 < log_sum_exp_cutoff<T>()) return x2;
   return (x2 + local_log(1 + sd::math::p_exp<T>(x1 - x2)));
 }
 
@@ -82,7 +92,7 @@ T log_sum_exp(T arg1, T arg2, T arg3) {
 
 template <bool HasElementStride, typename Type, typename IndexType>
 Type softmax_normalization_term(const Type *log_p, const uint64_t len_c, const uint64_t element_stride) {
-  Type max_p;
+  Type max_p = negative_infinity<Type>();
   for (auto c = 0; c < len_c; ++c) {
     max_p = std::max(max_p, element<HasElementStride>(log_p, c, element_stride));
   }
@@ -140,6 +150,68 @@ SD_LIB_HIDDEN void ctcLoss(graph::Context &block, const NDArray &logitsInput, co
 SD_LIB_HIDDEN void beamSearch(const NDArray &logit, const NDArray &sequence_length, NDArray &result_sequences,
                               NDArray &result_probs, NDArray &result_sequences_length, int blank_index, int beam_width,
                               int nbest_len, bool normalize_logits);
+
+/**
+ * @brief One hypothesis of the CTC beam search: label sequence and its log probability
+ */
+struct CtcHypothesis {
+  std::vector<int> labels;
+  double logProb;
+};
+
+/**
+ * @brief Streaming CTC beam search over a batch of independent utterances.
+ *
+ * Frames are fed in chunks of {BATCH_LEN, CHUNK_FRAME_LEN, CLASS_LEN} log probabilities; the beams of every batch entry
+ * are carried over between chunks, so the partial hypotheses are available after each chunk and feeding a sequence in
+ * chunks gives the same result as decoding it at once with beamSearch. Batch entries are decoded in parallel.
+ * The logits data type is fixed by the first chunk.
+ *
+ * NOTE: it is not thread-safe
+ */
+class SD_LIB_EXPORT CtcBeamSearchStream {
+ public:
+  /**
+   * @param batch_len number of utterances decoded together
+   * @param class_len number of classes including the blank label
+   * @param blank_index the index of the blank label, defaults to the last class when out of range
+   * @param beam_width the width of the beam search
+   * @param nbest_len the number of hypotheses returned per batch entry, at most beam_width
+   * @param normalize_logits when true the logits are normalized with log softmax
+   */
+  CtcBeamSearchStream(int batch_len, int class_len, int blank_index = -1, int beam_width = 25, int nbest_len = 1,
+                      bool normalize_logits = false);
+  ~CtcBeamSearchStream();
+
+  CtcBeamSearchStream(const CtcBeamSearchStream &other) = delete;
+  CtcBeamSearchStream &operator=(const CtcBeamSearchStream &other) = delete;
+
+  /**
+   * @param logits NDArray {BATCH_LEN, CHUNK_FRAME_LEN, CLASS_LEN} log probabilities of the next frames
+   * @param frame_lengths NDArray {BATCH_LEN} or nullptr. number of valid frames of the chunk for each batch entry
+   */
+  void feed(const NDArray &logits, const NDArray *frame_lengths = nullptr);
+
+  // partial (or final, after the last chunk) nbest hypotheses of the batch entry, best first
+  std::vector<CtcHypothesis> hypotheses(int batch_index) const;
+
+  // number of frames decoded so far for the batch entry
+  sd::LongType frames(int batch_index) const;
+
+  // drops all beams and starts new utterances
+  void reset();
+
+  class Impl;
+
+ private:
+  int _batchLen;
+  int _classLen;
+  int _blankIndex;
+  int _beamWidth;
+  int _nbestLen;
+  bool _normalizeLogits;
+  Impl *_impl = nullptr;
+};
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
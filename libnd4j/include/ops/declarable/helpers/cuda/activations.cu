@@ -472,6 +472,26 @@ void logSoftmax(sd::LaunchContext *context, const NDArray &input, NDArray &outpu
   output.tickWriteDevice();
 }
 
+//////////////////////////////////////////////////////////////////////////
+void softmaxBp(sd::LaunchContext *context, const NDArray &input, const NDArray &gradO, NDArray &gradI,
+               const int dimension) {
+  auto softMax = gradI.ulike();
+  softmax(context, input, softMax, dimension);
+
+  auto sumAlongDim = (softMax * gradO).reduceAlongDimension(reduce::Sum, {dimension}, true);
+  gradI.assign(softMax * (gradO - sumAlongDim));
+}
+
+//////////////////////////////////////////////////////////////////////////
+void logSoftmaxBp(sd::LaunchContext *context, const NDArray &input, const NDArray &gradO, NDArray &gradI,
+                  const int dimension) {
+  auto softMax = gradI.ulike();
+  softmax(context, input, softMax, dimension);
+
+  auto sumGradO = gradO.reduceAlongDimension(reduce::Sum, {dimension}, true);
+  gradI.assign(gradO - softMax * sumGradO);
+}
+
 ///////////////////////////////////////////////////////////////////
 template <typename T>
 void SD_KERNEL softMaxDerivForVectorCuda(const void *vx, const sd::LongType *xzShapeInfo, void *vz) {
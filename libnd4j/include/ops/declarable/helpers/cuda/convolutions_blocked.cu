@@ -0,0 +1,111 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// NCHWc (channel-blocked) layout helpers, implemented via reordering into NCHW and regular kernels
+//
+#include <ops/declarable/helpers/convolutions.h>
+
+namespace sd {
+namespace ops {
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::toBlockedChannels(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                         const bool isNCHW) {
+  // input  [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)
+  // output [bS, iCb, iH, iW, b]
+
+  const NDArray x = isNCHW ? input.permute({0, 1, 2, 3}) : input.permute({0, 3, 1, 2});
+  const sd::LongType bS = x.sizeAt(0);
+  const sd::LongType iC = x.sizeAt(1);
+  const sd::LongType iH = x.sizeAt(2);
+  const sd::LongType iW = x.sizeAt(3);
+  const sd::LongType iCb = output.sizeAt(1);
+
+  NDArray padded('c', {bS, iCb * SD_CHANNEL_BLOCK, iH, iW}, input.dataType(), block.launchContext());
+  padded.nullify();
+  padded({0, 0, 0, iC, 0, 0, 0, 0}).assign(x);
+
+  output.assign(padded.reshape('c', {bS, iCb, SD_CHANNEL_BLOCK, iH, iW}, false).permute({0, 1, 3, 4, 2}));
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::fromBlockedChannels(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                           const bool isNCHW) {
+  // input  [bS, iCb, iH, iW, b]
+  // output [bS, iC, iH, iW] (NCHW) or [bS, iH, iW, iC] (NHWC)
+
+  const sd::LongType bS = input.sizeAt(0);
+  const sd::LongType iCb = input.sizeAt(1);
+  const sd::LongType iH = input.sizeAt(2);
+  const sd::LongType iW = input.sizeAt(3);
+  const sd::LongType iC = output.sizeAt(isNCHW ? 1 : 3);
+
+  NDArray plain = input.permute({0, 1, 4, 2, 3}).reshape('c', {bS, iCb * SD_CHANNEL_BLOCK, iH, iW});
+  NDArray z = isNCHW ? output.permute({0, 1, 2, 3}) : output.permute({0, 3, 1, 2});
+
+  z.assign(plain({0, 0, 0, iC, 0, 0, 0, 0}));
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::conv2dBlocked(sd::graph::Context& block, const NDArray& input, const NDArray& weights,
+                                     const NDArray* bias, NDArray& output, const int kH, const int kW, const int sH,
+                                     const int sW, int pH, int pW, const int dH, const int dW, const int paddingMode,
+                                     const int wFormat) {
+  const sd::LongType iC = weights.sizeAt(0 == wFormat ? 2 : (1 == wFormat ? 1 : 3));
+  const sd::LongType oC = weights.sizeAt(0 == wFormat ? 3 : 0);
+
+  NDArray x('c', {input.sizeAt(0), iC, input.sizeAt(2), input.sizeAt(3)}, input.dataType(), block.launchContext());
+  NDArray z('c', {output.sizeAt(0), oC, output.sizeAt(2), output.sizeAt(3)}, output.dataType(), block.launchContext());
+
+  fromBlockedChannels(block, input, x, true);
+  conv2d(block, &x, &weights, bias, &z, kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, 1, wFormat);
+  toBlockedChannels(block, z, output, true);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::pooling2dBlocked(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                        const int kH, const int kW, const int sH, const int sW, const int pH,
+                                        const int pW, const int dH, const int dW, const PoolingType poolingMode,
+                                        const int extraParam0) {
+  // padded tail channels are pooled as well, they are zeros and never reach user
+  const sd::LongType iC = input.sizeAt(1) * SD_CHANNEL_BLOCK;
+
+  NDArray x('c', {input.sizeAt(0), iC, input.sizeAt(2), input.sizeAt(3)}, input.dataType(), block.launchContext());
+  NDArray z('c', {output.sizeAt(0), iC, output.sizeAt(2), output.sizeAt(3)}, output.dataType(), block.launchContext());
+
+  fromBlockedChannels(block, input, x, true);
+  pooling2d(block, x, z, kH, kW, sH, sW, pH, pW, dH, dW, poolingMode, extraParam0);
+  toBlockedChannels(block, z, output, true);
+}
+
+//////////////////////////////////////////////////////////////////////////
+void ConvolutionUtils::upsampling2dBlocked(sd::graph::Context& block, const NDArray& input, NDArray& output,
+                                           const int factorH, const int factorW) {
+  const sd::LongType iC = input.sizeAt(1) * SD_CHANNEL_BLOCK;
+
+  NDArray x('c', {input.sizeAt(0), iC, input.sizeAt(2), input.sizeAt(3)}, input.dataType(), block.launchContext());
+  NDArray z('c', {output.sizeAt(0), iC, output.sizeAt(2), output.sizeAt(3)}, output.dataType(), block.launchContext());
+
+  fromBlockedChannels(block, input, x, true);
+  upsampling2d(block, x, z, factorH, factorW, true);
+  toBlockedChannels(block, z, output, true);
+}
+
+}  // namespace ops
+}  // namespace sd
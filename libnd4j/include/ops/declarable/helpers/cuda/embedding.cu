@@ -0,0 +1,245 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Embedding gathers, CUDA implementation: one block per output row (or bag), threads along the row
+//
+#include <ops/declarable/helpers/embedding.h>
+#include <ops/declarable/helpers/helpers.h>
+
+#include <memory>
+#include <type_traits>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// half, bfloat16 and float accumulate in float, double in double
+template <typename T>
+using EmbeddingAccumulator = typename std::conditional<std::is_same<T, double>::value, double, float>::type;
+
+static SD_INLINE bool isDenseC(const NDArray& array) { return array.ordering() == 'c' && array.ews() == 1; }
+
+// returns the array itself when it is dense, c-ordered and of the given type, otherwise a copy kept alive by holder
+static const NDArray* denseInput(const NDArray& array, sd::DataType dataType, std::unique_ptr<NDArray>& holder) {
+  if (array.dataType() == dataType && isDenseC(array)) return &array;
+  holder.reset(new NDArray('c', array.getShapeAsVector(), dataType, array.getContext()));
+  holder->assign(array);
+  return holder.get();
+}
+
+// returns the array itself when it is dense and c-ordered, otherwise a dense buffer to be written back
+// with flushDenseOutput
+static NDArray* denseOutput(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (isDenseC(array)) return &array;
+  holder.reset(new NDArray('c', array.getShapeAsVector(), array.dataType(), array.getContext()));
+  return holder.get();
+}
+
+static void flushDenseOutput(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (holder != nullptr) array.assign(*holder);
+}
+
+template <typename T>
+static SD_KERNEL void embeddingLookupCuda(const void* vParams, const sd::LongType* indices, void* vOutput,
+                                          const sd::LongType numIndices, const sd::LongType rowLength) {
+  auto params = reinterpret_cast<const T*>(vParams);
+  auto output = reinterpret_cast<T*>(vOutput);
+
+  for (auto i = blockIdx.x; i < numIndices; i += gridDim.x) {
+    auto src = params + indices[i] * rowLength;
+    auto dst = output + i * rowLength;
+    for (auto k = threadIdx.x; k < rowLength; k += blockDim.x) dst[k] = src[k];
+  }
+}
+
+template <typename T>
+static SD_KERNEL void embeddingBagCuda(const void* vParams, const sd::LongType* indices, const sd::LongType* offsets,
+                                       const void* vWeights, void* vOutput, const sd::LongType numIndices,
+                                       const sd::LongType numBags, const sd::LongType rowLength, const int mode) {
+  typedef EmbeddingAccumulator<T> A;
+  auto params = reinterpret_cast<const T*>(vParams);
+  auto weights = reinterpret_cast<const T*>(vWeights);
+  auto output = reinterpret_cast<T*>(vOutput);
+
+  for (auto b = blockIdx.x; b < numBags; b += gridDim.x) {
+    const auto first = offsets[b];
+    const auto last = b + 1 < numBags ? offsets[b + 1] : numIndices;
+
+    for (auto k = threadIdx.x; k < rowLength; k += blockDim.x) {
+      if (last <= first) {
+        output[b * rowLength + k] = static_cast<T>(0);
+        continue;
+      }
+
+      A acc = mode == EMBEDDING_BAG_MAX ? -DataTypeUtils::infOrMax<A>() : static_cast<A>(0);
+      for (auto j = first; j < last; j++) {
+        const auto v = static_cast<A>(params[indices[j] * rowLength + k]);
+        if (mode == EMBEDDING_BAG_MAX)
+          acc = v > acc ? v : acc;
+        else
+          acc += (weights != nullptr ? static_cast<A>(weights[j]) : static_cast<A>(1)) * v;
+      }
+
+      if (mode == EMBEDDING_BAG_MEAN) acc /= static_cast<A>(last - first);
+      output[b * rowLength + k] = static_cast<T>(acc);
+    }
+  }
+}
+
+template <typename T>
+static SD_KERNEL void embeddingBagBpCuda(const void* vParams, const sd::LongType* indices,
+                                         const sd::LongType* offsets, const void* vWeights, const void* vGradO,
+                                         void* vGradRows, const sd::LongType numIndices, const sd::LongType numBags,
+                                         const sd::LongType rowLength, const int mode) {
+  typedef EmbeddingAccumulator<T> A;
+  auto params = reinterpret_cast<const T*>(vParams);
+  auto weights = reinterpret_cast<const T*>(vWeights);
+  auto gradO = reinterpret_cast<const T*>(vGradO);
+  auto gradRows = reinterpret_cast<T*>(vGradRows);
+
+  // indices before the first bag get no gradient
+  for (auto j = blockIdx.x; j < offsets[0]; j += gridDim.x)
+    for (auto k = threadIdx.x; k < rowLength; k += blockDim.x) gradRows[j * rowLength + k] = static_cast<T>(0);
+
+  for (auto b = blockIdx.x; b < numBags; b += gridDim.x) {
+    const auto first = offsets[b];
+    const auto last = b + 1 < numBags ? offsets[b + 1] : numIndices;
+    if (last <= first) continue;
+
+    for (auto k = threadIdx.x; k < rowLength; k += blockDim.x) {
+      const auto g = gradO[b * rowLength + k];
+
+      if (mode == EMBEDDING_BAG_MAX) {
+        auto winner = first;
+        for (auto j = first + 1; j < last; j++)
+          if (params[indices[j] * rowLength + k] > params[indices[winner] * rowLength + k]) winner = j;
+
+        for (auto j = first; j < last; j++) gradRows[j * rowLength + k] = j == winner ? g : static_cast<T>(0);
+        continue;
+      }
+
+      const A norm = mode == EMBEDDING_BAG_MEAN ? static_cast<A>(1) / static_cast<A>(last - first) : static_cast<A>(1);
+      for (auto j = first; j < last; j++) {
+        const A scale = (weights != nullptr ? static_cast<A>(weights[j]) : static_cast<A>(1)) * norm;
+        gradRows[j * rowLength + k] = static_cast<T>(scale * static_cast<A>(g));
+      }
+    }
+  }
+}
+
+template <typename T>
+static void embeddingLookup_(sd::LaunchContext* context, const NDArray& params, const NDArray& indices,
+                             NDArray& output) {
+  const auto rowLength = params.lengthOf() / params.sizeAt(0);
+
+  // dense arrays are used in place, so that every row is copied once
+  std::unique_ptr<NDArray> paramsHolder, indicesHolder, outputHolder;
+  auto p = denseInput(params, params.dataType(), paramsHolder);
+  auto i = denseInput(indices, sd::DataType::INT64, indicesHolder);
+  auto z = denseOutput(output, outputHolder);
+
+  NDArray::prepareSpecialUse({z}, {p, i});
+  embeddingLookupCuda<T><<<512, SD_CUDA_BLOCK_SIZE, 1024, *context->getCudaStream()>>>(
+      p->specialBuffer(), reinterpret_cast<const sd::LongType*>(i->specialBuffer()), z->specialBuffer(),
+      i->lengthOf(), rowLength);
+  NDArray::registerSpecialUse({z}, {p, i});
+
+  flushDenseOutput(output, outputHolder);
+}
+
+template <typename T>
+static void embeddingBag_(sd::LaunchContext* context, const NDArray& params, const NDArray& indices,
+                          const NDArray& offsets, const NDArray* weights, const int mode, NDArray& output) {
+  const auto rowLength = params.lengthOf() / params.sizeAt(0);
+
+  std::unique_ptr<NDArray> paramsHolder, indicesHolder, offsetsHolder, weightsHolder, outputHolder;
+  auto p = denseInput(params, params.dataType(), paramsHolder);
+  auto i = denseInput(indices, sd::DataType::INT64, indicesHolder);
+  auto o = denseInput(offsets, sd::DataType::INT64, offsetsHolder);
+  auto w = weights != nullptr ? denseInput(*weights, params.dataType(), weightsHolder) : nullptr;
+  auto z = denseOutput(output, outputHolder);
+
+  std::vector<const NDArray*> reads = {p, i, o};
+  if (w != nullptr) reads.push_back(w);
+
+  NDArray::prepareSpecialUse({z}, reads);
+  embeddingBagCuda<T><<<512, SD_CUDA_BLOCK_SIZE, 1024, *context->getCudaStream()>>>(
+      p->specialBuffer(), reinterpret_cast<const sd::LongType*>(i->specialBuffer()),
+      reinterpret_cast<const sd::LongType*>(o->specialBuffer()), w != nullptr ? w->specialBuffer() : nullptr,
+      z->specialBuffer(), i->lengthOf(), o->lengthOf(), rowLength, mode);
+  NDArray::registerSpecialUse({z}, reads);
+
+  flushDenseOutput(output, outputHolder);
+}
+
+template <typename T>
+static void embeddingBagBp_(sd::LaunchContext* context, const NDArray& params, const NDArray& indices,
+                            const NDArray& offsets, const NDArray* weights, const NDArray& gradO, const int mode,
+                            NDArray& gradRows) {
+  // without bags no index gets a gradient
+  if (offsets.lengthOf() == 0) {
+    gradRows.nullify();
+    return;
+  }
+
+  const auto rowLength = params.lengthOf() / params.sizeAt(0);
+
+  std::unique_ptr<NDArray> paramsHolder, indicesHolder, offsetsHolder, weightsHolder, gradOHolder, gradRowsHolder;
+  auto p = denseInput(params, params.dataType(), paramsHolder);
+  auto i = denseInput(indices, sd::DataType::INT64, indicesHolder);
+  auto o = denseInput(offsets, sd::DataType::INT64, offsetsHolder);
+  auto w = weights != nullptr ? denseInput(*weights, params.dataType(), weightsHolder) : nullptr;
+  auto g = denseInput(gradO, gradO.dataType(), gradOHolder);
+  auto z = denseOutput(gradRows, gradRowsHolder);
+
+  std::vector<const NDArray*> reads = {p, i, o, g};
+  if (w != nullptr) reads.push_back(w);
+
+  NDArray::prepareSpecialUse({z}, reads);
+  embeddingBagBpCuda<T><<<512, SD_CUDA_BLOCK_SIZE, 1024, *context->getCudaStream()>>>(
+      p->specialBuffer(), reinterpret_cast<const sd::LongType*>(i->specialBuffer()),
+      reinterpret_cast<const sd::LongType*>(o->specialBuffer()), w != nullptr ? w->specialBuffer() : nullptr,
+      g->specialBuffer(), z->specialBuffer(), i->lengthOf(), o->lengthOf(), rowLength, mode);
+  NDArray::registerSpecialUse({z}, reads);
+
+  flushDenseOutput(gradRows, gradRowsHolder);
+}
+
+void embeddingLookup(sd::LaunchContext* context, const NDArray& params, const NDArray& indices, NDArray& output) {
+  if (output.isEmpty() || indices.lengthOf() == 0) return;
+
+  BUILD_SINGLE_SELECTOR(params.dataType(), embeddingLookup_, (context, params, indices, output), SD_COMMON_TYPES);
+}
+
+void embeddingBag(sd::LaunchContext* context, const NDArray& params, const NDArray& indices, const NDArray& offsets,
+                  const NDArray* weights, const int mode, NDArray& output) {
+  BUILD_SINGLE_SELECTOR(params.dataType(), embeddingBag_, (context, params, indices, offsets, weights, mode, output),
+                        SD_FLOAT_TYPES);
+}
+
+void embeddingBagBp(sd::LaunchContext* context, const NDArray& params, const NDArray& indices, const NDArray& offsets,
+                    const NDArray* weights, const NDArray& gradO, const int mode, NDArray& gradRows) {
+  BUILD_SINGLE_SELECTOR(params.dataType(), embeddingBagBp_,
+                        (context, params, indices, offsets, weights, gradO, mode, gradRows), SD_FLOAT_TYPES);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
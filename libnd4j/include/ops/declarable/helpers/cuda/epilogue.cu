@@ -0,0 +1,59 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Fused bias + activation epilogue, CUDA implementation
+//
+#include <ops/declarable/helpers/epilogue.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+//////////////////////////////////////////////////////////////////////////
+void fusedEpilogue(sd::LaunchContext* context, const NDArray& input, const NDArray* bias, NDArray& output,
+                   const int channelDim, const graph::FusedActivation activation, const double alpha) {
+  if (bias != nullptr)
+    const_cast<NDArray&>(input).applyBroadcast(sd::broadcast::Add, {channelDim}, *bias, output);
+  else if (&input != &output)
+    output.assign(input);
+
+  switch (activation) {
+    case graph::FUSED_RELU:
+      output.applyScalar(sd::scalar::RELU, alpha, output);
+      break;
+    case graph::FUSED_RELU6:
+      output.applyScalar(sd::scalar::RELU6, alpha, output);
+      break;
+    case graph::FUSED_LRELU:
+      output.applyScalar(sd::scalar::LeakyRELU, alpha, output);
+      break;
+    case graph::FUSED_SIGMOID:
+      output.applyTransform(sd::transform::Sigmoid, output);
+      break;
+    case graph::FUSED_TANH:
+      output.applyTransform(sd::transform::Tanh, output);
+      break;
+    default:
+      break;
+  }
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
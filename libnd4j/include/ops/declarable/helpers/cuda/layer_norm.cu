@@ -0,0 +1,81 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// layer normalization composed from reductions and broadcasts
+//
+#include <helpers/ShapeUtils.h>
+#include <ops/declarable/helpers/layer_norm.h>
+
+#if NOT_EXCLUDED(OP_layer_norm)
+namespace sd {
+namespace ops {
+namespace helpers {
+
+static void layerNormMoments(const NDArray& input, const std::vector<int>& axes, NDArray& means, NDArray& stdev) {
+  means = input.reduceAlongDimension(reduce::Mean, axes, true);
+  stdev = input.varianceAlongDimension(variance::SummaryStatsStandardDeviation, false, axes);
+  stdev.reshapei(means.getShapeAsVector());
+}
+
+void layerNorm(sd::LaunchContext* context, const NDArray& input, const NDArray& gain, const NDArray* bias,
+               NDArray& output, const std::vector<int>& axes, const int dimC) {
+  NDArray means, stdev;
+  layerNormMoments(input, axes, means, stdev);
+  stdev += 1e-12;
+
+  input.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), means, output, false);
+  output.applyTrueBroadcast(sd::BroadcastOpsTuple::Divide(), stdev, output, false);
+  output.applyScalar(sd::scalar::ReplaceNans, 0, output);
+
+  output.applyBroadcast(sd::broadcast::Multiply, {dimC}, gain, output);
+  if (bias != nullptr) output.applyBroadcast(sd::broadcast::Add, {dimC}, *bias, output);
+}
+
+void layerNormBp(sd::LaunchContext* context, const NDArray& input, const NDArray& gain, const NDArray& gradO,
+                 NDArray& dLdx, NDArray& dLdgTerms, const std::vector<int>& axes, const int dimC) {
+  NDArray means, stdev;
+  layerNormMoments(input, axes, means, stdev);
+
+  // dLdgTerms = standardized(input) * gradO
+  input.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), means, dLdgTerms, false);
+  dLdgTerms.applyTrueBroadcast(sd::BroadcastOpsTuple::Divide(), stdev + 1e-12, dLdgTerms, false);
+  dLdgTerms.applyScalar(sd::scalar::ReplaceNans, 0, dLdgTerms);
+  dLdgTerms *= gradO;
+
+  // dLdx = (g' - mean(g') - y * mean(g' * y)) / stdev, g' = gradO * gain, y = (input - mean) / stdev
+  auto scaled = gradO.ulike();
+  const_cast<NDArray&>(gradO).applyBroadcast(sd::broadcast::Multiply, {dimC}, gain, scaled);
+  auto y = input.ulike();
+  input.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), means, y, false);
+  y.applyTrueBroadcast(sd::BroadcastOpsTuple::Divide(), stdev, y, false);
+
+  auto meanScaled = scaled.reduceAlongDimension(reduce::Mean, axes, true);
+  auto meanScaledY = (scaled * y).reduceAlongDimension(reduce::Mean, axes, true);
+  scaled.applyTrueBroadcast(sd::BroadcastOpsTuple::Subtract(), meanScaled, dLdx, false);
+  y.applyTrueBroadcast(sd::BroadcastOpsTuple::Multiply(), meanScaledY, y, false);
+  dLdx -= y;
+  dLdx.applyTrueBroadcast(sd::BroadcastOpsTuple::Divide(), stdev, dLdx, false);
+  dLdx.applyScalar(sd::scalar::ReplaceNans, 0, dLdx);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif
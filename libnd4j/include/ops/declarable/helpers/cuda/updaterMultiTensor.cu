@@ -0,0 +1,87 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Multi-tensor updater, CUDA implementation: tensors go through the single tensor updater kernels
+// one after another, clipping and weight decay are applied around them
+//
+#include <ops/declarable/helpers/updatersHelpers.h>
+
+#include <cmath>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+void updaterMultiTensor(sd::LaunchContext* context, const int type, const std::vector<const NDArray*>& params,
+                        const std::vector<const NDArray*>& gradients, const std::vector<const NDArray*>& initStates,
+                        const std::vector<NDArray*>& updatedParams, const std::vector<NDArray*>& updatedStates,
+                        const MultiTensorUpdaterConfig& config) {
+  const int n = static_cast<int>(params.size());
+
+  double clip = 1.;
+  if (config.maxGlobalNorm > 0.) {
+    double total = 0.;
+    for (auto g : gradients) total += g->reduceNumber(reduce::SquaredNorm).e<double>(0);
+
+    const double norm = std::sqrt(total);
+    if (norm > config.maxGlobalNorm) clip = config.maxGlobalNorm / norm;
+  }
+
+  for (int t = 0; t < n; t++) {
+    auto gradient = *gradients[t] * clip;
+    NDArray update(gradient.ulike());
+
+    switch (type) {
+      case MULTI_SGD:
+        update.assign(gradient * config.lr);
+        break;
+      case MULTI_NESTEROVS:
+        updaterNesterovs(context, gradient, *initStates[t], update, *updatedStates[t], config.lr, config.beta1);
+        break;
+      case MULTI_RMS_PROP:
+        updaterRmsProp(context, gradient, *initStates[t], update, *updatedStates[t], config.lr, config.beta1,
+                       config.epsilon);
+        break;
+      case MULTI_ADAM:
+        updaterAdam(context, gradient, *initStates[t], *initStates[n + t], update, *updatedStates[t],
+                    *updatedStates[n + t], config.lr, config.beta1, config.beta2, config.epsilon, config.iteration);
+        break;
+      case MULTI_NADAM:
+        updaterNadam(context, gradient, *initStates[t], *initStates[n + t], update, *updatedStates[t],
+                     *updatedStates[n + t], config.lr, config.beta1, config.beta2, config.epsilon, config.iteration);
+        break;
+      case MULTI_AMS_GRAD:
+        updaterAmsGrad(context, gradient, *initStates[t], *initStates[n + t], *initStates[2 * n + t], update,
+                       *updatedStates[t], *updatedStates[n + t], *updatedStates[2 * n + t], config.lr, config.beta1,
+                       config.beta2, config.epsilon, config.iteration);
+        break;
+      default:
+        throw std::invalid_argument("updaterMultiTensor: unknown updater type");
+    }
+
+    if (config.weightDecay != 0.) update += *params[t] * (config.lr * config.weightDecay);
+
+    updatedParams[t]->assign(*params[t] - update);
+  }
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
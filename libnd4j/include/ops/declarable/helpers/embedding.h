@@ -0,0 +1,60 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Embedding row gathers: plain lookup, and bags pooled while gathering
+//
+#ifndef LIBND4J_HELPERS_EMBEDDING_H
+#define LIBND4J_HELPERS_EMBEDDING_H
+#include <array/NDArray.h>
+#include <system/op_boilerplate.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// pooling of the rows of a bag
+enum EmbeddingBagMode { EMBEDDING_BAG_SUM = 0, EMBEDDING_BAG_MEAN = 1, EMBEDDING_BAG_MAX = 2 };
+
+/**
+ * output[i, ...] = params[indices[i], ...]
+ * indices have to be checked against the first dimension of params beforehand
+ */
+SD_LIB_HIDDEN void embeddingLookup(sd::LaunchContext* context, const NDArray& params, const NDArray& indices,
+                                   NDArray& output);
+
+/**
+ * output[b, ...] = pool(weights[j] * params[indices[j], ...]) over j in [offsets[b], offsets[b + 1]),
+ * the last bag ends at the end of indices and empty bags give zeros. weights may be nullptr.
+ */
+SD_LIB_HIDDEN void embeddingBag(sd::LaunchContext* context, const NDArray& params, const NDArray& indices,
+                                const NDArray& offsets, const NDArray* weights, const int mode, NDArray& output);
+
+/**
+ * sparse gradient of embeddingBag w.r.t. params: gradRows[j, ...] is the gradient flowing into
+ * params[indices[j], ...], rows of repeated indices are to be summed by the consumer
+ */
+SD_LIB_HIDDEN void embeddingBagBp(sd::LaunchContext* context, const NDArray& params, const NDArray& indices,
+                                  const NDArray& offsets, const NDArray* weights, const NDArray& gradO,
+                                  const int mode, NDArray& gradRows);
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_EMBEDDING_H
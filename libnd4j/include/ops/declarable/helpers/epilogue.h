@@ -17,27 +17,27 @@
  ******************************************************************************/
 
 //
-// @author raver119@gmail.com
+// Fused output epilogue: bias addition followed by activation, applied in a single pass
 //
 
-#ifndef LIBND4J_BENCHMARKSUIT_H
-#define LIBND4J_BENCHMARKSUIT_H
-
-#include <string>
-#include <system/pointercast.h>
-#include <system/dll.h>
-#include <helpers/BenchmarkHelper.h>
-#include <array/NDArrayFactory.h>
+#ifndef LIBND4J_EPILOGUE_H
+#define LIBND4J_EPILOGUE_H
+#include <graph/FusedActivation.h>
+#include <ops/declarable/helpers/helpers.h>
 
 namespace sd {
-    class SD_LIB_EXPORT BenchmarkSuit {
-    public:
-        BenchmarkSuit() = default;
-        ~BenchmarkSuit() = default;
+namespace ops {
+namespace helpers {
 
-        virtual std::string runSuit() = 0;
-    };
-}
+/**
+ * output = activation(input + bias), where bias (optional) is broadcast along channelDim.
+ * input and output must have the same shape, and may be the same array.
+ */
+SD_LIB_HIDDEN void fusedEpilogue(sd::LaunchContext* context, const NDArray& input, const NDArray* bias, NDArray& output,
+                                 const int channelDim, const graph::FusedActivation activation, const double alpha);
 
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
 
-#endif //DEV_TESTS_BENCHMARKSUIT_H
+#endif  // LIBND4J_EPILOGUE_H
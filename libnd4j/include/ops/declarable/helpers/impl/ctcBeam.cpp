@@ -31,7 +31,9 @@
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <memory>
 #include <numeric>
+#include <stdexcept>
 #include <vector>
 
 namespace sd {
@@ -57,10 +59,6 @@ struct DefaultInvalid<T, typename std::enable_if<std::is_integral<T>::value>::ty
 
 template <typename T>
 struct SequenceNode {
-  // intrusive double links
-  SequenceNode<T>* prev = nullptr;
-  SequenceNode<T>* next = nullptr;
-
   // sequence prefix/parent
   SequenceNode<T>* prefix = nullptr;
 
@@ -92,7 +90,55 @@ struct SequenceNode {
 };
 
 /***
- * Sequence container.
+ * Pool of sequence nodes.
+ *
+ * Nodes are carved from blocks that grow geometrically and removed nodes go to a free list,
+ * so extending and pruning paths does not hit the allocator after the first few frames.
+ * All nodes are released at once with the pool.
+ */
+template <typename T>
+class SequenceNodePool {
+ public:
+  SequenceNodePool() = default;
+  SequenceNodePool(const SequenceNodePool& other) = delete;
+  SequenceNodePool& operator=(const SequenceNodePool& other) = delete;
+
+  SequenceNode<T>* acquire() {
+    SequenceNode<T>* node;
+    if (!free_.empty()) {
+      node = free_.back();
+      free_.pop_back();
+    } else {
+      if (used_ == block_size_) {
+        block_size_ = blocks_.empty() ? kInitialBlockSize : block_size_ * 2;
+        blocks_.emplace_back(new SequenceNode<T>[block_size_]);
+        used_ = 0;
+      }
+      node = &blocks_.back()[used_++];
+    }
+    *node = SequenceNode<T>();
+    return node;
+  }
+
+  void release(SequenceNode<T>* node) { free_.push_back(node); }
+
+  void clear() {
+    blocks_.clear();
+    free_.clear();
+    block_size_ = 0;
+    used_ = 0;
+  }
+
+ private:
+  static constexpr size_t kInitialBlockSize = 256;
+  std::vector<std::unique_ptr<SequenceNode<T>[]>> blocks_;
+  std::vector<SequenceNode<T>*> free_;
+  size_t block_size_ = 0;
+  size_t used_ = 0;
+};
+
+/***
+ * Sequence container: prefix tree of the label sequences.
  *
  * NOTE: it is not thread-safe
  *
@@ -156,46 +202,17 @@ struct SequenceNode {
 template <typename T>
 class SequenceContainer {
  public:
-  SequenceContainer() : count_(1) {
-    empty_path = new SequenceNode<T>();
-    current_ = empty_path;
-  }
+  SequenceContainer() { clear(); }
 
   SequenceContainer(const SequenceContainer& s) = delete;
-
-  SequenceContainer(SequenceContainer&& other) noexcept {
-    this->current_ = other.current_;
-    other.current_ = nullptr;
-  }
-
   SequenceContainer& operator=(const SequenceContainer& other) = delete;
 
-  SequenceContainer& operator=(SequenceContainer&& other) noexcept {
-    if (this != other) {
-      clear();
-      this->current_ = other.current_;
-      this->count_ = other.count_;
-      other.current_ = nullptr;
-      other.count_ = 0;
-    }
-    return *this;
-  }
-
-  SequenceNode<T>* getEmptyPath() { return current_; }
+  SequenceNode<T>* getEmptyPath() { return empty_path; }
 
   SequenceNode<T>* extendPath(SequenceNode<T>* prefix, T value) {
-    auto new_node = new SequenceNode<T>();
-
+    auto new_node = pool_.acquire();
     new_node->value = value;
     new_node->prefix = prefix;
-    // add in the holder
-    new_node->next = nullptr;
-    new_node->prev = current_;
-    /*std::cout << "add " << (long long)new_node << std::endl;
-    print_seq1(new_node);*/
-    if (current_) current_->next = new_node;
-
-    current_ = new_node;
     count_++;
     return new_node;
   }
@@ -205,17 +222,7 @@ class SequenceContainer {
 
     if (!seq->safeToRemove()) return;
 
-    SequenceNode<T>* previous = seq->prev;
-    SequenceNode<T>* next = seq->next;
-    if (previous) previous->next = next;
-    if (next) next->prev = previous;
-
-    if (current_ == seq) {
-      current_ = previous;
-    }
-    // std::cout << "remove " << (long long)seq << " " << std::endl;
-    // print_seq1(seq);
-    delete seq;
+    pool_.release(seq);
     count_--;
   }
 
@@ -237,24 +244,15 @@ class SequenceContainer {
     return {};
   }
 
+  // releases all nodes and starts over with the empty path
   void clear() {
-    // destruct all nodes
-    SequenceNode<T>* del = current_;
-    // int i = 0;
-    while (del) {
-      //++i;
-      SequenceNode<T>* temp = del->prev;
-      delete del;
-      del = temp;
-    }
-    current_ = nullptr;
-    // assert(count_==i);
+    pool_.clear();
+    empty_path = pool_.acquire();
+    count_ = 1;
   }
 
-  ~SequenceContainer() { clear(); }
-
  private:
-  SequenceNode<T>* current_ = nullptr;
+  SequenceNodePool<T> pool_;
 
   SequenceNode<T>* empty_path = nullptr;
 
@@ -293,60 +291,87 @@ SD_INLINE T pr(const int c, const BeamProb<T>& beam_prob, const SequenceNode<U>*
   return seq->value == c ? beam_prob.blank + prob : beam_prob.total + prob;
 }
 
-template <bool HasElementStride = false, typename Type, typename IndexType>
-void inner_beam_search(const Type* log_p, const uint64_t inc_p, IndexType* result_sequence, const uint64_t inc_res_seq,
-                       const uint64_t max_len_t, Type* result_prob, IndexType* result_seq_length, uint64_t len_t,
-                       const uint64_t len_c, const int blank_index, int beam_width, int nbest_len,
-                       bool normalize_logits, const uint64_t element_stride = 1L) {
+/***
+ * Beam search state of a single sequence.
+ *
+ * Frames are consumed one at a time with step(), so a sequence can be decoded at once or in chunks
+ * while the beams and the prefix tree are carried over between calls.
+ */
+template <typename Type, typename IndexType>
+class BeamSearchDecoder {
+ public:
   using BeamEntryType = BeamEntry<Type, IndexType>;
   using BeamEntryTypeEx = BeamEntryEx<Type, IndexType>;
 
-  if (beam_width < 1) beam_width = 1;
-  if (nbest_len > beam_width) nbest_len = beam_width;
-  // if len_t is greater than max_len_t truncate it
-  len_t = len_t > max_len_t ? max_len_t : len_t;
+  BeamSearchDecoder(const uint64_t len_c, const int blank_index, int beam_width, int nbest_len,
+                    bool normalize_logits)
+      : len_c_(len_c), blank_index_(blank_index), normalize_logits_(normalize_logits) {
+    if (beam_width < 1) beam_width = 1;
+    if (nbest_len > beam_width) nbest_len = beam_width;
+    beam_width_ = beam_width;
+    nbest_len_ = nbest_len;
+
+    // vectors: we will use it as array, here
+    last_beams_.resize(beam_width);
+    // as we skip blank indexes the count is beam_width * len_c
+    next_beams_.resize(beam_width * len_c);
+
+    // lookupContainer:
+    // it will keep sorted entries. so we will just move and compare the entry
+    // in each step there will be overlapped cases
+    // the size of overlapped cases in last_beam[0:beam_width]:
+    //    as we have beam_width size in each step after sort and pruning
+    //    there is at least one item who will not have any parent
+    //    and for the rest (beam_width-1) it will check  has_parent_in_container() ? 1 : 0
+    //    so maximum size of overlapped pairs is  beam_width-1
+    lookUp_.resize(beam_width - 1);
+    // additional storage to sort overlapped case by classes
+    child_class_sorter_help_.resize(beam_width - 1);
+    reset();
+  }
+
+  void reset() {
+    sequence_container_.clear();
+    BeamEntryType empty;
+    empty.prob.blank = 0;
+    empty.prob.total = log_sum_exp(empty.prob.blank, empty.prob.non_blank);
+    empty.sequence = sequence_container_.getEmptyPath();
+
+    last_beams_[0].entry = empty;
+    last_beams_[0].index_as_child = -1;
+    last_beams_[0].index_as_parent = -1;
+    last_beams_[0].children_count = 0;
+    last_beam_size_ = 1;
+    frames_ = 0;
+  }
+
+  uint64_t frames() const { return frames_; }
+
+  template <bool HasElementStride>
+  void decode(const Type* log_p, const uint64_t inc_p, const uint64_t len_t, const uint64_t element_stride = 1L) {
+    for (uint64_t t = 0; t < len_t; t++) {
+      step<HasElementStride>(log_p, element_stride);
+      log_p += inc_p;
+    }
+  }
+
+  // consumes one frame of log probabilities
+  template <bool HasElementStride>
+  void step(const Type* log_p, const uint64_t element_stride) {
+    auto& last_beams = last_beams_;
+    auto& next_beams = next_beams_;
+    auto& lookUp = lookUp_;
+    auto& child_class_sorter_help = child_class_sorter_help_;
+    const auto len_c = len_c_;
+    const auto blank_index = blank_index_;
+    const auto beam_width = beam_width_;
 
-  SequenceContainer<IndexType> sequence_container;
-  BeamEntryType empty;
-  empty.prob.blank = 0;
-  empty.prob.total = log_sum_exp(empty.prob.blank, empty.prob.non_blank);
-  empty.sequence = sequence_container.getEmptyPath();
-
-  // vectors: we will use it as array, here
-  std::vector<BeamEntryTypeEx> last_beams;
-  std::vector<BeamEntryType> next_beams;
-  last_beams.resize(beam_width);
-  // as we skip blank indexes the count is beam_width * len_c
-  next_beams.resize(beam_width * len_c);
-  last_beams[0].entry = empty;
-  last_beams[0].index_as_child = -1;
-  last_beams[0].index_as_parent = -1;
-  last_beams[0].children_count = 0;
-  auto last_beam_size = 1;
-
-  // lookupContainer:
-  // it will keep sorted entries. so we will just move and compare the entry
-  // in each step there will be overlapped cases
-  // the size of overlapped cases in last_beam[0:beam_width]:
-  //    as we have beam_width size in each step after sort and pruning
-  //    there is at least one item who will not have any parent
-  //    and for the rest (beam_width-1) it will check  has_parent_in_container() ? 1 : 0
-  //    so maximum size of overlapped pairs is  beam_width-1
-
-  std::vector<LookUpEntry<Type, IndexType>> lookUp;
-  lookUp.resize(beam_width - 1);
-
-  // additional storage to sort overlapped case by classes
-  std::vector<std::pair<IndexType, int>> child_class_sorter_help;
-  child_class_sorter_help.resize(beam_width - 1);
-  Type norm_offset = 0;
-
-  for (uint64_t t = 0; t < len_t; t++) {
     auto next_beam_size = 0;
-    if (normalize_logits) {
+    Type norm_offset = 0;
+    if (normalize_logits_) {
       norm_offset = softmax_normalization_term<HasElementStride, Type, IndexType>(log_p, len_c, element_stride);
     }
-    for (auto j = 0; j < last_beam_size; j++) {
+    for (auto j = 0; j < last_beam_size_; j++) {
       SequenceNode<IndexType>* seq = last_beams[j].entry.sequence;
       auto& cur_prob = last_beams[j].entry.prob;
       // if len(seq) > 0 then
@@ -358,7 +383,7 @@ void inner_beam_search(const Type* log_p, const uint64_t inc_p, IndexType* resul
                            : negative_infinity<Type>();
       blank_prob = log_p_blank + cur_prob.total;
 
-      if (normalize_logits) {
+      if (normalize_logits_) {
         non_blank_prob = non_blank_prob - norm_offset;
         blank_prob = blank_prob - norm_offset;
       }
@@ -399,7 +424,7 @@ void inner_beam_search(const Type* log_p, const uint64_t inc_p, IndexType* resul
         const auto prob = element<HasElementStride>(log_p, c, element_stride);  // log_p[c];
 
         non_blank_prob = pr(c, cur_prob, seq, prob);
-        if (normalize_logits) non_blank_prob = non_blank_prob - norm_offset;
+        if (normalize_logits_) non_blank_prob = non_blank_prob - norm_offset;
         // extend by new character
         auto look_up_beam_index_ex = -1;
         int found_index = -1;
@@ -421,7 +446,7 @@ void inner_beam_search(const Type* log_p, const uint64_t inc_p, IndexType* resul
             lookUp[found_index].next_beam_index = next_beam_size;
             extended_sequence->increaseRef();
           } else {
-            extended_sequence = sequence_container.extendPath(seq, c);
+            extended_sequence = sequence_container_.extendPath(seq, c);
           }
           entry.prob.non_blank = non_blank_prob;
           entry.prob.total = non_blank_prob;
@@ -441,112 +466,134 @@ void inner_beam_search(const Type* log_p, const uint64_t inc_p, IndexType* resul
 
     }  // iteration over  beams
 
-    log_p += inc_p;
+    last_beam_size_ = std::min(next_beam_size, beam_width);
+    // only the set of the best candidates matters here, the order is established when results are taken
+    if (last_beam_size_ < next_beam_size) {
+      std::nth_element(std::begin(next_beams), std::begin(next_beams) + last_beam_size_,
+                       std::begin(next_beams) + next_beam_size, compare_beam_prob<Type, IndexType>);
+    }
 
-    last_beam_size = std::min(next_beam_size, beam_width);
-#if !defined(NTH_ELEMENT)
-    // sort next beams to get candidates
-    std::partial_sort(std::begin(next_beams), std::begin(next_beams) + last_beam_size,
-                      std::begin(next_beams) + next_beam_size, compare_beam_prob<Type, IndexType>);
+    // copy top beams
+    for (int j = 0; j < last_beam_size_; j++) {
+      last_beams[j].entry = next_beams[j];
+      last_beams[j].index_as_child = -1;
+      last_beams[j].index_as_parent = -1;
+      last_beams[j].children_count = 0;
+    }
 
-#else
-    std::nth_element(std::begin(next_beams), std::begin(next_beams) + last_beam_size,
-                     std::begin(next_beams) + next_beam_size, compare_beam_prob<Type, IndexType>);
+    // return pruned sequences to the pool
+    for (auto j = beam_width; j < next_beam_size; j++) {
+      sequence_container_.remove(next_beams[j].sequence);
+    }
 
-#endif
+    // check overlapping cases and create lookUp with sorted classes as well
+    int look_up_index = 0;
+    for (auto j = 0; j < last_beam_size_; j++) {
+      // if it is not parent node then there is not any need to check
+      if (last_beams[j].entry.sequence->isFullyExtended()) {
+        auto parent_seq = last_beams[j].entry.sequence;
+        int children_count = 0;
+        for (int k = 0; k < last_beam_size_; k++) {
+          auto current = last_beams[k].entry.sequence;
+          if (current->prefix == parent_seq) {
+            child_class_sorter_help[children_count].first = current->value;
+            child_class_sorter_help[children_count].second = k;
+            ++children_count;
+          }
+        }
 
-    if (t < len_t) {
-      // copy top beams
-      for (int j = 0; j < last_beam_size; j++) {
-        last_beams[j].entry = next_beams[j];
-        last_beams[j].index_as_child = -1;
-        last_beams[j].index_as_parent = -1;
-        last_beams[j].children_count = 0;
+        if (children_count > 0) {
+          // sort by class
+          if (children_count > 1) {
+            std::sort(std::begin(child_class_sorter_help), std::begin(child_class_sorter_help) + children_count,
+                      [](const std::pair<IndexType, int>& left, const std::pair<IndexType, int>& right) {
+                        return left.first < right.first;
+                      });
+          }
+          last_beams[j].index_as_parent = look_up_index;
+          last_beams[j].children_count = children_count;
+
+          for (int l = 0; l < children_count; l++) {
+            int c = child_class_sorter_help[l].first;
+            int k = child_class_sorter_help[l].second;
+            last_beams[k].index_as_child = look_up_index;
+            auto seq = last_beams[k].entry.sequence;
+            lookUp[look_up_index].last_c = c;
+            lookUp[look_up_index].node = seq;
+            lookUp[look_up_index].next_beam_index = -1;
+            // next one
+            ++look_up_index;
+          }
+        }  // add sorted lookUps
       }
+    }  // overlap_direction identified to speed up lookUp
 
-      // delete sequences from the sequence_holder to decrease memory
-      for (auto j = beam_width; j < next_beam_size; j++) {
-        sequence_container.remove(next_beams[j].sequence);
-      }
+    ++frames_;
+  }
 
-      // check overlapping cases and create lookUp with sorted classes as well
-      int look_up_index = 0;
-      for (auto j = 0; j < last_beam_size; j++) {
-        // if it is not parent node then there is not any need to check
-        if (last_beams[j].entry.sequence->isFullyExtended()) {
-          auto parent_seq = last_beams[j].entry.sequence;
-          int children_count = 0;
-          for (int k = 0; k < last_beam_size; k++) {
-            auto current = last_beams[k].entry.sequence;
-            if (current->prefix == parent_seq) {
-              child_class_sorter_help[children_count].first = current->value;
-              child_class_sorter_help[children_count].second = k;
-              ++children_count;
-            }
-          }
+  // the current nbest beams, best first. empty when there are less than nbest beams
+  std::vector<BeamEntryType> best() const {
+    if (nbest_len_ > last_beam_size_) return {};
+    std::vector<BeamEntryType> top(last_beam_size_);
+    for (int j = 0; j < last_beam_size_; j++) top[j] = last_beams_[j].entry;
+    std::partial_sort(std::begin(top), std::begin(top) + nbest_len_, std::end(top),
+                      compare_beam_prob<Type, IndexType>);
+    top.resize(nbest_len_);
+    return top;
+  }
 
-          if (children_count > 0) {
-            // sort by class
-            if (children_count < 2) {
-              //
-              if (children_count > 1 && child_class_sorter_help[0].first > child_class_sorter_help[1].first) {
-                std::swap(child_class_sorter_help[0], child_class_sorter_help[1]);
-              }
-            } else {
-              std::sort(std::begin(child_class_sorter_help), std::begin(child_class_sorter_help) + children_count,
-                        [](const std::pair<int, int>& left, const std::pair<int, int>& right) {
-                          return left.first < right.first;
-                        });
-            }
-            last_beams[j].index_as_parent = look_up_index;
-            last_beams[j].children_count = children_count;
-
-            for (int l = 0; l < children_count; l++) {
-              int c = child_class_sorter_help[l].first;
-              int k = child_class_sorter_help[l].second;
-              // std::cout << c <<" , " << k << std::endl;
-              last_beams[k].index_as_child = look_up_index;
-              auto seq = last_beams[k].entry.sequence;
-              lookUp[look_up_index].last_c = c;
-              lookUp[look_up_index].node = seq;
-              lookUp[look_up_index].next_beam_index = -1;
-              // next one
-              ++look_up_index;
-            }
-          }  // add sorted lookUps
+  void storeResults(IndexType* result_sequence, const uint64_t inc_res_seq, const uint64_t max_len_t,
+                    Type* result_prob, IndexType* result_seq_length) const {
+    auto top = best();
+    if (!top.empty()) {
+      for (int j = 0; j < nbest_len_; j++) {
+        auto result_vector = SequenceContainer<IndexType>::getSequence(top[j].sequence, frames_);
+        const auto seq_size = std::min(static_cast<uint64_t>(result_vector.size()), max_len_t);
+
+        result_prob[j] = top[j].prob.total;
+        result_seq_length[j] = seq_size;
+        // copy sequence
+        for (uint64_t s = 0; s < seq_size; s++) {
+          result_sequence[s] = result_vector[s];
         }
-      }  // overlap_direction identified to speed up lookUp
-    }
 
-  }  // iterate over t
-#if defined(NTH_ELEMENT)
-  // use sort  for n elements as only nth_element was used
-  std::sort(std::begin(next_beams), std::begin(next_beams) + last_beam_size, compare_beam_prob<Type, IndexType>);
-#endif
-  // store nbest results
-  if (nbest_len <= last_beam_size) {
-    for (int j = 0; j < nbest_len; j++) {
-      auto top = next_beams[j];
-      auto result_vector = SequenceContainer<IndexType>::getSequence(top.sequence, len_t);
-      const auto seq_size = result_vector.size();
-
-      result_prob[j] = top.prob.total;
-      result_seq_length[j] = seq_size;
-      // copy sequence
-      for (auto s = 0; s < seq_size; s++) {
-        result_sequence[s] = result_vector[s];
+        result_sequence += inc_res_seq;
+      }
+    } else {
+      for (int j = 0; j < nbest_len_; j++) {
+        result_prob[j] = negative_infinity<Type>();
+        result_seq_length[j] = 0;
       }
-
-      result_sequence += inc_res_seq;
-    }
-  } else {
-    for (int j = 0; j < nbest_len; j++) {
-      result_prob[j] = negative_infinity<Type>();
-      result_seq_length[j] = 0;
-      ;
     }
   }
-  return;
+
+ private:
+  const uint64_t len_c_;
+  const int blank_index_;
+  const bool normalize_logits_;
+  int beam_width_;
+  int nbest_len_;
+
+  SequenceContainer<IndexType> sequence_container_;
+  std::vector<BeamEntryTypeEx> last_beams_;
+  std::vector<BeamEntryType> next_beams_;
+  std::vector<LookUpEntry<Type, IndexType>> lookUp_;
+  std::vector<std::pair<IndexType, int>> child_class_sorter_help_;
+  int last_beam_size_ = 1;
+  uint64_t frames_ = 0;
+};
+
+template <bool HasElementStride = false, typename Type, typename IndexType>
+void inner_beam_search(const Type* log_p, const uint64_t inc_p, IndexType* result_sequence, const uint64_t inc_res_seq,
+                       const uint64_t max_len_t, Type* result_prob, IndexType* result_seq_length, uint64_t len_t,
+                       const uint64_t len_c, const int blank_index, int beam_width, int nbest_len,
+                       bool normalize_logits, const uint64_t element_stride = 1L) {
+  // if len_t is greater than max_len_t truncate it
+  len_t = len_t > max_len_t ? max_len_t : len_t;
+
+  BeamSearchDecoder<Type, IndexType> decoder(len_c, blank_index, beam_width, nbest_len, normalize_logits);
+  decoder.template decode<HasElementStride>(log_p, inc_p, len_t, element_stride);
+  decoder.storeResults(result_sequence, inc_res_seq, max_len_t, result_prob, result_seq_length);
 }
 
 template <typename Type, typename IndexType = int>
@@ -567,7 +614,7 @@ void beamSearch_(const NDArray& logit, const NDArray& sequence_length, NDArray&
 
   if (len_c < 1 || max_len_t < 1) return;
   // defaulting blankIndex to the last class if its incorrect or -1
-  if (blank_index > len_c || blank_index < 0) blank_index = static_cast<int>(len_c) - 1;
+  if (blank_index >= len_c || blank_index < 0) blank_index = static_cast<int>(len_c) - 1;
 
   // strides
   auto batch_stride = rank > 2 ? strides[0] : 0;
@@ -625,9 +672,9 @@ void beamSearch_(const NDArray& logit, const NDArray& sequence_length, NDArray&
         auto seq_ptr = &(result_seq_ptr[b * batch_stride_res]);
 
         auto len_t = len_t_ptr ? len_t_ptr[b * element_stride_t] : max_len_t;
-        inner_beam_search<false, Type, IndexType>(ptr, inc_p, seq_ptr, inc_res, max_len_t, prob_ptr, seq_length_ptr,
-                                                  len_t, len_c, blank_index, beam_width, nbest_len, normalize_logits,
-                                                  element_stride);
+        inner_beam_search<true, Type, IndexType>(ptr, inc_p, seq_ptr, inc_res, max_len_t, prob_ptr, seq_length_ptr,
+                                                 len_t, len_c, blank_index, beam_width, nbest_len, normalize_logits,
+                                                 element_stride);
 
         ptr += batch_stride;
       }
@@ -654,8 +701,140 @@ BUILD_DOUBLE_TEMPLATE(template void beamSearch_,
                        int nbest_len, bool normalize_logits),
                       SD_FLOAT_TYPES, SD_INDEXING_TYPES);
 
+//////////////////////////////////////////////////////////////////////////
+// streaming decoder
+
+class CtcBeamSearchStream::Impl {
+ public:
+  virtual ~Impl() = default;
+  virtual sd::DataType dataType() const = 0;
+  virtual void feed(const NDArray& logits, const NDArray* frame_lengths) = 0;
+  virtual std::vector<CtcHypothesis> hypotheses(int batch_index) const = 0;
+  virtual sd::LongType frames(int batch_index) const = 0;
+  virtual void reset() = 0;
+};
+
+template <typename Type>
+class CtcBeamSearchStreamImpl : public CtcBeamSearchStream::Impl {
+ public:
+  CtcBeamSearchStreamImpl(int batch_len, int class_len, int blank_index, int beam_width, int nbest_len,
+                          bool normalize_logits) {
+    decoders_.reserve(batch_len);
+    for (int b = 0; b < batch_len; b++)
+      decoders_.emplace_back(new BeamSearchDecoder<Type, int>(class_len, blank_index, beam_width, nbest_len,
+                                                              normalize_logits));
+  }
+
+  sd::DataType dataType() const override { return DataTypeUtils::fromT<Type>(); }
+
+  void feed(const NDArray& logits, const NDArray* frame_lengths) override {
+    const auto strides = logits.stridesOf();
+    const auto len_t = logits.sizeAt(1);
+    const auto batch_stride = strides[0];
+    const auto inc_p = strides[1];
+    const auto element_stride = strides[2];
+    const auto logits_ptr = logits.bufferAsT<Type>();
+
+    std::vector<sd::LongType> lengths(decoders_.size(), len_t);
+    if (frame_lengths != nullptr) {
+      for (size_t b = 0; b < lengths.size(); b++)
+        lengths[b] = sd::math::sd_min(frame_lengths->e<sd::LongType>(b), len_t);
+    }
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto b = start; b < stop; b++) {
+        auto ptr = logits_ptr + b * batch_stride;
+        if (element_stride == 1)
+          decoders_[b]->template decode<false>(ptr, inc_p, lengths[b]);
+        else
+          decoders_[b]->template decode<true>(ptr, inc_p, lengths[b], element_stride);
+      }
+    };
+    samediff::Threads::parallel_for(func, 0, decoders_.size(), 1);
+  }
+
+  std::vector<CtcHypothesis> hypotheses(int batch_index) const override {
+    std::vector<CtcHypothesis> result;
+    for (auto& entry : decoders_[batch_index]->best()) {
+      CtcHypothesis hypothesis;
+      hypothesis.labels = SequenceContainer<int>::getSequence(entry.sequence, decoders_[batch_index]->frames());
+      hypothesis.logProb = static_cast<double>(entry.prob.total);
+      result.emplace_back(std::move(hypothesis));
+    }
+    return result;
+  }
+
+  sd::LongType frames(int batch_index) const override { return decoders_[batch_index]->frames(); }
+
+  void reset() override {
+    for (auto& decoder : decoders_) decoder->reset();
+  }
+
+ private:
+  std::vector<std::unique_ptr<BeamSearchDecoder<Type, int>>> decoders_;
+};
+
+template <typename Type>
+static CtcBeamSearchStream::Impl* createStreamImpl(int batch_len, int class_len, int blank_index, int beam_width,
+                                                   int nbest_len, bool normalize_logits) {
+  return new CtcBeamSearchStreamImpl<Type>(batch_len, class_len, blank_index, beam_width, nbest_len,
+                                           normalize_logits);
+}
+
+CtcBeamSearchStream::CtcBeamSearchStream(int batch_len, int class_len, int blank_index, int beam_width, int nbest_len,
+                                         bool normalize_logits)
+    : _batchLen(batch_len),
+      _classLen(class_len),
+      _blankIndex(blank_index),
+      _beamWidth(beam_width),
+      _nbestLen(nbest_len),
+      _normalizeLogits(normalize_logits) {
+  if (batch_len < 1 || class_len < 1)
+    throw std::invalid_argument("CtcBeamSearchStream: batch and class lengths should be positive");
+  // defaulting blankIndex to the last class if its incorrect or -1
+  if (_blankIndex >= class_len || _blankIndex < 0) _blankIndex = class_len - 1;
+}
+
+CtcBeamSearchStream::~CtcBeamSearchStream() { delete _impl; }
+
+void CtcBeamSearchStream::feed(const NDArray& logits, const NDArray* frame_lengths) {
+  if (logits.rankOf() != 3 || logits.sizeAt(0) != _batchLen || logits.sizeAt(2) != _classLen)
+    throw std::invalid_argument("CtcBeamSearchStream: logits should have shape {BATCH_LEN, CHUNK_FRAME_LEN, CLASS_LEN}");
+  if (frame_lengths != nullptr && frame_lengths->lengthOf() != _batchLen)
+    throw std::invalid_argument("CtcBeamSearchStream: frame lengths should have BATCH_LEN elements");
+
+  if (_impl == nullptr) {
+    BUILD_SINGLE_SELECTOR(logits.dataType(), _impl = createStreamImpl,
+                          (_batchLen, _classLen, _blankIndex, _beamWidth, _nbestLen, _normalizeLogits),
+                          SD_FLOAT_TYPES);
+  } else if (_impl->dataType() != logits.dataType()) {
+    throw std::invalid_argument("CtcBeamSearchStream: logits data type can't change between chunks");
+  }
+
+  NDArray::preparePrimaryUse({}, {&logits});
+  _impl->feed(logits, frame_lengths);
+  NDArray::registerPrimaryUse({}, {&logits});
+}
+
+std::vector<CtcHypothesis> CtcBeamSearchStream::hypotheses(int batch_index) const {
+  if (batch_index < 0 || batch_index >= _batchLen)
+    throw std::invalid_argument("CtcBeamSearchStream: batch index is out of range");
+  if (_impl == nullptr) return {};
+  return _impl->hypotheses(batch_index);
+}
+
+sd::LongType CtcBeamSearchStream::frames(int batch_index) const {
+  if (batch_index < 0 || batch_index >= _batchLen)
+    throw std::invalid_argument("CtcBeamSearchStream: batch index is out of range");
+  return _impl == nullptr ? 0 : _impl->frames(batch_index);
+}
+
+void CtcBeamSearchStream::reset() {
+  if (_impl != nullptr) _impl->reset();
+}
+
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
 
-#endif
\ No newline at end of file
+#endif
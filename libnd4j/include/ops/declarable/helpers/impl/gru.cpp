@@ -32,6 +32,7 @@
 // Kyunghyun Cho, Bart van Merrienboer, Caglar Gulcehre, Dzmitry Bahdanau, Fethi Bougares, Holger Schwenk, Yoshua Bengio
 // "Learning Phrase Representations using RNN Encoder-Decoder for StatnIntical Machine Translation"
 
+#include <array/NDArrayExpression.h>
 #include <helpers/MmulHelper.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/declarable/helpers/gru.h>
@@ -267,17 +268,20 @@ void gruCellBp(sd::LaunchContext* context, const NDArray* x, const NDArray* hLas
   // ***** feed forward step ***** //
 
   // reset gate
-  NDArray r = mmul(*x, Wrx) + mmul(*hLast, Wrh) + br;  // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-  r.applyTransform(transform::Sigmoid, r);
+  NDArray r = mmul(*x, Wrx);  // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
+  MmulHelper::mmul(hLast, &Wrh, &r, 1., 1.);
+  expr::assign(r, expr::sigmoid(expr::lazy(r) + expr::lazy(br)));
 
   // update gate
-  NDArray u = mmul(*x, Wux) + mmul(*hLast, Wuh) + bu;  // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-  u.applyTransform(transform::Sigmoid, u);
+  NDArray u = mmul(*x, Wux);  // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
+  MmulHelper::mmul(hLast, &Wuh, &u, 1., 1.);
+  expr::assign(u, expr::sigmoid(expr::lazy(u) + expr::lazy(bu)));
 
   // cell gate c = activation(x×Wcx + (r*hlast)×Wcu + bc)
-  NDArray c =
-      mmul(*x, Wcx) + mmul(r * *hLast, Wch) + *bc;  // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
-  c.applyTransform(transform::Tanh, c);
+  NDArray c = mmul(*x, Wcx);  // [bS, iS] × [iS, nU] + [bS, nU] × [nU, nU] + [nU] = [bS, nU]
+  NDArray rhLast = r * *hLast;
+  MmulHelper::mmul(&rhLast, &Wch, &c, 1., 1.);
+  expr::assign(c, expr::tanh(expr::lazy(c) + expr::lazy(*bc)));
 
   // h = (1 - u) * c + u * hPrev
 
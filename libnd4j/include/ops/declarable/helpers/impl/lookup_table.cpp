@@ -0,0 +1,451 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Open addressing hash tables over key and value arrays. They work on host buffers, so the same code serves
+// both backends.
+//
+#include <execution/Threads.h>
+#include <helpers/helper_hash.h>
+#include <ops/declarable/helpers/lookup_table.h>
+#include <ops/declarable/helpers/strings.h>
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// dense c-ordered host copy of array with the given type, unless it is such already
+static const NDArray* denseHost(const NDArray& array, sd::DataType dataType, std::unique_ptr<NDArray>& holder) {
+  if (array.dataType() == dataType && array.ordering() == 'c' && array.ews() == 1) {
+    array.syncToHost();
+    return &array;
+  }
+
+  holder.reset(new NDArray('c', array.getShapeAsVector(), dataType, array.getContext()));
+  holder->assign(array);
+  holder->syncToHost();
+  return holder.get();
+}
+
+// the output itself if it is dense and has the given type, otherwise a buffer to be copied into it with flushHost
+static NDArray* denseHostOutput(NDArray& array, sd::DataType dataType, std::unique_ptr<NDArray>& holder) {
+  if (array.dataType() == dataType && array.ordering() == 'c' && array.ews() == 1) return &array;
+
+  holder.reset(new NDArray('c', array.getShapeAsVector(), dataType, array.getContext()));
+  return holder.get();
+}
+
+static void flushHost(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (holder == nullptr) {
+    array.tickWriteHost();
+    return;
+  }
+
+  holder->tickWriteHost();
+  array.assign(*holder);
+}
+
+// finalizer of splitmix64: integer keys are often consecutive ids, their low bits have to be mixed
+static SD_INLINE sd::LongType mixLong(sd::LongType key) {
+  auto z = static_cast<uint64_t>(key);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return static_cast<sd::LongType>(z ^ (z >> 31));
+}
+
+// integer or utf8 keys, strings hash the same way as in string_to_hash_bucket
+class TableKeys {
+ private:
+  std::unique_ptr<Utf8Strings> _strings;
+  std::unique_ptr<NDArray> _holder;
+  const sd::LongType* _ints = nullptr;
+
+ public:
+  const sd::LongType length;
+
+  explicit TableKeys(const NDArray& keys) : length(keys.lengthOf()) {
+    if (keys.isS()) {
+      _strings.reset(new Utf8Strings(keys));
+    } else if (keys.isZ()) {
+      _ints = length > 0 ? denseHost(keys, sd::DataType::INT64, _holder)->bufferAsT<sd::LongType>() : nullptr;
+    } else {
+      throw std::invalid_argument("hash table: keys have to be integer or UTF8 strings");
+    }
+  }
+
+  bool isStrings() const { return _strings != nullptr; }
+
+  sd::LongType hash(sd::LongType e) const {
+    return isStrings() ? HashHelper::getInstance().getLongHash(_strings->at(e), _strings->size(e)) : mixLong(_ints[e]);
+  }
+
+  bool equals(sd::LongType e, const TableKeys& other, sd::LongType o) const {
+    if (!isStrings()) return _ints[e] == other._ints[o];
+
+    auto size = _strings->size(e);
+    return size == other._strings->size(o) && std::memcmp(_strings->at(e), other._strings->at(o), size) == 0;
+  }
+
+  // string keys only
+  const Utf8Strings& strings() const { return *_strings; }
+};
+
+static SD_INLINE sd::LongType homeSlot(sd::LongType hash, sd::LongType capacity) {
+  return static_cast<sd::LongType>(static_cast<uint64_t>(hash) & static_cast<uint64_t>(capacity - 1));
+}
+
+// position of the query within keys, or -1 if it isn't there
+static sd::LongType findEntry(const sd::LongType* table, sd::LongType capacity, const TableKeys& keys,
+                              const TableKeys& queries, sd::LongType query, sd::LongType hash) {
+  auto slot = homeSlot(hash, capacity);
+  for (sd::LongType probe = 0; probe < capacity; probe++) {
+    auto entry = table[2 * slot + 1];
+    if (entry < 0 || entry >= keys.length) return -1;
+
+    if (table[2 * slot] == hash && keys.equals(entry, queries, query)) return entry;
+
+    slot = (slot + 1) & (capacity - 1);
+  }
+
+  return -1;
+}
+
+/**
+ * inserts keys [first, last) into the index. Slots are claimed with compare-and-swap, the thread which claimed
+ * a slot writes its hash. A repeated key keeps the largest position, so the last occurrence wins regardless of
+ * the order threads get there
+ */
+static void insertEntries(sd::LongType* table, sd::LongType capacity, const TableKeys& keys, sd::LongType first,
+                          sd::LongType last) {
+  std::unique_ptr<std::atomic<sd::LongType>[]> slots(new std::atomic<sd::LongType>[capacity]);
+
+  auto load = PRAGMA_THREADS_FOR {
+    for (auto s = start; s < stop; s++) slots[s].store(table[2 * s + 1], std::memory_order_relaxed);
+  };
+  samediff::Threads::parallel_for(load, 0, capacity);
+
+  auto insert = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      auto hash = keys.hash(e);
+      auto slot = homeSlot(hash, capacity);
+      while (true) {
+        auto current = slots[slot].load();
+        if (current < 0) {
+          if (slots[slot].compare_exchange_strong(current, e)) {
+            table[2 * slot] = hash;
+            break;
+          }
+
+          // somebody else claimed the slot, it may hold the same key
+          continue;
+        }
+
+        if (keys.equals(current, keys, e)) {
+          while (current < e && !slots[slot].compare_exchange_weak(current, e)) {
+          }
+          break;
+        }
+
+        slot = (slot + 1) & (capacity - 1);
+      }
+    }
+  };
+  samediff::Threads::parallel_for(insert, first, last);
+
+  auto store = PRAGMA_THREADS_FOR {
+    for (auto s = start; s < stop; s++) table[2 * s + 1] = slots[s].load(std::memory_order_relaxed);
+  };
+  samediff::Threads::parallel_for(store, 0, capacity);
+}
+
+static void clearTable(sd::LongType* table, sd::LongType capacity) {
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto s = start; s < stop; s++) {
+      table[2 * s] = 0;
+      table[2 * s + 1] = -1;
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, capacity);
+}
+
+sd::LongType hashTableCapacity(sd::LongType numKeys) {
+  sd::LongType capacity = 8;
+  while (capacity < 2 * numKeys) capacity <<= 1;
+
+  return capacity;
+}
+
+std::string hashTableValidate(const NDArray& table, const NDArray& keys) {
+  if (!table.isZ() || table.rankOf() != 2 || table.sizeAt(1) != 2)
+    return "table index should be an integer [capacity, 2] matrix";
+
+  auto capacity = table.sizeAt(0);
+  if (capacity < 1 || (capacity & (capacity - 1)) != 0) return "table capacity should be a power of two";
+
+  if (keys.rankOf() > 1) return "keys should be a vector";
+
+  if (!keys.isZ() && keys.dataType() != sd::DataType::UTF8) return "keys should be integer or UTF8 strings";
+
+  if (keys.lengthOf() >= capacity) return "table capacity should exceed the number of keys";
+
+  return "";
+}
+
+void hashTableBuild(sd::LaunchContext* context, const NDArray& keys, NDArray& table) {
+  TableKeys tableKeys(keys);
+  auto capacity = table.sizeAt(0);
+
+  std::unique_ptr<NDArray> holder;
+  auto index = denseHostOutput(table, sd::DataType::INT64, holder)->bufferAsT<sd::LongType>();
+
+  clearTable(index, capacity);
+  insertEntries(index, capacity, tableKeys, 0, tableKeys.length);
+
+  flushHost(table, holder);
+}
+
+// number of elements in a row of values
+static sd::LongType rowLength(const NDArray& values) {
+  sd::LongType length = 1;
+  for (int d = 1; d < values.rankOf(); d++) length *= values.sizeAt(d);
+
+  return length;
+}
+
+void hashTableLookup(sd::LaunchContext* context, const NDArray& table, const NDArray& keys, const NDArray& values,
+                     const NDArray& queries, const NDArray* defaultValue, sd::LongType numOovBuckets,
+                     NDArray& output) {
+  TableKeys tableKeys(keys), tableQueries(queries);
+  if (tableKeys.isStrings() != tableQueries.isStrings())
+    throw std::invalid_argument("hashTableLookup: queries and keys should be both integer or both strings");
+
+  std::unique_ptr<NDArray> indexHolder, valuesHolder, outputHolder;
+  auto capacity = table.sizeAt(0);
+  auto index = denseHost(table, sd::DataType::INT64, indexHolder)->bufferAsT<sd::LongType>();
+
+  auto numQueries = tableQueries.length;
+
+  if (numOovBuckets > 0) {
+    // ids of known queries, following ids are the buckets of unknown ones
+    auto ids = keys.lengthOf() > 0 ? denseHost(values, sd::DataType::INT64, valuesHolder)->bufferAsT<sd::LongType>()
+                                   : nullptr;
+    auto out = denseHostOutput(output, sd::DataType::INT64, outputHolder)->bufferAsT<sd::LongType>();
+
+    auto func = PRAGMA_THREADS_FOR {
+      for (auto q = start; q < stop; q++) {
+        auto hash = tableQueries.hash(q);
+        auto entry = findEntry(index, capacity, tableKeys, tableQueries, q, hash);
+        out[q] = entry >= 0 ? ids[entry]
+                            : tableKeys.length + static_cast<sd::LongType>(static_cast<uint64_t>(hash) %
+                                                                           static_cast<uint64_t>(numOovBuckets));
+      }
+    };
+    samediff::Threads::parallel_for(func, 0, numQueries);
+
+    flushHost(output, outputHolder);
+    return;
+  }
+
+  auto row = rowLength(values);
+  auto rowBytes = row * DataTypeUtils::sizeOf(values.dataType());
+
+  NDArray defaultRow('c', {row}, values.dataType(), values.getContext());
+  if (defaultValue == nullptr)
+    defaultRow.nullify();
+  else if (defaultValue->lengthOf() == 1 && values.isZ())
+    defaultRow.assign(defaultValue->e<sd::LongType>(0));
+  else if (defaultValue->lengthOf() == 1)
+    defaultRow.assign(defaultValue->e<double>(0));
+  else
+    defaultRow.assign(defaultValue->reshape('c', {row}));
+  defaultRow.syncToHost();
+
+  auto source = keys.lengthOf() > 0 ? denseHost(values, values.dataType(), valuesHolder)->bufferAsT<int8_t>() : nullptr;
+  auto fallback = defaultRow.bufferAsT<int8_t>();
+  auto out = denseHostOutput(output, values.dataType(), outputHolder)->bufferAsT<int8_t>();
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto q = start; q < stop; q++) {
+      auto entry = findEntry(index, capacity, tableKeys, tableQueries, q, tableQueries.hash(q));
+      std::memcpy(out + q * rowBytes, entry >= 0 ? source + entry * rowBytes : fallback, rowBytes);
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, numQueries);
+
+  flushHost(output, outputHolder);
+}
+
+/**
+ * for every new key: its position in the table or -1, and whether it's the last occurrence of the key in newKeys,
+ * found through a temporary index over newKeys
+ */
+static void classifyNewKeys(const NDArray& table, const TableKeys& keys, const TableKeys& newKeys,
+                            std::vector<sd::LongType>& existing, std::vector<int8_t>& isLast) {
+  if (keys.isStrings() != newKeys.isStrings())
+    throw std::invalid_argument("hash table: new keys and keys should be both integer or both strings");
+
+  std::unique_ptr<NDArray> holder;
+  auto capacity = table.sizeAt(0);
+  auto index = denseHost(table, sd::DataType::INT64, holder)->bufferAsT<sd::LongType>();
+
+  auto ownCapacity = hashTableCapacity(newKeys.length);
+  std::vector<sd::LongType> ownIndex(2 * ownCapacity);
+  clearTable(ownIndex.data(), ownCapacity);
+  insertEntries(ownIndex.data(), ownCapacity, newKeys, 0, newKeys.length);
+
+  existing.resize(newKeys.length);
+  isLast.resize(newKeys.length);
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      auto hash = newKeys.hash(e);
+      existing[e] = findEntry(index, capacity, keys, newKeys, e, hash);
+      isLast[e] = findEntry(ownIndex.data(), ownCapacity, newKeys, newKeys, e, hash) == e ? 1 : 0;
+    }
+  };
+  samediff::Threads::parallel_for(func, 0, newKeys.length);
+}
+
+sd::LongType hashTableCountMissing(const NDArray& table, const NDArray& keys, const NDArray& newKeys) {
+  TableKeys tableKeys(keys), tableNewKeys(newKeys);
+  std::vector<sd::LongType> existing;
+  std::vector<int8_t> isLast;
+  classifyNewKeys(table, tableKeys, tableNewKeys, existing, isLast);
+
+  sd::LongType count = 0;
+  for (sd::LongType e = 0; e < tableNewKeys.length; e++)
+    if (isLast[e] && existing[e] < 0) count++;
+
+  return count;
+}
+
+void hashTableInsert(sd::LaunchContext* context, const NDArray& table, const NDArray& keys, const NDArray& values,
+                     const NDArray& newKeys, const NDArray& newValues, NDArray& outputTable, NDArray& outputKeys,
+                     NDArray& outputValues) {
+  TableKeys tableKeys(keys), tableNewKeys(newKeys);
+  std::vector<sd::LongType> existing;
+  std::vector<int8_t> isLast;
+  classifyNewKeys(table, tableKeys, tableNewKeys, existing, isLast);
+
+  // target position of every new key which makes it into the table, -1 for the overwritten occurrences
+  auto numKeys = tableKeys.length;
+  std::vector<sd::LongType> target(tableNewKeys.length, -1);
+  sd::LongType total = numKeys, appendedBytes = 0;
+  for (sd::LongType e = 0; e < tableNewKeys.length; e++) {
+    if (!isLast[e]) continue;
+
+    if (existing[e] >= 0) {
+      target[e] = existing[e];
+    } else {
+      target[e] = total++;
+      if (tableNewKeys.isStrings()) appendedBytes += tableNewKeys.strings().size(e);
+    }
+  }
+
+  if (total == 0) {
+    hashTableBuild(context, keys, outputTable);
+    return;
+  }
+
+  if (outputKeys.lengthOf() != total || outputValues.sizeAt(0) != total)
+    throw std::invalid_argument("hashTableInsert: outputs don't match the number of keys after insertion");
+
+  // keys: old ones followed by the appended ones
+  if (tableKeys.isStrings()) {
+    auto& oldKeys = tableKeys.strings();
+    auto& addedKeys = tableNewKeys.strings();
+    auto oldBytes = numKeys > 0 ? oldKeys.offsets[numKeys] : 0;
+    auto result = allocateStrings(outputKeys, oldBytes + appendedBytes);
+    if (numKeys > 0) {
+      std::memcpy(result.offsets, oldKeys.offsets, numKeys * sizeof(sd::LongType));
+      std::memcpy(result.data, oldKeys.data, oldBytes);
+    }
+
+    auto offset = oldBytes;
+    for (sd::LongType e = 0; e < tableNewKeys.length; e++) {
+      if (target[e] < numKeys) continue;
+
+      result.offsets[target[e]] = offset;
+      std::memcpy(result.data + offset, addedKeys.at(e), addedKeys.size(e));
+      offset += addedKeys.size(e);
+    }
+
+    finishStrings(outputKeys);
+  } else {
+    std::unique_ptr<NDArray> keysHolder, oldHolder, newHolder;
+    auto out = denseHostOutput(outputKeys, sd::DataType::INT64, keysHolder)->bufferAsT<sd::LongType>();
+    if (numKeys > 0)
+      std::memcpy(out, denseHost(keys, sd::DataType::INT64, oldHolder)->bufferAsT<sd::LongType>(),
+                  numKeys * sizeof(sd::LongType));
+
+    auto added = tableNewKeys.length > 0 ? denseHost(newKeys, sd::DataType::INT64, newHolder)->bufferAsT<sd::LongType>()
+                                         : nullptr;
+    for (sd::LongType e = 0; e < tableNewKeys.length; e++)
+      if (target[e] >= numKeys) out[target[e]] = added[e];
+
+    flushHost(outputKeys, keysHolder);
+  }
+
+  // values: old rows, replaced and appended rows written in parallel, targets are distinct
+  {
+    std::unique_ptr<NDArray> valuesHolder, oldHolder, newHolder;
+    auto rowBytes = rowLength(values) * DataTypeUtils::sizeOf(values.dataType());
+    auto out = denseHostOutput(outputValues, values.dataType(), valuesHolder)->bufferAsT<int8_t>();
+    if (numKeys > 0)
+      std::memcpy(out, denseHost(values, values.dataType(), oldHolder)->bufferAsT<int8_t>(), numKeys * rowBytes);
+
+    if (tableNewKeys.length > 0) {
+      auto added = denseHost(newValues, values.dataType(), newHolder)->bufferAsT<int8_t>();
+      auto func = PRAGMA_THREADS_FOR {
+        for (auto e = start; e < stop; e++)
+          if (target[e] >= 0) std::memcpy(out + target[e] * rowBytes, added + e * rowBytes, rowBytes);
+      };
+      samediff::Threads::parallel_for(func, 0, tableNewKeys.length);
+    }
+
+    flushHost(outputValues, valuesHolder);
+  }
+
+  // index: updated in place if it has room, rebuilt otherwise
+  TableKeys allKeys(outputKeys);
+  auto capacity = outputTable.sizeAt(0);
+  if (total >= capacity) throw std::invalid_argument("hashTableInsert: output table capacity is too small");
+
+  std::unique_ptr<NDArray> indexHolder, oldIndexHolder;
+  auto index = denseHostOutput(outputTable, sd::DataType::INT64, indexHolder)->bufferAsT<sd::LongType>();
+  if (capacity == table.sizeAt(0)) {
+    std::memcpy(index, denseHost(table, sd::DataType::INT64, oldIndexHolder)->bufferAsT<sd::LongType>(),
+                2 * capacity * sizeof(sd::LongType));
+    insertEntries(index, capacity, allKeys, numKeys, total);
+  } else {
+    clearTable(index, capacity);
+    insertEntries(index, capacity, allKeys, 0, total);
+  }
+
+  flushHost(outputTable, indexHolder);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
@@ -250,8 +250,8 @@ void lstmLayerCell(const NDArray* x, const NDArray* Wx, const NDArray* Wr, const
 
   const sd::LongType nOut = Wx->sizeAt(-1) / 4;
 
-  auto z = mmul(*x, *Wx) + mmul(*hI, *Wr);  //   [bs, nIn] * [nIn, 4*nOut] + [bs, nOut] * [nOut, 4*nOut] = [bS, 4*nOut]
-                                            // or [nIn] * [nIn, 4*nOut] + [nOut] * [nOut, 4*nOut] = [4*nOut]
+  auto z = mmul(*x, *Wx);                 //   [bs, nIn] * [nIn, 4*nOut] + [bs, nOut] * [nOut, 4*nOut] = [bS, 4*nOut]
+  MmulHelper::mmul(hI, Wr, &z, 1., 1.);  // or [nIn] * [nIn, 4*nOut] + [nOut] * [nOut, 4*nOut] = [4*nOut]
 
   // add biases if they are given
   if (b != nullptr) z += *b;  // broadcast [bS, 4*nOut](or[4*nOut]) + [4*nOut] = [bS, 4*nOut]
@@ -298,9 +298,8 @@ void lstmLayerCell(const NDArray* x, const NDArray* Wx, const NDArray* Wr, const
 
   const sd::LongType nOut = Wx->sizeAt(-1) / 4;
 
-  z->assign(mmul(*x, *Wx) +
-            mmul(*hI, *Wr));  //   [bs, nIn] * [nIn, 4*nOut] + [bs, nOut] * [nOut, 4*nOut] = [bS, 4*nOut]
-                              // or [nIn] * [nIn, 4*nOut] + [nOut] * [nOut, 4*nOut] = [4*nOut]
+  MmulHelper::mmul(x, Wx, z, 1., 0.);  //   [bs, nIn] * [nIn, 4*nOut] + [bs, nOut] * [nOut, 4*nOut] = [bS, 4*nOut]
+  MmulHelper::mmul(hI, Wr, z, 1., 1.);  // or [nIn] * [nIn, 4*nOut] + [nOut] * [nOut, 4*nOut] = [4*nOut]
   // add biases if they are given
   if (b != nullptr) *z += *b;  // broadcast [bS, 4*nOut](or[4*nOut]) + [4*nOut] = [bS, 4*nOut]
 
@@ -0,0 +1,375 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// CSR conversions and sparse x dense kernels. They work on host buffers, so the same code serves
+// both backends. Rows are split between threads so that every thread gets about the same number
+// of non-zero elements.
+//
+#include <execution/Threads.h>
+#include <ops/declarable/helpers/sparse.h>
+#include <system/Environment.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// dense c-ordered copy of array with the given type, unless it is such already
+static const NDArray* denseHost(const NDArray& array, sd::DataType dataType, std::unique_ptr<NDArray>& holder) {
+  if (array.dataType() == dataType && array.ordering() == 'c' && array.ews() == 1) return &array;
+
+  holder.reset(new NDArray('c', array.getShapeAsVector(), dataType, array.getContext()));
+  holder->assign(array);
+  holder->syncToHost();
+  return holder.get();
+}
+
+// the output itself if it is dense, otherwise a buffer to be copied into it with flushHost
+static NDArray* denseHostOutput(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (array.ordering() == 'c' && array.ews() == 1) return &array;
+
+  holder.reset(new NDArray('c', array.getShapeAsVector(), array.dataType(), array.getContext()));
+  return holder.get();
+}
+
+static void flushHost(NDArray& array, std::unique_ptr<NDArray>& holder) {
+  if (holder == nullptr) return;
+
+  holder->tickWriteHost();
+  array.assign(*holder);
+}
+
+// first rows of chunks holding about the same number of rows plus non-zero elements
+static std::vector<sd::LongType> balancedRows(const sd::LongType* rowPointers, sd::LongType rows) {
+  const sd::LongType chunks = std::max<sd::LongType>(
+      1, std::min<sd::LongType>(rows, 4 * sd::Environment::getInstance().maxMasterThreads()));
+  const sd::LongType total = rowPointers[rows] + rows;
+
+  std::vector<sd::LongType> bounds(chunks + 1, rows);
+  bounds[0] = 0;
+  for (sd::LongType c = 1; c < chunks; c++) {
+    const sd::LongType target = total * c / chunks;
+    // rowPointers[r] + r is increasing in r
+    sd::LongType lo = bounds[c - 1], hi = rows;
+    while (lo < hi) {
+      const auto mid = lo + (hi - lo) / 2;
+      if (rowPointers[mid] + mid < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    bounds[c] = lo;
+  }
+
+  return bounds;
+}
+
+template <typename FUNC>
+static void forBalancedRows(const sd::LongType* rowPointers, sd::LongType rows, FUNC&& rowFunc) {
+  auto bounds = balancedRows(rowPointers, rows);
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto c = start; c < stop; c++)
+      for (auto r = bounds[c]; r < bounds[c + 1]; r++) rowFunc(r);
+  };
+
+  samediff::Threads::parallel_for(func, 0, bounds.size() - 1);
+}
+
+//////////////////////////////////////////////////////////////////////////
+std::string csrValidate(const CsrMatrix& matrix) {
+  if (matrix.rowPointers == nullptr || matrix.columns == nullptr || matrix.values == nullptr)
+    return "rowPointers, columns and values are required";
+  if (matrix.rowPointers->rankOf() != 1 || matrix.rowPointers->lengthOf() < 1)
+    return "rowPointers should be a non-empty vector";
+  if (matrix.columns->lengthOf() != matrix.values->lengthOf())
+    return "columns and values should have the same length";
+
+  NDArray::preparePrimaryUse({}, {matrix.rowPointers, matrix.columns});
+  std::unique_ptr<NDArray> rpHolder, colHolder;
+  auto rp = denseHost(*matrix.rowPointers, sd::DataType::INT64, rpHolder)->bufferAsT<sd::LongType>();
+  auto col = denseHost(*matrix.columns, sd::DataType::INT64, colHolder)->bufferAsT<sd::LongType>();
+
+  std::string error;
+  if (rp[0] != 0)
+    error = "rowPointers should start with 0";
+  else if (rp[matrix.rows] != matrix.nnz())
+    error = "last of rowPointers should be the number of values";
+  else {
+    for (sd::LongType r = 0; r < matrix.rows && error.empty(); r++)
+      if (rp[r + 1] < rp[r]) error = "rowPointers should be non-decreasing";
+
+    for (sd::LongType j = 0; j < matrix.nnz() && error.empty(); j++)
+      if (col[j] < 0 || col[j] >= matrix.cols) error = "columns should be within [0, number of columns)";
+  }
+
+  NDArray::registerPrimaryUse({}, {matrix.rowPointers, matrix.columns});
+  return error;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static sd::LongType countNonZeros_(const NDArray& dense) {
+  std::unique_ptr<NDArray> holder;
+  auto x = denseHost(dense, dense.dataType(), holder)->bufferAsT<T>();
+
+  sd::LongType count = 0;
+  for (sd::LongType e = 0; e < dense.lengthOf(); e++)
+    if (x[e] != static_cast<T>(0)) count++;
+
+  return count;
+}
+
+sd::LongType csrCountNonZeros(const NDArray& dense) {
+  NDArray::preparePrimaryUse({}, {&dense});
+  sd::LongType count;
+  BUILD_SINGLE_SELECTOR(dense.dataType(), count = countNonZeros_, (dense), SD_COMMON_TYPES);
+  NDArray::registerPrimaryUse({}, {&dense});
+  return count;
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void denseToCsr_(const NDArray& dense, NDArray& rowPointers, NDArray& columns, NDArray& values) {
+  std::unique_ptr<NDArray> holder;
+  auto x = denseHost(dense, dense.dataType(), holder)->bufferAsT<T>();
+
+  const auto rows = dense.sizeAt(0);
+  const auto cols = dense.sizeAt(1);
+  auto rp = rowPointers.bufferAsT<sd::LongType>();
+  auto col = columns.bufferAsT<sd::LongType>();
+  auto val = values.bufferAsT<T>();
+
+  // count per row, then fill every row at its offset
+  auto count = PRAGMA_THREADS_FOR {
+    for (auto r = start; r < stop; r++) {
+      sd::LongType n = 0;
+      for (sd::LongType c = 0; c < cols; c++)
+        if (x[r * cols + c] != static_cast<T>(0)) n++;
+      rp[r + 1] = n;
+    }
+  };
+  samediff::Threads::parallel_for(count, 0, rows);
+
+  rp[0] = 0;
+  for (sd::LongType r = 0; r < rows; r++) rp[r + 1] += rp[r];
+
+  auto fill = PRAGMA_THREADS_FOR {
+    for (auto r = start; r < stop; r++) {
+      auto pos = rp[r];
+      for (sd::LongType c = 0; c < cols; c++) {
+        const auto v = x[r * cols + c];
+        if (v == static_cast<T>(0)) continue;
+        col[pos] = c;
+        val[pos++] = v;
+      }
+    }
+  };
+  samediff::Threads::parallel_for(fill, 0, rows);
+}
+
+void denseToCsr(sd::LaunchContext* context, const NDArray& dense, NDArray& rowPointers, NDArray& columns,
+                NDArray& values) {
+  NDArray::preparePrimaryUse({&rowPointers, &columns, &values}, {&dense});
+  BUILD_SINGLE_SELECTOR(dense.dataType(), denseToCsr_, (dense, rowPointers, columns, values), SD_COMMON_TYPES);
+  NDArray::registerPrimaryUse({&rowPointers, &columns, &values}, {&dense});
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void csrToDense_(const CsrMatrix& matrix, NDArray& dense) {
+  std::unique_ptr<NDArray> rpHolder, colHolder, valHolder, outHolder;
+  auto rp = denseHost(*matrix.rowPointers, sd::DataType::INT64, rpHolder)->bufferAsT<sd::LongType>();
+  auto col = denseHost(*matrix.columns, sd::DataType::INT64, colHolder)->bufferAsT<sd::LongType>();
+  auto val = denseHost(*matrix.values, dense.dataType(), valHolder)->bufferAsT<T>();
+  auto out = denseHostOutput(dense, outHolder);
+  auto z = out->bufferAsT<T>();
+  const auto cols = matrix.cols;
+
+  std::fill(z, z + out->lengthOf(), static_cast<T>(0));
+
+  forBalancedRows(rp, matrix.rows, [&](sd::LongType r) {
+    T* zr = z + r * cols;
+    for (auto j = rp[r]; j < rp[r + 1]; j++) zr[col[j]] += val[j];
+  });
+
+  flushHost(dense, outHolder);
+}
+
+void csrToDense(sd::LaunchContext* context, const CsrMatrix& matrix, NDArray& dense) {
+  NDArray::preparePrimaryUse({&dense}, {matrix.rowPointers, matrix.columns, matrix.values});
+  BUILD_SINGLE_SELECTOR(dense.dataType(), csrToDense_, (matrix, dense), SD_COMMON_TYPES);
+  NDArray::registerPrimaryUse({&dense}, {matrix.rowPointers, matrix.columns, matrix.values});
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void cooToCsr_(const NDArray& indices, const NDArray& values, sd::LongType rows, NDArray& rowPointers,
+                      NDArray& columns, NDArray& csrValues) {
+  std::unique_ptr<NDArray> idxHolder, valHolder;
+  auto idx = denseHost(indices, sd::DataType::INT64, idxHolder)->bufferAsT<sd::LongType>();
+  auto v = denseHost(values, csrValues.dataType(), valHolder)->bufferAsT<T>();
+
+  const auto nnz = values.lengthOf();
+  auto rp = rowPointers.bufferAsT<sd::LongType>();
+  auto col = columns.bufferAsT<sd::LongType>();
+  auto val = csrValues.bufferAsT<T>();
+
+  // counting sort by row keeps the given order within rows
+  std::fill(rp, rp + rows + 1, 0);
+  for (sd::LongType j = 0; j < nnz; j++) {
+    const auto r = idx[2 * j];
+    if (r < 0 || r >= rows) throw std::invalid_argument("cooToCsr: row index is out of range");
+    rp[r + 1]++;
+  }
+  for (sd::LongType r = 0; r < rows; r++) rp[r + 1] += rp[r];
+
+  std::vector<sd::LongType> next(rp, rp + rows);
+  for (sd::LongType j = 0; j < nnz; j++) {
+    const auto pos = next[idx[2 * j]]++;
+    col[pos] = idx[2 * j + 1];
+    val[pos] = v[j];
+  }
+
+  // and then the entries of every row are ordered by column
+  forBalancedRows(rp, rows, [&](sd::LongType r) {
+    const auto first = rp[r], last = rp[r + 1];
+    if (std::is_sorted(col + first, col + last)) return;
+
+    std::vector<std::pair<sd::LongType, T>> entries(last - first);
+    for (auto j = first; j < last; j++) entries[j - first] = {col[j], val[j]};
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const std::pair<sd::LongType, T>& a, const std::pair<sd::LongType, T>& b) {
+                       return a.first < b.first;
+                     });
+    for (auto j = first; j < last; j++) {
+      col[j] = entries[j - first].first;
+      val[j] = entries[j - first].second;
+    }
+  });
+}
+
+void cooToCsr(sd::LaunchContext* context, const NDArray& indices, const NDArray& values, sd::LongType rows,
+              NDArray& rowPointers, NDArray& columns, NDArray& csrValues) {
+  NDArray::preparePrimaryUse({&rowPointers, &columns, &csrValues}, {&indices, &values});
+  BUILD_SINGLE_SELECTOR(csrValues.dataType(), cooToCsr_, (indices, values, rows, rowPointers, columns, csrValues),
+                        SD_COMMON_TYPES);
+  NDArray::registerPrimaryUse({&rowPointers, &columns, &csrValues}, {&indices, &values});
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void csrMatmul_(const CsrMatrix& matrix, const NDArray& dense, NDArray& output) {
+  std::unique_ptr<NDArray> rpHolder, colHolder, valHolder, denseHolder, outHolder;
+  auto rp = denseHost(*matrix.rowPointers, sd::DataType::INT64, rpHolder)->bufferAsT<sd::LongType>();
+  auto col = denseHost(*matrix.columns, sd::DataType::INT64, colHolder)->bufferAsT<sd::LongType>();
+  auto val = denseHost(*matrix.values, output.dataType(), valHolder)->bufferAsT<T>();
+  auto b = denseHost(dense, output.dataType(), denseHolder)->bufferAsT<T>();
+  auto z = denseHostOutput(output, outHolder)->bufferAsT<T>();
+
+  // a vector is multiplied as a single column
+  const sd::LongType k = dense.rankOf() == 1 ? 1 : dense.sizeAt(1);
+
+  if (k == 1) {
+    forBalancedRows(rp, matrix.rows, [&](sd::LongType r) {
+      T sum = static_cast<T>(0);
+      for (auto j = rp[r]; j < rp[r + 1]; j++) sum += val[j] * b[col[j]];
+      z[r] = sum;
+    });
+  } else {
+    forBalancedRows(rp, matrix.rows, [&](sd::LongType r) {
+      T* zr = z + r * k;
+      std::fill(zr, zr + k, static_cast<T>(0));
+      for (auto j = rp[r]; j < rp[r + 1]; j++) {
+        const T v = val[j];
+        const T* br = b + col[j] * k;
+        PRAGMA_OMP_SIMD
+        for (sd::LongType e = 0; e < k; e++) zr[e] += v * br[e];
+      }
+    });
+  }
+
+  flushHost(output, outHolder);
+}
+
+void csrMatmul(sd::LaunchContext* context, const CsrMatrix& matrix, const NDArray& dense, NDArray& output) {
+  NDArray::preparePrimaryUse({&output}, {matrix.rowPointers, matrix.columns, matrix.values, &dense});
+  BUILD_SINGLE_SELECTOR(output.dataType(), csrMatmul_, (matrix, dense, output), SD_FLOAT_TYPES);
+  NDArray::registerPrimaryUse({&output}, {matrix.rowPointers, matrix.columns, matrix.values, &dense});
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void csrMultiplyDense_(const CsrMatrix& matrix, const NDArray& dense, NDArray& outputValues) {
+  std::unique_ptr<NDArray> rpHolder, colHolder, valHolder, denseHolder, outHolder;
+  auto rp = denseHost(*matrix.rowPointers, sd::DataType::INT64, rpHolder)->bufferAsT<sd::LongType>();
+  auto col = denseHost(*matrix.columns, sd::DataType::INT64, colHolder)->bufferAsT<sd::LongType>();
+  auto val = denseHost(*matrix.values, outputValues.dataType(), valHolder)->bufferAsT<T>();
+  auto y = denseHost(dense, outputValues.dataType(), denseHolder)->bufferAsT<T>();
+  auto z = denseHostOutput(outputValues, outHolder)->bufferAsT<T>();
+  const auto cols = matrix.cols;
+
+  forBalancedRows(rp, matrix.rows, [&](sd::LongType r) {
+    const T* yr = y + r * cols;
+    for (auto j = rp[r]; j < rp[r + 1]; j++) z[j] = val[j] * yr[col[j]];
+  });
+
+  flushHost(outputValues, outHolder);
+}
+
+void csrMultiplyDense(sd::LaunchContext* context, const CsrMatrix& matrix, const NDArray& dense,
+                      NDArray& outputValues) {
+  NDArray::preparePrimaryUse({&outputValues}, {matrix.rowPointers, matrix.columns, matrix.values, &dense});
+  BUILD_SINGLE_SELECTOR(outputValues.dataType(), csrMultiplyDense_, (matrix, dense, outputValues), SD_FLOAT_TYPES);
+  NDArray::registerPrimaryUse({&outputValues}, {matrix.rowPointers, matrix.columns, matrix.values, &dense});
+}
+
+//////////////////////////////////////////////////////////////////////////
+template <typename T>
+static void csrAddDense_(const CsrMatrix& matrix, const NDArray& dense, NDArray& output) {
+  std::unique_ptr<NDArray> rpHolder, colHolder, valHolder, denseHolder, outHolder;
+  auto rp = denseHost(*matrix.rowPointers, sd::DataType::INT64, rpHolder)->bufferAsT<sd::LongType>();
+  auto col = denseHost(*matrix.columns, sd::DataType::INT64, colHolder)->bufferAsT<sd::LongType>();
+  auto val = denseHost(*matrix.values, output.dataType(), valHolder)->bufferAsT<T>();
+  auto y = denseHost(dense, output.dataType(), denseHolder)->bufferAsT<T>();
+  auto z = denseHostOutput(output, outHolder)->bufferAsT<T>();
+  const auto cols = matrix.cols;
+
+  forBalancedRows(rp, matrix.rows, [&](sd::LongType r) {
+    T* zr = z + r * cols;
+    const T* yr = y + r * cols;
+    std::copy(yr, yr + cols, zr);
+    for (auto j = rp[r]; j < rp[r + 1]; j++) zr[col[j]] += val[j];
+  });
+
+  flushHost(output, outHolder);
+}
+
+void csrAddDense(sd::LaunchContext* context, const CsrMatrix& matrix, const NDArray& dense, NDArray& output) {
+  NDArray::preparePrimaryUse({&output}, {matrix.rowPointers, matrix.columns, matrix.values, &dense});
+  BUILD_SINGLE_SELECTOR(output.dataType(), csrAddDense_, (matrix, dense, output), SD_FLOAT_TYPES);
+  NDArray::registerPrimaryUse({&output}, {matrix.rowPointers, matrix.columns, matrix.values, &dense});
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
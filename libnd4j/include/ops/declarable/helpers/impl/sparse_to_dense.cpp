@@ -25,6 +25,7 @@
 #include <system/op_boilerplate.h>
 
 #if NOT_EXCLUDED(OP_compat_sparse_to_dense)
+#include <execution/Threads.h>
 #include <helpers/ShapeUtils.h>
 #include <helpers/StringUtils.h>
 #include <ops/declarable/helpers/sparse_to_dense.h>
@@ -39,17 +40,34 @@ static void fill_(const void *vvalues, const void *vindices, void *voutput, cons
   auto indices = reinterpret_cast<const I *>(vindices);
   auto output = reinterpret_cast<X *>(voutput);
 
-  int coords[SD_MAX_RANK];
-  uint64_t pos = 0;
-  for (uint64_t e = 0L; e < length; e++) {
-    // indices come in blocks
-    for (uint8_t p = 0; p < rank; p++) {
-      coords[p] = indices[pos++];
+  // indices come in blocks of rank coordinates
+  std::vector<sd::LongType> offsets(length);
+  auto func = PRAGMA_THREADS_FOR {
+    sd::LongType coords[SD_MAX_RANK];
+    for (auto e = start; e < stop; e++) {
+      for (uint8_t p = 0; p < rank; p++) coords[p] = indices[e * rank + p];
+
+      offsets[e] = shape::getOffset(zShapeInfo, coords);
     }
+  };
+
+  samediff::Threads::parallel_for(func, 0, length);
+
+  // sorted indices land at distinct offsets and can be scattered in parallel. otherwise indices may repeat,
+  // so values are written serially and the last value for an index wins
+  bool distinct = true;
+  for (uint64_t e = 1; e < length && distinct; e++) distinct = offsets[e - 1] < offsets[e];
 
-    // fill output at given coords with sparse value
-    output[shape::getOffset(zShapeInfo, coords)] = values[e];
+  if (!distinct) {
+    for (uint64_t e = 0; e < length; e++) output[offsets[e]] = values[e];
+    return;
   }
+
+  auto scatter = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) output[offsets[e]] = values[e];
+  };
+
+  samediff::Threads::parallel_for(scatter, 0, length);
 }
 
 void compat_sparse_to_dense(const NDArray &values, const NDArray &indices, NDArray *def, NDArray &output) {
@@ -0,0 +1,453 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched utf8 string kernels. They work on host buffers, so the same code serves both backends.
+//
+#include <execution/Threads.h>
+#include <helpers/ShapeUtils.h>
+#include <helpers/helper_hash.h>
+#include <ops/declarable/helpers/strings.h>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+constexpr uint64_t ASCII_HIGH_BITS = 0x8080808080808080ull;
+constexpr uint64_t ASCII_ONES = 0x0101010101010101ull;
+
+Utf8Output allocateStrings(NDArray& output, sd::LongType dataLength) {
+  auto headerLength = ShapeUtils::stringBufferHeaderRequirements(output.lengthOf());
+
+  output.dataBuffer()->allocatePrimary();
+  output.dataBuffer()->expand(headerLength + dataLength);
+
+  Utf8Output result;
+  result.offsets = output.bufferAsT<sd::LongType>();
+  result.data = reinterpret_cast<char*>(output.bufferAsT<int8_t>()) + headerLength;
+  result.offsets[output.lengthOf()] = dataLength;
+  return result;
+}
+
+void finishStrings(NDArray& output) {
+  output.tickWriteHost();
+  output.syncToDevice();
+}
+
+// INT64 output is written in place when it's dense, otherwise through a temporary flushed by flushIndices
+static sd::LongType* indicesOutput(NDArray& output, std::unique_ptr<NDArray>& holder) {
+  if (output.dataType() == sd::DataType::INT64 && output.ordering() == 'c' && output.ews() == 1) {
+    output.syncToHost();
+    return output.bufferAsT<sd::LongType>();
+  }
+
+  holder.reset(new NDArray('c', output.getShapeAsVector(), sd::DataType::INT64, output.getContext()));
+  return holder->bufferAsT<sd::LongType>();
+}
+
+static void flushIndices(NDArray& output, std::unique_ptr<NDArray>& holder) {
+  if (holder != nullptr) {
+    holder->tickWriteHost();
+    output.assign(*holder);
+  } else {
+    output.tickWriteHost();
+  }
+}
+
+// exclusive prefix sum in place: counts[e + 1] holds the count of item e, counts[0] is 0
+static void prefixSum(std::vector<sd::LongType>& counts) {
+  for (size_t e = 1; e < counts.size(); e++) counts[e] += counts[e - 1];
+}
+
+//////////////////////////////////////////////////////////////////////////
+// lowercase
+
+// two-byte symbols lowercased without changing their encoded length
+static SD_INLINE uint32_t lowerTwoBytes(uint32_t cp) {
+  if ((cp >= 0xc0 && cp <= 0xde && cp != 0xd7) || (cp >= 0x391 && cp <= 0x3a9 && cp != 0x3a2) ||
+      (cp >= 0x410 && cp <= 0x42f))
+    return cp + 0x20;
+
+  if (cp >= 0x400 && cp <= 0x40f) return cp + 0x50;
+
+  if (cp == 0x178) return 0xff;
+
+  // latin extended-a keeps capital and small letters in pairs, U+0130 lowercases to a single byte symbol
+  if (((cp >= 0x100 && cp <= 0x137) || (cp >= 0x14a && cp <= 0x177)) && cp != 0x130 && (cp & 1) == 0) return cp + 1;
+
+  if (((cp >= 0x139 && cp <= 0x148) || (cp >= 0x179 && cp <= 0x17e)) && (cp & 1) == 1) return cp + 1;
+
+  return cp;
+}
+
+static void lowerUtf8(const char* input, sd::LongType length, char* output) {
+  sd::LongType i = 0;
+  while (i < length) {
+    // ascii runs are lowercased 8 bytes per step
+    if (length - i >= 8) {
+      uint64_t word;
+      std::memcpy(&word, input + i, sizeof(uint64_t));
+      if ((word & ASCII_HIGH_BITS) == 0) {
+        auto aboveA = word + ASCII_ONES * (0x80 - 'A');
+        auto aboveZ = word + ASCII_ONES * (0x80 - 'Z' - 1);
+        word |= ((aboveA & ~aboveZ) & ASCII_HIGH_BITS) >> 2;
+        std::memcpy(output + i, &word, sizeof(uint64_t));
+        i += 8;
+        continue;
+      }
+    }
+
+    auto lead = static_cast<uint8_t>(input[i]);
+    if (lead < 0x80) {
+      output[i++] = (lead >= 'A' && lead <= 'Z') ? static_cast<char>(lead + 0x20) : static_cast<char>(lead);
+    } else if ((lead >> 5) == 0x6 && i + 1 < length && (static_cast<uint8_t>(input[i + 1]) >> 6) == 0x2) {
+      auto cp = lowerTwoBytes(((lead & 0x1fu) << 6) | (static_cast<uint8_t>(input[i + 1]) & 0x3fu));
+      output[i] = static_cast<char>(0xc0 | (cp >> 6));
+      output[i + 1] = static_cast<char>(0x80 | (cp & 0x3f));
+      i += 2;
+    } else {
+      output[i] = input[i];
+      i++;
+    }
+  }
+}
+
+void stringsLower(sd::LaunchContext* context, const NDArray& input, NDArray& output) {
+  if (output.isEmpty()) return;
+
+  Utf8Strings strings(input);
+  auto result = allocateStrings(output, strings.offsets[strings.length]);
+  std::memcpy(result.offsets, strings.offsets, strings.length * sizeof(sd::LongType));
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) lowerUtf8(strings.at(e), strings.size(e), result.data + strings.offsets[e]);
+  };
+
+  samediff::Threads::parallel_for(func, 0, strings.length);
+
+  finishStrings(output);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// tokenizer
+
+static SD_INLINE bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+static SD_INLINE bool isPunctuation(char c) {
+  return (c >= '!' && c <= '/') || (c >= ':' && c <= '@') || (c >= '[' && c <= '`') || (c >= '{' && c <= '~');
+}
+
+// calls f(begin, length) for every token, bytes of multi-byte symbols are never separators
+template <typename F>
+static void forEachToken(const char* string, sd::LongType length, bool punctuation, F&& f) {
+  sd::LongType i = 0;
+  while (i < length) {
+    if (isSpace(string[i])) {
+      i++;
+    } else if (punctuation && isPunctuation(string[i])) {
+      f(string + i, 1);
+      i++;
+    } else {
+      auto begin = i;
+      while (i < length && !isSpace(string[i]) && !(punctuation && isPunctuation(string[i]))) i++;
+      f(string + begin, i - begin);
+    }
+  }
+}
+
+// tokens (and their bytes) of every string, as counts for prefixSum
+static void countTokens(const Utf8Strings& strings, bool punctuation, std::vector<sd::LongType>& tokens,
+                        std::vector<sd::LongType>* bytes) {
+  tokens.assign(strings.length + 1, 0);
+  if (bytes != nullptr) bytes->assign(strings.length + 1, 0);
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      sd::LongType numTokens = 0, numBytes = 0;
+      forEachToken(strings.at(e), strings.size(e), punctuation, [&](const char*, sd::LongType length) {
+        numTokens++;
+        numBytes += length;
+      });
+
+      tokens[e + 1] = numTokens;
+      if (bytes != nullptr) (*bytes)[e + 1] = numBytes;
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, strings.length);
+}
+
+sd::LongType stringsCountTokens(const NDArray& input, int mode) {
+  Utf8Strings strings(input);
+  std::vector<sd::LongType> tokens;
+  countTokens(strings, mode == TOKENIZE_PUNCTUATION, tokens, nullptr);
+
+  prefixSum(tokens);
+  return tokens.back();
+}
+
+void stringsTokenize(sd::LaunchContext* context, const NDArray& input, int mode, NDArray& values,
+                     NDArray& rowSplits) {
+  Utf8Strings strings(input);
+  bool punctuation = mode == TOKENIZE_PUNCTUATION;
+
+  std::vector<sd::LongType> tokens, bytes;
+  countTokens(strings, punctuation, tokens, &bytes);
+  prefixSum(tokens);
+  prefixSum(bytes);
+
+  if (values.lengthOf() != tokens.back())
+    throw std::invalid_argument("stringsTokenize: values length doesn't match number of tokens");
+
+  std::unique_ptr<NDArray> splitsHolder;
+  auto splits = indicesOutput(rowSplits, splitsHolder);
+  std::memcpy(splits, tokens.data(), tokens.size() * sizeof(sd::LongType));
+  flushIndices(rowSplits, splitsHolder);
+
+  if (values.isEmpty()) return;
+
+  auto result = allocateStrings(values, bytes.back());
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      auto token = tokens[e];
+      auto offset = bytes[e];
+      forEachToken(strings.at(e), strings.size(e), punctuation, [&](const char* begin, sd::LongType length) {
+        result.offsets[token++] = offset;
+        std::memcpy(result.data + offset, begin, length);
+        offset += length;
+      });
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, strings.length);
+
+  finishStrings(values);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// hashing
+
+static SD_INLINE sd::LongType hashBucket(sd::LongType hash, sd::LongType numBuckets) {
+  return static_cast<sd::LongType>(static_cast<uint64_t>(hash) % static_cast<uint64_t>(numBuckets));
+}
+
+// row splits over numTokens tokens, a single row if there are none
+static std::vector<sd::LongType> readSplits(const NDArray* rowSplits, sd::LongType numTokens) {
+  if (rowSplits == nullptr) return {0, numTokens};
+
+  std::vector<sd::LongType> splits(rowSplits->lengthOf());
+  for (sd::LongType e = 0; e < rowSplits->lengthOf(); e++) splits[e] = rowSplits->e<sd::LongType>(e);
+
+  if (splits.empty() || splits.front() != 0 || splits.back() != numTokens)
+    throw std::invalid_argument("row splits have to start with 0 and end with the number of tokens");
+
+  for (size_t e = 1; e < splits.size(); e++)
+    if (splits[e] < splits[e - 1]) throw std::invalid_argument("row splits have to be non-decreasing");
+
+  return splits;
+}
+
+static SD_INLINE sd::LongType ngramsInRow(const std::vector<sd::LongType>& splits, size_t row, int width) {
+  auto tokens = splits[row + 1] - splits[row];
+  return tokens >= width ? tokens - width + 1 : 0;
+}
+
+sd::LongType stringsCountNgrams(const NDArray& tokens, const NDArray* rowSplits, int width) {
+  auto splits = readSplits(rowSplits, tokens.lengthOf());
+
+  sd::LongType count = 0;
+  for (size_t r = 0; r + 1 < splits.size(); r++) count += ngramsInRow(splits, r, width);
+
+  return count;
+}
+
+void stringsNgramHash(sd::LaunchContext* context, const NDArray& tokens, const NDArray* rowSplits, int width,
+                      sd::LongType numBuckets, NDArray& hashes, NDArray& outputSplits) {
+  if (width < 1 || numBuckets < 1)
+    throw std::invalid_argument("stringsNgramHash: width and number of buckets have to be positive");
+
+  Utf8Strings strings(tokens);
+  auto splits = readSplits(rowSplits, strings.length);
+  auto numRows = splits.size() - 1;
+
+  std::vector<sd::LongType> ngrams(numRows + 1, 0);
+  for (size_t r = 0; r < numRows; r++) ngrams[r + 1] = ngramsInRow(splits, r, width);
+  prefixSum(ngrams);
+
+  if (hashes.lengthOf() != ngrams.back())
+    throw std::invalid_argument("stringsNgramHash: output length doesn't match number of n-grams");
+
+  std::unique_ptr<NDArray> splitsHolder, hashesHolder;
+  auto outSplits = indicesOutput(outputSplits, splitsHolder);
+  std::memcpy(outSplits, ngrams.data(), ngrams.size() * sizeof(sd::LongType));
+  flushIndices(outputSplits, splitsHolder);
+
+  if (hashes.isEmpty()) return;
+
+  auto out = indicesOutput(hashes, hashesHolder);
+  auto& hasher = HashHelper::getInstance();
+  const char separator = ' ';
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto r = start; r < stop; r++) {
+      for (sd::LongType g = 0; g < ngrams[r + 1] - ngrams[r]; g++) {
+        auto first = splits[r] + g;
+        auto hash = hasher.updateLongHash(hasher.initialLongHash(), strings.at(first), strings.size(first));
+        for (int t = 1; t < width; t++) {
+          hash = hasher.updateLongHash(hash, &separator, 1);
+          hash = hasher.updateLongHash(hash, strings.at(first + t), strings.size(first + t));
+        }
+
+        out[ngrams[r] + g] = hashBucket(hash, numBuckets);
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, numRows);
+
+  flushIndices(hashes, hashesHolder);
+}
+
+void stringsToHashBucket(sd::LaunchContext* context, const NDArray& input, sd::LongType numBuckets, NDArray& output) {
+  if (numBuckets < 1) throw std::invalid_argument("stringsToHashBucket: number of buckets has to be positive");
+
+  Utf8Strings strings(input);
+  std::unique_ptr<NDArray> holder;
+  auto out = indicesOutput(output, holder);
+  auto& hasher = HashHelper::getInstance();
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++)
+      out[e] = hashBucket(hasher.getLongHash(strings.at(e), strings.size(e)), numBuckets);
+  };
+
+  samediff::Threads::parallel_for(func, 0, strings.length);
+
+  flushIndices(output, holder);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// join and substr
+
+void stringsJoin(sd::LaunchContext* context, const NDArray& input, const std::string& separator, NDArray& output) {
+  if (output.isEmpty()) return;
+
+  Utf8Strings strings(input);
+  auto width = input.rankOf() > 0 ? input.sizeAt(-1) : 1;
+  auto rows = output.lengthOf();
+  if (rows * width != strings.length)
+    throw std::invalid_argument("stringsJoin: output length doesn't match input shape");
+
+  // every row adds width - 1 separators, so the offsets follow from the input ones directly
+  auto separators = static_cast<sd::LongType>(separator.size()) * (width > 0 ? width - 1 : 0);
+  auto result = allocateStrings(output, strings.offsets[strings.length] + rows * separators);
+
+  auto func = PRAGMA_THREADS_FOR {
+    for (auto r = start; r < stop; r++) {
+      auto offset = strings.offsets[r * width] + r * separators;
+      result.offsets[r] = offset;
+      for (sd::LongType e = 0; e < width; e++) {
+        if (e > 0) {
+          std::memcpy(result.data + offset, separator.data(), separator.size());
+          offset += separator.size();
+        }
+
+        auto index = r * width + e;
+        std::memcpy(result.data + offset, strings.at(index), strings.size(index));
+        offset += strings.size(index);
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(func, 0, rows);
+
+  finishStrings(output);
+}
+
+static SD_INLINE bool isTrailByte(char c) { return (static_cast<uint8_t>(c) >> 6) == 0x2; }
+
+static sd::LongType countSymbols(const char* string, sd::LongType length) {
+  sd::LongType count = 0;
+  for (sd::LongType e = 0; e < length; e++)
+    if (!isTrailByte(string[e])) count++;
+
+  return count;
+}
+
+// byte position after skipping the given number of symbols from byte position
+static sd::LongType skipSymbols(const char* string, sd::LongType length, sd::LongType position, sd::LongType symbols) {
+  for (; symbols > 0 && position < length; symbols--) {
+    position++;
+    while (position < length && isTrailByte(string[position])) position++;
+  }
+
+  return position;
+}
+
+void stringsSubstr(sd::LaunchContext* context, const NDArray& input, sd::LongType pos, sd::LongType len, bool chars,
+                   NDArray& output) {
+  if (output.isEmpty()) return;
+
+  Utf8Strings strings(input);
+
+  // first byte and byte length of every substring, lengths as counts for prefixSum
+  std::vector<sd::LongType> begins(strings.length), lengths(strings.length + 1, 0);
+
+  auto measure = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++) {
+      auto string = strings.at(e);
+      auto size = strings.size(e);
+      auto units = chars ? countSymbols(string, size) : size;
+
+      auto first = pos < 0 ? sd::math::sd_max<sd::LongType>(0, units + pos) : sd::math::sd_min<sd::LongType>(pos, units);
+      auto count = len < 0 ? units - first : sd::math::sd_min<sd::LongType>(len, units - first);
+
+      if (chars) {
+        begins[e] = skipSymbols(string, size, 0, first);
+        lengths[e + 1] = skipSymbols(string, size, begins[e], count) - begins[e];
+      } else {
+        begins[e] = first;
+        lengths[e + 1] = count;
+      }
+    }
+  };
+
+  samediff::Threads::parallel_for(measure, 0, strings.length);
+  prefixSum(lengths);
+
+  auto result = allocateStrings(output, lengths.back());
+  std::memcpy(result.offsets, lengths.data(), strings.length * sizeof(sd::LongType));
+
+  auto copy = PRAGMA_THREADS_FOR {
+    for (auto e = start; e < stop; e++)
+      std::memcpy(result.data + lengths[e], strings.at(e) + begins[e], lengths[e + 1] - lengths[e]);
+  };
+
+  samediff::Threads::parallel_for(copy, 0, strings.length);
+
+  finishStrings(output);
+}
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
@@ -0,0 +1,45 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Fused layer normalization: y = gain * (x - mean) / (stdev + 1e-12) + bias, moments taken over axes,
+// gain and bias broadcast along dimension dimC
+//
+#ifndef LIBND4J_HELPERS_LAYER_NORM_H
+#define LIBND4J_HELPERS_LAYER_NORM_H
+#include <array/NDArray.h>
+#include <system/op_boilerplate.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// bias may be nullptr
+SD_LIB_HIDDEN void layerNorm(sd::LaunchContext* context, const NDArray& input, const NDArray& gain, const NDArray* bias,
+                             NDArray& output, const std::vector<int>& axes, const int dimC);
+
+// computes dLdx and, for the caller to reduce into dLdg, dLdgTerms = standardized(input) * gradO
+SD_LIB_HIDDEN void layerNormBp(sd::LaunchContext* context, const NDArray& input, const NDArray& gain,
+                               const NDArray& gradO, NDArray& dLdx, NDArray& dLdgTerms, const std::vector<int>& axes,
+                               const int dimC);
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_LAYER_NORM_H
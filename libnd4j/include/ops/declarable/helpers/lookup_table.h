@@ -0,0 +1,75 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Read-optimized hash tables for vocabulary lookups. A table is kept as plain arrays, so it's saved and
+// loaded with the graph like any other variable:
+//   keys   [n]          - integer or utf8 keys
+//   values [n, ...]     - value (row) of every key
+//   table  [capacity, 2] - open addressing index with linear probing, slot s holds the 64-bit hash of its key
+//                         and the key position, or -1 if it's empty. Capacity is a power of two and the
+//                         load factor is at most 1/2, so probes are short and stay within a cache line or two
+// Lookups only read the index, insertion claims slots with compare-and-swap, so both run in parallel
+// without locks. Repeated keys resolve to the last occurrence.
+//
+#ifndef LIBND4J_HELPERS_LOOKUP_TABLE_H
+#define LIBND4J_HELPERS_LOOKUP_TABLE_H
+#include <array/NDArray.h>
+#include <system/op_boilerplate.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// index capacity for the given number of keys
+SD_LIB_HIDDEN sd::LongType hashTableCapacity(sd::LongType numKeys);
+
+/**
+ * checks the index and keys of a table, returns an empty string if they are valid, or what is wrong otherwise
+ */
+SD_LIB_HIDDEN std::string hashTableValidate(const NDArray& table, const NDArray& keys);
+
+// builds the index of keys, its capacity is defined by the table shape
+SD_LIB_HIDDEN void hashTableBuild(sd::LaunchContext* context, const NDArray& keys, NDArray& table);
+
+/**
+ * values of queries, output has shape of queries followed by the row shape of values. Queries which aren't in
+ * the table get defaultValue (scalar or row, zero if it's null), or, if numOovBuckets is positive, are hashed
+ * into one of numOovBuckets ids following the ones of the table (integer vector values only)
+ */
+SD_LIB_HIDDEN void hashTableLookup(sd::LaunchContext* context, const NDArray& table, const NDArray& keys,
+                                   const NDArray& values, const NDArray& queries, const NDArray* defaultValue,
+                                   sd::LongType numOovBuckets, NDArray& output);
+
+// number of distinct keys of newKeys which aren't in the table yet
+SD_LIB_HIDDEN sd::LongType hashTableCountMissing(const NDArray& table, const NDArray& keys, const NDArray& newKeys);
+
+/**
+ * inserts newKeys with newValues: values of keys present already are replaced, missing keys are appended in the
+ * order of their last occurrence. The index is updated in place when outputTable has the same capacity as table,
+ * and is rebuilt otherwise
+ */
+SD_LIB_HIDDEN void hashTableInsert(sd::LaunchContext* context, const NDArray& table, const NDArray& keys,
+                                   const NDArray& values, const NDArray& newKeys, const NDArray& newValues,
+                                   NDArray& outputTable, NDArray& outputKeys, NDArray& outputValues);
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_LOOKUP_TABLE_H
@@ -0,0 +1,91 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Compressed sparse row matrices, kept as three dense arrays:
+//   rowPointers [rows + 1] - entries of row r are rowPointers[r] ... rowPointers[r + 1] - 1
+//   columns     [nnz]      - column of every entry
+//   values      [nnz]      - value of every entry
+// The conversions order the entries of a row by column, repeated (row, column) pairs are summed
+// when the matrix is densified.
+//
+#ifndef LIBND4J_HELPERS_SPARSE_H
+#define LIBND4J_HELPERS_SPARSE_H
+#include <array/NDArray.h>
+#include <system/op_boilerplate.h>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+struct CsrMatrix {
+  const NDArray* rowPointers = nullptr;
+  const NDArray* columns = nullptr;
+  const NDArray* values = nullptr;
+  sd::LongType rows = 0;
+  sd::LongType cols = 0;
+
+  CsrMatrix() = default;
+  CsrMatrix(const NDArray* rowPointers, const NDArray* columns, const NDArray* values, sd::LongType cols)
+      : rowPointers(rowPointers), columns(columns), values(values), rows(rowPointers->lengthOf() - 1), cols(cols) {}
+
+  sd::LongType nnz() const { return values->lengthOf(); }
+};
+
+/**
+ * checks the structure of the matrix, returns an empty string if it's valid, or what is wrong otherwise
+ */
+SD_LIB_HIDDEN std::string csrValidate(const CsrMatrix& matrix);
+
+// number of non-zero elements of a matrix
+SD_LIB_HIDDEN sd::LongType csrCountNonZeros(const NDArray& dense);
+
+SD_LIB_HIDDEN void denseToCsr(sd::LaunchContext* context, const NDArray& dense, NDArray& rowPointers,
+                              NDArray& columns, NDArray& values);
+
+SD_LIB_HIDDEN void csrToDense(sd::LaunchContext* context, const CsrMatrix& matrix, NDArray& dense);
+
+/**
+ * builds CSR from COO entries, indices [nnz, 2] holds (row, column) pairs in any order
+ */
+SD_LIB_HIDDEN void cooToCsr(sd::LaunchContext* context, const NDArray& indices, const NDArray& values,
+                            sd::LongType rows, NDArray& rowPointers, NDArray& columns, NDArray& csrValues);
+
+/**
+ * output = matrix x dense, dense is [cols, k] or a vector of length cols, output is [rows, k] or [rows]
+ */
+SD_LIB_HIDDEN void csrMatmul(sd::LaunchContext* context, const CsrMatrix& matrix, const NDArray& dense,
+                             NDArray& output);
+
+/**
+ * values of matrix * dense, dense is [rows, cols]: the result keeps the sparsity of the matrix
+ */
+SD_LIB_HIDDEN void csrMultiplyDense(sd::LaunchContext* context, const CsrMatrix& matrix, const NDArray& dense,
+                                    NDArray& outputValues);
+
+/**
+ * output = matrix + dense, dense is [rows, cols]
+ */
+SD_LIB_HIDDEN void csrAddDense(sd::LaunchContext* context, const CsrMatrix& matrix, const NDArray& dense,
+                               NDArray& output);
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_SPARSE_H
@@ -0,0 +1,121 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Batched kernels for utf8 string arrays. They work directly on the offsets layout: the buffer starts
+// with length + 1 offsets, string i occupies data[offsets[i]] ... data[offsets[i + 1]] - 1. Outputs are
+// built in two passes - per-string sizes first, then a prefix sum gives the offsets and the strings are
+// written in place - so no memory is allocated per string. Strings are processed in parallel.
+//
+#ifndef LIBND4J_HELPERS_STRINGS_H
+#define LIBND4J_HELPERS_STRINGS_H
+#include <array/NDArray.h>
+#include <helpers/ShapeUtils.h>
+#include <system/op_boilerplate.h>
+
+#include <stdexcept>
+
+namespace sd {
+namespace ops {
+namespace helpers {
+
+// read-only view of a utf8 array
+struct Utf8Strings {
+  const sd::LongType* offsets;
+  const char* data;
+  sd::LongType length;
+
+  explicit Utf8Strings(const NDArray& array) {
+    if (array.dataType() != sd::DataType::UTF8)
+      throw std::invalid_argument("strings helpers: only UTF8 arrays are supported");
+
+    array.syncToHost();
+    length = array.lengthOf();
+    offsets = array.bufferAsT<sd::LongType>();
+    data = reinterpret_cast<const char*>(array.bufferAsT<int8_t>()) +
+           ShapeUtils::stringBufferHeaderRequirements(length);
+  }
+
+  const char* at(sd::LongType e) const { return data + offsets[e]; }
+  sd::LongType size(sd::LongType e) const { return offsets[e + 1] - offsets[e]; }
+};
+
+struct Utf8Output {
+  sd::LongType* offsets;
+  char* data;
+};
+
+/**
+ * allocates the header and dataLength bytes of data for the strings of output, the last offset is set already.
+ * Once the strings are written, output has to be passed to finishStrings
+ */
+SD_LIB_HIDDEN Utf8Output allocateStrings(NDArray& output, sd::LongType dataLength);
+
+SD_LIB_HIDDEN void finishStrings(NDArray& output);
+
+// tokenizer modes
+constexpr int TOKENIZE_WHITESPACE = 0;
+// whitespace separates tokens, every ascii punctuation symbol is a token of its own
+constexpr int TOKENIZE_PUNCTUATION = 1;
+
+/**
+ * lowercase copy of utf8 strings: ascii, latin-1, latin extended-a, greek and cyrillic capitals are
+ * mapped, any other symbol is kept as is. Offsets of the output match the input ones
+ */
+SD_LIB_HIDDEN void stringsLower(sd::LaunchContext* context, const NDArray& input, NDArray& output);
+
+// total number of tokens in all strings of the input
+SD_LIB_HIDDEN sd::LongType stringsCountTokens(const NDArray& input, int mode);
+
+/**
+ * splits every string into tokens, values gets all tokens, tokens of string i are
+ * values[rowSplits[i]] ... values[rowSplits[i + 1] - 1]
+ */
+SD_LIB_HIDDEN void stringsTokenize(sd::LaunchContext* context, const NDArray& input, int mode, NDArray& values,
+                                   NDArray& rowSplits);
+
+// total number of n-grams of the given width, rowSplits is optional
+SD_LIB_HIDDEN sd::LongType stringsCountNgrams(const NDArray& tokens, const NDArray* rowSplits, int width);
+
+/**
+ * hashes n-grams of consecutive tokens within every row into numBuckets buckets. N-gram is hashed as its
+ * tokens joined with single spaces, without a row splits all tokens are one row
+ */
+SD_LIB_HIDDEN void stringsNgramHash(sd::LaunchContext* context, const NDArray& tokens, const NDArray* rowSplits,
+                                    int width, sd::LongType numBuckets, NDArray& hashes, NDArray& outputSplits);
+
+// bucket of the 64-bit hash of every string
+SD_LIB_HIDDEN void stringsToHashBucket(sd::LaunchContext* context, const NDArray& input, sd::LongType numBuckets,
+                                       NDArray& output);
+
+// joins strings along the last dimension, the output has the shape of input without the last dimension
+SD_LIB_HIDDEN void stringsJoin(sd::LaunchContext* context, const NDArray& input, const std::string& separator,
+                               NDArray& output);
+
+/**
+ * substrings of length len (negative means till the end) starting at pos, negative pos counts from the end.
+ * Both are clamped to the string bounds. Positions are counted in bytes, or in symbols if chars is true
+ */
+SD_LIB_HIDDEN void stringsSubstr(sd::LaunchContext* context, const NDArray& input, sd::LongType pos, sd::LongType len,
+                                 bool chars, NDArray& output);
+
+}  // namespace helpers
+}  // namespace ops
+}  // namespace sd
+#endif  // LIBND4J_HELPERS_STRINGS_H
@@ -62,6 +62,59 @@ SD_LIB_HIDDEN void updaterAdaBelief(sd::LaunchContext* context, const NDArray& g
                                     const NDArray& initStateM, NDArray& update, NDArray& stateU, NDArray& stateM,
                                     const double dLr, const double dBeta1, const double dBeta2, const double dEpsilon,
                                     const int nIteration);
+
+// updaters available to the multi-tensor updater, with 0, 1, 1, 2, 2 and 3 state arrays per tensor
+enum MultiTensorUpdaterType {
+  MULTI_SGD = 0,
+  MULTI_NESTEROVS = 1,
+  MULTI_RMS_PROP = 2,
+  MULTI_ADAM = 3,
+  MULTI_NADAM = 4,
+  MULTI_AMS_GRAD = 5,
+};
+
+struct MultiTensorUpdaterConfig {
+  double lr = 0.;
+  // momentum for nesterovs, decay for rms prop
+  double beta1 = 0.;
+  double beta2 = 0.;
+  double epsilon = 0.;
+  // decoupled weight decay: param -= update + lr * weightDecay * param
+  double weightDecay = 0.;
+  // gradients are scaled so that their global norm doesn't exceed it, 0 disables clipping
+  double maxGlobalNorm = 0.;
+  int iteration = 0;
+};
+
+SD_INLINE int multiTensorUpdaterStates(const int type) {
+  switch (type) {
+    case MULTI_SGD:
+      return 0;
+    case MULTI_NESTEROVS:
+    case MULTI_RMS_PROP:
+      return 1;
+    case MULTI_ADAM:
+    case MULTI_NADAM:
+      return 2;
+    case MULTI_AMS_GRAD:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+/**
+ * updates all params in one pass: gradients are clipped by their global norm, and then the update and
+ * weight decay are applied to the params directly. States are given state-major: states[s * n + t] is
+ * the state s of tensor t, in the order of the single tensor updater. Outputs may be the inputs.
+ */
+SD_LIB_HIDDEN void updaterMultiTensor(sd::LaunchContext* context, const int type,
+                                      const std::vector<const NDArray*>& params,
+                                      const std::vector<const NDArray*>& gradients,
+                                      const std::vector<const NDArray*>& initStates,
+                                      const std::vector<NDArray*>& updatedParams,
+                                      const std::vector<NDArray*>& updatedStates,
+                                      const MultiTensorUpdaterConfig& config);
 }  // namespace helpers
 }  // namespace ops
 }  // namespace sd
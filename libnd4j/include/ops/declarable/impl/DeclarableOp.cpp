@@ -27,6 +27,7 @@
 #include <helpers/StringUtils.h>
 #include <ops/declarable/DeclarableOp.h>
 #include <ops/declarable/OpRegistrator.h>
+#include <system/Tracer.h>
 
 #include <cstdarg>
 #if defined(HAVE_VEDA)
@@ -264,7 +265,11 @@ int sd::ops::DeclarableOp::prepareOutputs(Context &ctx) {
       shapeStart = std::chrono::system_clock::now();
     }
 
-    auto outSha = this->calculateOutputShape(&inSha, ctx);
+    ShapeList *outSha;
+    {
+      TraceScope trace(TraceEventType::SHAPE_FUNCTION, this->getOpName()->c_str());
+      outSha = this->calculateOutputShape(&inSha, ctx);
+    }
     results = outSha->size();
 
     // optionally saving shapeTime
@@ -616,8 +621,37 @@ sd::Status sd::ops::DeclarableOp::validateDataTypes(Context &block) {
   return sd::Status::OK;
 }
 
+void sd::ops::DeclarableOp::applyFusedActivation(Context &block) {
+  auto z = getZ(block, 0);
+  if (z == nullptr || z->isEmpty()) return;
+
+  const auto alpha = block.fusedActivationAlpha();
+  switch (block.fusedActivation()) {
+    case FUSED_RELU:
+      z->applyScalar(sd::scalar::RELU, alpha, *z);
+      break;
+    case FUSED_RELU6:
+      z->applyScalar(sd::scalar::RELU6, alpha, *z);
+      break;
+    case FUSED_LRELU:
+      z->applyScalar(sd::scalar::LeakyRELU, alpha, *z);
+      break;
+    case FUSED_SIGMOID:
+      z->applyTransform(sd::transform::Sigmoid, *z);
+      break;
+    case FUSED_TANH:
+      z->applyTransform(sd::transform::Tanh, *z);
+      break;
+    default:
+      break;
+  }
+
+  block.markFusedActivationApplied(true);
+}
+
 sd::Status sd::ops::DeclarableOp::execute(Context *block) {
   sd_debug("Executing op: [%s]\n", this->getOpName()->c_str());
+  TraceScope trace(TraceEventType::OP, this->getOpName()->c_str());
 
   std::chrono::time_point<std::chrono::system_clock> timeEnter, timeStart, timeEnd;
   sd::LongType prepTime, outerTime;
@@ -645,6 +679,9 @@ sd::Status sd::ops::DeclarableOp::execute(Context *block) {
   sd::Status status;
   bool hasHelper = false;
 
+  // kernels supporting fused activation will mark it as applied
+  block->markFusedActivationApplied(false);
+
   // platform helpers use might be forbidden for various reasons, so we'll check it out first
   if (block->helpersAllowed() && sd::Environment::getInstance().helpersAllowed()) {
     // if we have platform-specific helper for this op - invoke it
@@ -734,6 +771,11 @@ sd::Status sd::ops::DeclarableOp::execute(Context *block) {
 #else
   if (!hasHelper) status = this->validateAndExecute(*block);
 #endif
+
+  // activation folded into this op, but not applied by the kernel itself
+  if (status == sd::Status::OK && block->fusedActivation() != FUSED_NONE && !block->isFusedActivationApplied())
+    applyFusedActivation(*block);
+
   // optionally saving execution time
   if (Environment::getInstance().isProfiling()) {
     timeEnd = std::chrono::system_clock::now();
@@ -31,15 +31,23 @@
 
 namespace sd {
 
+template <typename S, typename T>
+struct SpecialConvertKernel {
+  static SD_INLINE void run(const S *x, T *z, const sd::LongType start, const sd::LongType stop) {
+    for (auto i = start; i < stop; i++) {
+      z[i] = static_cast<T>(x[i]);
+    }
+  }
+};
+
 template <typename S, typename T>
 void SpecialTypeConverter::convertGeneric(sd::Pointer *extras, void *dx, sd::LongType N, void *dz) {
   auto x = reinterpret_cast<S *>(dx);
   auto z = reinterpret_cast<T *>(dz);
 
   auto func = PRAGMA_THREADS_FOR {
-    for (auto i = start; i < stop; i++) {
-      z[i] = static_cast<T>(x[i]);
-    }
+    isaDispatch<SpecialConvertKernel<S, T>>(static_cast<const S *>(x), z, static_cast<sd::LongType>(start),
+                                            static_cast<sd::LongType>(stop));
   };
 
   samediff::Threads::parallel_for(func, 0, N);
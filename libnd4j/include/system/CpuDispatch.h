@@ -0,0 +1,131 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Runtime CPU dispatch.
+//
+// With SD_CPU_DISPATCH the library is built for the baseline ISA of the architecture, and selected hot
+// kernels are additionally compiled for AVX2 and AVX-512 (SVE on aarch64). The variant is picked on every
+// call from the ISA detected at startup, so a single binary runs at full speed on every host.
+//
+// A kernel is a struct with a single static SD_INLINE `run` method. Its body must not contain lambdas or
+// threading calls: the ISA of a variant is propagated by inlining `run` into the variant, and lambdas are
+// compiled separately. Call it as isaDispatch<Kernel>(args...); without SD_CPU_DISPATCH this is a plain
+// inlined call.
+//
+#ifndef SD_SYSTEM_CPUDISPATCH_H
+#define SD_SYSTEM_CPUDISPATCH_H
+#include <system/common.h>
+
+#include <atomic>
+
+#if defined(SD_CPU_DISPATCH) && !defined(__CUDACC__) && (defined(__GNUC__) || defined(__clang__))
+#if defined(__x86_64__) || defined(_M_X64)
+#define SD_DISPATCH_X86 1
+#define SD_TARGET_AVX2 __attribute__((target("avx,avx2,fma,f16c")))
+#define SD_TARGET_AVX512 __attribute__((target("avx,avx2,fma,f16c,avx512f,avx512vl,avx512bw,avx512dq,avx512cd")))
+#elif defined(__aarch64__) && !defined(__clang__) && __GNUC__ >= 10
+#define SD_DISPATCH_SVE 1
+#define SD_TARGET_SVE __attribute__((target("+sve")))
+#endif
+#endif
+
+namespace sd {
+
+enum class CpuIsa : int {
+  GENERIC = 0,
+  AVX2 = 1,
+  AVX512 = 2,
+  NEON = 3,
+  SVE = 4,
+};
+
+class SD_LIB_EXPORT CpuDispatch {
+ private:
+  CpuIsa _detected = CpuIsa::GENERIC;
+  std::atomic<CpuIsa> _active;
+
+  CpuDispatch();
+
+ public:
+  static CpuDispatch& getInstance();
+
+  /**
+   * best ISA supported by this host
+   */
+  CpuIsa detected() const { return _detected; }
+
+  /**
+   * ISA used to select kernel variants: the detected one, unless lowered by SD_CPU_ISA or setIsa()
+   */
+  CpuIsa isa() const { return _active.load(std::memory_order_relaxed); }
+
+  /**
+   * selects the ISA for subsequent kernel calls, throws std::invalid_argument if this host doesn't support it
+   */
+  void setIsa(CpuIsa isa);
+
+  bool supports(CpuIsa isa) const;
+
+  /**
+   * true if this binary carries ISA-specific kernel variants
+   */
+  static bool isMultiVersioned();
+
+  static const char* isaName(CpuIsa isa);
+};
+
+template <typename Kernel, typename R, typename... Args>
+struct IsaVariants {
+  static R generic(Args... args) { return Kernel::run(args...); }
+#ifdef SD_DISPATCH_X86
+  SD_TARGET_AVX2 static R avx2(Args... args) { return Kernel::run(args...); }
+  SD_TARGET_AVX512 static R avx512(Args... args) { return Kernel::run(args...); }
+#endif
+#ifdef SD_DISPATCH_SVE
+  SD_TARGET_SVE static R sve(Args... args) { return Kernel::run(args...); }
+#endif
+};
+
+template <typename Kernel, typename... Args>
+SD_INLINE auto isaDispatch(Args... args) -> decltype(Kernel::run(args...)) {
+#if defined(SD_DISPATCH_X86) || defined(SD_DISPATCH_SVE)
+  using Variants = IsaVariants<Kernel, decltype(Kernel::run(args...)), Args...>;
+  switch (CpuDispatch::getInstance().isa()) {
+#ifdef SD_DISPATCH_X86
+    case CpuIsa::AVX512:
+      return Variants::avx512(args...);
+    case CpuIsa::AVX2:
+      return Variants::avx2(args...);
+#endif
+#ifdef SD_DISPATCH_SVE
+    case CpuIsa::SVE:
+      return Variants::sve(args...);
+#endif
+    default:
+      return Variants::generic(args...);
+  }
+#else
+  return Kernel::run(args...);
+#endif
+}
+
+}  // namespace sd
+
+#endif  // SD_SYSTEM_CPUDISPATCH_H
@@ -48,6 +48,8 @@ class SD_LIB_EXPORT Environment {
   std::atomic<bool> _profile;
   std::atomic<sd::DataType> _dataType;
   std::atomic<bool> _precBoost;
+  std::atomic<bool> _pairwiseReductions{false};
+  std::atomic<bool> _blockedLayout{false};
   std::atomic<bool> _useONEDNN{true};
   std::atomic<bool> _allowHelpers{true};
 
@@ -147,6 +149,20 @@ class SD_LIB_EXPORT Environment {
   bool precisionBoostAllowed();
   void allowPrecisionBoost(bool reallyAllow);
 
+  /**
+   * when enabled, blocked reductions accumulate fixed-size blocks separately and merge the block results,
+   * which bounds rounding error growth for long sums at a small cost
+   */
+  bool pairwiseReductions();
+  void setPairwiseReductions(bool reallyPairwise);
+
+  /**
+   * when enabled, InferenceOptimizer switches chains of convolution and pooling layers to NCHWc blocked layout.
+   * disabled by default, since blocked convolution is a direct kernel and loses to im2col + GEMM on larger layers
+   */
+  bool blockedLayout();
+  void setBlockedLayout(bool reallyBlocked);
+
   bool isExperimentalBuild();
 
   bool isCPU();
@@ -0,0 +1,107 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Cost model used to size thread teams.
+//
+// Every op class has an estimated cost in ns per element for each group of data types, and a thread
+// is worth spawning only if it gets at least threadCost() ns of work. The defaults reproduce the
+// static 1024-elements-per-thread rule for elementwise ops; calibrate() replaces them with values
+// measured on this host, and a calibrated profile can be saved and loaded back by later runs.
+//
+// SD_COST_PROFILE points to a profile loaded at startup; with SD_CALIBRATE=true a missing profile is
+// measured at startup and written to that path.
+//
+#ifndef SD_SYSTEM_PARALLELCOSTMODEL_H
+#define SD_SYSTEM_PARALLELCOSTMODEL_H
+#include <array/DataType.h>
+#include <system/common.h>
+
+#include <atomic>
+#include <string>
+
+namespace sd {
+
+enum class CostClass : int {
+  ELEMENTWISE = 0,     // copies, arithmetic, comparisons: bound by memory bandwidth
+  TRANSCENDENTAL = 1,  // exp, log, tanh and similar math functions
+  REDUCTION = 2,
+};
+
+class SD_LIB_EXPORT ParallelCostModel {
+ public:
+  static const int kNumClasses = 3;
+  // float, double, 16-bit floats, integers and bool
+  static const int kNumTypeGroups = 4;
+
+ private:
+  std::atomic<double> _costs[kNumClasses][kNumTypeGroups];
+  std::atomic<double> _threadCost;
+  std::atomic<bool> _calibrated{false};
+
+  ParallelCostModel();
+
+ public:
+  static ParallelCostModel& getInstance();
+
+  /**
+   * estimated ns per element of the given op class on the given data type
+   */
+  double costPerElement(CostClass costClass, sd::DataType dataType) const;
+  void setCostPerElement(CostClass costClass, sd::DataType dataType, double nanos);
+
+  /**
+   * minimal amount of work, in ns, that justifies one more thread
+   */
+  double threadCost() const;
+  void setThreadCost(double nanos);
+
+  /**
+   * number of threads, in [1, maxThreads], for numElements elements of the given op class
+   */
+  int numberOfThreads(CostClass costClass, sd::DataType dataType, sd::LongType numElements, int maxThreads) const;
+
+  /**
+   * true once the costs were measured by calibrate() or loaded from a profile
+   */
+  bool isCalibrated() const;
+
+  /**
+   * microbenchmarks every op class on every type group, and the thread wake-up latency
+   */
+  void calibrate();
+
+  /**
+   * restores the static defaults
+   */
+  void reset();
+
+  /**
+   * writes the current costs to a text profile, throws std::runtime_error if the file can't be written
+   */
+  void save(const std::string& path) const;
+
+  /**
+   * reads a profile written by save(), returns false if the file doesn't exist or isn't a valid profile
+   */
+  bool load(const std::string& path);
+};
+
+}  // namespace sd
+
+#endif  // SD_SYSTEM_PARALLELCOSTMODEL_H
@@ -0,0 +1,197 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Always-available tracing of op execution, shape functions, allocations, workspace spills and
+// thread pool waits.
+//
+// Every thread writes fixed-size events into its own ring buffer, so recording takes no locks and
+// the oldest events are overwritten once a buffer is full. When tracing is off, the only cost at a
+// trace point is one relaxed atomic load. exportChromeTrace() merges the buffers into Chrome trace
+// JSON, readable by chrome://tracing and Perfetto.
+//
+// SD_TRACE=true enables tracing at startup, SD_TRACE_BUFFER sets the number of events kept per thread.
+//
+#ifndef SD_SYSTEM_TRACER_H
+#define SD_SYSTEM_TRACER_H
+#include <system/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#define SD_TRACE_STRINGIFY_(x) #x
+#define SD_TRACE_STRINGIFY(x) SD_TRACE_STRINGIFY_(x)
+// "file:line" of the place it's expanded at
+#define SD_TRACE_SITE __FILE__ ":" SD_TRACE_STRINGIFY(__LINE__)
+
+namespace sd {
+
+enum class TraceEventType : int {
+  OP = 0,              // op execution, with duration
+  SHAPE_FUNCTION = 1,  // output shape calculation, with duration
+  ALLOCATION = 2,      // heap allocation, value is the number of bytes
+  DEALLOCATION = 3,
+  WORKSPACE_SPILL = 4,  // workspace allocation that didn't fit, value is the number of bytes
+  POOL_WAIT = 5,        // waiting for the thread pool to finish a ticket, with duration
+};
+
+struct TraceEvent {
+  // ns since the tracer started
+  uint64_t timestamp;
+  // ns, 0 for instant events
+  uint64_t duration;
+  // must stay valid until export: op names, string literals
+  const char *name;
+  sd::LongType value;
+  TraceEventType type;
+};
+
+class SD_LIB_EXPORT TraceBuffer {
+ private:
+  std::vector<TraceEvent> _events;
+  uint64_t _mask;
+  std::atomic<uint64_t> _head{0};
+  int _threadId;
+  // set once the owning thread exits
+  bool _retired = false;
+
+ public:
+  // capacity is rounded up to a power of 2
+  TraceBuffer(int threadId, uint64_t capacity);
+
+  // called only by the owning thread
+  SD_INLINE void push(const TraceEvent &event) {
+    auto head = _head.load(std::memory_order_relaxed);
+    _events[head & _mask] = event;
+    _head.store(head + 1, std::memory_order_release);
+  }
+
+  // copies the events still held by the buffer, oldest first
+  void collect(std::vector<TraceEvent> &events) const;
+
+  int threadId() const { return _threadId; }
+
+  bool isRetired() const { return _retired; }
+  void retire() { _retired = true; }
+};
+
+class SD_LIB_EXPORT Tracer {
+ private:
+  static std::atomic<bool> _enabled;
+
+  std::chrono::steady_clock::time_point _origin;
+  // events older than this are dropped on export
+  std::atomic<uint64_t> _resetTime{0};
+  std::atomic<uint64_t> _bufferSize;
+
+  std::vector<std::unique_ptr<TraceBuffer>> _buffers;
+  int _nextThreadId = 1;
+  std::mutex _mutex;
+
+  Tracer();
+
+  TraceBuffer *threadBuffer();
+
+  // called when the owning thread exits, only the most recently retired buffers are kept for export
+  void retire(TraceBuffer *buffer);
+
+  friend struct ThreadTraceBuffer;
+
+ public:
+  static Tracer &getInstance();
+
+  static SD_INLINE bool isEnabled() { return _enabled.load(std::memory_order_relaxed); }
+  static void setEnabled(bool enabled);
+
+  /**
+   * ns since the tracer started
+   */
+  SD_INLINE uint64_t now() const {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _origin).count();
+  }
+
+  void record(TraceEventType type, const char *name, uint64_t timestamp, uint64_t duration, sd::LongType value = 0);
+
+  SD_INLINE void instant(TraceEventType type, const char *name, sd::LongType value) {
+    record(type, name, now(), 0, value);
+  }
+
+  /**
+   * number of events kept per thread, applies to threads that haven't traced anything yet
+   */
+  void setBufferSize(uint64_t numEvents);
+  uint64_t bufferSize() const;
+
+  /**
+   * number of thread buffers held: live threads that traced anything, and a few threads that exited
+   */
+  int numBuffers();
+
+  /**
+   * drops everything recorded so far
+   */
+  void reset();
+
+  /**
+   * all events recorded since the last reset, ordered by timestamp
+   */
+  std::vector<TraceEvent> events();
+
+  std::string exportChromeTrace();
+
+  /**
+   * writes exportChromeTrace() to the file, returns false if it can't be written
+   */
+  bool exportChromeTrace(const std::string &path);
+};
+
+/**
+ * records an event spanning its own lifetime, if tracing was on when it was created
+ */
+class TraceScope {
+ private:
+  const char *_name;
+  uint64_t _start;
+  TraceEventType _type;
+  bool _active;
+
+ public:
+  SD_INLINE TraceScope(TraceEventType type, const char *name) : _name(name), _start(0), _type(type) {
+    _active = Tracer::isEnabled();
+    if (_active) _start = Tracer::getInstance().now();
+  }
+
+  SD_INLINE ~TraceScope() {
+    if (_active) {
+      auto &tracer = Tracer::getInstance();
+      tracer.record(_type, _name, _start, tracer.now() - _start);
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+};
+
+}  // namespace sd
+
+#endif  // SD_SYSTEM_TRACER_H
@@ -73,6 +73,7 @@
 #include <memory/MemoryTracker.h>
 #include <stdlib.h>
 #include <string.h>
+#include <system/Tracer.h>
 #include <system/common.h>
 #include <system/type_boilerplate.h>
 
@@ -2618,7 +2619,7 @@
 #endif
 
 template <typename TT, typename WW>
-SD_INLINE TT* internal_alloc_host(WW workSpace, sd::LongType len) {
+SD_INLINE TT* internal_alloc_host(WW workSpace, sd::LongType len, const char* site = "unknown") {
   TT* var;
   if (workSpace == nullptr) {
 #if defined(SD_ALIGNED_ALLOC)
@@ -2630,6 +2631,8 @@ SD_INLINE TT* internal_alloc_host(WW workSpace, sd::LongType len) {
 #if !defined(_RELEASE)
     sd::memory::MemoryTracker::getInstance().countIn(sd::memory::MemoryType::HOST, var, len * sizeof(TT));
 #endif
+    if (sd::Tracer::isEnabled())
+      sd::Tracer::getInstance().instant(sd::TraceEventType::ALLOCATION, site, len * sizeof(TT));
   } else {
     var = reinterpret_cast<TT*>(workSpace->allocateBytes(len * sizeof(TT)));
   }
@@ -2638,8 +2641,9 @@ SD_INLINE TT* internal_alloc_host(WW workSpace, sd::LongType len) {
 }
 
 template <typename TT_PTR, typename WW>
-SD_INLINE void internal_release_host(WW workspace, TT_PTR var) {
+SD_INLINE void internal_release_host(WW workspace, TT_PTR var, const char* site = "unknown") {
   if (workspace == nullptr) {
+    if (sd::Tracer::isEnabled()) sd::Tracer::getInstance().instant(sd::TraceEventType::DEALLOCATION, site, 0);
 #if !defined(_RELEASE)
     sd::memory::MemoryTracker::getInstance().countOut(var);
 #endif
@@ -2651,8 +2655,9 @@ SD_INLINE void internal_release_host(WW workspace, TT_PTR var) {
   }
 }
 
-#define ALLOCATE(VARIABLE, WORKSPACE, LENGTH, TT) VARIABLE = internal_alloc_host<TT>(WORKSPACE, LENGTH);
-#define RELEASE(VARIABLE, WORKSPACE) internal_release_host(WORKSPACE, VARIABLE);
+#define ALLOCATE(VARIABLE, WORKSPACE, LENGTH, TT) \
+  VARIABLE = internal_alloc_host<TT>(WORKSPACE, LENGTH, SD_TRACE_SITE);
+#define RELEASE(VARIABLE, WORKSPACE) internal_release_host(WORKSPACE, VARIABLE, SD_TRACE_SITE);
 
 #define CONSTANT(SHAPE) ConstantShapeHelper::getInstance().createFromExisting(SHAPE, block.workspace())
 
@@ -21,6 +21,7 @@
 #include <system/common.h>
 
 #include <cfloat>
+#include <cstring>
 #include <iosfwd>
 #include <iostream>
 
@@ -95,32 +96,33 @@ static SD_INLINE SD_HOST_DEVICE unsigned short hneg(unsigned short h) {
 //_Pragma("omp declare simd") inline
 SD_INLINE SD_HOST_DEVICE float cpu_ihalf2float(ihalf h) { return _cvtsh_ss(h.getX()); }
 #else
+// branch-free, so that loops converting halfs element by element can be vectorized
 SD_INLINE SD_HOST_DEVICE float cpu_ihalf2float(ihalf h) {
-  unsigned sign = ((h.getX() >> 15) & 1);
-  unsigned exponent = ((h.getX() >> 10) & 0x1f);
-  unsigned mantissa = ((h.getX() & 0x3ff) << 13);
-
-  if (exponent == 0x1f) { /* NaN or Inf */
-    mantissa = (mantissa ? (sign = 0, 0x7fffff) : 0);
-    exponent = 0xff;
-  } else if (!exponent) { /* Denorm or Zero */
-    if (mantissa) {
-      unsigned int msb;
-      exponent = 0x71;
-      do {
-        msb = (mantissa & 0x400000);
-        mantissa <<= 1; /* normalize */
-        --exponent;
-      } while (!msb);
-      mantissa &= 0x7fffff; /* 1.mantissa is implicit */
-    }
-  } else {
-    exponent += 0x70;
-  }
-
-  int temp = ((sign << 31) | (exponent << 23) | mantissa);
-
-  return *((float*)((void*)&temp));
+  const unsigned x = h.getX();
+  const unsigned infExponent = 0x7c00U << 13;
+  const float denormMagic = 6.103515625e-05f;  // 2^-14
+
+  unsigned bits = (x & 0x7fffU) << 13;
+  const unsigned exponent = bits & infExponent;
+  bits += (127 - 15) << 23;
+
+  // zero and denormals are scaled back from a normal float, Inf and NaN keep the maximal exponent
+  unsigned denorm;
+  float denormValue;
+  const unsigned denormBits = bits + (1U << 23);
+  memcpy(&denormValue, &denormBits, sizeof(float));
+  denormValue -= denormMagic;
+  memcpy(&denorm, &denormValue, sizeof(float));
+
+  bits = exponent == infExponent ? bits + ((128 - 16) << 23) : (exponent == 0 ? denorm : bits);
+  bits |= (x & 0x8000U) << 16;
+
+  // NaNs are canonical
+  bits = (x & 0x7fffU) > 0x7c00U ? 0x7fffffffU : bits;
+
+  float result;
+  memcpy(&result, &bits, sizeof(float));
+  return result;
 }
 #endif
 
@@ -133,59 +135,32 @@ SD_INLINE SD_HOST_DEVICE ihalf cpu_float2ihalf_rn(float f) {
 }
 
 #else
+// branch-free round to nearest even, so that loops converting to halfs element by element can be vectorized
 SD_INLINE SD_HOST_DEVICE ihalf cpu_float2ihalf_rn(float f) {
   ihalf ret;
 
-  unsigned x = *((int*)(void*)(&f));
-  unsigned u = (x & 0x7fffffff), remainder, shift, lsb, lsb_s1, lsb_m1;
-  unsigned sign, exponent, mantissa;
+  unsigned x;
+  memcpy(&x, &f, sizeof(float));
+  const unsigned sign = x & 0x80000000U;
+  const unsigned u = x ^ sign;
 
-  // Get rid of +NaN/-NaN case first.
-  if (u > 0x7f800000) {
-    *ret.getXP() = 0x7fffU;
-    return ret;
-  }
-
-  sign = ((x >> 16) & 0x8000);
-
-  // Get rid of +Inf/-Inf, +0/-0.
-  if (u > 0x477fefff) {
-    *ret.getXP() = sign | 0x7c00U;
-    return ret;
-  }
-  if (u < 0x33000001) {
-    *ret.getXP() = (sign | 0x0000);
-    return ret;
-  }
+  // values below 2^-14 are rounded by the float adder against a magic number with a fixed exponent
+  const unsigned denormMagicBits = ((127 - 15) + (23 - 10) + 1) << 23;
+  float uValue, denormMagic;
+  memcpy(&uValue, &u, sizeof(float));
+  memcpy(&denormMagic, &denormMagicBits, sizeof(float));
+  uValue += denormMagic;
+  unsigned denorm;
+  memcpy(&denorm, &uValue, sizeof(float));
+  denorm -= denormMagicBits;
 
-  exponent = ((u >> 23) & 0xff);
-  mantissa = (u & 0x7fffff);
-
-  if (exponent > 0x70) {
-    shift = 13;
-    exponent -= 0x70;
-  } else {
-    shift = 0x7e - exponent;
-    exponent = 0;
-    mantissa |= 0x800000;
-  }
-  lsb = (1 << shift);
-  lsb_s1 = (lsb >> 1);
-  lsb_m1 = (lsb - 1);
-
-  // Round to nearest even.
-  remainder = (mantissa & lsb_m1);
-  mantissa >>= shift;
-  if (remainder > lsb_s1 || (remainder == lsb_s1 && (mantissa & 0x1))) {
-    ++mantissa;
-    if (!(mantissa & 0x3ff)) {
-      ++exponent;
-      mantissa = 0;
-    }
-  }
+  // normals: rebias the exponent and round the 13 dropped mantissa bits
+  const unsigned normal = (u + ((unsigned)(15 - 127) << 23) + 0xfffU + ((u >> 13) & 1U)) >> 13;
 
-  *ret.getXP() = (sign | (exponent << 10) | mantissa);
+  unsigned h = u >= ((127 + 16) << 23) ? 0x7c00U : (u < (113U << 23) ? denorm : normal);
+  h |= sign >> 16;
 
+  *ret.getXP() = static_cast<unsigned short>(u > 0x7f800000U ? 0x7fffU : h);
   return ret;
 }
 #endif
@@ -0,0 +1,124 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+//
+// Bulk conversions between float and the 16-bit floating point types.
+//
+// Hardware conversions are used when the translation unit is compiled for them (SD_F16C, AVX512-BF16,
+// aarch64 fp16); otherwise the loops run over the branch-free scalar conversions, which the compiler
+// vectorizes. Rounding is round-to-nearest-even everywhere, except that the AVX512-BF16 instruction
+// treats float denormals as zero.
+//
+#ifndef LIBND4J_HALF_CONVERSIONS_H
+#define LIBND4J_HALF_CONVERSIONS_H
+#include <system/openmp_pragmas.h>
+#include <types/bfloat16.h>
+#include <types/float16.h>
+
+#include <cstring>
+
+#if defined(SD_F16C) || defined(__AVX512BF16__)
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(__CUDACC__)
+#include <arm_neon.h>
+#define SD_NEON_FP16 1
+#endif
+
+namespace sd {
+
+SD_INLINE void convertToFloats(const float16* x, float* z, const sd::LongType n) {
+  sd::LongType i = 0;
+#if defined(SD_F16C)
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(z + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i))));
+#elif defined(SD_NEON_FP16)
+  for (; i + 4 <= n; i += 4)
+    vst1q_f32(z + i, vcvt_f32_f16(vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const uint16_t*>(x + i)))));
+#endif
+  PRAGMA_OMP_SIMD
+  for (auto e = i; e < n; e++) z[e] = static_cast<float>(x[e]);
+}
+
+SD_INLINE void convertFromFloats(const float* x, float16* z, const sd::LongType n) {
+  sd::LongType i = 0;
+#if defined(SD_F16C)
+  for (; i + 8 <= n; i += 8)
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(z + i),
+                     _mm256_cvtps_ph(_mm256_loadu_ps(x + i), _MM_FROUND_TO_NEAREST_INT));
+#elif defined(SD_NEON_FP16)
+  for (; i + 4 <= n; i += 4)
+    vst1_u16(reinterpret_cast<uint16_t*>(z + i), vreinterpret_u16_f16(vcvt_f16_f32(vld1q_f32(x + i))));
+#endif
+  PRAGMA_OMP_SIMD
+  for (auto e = i; e < n; e++) z[e] = x[e];
+}
+
+SD_INLINE void convertToFloats(const bfloat16* x, float* z, const sd::LongType n) {
+  // bfloat16 is the upper half of a float, widening is a shift
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < n; e++) {
+    const uint32_t bits = static_cast<uint32_t>(static_cast<uint16_t>(x[e]._data)) << 16;
+    std::memcpy(z + e, &bits, sizeof(float));
+  }
+}
+
+SD_INLINE void convertFromFloats(const float* x, bfloat16* z, const sd::LongType n) {
+  sd::LongType i = 0;
+#if defined(__AVX512BF16__) && defined(__AVX512VL__)
+  for (; i + 16 <= n; i += 16) {
+    const __m256bh packed = _mm512_cvtneps_pbh(_mm512_loadu_ps(x + i));
+    std::memcpy(z + i, &packed, sizeof(packed));
+  }
+#endif
+  PRAGMA_OMP_SIMD
+  for (auto e = i; e < n; e++) {
+    uint32_t bits;
+    std::memcpy(&bits, x + e, sizeof(float));
+    // NaNs would round into infinities or carry into the sign, so they become a quiet NaN with the sign kept
+    const uint32_t nan = (bits >> 16 & 0x8000) | 0x7fc0;
+    const uint32_t rounded = (bits + 0x7fff + ((bits >> 16) & 1)) >> 16;
+    z[e]._data = static_cast<int16_t>((bits & 0x7fffffff) > 0x7f800000 ? nan : rounded);
+  }
+}
+
+// other types go through plain casts, so that callers can convert between any type and a float block
+template <typename T>
+SD_INLINE void convertToFloats(const T* x, float* z, const sd::LongType n) {
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < n; e++) z[e] = static_cast<float>(x[e]);
+}
+
+template <typename T>
+SD_INLINE void convertFromFloats(const float* x, T* z, const sd::LongType n) {
+  PRAGMA_OMP_SIMD
+  for (sd::LongType e = 0; e < n; e++) z[e] = static_cast<T>(x[e]);
+}
+
+SD_INLINE void convertToFloats(const float* x, float* z, const sd::LongType n) {
+  if (x != z) std::memcpy(z, x, n * sizeof(float));
+}
+
+SD_INLINE void convertFromFloats(const float* x, float* z, const sd::LongType n) {
+  if (x != z) std::memcpy(z, x, n * sizeof(float));
+}
+
+}  // namespace sd
+
+#endif  // LIBND4J_HALF_CONVERSIONS_H
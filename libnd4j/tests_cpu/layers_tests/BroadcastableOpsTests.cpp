@@ -793,3 +793,70 @@ TEST_F(BroadcastableOpsTests, test_bert_multiply_2) {
 
   ASSERT_EQ(e, z);
 }
+
+// reference z = x + y with size-1 dims of x and y broadcast, computed element by element
+static NDArray broadcastAddReference(const NDArray &x, const NDArray &y, const NDArray &z) {
+  NDArray e(z.ordering(), z.getShapeAsVector(), z.dataType());
+  sd::LongType coords[SD_MAX_RANK];
+  for (sd::LongType i = 0; i < e.lengthOf(); ++i) {
+    shape::index2coords(i, e.shapeInfo(), coords);
+    sd::LongType xi = 0, yi = 0;
+    for (int d = 0; d < e.rankOf(); ++d) {
+      xi = xi * x.sizeAt(d) + (x.sizeAt(d) == 1 ? 0 : coords[d]);
+      yi = yi * y.sizeAt(d) + (y.sizeAt(d) == 1 ? 0 : coords[d]);
+    }
+    e.p(i, x.e<double>(xi) + y.e<double>(yi));
+  }
+  return e;
+}
+
+TEST_F(BroadcastableOpsTests, broadcast_rank6_1) {
+  auto x = NDArrayFactory::create<float>('c', {2, 3, 1, 4, 1, 5});
+  auto y = NDArrayFactory::create<float>('c', {1, 3, 2, 1, 2, 5});
+  auto z = NDArrayFactory::create<float>('c', {2, 3, 2, 4, 2, 5});
+  x.linspace(1.f);
+  y.linspace(0.5f, 0.25f);
+
+  x.applyTrueBroadcast(BroadcastOpsTuple::Add(), y, z);
+
+  ASSERT_EQ(broadcastAddReference(x, y, z), z);
+}
+
+TEST_F(BroadcastableOpsTests, broadcast_transposed_1) {
+  // x is 'f'-ordered and z 'c'-ordered: the engine walks the inner dims in tiles
+  auto x = NDArrayFactory::create<double>('f', {3, 70, 130});
+  auto y = NDArrayFactory::create<double>('c', {1, 70, 130});
+  auto z = NDArrayFactory::create<double>('c', {3, 70, 130});
+  auto zf = NDArrayFactory::create<double>('f', {3, 70, 130});
+  x.linspace(1.);
+  y.linspace(-3., 0.5);
+
+  x.applyTrueBroadcast(BroadcastOpsTuple::Add(), y, z);
+  x.applyTrueBroadcast(BroadcastOpsTuple::Add(), y, zf);
+
+  auto e = broadcastAddReference(x, y, z);
+  ASSERT_EQ(e, z);
+  ASSERT_EQ(e, zf);
+}
+
+TEST_F(BroadcastableOpsTests, broadcast_channels_bool_int_1) {
+  auto x = NDArrayFactory::create<float>('c', {2, 4, 3, 3});
+  auto y = NDArrayFactory::create<float>('c', {1, 4, 1, 1}, {3.f, 10.f, 40.f, 50.f});
+  auto z = NDArrayFactory::create<bool>('c', {2, 4, 3, 3});
+  x.linspace(1.f);
+
+  x.applyTrueBroadcast(BroadcastBoolOpsTuple::custom(scalar::GreaterThan, pairwise::GreaterThan, broadcast::GreaterThan),
+                       y, z);
+  for (sd::LongType i = 0; i < z.lengthOf(); ++i)
+    ASSERT_EQ(x.e<float>(i) > y.e<float>((i / 9) % 4), z.e<bool>(i));
+
+  auto a = NDArrayFactory::create<int>('c', {5, 1, 6});
+  auto b = NDArrayFactory::create<int>('c', {1, 3, 1}, {0, 1, 2});
+  auto c = NDArrayFactory::create<int>('c', {5, 3, 6});
+  a.linspace(1);
+
+  a.applyTrueBroadcast(BroadcastIntOpsTuple::custom(scalar::ShiftLeft, pairwise::ShiftLeft, broadcast::ShiftLeft), b,
+                       c);
+  for (sd::LongType i = 0; i < c.lengthOf(); ++i)
+    ASSERT_EQ(a.e<int>((i / 18) * 6 + i % 6) << b.e<int>((i / 6) % 3), c.e<int>(i));
+}
@@ -22,6 +22,7 @@
 #include <graph/Graph.h>
 #include <graph/GraphExecutioner.h>
 #include <graph/Node.h>
+#include <graph/execution/LoopProgram.h>
 #include <ops/declarable/CustomOperations.h>
 
 #include "testlayers.h"
@@ -247,6 +248,63 @@ TEST_F(ConditionalTests, Flat_Test_5) {
   delete graph;
 }
 
+/**
+ * many cycles in body: everything after the first cycle runs on bound variables
+ */
+TEST_F(ConditionalTests, Flat_Test_5_1) {
+  sd::ops::identity op0;
+
+  auto graph = GraphExecutioner::importFromFlatBuffers("./resources/simplewhile_0_4.fb");
+  auto varSpace = graph->getVariableSpace();
+  varSpace->getVariable(2)->getNDArray()->assign(100.0);
+
+  auto status = GraphExecutioner::execute(graph);
+  ASSERT_EQ(sd::Status::OK, status);
+
+  ASSERT_TRUE(varSpace->hasVariable(17));
+
+  auto z = varSpace->getVariable(17)->getNDArray();
+
+  ASSERT_NE(nullptr, z);
+
+  // 13 cycles, 2.0 each
+  auto exp = NDArrayFactory::create<float>('c', {2, 2}, {26, 26, 26, 26});
+  ASSERT_TRUE(exp.equalsTo(z));
+
+  delete graph;
+}
+
+TEST_F(ConditionalTests, Flat_Test_5_2) {
+  sd::ops::identity op0;
+
+  auto graph = GraphExecutioner::importFromFlatBuffers("./resources/simplewhile_0_4.fb");
+  auto varSpace = graph->getVariableSpace();
+  varSpace->getVariable(2)->getNDArray()->assign(100.0);
+
+  int whileId = 0;
+  for (auto& p : *graph->getMapped())
+    if (p.second->opType() == OpType_LOGIC && p.second->opNum() == sd::logic::While) whileId = p.first;
+  ASSERT_NE(0, whileId);
+
+  auto exp = NDArrayFactory::create<float>('c', {2, 2}, {26, 26, 26, 26});
+
+  // second run has to resolve variables again, and keeps double buffering
+  for (int run = 0; run < 2; run++) {
+    auto status = GraphExecutioner::execute(graph);
+    ASSERT_EQ(sd::Status::OK, status);
+    ASSERT_TRUE(exp.equalsTo(varSpace->getVariable(17)->getNDArray()));
+
+    auto program = graph->loopProgram(whileId);
+    ASSERT_NE(nullptr, program);
+
+    // 13 iterations, the first one goes through the interpreter, the rest swap arrays instead of copying
+    ASSERT_LT(0, program->swappedReturns());
+    ASSERT_EQ(0, program->copiedReturns());
+  }
+
+  delete graph;
+}
+
 /**
  * While loop with multiple variables
  */
@@ -5080,4 +5080,84 @@ TEST_F(ConvolutionTests2, depthwise_conv2d_bp_test7) {
   ASSERT_TRUE(expGradW.equalsTo(gradW));
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, nchwc_roundtrip_1) {
+  const int bS = 2, iC = SD_CHANNEL_BLOCK + 3, iH = 3, iW = 4;
+
+  NDArray input('c', {bS, iH, iW, iC}, sd::DataType::FLOAT32);
+  input.linspace(-5., 0.25);
+
+  sd::ops::to_nchwc toOp;
+  sd::ops::from_nchwc fromOp;
+
+  auto blocked = toOp.evaluate({&input}, {}, {1});
+  ASSERT_EQ(sd::Status::OK, blocked.status());
+  ASSERT_TRUE(blocked.at(0)->isSameShape({bS, 2, iH, iW, SD_CHANNEL_BLOCK}));
+
+  // tail channels of last block are zeros
+  ASSERT_EQ(0.f, (*blocked.at(0))({0, 0, 1, 2, 0, 0, 0, 0, 3, SD_CHANNEL_BLOCK}).reduceNumber(reduce::ASum).e<float>(0));
+
+  auto plain = fromOp.evaluate({blocked.at(0)}, {}, {iC, 1});
+  ASSERT_EQ(sd::Status::OK, plain.status());
+  ASSERT_TRUE(input.isSameShape(plain.at(0)));
+  ASSERT_TRUE(input.equalsTo(plain.at(0)));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, conv2d_nchwc_1) {
+  const int bS = 2, iC = 3, iH = 6, iW = 5, oC = SD_CHANNEL_BLOCK + 1;
+  const int kH = 3, kW = 2, sH = 2, sW = 1, pH = 0, pW = 0, dH = 1, dW = 2;
+
+  for (int paddingMode = 0; paddingMode < 2; ++paddingMode) {
+    for (int wFormat = 0; wFormat < 3; ++wFormat) {
+      NDArray input('c', {bS, iC, iH, iW}, sd::DataType::FLOAT32);
+      NDArray weights('c', sd::ops::ConvolutionUtils::expectWeightsShape(wFormat, kH, kW, iC, oC), sd::DataType::FLOAT32);
+      NDArray bias('c', {oC}, sd::DataType::FLOAT32);
+      input.linspace(-1., 0.01);
+      weights.linspace(0.5, -0.007);
+      bias.linspace(-0.2, 0.05);
+
+      const std::vector<sd::LongType> iArgs = {kH, kW, sH, sW, pH, pW, dH, dW, paddingMode, 0, wFormat};
+
+      sd::ops::conv2d conv;
+      sd::ops::conv2d_nchwc blockedConv;
+
+      auto exp = conv.evaluate({&input, &weights, &bias}, {}, iArgs);
+      auto result = blockedConv.evaluate({&input, &weights, &bias}, {}, iArgs);
+      ASSERT_EQ(sd::Status::OK, result.status());
+
+      ASSERT_TRUE(exp.at(0)->isSameShape(result.at(0)));
+      ASSERT_TRUE(exp.at(0)->equalsTo(result.at(0), 1e-4));
+    }
+  }
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(ConvolutionTests2, pooling2d_nchwc_1) {
+  const int bS = 2, iC = 5, iH = 7, iW = 6;
+
+  NDArray input('c', {bS, iH, iW, iC}, sd::DataType::FLOAT32);
+  input.linspace(-3., 0.013);
+
+  // kH, kW, sH, sW, pH, pW, dH, dW, same mode, divisor, NHWC
+  const std::vector<sd::LongType> iArgs = {3, 3, 2, 2, 0, 0, 1, 1, 1, 0, 1};
+
+  sd::ops::maxpool2d maxPool;
+  sd::ops::maxpool2d_nchwc blockedMaxPool;
+  sd::ops::avgpool2d avgPool;
+  sd::ops::avgpool2d_nchwc blockedAvgPool;
+
+  auto expMax = maxPool.evaluate({&input}, {}, iArgs);
+  auto max = blockedMaxPool.evaluate({&input}, {}, iArgs);
+  ASSERT_EQ(sd::Status::OK, max.status());
+  ASSERT_TRUE(expMax.at(0)->isSameShape(max.at(0)));
+  ASSERT_TRUE(expMax.at(0)->equalsTo(max.at(0)));
+
+  auto expAvg = avgPool.evaluate({&input}, {}, iArgs);
+  auto avg = blockedAvgPool.evaluate({&input}, {}, iArgs);
+  ASSERT_EQ(sd::Status::OK, avg.status());
+  ASSERT_TRUE(expAvg.at(0)->isSameShape(avg.at(0)));
+  ASSERT_TRUE(expAvg.at(0)->equalsTo(avg.at(0)));
+}
+
 #endif  // LIBND4J_CONVOLUTIONTESTS2_H
@@ -0,0 +1,77 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+#include <ops/declarable/CustomOperations.h>
+#include <system/CpuDispatch.h>
+
+#include "testlayers.h"
+
+using namespace sd;
+
+class CpuDispatchTests : public testing::Test {
+ public:
+  CpuIsa _isa;
+
+  CpuDispatchTests() { _isa = CpuDispatch::getInstance().isa(); }
+
+  ~CpuDispatchTests() { CpuDispatch::getInstance().setIsa(_isa); }
+};
+
+TEST_F(CpuDispatchTests, test_detection_1) {
+  auto& dispatch = CpuDispatch::getInstance();
+
+  ASSERT_TRUE(dispatch.supports(CpuIsa::GENERIC));
+  ASSERT_TRUE(dispatch.supports(dispatch.detected()));
+  ASSERT_TRUE(dispatch.supports(dispatch.isa()));
+  ASSERT_EQ(std::string("generic"), std::string(CpuDispatch::isaName(CpuIsa::GENERIC)));
+}
+
+TEST_F(CpuDispatchTests, test_unsupported_isa_1) {
+  auto& dispatch = CpuDispatch::getInstance();
+  for (auto isa : {CpuIsa::AVX2, CpuIsa::AVX512, CpuIsa::NEON, CpuIsa::SVE}) {
+    if (dispatch.supports(isa)) continue;
+    ASSERT_ANY_THROW(dispatch.setIsa(isa));
+  }
+}
+
+// every variant available on this host has to produce the generic results
+TEST_F(CpuDispatchTests, test_variants_1) {
+  auto& dispatch = CpuDispatch::getInstance();
+
+  NDArray x('c', {16, 37}, sd::DataType::FLOAT32);
+  x.linspace(-3, 0.011);
+
+  dispatch.setIsa(CpuIsa::GENERIC);
+  auto expTransform = x.transform(transform::Tanh);
+  auto expReduce = x.reduceAlongDimension(reduce::Sum, {1});
+  auto expCast = x.cast(sd::DataType::HALF);
+  sd::ops::softmax softmax;
+  auto expSoftmax = softmax.evaluate({&x}, {}, {0});
+
+  for (auto isa : {CpuIsa::AVX2, CpuIsa::AVX512, CpuIsa::NEON, CpuIsa::SVE}) {
+    if (!dispatch.supports(isa)) continue;
+    dispatch.setIsa(isa);
+
+    ASSERT_TRUE(expTransform.equalsTo(x.transform(transform::Tanh)));
+    ASSERT_TRUE(expReduce.equalsTo(x.reduceAlongDimension(reduce::Sum, {1})));
+    ASSERT_TRUE(expCast.equalsTo(x.cast(sd::DataType::HALF)));
+    auto result = softmax.evaluate({&x}, {}, {0});
+    ASSERT_TRUE(expSoftmax.at(0)->equalsTo(result.at(0)));
+  }
+}
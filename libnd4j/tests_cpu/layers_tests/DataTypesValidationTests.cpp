@@ -127,6 +127,87 @@ TEST_F(DataTypesValidationTests, cast_1) {
   ASSERT_TRUE(y == static_cast<float>(x));
 }
 
+TEST_F(DataTypesValidationTests, half_compute_1) {
+  // long enough to span several conversion blocks and threads
+  const int length = 3000;
+  for (auto dtype : {sd::DataType::HALF, sd::DataType::BFLOAT16}) {
+    auto xf = NDArrayFactory::create<float>('c', {length});
+    auto yf = NDArrayFactory::create<float>('c', {length});
+    xf.linspace(0.25, 0.01);
+    yf.linspace(-1.0, 0.002);
+
+    auto x = xf.cast(dtype);
+    auto y = yf.cast(dtype);
+    auto z = x.ulike();
+
+    x.applyTransform(transform::Sqrt, z);
+    ASSERT_TRUE(z.equalsTo(x.cast(sd::DataType::FLOAT32).transform(transform::Sqrt).cast(dtype), 1e-2));
+
+    x.applyPairwiseTransform(pairwise::Add, y, z);
+    ASSERT_TRUE(z.equalsTo((x.cast(sd::DataType::FLOAT32) + y.cast(sd::DataType::FLOAT32)).cast(dtype), 1e-2));
+
+    x.applyScalar(scalar::Multiply, 3.0, z);
+    ASSERT_TRUE(z.equalsTo((x.cast(sd::DataType::FLOAT32) * 3.f).cast(dtype), 1e-2));
+  }
+}
+
+TEST_F(DataTypesValidationTests, half_compute_2) {
+  // 0.1 isn't representable, accumulating it in 16 bits would drift far from the float sum
+  auto x = NDArrayFactory::create<float>('c', {4096});
+  x.assign(0.1f);
+
+  for (auto dtype : {sd::DataType::HALF, sd::DataType::BFLOAT16}) {
+    auto h = x.cast(dtype);
+    const float expected = 4096.f * h.e<float>(0);
+
+    ASSERT_NEAR(expected, h.reduceNumber(reduce::Sum).e<float>(0), expected * 1e-2);
+    ASSERT_NEAR(h.e<float>(0), h.reduceNumber(reduce::Mean).e<float>(0), 1e-3);
+  }
+}
+
+TEST_F(DataTypesValidationTests, half_cast_1) {
+  auto x = NDArrayFactory::create<float>('c', {1000});
+  x.linspace(-500.0, 1.0);
+
+  // integers of this magnitude are exact in half, and bfloat16 rounds them to 8 significant bits
+  ASSERT_TRUE(x.equalsTo(x.cast(sd::DataType::HALF).cast(sd::DataType::FLOAT32)));
+  ASSERT_TRUE(x.equalsTo(x.cast(sd::DataType::HALF).cast(sd::DataType::INT32).cast(sd::DataType::FLOAT32)));
+
+  auto b = x.cast(sd::DataType::BFLOAT16).cast(sd::DataType::DOUBLE);
+  for (int e = 0; e < 1000; e++) ASSERT_NEAR(x.e<double>(e), b.e<double>(e), std::abs(x.e<double>(e)) / 256.);
+}
+
+TEST_F(DataTypesValidationTests, half_cast_2) {
+  // NaNs, infinities and rounding ties, as float bits and the bfloat16 bits they are expected to narrow to
+  const std::vector<std::pair<uint32_t, uint16_t>> cases = {
+      {0x7fc00000, 0x7fc0}, {0xffc00000, 0xffc0}, {0x7fffffff, 0x7fc0}, {0xffffffff, 0xffc0},
+      {0x7f800001, 0x7fc0}, {0x7f807fff, 0x7fc0}, {0x7f800000, 0x7f80}, {0xff800000, 0xff80},
+      {0x7f7fffff, 0x7f80}, {0x3f808000, 0x3f80}, {0x3f818000, 0x3f82}, {0x3f808001, 0x3f81},
+      {0xbf808000, 0xbf80}, {0x00000000, 0x0000}, {0x80000000, 0x8000}};
+
+  // long enough to run both the vector and the scalar tail of the conversion
+  const int length = 3 * cases.size();
+  auto x = NDArrayFactory::create<float>('c', {length});
+  for (int e = 0; e < length; e++) {
+    float f;
+    std::memcpy(&f, &cases[e % cases.size()].first, sizeof(float));
+    x.p(e, f);
+  }
+
+  auto z = x.cast(sd::DataType::BFLOAT16);
+  for (int e = 0; e < length; e++) {
+    const uint16_t expected = cases[e % cases.size()].second;
+    const uint16_t actual = static_cast<uint16_t>(z.bufferAsT<bfloat16>()[e]._data);
+
+    // hardware conversions may keep more of the NaN payload, only the sign and the NaN-ness are fixed
+    if ((expected & 0x7fff) > 0x7f80) {
+      ASSERT_EQ(expected & 0x8000, actual & 0x8000);
+      ASSERT_GT(actual & 0x7fff, 0x7f80);
+    } else
+      ASSERT_EQ(expected, actual);
+  }
+}
+
 TEST_F(DataTypesValidationTests, test_bits_hamming_distance_1) {
   auto x = NDArrayFactory::create<int>('c', {3}, {0b01011000, 0b01011111, 0b01111110});
   auto y = NDArrayFactory::create<int>('c', {3}, {0b00010110, 0b01011000, 0b01011000});
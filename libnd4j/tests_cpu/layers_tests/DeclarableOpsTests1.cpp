@@ -2976,6 +2976,51 @@ TEST_F(DeclarableOpsTests1, softmax_test12) {
   ASSERT_TRUE(expOutput.isSameShape(z));
   ASSERT_TRUE(expOutput.equalsTo(z));
 }
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, softmax_test13) {
+  // softmax along a non-last axis, compared with softmax along the last axis of the permuted input
+  NDArray input('c', {3, 300, 7}, sd::DataType::FLOAT32);
+  input.linspace(-40, 0.013);
+
+  sd::ops::softmax op;
+  auto results = op.evaluate({&input}, {}, {1}, {});
+  ASSERT_EQ(sd::Status::OK, results.status());
+
+  auto permuted = input.permute({0, 2, 1}).dup('c');
+  auto expected = op.evaluate({&permuted}, {}, {2}, {});
+  ASSERT_EQ(sd::Status::OK, expected.status());
+
+  ASSERT_TRUE(expected.at(0)->permute({0, 2, 1}).equalsTo(results.at(0), 1e-6));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests1, softmax_bp_test1) {
+  NDArray input('c', {4, 5, 6}, sd::DataType::FLOAT32);
+  NDArray gradO('c', {4, 5, 6}, sd::DataType::FLOAT32);
+  input.linspace(-3, 0.05);
+  gradO.linspace(1, -0.02);
+
+  for (int dim : {1, 2}) {
+    sd::ops::softmax softmaxOp;
+    auto softmax = softmaxOp.evaluate({&input}, {}, {dim}, {});
+    ASSERT_EQ(sd::Status::OK, softmax.status());
+    auto y = softmax.at(0);
+    auto expected = *y * (gradO - (*y * gradO).reduceAlongDimension(sd::reduce::Sum, {dim}, true));
+
+    sd::ops::softmax_bp op;
+    auto results = op.evaluate({&input, &gradO}, {}, {dim}, {});
+    ASSERT_EQ(sd::Status::OK, results.status());
+    ASSERT_TRUE(expected.equalsTo(results.at(0), 1e-5));
+
+    auto expectedLog = gradO - *y * gradO.reduceAlongDimension(sd::reduce::Sum, {dim}, true);
+    sd::ops::log_softmax_bp logOp;
+    auto logResults = logOp.evaluate({&input, &gradO}, {}, {dim}, {});
+    ASSERT_EQ(sd::Status::OK, logResults.status());
+    ASSERT_TRUE(expectedLog.equalsTo(logResults.at(0), 1e-5));
+  }
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests1, Reverse_1) {
   float inBuff[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24};
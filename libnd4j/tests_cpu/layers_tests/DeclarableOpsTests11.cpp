@@ -1631,6 +1631,44 @@ TEST_F(DeclarableOpsTests11, ImageResizeArea_Test15) {
   ASSERT_TRUE(expected.equalsTo(result));
 }
 
+TEST_F(DeclarableOpsTests11, ImageResizeArea_Test16) {
+  NDArray input = NDArrayFactory::create<uint8_t>('c', {1, 5, 5, 1});
+  input.linspace(1);
+  NDArray inputF = input.cast(sd::DataType::FLOAT32);
+
+  sd::ops::resize_area op;
+  auto expected = op.evaluate({&inputF}, {}, {8, 7}, {false});
+  // the second call for the same sizes reuses the cached coefficients
+  auto results = op.evaluate({&input}, {}, {8, 7}, {false});
+  auto cached = op.evaluate({&input}, {}, {8, 7}, {false});
+
+  ASSERT_EQ(sd::Status::OK, expected.status());
+  ASSERT_EQ(sd::Status::OK, results.status());
+  ASSERT_EQ(sd::Status::OK, cached.status());
+
+  // 8-bit input is accumulated in fixed point
+  ASSERT_TRUE(expected.at(0)->isSameShape(results.at(0)));
+  ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0), 1e-3));
+  ASSERT_TRUE(results.at(0)->equalsTo(cached.at(0)));
+}
+
+TEST_F(DeclarableOpsTests11, ImageResizeBilinear_Strided_1) {
+  NDArray input('c', {1, 4, 4, 2}, sd::DataType::FLOAT32);
+  input.linspace(1);
+  // channels-last view over a channels-first buffer
+  NDArray permuted('c', {1, 2, 4, 4}, sd::DataType::FLOAT32);
+  permuted.assign(input.permute({0, 3, 1, 2}));
+  auto view = permuted.permute({0, 2, 3, 1});
+
+  sd::ops::resize_bilinear op;
+  auto expected = op.evaluate({&input}, {}, {7, 5});
+  auto results = op.evaluate({&view}, {}, {7, 5});
+
+  ASSERT_EQ(sd::Status::OK, expected.status());
+  ASSERT_EQ(sd::Status::OK, results.status());
+  ASSERT_TRUE(expected.at(0)->equalsTo(results.at(0)));
+}
+
 ///////////////////////////////////////////////////////////////////
 TEST_F(DeclarableOpsTests11, summaryStatsData_test1) {
   functions::summarystats::SummaryStatsData<double> var1;
@@ -558,6 +558,52 @@ TEST_F(DeclarableOpsTests15, Test_layer_norm_bp_2) {
   ASSERT_EQ(sd::Status::OK, status);
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, Test_layer_norm_2) {
+  // normalized axes are not trailing, channels are last
+  NDArray x('c', {2, 3, 4, 5}, sd::DataType::FLOAT32);
+  NDArray gain('c', {5}, {-0.1, 0.1, -0.2, 0.2, 0.5}, sd::DataType::FLOAT32);
+  NDArray bias('c', {5}, {-0.05, 0.05, -1.05, 1.05, 0.}, sd::DataType::FLOAT32);
+  x.linspace(-3, 0.07);
+
+  sd::ops::standardize standardizeOp;
+  auto standardized = standardizeOp.evaluate({&x}, {}, {1, 2});
+  ASSERT_EQ(sd::Status::OK, standardized.status());
+  NDArray expected = *standardized.at(0) * gain + bias;
+
+  sd::ops::layer_norm op;
+  auto result = op.evaluate({&x, &gain, &bias}, {}, {1, 2}, {false});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_TRUE(expected.isSameShape(result.at(0)));
+  ASSERT_TRUE(expected.equalsTo(result.at(0), 1e-5));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(DeclarableOpsTests15, Test_layer_norm_bp_3) {
+  NDArray x('c', {3, 4, 6}, sd::DataType::FLOAT32);
+  NDArray gain('c', {4}, {-0.1, 0.1, -0.2, 0.2}, sd::DataType::FLOAT32);
+  NDArray gradO('c', {3, 4, 6}, sd::DataType::FLOAT32);
+  x.linspace(-2, 0.13);
+  gradO.linspace(-1, 0.03);
+
+  // reference: standardize_bp of gradO * gain, gain gradient from standardized input
+  sd::ops::standardize standardizeOp;
+  auto standardized = standardizeOp.evaluate({&x}, {}, {1, 2});
+  ASSERT_EQ(sd::Status::OK, standardized.status());
+  NDArray scaled = gradO.ulike();
+  gradO.applyBroadcast(sd::broadcast::Multiply, {1}, gain, scaled);
+  sd::ops::standardize_bp standardizeBpOp;
+  auto expGradI = standardizeBpOp.evaluate({&x, &scaled}, {}, {1, 2});
+  ASSERT_EQ(sd::Status::OK, expGradI.status());
+  auto expGradG = (*standardized.at(0) * gradO).reduceAlongDimension(sd::reduce::Sum, {0, 2});
+
+  sd::ops::layer_norm_bp op;
+  auto result = op.evaluate({&x, &gain, &gradO}, {}, {1, 2}, {true});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_TRUE(expGradI.at(0)->equalsTo(result.at(0), 1e-4));
+  ASSERT_TRUE(expGradG.equalsTo(result.at(1), 1e-4));
+}
+
 TEST_F(DeclarableOpsTests15, test_hashCode_1) {
   auto x = NDArrayFactory::create<int>('c', {10});
   auto y = NDArrayFactory::create<int>('c', {10});
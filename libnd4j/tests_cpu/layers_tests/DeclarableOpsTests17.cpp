@@ -64,6 +64,29 @@ TEST_F(DeclarableOpsTests17, test_sparse_to_dense_2) {
   ASSERT_EQ(sd::Status::OK, result.status());
 }
 
+TEST_F(DeclarableOpsTests17, test_sparse_to_dense_3) {
+  // repeated indices keep the last value given for them
+  const int numValues = 8192;
+  auto values = NDArrayFactory::create<float>('c', {numValues});
+  auto ranges = NDArrayFactory::create<sd::LongType>('c', {numValues, 2});
+  for (int e = 0; e < numValues; e++) {
+    values.p(e, (float)(e + 1));
+    ranges.p(e, 0, e % 2);
+    ranges.p(e, 1, e % 2);
+  }
+
+  auto shape = NDArrayFactory::create<sd::LongType>({3, 3});
+  auto def = NDArrayFactory::create<float>(0.f);
+  auto exp = NDArrayFactory::create<float>('c', {3, 3}, {8191.f, 0.f, 0.f, 0.f, 8192.f, 0.f, 0.f, 0.f, 0.f});
+
+  sd::ops::compat_sparse_to_dense op;
+  for (int e = 0; e < 5; e++) {
+    auto result = op.evaluate({&ranges, &shape, &values, &def});
+    ASSERT_EQ(sd::Status::OK, result.status());
+    ASSERT_EQ(exp, *result.at(0));
+  }
+}
+
 TEST_F(DeclarableOpsTests17, test_compat_string_split_1) {
   auto x = NDArrayFactory::string({2}, {"first string", "second"});
   auto delimiter = NDArrayFactory::string(" ");
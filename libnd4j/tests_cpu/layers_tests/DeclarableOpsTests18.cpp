@@ -2318,3 +2318,101 @@ TEST_F(DeclarableOpsTests18, TestUpdaterAmsGrad3) {
   ASSERT_TRUE(stateH.isSameShape(results.at(3)));
   ASSERT_TRUE(stateH.equalsTo(results.at(3)));
 }
+
+TEST_F(DeclarableOpsTests18, TestMultiTensorUpdater1) {
+  // tensors of different sizes, the largest one spans several chunks
+  const std::vector<sd::LongType> lengths = {5, 1, 40000};
+
+  std::vector<NDArray> params, grads, stateU, stateM;
+  for (auto length : lengths) {
+    params.emplace_back('c', std::vector<sd::LongType>{length}, DataType::FLOAT32);
+    grads.emplace_back('c', std::vector<sd::LongType>{length}, DataType::FLOAT32);
+    params.back().linspace(0.5, 0.001);
+    grads.back().linspace(-1.0, 0.0003);
+    stateU.emplace_back(NDArrayFactory::create<float>('c', {length}));
+    stateM.emplace_back(NDArrayFactory::create<float>('c', {length}));
+  }
+
+  // the same update done by adam_updater, tensor by tensor
+  std::vector<NDArray> expParams, expU, expM;
+  for (int t = 0; t < lengths.size(); t++) {
+    expParams.emplace_back(params[t].dup());
+    expU.emplace_back(stateU[t].dup());
+    expM.emplace_back(stateM[t].dup());
+  }
+
+  sd::ops::adam_updater adam;
+  sd::ops::multi_tensor_updater op;
+  for (int iteration = 0; iteration < 2; iteration++) {
+    for (int t = 0; t < lengths.size(); t++) {
+      NDArray update(grads[t].ulike());
+      ASSERT_EQ(sd::Status::OK, adam.execute({&grads[t], &expU[t], &expM[t]}, {&update, &expU[t], &expM[t]},
+                                             {0.001, 0.9, 0.999, 1.0e-8}, {iteration}));
+      expParams[t] -= update;
+    }
+
+    std::vector<NDArray*> inputs, outputs;
+    for (auto& p : params) inputs.push_back(&p);
+    for (auto& g : grads) inputs.push_back(&g);
+    for (auto& u : stateU) inputs.push_back(&u);
+    for (auto& m : stateM) inputs.push_back(&m);
+    for (auto& p : params) outputs.push_back(&p);
+    for (auto& u : stateU) outputs.push_back(&u);
+    for (auto& m : stateM) outputs.push_back(&m);
+
+    // updated in place
+    ASSERT_EQ(sd::Status::OK, op.execute(inputs, outputs, {0.001, 0.9, 0.999, 1.0e-8}, {3, iteration}));
+  }
+
+  for (int t = 0; t < lengths.size(); t++) {
+    ASSERT_TRUE(expParams[t].equalsTo(params[t]));
+    ASSERT_TRUE(expU[t].equalsTo(stateU[t]));
+    ASSERT_TRUE(expM[t].equalsTo(stateM[t]));
+  }
+}
+
+TEST_F(DeclarableOpsTests18, TestMultiTensorUpdater2) {
+  NDArray param0('c', {2}, {1, 2}, DataType::FLOAT32);
+  NDArray param1('c', {1}, {1}, DataType::FLOAT32);
+  // global norm of gradients is 5
+  NDArray grad0('c', {2}, {3, 4}, DataType::FLOAT32);
+  NDArray grad1('c', {1}, {0}, DataType::FLOAT32);
+
+  // sgd with lr 0.1, weight decay 0.5, gradients clipped to norm 1
+  NDArray exp0('c', {2}, {0.89, 1.82}, DataType::FLOAT32);
+  NDArray exp1('c', {1}, {0.95}, DataType::FLOAT32);
+
+  sd::ops::multi_tensor_updater op;
+  auto results = op.evaluate({&param0, &param1, &grad0, &grad1}, {0.1, 0., 0., 0., 0.5, 1.0}, {0});
+  ASSERT_EQ(sd::Status::OK, results.status());
+
+  ASSERT_TRUE(exp0.equalsTo(results.at(0)));
+  ASSERT_TRUE(exp1.equalsTo(results.at(1)));
+  // gradients stay intact
+  ASSERT_EQ(3.f, grad0.e<float>(0));
+}
+
+TEST_F(DeclarableOpsTests18, TestMultiTensorUpdater3) {
+  NDArray param('c', {1, 5}, {1, 1, 1, 1, 1}, DataType::FLOAT32);
+  NDArray grad('c', {1, 5}, {1, 2, 3, 4, 5}, DataType::FLOAT32);
+  NDArray initV('c', {1, 5}, {0.1, 0.2, 0.3, 0.4, 0.5}, DataType::FLOAT32);
+  NDArray initM('c', {1, 5}, {0.5, 0.4, 0.3, 0.2, 0.1}, DataType::FLOAT32);
+  NDArray initH('c', {1, 5}, {0.2, 0.01, 0.5, 0.01, 0.9}, DataType::FLOAT32);
+
+  NDArray update('c', {1, 5}, DataType::FLOAT32);
+  NDArray expV(initV.ulike()), expM(initM.ulike()), expH(initH.ulike());
+
+  sd::ops::ams_grad_updater single;
+  ASSERT_EQ(sd::Status::OK, single.execute({&grad, &initV, &initM, &initH}, {&update, &expV, &expM, &expH},
+                                           {0.01, 0.9, 0.999, 1.0e-8}, {3}));
+  auto expParam = param - update;
+
+  sd::ops::multi_tensor_updater op;
+  auto results = op.evaluate({&param, &grad, &initV, &initM, &initH}, {0.01, 0.9, 0.999, 1.0e-8}, {5, 3});
+  ASSERT_EQ(sd::Status::OK, results.status());
+
+  ASSERT_TRUE(expParam.equalsTo(results.at(0)));
+  ASSERT_TRUE(expV.equalsTo(results.at(1)));
+  ASSERT_TRUE(expM.equalsTo(results.at(2)));
+  ASSERT_TRUE(expH.equalsTo(results.at(3)));
+}
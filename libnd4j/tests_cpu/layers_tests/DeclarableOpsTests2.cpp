@@ -19,6 +19,7 @@
 #include <array/NDArrayList.h>
 #include <helpers/helper_hash.h>
 #include <ops/declarable/CustomOperations.h>
+#include <ops/declarable/helpers/ctc.h>
 
 #include <numeric>
 
@@ -4277,3 +4278,75 @@ TEST_F(DeclarableOpsTests2, ctc_beam_test2) {
   ASSERT_TRUE(expected_probs.equalsTo(result_probs));
   ASSERT_TRUE(expected_length.equalsTo(result_sequence_length));
 }
+
+TEST_F(DeclarableOpsTests2, ctc_beam_stream_test1) {
+  constexpr int CLASS_LEN = 5;
+  constexpr int BATCH_LEN = 1;
+  constexpr int MAX_FRAME_LEN = 3;
+  constexpr int NBEST_LEN = 2;
+  constexpr int BEAM_WIDTH = 3;
+  constexpr int BLANK_INDEX = CLASS_LEN - 1;
+  auto logits = NDArrayFactory::create<float>(
+      'c', {BATCH_LEN, MAX_FRAME_LEN, CLASS_LEN},
+      {-2.578319f, -1.091237f, -1.519336f, -2.115322f, -1.390921f, -1.901657f, -2.46196f, -1.718925f, -0.837558f,
+       -1.874794f, -1.761921f, -1.125581f, -2.378538f, -1.907196f, -1.336974f});
+
+  sd::ops::helpers::CtcBeamSearchStream stream(BATCH_LEN, CLASS_LEN, BLANK_INDEX, BEAM_WIDTH, NBEST_LEN);
+  // the first frame, then the rest of the sequence
+  auto chunk1 = logits({0, 0, 0, 1, 0, 0}, true);
+  auto chunk2 = logits({0, 0, 1, 3, 0, 0}, true);
+
+  stream.feed(chunk1);
+  auto partial = stream.hypotheses(0);
+  ASSERT_EQ(1, stream.frames(0));
+  ASSERT_EQ(NBEST_LEN, partial.size());
+  ASSERT_EQ(std::vector<int>({1}), partial[0].labels);
+
+  stream.feed(chunk2);
+  auto hypotheses = stream.hypotheses(0);
+  ASSERT_EQ(MAX_FRAME_LEN, stream.frames(0));
+  ASSERT_EQ(NBEST_LEN, hypotheses.size());
+  ASSERT_EQ(std::vector<int>({1, 3}), hypotheses[0].labels);
+  ASSERT_EQ(std::vector<int>({1, 3, 1}), hypotheses[1].labels);
+  ASSERT_NEAR(-2.817627, hypotheses[0].logProb, 1e-5);
+  ASSERT_NEAR(-3.054376, hypotheses[1].logProb, 1e-5);
+
+  stream.reset();
+  ASSERT_EQ(0, stream.frames(0));
+  stream.feed(logits);
+  ASSERT_EQ(std::vector<int>({1, 3}), stream.hypotheses(0)[0].labels);
+}
+
+TEST_F(DeclarableOpsTests2, ctc_beam_blank_index_test1) {
+  constexpr int CLASS_LEN = 5;
+  constexpr int BATCH_LEN = 1;
+  constexpr int MAX_FRAME_LEN = 3;
+  constexpr int NBEST_LEN = 2;
+  constexpr int BEAM_WIDTH = 3;
+  // out of range by one, both decoders fall back to the last class
+  constexpr int BLANK_INDEX = CLASS_LEN;
+  auto logits = NDArrayFactory::create<float>(
+      'c', {BATCH_LEN, MAX_FRAME_LEN, CLASS_LEN},
+      {-2.578319f, -1.091237f, -1.519336f, -2.115322f, -1.390921f, -1.901657f, -2.46196f, -1.718925f, -0.837558f,
+       -1.874794f, -1.761921f, -1.125581f, -2.378538f, -1.907196f, -1.336974f});
+  auto logits_length = NDArrayFactory::create<int>('c', {BATCH_LEN}, {3});
+
+  auto expected_seq = NDArrayFactory::create<int>('c', {BATCH_LEN, NBEST_LEN, MAX_FRAME_LEN}, {1, 3, 0, 1, 3, 1});
+  auto expected_length = NDArrayFactory::create<int>('c', {BATCH_LEN, NBEST_LEN}, {2, 3});
+  auto expected_probs = NDArrayFactory::create<float>('c', {BATCH_LEN, NBEST_LEN}, {-2.817627f, -3.054376f});
+
+  sd::ops::ctc_beam op;
+  auto results = op.evaluate({&logits, &logits_length}, {}, {BLANK_INDEX, BEAM_WIDTH, NBEST_LEN});
+
+  ASSERT_EQ(sd::Status::OK, results.status());
+  ASSERT_TRUE(expected_seq.equalsTo(results.at(0)));
+  ASSERT_TRUE(expected_probs.equalsTo(results.at(1)));
+  ASSERT_TRUE(expected_length.equalsTo(results.at(2)));
+
+  sd::ops::helpers::CtcBeamSearchStream stream(BATCH_LEN, CLASS_LEN, BLANK_INDEX, BEAM_WIDTH, NBEST_LEN);
+  stream.feed(logits);
+  auto hypotheses = stream.hypotheses(0);
+  ASSERT_EQ(NBEST_LEN, hypotheses.size());
+  ASSERT_EQ(std::vector<int>({1, 3}), hypotheses[0].labels);
+  ASSERT_EQ(std::vector<int>({1, 3, 1}), hypotheses[1].labels);
+}
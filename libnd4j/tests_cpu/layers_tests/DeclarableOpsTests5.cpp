@@ -1798,6 +1798,106 @@ TEST_F(DeclarableOpsTests5, EmbeddingLookup_3) {
 
   ASSERT_TRUE(exp.equalsTo(output));
 }
+TEST_F(DeclarableOpsTests5, EmbeddingBag_1) {
+  auto x = NDArrayFactory::create<float>('c', {4, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  auto indices = NDArrayFactory::create<sd::LongType>({0, 2, 1, 3, 3});
+  // the second bag is empty
+  auto offsets = NDArrayFactory::create<sd::LongType>({0, 2, 2});
+  auto exp = NDArrayFactory::create<float>('c', {3, 2}, {6, 8, 0, 0, 17, 20});
+
+  sd::ops::embedding_bag op;
+  auto result = op.evaluate({&x, &indices, &offsets}, {}, {0});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  auto output = result.at(0);
+  ASSERT_TRUE(exp.isSameShape(output));
+  ASSERT_TRUE(exp.equalsTo(output));
+}
+
+TEST_F(DeclarableOpsTests5, EmbeddingBag_2) {
+  auto x = NDArrayFactory::create<float>('c', {4, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  auto indices = NDArrayFactory::create<int>({0, 2, 1, 3, 3});
+  auto offsets = NDArrayFactory::create<int>({0, 2, 2});
+  auto weights = NDArrayFactory::create<float>({1.f, 0.5f, 2.f, 1.f, 1.f});
+  auto exp = NDArrayFactory::create<float>('c', {3, 2}, {1.75f, 2.5f, 0.f, 0.f, 20.f / 3.f, 8.f});
+
+  sd::ops::embedding_bag op;
+  auto result = op.evaluate({&x, &indices, &offsets, &weights}, {}, {1});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
+TEST_F(DeclarableOpsTests5, EmbeddingBag_3) {
+  auto x = NDArrayFactory::create<double>('c', {4, 2}, {1, 8, 3, 4, 5, 6, 7, 2});
+  auto indices = NDArrayFactory::create<sd::LongType>({0, 2, 1, 3, 3});
+  auto offsets = NDArrayFactory::create<sd::LongType>({0, 2, 2});
+  auto exp = NDArrayFactory::create<double>('c', {3, 2}, {5, 8, 0, 0, 7, 4});
+
+  sd::ops::embedding_bag op;
+  auto result = op.evaluate({&x, &indices, &offsets}, {}, {2});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
+TEST_F(DeclarableOpsTests5, EmbeddingBag_4) {
+  auto x = NDArrayFactory::create<float>('c', {4, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  auto indices = NDArrayFactory::create<sd::LongType>({0, 4});
+  auto offsets = NDArrayFactory::create<sd::LongType>({0});
+  auto output = NDArrayFactory::create<float>('c', {1, 2});
+
+  sd::ops::embedding_bag op;
+  ASSERT_ANY_THROW(op.execute({&x, &indices, &offsets}, {&output}, {}, {0}, {}));
+}
+
+TEST_F(DeclarableOpsTests5, EmbeddingBag_5) {
+  // f-ordered params and a strided output view, summed in double: 1e8 + 1 isn't representable in float
+  auto x = NDArrayFactory::create<double>('f', {3, 2}, {1e8, 1, 2, 3, 4, 5});
+  auto indices = NDArrayFactory::create<sd::LongType>({0, 1, 2});
+  auto offsets = NDArrayFactory::create<sd::LongType>({0, 2});
+  auto exp = NDArrayFactory::create<double>('c', {2, 2}, {1e8 + 1, 7, 2, 5});
+
+  auto buffer = NDArrayFactory::create<double>('c', {2, 4});
+  auto output = buffer({0, 0, 1, 3});
+
+  sd::ops::embedding_bag op;
+  ASSERT_EQ(sd::Status::OK, op.execute({&x, &indices, &offsets}, {&output}, {}, {0}, {}));
+  ASSERT_TRUE(exp.equalsTo(output));
+}
+
+TEST_F(DeclarableOpsTests5, EmbeddingBag_Bp_1) {
+  auto x = NDArrayFactory::create<float>('c', {4, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  auto indices = NDArrayFactory::create<sd::LongType>({0, 2, 1, 3, 3});
+  auto offsets = NDArrayFactory::create<sd::LongType>({0, 2, 2});
+  auto weights = NDArrayFactory::create<float>({1.f, 0.5f, 2.f, 1.f, 1.f});
+  auto gradO = NDArrayFactory::create<float>('c', {3, 2}, {1, 2, 3, 4, 5, 6});
+  auto expRows = NDArrayFactory::create<float>(
+      'c', {5, 2}, {0.5f, 1.f, 0.25f, 0.5f, 10.f / 3.f, 4.f, 5.f / 3.f, 2.f, 5.f / 3.f, 2.f});
+
+  sd::ops::embedding_bag_bp op;
+  auto result = op.evaluate({&x, &indices, &offsets, &weights, &gradO}, {}, {1});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  // the gradient is sparse: one row per lookup, repeated indices aren't merged
+  ASSERT_EQ(sd::DataType::INT64, result.at(0)->dataType());
+  ASSERT_TRUE(indices.equalsTo(result.at(0)));
+  ASSERT_TRUE(expRows.isSameShape(result.at(1)));
+  ASSERT_TRUE(expRows.equalsTo(result.at(1)));
+}
+
+TEST_F(DeclarableOpsTests5, EmbeddingBag_Bp_2) {
+  auto x = NDArrayFactory::create<double>('c', {4, 2}, {1, 8, 3, 4, 5, 6, 7, 2});
+  auto indices = NDArrayFactory::create<sd::LongType>({0, 2, 1, 3, 3});
+  auto offsets = NDArrayFactory::create<sd::LongType>({0, 2, 2});
+  auto gradO = NDArrayFactory::create<double>('c', {3, 2}, {1, 2, 3, 4, 5, 6});
+  // the first row holding the maximum gets the gradient
+  auto expRows = NDArrayFactory::create<double>('c', {5, 2}, {0, 2, 1, 0, 0, 6, 5, 0, 0, 0});
+
+  sd::ops::embedding_bag_bp op;
+  auto result = op.evaluate({&x, &indices, &offsets, &gradO}, {}, {2});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_TRUE(expRows.equalsTo(result.at(1)));
+}
+
 /* @Test
     public void testDynamicPartition(){
         INDArray data = Nd4j.createFromArray(2, 1, 2, 0);
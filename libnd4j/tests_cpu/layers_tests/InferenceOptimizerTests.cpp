@@ -0,0 +1,225 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+#include <array/NDArray.h>
+#include <graph/Graph.h>
+#include <graph/GraphExecutioner.h>
+#include <graph/InferenceOptimizer.h>
+#include <graph/Node.h>
+#include <ops/declarable/CustomOperations.h>
+
+#include "testlayers.h"
+
+using namespace sd;
+using namespace sd::graph;
+
+class InferenceOptimizerTests : public testing::Test {
+ public:
+};
+
+TEST_F(InferenceOptimizerTests, Conv2d_BatchNorm_Relu_1) {
+  auto x = NDArrayFactory::create<float>('c', {1, 2, 5, 5});
+  auto w = NDArrayFactory::create<float>('c', {2, 2, 2, 3});
+  auto b = NDArrayFactory::create<float>('c', {3}, {0.1f, -0.2f, 0.3f});
+  auto mean = NDArrayFactory::create<float>('c', {3}, {0.5f, -1.f, 0.25f});
+  auto variance = NDArrayFactory::create<float>('c', {3}, {1.5f, 0.5f, 2.f});
+  auto gamma = NDArrayFactory::create<float>('c', {3}, {0.8f, 1.2f, -0.6f});
+  auto beta = NDArrayFactory::create<float>('c', {3}, {0.1f, -0.3f, 0.2f});
+  x.linspace(-1.f, 0.1f);
+  w.linspace(-0.5f, 0.07f);
+
+  // reference: ops executed one by one
+  sd::ops::conv2d conv;
+  sd::ops::batchnorm norm;
+  sd::ops::relu relu;
+
+  auto convResult = conv.evaluate({&x, &w, &b}, {}, {2, 2, 1, 1, 0, 0, 1, 1, 0, 0});
+  ASSERT_EQ(sd::Status::OK, convResult.status());
+  auto normResult = norm.evaluate({convResult.at(0), &mean, &variance, &gamma, &beta}, {1e-3}, {1, 1, 1});
+  ASSERT_EQ(sd::Status::OK, normResult.status());
+  auto reluResult = relu.evaluate({normResult.at(0)}, {0.0}, {});
+  ASSERT_EQ(sd::Status::OK, reluResult.status());
+  auto exp = reluResult.at(0);
+
+  auto graph = new Graph();
+  auto varSpace = graph->getVariableSpace();
+  varSpace->putVariable(-1, new NDArray(x.dup()));
+  varSpace->putVariable(-2, new NDArray(w.dup()));
+  varSpace->putVariable(-3, new NDArray(b.dup()));
+  varSpace->putVariable(-4, new NDArray(mean.dup()));
+  varSpace->putVariable(-5, new NDArray(variance.dup()));
+  varSpace->putVariable(-6, new NDArray(gamma.dup()));
+  varSpace->putVariable(-7, new NDArray(beta.dup()));
+
+  graph->addNode(new Node(&conv, 1, {-1, -2, -3}, {}, {}, 0.0f, {}, {2, 2, 1, 1, 0, 0, 1, 1, 0, 0}));
+  graph->addNode(new Node(&norm, 2, {1, -4, -5, -6, -7}, {}, {}, 0.0f, {1e-3}, {1, 1, 1}));
+  graph->addNode(new Node(&relu, 3, {2}, {}, {}, 0.0f, {0.0}, {}));
+
+  ASSERT_EQ(3, graph->totalNodes());
+  ASSERT_EQ(2, InferenceOptimizer::optimize(graph));
+  ASSERT_EQ(1, graph->totalNodes());
+
+  auto node = graph->getMapped()->at(3);
+  ASSERT_EQ(FUSED_RELU, node->getContextPrototype()->fusedActivation());
+
+  ASSERT_EQ(sd::Status::OK, GraphExecutioner::execute(graph));
+  ASSERT_TRUE(varSpace->hasVariable(3));
+
+  auto z = varSpace->getVariable(3)->getNDArray();
+  ASSERT_TRUE(exp->isSameShape(z));
+  ASSERT_TRUE(exp->equalsTo(z, 1e-4));
+
+  delete graph;
+}
+
+TEST_F(InferenceOptimizerTests, XwPlusB_Relu_1) {
+  auto x = NDArrayFactory::create<float>('c', {2, 3}, {1.f, -2.f, 3.f, -4.f, 5.f, -6.f});
+  auto w = NDArrayFactory::create<float>('c', {3, 4}, {0.1f, -0.2f, 0.3f, -0.4f, 0.5f, -0.6f, 0.7f, -0.8f, 0.9f, -1.f, 1.1f, -1.2f});
+  auto b = NDArrayFactory::create<float>('c', {4}, {0.5f, 0.5f, -0.5f, -0.5f});
+  auto exp = NDArrayFactory::create<float>('c', {2, 4}, {2.3f, 0.f, 1.7f, 0.f, 0.f, 4.3f, 0.f, 4.3f});
+
+  sd::ops::xw_plus_b op;
+  sd::ops::relu relu;
+
+  auto graph = new Graph();
+  auto varSpace = graph->getVariableSpace();
+  varSpace->putVariable(-1, new NDArray(x.dup()));
+  varSpace->putVariable(-2, new NDArray(w.dup()));
+  varSpace->putVariable(-3, new NDArray(b.dup()));
+
+  graph->addNode(new Node(&op, 1, {-1, -2, -3}));
+  graph->addNode(new Node(&relu, 2, {1}, {}, {}, 0.0f, {0.0}, {}));
+
+  ASSERT_EQ(1, InferenceOptimizer::optimize(graph));
+  ASSERT_EQ(1, graph->totalNodes());
+
+  ASSERT_EQ(sd::Status::OK, GraphExecutioner::execute(graph));
+
+  auto z = varSpace->getVariable(2)->getNDArray();
+  ASSERT_TRUE(exp.equalsTo(z));
+
+  delete graph;
+}
+
+TEST_F(InferenceOptimizerTests, SharedProducer_1) {
+  auto x = NDArrayFactory::create<float>('c', {2, 3});
+  auto w = NDArrayFactory::create<float>('c', {3, 4});
+  auto b = NDArrayFactory::create<float>('c', {4});
+
+  sd::ops::xw_plus_b op;
+  sd::ops::relu relu;
+  sd::ops::sigmoid sigmoid;
+
+  auto graph = new Graph();
+  auto varSpace = graph->getVariableSpace();
+  varSpace->putVariable(-1, new NDArray(x.dup()));
+  varSpace->putVariable(-2, new NDArray(w.dup()));
+  varSpace->putVariable(-3, new NDArray(b.dup()));
+
+  // output of xw_plus_b is consumed twice, so nothing can be fused
+  graph->addNode(new Node(&op, 1, {-1, -2, -3}));
+  graph->addNode(new Node(&relu, 2, {1}, {}, {}, 0.0f, {0.0}, {}));
+  graph->addNode(new Node(&sigmoid, 3, {1}));
+
+  ASSERT_EQ(0, InferenceOptimizer::optimize(graph));
+  ASSERT_EQ(3, graph->totalNodes());
+
+  delete graph;
+}
+
+TEST_F(InferenceOptimizerTests, BlockedLayout_1) {
+  auto x = NDArrayFactory::create<float>('c', {2, 3, 8, 8});
+  auto w1 = NDArrayFactory::create<float>('c', {3, 3, 3, 5});
+  auto b1 = NDArrayFactory::create<float>('c', {5});
+  auto w2 = NDArrayFactory::create<float>('c', {1, 1, 5, 4});
+  x.linspace(-2.f, 0.01f);
+  w1.linspace(0.3f, -0.01f);
+  b1.linspace(-0.1f, 0.05f);
+  w2.linspace(-0.4f, 0.04f);
+
+  sd::ops::conv2d conv;
+  sd::ops::relu relu;
+  sd::ops::maxpool2d pool;
+
+  // reference: ops executed one by one
+  auto conv1 = conv.evaluate({&x, &w1, &b1}, {}, {3, 3, 1, 1, 0, 0, 1, 1, 1, 0});
+  auto relu1 = relu.evaluate({conv1.at(0)}, {0.0}, {});
+  auto pool1 = pool.evaluate({relu1.at(0)}, {}, {2, 2, 2, 2, 0, 0, 1, 1, 0});
+  auto conv2 = conv.evaluate({pool1.at(0), &w2}, {}, {1, 1, 1, 1, 0, 0, 1, 1, 0, 0});
+  ASSERT_EQ(sd::Status::OK, conv2.status());
+  auto exp = conv2.at(0);
+
+  auto graph = new Graph();
+  auto varSpace = graph->getVariableSpace();
+  varSpace->putVariable(-1, new NDArray(x.dup()));
+  varSpace->putVariable(-2, new NDArray(w1.dup()));
+  varSpace->putVariable(-3, new NDArray(b1.dup()));
+  varSpace->putVariable(-4, new NDArray(w2.dup()));
+
+  graph->addNode(new Node(&conv, 1, {-1, -2, -3}, {}, {}, 0.0f, {}, {3, 3, 1, 1, 0, 0, 1, 1, 1, 0}));
+  graph->addNode(new Node(&relu, 2, {1}, {}, {}, 0.0f, {0.0}, {}));
+  graph->addNode(new Node(&pool, 3, {2}, {}, {}, 0.0f, {}, {2, 2, 2, 2, 0, 0, 1, 1, 0}));
+  graph->addNode(new Node(&conv, 4, {3, -4}, {}, {}, 0.0f, {}, {1, 1, 1, 1, 0, 0, 1, 1, 0, 0}));
+
+  // relu fusion, then three layers switched to blocked layout
+  ASSERT_EQ(1, InferenceOptimizer::fuseActivations(graph));
+  ASSERT_EQ(3, InferenceOptimizer::propagateBlockedLayout(graph));
+  ASSERT_EQ(3, graph->totalNodes());
+  ASSERT_EQ(std::string("maxpool2d_nchwc"), *graph->getMapped()->at(3)->getCustomOp()->getOpName());
+
+  ASSERT_EQ(sd::Status::OK, GraphExecutioner::execute(graph));
+
+  auto z = varSpace->getVariable(4)->getNDArray();
+  ASSERT_TRUE(exp->isSameShape(z));
+  ASSERT_TRUE(exp->equalsTo(z, 1e-4));
+
+  delete graph;
+}
+
+TEST_F(InferenceOptimizerTests, BlockedLayout_2) {
+  sd::ops::conv2d conv;
+  sd::ops::maxpool2d pool;
+
+  auto build = [&]() -> Graph * {
+    auto graph = new Graph();
+    auto varSpace = graph->getVariableSpace();
+    varSpace->putVariable(-1, NDArrayFactory::create_<float>('c', {2, 3, 8, 8}));
+    varSpace->putVariable(-2, NDArrayFactory::create_<float>('c', {3, 3, 3, 5}));
+    varSpace->putVariable(-3, NDArrayFactory::create_<float>('c', {1, 1, 5, 4}));
+
+    graph->addNode(new Node(&conv, 1, {-1, -2}, {}, {}, 0.0f, {}, {3, 3, 1, 1, 0, 0, 1, 1, 1, 0}));
+    graph->addNode(new Node(&pool, 2, {1}, {}, {}, 0.0f, {}, {2, 2, 2, 2, 0, 0, 1, 1, 0}));
+    graph->addNode(new Node(&conv, 3, {2, -3}, {}, {}, 0.0f, {}, {1, 1, 1, 1, 0, 0, 1, 1, 0, 0}));
+    return graph;
+  };
+
+  // blocked layout is opt-in
+  auto graph = build();
+  ASSERT_EQ(0, InferenceOptimizer::optimize(graph));
+  ASSERT_EQ(std::string("maxpool2d"), *graph->getMapped()->at(2)->getCustomOp()->getOpName());
+  delete graph;
+
+  sd::Environment::getInstance().setBlockedLayout(true);
+  graph = build();
+  auto cnt = InferenceOptimizer::optimize(graph);
+  sd::Environment::getInstance().setBlockedLayout(false);
+
+  ASSERT_EQ(3, cnt);
+  ASSERT_EQ(std::string("maxpool2d_nchwc"), *graph->getMapped()->at(2)->getCustomOp()->getOpName());
+  delete graph;
+}
@@ -0,0 +1,204 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+
+//
+// Linear algebra ops on matrices larger than the panel width of the blocked kernels
+//
+#include <helpers/MmulHelper.h>
+#include <ops/declarable/CustomOperations.h>
+
+#include "testlayers.h"
+
+using namespace sd;
+
+class LinalgTests : public testing::Test {
+ public:
+  // deterministic pseudo-random matrix in [-0.5, 0.5), diagonally dominant when the shift is large enough
+  static NDArray matrix(sd::LongType rows, sd::LongType cols, double shift = 0.) {
+    NDArray result('c', {rows, cols}, DataType::DOUBLE);
+    uint64_t state = 119;
+    for (sd::LongType i = 0; i < rows; i++)
+      for (sd::LongType j = 0; j < cols; j++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        result.r<double>(i, j) = static_cast<double>(state >> 11) / 9007199254740992. - 0.5 + (i == j ? shift : 0.);
+      }
+    return result;
+  }
+
+  static NDArray product(const NDArray& a, const NDArray& b, bool transA = false, bool transB = false) {
+    NDArray result('c', {transA ? a.sizeAt(1) : a.sizeAt(0), transB ? b.sizeAt(0) : b.sizeAt(1)}, DataType::DOUBLE);
+    MmulHelper::matmul(&a, &b, &result, transA, transB);
+    return result;
+  }
+
+  static NDArray identity(sd::LongType n) {
+    NDArray result('c', {n, n}, DataType::DOUBLE);
+    result.setIdentity();
+    return result;
+  }
+};
+
+TEST_F(LinalgTests, matrix_inverse_1) {
+  auto a = matrix(150, 150, 10.);
+
+  sd::ops::matrix_inverse op;
+  auto result = op.evaluate({&a});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  ASSERT_TRUE(identity(150).equalsTo(product(a, *result.at(0)), 1e-8));
+}
+
+TEST_F(LinalgTests, matrix_inverse_singular_1) {
+  auto a = matrix(100, 100);
+  a({7, 8, 0, 0}).nullify();
+
+  sd::ops::matrix_inverse op;
+  auto result = op.evaluate({&a});
+  ASSERT_EQ(sd::Status::VALIDATION, result.status());
+}
+
+TEST_F(LinalgTests, lu_1) {
+  const sd::LongType n = 130;
+  auto a = matrix(n, n);
+
+  sd::ops::lu op;
+  auto result = op.evaluate({&a});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto factors = result.at(0);
+  auto permutation = result.at(1);
+
+  NDArray lower('c', {n, n}, DataType::DOUBLE), upper('c', {n, n}, DataType::DOUBLE), permuted(a.ulike());
+  lower.nullify();
+  upper.nullify();
+  for (sd::LongType i = 0; i < n; i++) {
+    for (sd::LongType j = 0; j < n; j++) {
+      if (j < i) lower.r<double>(i, j) = factors->e<double>(i, j);
+      if (j >= i) upper.r<double>(i, j) = factors->e<double>(i, j);
+      permuted.r<double>(i, j) = a.e<double>(permutation->e<sd::LongType>(i), j);
+    }
+    lower.r<double>(i, i) = 1.;
+  }
+
+  ASSERT_TRUE(permuted.equalsTo(product(lower, upper), 1e-8));
+}
+
+TEST_F(LinalgTests, matrix_determinant_1) {
+  auto a = NDArrayFactory::create<double>('c', {3, 3, 3}, {2, 0, 0, 0, 3, 0, 0, 0, 4,
+                                                           0, 1, 0, 1, 0, 0, 0, 0, 5,
+                                                           1, 2, 3, 4, 5, 6, 7, 8, 10});
+  auto exp = NDArrayFactory::create<double>({24., -5., -3.});
+
+  sd::ops::matrix_determinant op;
+  auto result = op.evaluate({&a});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  ASSERT_TRUE(exp.equalsTo(result.at(0)));
+}
+
+TEST_F(LinalgTests, cholesky_1) {
+  const sd::LongType n = 140;
+  auto b = matrix(n, n);
+  // symmetric positive definite
+  auto a = product(b, b, false, true);
+  a += identity(n);
+
+  sd::ops::cholesky op;
+  auto result = op.evaluate({&a});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto l = result.at(0);
+
+  for (sd::LongType i = 0; i < n; i++)
+    for (sd::LongType j = i + 1; j < n; j++) ASSERT_EQ(0., l->e<double>(i, j));
+  ASSERT_TRUE(a.equalsTo(product(*l, *l, false, true), 1e-8));
+}
+
+TEST_F(LinalgTests, triangular_solve_1) {
+  const sd::LongType n = 140;
+  auto a = matrix(n, n, 10.);
+  auto b = matrix(n, 3);
+  for (sd::LongType i = 0; i < n; i++)
+    for (sd::LongType j = i + 1; j < n; j++) a.r<double>(i, j) = 0.;
+
+  sd::ops::triangular_solve op;
+  auto result = op.evaluate({&a, &b}, {true, false});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  ASSERT_TRUE(b.equalsTo(product(a, *result.at(0)), 1e-8));
+}
+
+TEST_F(LinalgTests, qr_1) {
+  auto a = matrix(150, 90);
+
+  sd::ops::qr op;
+  auto result = op.evaluate({&a}, {}, {}, {false});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto q = result.at(0);
+  auto r = result.at(1);
+  ASSERT_EQ(std::vector<sd::LongType>({150, 90}), q->getShapeAsVector());
+  ASSERT_EQ(std::vector<sd::LongType>({90, 90}), r->getShapeAsVector());
+
+  for (sd::LongType i = 0; i < 90; i++)
+    for (sd::LongType j = 0; j < i; j++) ASSERT_EQ(0., r->e<double>(i, j));
+  ASSERT_TRUE(a.equalsTo(product(*q, *r), 1e-8));
+  ASSERT_TRUE(identity(90).equalsTo(product(*q, *q, true, false), 1e-8));
+}
+
+TEST_F(LinalgTests, svd_1) {
+  auto a = matrix(80, 70);
+
+  sd::ops::svd op;
+  auto result = op.evaluate({&a}, {}, {0, 1, 16});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto s = result.at(0);
+  auto u = result.at(1);
+  auto v = result.at(2);
+
+  for (sd::LongType i = 1; i < 70; i++) ASSERT_GE(s->e<double>(i - 1), s->e<double>(i));
+
+  NDArray us(*u);
+  for (sd::LongType i = 0; i < 80; i++)
+    for (sd::LongType j = 0; j < 70; j++) us.r<double>(i, j) *= s->e<double>(j);
+
+  ASSERT_TRUE(a.equalsTo(product(us, *v, false, true), 1e-8));
+  ASSERT_TRUE(identity(70).equalsTo(product(*v, *v, true, false), 1e-8));
+}
+
+TEST_F(LinalgTests, svd_2) {
+  // wide matrix with full V
+  auto a = matrix(40, 60);
+
+  sd::ops::svd op;
+  auto result = op.evaluate({&a}, {}, {1, 1, 16});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto s = result.at(0);
+  auto u = result.at(1);
+  auto v = result.at(2);
+  ASSERT_EQ(std::vector<sd::LongType>({40, 40}), u->getShapeAsVector());
+  ASSERT_EQ(std::vector<sd::LongType>({60, 60}), v->getShapeAsVector());
+
+  ASSERT_TRUE(identity(40).equalsTo(product(*u, *u, true, false), 1e-8));
+  ASSERT_TRUE(identity(60).equalsTo(product(*v, *v, true, false), 1e-8));
+
+  NDArray us(*u);
+  for (sd::LongType i = 0; i < 40; i++)
+    for (sd::LongType j = 0; j < 40; j++) us.r<double>(i, j) *= s->e<double>(j);
+  auto thinV = (*v)({0, 0, 0, 40}, true);
+  ASSERT_TRUE(a.equalsTo(product(us, thinV.dup('c'), false, true), 1e-8));
+}
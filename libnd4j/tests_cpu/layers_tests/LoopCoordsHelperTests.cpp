@@ -19,7 +19,9 @@
 //
 // @author Abdelrauf
 //
+#include <array/NDArray.h>
 #include <helpers/LoopsCoordsHelper.h>
+#include <helpers/OffsetIterator.h>
 
 #include <type_traits>
 
@@ -205,3 +207,38 @@ TEST_F(LoopCoordsHelper, Increment_Use_Tests) {
     zoffset2_f = inc_coords<false>(shape, strides_f, strides_f, zcoords2_f, zoffset2_f, Rank);
   }
 }
+
+TEST_F(LoopCoordsHelper, OffsetIterator_Tests) {
+  NDArray x('c', {4, 5, 6, 7}, sd::DataType::FLOAT32);
+  NDArray y('f', {4, 5, 6, 7}, sd::DataType::FLOAT32);
+
+  auto permuted = x.permute({2, 0, 3, 1});
+  auto sliced = x({0, 4, 1, 1, 4, 1, 0, 6, 1, 0, 7, 2}, true, true);
+  auto row = x({2, 3, 0, 0, 0, 0, 3, 4}, true);
+  auto yPermuted = y.permute({2, 0, 3, 1});
+  auto ySliced = y({0, 4, 1, 1, 4, 1, 0, 6, 1, 0, 7, 2}, true, true);
+
+  const sd::LongType len = permuted.lengthOf();
+  for (sd::LongType start : {0, 1, 41, 839}) {
+    OffsetIterator<3> it(permuted.shapeInfo(), yPermuted.shapeInfo(), x.shapeInfo());
+    it.seek(start);
+    for (sd::LongType i = start; i < len; i++, it.next()) {
+      ASSERT_EQ(shape::getIndexOffset(i, permuted.shapeInfo()), it.offset(0));
+      ASSERT_EQ(shape::getIndexOffset(i, yPermuted.shapeInfo()), it.offset(1));
+      ASSERT_EQ(shape::getIndexOffset(i, x.shapeInfo()), it.offset(2));
+    }
+  }
+
+  OffsetIterator<2> it(sliced.shapeInfo(), ySliced.shapeInfo());
+  for (sd::LongType i = 0; i < sliced.lengthOf(); i++, it.next()) {
+    ASSERT_EQ(shape::getIndexOffset(i, sliced.shapeInfo()), it.offset(0));
+    ASSERT_EQ(shape::getIndexOffset(i, ySliced.shapeInfo()), it.offset(1));
+  }
+
+  // a dense array and a strided row collapse to a single dimension
+  OffsetIterator<2> dense(x.shapeInfo(), row.shapeInfo());
+  ASSERT_EQ(1, dense.rank(0));
+  ASSERT_EQ(1, dense.rank(1));
+  for (sd::LongType i = 0; i < row.lengthOf(); i++, dense.next())
+    ASSERT_EQ(shape::getIndexOffset(i, row.shapeInfo()), dense.offset(1));
+}
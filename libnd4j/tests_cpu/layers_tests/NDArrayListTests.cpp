@@ -70,3 +70,74 @@ TEST_F(NDArrayListTests, Test_Stack_UnStack_1) {
 
   delete array;
 }
+
+TEST_F(NDArrayListTests, Test_Dense_Stack_1) {
+  NDArrayList list(0, true);
+
+  for (int e = 0; e < 5; e++) {
+    auto row = NDArrayFactory::create<float>('c', {2, 3});
+    row.assign((float)e);
+    ASSERT_EQ(sd::Status::OK, list.write(e, row));
+  }
+
+  ASSERT_TRUE(list.isDense());
+  ASSERT_EQ(5, list.elements());
+
+  // rewriting an index reuses its storage slot
+  auto slot = list.readRaw(2);
+  auto row = NDArrayFactory::create<float>('c', {2, 3});
+  row.assign(7.f);
+  ASSERT_EQ(sd::Status::OK, list.write(2, row));
+  ASSERT_TRUE(slot == list.readRaw(2));
+
+  auto exp = NDArrayFactory::create<float>('c', {5, 2, 3}, {0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f,
+                                                            1.f, 1.f, 7.f, 7.f, 7.f, 7.f, 7.f, 7.f, 3.f, 3.f,
+                                                            3.f, 3.f, 3.f, 3.f, 4.f, 4.f, 4.f, 4.f, 4.f, 4.f});
+  auto array = list.stack();
+  ASSERT_TRUE(exp.isSameShape(array));
+  ASSERT_TRUE(exp.equalsTo(array));
+
+  // writes after stack() must not leak into the stacked result
+  row.assign(-1.f);
+  ASSERT_EQ(sd::Status::OK, list.write(0, row));
+  ASSERT_TRUE(exp.equalsTo(array));
+  ASSERT_TRUE(row.equalsTo(list.readRaw(0)));
+
+  delete array;
+}
+
+TEST_F(NDArrayListTests, Test_Dense_Gather_1) {
+  NDArrayList list(4, false);
+  list.preallocate(sd::DataType::DOUBLE, {3});
+  ASSERT_TRUE(list.isDense());
+
+  for (int e = 0; e < 4; e++) {
+    auto row = NDArrayFactory::create<double>('c', {3});
+    row.assign((double)e);
+    ASSERT_EQ(sd::Status::OK, list.write(e, row));
+  }
+
+  auto exp = NDArrayFactory::create<double>('c', {3, 3}, {3., 3., 3., 0., 0., 0., 2., 2., 2.});
+  auto array = list.gather({3, 0, 2});
+  ASSERT_TRUE(exp.isSameShape(array));
+  ASSERT_TRUE(exp.equalsTo(array));
+
+  delete array;
+}
+
+TEST_F(NDArrayListTests, Test_Dense_Fallback_1) {
+  auto input = NDArrayFactory::create<float>('c', {5, 2});
+  input.linspace(1);
+
+  NDArrayList list(2, false);
+  list.shape() = input.getShapeAsVector();
+
+  // splits of different length can't share the storage
+  ASSERT_EQ(sd::Status::OK, list.write(0, input({0, 2, 0, 0})));
+  ASSERT_TRUE(list.isDense());
+  ASSERT_EQ(sd::Status::OK, list.write(1, input({2, 5, 0, 0})));
+  ASSERT_FALSE(list.isDense());
+
+  ASSERT_TRUE(input({0, 2, 0, 0}).equalsTo(list.readRaw(0)));
+  ASSERT_TRUE(input({2, 5, 0, 0}).equalsTo(list.readRaw(1)));
+}
@@ -473,6 +473,68 @@ TEST_F(NDArrayTest, TestReduceAlongDimension2) {
   delete array;
 }
 
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, TestReduceAlongDimension3) {
+  // column sums stream the rows; compare against row sums of the transposed copy
+  NDArray array('c', {257, 1100}, sd::DataType::FLOAT32);
+  array.linspace(-3., 0.01);
+
+  auto res = array.reduceAlongDimension(reduce::Sum, {0});
+  auto exp = array.permute({1, 0}).dup('c').reduceAlongDimension(reduce::Sum, {1});
+
+  ASSERT_TRUE(exp.isSameShape(res));
+  ASSERT_TRUE(exp.equalsTo(res, 1e-3));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, TestReduceAlongDimension4) {
+  NDArray array('c', {64, 3, 40}, sd::DataType::DOUBLE);
+  array.linspace(1., 0.5);
+
+  auto res = array.reduceAlongDimension(reduce::Mean, {0});
+  auto max = array.reduceAlongDimension(reduce::Max, {0});
+  auto perm = array.permute({1, 2, 0}).dup('c');
+
+  ASSERT_TRUE(perm.reduceAlongDimension(reduce::Mean, {2}).equalsTo(res));
+  ASSERT_TRUE(perm.reduceAlongDimension(reduce::Max, {2}).equalsTo(max));
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, TestReduceAlongDimension5) {
+  NDArray array('c', {1 << 20, 8}, sd::DataType::FLOAT32);
+  array.assign(0.1f);
+
+  Environment::getInstance().setPairwiseReductions(true);
+  auto res = array.reduceAlongDimension(reduce::Sum, {0});
+  Environment::getInstance().setPairwiseReductions(false);
+
+  for (int e = 0; e < res.lengthOf(); e++) ASSERT_NEAR(104857.6f, res.e<float>(e), 1.f);
+}
+
+//////////////////////////////////////////////////////////////////////
+TEST_F(NDArrayTest, TestReduceAlongDimension6) {
+  // AMax and AMin start from the first element, every column has to start from its own
+  NDArray array('c', {300, 16}, sd::DataType::FLOAT32);
+
+  for (bool pairwise : {false, true}) {
+    Environment::getInstance().setPairwiseReductions(pairwise);
+
+    array.linspace(1.);
+    array.p(0, -10000.f);
+    auto amax = array.reduceAlongDimension(reduce::AMax, {0});
+
+    array.p(0, 0.5f);
+    auto amin = array.reduceAlongDimension(reduce::AMin, {0});
+
+    for (int c = 0; c < 16; c++) {
+      ASSERT_NEAR(c == 0 ? 10000.f : 299.f * 16 + c + 1, amax.e<float>(c), 1e-3f);
+      ASSERT_NEAR(c == 0 ? 0.5f : c + 1.f, amin.e<float>(c), 1e-5f);
+    }
+  }
+
+  Environment::getInstance().setPairwiseReductions(false);
+}
+
 //////////////////////////////////////////////////////////////////////
 TEST_F(NDArrayTest, TestTransform1) {
   float *c = new float[4]{-1, -2, -3, -4};
@@ -20,6 +20,7 @@
 // Created by raver119 on 21.11.17.
 //
 #include <array/NDArray.h>
+#include <array/NDArrayExpression.h>
 #include <helpers/DebugHelper.h>
 #include <ops/declarable/headers/parity_ops.h>
 
@@ -1228,3 +1229,84 @@ TEST_F(NDArrayTest2, test_numpy_import_1) {
 
   ASSERT_EQ(exp, array);
 }
+
+TEST_F(NDArrayTest2, test_lambda_layouts_1) {
+  NDArray x('c', {4, 6}, sd::DataType::FLOAT32);
+  NDArray y('f', {4, 3}, sd::DataType::FLOAT32);
+  NDArray z('c', {4, 3}, sd::DataType::FLOAT32);
+  x.linspace(1.);
+  y.linspace(0.5);
+
+  // strided view, f-ordered operand and c-ordered target go through the row-wise loop
+  auto v = x({0, 0, 1, 0, 6, 2}, false, true);
+  NDArray e = v.dup() * 2.f + y;
+
+  v.applyPairwiseLambda<float>(y, [](float a, float b) { return a * 2.f + b; }, z);
+  ASSERT_TRUE(e.equalsTo(z));
+
+  NDArray i('c', {4, 3}, {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}, sd::DataType::FLOAT32);
+  y.applyIndexedLambda<float>([](sd::LongType index, float) { return static_cast<float>(index); }, z);
+  ASSERT_TRUE(i.equalsTo(z));
+}
+
+TEST_F(NDArrayTest2, test_expression_assign_1) {
+  NDArray x('c', {3, 4}, sd::DataType::FLOAT32);
+  NDArray y('c', {3, 4}, sd::DataType::FLOAT32);
+  x.linspace(1.);
+  y.linspace(-2., 0.5);
+
+  auto e = (x + (y - 1.f) * 1e9f);
+  expr::assign(x, expr::lazy(x) + (expr::lazy(y) - 1.) * 1e9);
+
+  ASSERT_TRUE(e.equalsTo(x));
+}
+
+TEST_F(NDArrayTest2, test_expression_broadcast_1) {
+  NDArray x('c', {2, 3, 4}, sd::DataType::FLOAT32);
+  NDArray b('c', {4}, {0.1f, 0.2f, 0.3f, 0.4f}, sd::DataType::FLOAT32);
+  NDArray m('c', {2, 1, 4}, sd::DataType::FLOAT32);
+  x.linspace(-1., 0.1);
+  m.linspace(1.);
+
+  NDArray e = x * m + b;
+  e.applyTransform(transform::Tanh, e);
+
+  auto z = expr::evaluate(expr::tanh(expr::lazy(x) * expr::lazy(m) + expr::lazy(b)));
+
+  ASSERT_TRUE(e.isSameShape(z));
+  ASSERT_TRUE(e.equalsTo(z));
+}
+
+TEST_F(NDArrayTest2, test_expression_orders_and_types_1) {
+  NDArray x('f', {3, 5}, sd::DataType::DOUBLE);
+  NDArray y('c', {3, 5}, sd::DataType::FLOAT32);
+  NDArray z('f', {3, 5}, sd::DataType::DOUBLE);
+  x.linspace(0.5);
+  y.linspace(-3.);
+
+  NDArray e = x * x - y.cast(sd::DataType::DOUBLE) / 2.;
+  expr::assign(z, expr::lazy(x) * expr::lazy(x) - expr::lazy(y) / 2);
+
+  ASSERT_TRUE(e.equalsTo(z));
+}
+
+TEST_F(NDArrayTest2, test_expression_view_1) {
+  NDArray x('c', {4, 6}, sd::DataType::FLOAT32);
+  x.linspace(1.);
+  auto v = x({0, 0, 1, 4});
+  NDArray e = v.dup();
+  e.applyScalar(scalar::MaxPairwise, 10.f, e);
+
+  expr::assign(v, expr::max(expr::lazy(v), 10.f));
+
+  ASSERT_TRUE(e.equalsTo(v));
+  ASSERT_EQ(1.f, x.e<float>(0, 0));
+  ASSERT_EQ(24.f, x.e<float>(3, 5));
+}
+
+TEST_F(NDArrayTest2, test_expression_bad_shape_1) {
+  NDArray x('c', {3, 4}, sd::DataType::FLOAT32);
+  NDArray y('c', {4, 3}, sd::DataType::FLOAT32);
+
+  ASSERT_ANY_THROW(expr::assign(x, expr::lazy(x) + expr::lazy(y)));
+}
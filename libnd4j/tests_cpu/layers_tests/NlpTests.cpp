@@ -20,7 +20,9 @@
 // @author raver119@gmail.com
 //
 #include <array/NDArray.h>
+#include <graph/FlatUtils.h>
 #include <helpers/GradCheck.h>
+#include <helpers/helper_hash.h>
 #include <helpers/RandomLauncher.h>
 #include <ops/declarable/CustomOperations.h>
 #include <ops/ops.h>
@@ -475,3 +477,117 @@ TEST_F(NlpTests, test_cbow_hs_batch_1) {
   ASSERT_EQ(exp1, row_s1_5);
   ASSERT_EQ(exp2, row_s1_6);
 }
+
+TEST_F(NlpTests, hash_table_lookup_test_1) {
+  auto keys = NDArrayFactory::string({4}, std::vector<std::string>{"the", "cat", "sat", "the"});
+  auto values = NDArrayFactory::create<sd::LongType>('c', {4}, {0, 1, 2, 3});
+  auto queries = NDArrayFactory::string({3}, std::vector<std::string>{"cat", "dog", "the"});
+  auto defaultValue = NDArrayFactory::create<sd::LongType>(-1);
+  auto exp = NDArrayFactory::create<sd::LongType>('c', {3}, {1, -1, 3});
+
+  sd::ops::hash_table_build build;
+  auto built = build.evaluate({&keys});
+  ASSERT_EQ(sd::Status::OK, built.status());
+  auto table = built.at(0);
+  ASSERT_EQ(8, table->sizeAt(0));
+
+  sd::ops::hash_table_lookup op;
+  auto result = op.evaluate({table, &keys, &values, &queries, &defaultValue});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+
+  // unknown words go to buckets following the vocabulary
+  std::string dog("dog");
+  auto bucket = static_cast<sd::LongType>(static_cast<uint64_t>(sd::ops::HashHelper::getInstance().getLongHash(dog)) % 10);
+  auto expOov = NDArrayFactory::create<sd::LongType>('c', {3}, {1, 4 + bucket, 3});
+
+  auto oov = op.evaluate({table, &keys, &values, &queries}, {}, {10});
+  ASSERT_EQ(sd::Status::OK, oov.status());
+  ASSERT_EQ(expOov, *oov.at(0));
+}
+
+TEST_F(NlpTests, hash_table_lookup_test_2) {
+  auto keys = NDArrayFactory::create<int>('c', {3}, {10, 20, 30});
+  auto values = NDArrayFactory::create<float>('c', {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  auto queries = NDArrayFactory::create<int>('c', {2, 2}, {30, 11, 10, 30});
+  auto defaultValue = NDArrayFactory::create<float>(0.5f);
+  auto exp = NDArrayFactory::create<float>('c', {2, 2, 2}, {5.f, 6.f, 0.5f, 0.5f, 1.f, 2.f, 5.f, 6.f});
+
+  sd::ops::hash_table_build build;
+  auto built = build.evaluate({&keys});
+  ASSERT_EQ(sd::Status::OK, built.status());
+
+  sd::ops::hash_table_lookup op;
+  auto result = op.evaluate({built.at(0), &keys, &values, &queries, &defaultValue});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+}
+
+TEST_F(NlpTests, hash_table_insert_test_1) {
+  auto keys = NDArrayFactory::create<sd::LongType>('c', {2}, {1, 2});
+  auto values = NDArrayFactory::create<float>('c', {2}, {10.f, 20.f});
+  auto newKeys = NDArrayFactory::create<sd::LongType>('c', {4}, {2, 3, 3, 4});
+  auto newValues = NDArrayFactory::create<float>('c', {4}, {21.f, 30.f, 31.f, 40.f});
+  auto queries = NDArrayFactory::create<sd::LongType>('c', {5}, {4, 3, 2, 1, 5});
+  auto expKeys = NDArrayFactory::create<sd::LongType>('c', {4}, {1, 2, 3, 4});
+  auto expValues = NDArrayFactory::create<float>('c', {4}, {10.f, 21.f, 31.f, 40.f});
+  auto exp = NDArrayFactory::create<float>('c', {5}, {40.f, 31.f, 21.f, 10.f, 0.f});
+
+  sd::ops::hash_table_build build;
+  auto built = build.evaluate({&keys});
+  ASSERT_EQ(sd::Status::OK, built.status());
+
+  // room for 4 keys: the index is updated in place
+  sd::ops::hash_table_insert insert;
+  auto inserted = insert.evaluate({built.at(0), &keys, &values, &newKeys, &newValues});
+  ASSERT_EQ(sd::Status::OK, inserted.status());
+  ASSERT_EQ(8, inserted.at(0)->sizeAt(0));
+  ASSERT_EQ(expKeys, *inserted.at(1));
+  ASSERT_EQ(expValues, *inserted.at(2));
+
+  sd::ops::hash_table_lookup lookup;
+  auto result = lookup.evaluate({inserted.at(0), inserted.at(1), inserted.at(2), &queries});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+
+  // 10 keys don't fit, the index grows
+  auto moreKeys = NDArrayFactory::create<sd::LongType>('c', {10});
+  moreKeys.linspace(0);
+  auto moreValues = NDArrayFactory::create<float>('c', {10});
+  moreValues.linspace(100.f);
+
+  auto grown = insert.evaluate({inserted.at(0), inserted.at(1), inserted.at(2), &moreKeys, &moreValues});
+  ASSERT_EQ(sd::Status::OK, grown.status());
+  ASSERT_EQ(32, grown.at(0)->sizeAt(0));
+  ASSERT_EQ(10, grown.at(1)->lengthOf());
+
+  auto all = lookup.evaluate({grown.at(0), grown.at(1), grown.at(2), &moreKeys});
+  ASSERT_EQ(sd::Status::OK, all.status());
+  ASSERT_EQ(moreValues, *all.at(0));
+}
+
+TEST_F(NlpTests, hash_table_serialization_test_1) {
+  auto keys = NDArrayFactory::string({3}, std::vector<std::string>{"alpha", "beta", "gamma"});
+  auto values = NDArrayFactory::create<int>('c', {3}, {7, 8, 9});
+  auto queries = NDArrayFactory::string({2}, std::vector<std::string>{"gamma", "alpha"});
+  auto exp = NDArrayFactory::create<int>('c', {2}, {9, 7});
+
+  sd::ops::hash_table_build build;
+  auto built = build.evaluate({&keys});
+  ASSERT_EQ(sd::Status::OK, built.status());
+
+  // the table is restored from the graph like any other array
+  std::vector<NDArray*> restored;
+  for (auto array : std::vector<NDArray*>{built.at(0), &keys, &values}) {
+    flatbuffers::FlatBufferBuilder builder(1024);
+    builder.Finish(sd::graph::FlatUtils::toFlatArray(builder, *array));
+    restored.emplace_back(sd::graph::FlatUtils::fromFlatArray(sd::graph::GetFlatArray(builder.GetBufferPointer())));
+  }
+
+  sd::ops::hash_table_lookup op;
+  auto result = op.evaluate({restored[0], restored[1], restored[2], &queries});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+
+  for (auto array : restored) delete array;
+}
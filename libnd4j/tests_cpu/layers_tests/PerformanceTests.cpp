@@ -29,6 +29,7 @@
 #include <helpers/GradCheck.h>
 #include <helpers/Loops.h>
 #include <helpers/MmulHelper.h>
+#include <helpers/OffsetIterator.h>
 #include <helpers/OmpLaunchHelper.h>
 #include <helpers/RandomLauncher.h>
 #include <helpers/threshold.h>
@@ -54,6 +55,39 @@ class PerformanceTests : public testing::Test {
   PerformanceTests() { samediff::ThreadPool::getInstance(); }
 };
 
+TEST_F(PerformanceTests, benchmark_stats_1) {
+  std::vector<double> timings;
+  for (int e = 100; e >= 1; e--) timings.emplace_back(e);
+
+  auto stats = BenchmarkStats::build(timings);
+
+  ASSERT_EQ(100, stats.iterations);
+  ASSERT_NEAR(50.5, stats.mean, 1e-9);
+  ASSERT_NEAR(50.5, stats.median, 1e-9);
+  ASSERT_NEAR(99.0, stats.p99, 1e-9);
+  ASSERT_NEAR(1.0, stats.min, 1e-9);
+  ASSERT_NEAR(100.0, stats.max, 1e-9);
+  ASSERT_TRUE(stats.ciLow < stats.median && stats.median < stats.ciHigh);
+}
+
+TEST_F(PerformanceTests, benchmark_report_1) {
+  BenchmarkRecord record;
+  record.suite = "loops";
+  record.name = "tanh";
+  record.parameters["length"] = 1024;
+  record.bytes = 8192;
+  record.stats = BenchmarkStats::build({2.0, 2.0, 2.0});
+
+  BenchmarkReport report;
+  report.add(record);
+
+  ASSERT_NEAR(4.096e9, report.records()[0].bytesPerSecond(), 1.0);
+
+  auto json = report.toJson();
+  ASSERT_NE(std::string::npos, json.find("\"name\": \"tanh\""));
+  ASSERT_NE(std::string::npos, json.find("\"length\": 1024"));
+}
+
 #ifdef RELEASE_BUILD
 
 TEST_F(PerformanceTests, test_matmul_c_f_1) {
@@ -134,4 +168,71 @@ TEST_F(PerformanceTests, test_maxpooling2d_1) {
             valuesX[valuesX.size() - 1]);
 }
 
+TEST_F(PerformanceTests, test_applyLambda_overhead_1) {
+  // the same lambda, inlined into the loop vs called through std::function for every element
+  auto x = NDArrayFactory::create<float>('c', {1024, 1024});
+  auto z = x.like();
+  x.linspace(1.0f, 1e-6f);
+
+  auto lambda = LAMBDA_F(_x) { return _x * 0.5f + 1.0f; };
+  std::function<float(float)> wrapped(lambda);
+
+  std::vector<sd::LongType> valuesI, valuesW;
+  for (int i = 0; i < numIterations; i++) {
+    auto timeStartI = std::chrono::system_clock::now();
+    x.applyLambda<float>(lambda, z);
+    auto timeEndI = std::chrono::system_clock::now();
+    valuesI.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEndI - timeStartI).count());
+
+    auto timeStartW = std::chrono::system_clock::now();
+    x.applyLambda<float>(wrapped, z);
+    auto timeEndW = std::chrono::system_clock::now();
+    valuesW.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEndW - timeStartW).count());
+  }
+
+  std::sort(valuesI.begin(), valuesI.end());
+  std::sort(valuesW.begin(), valuesW.end());
+
+  const double perElementI = static_cast<double>(valuesI[valuesI.size() / 2]) / x.lengthOf();
+  const double perElementW = static_cast<double>(valuesW[valuesW.size() / 2]) / x.lengthOf();
+  sd_printf("Median ns/element inlined: [%f]; std::function: [%f];\n", perElementI, perElementW);
+}
+
+TEST_F(PerformanceTests, test_offset_iterator_1) {
+  // per-element shape::getIndexOffset vs incremental OffsetIterator, over permuted and sliced views
+  auto x = NDArrayFactory::create<float>('c', {32, 64, 48, 40});
+  x.linspace(1.0f, 1e-6f);
+
+  auto permuted = x.permute({3, 1, 0, 2});
+  auto sliced = x({0, 32, 2, 0, 64, 1, 8, 40, 1, 0, 40, 3}, true, true);
+
+  for (auto view : {&permuted, &sliced}) {
+    auto buffer = view->bufferAsT<float>();
+    const auto len = view->lengthOf();
+
+    std::vector<sd::LongType> valuesG, valuesI;
+    float sumG = 0.f, sumI = 0.f;
+    for (int i = 0; i < numIterations; i++) {
+      auto timeStartG = std::chrono::system_clock::now();
+      for (sd::LongType e = 0; e < len; e++) sumG += buffer[shape::getIndexOffset(e, view->shapeInfo())];
+      auto timeEndG = std::chrono::system_clock::now();
+      valuesG.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEndG - timeStartG).count());
+
+      auto timeStartI = std::chrono::system_clock::now();
+      OffsetIterator<1> it(view->shapeInfo());
+      for (sd::LongType e = 0; e < len; e++, it.next()) sumI += buffer[it.offset(0)];
+      auto timeEndI = std::chrono::system_clock::now();
+      valuesI.emplace_back(std::chrono::duration_cast<std::chrono::nanoseconds>(timeEndI - timeStartI).count());
+    }
+
+    ASSERT_EQ(sumG, sumI);
+
+    std::sort(valuesG.begin(), valuesG.end());
+    std::sort(valuesI.begin(), valuesI.end());
+    sd_printf("Rank %i view, median ns/element getIndexOffset: [%f]; OffsetIterator: [%f];\n", view->rankOf(),
+              static_cast<double>(valuesG[valuesG.size() / 2]) / len,
+              static_cast<double>(valuesI[valuesI.size() / 2]) / len);
+  }
+}
+
 #endif
@@ -22,6 +22,9 @@
 #include <graph/GraphExecutioner.h>
 #include <graph/GraphHolder.h>
 #include <graph/InferenceRequest.h>
+#include <graph/InferenceServer.h>
+
+#include <thread>
 
 #include "testlayers.h"
 
@@ -83,6 +86,16 @@ TEST_F(ServerRelatedTests, Basic_Output_Test_1) {
     ASSERT_EQ(*array3, *restored.byId("second indexed")->getNDArray());
 }
 */
+TEST_F(ServerRelatedTests, InferenceServer_Malformed_1) {
+  InferenceServer server;
+
+  std::vector<uint8_t> garbage(16, 0xff);
+  auto future = server.submit(garbage);
+
+  ASSERT_ANY_THROW(future.get());
+  ASSERT_EQ(0, server.executedRequests());
+}
+
 #if GRAPH_FILES_OK
 TEST_F(ServerRelatedTests, Basic_Execution_Test_1) {
   flatbuffers::FlatBufferBuilder builder(4096);
@@ -186,4 +199,141 @@ TEST_F(ServerRelatedTests, BasicExecutionTests_3) {
 
   GraphHolder::getInstance().dropGraphAny(11903L);
 }
+
+TEST_F(ServerRelatedTests, BasicExecutionTests_4) {
+  auto oGraph = GraphExecutioner::importFromFlatBuffers("./resources/reduce_dim_false.fb");
+  GraphHolder::getInstance().registerGraph(11904L, oGraph);
+
+  // the same session serves consecutive requests, and doesn't keep the previous inputs
+  for (int e = 1; e <= 3; e++) {
+    flatbuffers::FlatBufferBuilder builder(4096);
+    flatbuffers::FlatBufferBuilder otherBuilder(4096);
+
+    auto input0 = NDArrayFactory::create<float>('c', {3, 3});
+    input0.assign((float)e);
+    auto exp = NDArrayFactory::create<float>('c', {3});
+    exp.assign(3.f * e);
+
+    InferenceRequest ir(11904L);
+    ir.appendVariable(1, 0, &input0);
+
+    auto af = ir.asFlatInferenceRequest(otherBuilder);
+    otherBuilder.Finish(af);
+    auto fir = GetFlatInferenceRequest(otherBuilder.GetBufferPointer());
+
+    auto flatResult = GraphHolder::getInstance().execute(fir->id(), builder, fir);
+    builder.Finish(flatResult);
+
+    ExecutionResult restored(GetFlatResult(builder.GetBufferPointer()));
+    ASSERT_EQ(1, restored.size());
+    ASSERT_EQ(exp, *restored.at(0)->getNDArray());
+  }
+
+  auto pool = GraphHolder::getInstance().sessionPool(11904L);
+  ASSERT_EQ(1, pool->size());
+  ASSERT_EQ(1, pool->idle());
+
+  GraphHolder::getInstance().dropGraphAny(11904L);
+}
+
+TEST_F(ServerRelatedTests, InferenceServer_1) {
+  auto oGraph = GraphExecutioner::importFromFlatBuffers("./resources/reduce_dim_false.fb");
+  GraphHolder::getInstance().registerGraph(11905L, oGraph);
+
+  BatchingOptions options;
+  options.numWorkers = 2;
+  InferenceServer server(options);
+
+  // the graph reduces its input, so requests are executed one by one but from concurrent clients
+  const int numClients = 4;
+  std::vector<std::thread> clients;
+  std::vector<int> failures(numClients, 0);
+  for (int c = 0; c < numClients; c++) {
+    clients.emplace_back([&, c]() {
+      for (int e = 1; e <= 5; e++) {
+        auto input0 = NDArrayFactory::create<float>('c', {3, 3});
+        input0.assign((float)(c + e));
+        auto exp = NDArrayFactory::create<float>('c', {3});
+        exp.assign(3.f * (c + e));
+
+        flatbuffers::FlatBufferBuilder builder(4096);
+        InferenceRequest ir(11905L);
+        ir.appendVariable(1, 0, &input0);
+        builder.Finish(ir.asFlatInferenceRequest(builder));
+
+        auto bytes = server.inferenceRequest(
+            std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize()));
+
+        ExecutionResult restored(GetFlatResult(bytes.data()));
+        if (restored.size() != 1 || exp != *restored.at(0)->getNDArray()) failures[c]++;
+      }
+    });
+  }
+
+  for (auto& client : clients) client.join();
+
+  for (auto f : failures) ASSERT_EQ(0, f);
+  ASSERT_EQ(numClients * 5, server.executedRequests());
+  ASSERT_EQ(server.executedRequests(), server.executedBatches());
+
+  GraphHolder::getInstance().dropGraphAny(11905L);
+}
 #endif
+
+TEST_F(ServerRelatedTests, InferenceServer_2) {
+  // row-wise graph: abs(x), so concatenated requests can be split back along the first dimension
+  auto graph = new Graph();
+  graph->getExecutorConfiguration()->_outputMode = OutputMode_EXPLICIT;
+
+  auto x = NDArrayFactory::create_<float>('c', {2, 3});
+  graph->getVariableSpace()->putVariable(-1, x);
+  graph->addNode(new Node(OpType_TRANSFORM_SAME, transform::Abs, 1, {-1}, {}));
+  graph->addOutput(1);
+
+  GraphHolder::getInstance().registerGraph(11906L, graph);
+
+  BatchingOptions options;
+  options.maxQueueDelayUs = 50000;
+  InferenceServer server(options);
+  server.setBatchable(11906L, true);
+
+  // every client submits all of its requests before waiting, so they are queued together
+  const int numClients = 4;
+  const int numRequests = 4;
+  std::vector<std::thread> clients;
+  std::vector<int> failures(numClients, 0);
+  for (int c = 0; c < numClients; c++) {
+    clients.emplace_back([&, c]() {
+      std::vector<std::future<std::vector<uint8_t>>> futures;
+      std::vector<NDArray> expected;
+      for (int e = 0; e < numRequests; e++) {
+        auto input0 = NDArrayFactory::create<float>('c', {2, 3});
+        input0.linspace(-(float)(1000 * c + 10 * e + 1), -1.f);
+        expected.emplace_back(input0.dup());
+        expected.back().applyTransform(transform::Abs, expected.back());
+
+        flatbuffers::FlatBufferBuilder builder(4096);
+        InferenceRequest ir(11906L);
+        ir.appendVariable(-1, 0, &input0);
+        builder.Finish(ir.asFlatInferenceRequest(builder));
+
+        futures.emplace_back(server.submit(
+            std::vector<uint8_t>(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize())));
+      }
+
+      for (int e = 0; e < numRequests; e++) {
+        auto bytes = futures[e].get();
+        ExecutionResult restored(GetFlatResult(bytes.data()));
+        if (restored.size() != 1 || expected[e] != *restored.at(0)->getNDArray()) failures[c]++;
+      }
+    });
+  }
+
+  for (auto& client : clients) client.join();
+
+  for (auto f : failures) ASSERT_EQ(0, f);
+  ASSERT_EQ(numClients * numRequests, server.executedRequests());
+  ASSERT_LT(server.executedBatches(), server.executedRequests());
+
+  GraphHolder::getInstance().dropGraphAny(11906L);
+}
@@ -0,0 +1,148 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Tests for CSR sparse matrix ops
+//
+#include <ops/declarable/CustomOperations.h>
+
+#include "testlayers.h"
+
+using namespace sd;
+
+class SparseTests : public testing::Test {
+ public:
+  // [[1, 0, 2, 0],
+  //  [0, 0, 0, 0],
+  //  [0, 3, 0, 4]]
+  NDArray dense = NDArrayFactory::create<float>('c', {3, 4}, {1, 0, 2, 0, 0, 0, 0, 0, 0, 3, 0, 4});
+  NDArray rowPointers = NDArrayFactory::create<sd::LongType>({0, 2, 2, 4});
+  NDArray columns = NDArrayFactory::create<sd::LongType>({0, 2, 1, 3});
+  NDArray values = NDArrayFactory::create<float>({1, 2, 3, 4});
+};
+
+TEST_F(SparseTests, dense_to_csr_1) {
+  sd::ops::dense_to_csr op;
+  auto result = op.evaluate({&dense});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  ASSERT_EQ(rowPointers, *result.at(0));
+  ASSERT_EQ(columns, *result.at(1));
+  ASSERT_EQ(values, *result.at(2));
+}
+
+TEST_F(SparseTests, coo_to_csr_1) {
+  // entries in any order
+  auto indices = NDArrayFactory::create<int>('c', {4, 2}, {2, 3, 0, 2, 2, 1, 0, 0});
+  auto cooValues = NDArrayFactory::create<float>({4, 2, 3, 1});
+  auto shape = NDArrayFactory::create<int>({3, 4});
+
+  sd::ops::coo_to_csr op;
+  auto result = op.evaluate({&indices, &cooValues, &shape});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  ASSERT_EQ(rowPointers, *result.at(0));
+  ASSERT_EQ(columns, *result.at(1));
+  ASSERT_EQ(values, *result.at(2));
+}
+
+TEST_F(SparseTests, csr_to_dense_1) {
+  auto shape = NDArrayFactory::create<int>({3, 4});
+
+  sd::ops::csr_to_dense op;
+  auto result = op.evaluate({&rowPointers, &columns, &values, &shape});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(dense, *result.at(0));
+}
+
+TEST_F(SparseTests, csr_to_dense_2) {
+  auto shape = NDArrayFactory::create<int>({3, 4});
+  // rowPointers don't cover all values
+  auto broken = NDArrayFactory::create<sd::LongType>({0, 2, 2, 3});
+  auto output = NDArrayFactory::create<float>('c', {3, 4});
+
+  sd::ops::csr_to_dense op;
+  ASSERT_ANY_THROW(op.execute({&broken, &columns, &values, &shape}, {&output}, {}, {}, {}));
+}
+
+TEST_F(SparseTests, csr_matmul_1) {
+  auto b = NDArrayFactory::create<float>('c', {4, 2}, {1, 2, 3, 4, 5, 6, 7, 8});
+  auto exp = NDArrayFactory::create<float>('c', {3, 2}, {11, 14, 0, 0, 37, 44});
+
+  sd::ops::csr_matmul op;
+  auto result = op.evaluate({&rowPointers, &columns, &values, &b});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+}
+
+TEST_F(SparseTests, csr_matmul_2) {
+  auto v = NDArrayFactory::create<float>({1, 2, 3, 4});
+  auto exp = NDArrayFactory::create<float>({7, 0, 22});
+
+  sd::ops::csr_matmul op;
+  auto result = op.evaluate({&rowPointers, &columns, &values, &v});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+}
+
+TEST_F(SparseTests, csr_matmul_3) {
+  // uneven rows, so the row partitioning matters
+  auto a = NDArrayFactory::create<double>('c', {64, 48});
+  for (int r = 0; r < 64; r++)
+    for (int c = 0; c < 48; c++)
+      if ((r < 4 && c % 2 == 0) || (r * 7 + c * 3) % 11 == 0) a.p(r * 48 + c, (double)(r - c) / 8.0);
+
+  auto b = NDArrayFactory::create<double>('c', {48, 5});
+  b.linspace(-1.0, 0.05);
+
+  sd::ops::dense_to_csr toCsr;
+  auto csr = toCsr.evaluate({&a});
+  ASSERT_EQ(sd::Status::OK, csr.status());
+
+  sd::ops::csr_matmul op;
+  auto result = op.evaluate({csr.at(0), csr.at(1), csr.at(2), &b});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  sd::ops::matmul mmul;
+  auto exp = mmul.evaluate({&a, &b});
+  ASSERT_TRUE(exp.at(0)->equalsTo(result.at(0)));
+}
+
+TEST_F(SparseTests, csr_multiply_dense_1) {
+  auto other = NDArrayFactory::create<float>('c', {3, 4});
+  other.linspace(1.0);
+  // entries at (0, 0), (0, 2), (2, 1), (2, 3)
+  auto exp = NDArrayFactory::create<float>({1, 6, 30, 48});
+
+  sd::ops::csr_multiply_dense op;
+  auto result = op.evaluate({&rowPointers, &columns, &values, &other});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+}
+
+TEST_F(SparseTests, csr_add_dense_1) {
+  auto other = NDArrayFactory::create<float>('c', {3, 4});
+  other.assign(1.f);
+  auto exp = dense + 1.f;
+
+  sd::ops::csr_add_dense op;
+  auto result = op.evaluate({&rowPointers, &columns, &values, &other});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  ASSERT_EQ(exp, *result.at(0));
+}
@@ -27,6 +27,9 @@
 #include <array/NDArrayFactory.h>
 #include <graph/Stash.h>
 #include <helpers/BitwiseUtils.h>
+#include <helpers/helper_hash.h>
+#include <helpers/unicode.h>
+#include <ops/declarable/CustomOperations.h>
 
 #include <bitset>
 
@@ -852,3 +855,107 @@ TEST_F(StringTests, test_bit_string_1) {
   ASSERT_EQ(32, str.length());
   ASSERT_EQ(std::string("00000000000000000000000000000001"), str);
 }
+
+/////////////////////////////////////////////////////////////////////////
+TEST_F(StringTests, test_validate_utf8_1) {
+  std::string valid(u8"ascii prefix long enough €alpha水𝄋ÿ");
+  ASSERT_TRUE(unicode::isStringValidU8(valid.data(), valid.data() + valid.size()));
+
+  // overlong '/', stray continuation, truncated symbol and encoded surrogate
+  std::vector<std::string> invalid = {"abcdefgh\xc0\xaf", "\x80" "abc", "abc\xe2\x82", "\xed\xa0\x80"};
+  for (const auto& s : invalid) ASSERT_FALSE(unicode::isStringValidU8(s.data(), s.data() + s.size()));
+}
+
+/////////////////////////////////////////////////////////////////////////
+TEST_F(StringTests, test_string_lower_1) {
+  auto x = NDArrayFactory::string({2}, std::vector<std::string>{u8"Hello WORLD, Straße ÄÖÜ", "ABCDEFGHIJKLMNOP"});
+
+  sd::ops::string_lower op;
+  auto result = op.evaluate({&x});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto z = result.at(0);
+
+  ASSERT_EQ(std::string(u8"hello world, straße äöü"), z->e<std::string>(0));
+  ASSERT_EQ(std::string("abcdefghijklmnop"), z->e<std::string>(1));
+}
+
+/////////////////////////////////////////////////////////////////////////
+TEST_F(StringTests, test_string_tokenize_1) {
+  auto x = NDArrayFactory::string({3}, std::vector<std::string>{"Hello, world!", "   ", "a  b"});
+  auto expSplits = NDArrayFactory::create<sd::LongType>('c', {4}, {0, 4, 4, 6});
+  std::vector<std::string> expTokens = {"Hello", ",", "world", "!", "a", "b"};
+
+  sd::ops::string_tokenize op;
+  auto result = op.evaluate({&x}, {}, {1});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto values = result.at(0);
+  auto splits = result.at(1);
+
+  ASSERT_EQ(expTokens.size(), values->lengthOf());
+  for (int e = 0; e < expTokens.size(); e++) ASSERT_EQ(expTokens[e], values->e<std::string>(e));
+
+  ASSERT_EQ(expSplits, *splits);
+}
+
+/////////////////////////////////////////////////////////////////////////
+TEST_F(StringTests, test_string_ngram_hash_1) {
+  auto tokens = NDArrayFactory::string({4}, std::vector<std::string>{"a", "b", "c", "d"});
+  auto splits = NDArrayFactory::create<sd::LongType>('c', {3}, {0, 3, 4});
+  auto expSplits = NDArrayFactory::create<sd::LongType>('c', {3}, {0, 2, 2});
+  const sd::LongType buckets = 1000;
+
+  sd::ops::string_ngram_hash op;
+  auto result = op.evaluate({&tokens, &splits}, {}, {2, buckets});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto hashes = result.at(0);
+
+  ASSERT_EQ(2, hashes->lengthOf());
+  ASSERT_EQ(expSplits, *result.at(1));
+
+  std::vector<std::string> ngrams = {"a b", "b c"};
+  for (int e = 0; e < 2; e++) {
+    auto hash = sd::ops::HashHelper::getInstance().getLongHash(ngrams[e]);
+    ASSERT_EQ(static_cast<sd::LongType>(static_cast<uint64_t>(hash) % buckets), hashes->e<sd::LongType>(e));
+  }
+
+  // single n-gram hashes to the same bucket as the joined string
+  auto joined = NDArrayFactory::string({2}, std::vector<std::string>{"a b", "b c"});
+  sd::ops::string_to_hash_bucket bucketOp;
+  auto bucketResult = bucketOp.evaluate({&joined}, {}, {buckets});
+  ASSERT_EQ(sd::Status::OK, bucketResult.status());
+  ASSERT_EQ(*hashes, *bucketResult.at(0));
+}
+
+/////////////////////////////////////////////////////////////////////////
+TEST_F(StringTests, test_string_join_1) {
+  auto x = NDArrayFactory::string({2, 3}, std::vector<std::string>{"a", "bc", "", "d", u8"€", "f"});
+  auto separator = NDArrayFactory::string("--");
+
+  sd::ops::string_join op;
+  auto result = op.evaluate({&x, &separator});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto z = result.at(0);
+
+  ASSERT_EQ(2, z->lengthOf());
+  ASSERT_EQ(std::string("a--bc--"), z->e<std::string>(0));
+  ASSERT_EQ(std::string(u8"d--€--f"), z->e<std::string>(1));
+}
+
+/////////////////////////////////////////////////////////////////////////
+TEST_F(StringTests, test_string_substr_1) {
+  auto x = NDArrayFactory::string({3}, std::vector<std::string>{u8"€alpha", "ab", ""});
+
+  sd::ops::string_substr op;
+  auto result = op.evaluate({&x}, {}, {-3, 2, 1});
+  ASSERT_EQ(sd::Status::OK, result.status());
+  auto z = result.at(0);
+
+  ASSERT_EQ(std::string("ph"), z->e<std::string>(0));
+  ASSERT_EQ(std::string("ab"), z->e<std::string>(1));
+  ASSERT_EQ(std::string(""), z->e<std::string>(2));
+
+  auto bytes = op.evaluate({&x}, {}, {3, 3});
+  ASSERT_EQ(sd::Status::OK, bytes.status());
+  ASSERT_EQ(std::string("alp"), bytes.at(0)->e<std::string>(0));
+  ASSERT_EQ(std::string(""), bytes.at(0)->e<std::string>(1));
+}
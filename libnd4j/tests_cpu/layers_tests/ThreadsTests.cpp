@@ -23,8 +23,11 @@
 #include <execution/Threads.h>
 #include <loops/type_conversions.h>
 #include <ops/declarable/CustomOperations.h>
+#include <system/ParallelCostModel.h>
 
 #include <chrono>
+#include <cstdio>
+#include <fstream>
 
 #include "testlayers.h"
 
@@ -47,6 +50,76 @@ TEST_F(ThreadsTests, th_test_1) {
   ASSERT_EQ(2, ThreadsHelper::numberOfThreads(6, 2048));
 }
 
+TEST_F(ThreadsTests, cost_model_1) {
+  auto &model = sd::ParallelCostModel::getInstance();
+  model.reset();
+
+  // defaults keep the 1024 elements per thread rule for elementwise ops
+  ASSERT_EQ(1, model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::FLOAT32, 2043, 6));
+  ASSERT_EQ(2, model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::FLOAT32, 2048, 6));
+  ASSERT_EQ(6, model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::FLOAT32, 1 << 20, 6));
+
+  // expensive ops get more threads for the same number of elements
+  ASSERT_EQ(6, model.numberOfThreads(sd::CostClass::TRANSCENDENTAL, sd::DataType::FLOAT32, 2048, 6));
+
+  model.setCostPerElement(sd::CostClass::ELEMENTWISE, sd::DataType::DOUBLE, 0.25);
+  ASSERT_EQ(1, model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::DOUBLE, 4095, 6));
+  ASSERT_EQ(2, model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::FLOAT32, 2048, 6));
+
+  model.setThreadCost(100.0);
+  ASSERT_EQ(5, model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::DOUBLE, 2000, 6));
+
+  model.reset();
+  ASSERT_FALSE(model.isCalibrated());
+}
+
+TEST_F(ThreadsTests, cost_model_2) {
+  auto &model = sd::ParallelCostModel::getInstance();
+  const std::string path = "parallel_cost_profile.txt";
+
+  model.reset();
+  model.setThreadCost(5000.0);
+  model.setCostPerElement(sd::CostClass::REDUCTION, sd::DataType::BFLOAT16, 0.75);
+  model.save(path);
+
+  model.reset();
+  ASSERT_TRUE(model.load(path));
+  ASSERT_TRUE(model.isCalibrated());
+  ASSERT_NEAR(5000.0, model.threadCost(), 1e-6);
+  ASSERT_NEAR(0.75, model.costPerElement(sd::CostClass::REDUCTION, sd::DataType::HALF), 1e-6);
+  ASSERT_NEAR(8.0, model.costPerElement(sd::CostClass::TRANSCENDENTAL, sd::DataType::INT32), 1e-6);
+
+  // a broken profile is rejected as a whole
+  {
+    std::ofstream out(path);
+    out << "thread_cost 100\ncost elementwise float 0.5\n";
+  }
+  model.reset();
+  ASSERT_FALSE(model.load(path));
+  ASSERT_NEAR(1024.0, model.threadCost(), 1e-6);
+  ASSERT_FALSE(model.load("non_existent_profile.txt"));
+
+  std::remove(path.c_str());
+}
+
+TEST_F(ThreadsTests, cost_model_3) {
+  auto &model = sd::ParallelCostModel::getInstance();
+  model.calibrate();
+
+  ASSERT_TRUE(model.isCalibrated());
+  ASSERT_GT(model.threadCost(), 0.0);
+  for (auto dtype : {sd::DataType::FLOAT32, sd::DataType::DOUBLE, sd::DataType::HALF, sd::DataType::INT32}) {
+    ASSERT_GT(model.costPerElement(sd::CostClass::ELEMENTWISE, dtype), 0.0);
+    ASSERT_GT(model.costPerElement(sd::CostClass::TRANSCENDENTAL, dtype), 0.0);
+    ASSERT_GT(model.costPerElement(sd::CostClass::REDUCTION, dtype), 0.0);
+  }
+
+  const int threads = model.numberOfThreads(sd::CostClass::ELEMENTWISE, sd::DataType::FLOAT32, 1 << 24, 4);
+  ASSERT_TRUE(threads >= 1 && threads <= 4);
+
+  model.reset();
+}
+
 TEST_F(ThreadsTests, th_test_2) {
   // in this case we'll get better split over second loop - exactly 32 elements per thread
   ASSERT_EQ(2, ThreadsHelper::pickLoop2d(32, 48, 1024));
@@ -0,0 +1,148 @@
+/* ******************************************************************************
+ *
+ *
+ * This program and the accompanying materials are made available under the
+ * terms of the Apache License, Version 2.0 which is available at
+ * https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ *  See the NOTICE file distributed with this work for additional
+ *  information regarding copyright ownership.
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ ******************************************************************************/
+
+
+//
+// Tests for the op and allocation tracer
+//
+#include <ops/declarable/CustomOperations.h>
+#include <system/Tracer.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "testlayers.h"
+
+using namespace sd;
+using namespace sd::ops;
+
+class TracerTests : public testing::Test {
+ public:
+  TracerTests() { Tracer::getInstance().reset(); }
+
+  ~TracerTests() { Tracer::setEnabled(false); }
+};
+
+static int countEvents(const std::vector<TraceEvent> &events, TraceEventType type, const std::string &name) {
+  int count = 0;
+  for (const auto &e : events)
+    if (e.type == type && name == e.name) count++;
+
+  return count;
+}
+
+TEST_F(TracerTests, disabled_1) {
+  Tracer::setEnabled(false);
+
+  auto x = NDArrayFactory::create<float>('c', {3}, {1.f, 2.f, 3.f});
+  sd::ops::add op;
+  auto result = op.evaluate({&x, &x});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  ASSERT_EQ(0, Tracer::getInstance().events().size());
+}
+
+TEST_F(TracerTests, ops_1) {
+  Tracer::setEnabled(true);
+
+  auto x = NDArrayFactory::create<float>('c', {3}, {1.f, 2.f, 3.f});
+  sd::ops::add op;
+  auto result = op.evaluate({&x, &x});
+  ASSERT_EQ(sd::Status::OK, result.status());
+
+  Tracer::setEnabled(false);
+
+  auto events = Tracer::getInstance().events();
+  ASSERT_EQ(1, countEvents(events, TraceEventType::OP, "add"));
+  ASSERT_EQ(1, countEvents(events, TraceEventType::SHAPE_FUNCTION, "add"));
+
+  // the shape function runs within the op
+  for (const auto &op : events) {
+    if (op.type != TraceEventType::OP) continue;
+    for (const auto &shape : events)
+      if (shape.type == TraceEventType::SHAPE_FUNCTION) {
+        ASSERT_TRUE(shape.timestamp >= op.timestamp);
+        ASSERT_TRUE(shape.timestamp + shape.duration <= op.timestamp + op.duration);
+      }
+  }
+}
+
+TEST_F(TracerTests, ring_buffer_1) {
+  Tracer::setEnabled(true);
+
+  // this thread's buffer already exists if an earlier test traced anything, so record up to its capacity
+  const int numEvents = static_cast<int>(Tracer::getInstance().bufferSize()) * 4;
+  for (int e = 0; e < numEvents; e++) Tracer::getInstance().instant(TraceEventType::ALLOCATION, "ring_buffer_1", e);
+
+  Tracer::setEnabled(false);
+
+  auto events = Tracer::getInstance().events();
+  ASSERT_TRUE(events.size() <= Tracer::getInstance().bufferSize());
+
+  // the newest events are kept
+  ASSERT_EQ(numEvents - 1, events.back().value);
+  for (int e = 1; e < events.size(); e++) ASSERT_EQ(events[e - 1].value + 1, events[e].value);
+}
+
+TEST_F(TracerTests, chrome_trace_1) {
+  Tracer::setEnabled(true);
+  { TraceScope scope(TraceEventType::POOL_WAIT, "chrome_trace_1"); }
+  Tracer::getInstance().instant(TraceEventType::WORKSPACE_SPILL, "chrome_trace_1", 256);
+  Tracer::setEnabled(false);
+
+  auto json = Tracer::getInstance().exportChromeTrace();
+  ASSERT_NE(std::string::npos, json.find("\"traceEvents\""));
+  ASSERT_NE(std::string::npos, json.find("\"cat\": \"wait\""));
+  ASSERT_NE(std::string::npos, json.find("\"ph\": \"X\""));
+  ASSERT_NE(std::string::npos, json.find("{\"bytes\": 256}"));
+
+  const std::string path = "chrome_trace_1.json";
+  ASSERT_TRUE(Tracer::getInstance().exportChromeTrace(path));
+
+  std::ifstream file(path);
+  std::stringstream content;
+  content << file.rdbuf();
+  file.close();
+  std::remove(path.c_str());
+
+  ASSERT_EQ(json, content.str());
+}
+
+TEST_F(TracerTests, threads_1) {
+  Tracer::setEnabled(true);
+
+  // every thread gets its own buffer, which isn't kept forever once the thread exits
+  const int numThreads = 64;
+  for (int t = 0; t < numThreads; t++) {
+    std::thread thread([t]() { Tracer::getInstance().instant(TraceEventType::ALLOCATION, "threads_1", t); });
+    thread.join();
+  }
+
+  Tracer::setEnabled(false);
+
+  ASSERT_TRUE(Tracer::getInstance().numBuffers() < numThreads);
+
+  // events of the threads that exited last can still be exported
+  sd::LongType last = -1;
+  for (const auto &e : Tracer::getInstance().events())
+    if (std::string("threads_1") == e.name) last = e.value;
+
+  ASSERT_EQ(numThreads - 1, last);
+}
@@ -105,7 +105,7 @@ public class CpuNDArrayFactory extends BaseNativeNDArrayFactory {
 
         // TODO: add batched gemm here
 
-        PointerPointer functions = new PointerPointer(10);
+        PointerPointer functions = new PointerPointer(20);
         functions.put(0, Loader.addressof("cblas_sgemv"));
         functions.put(1, Loader.addressof("cblas_dgemv"));
         functions.put(2, Loader.addressof("cblas_sgemm"));
@@ -116,6 +116,16 @@ public class CpuNDArrayFactory extends BaseNativeNDArrayFactory {
         functions.put(7, Loader.addressof("LAPACKE_dgesvd"));
         functions.put(8, Loader.addressof("LAPACKE_sgesdd"));
         functions.put(9, Loader.addressof("LAPACKE_dgesdd"));
+        functions.put(10, Loader.addressof("cblas_strsm"));
+        functions.put(11, Loader.addressof("cblas_dtrsm"));
+        functions.put(12, Loader.addressof("LAPACKE_sgetrf"));
+        functions.put(13, Loader.addressof("LAPACKE_dgetrf"));
+        functions.put(14, Loader.addressof("LAPACKE_spotrf"));
+        functions.put(15, Loader.addressof("LAPACKE_dpotrf"));
+        functions.put(16, Loader.addressof("LAPACKE_sgeqrf"));
+        functions.put(17, Loader.addressof("LAPACKE_dgeqrf"));
+        functions.put(18, Loader.addressof("LAPACKE_sorgqr"));
+        functions.put(19, Loader.addressof("LAPACKE_dorgqr"));
         nativeOps.initializeFunctions(functions);
 
         if (nativeOps.lastErrorCode() != 0)